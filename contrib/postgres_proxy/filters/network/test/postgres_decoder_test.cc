@@ -726,6 +726,7 @@ public:
               (uint64_t, absl::Span<Buffer::RawSlice>, Buffer::ReservationSlicesOwnerPtr),
               (override));
   MOCK_METHOD(ssize_t, search, (const void*, uint64_t, size_t, size_t), (const, override));
+  MOCK_METHOD(ssize_t, searchAnyOf, (absl::string_view, size_t, size_t), (const, override));
   MOCK_METHOD(bool, startsWith, (absl::string_view), (const, override));
   MOCK_METHOD(std::string, toString, (), (const, override));
   MOCK_METHOD(void, setWatermarks, (uint64_t, uint32_t), (override));
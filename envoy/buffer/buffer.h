@@ -328,6 +328,17 @@ public:
     return search(data, size, start, 0);
   }
 
+  /**
+   * Search for the first byte within the buffer that is contained in a set of bytes, e.g. to find
+   * the next CR or LF.
+   * @param bytes supplies the set of bytes to search for.
+   * @param start supplies the starting index to search from.
+   * @param length limits the search to specified number of bytes starting from start index.
+   * When length value is zero, entire length of data from starting index to the end is searched.
+   * @return the index of the first matching byte or -1 if there is no match.
+   */
+  virtual ssize_t searchAnyOf(absl::string_view bytes, size_t start, size_t length) const PURE;
+
   /**
    * Search for an occurrence of data at the start of a buffer.
    * @param data supplies the data to search for.
@@ -1,7 +1,9 @@
 #pragma once
 
 #include <functional>
+#include <vector>
 
+#include "envoy/buffer/buffer.h"
 #include "envoy/common/pure.h"
 #include "envoy/network/address.h"
 #include "envoy/thread_local/thread_local.h"
@@ -27,6 +29,7 @@ public:
     Close = 0x10,
     Cancel = 0x20,
     Shutdown = 0x40,
+    SendZc = 0x80,
   };
 
   Request(RequestType type, IoUringSocket& socket) : type_(type), socket_(socket) {}
@@ -42,9 +45,22 @@ public:
    */
   IoUringSocket& socket() const { return socket_; }
 
+  /**
+   * Returns the flags of the completion queue entry currently delivered for the request, e.g.
+   * IORING_CQE_F_MORE and IORING_CQE_F_NOTIF for zero-copy sends. Always zero for injected
+   * completions.
+   */
+  uint32_t completionFlags() const { return completion_flags_; }
+
+  /**
+   * Sets the flags of the completion queue entry currently delivered for the request.
+   */
+  void setCompletionFlags(uint32_t flags) { completion_flags_ = flags; }
+
 private:
   RequestType type_;
   IoUringSocket& socket_;
+  uint32_t completion_flags_{0};
 };
 
 /**
@@ -118,6 +134,38 @@ public:
   virtual IoUringResult prepareReadv(os_fd_t fd, const struct iovec* iovecs, unsigned nr_vecs,
                                      off_t offset, Request* user_data) PURE;
 
+  /**
+   * Prepares a multishot recv and puts it into the submission queue. The request stays armed and
+   * completes for every chunk of received data with a buffer picked from the provided buffer ring
+   * of the given group, @see registerBufferRing(). The completions have IORING_CQE_F_BUFFER set,
+   * with the id of the buffer in the upper 16 bits of the flags, and IORING_CQE_F_MORE while the
+   * request stays armed.
+   * Returns IoUringResult::Failed in case the submission queue is full already
+   * and IoUringResult::Ok otherwise.
+   */
+  virtual IoUringResult prepareRecvMultishot(os_fd_t fd, uint16_t buffer_group,
+                                             Request* user_data) PURE;
+
+  /**
+   * Prepares a recvmsg system call and puts it into the submission queue.
+   * Returns IoUringResult::Failed in case the submission queue is full already
+   * and IoUringResult::Ok otherwise.
+   */
+  virtual IoUringResult prepareRecvmsg(os_fd_t fd, struct msghdr* msg, Request* user_data) PURE;
+
+  /**
+   * Prepares a multishot recvmsg and puts it into the submission queue. The request stays armed
+   * and completes for every received datagram with a buffer picked from the provided buffer ring of
+   * the given group, @see prepareRecvMultishot(). Each buffer starts with a struct
+   * io_uring_recvmsg_out, followed by the name and the control messages, sized according to
+   * msg_namelen and msg_controllen of the given msghdr, and the payload. The msghdr must stay valid
+   * as long as the request is armed.
+   * Returns IoUringResult::Failed in case the submission queue is full already
+   * and IoUringResult::Ok otherwise.
+   */
+  virtual IoUringResult prepareRecvmsgMultishot(os_fd_t fd, struct msghdr* msg,
+                                                uint16_t buffer_group, Request* user_data) PURE;
+
   /**
    * Prepares a writev system call and puts it into the submission queue.
    * Returns IoUringResult::Failed in case the submission queue is full already
@@ -126,6 +174,25 @@ public:
   virtual IoUringResult prepareWritev(os_fd_t fd, const struct iovec* iovecs, unsigned nr_vecs,
                                       off_t offset, Request* user_data) PURE;
 
+  /**
+   * Prepares a sendmsg system call and puts it into the submission queue.
+   * Returns IoUringResult::Failed in case the submission queue is full already
+   * and IoUringResult::Ok otherwise.
+   */
+  virtual IoUringResult prepareSendmsg(os_fd_t fd, const struct msghdr* msg,
+                                       Request* user_data) PURE;
+
+  /**
+   * Prepares a zero-copy sendmsg system call and puts it into the submission queue. The request
+   * completes twice: once with the result of the send, with IORING_CQE_F_MORE set if a
+   * notification follows, and once more with IORING_CQE_F_NOTIF set when the kernel no longer
+   * references the sent memory.
+   * Returns IoUringResult::Failed in case the submission queue is full already
+   * and IoUringResult::Ok otherwise.
+   */
+  virtual IoUringResult prepareSendmsgZc(os_fd_t fd, const struct msghdr* msg,
+                                         Request* user_data) PURE;
+
   /**
    * Prepares a close system call and puts it into the submission queue.
    * Returns IoUringResult::Failed in case the submission queue is full already
@@ -147,6 +214,27 @@ public:
    */
   virtual IoUringResult prepareShutdown(os_fd_t fd, int how, Request* user_data) PURE;
 
+  /**
+   * Registers a ring of provided buffers for the given buffer group. The ring is released when
+   * the io_uring is destroyed.
+   * Returns IoUringResult::Failed in case the kernel doesn't support provided buffer rings and
+   * IoUringResult::Ok otherwise.
+   * @param buffer_group is the id of the buffer group used by the requests consuming the buffers.
+   * @param entries is the number of buffers in the ring, which must be a power of 2.
+   */
+  virtual IoUringResult registerBufferRing(uint16_t buffer_group, uint32_t entries) PURE;
+
+  /**
+   * Hands a buffer to the ring of the given buffer group. The buffer must stay valid until a
+   * completion reports it as consumed or the io_uring is destroyed.
+   * @param buffer_group is the id of a registered buffer group.
+   * @param buf is the memory of the buffer.
+   * @param len is the size of the buffer.
+   * @param buffer_id is the id reported by the completion consuming the buffer.
+   */
+  virtual void addBufferToRing(uint16_t buffer_group, uint8_t* buf, uint32_t len,
+                               uint16_t buffer_id) PURE;
+
   /**
    * Submits the entries in the submission queue to the kernel using the
    * `io_uring_enter()` system call.
@@ -211,6 +299,24 @@ struct WriteParam {
   int32_t result_;
 };
 
+/**
+ * A datagram received by a datagram socket.
+ */
+struct ReceivedDatagram {
+  // The payload of the datagram.
+  Buffer::InstancePtr buffer_;
+  // The address of the sender.
+  sockaddr_storage peer_address_;
+  socklen_t peer_address_len_;
+  // The control messages received with the datagram, as laid out by the kernel.
+  std::vector<uint8_t> control_;
+  // Whether the datagram was larger than the receive buffer. The payload is incomplete then.
+  bool truncated_{false};
+  // The number of datagrams which were dropped before this one since the socket's queue of
+  // received datagrams was full.
+  uint32_t dropped_{0};
+};
+
 /**
  * Abstract for each socket.
  */
@@ -277,6 +383,27 @@ public:
    */
   virtual uint64_t write(const Buffer::RawSlice* slices, uint64_t num_slice) PURE;
 
+  /**
+   * Send a datagram on a datagram socket. The data is copied, the send completes asynchronously
+   * and its errors are not reported back.
+   * @param slices includes the payload of the datagram.
+   * @param num_slice the number of slices.
+   * @param peer_address the address to send the datagram to.
+   * @param control the control messages to send with the datagram, e.g. the source address or
+   * the UDP_SEGMENT size for GSO.
+   * @return the number of bytes queued to send, or a negative errno, e.g. -EAGAIN if too many
+   * sends are in flight. A write event is delivered once sends can be queued again.
+   */
+  virtual int32_t sendmsg(const Buffer::RawSlice* slices, uint64_t num_slice,
+                          const Network::Address::Instance& peer_address,
+                          absl::string_view control) PURE;
+
+  /**
+   * Take the oldest datagram received by a datagram socket.
+   * @return the datagram, or absl::nullopt if no datagram was received since the last call.
+   */
+  virtual absl::optional<ReceivedDatagram> takeDatagram() PURE;
+
   /**
    * Shutdown the socket.
    * @param how is SHUT_RD, SHUT_WR and SHUT_RDWR.
@@ -405,6 +532,12 @@ public:
   virtual IoUringSocket& addClientSocket(os_fd_t fd, Event::FileReadyCb cb,
                                          bool enable_close_event) PURE;
 
+  /**
+   * Add a datagram socket to the worker. The socket delivers a read event whenever datagrams are
+   * received, which are taken with IoUringSocket::takeDatagram().
+   */
+  virtual IoUringSocket& addDatagramSocket(os_fd_t fd, Event::FileReadyCb cb) PURE;
+
   /**
    * Return the current thread's dispatcher.
    */
@@ -422,12 +555,34 @@ public:
    */
   virtual Request* submitReadRequest(IoUringSocket& socket) PURE;
 
+  /**
+   * Submit a request receiving datagrams for a socket. The request completes for every received
+   * datagram while IORING_CQE_F_MORE is set.
+   */
+  virtual Request* submitRecvmsgRequest(IoUringSocket& socket) PURE;
+
   /**
    * Submit a write request for a socket.
    */
   virtual Request* submitWriteRequest(IoUringSocket& socket,
                                       const Buffer::RawSliceVector& slices) PURE;
 
+  /**
+   * Submit a zero-copy send request for a socket. The request takes the data to send from the
+   * front of the given buffer and keeps it alive until the kernel notifies that the data is no
+   * longer referenced, which may be after the request completion is delivered to the socket.
+   */
+  virtual Request* submitSendZcRequest(IoUringSocket& socket, Buffer::Instance& data) PURE;
+
+  /**
+   * Submit a request sending a datagram for a socket. The request copies the payload, the address
+   * and the control messages.
+   */
+  virtual Request* submitSendmsgRequest(IoUringSocket& socket, const Buffer::RawSlice* slices,
+                                        uint64_t num_slice,
+                                        const Network::Address::Instance& peer_address,
+                                        absl::string_view control) PURE;
+
   /**
    * Submit a close request for a socket.
    */
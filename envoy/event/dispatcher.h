@@ -10,6 +10,7 @@
 #include "envoy/common/time.h"
 #include "envoy/config/core/v3/resolver.pb.h"
 #include "envoy/config/core/v3/udp_socket_config.pb.h"
+#include "envoy/event/dispatcher_load.h"
 #include "envoy/event/dispatcher_thread_deletable.h"
 #include "envoy/event/file_event.h"
 #include "envoy/event/scaled_timer.h"
@@ -40,7 +41,8 @@ namespace Event {
  */
 #define ALL_DISPATCHER_STATS(HISTOGRAM)                                                            \
   HISTOGRAM(loop_duration_us, Microseconds)                                                        \
-  HISTOGRAM(poll_delay_us, Microseconds)
+  HISTOGRAM(poll_delay_us, Microseconds)                                                           \
+  HISTOGRAM(spin_duration_us, Microseconds)
 
 /**
  * Struct definition for all dispatcher stats. @see stats_macros.h
@@ -176,6 +178,11 @@ public:
    */
   virtual MonotonicTime approximateMonotonicTime() const PURE;
 
+  /**
+   * Returns the load of this dispatcher, which may be read from any thread.
+   */
+  virtual DispatcherLoad& load() PURE;
+
   /**
    * Initializes stats for this dispatcher. Note that this can't generally be done at construction
    * time, since the main and worker thread dispatchers are constructed before
@@ -271,6 +278,15 @@ public:
   };
   virtual void run(RunType type) PURE;
 
+  /**
+   * Enables hybrid polling for run() in the Block mode: after handling events, the event loop
+   * keeps polling for new events without blocking for up to spin_duration before it blocks in the
+   * kernel waiting for the next event. This trades CPU time for lower wake up latency. Must be
+   * called before run().
+   * @param spin_duration supplies how long to poll without blocking after the last event.
+   */
+  virtual void enableHybridPolling(std::chrono::microseconds spin_duration) PURE;
+
   /**
    * Returns a factory which connections may use for watermark buffer creation.
    * @return the watermark buffer factory for this dispatcher.
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+namespace Envoy {
+namespace Event {
+
+/**
+ * Load of a dispatcher. Updated on the dispatcher thread and readable from any thread, so that new
+ * work can be steered away from busy dispatchers, e.g. by connection balancers.
+ */
+class DispatcherLoad {
+public:
+  /**
+   * Enables tracking of the time the event loop spends handling events. Tracking is disabled by
+   * default since it costs a clock read per event loop iteration. May be called from any thread.
+   */
+  void enableBusyTracking() { busy_tracking_enabled_.store(true, std::memory_order_relaxed); }
+  bool busyTrackingEnabled() const {
+    return busy_tracking_enabled_.load(std::memory_order_relaxed);
+  }
+
+  /**
+   * @return the fraction of the last tracking period the event loop spent handling events rather
+   *         than waiting for them, in thousandths. Zero if busy tracking is disabled.
+   */
+  uint32_t busyPermille() const { return busy_permille_.load(std::memory_order_relaxed); }
+  void setBusyPermille(uint32_t busy_permille) {
+    busy_permille_.store(busy_permille, std::memory_order_relaxed);
+  }
+
+  /**
+   * Enables counting of the active streams handled by the dispatcher. Counting is disabled by
+   * default since it costs two atomic updates per stream. May be called from any thread.
+   */
+  void enableStreamTracking() { stream_tracking_enabled_.store(true, std::memory_order_relaxed); }
+  bool streamTrackingEnabled() const {
+    return stream_tracking_enabled_.load(std::memory_order_relaxed);
+  }
+
+  /**
+   * @return the number of active streams, e.g. HTTP requests, handled by the dispatcher. Streams
+   *         that started while stream tracking was disabled are not counted.
+   */
+  uint64_t activeStreams() const { return active_streams_.load(std::memory_order_relaxed); }
+  void incActiveStreams() { active_streams_.fetch_add(1, std::memory_order_relaxed); }
+  void decActiveStreams() { active_streams_.fetch_sub(1, std::memory_order_relaxed); }
+
+private:
+  std::atomic<bool> busy_tracking_enabled_{};
+  std::atomic<bool> stream_tracking_enabled_{};
+  std::atomic<uint32_t> busy_permille_{};
+  std::atomic<uint64_t> active_streams_{};
+};
+
+} // namespace Event
+} // namespace Envoy
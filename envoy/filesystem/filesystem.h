@@ -13,6 +13,7 @@
 #include "absl/status/statusor.h"
 #include "absl/strings/string_view.h"
 #include "absl/types/optional.h"
+#include "absl/types/span.h"
 
 namespace Envoy {
 namespace Filesystem {
@@ -77,6 +78,28 @@ public:
    */
   virtual Api::IoCallSizeResult write(absl::string_view buffer) PURE;
 
+  /**
+   * Write the slices to the file in order. The file must be explicitly opened before writing.
+   * Implementations may write all slices with a single system call; the default writes them one
+   * at a time, stopping at the first failed or short write.
+   *
+   * @return ssize_t total number of bytes written, or -1 for failure
+   */
+  virtual Api::IoCallSizeResult writev(absl::Span<const absl::string_view> slices) {
+    ssize_t written = 0;
+    for (absl::string_view slice : slices) {
+      Api::IoCallSizeResult result = write(slice);
+      if (!result.ok()) {
+        return result;
+      }
+      written += result.return_value_;
+      if (result.return_value_ != static_cast<ssize_t>(slice.size())) {
+        break;
+      }
+    }
+    return {written, Api::IoError::none()};
+  }
+
   /**
    * Get additional details about the file. May or may not require a file system operation.
    *
@@ -29,6 +29,18 @@ public:
    */
   virtual std::string format(const Context& context,
                              const StreamInfo::StreamInfo& stream_info) const PURE;
+
+  /**
+   * Append a formatted substitution line to the output. Callers that format many lines may reuse
+   * the output buffer across lines to avoid allocating a string per line.
+   * @param context supplies the formatter context.
+   * @param stream_info supplies the stream info.
+   * @param output supplies the buffer the formatted substitution line is appended to.
+   */
+  virtual void formatTo(const Context& context, const StreamInfo::StreamInfo& stream_info,
+                        std::string& output) const {
+    output.append(format(context, stream_info));
+  }
 };
 
 using FormatterPtr = std::unique_ptr<Formatter>;
@@ -60,6 +72,41 @@ public:
    */
   virtual Protobuf::Value formatValue(const Context& context,
                                       const StreamInfo::StreamInfo& stream_info) const PURE;
+
+  /**
+   * Append the value to the output buffer. This is equivalent to appending the value returned by
+   * format(), but allows providers to write the value without building intermediate strings.
+   * @param context supplies the formatter context.
+   * @param stream_info supplies the stream info.
+   * @param output supplies the buffer the value is appended to.
+   * @return bool true if the value was appended, false if there is no value. The output is left
+   *         unchanged in the latter case.
+   */
+  virtual bool formatTo(const Context& context, const StreamInfo::StreamInfo& stream_info,
+                        std::string& output) const {
+    const absl::optional<std::string> value = format(context, stream_info);
+    if (!value.has_value()) {
+      return false;
+    }
+    output.append(value.value());
+    return true;
+  }
+
+  /**
+   * Append the value to the output buffer as a JSON value of the type formatValue() returns,
+   * without building the Protobuf::Value.
+   * @param context supplies the formatter context.
+   * @param stream_info supplies the stream info.
+   * @param output supplies the buffer the JSON value is appended to.
+   * @param sanitize_buffer supplies a scratch buffer for the escaping of string values.
+   * @return bool false if the provider does not support this, in which case the output is left
+   *         unchanged and formatValue() has to be used instead. The default implementation
+   *         always returns false.
+   */
+  virtual bool formatJsonTo(const Context&, const StreamInfo::StreamInfo&, std::string&,
+                            std::string&) const {
+    return false;
+  }
 };
 
 using FormatterProviderPtr = std::unique_ptr<FormatterProvider>;
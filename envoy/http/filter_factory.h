@@ -52,11 +52,18 @@ public:
    *         nullopt if no decision can be made explicitly for the filter.
    */
   virtual absl::optional<bool> filterDisabled(absl::string_view config_name) const PURE;
+
+  /**
+   * @return false if filterDisabled() returns nullopt for every filter. The filter chain factory
+   *         then creates the filters that are enabled by default without calling filterDisabled().
+   */
+  virtual bool hasFilterDisabledOverrides() const { return true; }
 };
 
 class EmptyFilterChainOptions : public FilterChainOptions {
 public:
   absl::optional<bool> filterDisabled(absl::string_view) const override { return {}; }
+  bool hasFilterDisabledOverrides() const override { return false; }
 };
 
 /**
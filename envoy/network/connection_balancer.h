@@ -1,5 +1,6 @@
 #pragma once
 
+#include "envoy/event/dispatcher_load.h"
 #include "envoy/network/listen_socket.h"
 
 namespace Envoy {
@@ -27,6 +28,13 @@ public:
    */
   virtual void incNumConnections() PURE;
 
+  /**
+   * @return the load of the dispatcher the handler runs on, or nullptr if the handler does not
+   *         run on a dispatcher. Balancers may use it to account for the load of the worker
+   *         beyond the connections of this handler.
+   */
+  virtual Event::DispatcherLoad* dispatcherLoad() PURE;
+
   /**
    * Post a connected socket to this connection handler. This is used for cross-thread connection
    * transfer during the balancing process.
@@ -104,6 +104,26 @@ private:
 #define ENVOY_SOCKET_SO_REUSEPORT Network::SocketOptionName()
 #endif
 
+#ifdef SO_BUSY_POLL
+#define ENVOY_SOCKET_SO_BUSY_POLL ENVOY_MAKE_SOCKET_OPTION_NAME(SOL_SOCKET, SO_BUSY_POLL)
+#else
+#define ENVOY_SOCKET_SO_BUSY_POLL Network::SocketOptionName()
+#endif
+
+#ifdef SO_PREFER_BUSY_POLL
+#define ENVOY_SOCKET_SO_PREFER_BUSY_POLL                                                           \
+  ENVOY_MAKE_SOCKET_OPTION_NAME(SOL_SOCKET, SO_PREFER_BUSY_POLL)
+#else
+#define ENVOY_SOCKET_SO_PREFER_BUSY_POLL Network::SocketOptionName()
+#endif
+
+#ifdef SO_BUSY_POLL_BUDGET
+#define ENVOY_SOCKET_SO_BUSY_POLL_BUDGET                                                           \
+  ENVOY_MAKE_SOCKET_OPTION_NAME(SOL_SOCKET, SO_BUSY_POLL_BUDGET)
+#else
+#define ENVOY_SOCKET_SO_BUSY_POLL_BUDGET Network::SocketOptionName()
+#endif
+
 #ifdef SO_ORIGINAL_DST
 #define ENVOY_SOCKET_SO_ORIGINAL_DST ENVOY_MAKE_SOCKET_OPTION_NAME(SOL_IP, SO_ORIGINAL_DST)
 #else
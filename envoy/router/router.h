@@ -743,6 +743,39 @@ public:
 
 using VirtualHostConstSharedPtr = std::shared_ptr<const VirtualHost>;
 
+/**
+ * Latency tracking and hedging budget of the adaptive hedging of a route. It is shared by the
+ * requests of all workers, so implementations must be thread safe.
+ */
+class AdaptiveHedging {
+public:
+  virtual ~AdaptiveHedging() = default;
+
+  /**
+   * Called once for each request of the route, which counts it toward the hedging budget.
+   * @return the time after which an upstream request of the request should be hedged, or
+   *         absl::nullopt if too few latencies have been recorded to tell.
+   */
+  virtual absl::optional<std::chrono::milliseconds> onRequest() PURE;
+
+  /**
+   * Records the latency of an upstream request of the route.
+   * @param latency supplies the time from the start of the upstream request to its response
+   *        headers.
+   */
+  virtual void recordLatency(std::chrono::microseconds latency) PURE;
+
+  /**
+   * @return whether a hedged request can be sent without exceeding the hedging budget.
+   */
+  virtual bool canHedge() const PURE;
+
+  /**
+   * Charges a hedged request to the hedging budget.
+   */
+  virtual void onHedge() PURE;
+};
+
 /**
  * Route level hedging policy.
  */
@@ -767,6 +800,12 @@ public:
    * will be canceled immediately.
    */
   virtual bool hedgeOnPerTryTimeout() const PURE;
+
+  /**
+   * @return the adaptive hedging of the route, if configured. Adaptive hedging implies
+   *         hedgeOnPerTryTimeout().
+   */
+  virtual OptRef<AdaptiveHedging> adaptiveHedging() const PURE;
 };
 
 class MetadataMatchCriterion {
@@ -1275,6 +1314,14 @@ public:
    */
   virtual absl::optional<bool> filterDisabled(absl::string_view config_name) const PURE;
 
+  /**
+   * @return false if filterDisabled() returns nullopt for every filter, i.e. no filter is
+   *         configured on the route, its virtual host or its route configuration. The HTTP filter
+   *         chain of such a route only depends on the filters that are disabled by default. Routes
+   *         that do not implement this are assumed to have overrides.
+   */
+  virtual bool hasFilterDisabledOverrides() const { return true; }
+
   /**
    * This is a helper to get the route's per-filter config if it exists, up along the config
    * hierarchy(Route --> VirtualHost --> RouteConfiguration). Or nullptr if none of them exist.
@@ -222,6 +222,12 @@ public:
    */
   virtual std::chrono::milliseconds fileFlushIntervalMsec() const PURE;
 
+  /**
+   * @return uint64_t the number of bytes each log file may buffer in addition to the buffers of
+   *         the threads writing to it before further log lines are dropped, or 0 for no limit.
+   */
+  virtual uint64_t fileFlushMaxBufferedBytes() const PURE;
+
   /**
    * @return const std::string& the server's cluster.
    */
@@ -226,6 +226,12 @@ public:
    */
   virtual bool preferClientCiphers() const PURE;
 
+  /**
+   * @return true if the record layer of the sessions is offloaded to the kernel once their
+   * handshake is complete, false otherwise.
+   */
+  virtual bool kernelTlsOffload() const PURE;
+
   /**
    * @return a factory which can be used to create TLS context provider instances.
    */
@@ -169,6 +169,12 @@ public:
    * @return the const SSL connection data of upstream.
    */
   virtual Ssl::ConnectionInfoConstSharedPtr getUpstreamConnectionSslInfo() PURE;
+
+  /**
+   * @return the upstream network connection if the payload is written to it as is rather than
+   *         tunneled, nullptr otherwise.
+   */
+  virtual Network::Connection* rawConnection() PURE;
 };
 
 using GenericConnPoolPtr = std::unique_ptr<GenericConnPool>;
@@ -4,6 +4,7 @@
 #include <limits>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "envoy/common/pure.h"
 
@@ -65,6 +66,9 @@ struct Options {
   // If no value is set, the thread will be created with the default thread priority for the
   // platform.
   absl::optional<int> priority_{absl::nullopt};
+  // The CPUs the thread is allowed to run on. This is only supported on Linux. If empty, the thread
+  // inherits the CPU affinity of the creating thread.
+  std::vector<uint32_t> cpu_affinity_;
 };
 
 using OptionsOptConstRef = const absl::optional<Options>&;
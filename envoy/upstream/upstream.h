@@ -701,6 +701,8 @@ public:
   COUNTER(upstream_cx_none_healthy)                                                                \
   COUNTER(upstream_cx_overflow)                                                                    \
   COUNTER(upstream_cx_pool_overflow)                                                               \
+  COUNTER(upstream_cx_preconnect_unused)                                                           \
+  COUNTER(upstream_cx_preconnect_used)                                                             \
   COUNTER(upstream_cx_protocol_error)                                                              \
   COUNTER(upstream_cx_rx_bytes_total)                                                              \
   COUNTER(upstream_cx_total)                                                                       \
@@ -713,6 +715,9 @@ public:
   COUNTER(upstream_internal_redirect_succeeded_total)                                              \
   COUNTER(upstream_rq_cancelled)                                                                   \
   COUNTER(upstream_rq_completed)                                                                   \
+  COUNTER(upstream_rq_hedge_launched)                                                              \
+  COUNTER(upstream_rq_hedge_wasted)                                                                \
+  COUNTER(upstream_rq_hedge_won)                                                                   \
   COUNTER(upstream_rq_maintenance_mode)                                                            \
   COUNTER(upstream_rq_max_duration_reached)                                                        \
   COUNTER(upstream_rq_pending_failure_eject)                                                       \
@@ -940,6 +945,12 @@ public:
    */
   virtual float peekaheadRatio() const PURE;
 
+  /**
+   * @return the maximum number of streams anticipated per upstream by adaptive preconnecting, or
+   *         absl::nullopt if adaptive preconnecting is disabled.
+   */
+  virtual absl::optional<uint32_t> adaptivePreconnectMaxStreams() const PURE;
+
   /**
    * @return soft limit on size of the cluster's connections read and write buffers.
    */
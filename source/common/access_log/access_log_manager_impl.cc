@@ -1,5 +1,7 @@
 #include "source/common/access_log/access_log_manager_impl.h"
 
+#include <algorithm>
+#include <cstring>
 #include <string>
 
 #include "envoy/common/exception.h"
@@ -16,8 +18,13 @@ namespace {
 static constexpr Filesystem::FlagSet default_flags{1 << Filesystem::File::Operation::Write |
                                                    1 << Filesystem::File::Operation::Create |
                                                    1 << Filesystem::File::Operation::Append};
+
+std::atomic<uint64_t> next_file_id{0};
 } // namespace
 
+thread_local absl::flat_hash_map<uint64_t, AccessLogFileImpl::ThreadBuffer*>
+    AccessLogFileImpl::current_thread_buffers_;
+
 AccessLogManagerImpl::~AccessLogManagerImpl() {
   for (auto& [log_key, log_file_ptr] : access_logs_) {
     ENVOY_LOG(debug, "destroying access logger {}", log_key);
@@ -46,23 +53,61 @@ AccessLogManagerImpl::createAccessLog(const Filesystem::FilePathAndType& file_in
                                                   open_result.err_->getErrorDetails()));
   }
 
-  access_logs_[file_name] =
-      std::make_shared<AccessLogFileImpl>(std::move(file), dispatcher_, lock_, file_stats_,
-                                          file_flush_interval_msec_, api_.threadFactory());
+  access_logs_[file_name] = std::make_shared<AccessLogFileImpl>(
+      std::move(file), dispatcher_, lock_, file_stats_, file_flush_interval_msec_,
+      api_.threadFactory(), file_max_buffered_bytes_);
   return access_logs_[file_name];
 }
 
+WriteRing::WriteRing(uint64_t capacity) : mask_(capacity - 1), data_(new char[capacity]) {
+  ASSERT(capacity > 0 && (capacity & mask_) == 0);
+}
+
+bool WriteRing::write(absl::string_view data) {
+  const uint64_t head = head_.load(std::memory_order_relaxed);
+  if (capacity() - (head - tail_.load(std::memory_order_acquire)) < data.size()) {
+    return false;
+  }
+  if (data.empty()) {
+    return true;
+  }
+  const uint64_t offset = head & mask_;
+  const uint64_t first = std::min<uint64_t>(data.size(), capacity() - offset);
+  memcpy(data_.get() + offset, data.data(), first);
+  memcpy(data_.get(), data.data() + first, data.size() - first);
+  head_.store(head + data.size(), std::memory_order_release);
+  return true;
+}
+
+uint64_t WriteRing::peek(std::vector<absl::string_view>& slices) const {
+  const uint64_t tail = tail_.load(std::memory_order_relaxed);
+  const uint64_t head = head_.load(std::memory_order_acquire);
+  const uint64_t size = head - tail;
+  if (size == 0) {
+    return head;
+  }
+  const uint64_t offset = tail & mask_;
+  const uint64_t first = std::min<uint64_t>(size, capacity() - offset);
+  slices.emplace_back(data_.get() + offset, first);
+  if (first < size) {
+    slices.emplace_back(data_.get(), size - first);
+  }
+  return head;
+}
+
 AccessLogFileImpl::AccessLogFileImpl(Filesystem::FilePtr&& file, Event::Dispatcher& dispatcher,
                                      Thread::BasicLockable& lock, AccessLogFileStats& stats,
                                      std::chrono::milliseconds flush_interval_msec,
-                                     Thread::ThreadFactory& thread_factory)
-    : file_(std::move(file)), file_lock_(lock),
+                                     Thread::ThreadFactory& thread_factory,
+                                     uint64_t max_buffered_bytes)
+    : id_(next_file_id++), file_(std::move(file)), file_lock_(lock),
       flush_timer_(dispatcher.createTimer([this]() -> void {
         stats_.flushed_by_timer_.inc();
         flush_event_.notifyOne();
         flush_timer_->enableTimer(flush_interval_msec_);
       })),
-      thread_factory_(thread_factory), flush_interval_msec_(flush_interval_msec), stats_(stats) {
+      thread_factory_(thread_factory), flush_interval_msec_(flush_interval_msec),
+      max_buffered_bytes_(max_buffered_bytes), stats_(stats) {
   flush_timer_->enableTimer(flush_interval_msec_);
 }
 
@@ -85,17 +130,46 @@ AccessLogFileImpl::~AccessLogFileImpl() {
 
   // Flush any remaining data. If file was not opened for some reason, skip flushing part.
   if (file_->isOpen()) {
-    if (flush_buffer_.length() > 0) {
-      doWrite(flush_buffer_);
-    }
+    flush();
     const Api::IoCallBoolResult result = file_->close();
     ASSERT(result.return_value_, fmt::format("unable to close file '{}': {}", file_->path(),
                                              result.err_->getErrorDetails()));
   }
 }
 
-void AccessLogFileImpl::doWrite(Buffer::Instance& buffer) {
-  Buffer::RawSliceVector slices = buffer.getRawSlices();
+bool AccessLogFileImpl::hasBufferedData() {
+  if (flush_buffer_.length() > 0) {
+    return true;
+  }
+  return std::any_of(thread_buffers_.begin(), thread_buffers_.end(),
+                     [](const auto& buffer) { return buffer->ring_.size() > 0; });
+}
+
+bool AccessLogFileImpl::collectBufferedData() {
+  // The rings are collected before flush_buffer_, and the threads that wrote to flush_buffer_
+  // because their ring was full only go back to their ring after this, so that the lines of each
+  // thread are written in order.
+  for (const auto& buffer : thread_buffers_) {
+    const size_t num_slices = about_to_write_slices_.size();
+    const uint64_t end = buffer->ring_.peek(about_to_write_slices_);
+    if (about_to_write_slices_.size() != num_slices) {
+      about_to_consume_.emplace_back(&buffer->ring_, end);
+    }
+    buffer->overflowed_.store(false, std::memory_order_relaxed);
+  }
+  about_to_write_buffer_.move(flush_buffer_);
+  ASSERT(flush_buffer_.length() == 0);
+  return !about_to_write_slices_.empty() || about_to_write_buffer_.length() > 0;
+}
+
+void AccessLogFileImpl::doWrite() {
+  uint64_t length = about_to_write_buffer_.length();
+  for (absl::string_view slice : about_to_write_slices_) {
+    length += slice.size();
+  }
+  for (const Buffer::RawSlice& slice : about_to_write_buffer_.getRawSlices()) {
+    about_to_write_slices_.emplace_back(static_cast<const char*>(slice.mem_), slice.len_);
+  }
 
   // We must do the actual writes to disk under lock, so that we don't intermix chunks from
   // different AccessLogFileImpl pointing to the same underlying file. This can happen either via
@@ -105,22 +179,24 @@ void AccessLogFileImpl::doWrite(Buffer::Instance& buffer) {
   //            will never block network workers, but does mean that only a single flush thread can
   //            actually flush to disk. In the future it would be nice if we did away with the cross
   //            process lock or had multiple locks.
-  {
+  if (!about_to_write_slices_.empty()) {
     Thread::LockGuard lock(file_lock_);
-    for (const Buffer::RawSlice& slice : slices) {
-      absl::string_view data(static_cast<char*>(slice.mem_), slice.len_);
-      const Api::IoCallSizeResult result = file_->write(data);
-      if (result.ok() && result.return_value_ == static_cast<ssize_t>(slice.len_)) {
-        stats_.write_completed_.inc();
-      } else {
-        // Probably disk full.
-        stats_.write_failed_.inc();
-      }
+    const Api::IoCallSizeResult result = file_->writev(about_to_write_slices_);
+    if (result.ok() && result.return_value_ == static_cast<ssize_t>(length)) {
+      stats_.write_completed_.inc();
+    } else {
+      // Probably disk full.
+      stats_.write_failed_.inc();
     }
   }
 
-  stats_.write_total_buffered_.sub(buffer.length());
-  buffer.drain(buffer.length());
+  stats_.write_total_buffered_.sub(length);
+  for (const auto& [ring, end] : about_to_consume_) {
+    ring->consume(end);
+  }
+  about_to_consume_.clear();
+  about_to_write_slices_.clear();
+  about_to_write_buffer_.drain(about_to_write_buffer_.length());
 }
 
 void AccessLogFileImpl::flushThreadFunc() {
@@ -136,13 +212,13 @@ void AccessLogFileImpl::flushThreadFunc() {
     {
       Thread::LockGuard write_lock(write_lock_);
 
-      // flush_event_ can be woken up either by large enough flush_buffer or by timer.
-      // In case it was timer, flush_buffer_ can be empty.
+      // flush_event_ can be woken up either by large enough flush_buffer or ring, or by timer.
+      // In case it was timer, there can be no buffered data.
       //
       // Note: do not stop waiting when only `do_reopen` is true. In this case, we tried to
       // reopen and failed. We don't want to retry this in a tight loop, so wait for the next
       // event (timer or flush).
-      while (flush_buffer_.length() == 0 && !flush_thread_exit_ && !reopen_file_) {
+      while (!hasBufferedData() && !flush_thread_exit_ && !reopen_file_) {
         // CondVar::wait() does not throw, so it's safe to pass the mutex rather than the guard.
         flush_event_.wait(write_lock_);
       }
@@ -152,8 +228,7 @@ void AccessLogFileImpl::flushThreadFunc() {
       }
 
       flush_lock = std::unique_lock<Thread::BasicLockable>(flush_lock_);
-      about_to_write_buffer_.move(flush_buffer_);
-      ASSERT(flush_buffer_.length() == 0);
+      collectBufferedData();
 
       if (reopen_file_) {
         do_reopen = true;
@@ -175,7 +250,7 @@ void AccessLogFileImpl::flushThreadFunc() {
       }
     }
     // doWrite no matter file isOpen, if not, we can drain buffer
-    doWrite(about_to_write_buffer_);
+    doWrite();
   }
 }
 
@@ -186,32 +261,70 @@ void AccessLogFileImpl::flush() {
     Thread::LockGuard write_lock(write_lock_);
 
     // flush_lock_ must be held while checking this or else it is
-    // possible that flushThreadFunc() has already moved data from
-    // flush_buffer_ to about_to_write_buffer_, has unlocked write_lock_,
-    // but has not yet completed doWrite(). This would allow flush() to
-    // return before the pending data has actually been written to disk.
+    // possible that flushThreadFunc() has already collected the buffered
+    // data, has unlocked write_lock_, but has not yet completed doWrite().
+    // This would allow flush() to return before the pending data has
+    // actually been written to disk.
     flush_buffer_lock = std::unique_lock<Thread::BasicLockable>(flush_lock_);
 
-    if (flush_buffer_.length() == 0) {
+    if (!collectBufferedData()) {
       return;
     }
-
-    about_to_write_buffer_.move(flush_buffer_);
-    ASSERT(flush_buffer_.length() == 0);
   }
 
-  doWrite(about_to_write_buffer_);
+  doWrite();
 }
 
 void AccessLogFileImpl::write(absl::string_view data) {
+  stats_.write_total_buffered_.add(data.length());
+
+  ThreadBuffer*& buffer = current_thread_buffers_[id_];
+  if (buffer != nullptr && !buffer->overflowed_.load(std::memory_order_relaxed) &&
+      buffer->ring_.write(data)) {
+    stats_.write_buffered_.inc();
+    // Tell the flush thread to flush once when the ring gets half full rather than on every
+    // write. Notifying under the lock makes sure that the flush thread is not about to wait
+    // after it found the ring empty.
+    const uint64_t size = buffer->ring_.size();
+    if (size >= RING_SIZE / 2 && size < RING_SIZE / 2 + data.size()) {
+      Thread::LockGuard lock(write_lock_);
+      flush_event_.notifyOne();
+    }
+    return;
+  }
+
+  writeLocked(buffer, data);
+}
+
+void AccessLogFileImpl::writeLocked(ThreadBuffer*& buffer, absl::string_view data) {
   Thread::LockGuard lock(write_lock_);
 
   if (flush_thread_ == nullptr) {
     createFlushStructures();
   }
 
+  if (buffer == nullptr) {
+    thread_buffers_.push_back(std::make_unique<ThreadBuffer>());
+    buffer = thread_buffers_.back().get();
+  }
+
+  // The ring can be used again if flush_buffer_ was collected since the ring was found full.
+  if (!buffer->overflowed_.load(std::memory_order_relaxed) && buffer->ring_.write(data)) {
+    stats_.write_buffered_.inc();
+    if (buffer->ring_.size() >= RING_SIZE / 2) {
+      flush_event_.notifyOne();
+    }
+    return;
+  }
+
+  if (max_buffered_bytes_ != 0 && flush_buffer_.length() + data.size() > max_buffered_bytes_) {
+    stats_.write_dropped_.inc();
+    stats_.write_total_buffered_.sub(data.length());
+    return;
+  }
+
+  buffer->overflowed_.store(true, std::memory_order_relaxed);
   stats_.write_buffered_.inc();
-  stats_.write_total_buffered_.add(data.length());
   flush_buffer_.add(data.data(), data.size());
   if (flush_buffer_.length() > MIN_FLUSH_SIZE) {
     flush_event_.notifyOne();
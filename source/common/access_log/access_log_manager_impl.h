@@ -1,6 +1,9 @@
 #pragma once
 
+#include <atomic>
+#include <memory>
 #include <string>
+#include <vector>
 
 #include "envoy/access_log/access_log.h"
 #include "envoy/api/api.h"
@@ -13,6 +16,7 @@
 #include "source/common/common/logger.h"
 #include "source/common/common/thread.h"
 
+#include "absl/container/flat_hash_map.h"
 #include "absl/container/node_hash_map.h"
 
 namespace Envoy {
@@ -22,6 +26,7 @@ namespace Envoy {
   COUNTER(reopen_failed)                                                                           \
   COUNTER(write_buffered)                                                                          \
   COUNTER(write_completed)                                                                         \
+  COUNTER(write_dropped)                                                                           \
   COUNTER(write_failed)                                                                            \
   GAUGE(write_total_buffered, Accumulate)
 
@@ -35,8 +40,9 @@ class AccessLogManagerImpl : public AccessLogManager, Logger::Loggable<Logger::I
 public:
   AccessLogManagerImpl(std::chrono::milliseconds file_flush_interval_msec, Api::Api& api,
                        Event::Dispatcher& dispatcher, Thread::BasicLockable& lock,
-                       Stats::Store& stats_store)
-      : file_flush_interval_msec_(file_flush_interval_msec), api_(api), dispatcher_(dispatcher),
+                       Stats::Store& stats_store, uint64_t file_max_buffered_bytes = 0)
+      : file_flush_interval_msec_(file_flush_interval_msec),
+        file_max_buffered_bytes_(file_max_buffered_bytes), api_(api), dispatcher_(dispatcher),
         lock_(lock),
         file_stats_{ACCESS_LOG_FILE_STATS(POOL_COUNTER_PREFIX(stats_store, "filesystem."),
                                           POOL_GAUGE_PREFIX(stats_store, "filesystem."))} {}
@@ -49,6 +55,7 @@ public:
 
 private:
   const std::chrono::milliseconds file_flush_interval_msec_;
+  const uint64_t file_max_buffered_bytes_;
   Api::Api& api_;
   Event::Dispatcher& dispatcher_;
   Thread::BasicLockable& lock_;
@@ -56,19 +63,77 @@ private:
   absl::node_hash_map<std::string, AccessLogFileSharedPtr> access_logs_;
 };
 
+/**
+ * A ring of bytes with a single producer and a single consumer thread, which do not need to lock
+ * to append and release data.
+ */
+class WriteRing {
+public:
+  /**
+   * @param capacity supplies the size of the ring in bytes, which must be a power of two.
+   */
+  explicit WriteRing(uint64_t capacity);
+
+  /**
+   * Append data to the ring. Only called by the producer.
+   * @return false if the ring does not have room for all of the data, in which case nothing is
+   *         appended.
+   */
+  bool write(absl::string_view data);
+
+  /**
+   * @return the number of bytes in the ring.
+   */
+  uint64_t size() const {
+    return head_.load(std::memory_order_acquire) - tail_.load(std::memory_order_acquire);
+  }
+
+  /**
+   * @return the size of the ring in bytes.
+   */
+  uint64_t capacity() const { return mask_ + 1; }
+
+  /**
+   * Append the bytes in the ring to slices, as up to two slices as the data may wrap around the
+   * end of the ring. The slices stay valid until they are released with consume(). Only called by
+   * the consumer.
+   * @return the position up to which data was returned, to be passed to consume().
+   */
+  uint64_t peek(std::vector<absl::string_view>& slices) const;
+
+  /**
+   * Release the bytes up to position end, as returned by peek(), to the producer. Only called by
+   * the consumer.
+   */
+  void consume(uint64_t end) { tail_.store(end, std::memory_order_release); }
+
+private:
+  const uint64_t mask_;
+  const std::unique_ptr<char[]> data_;
+  // The number of bytes ever appended by the producer and released by the consumer, respectively.
+  // They are on separate cache lines so that the producer and the consumer do not contend.
+  alignas(64) std::atomic<uint64_t> head_{0};
+  alignas(64) std::atomic<uint64_t> tail_{0};
+};
+
 /**
  * This is a file implementation geared for writing out access logs. It turn out that in certain
  * cases even if a standard file is opened with O_NONBLOCK, the kernel can still block when writing.
  * This implementation uses a flush thread per file, with the idea there aren't that many
  * files. If this turns out to be a good implementation we can potentially have a single flush
  * thread that flushes all files, but we will start with this.
+ *
+ * Each thread writing to the file appends to a WriteRing of its own without taking a lock, which
+ * the flush thread drains with a single vectored write. When the ring of a thread is full, the
+ * thread appends to a shared overflow buffer under a lock until the flush thread drained it, which
+ * keeps the lines of each thread in order. The lines of different threads are not ordered.
  */
 class AccessLogFileImpl : public AccessLogFile {
 public:
   AccessLogFileImpl(Filesystem::FilePtr&& file, Event::Dispatcher& dispatcher,
                     Thread::BasicLockable& lock, AccessLogFileStats& stats,
                     std::chrono::milliseconds flush_interval_msec,
-                    Thread::ThreadFactory& thread_factory);
+                    Thread::ThreadFactory& thread_factory, uint64_t max_buffered_bytes = 0);
   ~AccessLogFileImpl() override;
 
   // AccessLog::AccessLogFile
@@ -83,12 +148,35 @@ public:
   void flush() override;
 
 private:
-  void doWrite(Buffer::Instance& buffer);
+  // Minimum size before the flush thread will be told to flush.
+  static const uint64_t MIN_FLUSH_SIZE = 1024 * 64;
+  // Size of the ring of each thread writing to the file. The flush thread is told to flush once a
+  // ring is half full.
+  static const uint64_t RING_SIZE = 1024 * 64;
+
+  // The buffer of a thread writing to the file.
+  struct ThreadBuffer {
+    ThreadBuffer() : ring_(RING_SIZE) {}
+
+    WriteRing ring_;
+    // Set by the thread once its ring was full and it wrote to flush_buffer_ instead, and cleared
+    // when flush_buffer_ is flushed. The thread writes to flush_buffer_ while this is set, so that
+    // its lines stay in order. Only modified while write_lock_ is held.
+    std::atomic<bool> overflowed_{false};
+  };
+
+  void writeLocked(ThreadBuffer*& buffer, absl::string_view data);
+  bool hasBufferedData() ABSL_EXCLUSIVE_LOCKS_REQUIRED(write_lock_);
+  bool collectBufferedData() ABSL_EXCLUSIVE_LOCKS_REQUIRED(write_lock_);
+  void doWrite();
   void flushThreadFunc();
   void createFlushStructures();
 
-  // Minimum size before the flush thread will be told to flush.
-  static const uint64_t MIN_FLUSH_SIZE = 1024 * 64;
+  // The buffers of the files the current thread has written to, by file id. Unlike the addresses
+  // of the files, the ids are never reused.
+  static thread_local absl::flat_hash_map<uint64_t, ThreadBuffer*> current_thread_buffers_;
+
+  const uint64_t id_;
 
   Filesystem::FilePtr file_;
 
@@ -106,17 +194,20 @@ private:
                                           // and all other data used during flushing and file
                                           // re-opening.
   Thread::MutexBasicLockable
-      write_lock_; // The lock is used when filling the flush buffer. It allows
-                   // multiple threads to write to the same file at relatively
-                   // high performance. It is always local to the process.
+      write_lock_; // The lock is used when filling the flush buffer and when adding
+                   // the buffer of a thread. It allows multiple threads to write to
+                   // the same file at relatively high performance. It is always
+                   // local to the process.
   Thread::ThreadPtr flush_thread_;
   Thread::CondVar flush_event_;
   bool flush_thread_exit_ ABSL_GUARDED_BY(write_lock_){false};
   bool reopen_file_ ABSL_GUARDED_BY(write_lock_){false};
   Buffer::OwnedImpl
-      flush_buffer_ ABSL_GUARDED_BY(write_lock_); // This buffer is used by multiple threads. It
-                                                  // gets filled and then flushed either when max
-                                                  // size is reached or when a timer fires.
+      flush_buffer_ ABSL_GUARDED_BY(write_lock_); // This buffer is used by multiple threads whose
+                                                  // ring is full. It gets filled and then flushed
+                                                  // either when max size is reached or when a
+                                                  // timer fires.
+  std::vector<std::unique_ptr<ThreadBuffer>> thread_buffers_ ABSL_GUARDED_BY(write_lock_);
   // TODO(jmarantz): this should be ABSL_GUARDED_BY(flush_lock_) but the analysis cannot poke
   // through the std::make_unique assignment. I do not believe it's possible to annotate this
   // properly now due to limitations in the clang thread annotation analysis.
@@ -125,11 +216,17 @@ private:
                                             // the lock is released so that flush_buffer_ can
                                             // continue to fill. This buffer is then used for the
                                             // final write to disk.
+  // The data of the rings that is about to be written, and the positions up to which the rings
+  // are released once it is. These are only used while flush_lock_ is held.
+  std::vector<absl::string_view> about_to_write_slices_;
+  std::vector<std::pair<WriteRing*, uint64_t>> about_to_consume_;
   Event::TimerPtr flush_timer_;
   Thread::ThreadFactory& thread_factory_;
   const std::chrono::milliseconds flush_interval_msec_; // Time interval buffer gets flushed no
                                                         // matter if it reached the MIN_FLUSH_SIZE
                                                         // or not.
+  const uint64_t max_buffered_bytes_; // Bytes flush_buffer_ may hold before further writes of
+                                      // threads whose ring is full are dropped, if not 0.
   AccessLogFileStats& stats_;
 };
 
@@ -4,6 +4,7 @@
 #include <memory>
 #include <string>
 
+#include "source/common/buffer/search_kernels.h"
 #include "source/common/common/assert.h"
 
 #include "absl/container/fixed_array.h"
@@ -11,13 +12,135 @@
 
 namespace Envoy {
 namespace Buffer {
-namespace {
-// This size has been determined to be optimal from running the
-// //test/integration:http_benchmark benchmark tests.
-// TODO(yanavlasov): This may not be optimal for all hardware configurations or traffic patterns and
-// may need to be configurable in the future.
-constexpr uint64_t CopyThreshold = 512;
-} // namespace
+thread_local SliceStoragePool* SliceStoragePool::current_ = nullptr;
+
+SliceStoragePoolPtr SliceStoragePool::create(uint64_t max_retained_bytes) {
+  return SliceStoragePoolPtr{new SliceStoragePool(max_retained_bytes)};
+}
+
+SliceStoragePool::~SliceStoragePool() {
+  ASSERT(refs_.load() == 0);
+  ASSERT(retained_bytes_ == 0);
+  // Remote frees can race with the owner releasing the pool. Those blocks are only freed here.
+  FreeBlock* block = remote_frees_.exchange(nullptr);
+  while (block != nullptr) {
+    FreeBlock* next = block->next_;
+    delete[] reinterpret_cast<uint8_t*>(block);
+    block = next;
+  }
+}
+
+void SliceStoragePool::initializeStats(Stats::Scope& scope, const std::string& prefix) {
+  ASSERT(current_ == this);
+  stats_ = std::make_unique<SliceStoragePoolStats>(SliceStoragePoolStats{
+      ALL_SLICE_STORAGE_POOL_STATS(POOL_COUNTER_PREFIX(scope, prefix),
+                                   POOL_GAUGE_PREFIX(scope, prefix))});
+  stats_->retained_bytes_.set(retained_bytes_);
+}
+
+SliceStoragePtr SliceStoragePool::allocate(uint64_t size) {
+  ASSERT(current_ == this);
+  ASSERT(isPoolable(size));
+  const uint32_t size_class = size / PageSize - 1;
+  refs_.fetch_add(1, std::memory_order_relaxed);
+
+  if (free_lists_[size_class] == nullptr) {
+    reclaimRemoteFrees();
+  }
+  FreeBlock* block = free_lists_[size_class];
+  if (block == nullptr) {
+    if (stats_ != nullptr) {
+      stats_->misses_.inc();
+    }
+    return {new uint8_t[size], SliceStorageDeleter(this, size_class)};
+  }
+
+  free_lists_[size_class] = block->next_;
+  retained_bytes_ -= size;
+  if (stats_ != nullptr) {
+    stats_->hits_.inc();
+    stats_->retained_bytes_.sub(size);
+  }
+  return {reinterpret_cast<uint8_t*>(block), SliceStorageDeleter(this, size_class)};
+}
+
+void SliceStoragePool::deallocate(uint8_t* mem, uint32_t size_class) {
+  FreeBlock* block = reinterpret_cast<FreeBlock*>(mem);
+  block->size_class_ = size_class;
+  if (current_ == this) {
+    retainOrFree(block);
+  } else if (owner_released_.load(std::memory_order_acquire)) {
+    delete[] mem;
+  } else {
+    // Hand the block back to the owning thread. The owner only ever takes the whole stack at once,
+    // so a plain CAS push is not subject to ABA.
+    block->next_ = remote_frees_.load(std::memory_order_relaxed);
+    while (!remote_frees_.compare_exchange_weak(block->next_, block, std::memory_order_release,
+                                                std::memory_order_relaxed)) {
+    }
+  }
+  unref();
+}
+
+void SliceStoragePool::retainOrFree(FreeBlock* block) {
+  const uint64_t size = classSize(block->size_class_);
+  if (retained_bytes_ + size > max_retained_bytes_) {
+    if (stats_ != nullptr) {
+      stats_->overflow_frees_.inc();
+    }
+    delete[] reinterpret_cast<uint8_t*>(block);
+    return;
+  }
+  block->next_ = free_lists_[block->size_class_];
+  free_lists_[block->size_class_] = block;
+  retained_bytes_ += size;
+  if (stats_ != nullptr) {
+    stats_->retained_bytes_.add(size);
+  }
+}
+
+void SliceStoragePool::reclaimRemoteFrees() {
+  FreeBlock* block = remote_frees_.exchange(nullptr, std::memory_order_acquire);
+  while (block != nullptr) {
+    FreeBlock* next = block->next_;
+    if (stats_ != nullptr) {
+      stats_->remote_frees_.inc();
+    }
+    retainOrFree(block);
+    block = next;
+  }
+}
+
+void SliceStoragePool::releaseOwner() {
+  if (current_ == this) {
+    current_ = nullptr;
+  }
+  owner_released_.store(true, std::memory_order_release);
+
+  // Blocks that are still outstanding are freed to the global allocator from now on, so there is
+  // no point in keeping the free lists around until the last of them comes back.
+  for (FreeBlock*& head : free_lists_) {
+    while (head != nullptr) {
+      FreeBlock* block = head;
+      head = block->next_;
+      delete[] reinterpret_cast<uint8_t*>(block);
+    }
+  }
+  retained_bytes_ = 0;
+  if (stats_ != nullptr) {
+    stats_->retained_bytes_.set(0);
+    stats_.reset();
+  }
+  unref();
+}
+
+void SliceStoragePool::unref() {
+  if (refs_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+    delete this;
+  }
+}
+
+void SliceStoragePoolReleaser::operator()(SliceStoragePool* pool) const { pool->releaseOwner(); }
 
 thread_local absl::InlinedVector<Slice::StoragePtr,
                                  OwnedImpl::OwnedImplReservationSlicesOwnerMultiple::free_list_max_>
@@ -499,87 +622,109 @@ void OwnedImpl::commit(uint64_t length, absl::Span<RawSlice> slices,
   }
 }
 
+uint64_t OwnedImpl::searchEnd(size_t start, size_t length) const {
+  // length equal to zero means that entire buffer must be searched.
+  if (length == 0) {
+    return length_;
+  }
+  return std::min<uint64_t>(length_, static_cast<uint64_t>(start) + length);
+}
+
+bool OwnedImpl::matchesAt(size_t slice_index, uint64_t offset, const uint8_t* data,
+                          uint64_t size) const {
+  while (size > 0) {
+    if (slice_index == slices_.size()) {
+      return false;
+    }
+    const Slice& slice = slices_[slice_index];
+    ASSERT(offset <= slice.dataSize());
+    const uint64_t compare_size = std::min(size, slice.dataSize() - offset);
+    if (memcmp(slice.data() + offset, data, compare_size) != 0) {
+      return false;
+    }
+    data += compare_size;
+    size -= compare_size;
+    offset = 0;
+    slice_index++;
+  }
+  return true;
+}
+
 ssize_t OwnedImpl::search(const void* data, uint64_t size, size_t start, size_t length) const {
-  // This implementation uses the same search algorithm as evbuffer_search(), a naive
-  // scan that requires O(M*N) comparisons in the worst case.
-  // TODO(brian-pane): replace this with a more efficient search if it shows up
-  // prominently in CPU profiling.
   if (size == 0) {
     return (start <= length_) ? start : -1;
   }
 
-  // length equal to zero means that entire buffer must be searched.
-  // Adjust the length to buffer length taking the staring index into account.
-  size_t left_to_search = length;
-  if (0 == length) {
-    left_to_search = length_ - start;
+  const uint64_t end = searchEnd(start, length);
+  if (start >= end || end - start < size) {
+    return -1;
   }
-  ssize_t offset = 0;
+
   const uint8_t* needle = static_cast<const uint8_t*>(data);
-  for (size_t slice_index = 0; slice_index < slices_.size() && (left_to_search > 0);
+  uint64_t slice_offset = 0;
+  // A match must start at or before `end - size`, so there is nothing left to find once the
+  // current slice starts after that.
+  for (size_t slice_index = 0; slice_index < slices_.size() && slice_offset + size <= end;
        slice_index++) {
-    const auto& slice = slices_[slice_index];
-    uint64_t slice_size = slice.dataSize();
-    if (slice_size <= start) {
-      start -= slice_size;
-      offset += slice_size;
+    const Slice& slice = slices_[slice_index];
+    const uint64_t slice_end = slice_offset + slice.dataSize();
+    if (slice_end <= start) {
+      slice_offset = slice_end;
       continue;
     }
-    const uint8_t* slice_start = slice.data();
-    const uint8_t* haystack = slice_start;
-    const uint8_t* haystack_end = haystack + slice_size;
-    haystack += start;
-    while (haystack < haystack_end) {
-      const size_t slice_search_limit =
-          std::min(static_cast<size_t>(haystack_end - haystack), left_to_search);
-      // Search within this slice for the first byte of the needle.
-      const uint8_t* first_byte_match =
-          static_cast<const uint8_t*>(memchr(haystack, needle[0], slice_search_limit));
-      if (first_byte_match == nullptr) {
-        left_to_search -= slice_search_limit;
-        break;
+    const uint64_t from = std::max<uint64_t>(start, slice_offset);
+    const uint64_t to = std::min(end, slice_end);
+
+    // Search for occurrences that lie entirely within this slice.
+    if (to - from >= size) {
+      const size_t match = SearchKernels::findNeedle(slice.data() + (from - slice_offset),
+                                                     to - from, needle, size);
+      if (match != SearchKernels::NotFound) {
+        return from + match;
       }
-      // After finding a match for the first byte of the needle, check whether the following
-      // bytes in the buffer match the remainder of the needle. Note that the match can span
-      // two or more slices.
-      left_to_search -= static_cast<size_t>(first_byte_match - haystack + 1);
-      // Save the current number of bytes left to search.
-      // If the pattern is not found, the search will resume from the next byte
-      // and left_to_search value must be restored.
-      const size_t saved_left_to_search = left_to_search;
-      size_t i = 1;
-      size_t match_index = slice_index;
-      const uint8_t* match_next = first_byte_match + 1;
-      const uint8_t* match_end = haystack_end;
-      while ((i < size) && (0 < left_to_search)) {
-        if (match_next >= match_end) {
-          // We've hit the end of this slice, so continue checking against the next slice.
-          match_index++;
-          if (match_index == slices_.size()) {
-            // We've hit the end of the entire buffer.
-            break;
-          }
-          const auto& match_slice = slices_[match_index];
-          match_next = match_slice.data();
-          match_end = match_next + match_slice.dataSize();
-          continue;
-        }
-        left_to_search--;
-        if (*match_next++ != needle[i]) {
+    }
+
+    // Check for occurrences that start within the last `size - 1` bytes of this slice and
+    // continue into the following slices. These start after any occurrence found above, and
+    // before any occurrence entirely within a following slice.
+    if (size > 1 && slice_end < end) {
+      uint64_t candidate = std::max(from, slice_end - std::min<uint64_t>(slice_end, size - 1));
+      const uint64_t candidates_end = std::min(slice_end, end - size + 1);
+      while (candidate < candidates_end) {
+        const size_t first_byte = SearchKernels::findByte(
+            slice.data() + (candidate - slice_offset), candidates_end - candidate, needle[0]);
+        if (first_byte == SearchKernels::NotFound) {
           break;
         }
-        i++;
+        candidate += first_byte;
+        if (matchesAt(slice_index, candidate - slice_offset, needle, size)) {
+          return candidate;
+        }
+        candidate++;
       }
-      if (i == size) {
-        // Successful match of the entire needle.
-        return offset + (first_byte_match - slice_start);
+    }
+    slice_offset = slice_end;
+  }
+  return -1;
+}
+
+ssize_t OwnedImpl::searchAnyOf(absl::string_view bytes, size_t start, size_t length) const {
+  const uint64_t end = searchEnd(start, length);
+  uint64_t slice_offset = 0;
+  for (size_t slice_index = 0; slice_index < slices_.size() && slice_offset < end;
+       slice_index++) {
+    const Slice& slice = slices_[slice_index];
+    const uint64_t slice_end = slice_offset + slice.dataSize();
+    if (slice_end > start) {
+      const uint64_t from = std::max<uint64_t>(start, slice_offset);
+      const uint64_t to = std::min(end, slice_end);
+      const size_t match =
+          SearchKernels::findAnyOf(slice.data() + (from - slice_offset), to - from, bytes);
+      if (match != SearchKernels::NotFound) {
+        return from + match;
       }
-      // If this wasn't a successful match, start scanning again at the next byte.
-      haystack = first_byte_match + 1;
-      left_to_search = saved_left_to_search;
     }
-    start = 0;
-    offset += slice_size;
+    slice_offset = slice_end;
   }
   return -1;
 }
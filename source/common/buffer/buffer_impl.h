@@ -1,6 +1,8 @@
 #pragma once
 
 #include <algorithm>
+#include <array>
+#include <atomic>
 #include <cstdint>
 #include <deque>
 #include <memory>
@@ -8,6 +10,8 @@
 
 #include "envoy/buffer/buffer.h"
 #include "envoy/http/stream_reset_handler.h"
+#include "envoy/stats/scope.h"
+#include "envoy/stats/stats_macros.h"
 
 #include "source/common/common/assert.h"
 #include "source/common/common/non_copyable.h"
@@ -19,6 +23,166 @@
 namespace Envoy {
 namespace Buffer {
 
+/**
+ * All slice storage pool stats. @see stats_macros.h
+ */
+#define ALL_SLICE_STORAGE_POOL_STATS(COUNTER, GAUGE)                                               \
+  COUNTER(hits)                                                                                    \
+  COUNTER(misses)                                                                                  \
+  COUNTER(overflow_frees)                                                                          \
+  COUNTER(remote_frees)                                                                            \
+  GAUGE(retained_bytes, Accumulate)
+
+/**
+ * Struct definition for all slice storage pool stats. @see stats_macros.h
+ */
+struct SliceStoragePoolStats {
+  ALL_SLICE_STORAGE_POOL_STATS(GENERATE_COUNTER_STRUCT, GENERATE_GAUGE_STRUCT)
+};
+
+class SliceStoragePool;
+
+/**
+ * Deleter for slice backing storage. Storage handed out by a SliceStoragePool is returned to the
+ * pool it was allocated from, any other storage is released to the global allocator.
+ */
+class SliceStorageDeleter {
+public:
+  SliceStorageDeleter() = default;
+  SliceStorageDeleter(SliceStoragePool* pool, uint32_t size_class)
+      : tagged_pool_(reinterpret_cast<uintptr_t>(pool) | size_class) {}
+
+  void operator()(uint8_t* mem) const;
+
+  /**
+   * @return the pool the storage was allocated from, or nullptr for heap allocated storage.
+   */
+  SliceStoragePool* pool() const {
+    return reinterpret_cast<SliceStoragePool*>(tagged_pool_ & ~SizeClassMask);
+  }
+
+private:
+  static constexpr uintptr_t SizeClassMask = 0xf;
+
+  // The owning pool with the size class of the block packed into the low bits, which are always
+  // zero due to the alignment of SliceStoragePool. Zero for heap allocated storage.
+  uintptr_t tagged_pool_{0};
+};
+
+using SliceStoragePtr = std::unique_ptr<uint8_t[], SliceStorageDeleter>;
+
+struct SliceStoragePoolReleaser {
+  void operator()(SliceStoragePool* pool) const;
+};
+using SliceStoragePoolPtr = std::unique_ptr<SliceStoragePool, SliceStoragePoolReleaser>;
+
+/**
+ * Slab allocator for slice backing storage, owned by a single dispatcher. Storage of up to
+ * MaxPooledSize bytes is served from page sized size classes whose free blocks are kept on
+ * intrusive free lists that are only touched by the thread the pool is installed on. Storage that
+ * is freed on any other thread, for example because the slice was moved into a buffer owned by
+ * another worker, is handed back through a lock-free stack and reclaimed by the owning thread the
+ * next time one of its free lists runs dry.
+ *
+ * The pool is reference counted by its outstanding blocks, so it stays alive after its owner
+ * releases it until the last block has been freed.
+ */
+class alignas(64) SliceStoragePool : NonCopyable {
+public:
+  static constexpr uint64_t PageSize = 4096;
+  static constexpr uint32_t NumSizeClasses = 16;
+  static constexpr uint64_t MaxPooledSize = NumSizeClasses * PageSize;
+
+  /**
+   * @param max_retained_bytes the maximum number of bytes of free storage kept for reuse. Storage
+   *        freed beyond this limit is released to the global allocator.
+   * @return a new pool. Destroying the returned pointer releases the owner's reference.
+   */
+  static SliceStoragePoolPtr create(uint64_t max_retained_bytes);
+
+  /**
+   * @return the pool installed on the calling thread, or nullptr if there is none.
+   */
+  static SliceStoragePool* current() { return current_; }
+
+  /**
+   * Install a pool on the calling thread. All slice storage allocated on the thread afterwards is
+   * served by the pool.
+   * @param pool supplies the pool to install, or nullptr to go back to the global allocator.
+   */
+  static void setCurrent(SliceStoragePool* pool) { current_ = pool; }
+
+  /**
+   * @return whether storage of the given size can be served by a pool.
+   */
+  static bool isPoolable(uint64_t size) {
+    return size != 0 && size <= MaxPooledSize && size % PageSize == 0;
+  }
+
+  /**
+   * Allocate a block of storage. Must be called on the thread the pool is installed on.
+   * @param size the size of the block. isPoolable(size) must be true.
+   * @return the block, which returns to this pool when freed.
+   */
+  SliceStoragePtr allocate(uint64_t size);
+
+  /**
+   * Start recording stats for the pool. Must be called on the thread the pool is installed on.
+   * @param scope supplies the scope to create the stats in.
+   * @param prefix supplies the stats prefix.
+   */
+  void initializeStats(Stats::Scope& scope, const std::string& prefix);
+
+  /**
+   * @return the number of bytes of free storage currently retained for reuse.
+   */
+  uint64_t retainedBytes() const { return retained_bytes_; }
+
+private:
+  friend class SliceStorageDeleter;
+  friend struct SliceStoragePoolReleaser;
+
+  struct FreeBlock {
+    FreeBlock* next_;
+    uint32_t size_class_;
+  };
+
+  explicit SliceStoragePool(uint64_t max_retained_bytes)
+      : max_retained_bytes_(max_retained_bytes) {}
+  ~SliceStoragePool();
+
+  static uint64_t classSize(uint32_t size_class) { return (size_class + 1) * PageSize; }
+
+  void deallocate(uint8_t* mem, uint32_t size_class);
+  void retainOrFree(FreeBlock* block);
+  void reclaimRemoteFrees();
+  void releaseOwner();
+  void unref();
+
+  static thread_local SliceStoragePool* current_;
+
+  const uint64_t max_retained_bytes_;
+  uint64_t retained_bytes_{0};
+  std::array<FreeBlock*, NumSizeClasses> free_lists_{};
+  std::unique_ptr<SliceStoragePoolStats> stats_;
+
+  // One reference for the owner plus one per outstanding block.
+  std::atomic<uint64_t> refs_{1};
+  std::atomic<bool> owner_released_{false};
+
+  // Blocks freed on threads other than the owning one. Kept on a separate cache line so that
+  // remote frees don't contend with the owner's free lists.
+  alignas(64) std::atomic<FreeBlock*> remote_frees_{nullptr};
+};
+
+inline void SliceStorageDeleter::operator()(uint8_t* mem) const {
+  if (tagged_pool_ == 0) {
+    delete[] mem;
+  } else {
+    pool()->deallocate(mem, static_cast<uint32_t>(tagged_pool_ & SizeClassMask));
+  }
+}
+
 /**
  * A Slice manages a contiguous block of bytes.
  * The block is arranged like this:
@@ -37,7 +201,7 @@ namespace Buffer {
 class Slice {
 public:
   using Reservation = RawSlice;
-  using StoragePtr = std::unique_ptr<uint8_t[]>;
+  using StoragePtr = SliceStoragePtr;
 
   struct SizedStorage {
     StoragePtr mem_{};
@@ -57,13 +221,7 @@ public:
    * @param account the account to charge.
    */
   Slice(uint64_t min_capacity, const BufferMemoryAccountSharedPtr& account)
-      : capacity_(sliceSize(min_capacity)), storage_(new uint8_t[capacity_]),
-        base_(storage_.get()) {
-    if (account) {
-      account->charge(capacity_);
-      account_ = account;
-    }
-  }
+      : Slice(newStorage(min_capacity), 0, account) {}
 
   /**
    * Create an empty mutable Slice that owns its storage, which it charges to the provided account,
@@ -359,12 +517,17 @@ public:
   /**
    * Create new backend storage with min capacity. This method will create a recommended capacity
    * which will bigger or equal to the min capacity and create new backend storage based on the
-   * recommended capacity.
+   * recommended capacity. The storage is served by the SliceStoragePool installed on the calling
+   * thread, if any.
    * @param min_capacity the min capacity of new created backend storage.
    * @return a backend storage for slice.
    */
   static inline SizedStorage newStorage(uint64_t min_capacity) {
     const uint64_t slice_size = sliceSize(min_capacity);
+    SliceStoragePool* pool = SliceStoragePool::current();
+    if (pool != nullptr && SliceStoragePool::isPoolable(slice_size)) {
+      return {pool->allocate(slice_size), static_cast<size_t>(slice_size)};
+    }
     return {StoragePtr{new uint8_t[slice_size]}, static_cast<size_t>(slice_size)};
   }
 
@@ -642,6 +805,13 @@ private:
  */
 class OwnedImpl : public LibEventInstance {
 public:
+  // Slices with less data than this are copied rather than moved or referenced when they are added
+  // to a buffer. This size has been determined to be optimal from running the
+  // //test/integration:http_benchmark benchmark tests.
+  // TODO(yanavlasov): This may not be optimal for all hardware configurations or traffic patterns
+  // and may need to be configurable in the future.
+  static constexpr uint64_t CopyThreshold = 512;
+
   OwnedImpl();
   OwnedImpl(absl::string_view data);
   OwnedImpl(const Instance& data);
@@ -672,6 +842,7 @@ public:
   Reservation reserveForRead() override;
   ReservationSingleSlice reserveSingleSlice(uint64_t length, bool separate_slice = false) override;
   ssize_t search(const void* data, uint64_t size, size_t start, size_t length) const override;
+  ssize_t searchAnyOf(absl::string_view bytes, size_t start, size_t length) const override;
   bool startsWith(absl::string_view data) const override;
   std::string toString() const override;
 
@@ -742,6 +913,18 @@ private:
   void addImpl(const void* data, uint64_t size);
   void drainImpl(uint64_t size);
 
+  /**
+   * @return the end offset of a search starting at `start` and limited to `length` bytes, with
+   *         a length of zero meaning the rest of the buffer.
+   */
+  uint64_t searchEnd(size_t start, size_t length) const;
+
+  /**
+   * @return whether the data starting at `offset` within the slice at `slice_index` matches the
+   *         supplied bytes, which may continue into the following slices.
+   */
+  bool matchesAt(size_t slice_index, uint64_t offset, const uint8_t* data, uint64_t size) const;
+
   /**
    * Moves contents of the `other_slice` by either taking its ownership or coalescing it
    * into an existing slice.
@@ -768,7 +951,8 @@ private:
     OwnedImplReservationSlicesOwnerMultiple() : free_list_ref_(free_list_) {}
     ~OwnedImplReservationSlicesOwnerMultiple() override {
       for (auto r = owned_storages_.rbegin(); r != owned_storages_.rend(); r++) {
-        if (r->mem_ != nullptr) {
+        // Pooled storage goes back to its pool when it is destroyed.
+        if (r->mem_ != nullptr && r->mem_.get_deleter().pool() == nullptr) {
           ASSERT(r->len_ == Slice::default_slice_size_);
           if (free_list_ref_.size() < free_list_max_) {
             free_list_ref_.push_back(std::move(r->mem_));
@@ -780,6 +964,10 @@ private:
     Slice::SizedStorage newStorage() {
       ASSERT(Slice::sliceSize(Slice::default_slice_size_) == Slice::default_slice_size_);
 
+      if (SliceStoragePool::current() != nullptr) {
+        return Slice::newStorage(Slice::default_slice_size_);
+      }
+
       Slice::SizedStorage storage{nullptr, Slice::default_slice_size_};
       if (!free_list_ref_.empty()) {
         storage.mem_ = std::move(free_list_ref_.back());
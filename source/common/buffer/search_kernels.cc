@@ -0,0 +1,216 @@
+#include "source/common/buffer/search_kernels.h"
+
+#include <array>
+#include <cstring>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define ENVOY_BUFFER_SEARCH_X86 1
+#include <immintrin.h>
+#endif
+
+namespace Envoy {
+namespace Buffer {
+namespace {
+
+bool force_scalar = false;
+
+// Portable implementations. These are also used for the tails of the vectorized searches that are
+// shorter than a vector.
+
+size_t findAnyOfSmallSetScalar(const uint8_t* data, size_t size, const uint8_t* set,
+                               size_t set_size) {
+  for (size_t i = 0; i < size; i++) {
+    for (size_t j = 0; j < set_size; j++) {
+      if (data[i] == set[j]) {
+        return i;
+      }
+    }
+  }
+  return SearchKernels::NotFound;
+}
+
+size_t findAnyOfTable(const uint8_t* data, size_t size, absl::string_view set) {
+  std::array<bool, 256> table{};
+  for (const char c : set) {
+    table[static_cast<uint8_t>(c)] = true;
+  }
+  for (size_t i = 0; i < size; i++) {
+    if (table[data[i]]) {
+      return i;
+    }
+  }
+  return SearchKernels::NotFound;
+}
+
+size_t findNeedleScalar(const uint8_t* data, size_t size, const uint8_t* needle,
+                        size_t needle_size) {
+  if (size < needle_size) {
+    return SearchKernels::NotFound;
+  }
+  const uint8_t* pos = data;
+  const uint8_t* const last_start = data + size - needle_size;
+  while (pos <= last_start) {
+    pos = static_cast<const uint8_t*>(memchr(pos, needle[0], last_start - pos + 1));
+    if (pos == nullptr) {
+      break;
+    }
+    if (memcmp(pos + 1, needle + 1, needle_size - 1) == 0) {
+      return pos - data;
+    }
+    pos++;
+  }
+  return SearchKernels::NotFound;
+}
+
+#ifdef ENVOY_BUFFER_SEARCH_X86
+
+bool cpuSupportsAvx2() {
+  __builtin_cpu_init();
+  return __builtin_cpu_supports("avx2");
+}
+
+bool useAvx2() {
+  static const bool has_avx2 = cpuSupportsAvx2();
+  return has_avx2;
+}
+
+// Adds `offset` to a result of a tail search, preserving NotFound.
+size_t offsetResult(size_t offset, size_t result) {
+  return result == SearchKernels::NotFound ? result : offset + result;
+}
+
+size_t findAnyOfSse2(const uint8_t* data, size_t size, const uint8_t* set, size_t set_size) {
+  __m128i set_vectors[SearchKernels::MaxVectorSetSize];
+  for (size_t j = 0; j < set_size; j++) {
+    set_vectors[j] = _mm_set1_epi8(static_cast<char>(set[j]));
+  }
+  size_t i = 0;
+  for (; i + sizeof(__m128i) <= size; i += sizeof(__m128i)) {
+    const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+    __m128i matches = _mm_cmpeq_epi8(chunk, set_vectors[0]);
+    for (size_t j = 1; j < set_size; j++) {
+      matches = _mm_or_si128(matches, _mm_cmpeq_epi8(chunk, set_vectors[j]));
+    }
+    const uint32_t mask = _mm_movemask_epi8(matches);
+    if (mask != 0) {
+      return i + __builtin_ctz(mask);
+    }
+  }
+  return offsetResult(i, findAnyOfSmallSetScalar(data + i, size - i, set, set_size));
+}
+
+__attribute__((target("avx2"))) size_t findAnyOfAvx2(const uint8_t* data, size_t size,
+                                                     const uint8_t* set, size_t set_size) {
+  __m256i set_vectors[SearchKernels::MaxVectorSetSize];
+  for (size_t j = 0; j < set_size; j++) {
+    set_vectors[j] = _mm256_set1_epi8(static_cast<char>(set[j]));
+  }
+  size_t i = 0;
+  for (; i + sizeof(__m256i) <= size; i += sizeof(__m256i)) {
+    const __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+    __m256i matches = _mm256_cmpeq_epi8(chunk, set_vectors[0]);
+    for (size_t j = 1; j < set_size; j++) {
+      matches = _mm256_or_si256(matches, _mm256_cmpeq_epi8(chunk, set_vectors[j]));
+    }
+    const uint32_t mask = _mm256_movemask_epi8(matches);
+    if (mask != 0) {
+      return i + __builtin_ctz(mask);
+    }
+  }
+  return offsetResult(i, findAnyOfSmallSetScalar(data + i, size - i, set, set_size));
+}
+
+// The needle searches compare the first and the last byte of the needle against a vector worth of
+// candidate positions at once, and only compare the full needle for the positions where both match.
+
+size_t findNeedleSse2(const uint8_t* data, size_t size, const uint8_t* needle,
+                      size_t needle_size) {
+  const __m128i first = _mm_set1_epi8(static_cast<char>(needle[0]));
+  const __m128i last = _mm_set1_epi8(static_cast<char>(needle[needle_size - 1]));
+  size_t i = 0;
+  for (; i + needle_size - 1 + sizeof(__m128i) <= size; i += sizeof(__m128i)) {
+    const __m128i block_first = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+    const __m128i block_last =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i + needle_size - 1));
+    uint32_t mask = _mm_movemask_epi8(
+        _mm_and_si128(_mm_cmpeq_epi8(first, block_first), _mm_cmpeq_epi8(last, block_last)));
+    while (mask != 0) {
+      const uint32_t bit = __builtin_ctz(mask);
+      if (memcmp(data + i + bit + 1, needle + 1, needle_size - 2) == 0) {
+        return i + bit;
+      }
+      mask &= mask - 1;
+    }
+  }
+  return offsetResult(i, findNeedleScalar(data + i, size - i, needle, needle_size));
+}
+
+__attribute__((target("avx2"))) size_t findNeedleAvx2(const uint8_t* data, size_t size,
+                                                      const uint8_t* needle, size_t needle_size) {
+  const __m256i first = _mm256_set1_epi8(static_cast<char>(needle[0]));
+  const __m256i last = _mm256_set1_epi8(static_cast<char>(needle[needle_size - 1]));
+  size_t i = 0;
+  for (; i + needle_size - 1 + sizeof(__m256i) <= size; i += sizeof(__m256i)) {
+    const __m256i block_first = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+    const __m256i block_last =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i + needle_size - 1));
+    uint32_t mask = _mm256_movemask_epi8(_mm256_and_si256(_mm256_cmpeq_epi8(first, block_first),
+                                                          _mm256_cmpeq_epi8(last, block_last)));
+    while (mask != 0) {
+      const uint32_t bit = __builtin_ctz(mask);
+      if (memcmp(data + i + bit + 1, needle + 1, needle_size - 2) == 0) {
+        return i + bit;
+      }
+      mask &= mask - 1;
+    }
+  }
+  return offsetResult(i, findNeedleScalar(data + i, size - i, needle, needle_size));
+}
+
+#endif // ENVOY_BUFFER_SEARCH_X86
+
+} // namespace
+
+size_t SearchKernels::findByte(const uint8_t* data, size_t size, uint8_t byte) {
+  const void* match = memchr(data, byte, size);
+  return match == nullptr ? NotFound : static_cast<const uint8_t*>(match) - data;
+}
+
+size_t SearchKernels::findAnyOf(const uint8_t* data, size_t size, absl::string_view set) {
+  if (set.empty()) {
+    return NotFound;
+  }
+  if (set.size() == 1) {
+    return findByte(data, size, static_cast<uint8_t>(set[0]));
+  }
+  if (set.size() > MaxVectorSetSize) {
+    return findAnyOfTable(data, size, set);
+  }
+  const uint8_t* set_bytes = reinterpret_cast<const uint8_t*>(set.data());
+#ifdef ENVOY_BUFFER_SEARCH_X86
+  if (!force_scalar) {
+    return useAvx2() ? findAnyOfAvx2(data, size, set_bytes, set.size())
+                     : findAnyOfSse2(data, size, set_bytes, set.size());
+  }
+#endif
+  return findAnyOfSmallSetScalar(data, size, set_bytes, set.size());
+}
+
+size_t SearchKernels::findNeedle(const uint8_t* data, size_t size, const uint8_t* needle,
+                                 size_t needle_size) {
+  if (needle_size == 1) {
+    return findByte(data, size, needle[0]);
+  }
+#ifdef ENVOY_BUFFER_SEARCH_X86
+  if (!force_scalar) {
+    return useAvx2() ? findNeedleAvx2(data, size, needle, needle_size)
+                     : findNeedleSse2(data, size, needle, needle_size);
+  }
+#endif
+  return findNeedleScalar(data, size, needle, needle_size);
+}
+
+void SearchKernels::forceScalarForTest(bool force) { force_scalar = force; }
+
+} // namespace Buffer
+} // namespace Envoy
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "absl/strings/string_view.h"
+
+namespace Envoy {
+namespace Buffer {
+
+/**
+ * Search primitives over a contiguous block of memory, used by OwnedImpl to search within a single
+ * slice. On x86-64 the byte set and needle searches are vectorized with AVX2 when the CPU supports
+ * it and with SSE2 otherwise; other platforms use portable scalar implementations. Single byte
+ * searches are delegated to memchr(), which the C library already vectorizes.
+ */
+class SearchKernels {
+public:
+  // Returned by all searches when there is no match.
+  static constexpr size_t NotFound = static_cast<size_t>(-1);
+
+  // Byte sets of up to this many bytes are searched with vector compares. Larger sets use a
+  // lookup table.
+  static constexpr size_t MaxVectorSetSize = 8;
+
+  /**
+   * @param data supplies the memory to search.
+   * @param size supplies the number of bytes to search.
+   * @param byte supplies the byte to search for.
+   * @return the index of the first occurrence of the byte, or NotFound.
+   */
+  static size_t findByte(const uint8_t* data, size_t size, uint8_t byte);
+
+  /**
+   * @param data supplies the memory to search.
+   * @param size supplies the number of bytes to search.
+   * @param set supplies the bytes to search for.
+   * @return the index of the first byte that is contained in the set, or NotFound.
+   */
+  static size_t findAnyOf(const uint8_t* data, size_t size, absl::string_view set);
+
+  /**
+   * @param data supplies the memory to search.
+   * @param size supplies the number of bytes to search.
+   * @param needle supplies the bytes to search for.
+   * @param needle_size supplies the length of the needle, which must be non-zero.
+   * @return the index of the first occurrence of the needle that lies entirely within the
+   *         searched memory, or NotFound.
+   */
+  static size_t findNeedle(const uint8_t* data, size_t size, const uint8_t* needle,
+                           size_t needle_size);
+
+  /**
+   * Force the portable implementations, regardless of the CPU features available. For use in
+   * tests and benchmarks comparing the implementations.
+   */
+  static void forceScalarForTest(bool force);
+};
+
+} // namespace Buffer
+} // namespace Envoy
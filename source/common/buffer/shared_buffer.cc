@@ -0,0 +1,45 @@
+#include "source/common/buffer/shared_buffer.h"
+
+namespace Envoy {
+namespace Buffer {
+namespace {
+
+// References a slice of a SharedBuffer, which it keeps alive until it is done.
+class SharedBufferFragment : public BufferFragment {
+public:
+  SharedBufferFragment(SharedBufferConstSharedPtr owner, const RawSlice& slice)
+      : owner_(std::move(owner)), slice_(slice) {}
+
+  // Buffer::BufferFragment
+  const void* data() const override { return slice_.mem_; }
+  size_t size() const override { return slice_.len_; }
+  void done() override { delete this; }
+
+private:
+  const SharedBufferConstSharedPtr owner_;
+  const RawSlice slice_;
+};
+
+} // namespace
+
+SharedBufferConstSharedPtr SharedBuffer::create(Instance& data) {
+  std::shared_ptr<SharedBuffer> shared(new SharedBuffer());
+  shared->data_.move(data);
+  return shared;
+}
+
+uint64_t SharedBuffer::addTo(Instance& buffer) const {
+  uint64_t shared_bytes = 0;
+  for (const RawSlice& slice : data_.getRawSlices()) {
+    if (slice.len_ < OwnedImpl::CopyThreshold) {
+      buffer.add(slice.mem_, slice.len_);
+      continue;
+    }
+    buffer.addBufferFragment(*new SharedBufferFragment(shared_from_this(), slice));
+    shared_bytes += slice.len_;
+  }
+  return shared_bytes;
+}
+
+} // namespace Buffer
+} // namespace Envoy
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+
+#include "envoy/buffer/buffer.h"
+
+#include "source/common/buffer/buffer_impl.h"
+#include "source/common/common/non_copyable.h"
+
+namespace Envoy {
+namespace Buffer {
+
+class SharedBuffer;
+using SharedBufferConstSharedPtr = std::shared_ptr<const SharedBuffer>;
+
+// Immutable data that can be added to any number of buffers without copying it. The buffers
+// reference the slices of the data through buffer fragments, each of which keeps the data alive
+// until the buffer that it was added to drains it.
+class SharedBuffer : public std::enable_shared_from_this<SharedBuffer>, NonCopyable {
+public:
+  /**
+   * @param data supplies the data to share, which is moved out of it.
+   */
+  static SharedBufferConstSharedPtr create(Instance& data);
+
+  /**
+   * Adds the data to the end of a buffer. Slices under OwnedImpl::CopyThreshold are copied rather
+   * than referenced, as a fragment and the slice that holds it cost about as much as the copy.
+   * @param buffer supplies the buffer to add to.
+   * @return the number of bytes that were referenced rather than copied.
+   */
+  uint64_t addTo(Instance& buffer) const;
+
+  uint64_t length() const { return data_.length(); }
+
+private:
+  SharedBuffer() = default;
+
+  OwnedImpl data_;
+};
+
+} // namespace Buffer
+} // namespace Envoy
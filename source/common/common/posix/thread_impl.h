@@ -12,7 +12,8 @@ namespace Thread {
 
 class ThreadHandle {
 public:
-  ThreadHandle(std::function<void()> thread_routine, absl::optional<int> thread_priority);
+  ThreadHandle(std::function<void()> thread_routine, absl::optional<int> thread_priority,
+               std::vector<uint32_t> cpu_affinity);
 
   /** Returns the thread routine. */
   std::function<void()>& routine();
@@ -20,12 +21,16 @@ public:
   /** Returns the thread priority, if any. */
   absl::optional<int> priority() const;
 
+  /** Returns the CPUs the thread is restricted to, or an empty vector for no restriction. */
+  const std::vector<uint32_t>& cpuAffinity() const;
+
   /** Returns the thread handle. */
   pthread_t& handle();
 
 private:
   std::function<void()> thread_routine_;
   const absl::optional<int> thread_priority_;
+  const std::vector<uint32_t> cpu_affinity_;
   pthread_t thread_handle_;
 };
 
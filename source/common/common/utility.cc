@@ -610,7 +610,11 @@ const std::string& getDefaultDateFormat(bool local_time) {
   CONSTRUCT_ON_FIRST_USE(std::string, "%Y-%m-%dT%H:%M:%E3SZ");
 }
 
-std::string AccessLogDateTimeFormatter::fromTime(const SystemTime& system_time, bool local_time) {
+namespace {
+
+// Formats the time in the default access log format, reusing the thread local formatting of the
+// last second.
+const std::string& cachedAccessLogTime(const SystemTime& system_time, bool local_time) {
   struct CachedTime {
     std::chrono::seconds epoch_time_seconds;
     std::string formatted_time;
@@ -647,6 +651,17 @@ std::string AccessLogDateTimeFormatter::fromTime(const SystemTime& system_time,
   return cached_time.formatted_time;
 }
 
+} // namespace
+
+std::string AccessLogDateTimeFormatter::fromTime(const SystemTime& system_time, bool local_time) {
+  return cachedAccessLogTime(system_time, local_time);
+}
+
+void AccessLogDateTimeFormatter::appendTime(const SystemTime& system_time, bool local_time,
+                                            std::string& output) {
+  output.append(cachedAccessLogTime(system_time, local_time));
+}
+
 const std::string& StringUtil::nonEmptyStringOrDefault(const std::string& s,
                                                        const std::string& default_value) {
   return s.empty() ? default_value : s;
@@ -171,6 +171,8 @@ private:
 class AccessLogDateTimeFormatter {
 public:
   static std::string fromTime(const SystemTime& time, bool local_time = false);
+  // Appends what fromTime() returns to the output.
+  static void appendTime(const SystemTime& time, bool local_time, std::string& output);
 };
 
 /**
@@ -1,5 +1,7 @@
 #include "source/common/conn_pool/conn_pool_base.h"
 
+#include <cmath>
+
 #include "envoy/server/overload/load_shed_point.h"
 
 #include "source/common/common/assert.h"
@@ -21,6 +23,34 @@ int64_t currentUnusedCapacity(const std::list<ActiveClientPtr>& connecting_clien
 }
 } // namespace
 
+void AdaptivePreconnectEstimator::onStream(MonotonicTime now) {
+  if (last_stream_time_.has_value()) {
+    // Streams sent within the same microsecond are counted a microsecond apart, so that the
+    // average stays positive.
+    const auto interval = std::chrono::duration_cast<std::chrono::microseconds>(
+        now - last_stream_time_.value());
+    updateAverage(stream_interval_us_, std::max<double>(interval.count(), 1));
+  }
+  last_stream_time_ = now;
+}
+
+void AdaptivePreconnectEstimator::onConnected(std::chrono::microseconds connect_time) {
+  updateAverage(connect_time_us_, std::max<double>(connect_time.count(), 1));
+}
+
+void AdaptivePreconnectEstimator::updateAverage(double& average, double sample) {
+  average = average == 0 ? sample : average + SampleWeight * (sample - average);
+}
+
+double AdaptivePreconnectEstimator::anticipatedStreams(MonotonicTime now) const {
+  if (stream_interval_us_ == 0 || connect_time_us_ == 0) {
+    return 0;
+  }
+  const auto idle_time =
+      std::chrono::duration_cast<std::chrono::microseconds>(now - last_stream_time_.value());
+  return connect_time_us_ / std::max<double>(stream_interval_us_, idle_time.count());
+}
+
 std::string ConnPoolImplBase::dumpState() const { return fmt::format("State: {}", *this); }
 
 void ConnPoolImplBase::assertCapacityCountsAreCorrect() {
@@ -144,15 +174,22 @@ bool ConnPoolImplBase::shouldCreateNewConnection(float global_preconnect_ratio)
     // Local preconnect does not need to anticipate a stream. It is called as
     // new streams are established or torn down and simply attempts to maintain
     // the correct ratio of streams and anticipated capacity.
+    //
+    // Adaptive preconnect additionally keeps enough unused capacity for the streams expected to
+    // arrive while a new connection is being established.
+    const uint32_t anticipated_streams = adaptiveAnticipatedStreams();
     bool result =
         shouldConnect(pending_streams_.size(), num_active_streams_,
-                      connecting_and_connected_stream_capacity_, perUpstreamPreconnectRatio());
+                      connecting_and_connected_stream_capacity_, perUpstreamPreconnectRatio()) ||
+        static_cast<int64_t>(pending_streams_.size() + anticipated_streams) >
+            connecting_and_connected_stream_capacity_;
     ENVOY_LOG(trace,
               "per-upstream shouldCreateNewConnection returns {} for pending {} active {} "
-              "connecting_and_connected_capacity {} connecting_capacity {} ratio {}",
+              "connecting_and_connected_capacity {} connecting_capacity {} ratio {} "
+              "anticipated {}",
               result, pending_streams_.size(), num_active_streams_,
               connecting_and_connected_stream_capacity_, connecting_stream_capacity_,
-              perUpstreamPreconnectRatio());
+              perUpstreamPreconnectRatio(), anticipated_streams);
     return result;
   }
 }
@@ -161,6 +198,19 @@ float ConnPoolImplBase::perUpstreamPreconnectRatio() const {
   return host_->cluster().perUpstreamPreconnectRatio();
 }
 
+uint32_t ConnPoolImplBase::adaptiveAnticipatedStreams() const {
+  const absl::optional<uint32_t> max_streams = host_->cluster().adaptivePreconnectMaxStreams();
+  if (!max_streams.has_value()) {
+    return 0;
+  }
+  // Round to nearest, so that pools which expect less than half a stream while a connection is
+  // being established do not keep a spare connection.
+  return static_cast<uint32_t>(std::min<double>(
+      std::round(adaptive_preconnect_estimator_.anticipatedStreams(
+          dispatcher_.timeSource().monotonicTime())),
+      max_streams.value()));
+}
+
 ConnPoolImplBase::ConnectionResult ConnPoolImplBase::tryCreateNewConnections() {
   ConnPoolImplBase::ConnectionResult result;
   // Somewhat arbitrarily cap the number of connections preconnected due to new
@@ -206,11 +256,15 @@ ConnPoolImplBase::tryCreateNewConnection(float global_preconnect_ratio) {
   if (can_create_connection || (ready_clients_.empty() && busy_clients_.empty() &&
                                 connecting_clients_.empty() && early_data_clients_.empty())) {
     ENVOY_LOG(debug, "creating a new connection (connecting={})", connecting_clients_.size());
+    // The connection is created ahead of demand if the connecting connections can already serve
+    // all the pending streams.
+    const bool preconnected = pending_streams_.size() <= connecting_stream_capacity_;
     ActiveClientPtr client = instantiateActiveClient();
     if (client.get() == nullptr) {
       ENVOY_LOG(trace, "connection creation failed");
       return ConnectionResult::FailedToCreateConnection;
     }
+    client->preconnected_ = preconnected;
     ASSERT(client->state() == ActiveClient::State::Connecting, dumpState());
     ENVOY_BUG(std::numeric_limits<uint64_t>::max() - connecting_stream_capacity_ >=
                   static_cast<uint64_t>(client->currentUnusedCapacity()),
@@ -236,6 +290,10 @@ void ConnPoolImplBase::attachStreamToClient(Envoy::ConnectionPool::ActiveClient&
   if (client.state() == Envoy::ConnectionPool::ActiveClient::State::ReadyForEarlyData) {
     traffic_stats.upstream_rq_0rtt_.inc();
   }
+  if (client.preconnected_) {
+    client.preconnected_ = false;
+    traffic_stats.upstream_cx_preconnect_used_.inc();
+  }
 
   if (enforceMaxRequests() && !host_->cluster().resourceManager(priority_).requests().canCreate()) {
     ENVOY_LOG(debug, "max streams overflow");
@@ -325,6 +383,10 @@ ConnectionPool::Cancellable* ConnPoolImplBase::newStreamImpl(AttachContext& cont
   ASSERT(!deferred_deleting_, dumpState());
   assertCapacityCountsAreCorrect();
 
+  if (host_->cluster().adaptivePreconnectMaxStreams().has_value()) {
+    adaptive_preconnect_estimator_.onStream(dispatcher_.timeSource().monotonicTime());
+  }
+
   if (!ready_clients_.empty()) {
     ActiveClient& client = *ready_clients_.front();
     ENVOY_CONN_LOG(debug, "using existing fully connected connection", client);
@@ -567,6 +629,10 @@ void ConnPoolImplBase::onConnectionEvent(ActiveClient& client, absl::string_view
     ENVOY_CONN_LOG(debug, "client disconnected, failure reason: {}", client, failure_reason);
 
     Envoy::Upstream::reportUpstreamCxDestroy(host_, event);
+    if (client.preconnected_) {
+      client.preconnected_ = false;
+      host_->cluster().trafficStats()->upstream_cx_preconnect_unused_.inc();
+    }
     const bool incomplete_stream = client.closingWithIncompleteStream();
     if (incomplete_stream) {
       Envoy::Upstream::reportUpstreamCxDestroyActiveRequest(host_, event);
@@ -649,6 +715,11 @@ void ConnPoolImplBase::onConnectionEvent(ActiveClient& client, absl::string_view
     client.has_handshake_completed_ = true;
     client.conn_connect_ms_->complete();
     client.conn_connect_ms_.reset();
+    if (host_->cluster().adaptivePreconnectMaxStreams().has_value()) {
+      adaptive_preconnect_estimator_.onConnected(
+          std::chrono::duration_cast<std::chrono::microseconds>(
+              dispatcher_.timeSource().monotonicTime() - client.connect_start_time_));
+    }
     if (client.state() == ActiveClient::State::Connecting ||
         client.state() == ActiveClient::State::ReadyForEarlyData) {
       transitionActiveClientState(client,
@@ -733,8 +804,15 @@ bool ConnPoolImplBase::connectingConnectionIsExcess(const ActiveClient& client)
   // If preconnect ratio is set, it also factors in the anticipated load based on both queued
   // streams and active streams, and makes sure the connecting capacity would still be sufficient to
   // serve that even with the most recent client removed.
+  //
+  // With adaptive preconnect, the connecting stream capacity must also still be sufficient to
+  // serve the pending streams and the anticipated ones.
+  const int64_t remaining_capacity =
+      static_cast<int64_t>(connecting_stream_capacity_) - client.currentUnusedCapacity();
   return (pending_streams_.size() + num_active_streams_) * perUpstreamPreconnectRatio() <=
-         (connecting_stream_capacity_ - client.currentUnusedCapacity() + num_active_streams_);
+             (remaining_capacity + num_active_streams_) &&
+         static_cast<int64_t>(pending_streams_.size() + adaptiveAnticipatedStreams()) <=
+             remaining_capacity;
 }
 
 void ConnPoolImplBase::onPendingStreamCancel(PendingStream& stream,
@@ -845,6 +923,7 @@ ActiveClient::ActiveClient(ConnPoolImplBase& parent, uint32_t lifetime_stream_li
     : parent_(parent), remaining_streams_(translateZeroToUnlimited(lifetime_stream_limit)),
       configured_stream_limit_(translateZeroToUnlimited(effective_concurrent_streams)),
       concurrent_stream_limit_(translateZeroToUnlimited(concurrent_stream_limit)),
+      connect_start_time_(parent_.dispatcher().timeSource().monotonicTime()),
       connect_timer_(parent_.dispatcher().createTimer([this]() { onConnectTimeout(); })) {
   conn_connect_ms_ = std::make_unique<Stats::HistogramCompletableTimespanImpl>(
       parent_.host()->cluster().trafficStats()->upstream_cx_connect_ms_,
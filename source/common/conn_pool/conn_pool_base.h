@@ -1,6 +1,7 @@
 #pragma once
 
 #include "envoy/common/conn_pool.h"
+#include "envoy/common/time.h"
 #include "envoy/event/dispatcher.h"
 #include "envoy/network/connection.h"
 #include "envoy/server/overload/overload_manager.h"
@@ -12,6 +13,7 @@
 #include "source/common/common/linked_object.h"
 
 #include "absl/strings/string_view.h"
+#include "absl/types/optional.h"
 #include "fmt/ostream.h"
 
 namespace Envoy {
@@ -139,12 +141,17 @@ public:
   Upstream::HostDescriptionConstSharedPtr real_host_description_;
   Stats::TimespanPtr conn_connect_ms_;
   Stats::TimespanPtr conn_length_;
+  // When the connection started connecting, to measure its establishment time for adaptive
+  // preconnecting at a finer granularity than conn_connect_ms_.
+  const MonotonicTime connect_start_time_;
   Event::TimerPtr connect_timer_;
   Event::TimerPtr connection_duration_timer_;
   bool resources_released_{false};
   bool timed_out_{false};
   // TODO(danzh) remove this once http codec exposes the handshake state for h3.
   bool has_handshake_completed_{false};
+  // True if the connection was created ahead of demand, and has not served a stream yet.
+  bool preconnected_{false};
 
 protected:
   // HTTP/3 subclass should override this.
@@ -175,6 +182,34 @@ public:
 
 using PendingStreamPtr = std::unique_ptr<PendingStream>;
 
+// Estimates the number of streams sent to an upstream while a new connection to it is being
+// established, from moving averages of the interval between streams and of the time it takes to
+// establish connections. This is the number of streams worth of connections adaptive
+// preconnecting keeps ahead of demand.
+class AdaptivePreconnectEstimator {
+public:
+  // Called when a stream is sent to the upstream.
+  void onStream(MonotonicTime now);
+  // Called when a connection to the upstream has been established.
+  void onConnected(std::chrono::microseconds connect_time);
+  // Returns the number of streams expected while a connection is being established, or 0 until
+  // both a stream interval and a connection establishment time have been observed. If no stream
+  // was sent for longer than the average stream interval, the time since the last stream is used
+  // as the interval instead, so that the estimate decays while the upstream is idle.
+  double anticipatedStreams(MonotonicTime now) const;
+
+private:
+  // The weight of a new sample in the moving averages, as for the smoothed RTT of TCP.
+  static constexpr double SampleWeight = 0.125;
+
+  static void updateAverage(double& average, double sample);
+
+  absl::optional<MonotonicTime> last_stream_time_;
+  // Moving averages in microseconds, 0 until a sample is observed.
+  double stream_interval_us_{0};
+  double connect_time_us_{0};
+};
+
 using ActiveClientPtr = std::unique_ptr<ActiveClient>;
 
 // Base class that handles stream queueing logic shared between connection pool implementations.
@@ -347,6 +382,9 @@ protected:
 
   float perUpstreamPreconnectRatio() const;
 
+  // Returns the number of streams anticipated by adaptive preconnecting, or 0 if it is disabled.
+  uint32_t adaptiveAnticipatedStreams() const;
+
   ConnectionPool::Cancellable*
   addPendingStream(Envoy::ConnectionPool::PendingStreamPtr&& pending_stream) {
     LinkedList::moveIntoList(std::move(pending_stream), pending_streams_);
@@ -419,6 +457,9 @@ private:
   Event::SchedulableCallbackPtr upstream_ready_cb_;
   Common::DebugRecursionChecker recursion_checker_;
   Server::LoadShedPoint* create_new_connection_load_shed_{nullptr};
+
+  // The demand estimate of adaptive preconnecting, only updated if it is enabled.
+  AdaptivePreconnectEstimator adaptive_preconnect_estimator_;
 };
 
 } // namespace ConnectionPool
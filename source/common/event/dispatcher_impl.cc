@@ -8,6 +8,7 @@
 
 #include "envoy/api/api.h"
 #include "envoy/common/scope_tracker.h"
+#include "envoy/config/bootstrap/v3/bootstrap.pb.h"
 #include "envoy/config/overload/v3/overload.pb.h"
 #include "envoy/network/client_connection_factory.h"
 #include "envoy/network/listen_socket.h"
@@ -27,6 +28,7 @@
 #include "source/common/network/address_impl.h"
 #include "source/common/network/connection_impl.h"
 #include "source/common/network/utility.h"
+#include "source/common/protobuf/utility.h"
 #include "source/common/runtime/runtime_features.h"
 
 #include "event2/event.h"
@@ -37,6 +39,12 @@
 
 namespace Envoy {
 namespace Event {
+namespace {
+constexpr uint64_t DefaultSliceStoragePoolMaxRetainedBytes = 4 * 1024 * 1024;
+constexpr uint64_t DefaultTimerWheelTickMs = 1;
+// The period over which the busy time of the event loop is measured when busy tracking is enabled.
+constexpr std::chrono::milliseconds LoadTrackingPeriod{100};
+} // namespace
 
 DispatcherImpl::DispatcherImpl(const std::string& name, Api::Api& api,
                                Event::TimeSystem& time_system)
@@ -61,7 +69,20 @@ DispatcherImpl::DispatcherImpl(const std::string& name, Api::Api& api,
                      watermark_factory != nullptr
                          ? watermark_factory
                          : std::make_shared<Buffer::WatermarkBufferFactory>(
-                               api.bootstrap().overload_manager().buffer_factory_config())) {}
+                               api.bootstrap().overload_manager().buffer_factory_config())) {
+  const auto& dispatcher_options = api.bootstrap().dispatcher_options();
+  if (dispatcher_options.has_slice_storage_pool()) {
+    slice_storage_pool_ = Buffer::SliceStoragePool::create(PROTOBUF_GET_WRAPPED_OR_DEFAULT(
+        dispatcher_options.slice_storage_pool(), max_retained_bytes,
+        DefaultSliceStoragePoolMaxRetainedBytes));
+  }
+  if (dispatcher_options.has_timer_wheel()) {
+    timer_wheel_ = std::make_unique<TimerWheel>(
+        *scheduler_, *this, time_system,
+        std::chrono::milliseconds(PROTOBUF_GET_MS_OR_DEFAULT(dispatcher_options.timer_wheel(), tick,
+                                                             DefaultTimerWheelTickMs)));
+  }
+}
 
 DispatcherImpl::DispatcherImpl(const std::string& name, Thread::ThreadFactory& thread_factory,
                                TimeSource& time_source, Filesystem::Instance& file_system,
@@ -80,8 +101,11 @@ DispatcherImpl::DispatcherImpl(const std::string& name, Thread::ThreadFactory& t
   ASSERT(!name_.empty());
   FatalErrorHandler::registerFatalErrorHandler(*this);
   updateApproximateMonotonicTimeInternal();
-  base_scheduler_.registerOnCheckCallback(
-      std::bind(&DispatcherImpl::updateApproximateMonotonicTime, this));
+  base_scheduler_.registerOnCheckCallback([this]() {
+    updateApproximateMonotonicTime();
+    poll_end_time_ = approximate_monotonic_time_;
+  });
+  base_scheduler_.registerOnPrepareCallback([this]() { onPrepareForPoll(); });
 }
 
 DispatcherImpl::~DispatcherImpl() {
@@ -107,6 +131,9 @@ void DispatcherImpl::initializeStats(Stats::Scope& scope,
     stats_ = std::make_unique<DispatcherStats>(
         DispatcherStats{ALL_DISPATCHER_STATS(POOL_HISTOGRAM_PREFIX(scope, stats_prefix_ + "."))});
     base_scheduler_.initializeStats(stats_.get());
+    if (slice_storage_pool_ != nullptr) {
+      slice_storage_pool_->initializeStats(scope, stats_prefix_ + ".slice_storage_pool.");
+    }
     ENVOY_LOG(debug, "running {} on thread {}", stats_prefix_, run_tid_.debugString());
   });
 }
@@ -233,7 +260,8 @@ Event::SchedulableCallbackPtr DispatcherImpl::createSchedulableCallback(std::fun
 }
 
 TimerPtr DispatcherImpl::createTimerInternal(TimerCb cb) {
-  return scheduler_->createTimer(
+  Scheduler& scheduler = timer_wheel_ != nullptr ? *timer_wheel_ : *scheduler_;
+  return scheduler.createTimer(
       [this, cb]() {
         touchWatchdog();
         cb();
@@ -294,8 +322,62 @@ void DispatcherImpl::run(RunType type) {
   // callbacks that have to get run before the initial event loop starts running. libevent does
   // not guarantee that events are run in any particular order. So even if we post() and call
   // event_base_once() before some other event, the other event might get called first.
+  if (slice_storage_pool_ != nullptr) {
+    Buffer::SliceStoragePool::setCurrent(slice_storage_pool_.get());
+  }
   runPostCallbacks();
-  base_scheduler_.run(type);
+  if (type == RunType::Block && hybrid_polling_spin_duration_ > std::chrono::microseconds::zero()) {
+    runHybridPolling();
+  } else {
+    base_scheduler_.run(type);
+  }
+  if (slice_storage_pool_ != nullptr) {
+    Buffer::SliceStoragePool::setCurrent(nullptr);
+  }
+}
+
+void DispatcherImpl::enableHybridPolling(std::chrono::microseconds spin_duration) {
+  ASSERT(spin_duration > std::chrono::microseconds::zero());
+  hybrid_polling_spin_duration_ = spin_duration;
+}
+
+void DispatcherImpl::runHybridPolling() {
+  // Poll without blocking for as long as events keep arriving within the spin duration of each
+  // other, and only block in the kernel once the loop has been idle for the whole spin duration.
+  // spin_start is the end of the last iteration that handled events, so the spin periods recorded
+  // in the stats exclude the time spent handling events. The prepare and check callbacks only run
+  // around the blocking waits, see onSpinIteration() for the iterations in between.
+  MonotonicTime spin_start = time_source_.monotonicTime();
+  MonotonicTime iteration_start = spin_start;
+  const auto record_spin = [this](std::chrono::nanoseconds spin) {
+    if (stats_ != nullptr && spin > std::chrono::nanoseconds::zero()) {
+      stats_->spin_duration_us_.recordValue(
+          std::chrono::duration_cast<std::chrono::microseconds>(spin).count());
+    }
+  };
+  while (true) {
+    const uint64_t handled_events = handled_events_;
+    if (!base_scheduler_.runOnce(false)) {
+      return;
+    }
+    const MonotonicTime now = time_source_.monotonicTime();
+    onSpinIteration(now, handled_events_ != handled_events);
+    if (handled_events_ != handled_events) {
+      record_spin(iteration_start - spin_start);
+      spin_start = now;
+    } else if (now - spin_start >= hybrid_polling_spin_duration_) {
+      record_spin(now - spin_start);
+      if (!base_scheduler_.runOnce(true)) {
+        return;
+      }
+      spin_start = time_source_.monotonicTime();
+      iteration_start = spin_start;
+      // The events of the blocking wait were handled since its check callback.
+      onSpinIteration(spin_start, true);
+      continue;
+    }
+    iteration_start = now;
+  }
 }
 
 MonotonicTime DispatcherImpl::approximateMonotonicTime() const {
@@ -337,6 +419,51 @@ void DispatcherImpl::updateApproximateMonotonicTimeInternal() {
   approximate_monotonic_time_ = time_source_.monotonicTime();
 }
 
+void DispatcherImpl::onSpinIteration(MonotonicTime now, bool handled_events) {
+  // What the check callback and the prepare callback of the next iteration would do.
+  approximate_monotonic_time_ = now;
+  if (!load_.busyTrackingEnabled()) {
+    return;
+  }
+  if (load_timer_ == nullptr) {
+    onPrepareForPoll();
+  } else if (handled_events) {
+    busy_time_ += now - poll_end_time_;
+  }
+  poll_end_time_ = now;
+}
+
+void DispatcherImpl::onPrepareForPoll() {
+  if (!load_.busyTrackingEnabled()) {
+    return;
+  }
+  // The time since polling last returned was spent handling events.
+  const MonotonicTime now = time_source_.monotonicTime();
+  if (load_timer_ == nullptr) {
+    // Busy tracking was just enabled. The timer publishes the busy time periodically, including
+    // while the loop is blocked waiting for events.
+    load_timer_ = scheduler_->createTimer([this]() { publishBusyTime(); }, *this);
+    load_timer_->enableTimer(LoadTrackingPeriod);
+    load_period_start_ = now;
+    return;
+  }
+  busy_time_ += now - poll_end_time_;
+}
+
+void DispatcherImpl::publishBusyTime() {
+  const MonotonicTime now = time_source_.monotonicTime();
+  // Account for the current iteration up to now, and start the next period from here.
+  busy_time_ += now - poll_end_time_;
+  poll_end_time_ = now;
+  const std::chrono::nanoseconds period = now - load_period_start_;
+  load_.setBusyPermille(period.count() > 0
+                            ? std::min<uint64_t>(1000, busy_time_.count() * 1000 / period.count())
+                            : 0);
+  busy_time_ = std::chrono::nanoseconds::zero();
+  load_period_start_ = now;
+  load_timer_->enableTimer(LoadTrackingPeriod);
+}
+
 void DispatcherImpl::runThreadLocalDelete() {
   std::list<DispatcherThreadDeletableConstPtr> to_be_delete;
   {
@@ -406,6 +533,7 @@ void DispatcherImpl::runFatalActionsOnTrackedObject(
 }
 
 void DispatcherImpl::touchWatchdog() {
+  ++handled_events_;
   if (watchdog_registration_) {
     watchdog_registration_->touchWatchdog();
   }
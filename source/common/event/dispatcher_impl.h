@@ -14,10 +14,12 @@
 #include "envoy/network/connection_handler.h"
 #include "envoy/stats/scope.h"
 
+#include "source/common/buffer/buffer_impl.h"
 #include "source/common/common/logger.h"
 #include "source/common/common/thread.h"
 #include "source/common/event/libevent.h"
 #include "source/common/event/libevent_scheduler.h"
+#include "source/common/event/timer_wheel_impl.h"
 #include "source/common/signal/fatal_error_handler.h"
 
 #include "absl/container/inlined_vector.h"
@@ -86,11 +88,13 @@ public:
   void post(PostCb callback) override;
   void deleteInDispatcherThread(DispatcherThreadDeletableConstPtr deletable) override;
   void run(RunType type) override;
+  void enableHybridPolling(std::chrono::microseconds spin_duration) override;
   Buffer::WatermarkFactory& getWatermarkFactory() override { return *buffer_factory_; }
   void pushTrackedObject(const ScopeTrackedObject* object) override;
   void popTrackedObject(const ScopeTrackedObject* expected_object) override;
   bool trackedObjectStackIsEmpty() const override { return tracked_object_stack_.empty(); }
   MonotonicTime approximateMonotonicTime() const override;
+  DispatcherLoad& load() override { return load_; }
   void updateApproximateMonotonicTime() override;
   void shutdown() override;
 
@@ -129,8 +133,13 @@ private:
   void updateApproximateMonotonicTimeInternal();
   void runPostCallbacks();
   void runThreadLocalDelete();
+  void runHybridPolling();
+  void onSpinIteration(MonotonicTime now, bool handled_events);
+  void onPrepareForPoll();
+  void publishBusyTime();
 
-  // Helper used to touch the watchdog after most schedulable, fd, and timer callbacks.
+  // Helper used to touch the watchdog after most schedulable, fd, and timer callbacks. Also counts
+  // the callbacks, so that hybrid polling can tell whether an iteration of the loop handled events.
   void touchWatchdog();
 
   // Validate that an operation is thread safe, i.e. it's invoked on the same thread that the
@@ -150,6 +159,8 @@ private:
   Buffer::WatermarkFactorySharedPtr buffer_factory_;
   LibeventScheduler base_scheduler_;
   SchedulerPtr scheduler_;
+  // Optional timing wheel backing the timers of the dispatcher instead of the libevent timer heap.
+  TimerWheelPtr timer_wheel_;
 
   SchedulableCallbackPtr thread_local_delete_cb_;
   Thread::MutexBasicLockable thread_local_deletable_lock_;
@@ -174,6 +185,18 @@ private:
   MonotonicTime approximate_monotonic_time_;
   WatchdogRegistrationPtr watchdog_registration_;
   const ScaledRangeTimerManagerPtr scaled_timer_manager_;
+  // Optional slab allocator for the storage of buffer slices allocated on the dispatcher thread.
+  Buffer::SliceStoragePoolPtr slice_storage_pool_;
+  // How long run() in the Block mode keeps polling without blocking after the last event. Zero
+  // disables hybrid polling.
+  std::chrono::microseconds hybrid_polling_spin_duration_{};
+  uint64_t handled_events_{};
+  DispatcherLoad load_;
+  // Busy tracking state, used only once busy tracking of load_ is enabled.
+  TimerPtr load_timer_;
+  MonotonicTime poll_end_time_;
+  MonotonicTime load_period_start_;
+  std::chrono::nanoseconds busy_time_{};
 };
 
 } // namespace Event
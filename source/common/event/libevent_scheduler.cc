@@ -61,6 +61,15 @@ void LibeventScheduler::run(Dispatcher::RunType mode) {
   event_base_loop(libevent_.get(), flag);
 }
 
+bool LibeventScheduler::runOnce(bool block) {
+  run_callbacks_ = block;
+  const int result =
+      event_base_loop(libevent_.get(), block ? EVLOOP_ONCE : flagsBasedOnEventType());
+  run_callbacks_ = true;
+  return result == 0 && !event_base_got_exit(libevent_.get()) &&
+         !event_base_got_break(libevent_.get());
+}
+
 void LibeventScheduler::loopExit() { event_base_loopexit(libevent_.get(), nullptr); }
 
 void LibeventScheduler::registerOnPrepareCallback(OnPrepareCallback&& callback) {
@@ -89,13 +98,17 @@ void LibeventScheduler::initializeStats(DispatcherStats* stats) {
 void LibeventScheduler::onPrepareForCallback(evwatch*, const evwatch_prepare_cb_info*, void* arg) {
   // `self` is `this`, passed in from evwatch_prepare_new.
   auto self = static_cast<LibeventScheduler*>(arg);
-  self->prepare_callback_();
+  if (self->run_callbacks_) {
+    self->prepare_callback_();
+  }
 }
 
 void LibeventScheduler::onCheckForCallback(evwatch*, const evwatch_check_cb_info*, void* arg) {
   // `self` is `this`, passed in from evwatch_prepare_new.
   auto self = static_cast<LibeventScheduler*>(arg);
-  self->check_callback_();
+  if (self->run_callbacks_) {
+    self->check_callback_();
+  }
 }
 
 void LibeventScheduler::onPrepareForStats(evwatch*, const evwatch_prepare_cb_info* info,
@@ -72,6 +72,15 @@ public:
    */
   void run(Dispatcher::RunType mode);
 
+  /**
+   * Runs a single iteration of the event loop. The prepare and check callbacks are only called
+   * when it blocks.
+   *
+   * @param block supplies whether to wait for events if none are active.
+   * @return false if the loop has no more events registered or was asked to exit, true otherwise.
+   */
+  bool runOnce(bool block);
+
   /**
    * Exits the libevent loop.
    */
@@ -133,6 +142,8 @@ private:
   timeval check_time_{};     // timestamp immediately after polling
   OnPrepareCallback prepare_callback_; // callback to be called from onPrepareForCallback()
   OnCheckCallback check_callback_;     // callback to be called from onCheckForCallback()
+  // Whether the prepare and check callbacks are called in the current iteration.
+  bool run_callbacks_{true};
 };
 
 } // namespace Event
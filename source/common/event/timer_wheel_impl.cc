@@ -0,0 +1,303 @@
+#include "source/common/event/timer_wheel_impl.h"
+
+#include <algorithm>
+#include <chrono>
+
+#include "source/common/common/assert.h"
+#include "source/common/common/scope_tracker.h"
+
+#include "absl/numeric/bits.h"
+
+namespace Envoy {
+namespace Event {
+
+/**
+ * Timer kept in a TimerWheel. The timer is linked into at most one list of the wheel at a time:
+ * a slot of the wheel, or one of the lists of zero duration timers.
+ */
+class TimerWheel::WheelTimer final : public Timer {
+public:
+  // Values of location_ other than the levels of the wheel.
+  static constexpr uint8_t Ready = Levels;
+  static constexpr uint8_t Disabled = Ready + 2;
+
+  WheelTimer(TimerWheel& wheel, TimerCb cb) : wheel_(wheel), cb_(std::move(cb)) { ASSERT(cb_); }
+  ~WheelTimer() override {
+    if (enabled()) {
+      wheel_.unlink(*this);
+    }
+  }
+
+  // Timer
+  void disableTimer() override {
+    ASSERT(wheel_.dispatcher_.isThreadSafe());
+    if (enabled()) {
+      wheel_.unlink(*this);
+    }
+  }
+
+  void enableTimer(std::chrono::milliseconds ms, const ScopeTrackedObject* object) override {
+    // Clip before converting to avoid overflowing the microseconds representation.
+    const auto max_duration =
+        std::chrono::duration_cast<std::chrono::milliseconds>(wheel_.maxDuration());
+    enableHRTimer(std::chrono::duration_cast<std::chrono::microseconds>(std::min(ms, max_duration)),
+                  object);
+  }
+
+  void enableHRTimer(std::chrono::microseconds us, const ScopeTrackedObject* object) override {
+    object_ = object;
+    wheel_.enableTimer(*this, us);
+  }
+
+  bool enabled() override { return location_ != Disabled; }
+
+private:
+  friend class TimerWheel;
+
+  TimerWheel& wheel_;
+  const TimerCb cb_;
+  const ScopeTrackedObject* object_{};
+  // Links of the list the timer is in.
+  WheelTimer* prev_{};
+  WheelTimer* next_{};
+  // The tick at which the timer expires.
+  uint64_t expiry_{};
+  // The level of the wheel, or Ready + the index of the list of zero duration timers, the timer is
+  // linked into, or Disabled.
+  uint8_t location_{Disabled};
+  uint8_t slot_{};
+};
+
+void TimerWheel::TimerList::pushBack(WheelTimer& timer) {
+  timer.prev_ = tail_;
+  timer.next_ = nullptr;
+  if (tail_ != nullptr) {
+    tail_->next_ = &timer;
+  } else {
+    head_ = &timer;
+  }
+  tail_ = &timer;
+}
+
+TimerWheel::WheelTimer* TimerWheel::TimerList::popFront() {
+  WheelTimer* timer = head_;
+  if (timer != nullptr) {
+    remove(*timer);
+  }
+  return timer;
+}
+
+void TimerWheel::TimerList::remove(WheelTimer& timer) {
+  if (timer.prev_ != nullptr) {
+    timer.prev_->next_ = timer.next_;
+  } else {
+    head_ = timer.next_;
+  }
+  if (timer.next_ != nullptr) {
+    timer.next_->prev_ = timer.prev_;
+  } else {
+    tail_ = timer.prev_;
+  }
+  timer.prev_ = nullptr;
+  timer.next_ = nullptr;
+}
+
+TimerWheel::TimerWheel(Scheduler& scheduler, Dispatcher& dispatcher, TimeSource& time_source,
+                       std::chrono::microseconds tick)
+    : dispatcher_(dispatcher), time_source_(time_source), tick_(tick),
+      start_(time_source.monotonicTime()),
+      driver_timer_(scheduler.createTimer([this]() { onDriverTimer(); }, dispatcher)),
+      ready_timer_(scheduler.createTimer([this]() { onReadyTimer(); }, dispatcher)) {
+  ASSERT(tick_ > std::chrono::microseconds::zero());
+}
+
+TimerPtr TimerWheel::createTimer(const TimerCb& cb, Dispatcher& dispatcher) {
+  ASSERT(&dispatcher == &dispatcher_);
+  return std::make_unique<WheelTimer>(*this, cb);
+}
+
+void TimerWheel::enableTimer(WheelTimer& timer, std::chrono::microseconds duration) {
+  ASSERT(dispatcher_.isThreadSafe());
+  if (timer.enabled()) {
+    unlink(timer);
+  }
+  if (duration.count() < 0) {
+    IS_ENVOY_BUG(fmt::format("Negative duration passed to enableTimer(): {}", duration.count()));
+    duration = std::chrono::microseconds::zero();
+  }
+  ++size_;
+
+  if (duration == std::chrono::microseconds::zero()) {
+    timer.location_ = WheelTimer::Ready + ready_index_;
+    ready_[ready_index_].pushBack(timer);
+    if (!ready_timer_->enabled()) {
+      ready_timer_->enableTimer(std::chrono::milliseconds::zero());
+    }
+    return;
+  }
+
+  const MonotonicTime now = time_source_.monotonicTime();
+  if (!processing_) {
+    // Advance the wheel as far as possible without skipping a slot that needs processing, so that
+    // the timer is placed in the lowest level that covers its duration. The driver is never
+    // enabled for a tick later than the next slot to process.
+    const uint64_t current_tick = currentTick(now);
+    if (driver_tick_.has_value()) {
+      now_tick_ = std::max(now_tick_, std::min(current_tick, driver_tick_.value() - 1));
+    } else if (wheelEmpty()) {
+      now_tick_ = std::max(now_tick_, current_tick);
+    }
+  }
+  // Round up so the timer never fires early.
+  const std::chrono::microseconds expiry_time =
+      std::chrono::ceil<std::chrono::microseconds>(now - start_) +
+      std::min(duration, maxDuration());
+  timer.expiry_ = std::clamp<uint64_t>((expiry_time.count() + tick_.count() - 1) / tick_.count(),
+                                       now_tick_ + 1, now_tick_ + MaxTicks);
+  insert(timer);
+
+  // The wheel needs to be processed at the start of the slot the timer was placed in: to run the
+  // timer if it is in the lowest level, or to cascade it to a lower level otherwise.
+  const uint32_t shift = SlotBits * timer.location_;
+  const uint64_t event_tick = (timer.expiry_ >> shift) << shift;
+  if (!driver_tick_.has_value() || event_tick < driver_tick_.value()) {
+    scheduleDriver(event_tick, now);
+  }
+}
+
+void TimerWheel::unlink(WheelTimer& timer) {
+  ASSERT(timer.enabled());
+  if (timer.location_ >= WheelTimer::Ready) {
+    ready_[timer.location_ - WheelTimer::Ready].remove(timer);
+  } else {
+    TimerList& list = slots_[timer.location_][timer.slot_];
+    list.remove(timer);
+    if (list.empty()) {
+      occupied_[timer.location_] &= ~(uint64_t(1) << timer.slot_);
+    }
+  }
+  timer.location_ = WheelTimer::Disabled;
+  --size_;
+}
+
+void TimerWheel::insert(WheelTimer& timer) {
+  ASSERT(timer.expiry_ >= now_tick_);
+  const uint64_t remaining = timer.expiry_ - now_tick_;
+  uint32_t level = 0;
+  while (level < Levels - 1 && remaining >= (uint64_t(1) << (SlotBits * (level + 1)))) {
+    ++level;
+  }
+  const uint32_t slot = slotIndex(timer.expiry_, level);
+  timer.location_ = level;
+  timer.slot_ = slot;
+  slots_[level][slot].pushBack(timer);
+  occupied_[level] |= uint64_t(1) << slot;
+}
+
+bool TimerWheel::wheelEmpty() const {
+  return std::all_of(occupied_.begin(), occupied_.end(),
+                     [](uint64_t occupied) { return occupied == 0; });
+}
+
+std::chrono::microseconds TimerWheel::maxDuration() const {
+  return std::chrono::microseconds(tick_.count() * static_cast<int64_t>(MaxTicks));
+}
+
+uint64_t TimerWheel::currentTick(MonotonicTime now) const {
+  return std::chrono::duration_cast<std::chrono::microseconds>(now - start_) / tick_;
+}
+
+absl::optional<uint64_t> TimerWheel::nextEventTick() const {
+  absl::optional<uint64_t> next;
+  for (uint32_t level = 0; level < Levels; ++level) {
+    if (occupied_[level] == 0) {
+      continue;
+    }
+    // Find the first non-empty slot after the current one, wrapping around to the current slot
+    // itself, which then holds timers for the next rotation of the level.
+    const uint32_t shift = SlotBits * level;
+    const uint64_t position = now_tick_ >> shift;
+    const uint64_t rotated =
+        absl::rotr(occupied_[level], static_cast<int>((position + 1) & (SlotsPerLevel - 1)));
+    const uint64_t tick = (position + absl::countr_zero(rotated) + 1) << shift;
+    if (!next.has_value() || tick < next.value()) {
+      next = tick;
+    }
+  }
+  return next;
+}
+
+void TimerWheel::scheduleDriver(uint64_t event_tick, MonotonicTime now) {
+  driver_tick_ = event_tick;
+  const MonotonicTime event_time =
+      start_ + std::chrono::microseconds(tick_.count() * static_cast<int64_t>(event_tick));
+  driver_timer_->enableHRTimer(
+      event_time > now ? std::chrono::ceil<std::chrono::microseconds>(event_time - now)
+                       : std::chrono::microseconds::zero());
+}
+
+void TimerWheel::onDriverTimer() {
+  driver_tick_.reset();
+  processing_ = true;
+  const uint64_t target = currentTick(time_source_.monotonicTime());
+  for (absl::optional<uint64_t> tick = nextEventTick(); tick.has_value() && tick.value() <= target;
+       tick = nextEventTick()) {
+    now_tick_ = tick.value();
+    // Cascade the higher levels first, as their timers may land in a lower level slot that starts
+    // at the same tick.
+    for (uint32_t level = Levels - 1; level > 0; --level) {
+      if ((now_tick_ & ((uint64_t(1) << (SlotBits * level)) - 1)) == 0) {
+        cascade(level, slotIndex(now_tick_, level));
+      }
+    }
+    // Timers enabled by the callbacks expire after now_tick_, so they are never added to the slot
+    // being run.
+    runList(slots_[0][slotIndex(now_tick_, 0)]);
+  }
+  now_tick_ = std::max(now_tick_, target);
+  processing_ = false;
+
+  // Timers enabled by the callbacks may have enabled the driver already, possibly for a later tick
+  // than the next slot to process.
+  const absl::optional<uint64_t> next = nextEventTick();
+  if (next.has_value() && (!driver_tick_.has_value() || next.value() < driver_tick_.value())) {
+    scheduleDriver(next.value(), time_source_.monotonicTime());
+  }
+}
+
+void TimerWheel::onReadyTimer() {
+  TimerList& list = ready_[ready_index_];
+  ready_index_ ^= 1;
+  runList(list);
+}
+
+void TimerWheel::cascade(uint32_t level, uint32_t slot) {
+  TimerList list = slots_[level][slot];
+  slots_[level][slot] = {};
+  occupied_[level] &= ~(uint64_t(1) << slot);
+  while (WheelTimer* timer = list.popFront()) {
+    insert(*timer);
+  }
+}
+
+void TimerWheel::runList(TimerList& list) {
+  while (!list.empty()) {
+    WheelTimer& timer = *list.head_;
+    unlink(timer);
+    run(timer);
+  }
+}
+
+void TimerWheel::run(WheelTimer& timer) {
+  // The callback may destroy the timer, so it must not be accessed after the callback is invoked.
+  if (timer.object_ == nullptr) {
+    timer.cb_();
+    return;
+  }
+  ScopeTrackerScopeState scope(timer.object_, dispatcher_);
+  timer.object_ = nullptr;
+  timer.cb_();
+}
+
+} // namespace Event
+} // namespace Envoy
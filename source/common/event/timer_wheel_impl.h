@@ -0,0 +1,123 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+
+#include "envoy/common/time.h"
+#include "envoy/event/dispatcher.h"
+#include "envoy/event/timer.h"
+
+#include "absl/types/optional.h"
+
+namespace Envoy {
+namespace Event {
+
+/**
+ * Scheduler that keeps its timers in a hierarchical timing wheel with a fixed tick, instead of
+ * in the libevent timer heap. Enabling and disabling a timer are O(1) list operations, which makes
+ * the wheel a good fit for the large number of idle and stream timeouts that are re-armed long
+ * before they fire.
+ *
+ * The wheel has Levels levels of SlotsPerLevel slots each. A slot of level N covers
+ * SlotsPerLevel^N ticks; a timer lives in the lowest level whose span covers its remaining
+ * duration, and is cascaded to a lower level when the wheel reaches the start of its slot. Timers
+ * are rounded up to whole ticks, so they never fire early and fire at most one tick late. A
+ * single timer of the underlying scheduler is armed for the next tick at which a slot needs
+ * processing, so an idle wheel does not wake up the event loop every tick.
+ *
+ * Timers enabled with a zero duration bypass the wheel and run in the next iteration of the event
+ * loop, like zero duration libevent timers do.
+ *
+ * Like the timers of the dispatcher, timers created by the wheel must be used on the dispatcher
+ * thread only and must be freed before the wheel is destroyed.
+ */
+class TimerWheel : public Scheduler {
+public:
+  static constexpr uint32_t SlotBits = 6;
+  static constexpr uint32_t SlotsPerLevel = 1 << SlotBits;
+  static constexpr uint32_t Levels = 6;
+  // The maximum number of ticks a timer can be scheduled ahead. Longer durations are clipped.
+  static constexpr uint64_t MaxTicks = (uint64_t(1) << (SlotBits * Levels)) - 1;
+
+  /**
+   * @param scheduler supplies the scheduler used to create the timers driving the wheel.
+   * @param dispatcher supplies the dispatcher the wheel's timers run on.
+   * @param time_source supplies the monotonic clock of the wheel. This must be the clock the
+   *        timers of the scheduler are based on.
+   * @param tick supplies the granularity of the wheel.
+   */
+  TimerWheel(Scheduler& scheduler, Dispatcher& dispatcher, TimeSource& time_source,
+             std::chrono::microseconds tick);
+
+  // Scheduler
+  TimerPtr createTimer(const TimerCb& cb, Dispatcher& dispatcher) override;
+
+  /**
+   * @return the number of enabled timers.
+   */
+  uint64_t size() const { return size_; }
+
+private:
+  class WheelTimer;
+
+  // An intrusive FIFO list of timers.
+  struct TimerList {
+    void pushBack(WheelTimer& timer);
+    WheelTimer* popFront();
+    void remove(WheelTimer& timer);
+    bool empty() const { return head_ == nullptr; }
+
+    WheelTimer* head_{};
+    WheelTimer* tail_{};
+  };
+
+  static uint32_t slotIndex(uint64_t tick, uint32_t level) {
+    return (tick >> (SlotBits * level)) & (SlotsPerLevel - 1);
+  }
+
+  void enableTimer(WheelTimer& timer, std::chrono::microseconds duration);
+  void unlink(WheelTimer& timer);
+  void insert(WheelTimer& timer);
+  bool wheelEmpty() const;
+  std::chrono::microseconds maxDuration() const;
+  uint64_t currentTick(MonotonicTime now) const;
+  absl::optional<uint64_t> nextEventTick() const;
+  void scheduleDriver(uint64_t event_tick, MonotonicTime now);
+  void onDriverTimer();
+  void onReadyTimer();
+  void cascade(uint32_t level, uint32_t slot);
+  void runList(TimerList& list);
+  void run(WheelTimer& timer);
+
+  Dispatcher& dispatcher_;
+  TimeSource& time_source_;
+  const std::chrono::microseconds tick_;
+  // The time of tick zero.
+  const MonotonicTime start_;
+  // The last tick processed by the wheel.
+  uint64_t now_tick_{};
+  std::array<std::array<TimerList, SlotsPerLevel>, Levels> slots_;
+  // Per level bitmap of the non-empty slots.
+  std::array<uint64_t, Levels> occupied_{};
+  // Timers enabled with a zero duration. One of the lists collects the newly enabled timers while
+  // the timers of the other one are being run, so that timers re-enabled from their callback run
+  // in the next event loop iteration.
+  std::array<TimerList, 2> ready_;
+  uint32_t ready_index_{};
+  // Fires at the next tick with a non-empty slot to process.
+  const TimerPtr driver_timer_;
+  // Fires in the next event loop iteration to run the ready timers.
+  const TimerPtr ready_timer_;
+  // The tick driver_timer_ is enabled for, if any.
+  absl::optional<uint64_t> driver_tick_;
+  // Whether the driver is processing slots, during which now_tick_ must not be advanced by timers
+  // enabled from the callbacks.
+  bool processing_{};
+  uint64_t size_{};
+};
+
+using TimerWheelPtr = std::unique_ptr<TimerWheel>;
+
+} // namespace Event
+} // namespace Envoy
@@ -81,6 +81,24 @@ Protobuf::Value HeaderFormatter::formatValue(OptRef<const Http::HeaderMap> heade
   return ValueUtil::stringValue(std::string(val));
 }
 
+bool HeaderFormatter::formatTo(OptRef<const Http::HeaderMap> headers, std::string& output) const {
+  const Http::HeaderEntry* header = findHeader(headers);
+  if (!header) {
+    return false;
+  }
+
+  output.append(
+      SubstitutionFormatUtils::truncateStringView(header->value().getStringView(), max_length_));
+  return true;
+}
+
+void HeaderFormatter::formatJsonTo(OptRef<const Http::HeaderMap> headers, std::string& output,
+                                   std::string& sanitize_buffer) const {
+  SubstitutionFormatUtils::appendJsonString(
+      output, sanitize_buffer,
+      [this, headers](std::string& value_output) { return formatTo(headers, value_output); });
+}
+
 ResponseHeaderFormatter::ResponseHeaderFormatter(absl::string_view main_header,
                                                  absl::string_view alternative_header,
                                                  absl::optional<size_t> max_length)
@@ -96,6 +114,18 @@ Protobuf::Value ResponseHeaderFormatter::formatValue(const Context& context,
   return HeaderFormatter::formatValue(context.responseHeaders());
 }
 
+bool ResponseHeaderFormatter::formatTo(const Context& context, const StreamInfo::StreamInfo&,
+                                       std::string& output) const {
+  return HeaderFormatter::formatTo(context.responseHeaders(), output);
+}
+
+bool ResponseHeaderFormatter::formatJsonTo(const Context& context, const StreamInfo::StreamInfo&,
+                                           std::string& output,
+                                           std::string& sanitize_buffer) const {
+  HeaderFormatter::formatJsonTo(context.responseHeaders(), output, sanitize_buffer);
+  return true;
+}
+
 RequestHeaderFormatter::RequestHeaderFormatter(absl::string_view main_header,
                                                absl::string_view alternative_header,
                                                absl::optional<size_t> max_length)
@@ -111,6 +141,17 @@ Protobuf::Value RequestHeaderFormatter::formatValue(const Context& context,
   return HeaderFormatter::formatValue(context.requestHeaders());
 }
 
+bool RequestHeaderFormatter::formatTo(const Context& context, const StreamInfo::StreamInfo&,
+                                      std::string& output) const {
+  return HeaderFormatter::formatTo(context.requestHeaders(), output);
+}
+
+bool RequestHeaderFormatter::formatJsonTo(const Context& context, const StreamInfo::StreamInfo&,
+                                          std::string& output, std::string& sanitize_buffer) const {
+  HeaderFormatter::formatJsonTo(context.requestHeaders(), output, sanitize_buffer);
+  return true;
+}
+
 ResponseTrailerFormatter::ResponseTrailerFormatter(absl::string_view main_header,
                                                    absl::string_view alternative_header,
                                                    absl::optional<size_t> max_length)
@@ -126,6 +167,18 @@ Protobuf::Value ResponseTrailerFormatter::formatValue(const Context& context,
   return HeaderFormatter::formatValue(context.responseTrailers());
 }
 
+bool ResponseTrailerFormatter::formatTo(const Context& context, const StreamInfo::StreamInfo&,
+                                        std::string& output) const {
+  return HeaderFormatter::formatTo(context.responseTrailers(), output);
+}
+
+bool ResponseTrailerFormatter::formatJsonTo(const Context& context, const StreamInfo::StreamInfo&,
+                                            std::string& output,
+                                            std::string& sanitize_buffer) const {
+  HeaderFormatter::formatJsonTo(context.responseTrailers(), output, sanitize_buffer);
+  return true;
+}
+
 HeadersByteSizeFormatter::HeadersByteSizeFormatter(const HeaderType header_type)
     : header_type_(header_type) {}
 
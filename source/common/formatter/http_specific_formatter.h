@@ -55,6 +55,9 @@ public:
 protected:
   absl::optional<std::string> format(OptRef<const Http::HeaderMap> headers) const;
   Protobuf::Value formatValue(OptRef<const Http::HeaderMap> headers) const;
+  bool formatTo(OptRef<const Http::HeaderMap> headers, std::string& output) const;
+  void formatJsonTo(OptRef<const Http::HeaderMap> headers, std::string& output,
+                    std::string& sanitize_buffer) const;
 
 private:
   const Http::HeaderEntry* findHeader(OptRef<const Http::HeaderMap> headers) const;
@@ -99,6 +102,10 @@ public:
                                      const StreamInfo::StreamInfo& stream_info) const override;
   Protobuf::Value formatValue(const Context& context,
                               const StreamInfo::StreamInfo& stream_info) const override;
+  bool formatTo(const Context& context, const StreamInfo::StreamInfo& stream_info,
+                std::string& output) const override;
+  bool formatJsonTo(const Context& context, const StreamInfo::StreamInfo& stream_info,
+                    std::string& output, std::string& sanitize_buffer) const override;
 };
 
 /**
@@ -114,6 +121,10 @@ public:
                                      const StreamInfo::StreamInfo& stream_info) const override;
   Protobuf::Value formatValue(const Context& context,
                               const StreamInfo::StreamInfo& stream_info) const override;
+  bool formatTo(const Context& context, const StreamInfo::StreamInfo& stream_info,
+                std::string& output) const override;
+  bool formatJsonTo(const Context& context, const StreamInfo::StreamInfo& stream_info,
+                    std::string& output, std::string& sanitize_buffer) const override;
 };
 
 /**
@@ -129,6 +140,10 @@ public:
                                      const StreamInfo::StreamInfo& stream_info) const override;
   Protobuf::Value formatValue(const Context& context,
                               const StreamInfo::StreamInfo& stream_info) const override;
+  bool formatTo(const Context& context, const StreamInfo::StreamInfo& stream_info,
+                std::string& output) const override;
+  bool formatJsonTo(const Context& context, const StreamInfo::StreamInfo& stream_info,
+                    std::string& output, std::string& sanitize_buffer) const override;
 };
 
 /**
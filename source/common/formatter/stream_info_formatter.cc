@@ -8,6 +8,7 @@
 #include "source/common/runtime/runtime_features.h"
 #include "source/common/stream_info/utility.h"
 
+#include "absl/strings/ascii.h"
 #include "absl/strings/str_format.h"
 #include "absl/strings/str_replace.h"
 #include "re2/re2.h"
@@ -481,6 +482,26 @@ Protobuf::Value CommonDurationFormatter::formatValue(const StreamInfo::StreamInf
   }
   return ValueUtil::numberValue(duration.value());
 }
+bool CommonDurationFormatter::formatTo(const StreamInfo::StreamInfo& info,
+                                       std::string& output) const {
+  auto duration = getDurationCount(info);
+  if (!duration.has_value()) {
+    return false;
+  }
+  const fmt::format_int formatted(duration.value());
+  output.append(formatted.data(), formatted.size());
+  return true;
+}
+bool CommonDurationFormatter::formatJsonTo(const StreamInfo::StreamInfo& info,
+                                           std::string& output, std::string&) const {
+  auto duration = getDurationCount(info);
+  if (!duration.has_value()) {
+    SubstitutionFormatUtils::appendJsonNull(output);
+    return true;
+  }
+  SubstitutionFormatUtils::appendJsonNumber(duration.value(), output);
+  return true;
+}
 
 // A SystemTime formatter that extracts the startTime from StreamInfo. Must be provided
 // an access log command that starts with `START_TIME`.
@@ -563,6 +584,29 @@ Protobuf::Value SystemTimeFormatter::formatValue(const StreamInfo::StreamInfo& s
   return ValueUtil::optionalStringValue(format(stream_info));
 }
 
+bool SystemTimeFormatter::formatTo(const StreamInfo::StreamInfo& stream_info,
+                                   std::string& output) const {
+  const auto time_field = (*time_field_extractor_)(stream_info);
+  if (!time_field.has_value()) {
+    return false;
+  }
+  if (date_formatter_.formatString().empty()) {
+    AccessLogDateTimeFormatter::appendTime(time_field.value(), local_time_, output);
+  } else {
+    output.append(date_formatter_.fromTime(time_field.value()));
+  }
+  return true;
+}
+
+bool SystemTimeFormatter::formatJsonTo(const StreamInfo::StreamInfo& stream_info,
+                                       std::string& output, std::string& sanitize_buffer) const {
+  SubstitutionFormatUtils::appendJsonString(output, sanitize_buffer,
+                                            [this, &stream_info](std::string& value_output) {
+                                              return formatTo(stream_info, value_output);
+                                            });
+  return true;
+}
+
 EnvironmentFormatter::EnvironmentFormatter(absl::string_view key,
                                            absl::optional<size_t> max_length) {
   ASSERT(!key.empty());
@@ -599,6 +643,94 @@ public:
   Protobuf::Value formatValue(const StreamInfo::StreamInfo& stream_info) const override {
     return ValueUtil::optionalStringValue(field_extractor_(stream_info));
   }
+  bool formatJsonTo(const StreamInfo::StreamInfo& stream_info, std::string& output,
+                    std::string& sanitize_buffer) const override {
+    SubstitutionFormatUtils::appendJsonString(
+        output, sanitize_buffer, [this, &stream_info](std::string& value_output) {
+          return formatTo(stream_info, value_output);
+        });
+    return true;
+  }
+
+private:
+  FieldExtractor field_extractor_;
+};
+
+// StreamInfo string formatter provider for fields that are built from the StreamInfo, which are
+// appended to the output without an intermediate string.
+class StreamInfoAppendFormatterProvider : public StreamInfoFormatterProvider {
+public:
+  using FieldAppender = std::function<bool(const StreamInfo::StreamInfo&, std::string&)>;
+
+  StreamInfoAppendFormatterProvider(FieldAppender f) : field_appender_(f) {}
+
+  // StreamInfoFormatterProvider
+  absl::optional<std::string> format(const StreamInfo::StreamInfo& stream_info) const override {
+    std::string value;
+    if (!field_appender_(stream_info, value)) {
+      return absl::nullopt;
+    }
+    return value;
+  }
+  Protobuf::Value formatValue(const StreamInfo::StreamInfo& stream_info) const override {
+    return ValueUtil::optionalStringValue(format(stream_info));
+  }
+  bool formatTo(const StreamInfo::StreamInfo& stream_info, std::string& output) const override {
+    return field_appender_(stream_info, output);
+  }
+  bool formatJsonTo(const StreamInfo::StreamInfo& stream_info, std::string& output,
+                    std::string& sanitize_buffer) const override {
+    SubstitutionFormatUtils::appendJsonString(
+        output, sanitize_buffer, [this, &stream_info](std::string& value_output) {
+          return field_appender_(stream_info, value_output);
+        });
+    return true;
+  }
+
+private:
+  FieldAppender field_appender_;
+};
+
+// StreamInfo string field extractor for fields that are stored in the StreamInfo or in objects it
+// references, which are appended to the output without copies.
+class StreamInfoStringViewFormatterProvider : public StreamInfoFormatterProvider {
+public:
+  using FieldExtractor =
+      std::function<absl::optional<absl::string_view>(const StreamInfo::StreamInfo&)>;
+
+  StreamInfoStringViewFormatterProvider(FieldExtractor f) : field_extractor_(f) {}
+
+  // StreamInfoFormatterProvider
+  absl::optional<std::string> format(const StreamInfo::StreamInfo& stream_info) const override {
+    const auto value = field_extractor_(stream_info);
+    if (!value.has_value()) {
+      return absl::nullopt;
+    }
+    return std::string(value.value());
+  }
+  Protobuf::Value formatValue(const StreamInfo::StreamInfo& stream_info) const override {
+    const auto value = field_extractor_(stream_info);
+    if (!value.has_value()) {
+      return SubstitutionFormatUtils::unspecifiedValue();
+    }
+    return ValueUtil::stringValue(std::string(value.value()));
+  }
+  bool formatTo(const StreamInfo::StreamInfo& stream_info, std::string& output) const override {
+    const auto value = field_extractor_(stream_info);
+    if (!value.has_value()) {
+      return false;
+    }
+    output.append(value.value());
+    return true;
+  }
+  bool formatJsonTo(const StreamInfo::StreamInfo& stream_info, std::string& output,
+                    std::string& sanitize_buffer) const override {
+    SubstitutionFormatUtils::appendJsonString(
+        output, sanitize_buffer, [this, &stream_info](std::string& value_output) {
+          return formatTo(stream_info, value_output);
+        });
+    return true;
+  }
 
 private:
   FieldExtractor field_extractor_;
@@ -629,6 +761,27 @@ public:
 
     return ValueUtil::numberValue(millis.value());
   }
+  bool formatTo(const StreamInfo::StreamInfo& stream_info, std::string& output) const override {
+    const auto millis = extractMillis(stream_info);
+    if (!millis) {
+      return false;
+    }
+
+    const fmt::format_int formatted(millis.value());
+    output.append(formatted.data(), formatted.size());
+    return true;
+  }
+  bool formatJsonTo(const StreamInfo::StreamInfo& stream_info, std::string& output,
+                    std::string&) const override {
+    const auto millis = extractMillis(stream_info);
+    if (!millis) {
+      SubstitutionFormatUtils::appendJsonNull(output);
+      return true;
+    }
+
+    SubstitutionFormatUtils::appendJsonNumber(millis.value(), output);
+    return true;
+  }
 
 private:
   absl::optional<int64_t> extractMillis(const StreamInfo::StreamInfo& stream_info) const {
@@ -656,6 +809,16 @@ public:
   Protobuf::Value formatValue(const StreamInfo::StreamInfo& stream_info) const override {
     return ValueUtil::numberValue(field_extractor_(stream_info));
   }
+  bool formatTo(const StreamInfo::StreamInfo& stream_info, std::string& output) const override {
+    const fmt::format_int formatted(field_extractor_(stream_info));
+    output.append(formatted.data(), formatted.size());
+    return true;
+  }
+  bool formatJsonTo(const StreamInfo::StreamInfo& stream_info, std::string& output,
+                    std::string&) const override {
+    SubstitutionFormatUtils::appendJsonNumber(field_extractor_(stream_info), output);
+    return true;
+  }
 
 private:
   FieldExtractor field_extractor_;
@@ -711,8 +874,61 @@ public:
 
     return ValueUtil::stringValue(toString(*address));
   }
+  bool formatTo(const StreamInfo::StreamInfo& stream_info, std::string& output) const override {
+    Network::Address::InstanceConstSharedPtr address = field_extractor_(stream_info);
+    if (!address) {
+      return false;
+    }
+
+    appendTo(*address, output);
+    return true;
+  }
+  bool formatJsonTo(const StreamInfo::StreamInfo& stream_info, std::string& output,
+                    std::string& sanitize_buffer) const override {
+    Network::Address::InstanceConstSharedPtr address = field_extractor_(stream_info);
+    if (!address) {
+      SubstitutionFormatUtils::appendJsonNull(output);
+      return true;
+    }
+
+    if (extraction_type_ == StreamInfoAddressFieldExtractionType::JustPort) {
+      const auto port = StreamInfo::Utility::extractDownstreamAddressJustPort(*address);
+      if (port) {
+        SubstitutionFormatUtils::appendJsonNumber(*port, output);
+      } else {
+        SubstitutionFormatUtils::appendJsonNull(output);
+      }
+      return true;
+    }
+
+    SubstitutionFormatUtils::appendJsonString(output, sanitize_buffer,
+                                              [this, &address](std::string& value_output) {
+                                                appendTo(*address, value_output);
+                                                return true;
+                                              });
+    return true;
+  }
 
 private:
+  // Same as toString(), without copying the strings owned by the address.
+  void appendTo(const Network::Address::Instance& address, std::string& output) const {
+    switch (extraction_type_) {
+    case StreamInfoAddressFieldExtractionType::WithoutPort:
+      output.append(StreamInfo::Utility::formatDownstreamAddressNoPort(address));
+      return;
+    case StreamInfoAddressFieldExtractionType::JustPort:
+      if (address.type() == Network::Address::Type::Ip) {
+        const fmt::format_int formatted(address.ip()->port());
+        output.append(formatted.data(), formatted.size());
+      }
+      return;
+    case StreamInfoAddressFieldExtractionType::WithPort:
+    default:
+      output.append(address.asString());
+      return;
+    }
+  }
+
   std::string toString(const Network::Address::Instance& address) const {
     switch (extraction_type_) {
     case StreamInfoAddressFieldExtractionType::WithoutPort:
@@ -957,20 +1173,32 @@ const StreamInfoFormatterProviderLookupTable& getKnownStreamInfoFormatterProvide
           {"PROTOCOL",
            {CommandSyntaxChecker::COMMAND_ONLY,
             [](absl::string_view, absl::optional<size_t>) {
-              return std::make_unique<StreamInfoStringFormatterProvider>(
-                  [](const StreamInfo::StreamInfo& stream_info) {
-                    return SubstitutionFormatUtils::protocolToString(stream_info.protocol());
+              return std::make_unique<StreamInfoStringViewFormatterProvider>(
+                  [](const StreamInfo::StreamInfo& stream_info)
+                      -> absl::optional<absl::string_view> {
+                    const auto protocol =
+                        SubstitutionFormatUtils::protocolToString(stream_info.protocol());
+                    if (!protocol.has_value()) {
+                      return absl::nullopt;
+                    }
+                    return protocol->get();
                   });
             }}},
           {"UPSTREAM_PROTOCOL",
            {CommandSyntaxChecker::COMMAND_ONLY,
             [](absl::string_view, absl::optional<size_t>) {
-              return std::make_unique<StreamInfoStringFormatterProvider>(
-                  [](const StreamInfo::StreamInfo& stream_info) {
-                    return stream_info.upstreamInfo()
-                               ? SubstitutionFormatUtils::protocolToString(
-                                     stream_info.upstreamInfo()->upstreamProtocol())
-                               : absl::nullopt;
+              return std::make_unique<StreamInfoStringViewFormatterProvider>(
+                  [](const StreamInfo::StreamInfo& stream_info)
+                      -> absl::optional<absl::string_view> {
+                    if (!stream_info.upstreamInfo()) {
+                      return absl::nullopt;
+                    }
+                    const auto protocol = SubstitutionFormatUtils::protocolToString(
+                        stream_info.upstreamInfo()->upstreamProtocol());
+                    if (!protocol.has_value()) {
+                      return absl::nullopt;
+                    }
+                    return protocol->get();
                   });
             }}},
           {"RESPONSE_CODE",
@@ -985,13 +1213,24 @@ const StreamInfoFormatterProviderLookupTable& getKnownStreamInfoFormatterProvide
            {CommandSyntaxChecker::PARAMS_OPTIONAL,
             [](absl::string_view format, absl::optional<size_t>) {
               bool allow_whitespaces = (format == "ALLOW_WHITESPACES");
-              return std::make_unique<StreamInfoStringFormatterProvider>(
-                  [allow_whitespaces](const StreamInfo::StreamInfo& stream_info) {
-                    if (allow_whitespaces || !stream_info.responseCodeDetails().has_value()) {
-                      return stream_info.responseCodeDetails();
+              return std::make_unique<StreamInfoAppendFormatterProvider>(
+                  [allow_whitespaces](const StreamInfo::StreamInfo& stream_info,
+                                      std::string& output) {
+                    const auto& details = stream_info.responseCodeDetails();
+                    if (!details.has_value()) {
+                      return false;
+                    }
+                    const size_t start = output.size();
+                    output.append(details.value());
+                    if (!allow_whitespaces) {
+                      // Same as StringUtil::replaceAllEmptySpace(), in place.
+                      for (size_t i = start; i < output.size(); i++) {
+                        if (absl::ascii_isspace(output[i])) {
+                          output[i] = '_';
+                        }
+                      }
                     }
-                    return absl::optional<std::string>(StringUtil::replaceAllEmptySpace(
-                        stream_info.responseCodeDetails().value()));
+                    return true;
                   });
             }}},
           {"CONNECTION_TERMINATION_DETAILS",
@@ -1080,25 +1319,27 @@ const StreamInfoFormatterProviderLookupTable& getKnownStreamInfoFormatterProvide
           {"CUSTOM_FLAGS",
            {CommandSyntaxChecker::COMMAND_ONLY,
             [](absl::string_view, absl::optional<size_t>) {
-              return std::make_unique<StreamInfoStringFormatterProvider>(
+              return std::make_unique<StreamInfoStringViewFormatterProvider>(
                   [](const StreamInfo::StreamInfo& stream_info) {
-                    return std::string(stream_info.customFlags());
+                    return absl::make_optional(stream_info.customFlags());
                   });
             }}},
           {"RESPONSE_FLAGS",
            {CommandSyntaxChecker::COMMAND_ONLY,
             [](absl::string_view, absl::optional<size_t>) {
-              return std::make_unique<StreamInfoStringFormatterProvider>(
-                  [](const StreamInfo::StreamInfo& stream_info) {
-                    return StreamInfo::ResponseFlagUtils::toShortString(stream_info);
+              return std::make_unique<StreamInfoAppendFormatterProvider>(
+                  [](const StreamInfo::StreamInfo& stream_info, std::string& output) {
+                    StreamInfo::ResponseFlagUtils::appendTo(stream_info, false, output);
+                    return true;
                   });
             }}},
           {"RESPONSE_FLAGS_LONG",
            {CommandSyntaxChecker::COMMAND_ONLY,
             [](absl::string_view, absl::optional<size_t>) {
-              return std::make_unique<StreamInfoStringFormatterProvider>(
-                  [](const StreamInfo::StreamInfo& stream_info) {
-                    return StreamInfo::ResponseFlagUtils::toString(stream_info);
+              return std::make_unique<StreamInfoAppendFormatterProvider>(
+                  [](const StreamInfo::StreamInfo& stream_info, std::string& output) {
+                    StreamInfo::ResponseFlagUtils::appendTo(stream_info, true, output);
+                    return true;
                   });
             }}},
           {"UPSTREAM_HOST_NAME",
@@ -1177,9 +1418,10 @@ const StreamInfoFormatterProviderLookupTable& getKnownStreamInfoFormatterProvide
           {"UPSTREAM_CLUSTER",
            {CommandSyntaxChecker::COMMAND_ONLY,
             [](absl::string_view, absl::optional<size_t>) {
-              return std::make_unique<StreamInfoStringFormatterProvider>(
-                  [](const StreamInfo::StreamInfo& stream_info) {
-                    std::string upstream_cluster_name;
+              return std::make_unique<StreamInfoStringViewFormatterProvider>(
+                  [](const StreamInfo::StreamInfo& stream_info)
+                      -> absl::optional<absl::string_view> {
+                    absl::string_view upstream_cluster_name;
                     if (stream_info.upstreamClusterInfo().has_value() &&
                         stream_info.upstreamClusterInfo().value() != nullptr) {
                       upstream_cluster_name =
@@ -1188,15 +1430,16 @@ const StreamInfoFormatterProviderLookupTable& getKnownStreamInfoFormatterProvide
 
                     return upstream_cluster_name.empty()
                                ? absl::nullopt
-                               : absl::make_optional<std::string>(upstream_cluster_name);
+                               : absl::make_optional(upstream_cluster_name);
                   });
             }}},
           {"UPSTREAM_CLUSTER_RAW",
            {CommandSyntaxChecker::COMMAND_ONLY,
             [](absl::string_view, absl::optional<size_t>) {
-              return std::make_unique<StreamInfoStringFormatterProvider>(
-                  [](const StreamInfo::StreamInfo& stream_info) {
-                    std::string upstream_cluster_name;
+              return std::make_unique<StreamInfoStringViewFormatterProvider>(
+                  [](const StreamInfo::StreamInfo& stream_info)
+                      -> absl::optional<absl::string_view> {
+                    absl::string_view upstream_cluster_name;
                     if (stream_info.upstreamClusterInfo().has_value() &&
                         stream_info.upstreamClusterInfo().value() != nullptr) {
                       upstream_cluster_name = stream_info.upstreamClusterInfo().value()->name();
@@ -1204,7 +1447,7 @@ const StreamInfoFormatterProviderLookupTable& getKnownStreamInfoFormatterProvide
 
                     return upstream_cluster_name.empty()
                                ? absl::nullopt
-                               : absl::make_optional<std::string>(upstream_cluster_name);
+                               : absl::make_optional(upstream_cluster_name);
                   });
             }}},
           {"UPSTREAM_LOCAL_ADDRESS",
@@ -1446,10 +1689,10 @@ const StreamInfoFormatterProviderLookupTable& getKnownStreamInfoFormatterProvide
           {"ROUTE_NAME",
            {CommandSyntaxChecker::COMMAND_ONLY,
             [](absl::string_view, absl::optional<size_t>) {
-              return std::make_unique<StreamInfoStringFormatterProvider>(
+              return std::make_unique<StreamInfoStringViewFormatterProvider>(
                   [](const StreamInfo::StreamInfo& stream_info) {
-                    absl::optional<std::string> result;
-                    std::string route_name = stream_info.getRouteName();
+                    absl::optional<absl::string_view> result;
+                    const std::string& route_name = stream_info.getRouteName();
                     if (!route_name.empty()) {
                       result = route_name;
                     }
@@ -1732,12 +1975,13 @@ const StreamInfoFormatterProviderLookupTable& getKnownStreamInfoFormatterProvide
           {"FILTER_CHAIN_NAME",
            {CommandSyntaxChecker::COMMAND_ONLY,
             [](absl::string_view, absl::optional<size_t>) {
-              return std::make_unique<StreamInfoStringFormatterProvider>(
-                  [](const StreamInfo::StreamInfo& stream_info) -> absl::optional<std::string> {
+              return std::make_unique<StreamInfoStringViewFormatterProvider>(
+                  [](const StreamInfo::StreamInfo& stream_info)
+                      -> absl::optional<absl::string_view> {
                     if (const auto info = stream_info.downstreamAddressProvider().filterChainInfo();
                         info.has_value()) {
                       if (!info->name().empty()) {
-                        return std::string(info->name());
+                        return info->name();
                       }
                     }
                     return absl::nullopt;
@@ -1746,8 +1990,9 @@ const StreamInfoFormatterProviderLookupTable& getKnownStreamInfoFormatterProvide
           {"VIRTUAL_CLUSTER_NAME",
            {CommandSyntaxChecker::COMMAND_ONLY,
             [](absl::string_view, absl::optional<size_t>) {
-              return std::make_unique<StreamInfoStringFormatterProvider>(
-                  [](const StreamInfo::StreamInfo& stream_info) -> absl::optional<std::string> {
+              return std::make_unique<StreamInfoStringViewFormatterProvider>(
+                  [](const StreamInfo::StreamInfo& stream_info)
+                      -> absl::optional<absl::string_view> {
                     return stream_info.virtualClusterName();
                   });
             }}},
@@ -1786,17 +2031,14 @@ const StreamInfoFormatterProviderLookupTable& getKnownStreamInfoFormatterProvide
           {"STREAM_ID",
            {CommandSyntaxChecker::COMMAND_ONLY,
             [](absl::string_view, absl::optional<size_t>) {
-              return std::make_unique<StreamInfoStringFormatterProvider>(
-                  [](const StreamInfo::StreamInfo& stream_info) -> absl::optional<std::string> {
+              return std::make_unique<StreamInfoStringViewFormatterProvider>(
+                  [](const StreamInfo::StreamInfo& stream_info)
+                      -> absl::optional<absl::string_view> {
                     auto provider = stream_info.getStreamIdProvider();
                     if (!provider.has_value()) {
                       return {};
                     }
-                    auto id = provider->toStringView();
-                    if (!id.has_value()) {
-                      return {};
-                    }
-                    return absl::make_optional<std::string>(id.value());
+                    return provider->toStringView();
                   });
             }}},
           {"START_TIME",
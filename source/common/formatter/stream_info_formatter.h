@@ -30,6 +30,14 @@ public:
                               const StreamInfo::StreamInfo& stream_info) const override {
     return formatValue(stream_info);
   }
+  bool formatTo(const Context&, const StreamInfo::StreamInfo& stream_info,
+                std::string& output) const override {
+    return formatTo(stream_info, output);
+  }
+  bool formatJsonTo(const Context&, const StreamInfo::StreamInfo& stream_info, std::string& output,
+                    std::string& sanitize_buffer) const override {
+    return formatJsonTo(stream_info, output, sanitize_buffer);
+  }
 
   /**
    * Format the value with the given stream info.
@@ -45,6 +53,32 @@ public:
    * @return Protobuf::Value containing a single value extracted from the given stream info.
    */
   virtual Protobuf::Value formatValue(const StreamInfo::StreamInfo& stream_info) const PURE;
+
+  /**
+   * Append the value extracted from the given stream info to the output buffer.
+   * @param stream_info supplies the stream info.
+   * @param output supplies the buffer the value is appended to.
+   * @return bool true if the value was appended, false if there is no value.
+   */
+  virtual bool formatTo(const StreamInfo::StreamInfo& stream_info, std::string& output) const {
+    const absl::optional<std::string> value = format(stream_info);
+    if (!value.has_value()) {
+      return false;
+    }
+    output.append(value.value());
+    return true;
+  }
+
+  /**
+   * Append the value extracted from the given stream info to the output buffer as a JSON value.
+   * @param stream_info supplies the stream info.
+   * @param output supplies the buffer the JSON value is appended to.
+   * @param sanitize_buffer supplies a scratch buffer for the escaping of string values.
+   * @return bool false if the provider does not support this and formatValue() has to be used.
+   */
+  virtual bool formatJsonTo(const StreamInfo::StreamInfo&, std::string&, std::string&) const {
+    return false;
+  }
 };
 
 using StreamInfoFormatterProviderPtr = std::unique_ptr<StreamInfoFormatterProvider>;
@@ -157,6 +191,9 @@ public:
   // StreamInfoFormatterProvider
   absl::optional<std::string> format(const StreamInfo::StreamInfo&) const override;
   Protobuf::Value formatValue(const StreamInfo::StreamInfo&) const override;
+  bool formatTo(const StreamInfo::StreamInfo&, std::string& output) const override;
+  bool formatJsonTo(const StreamInfo::StreamInfo&, std::string& output,
+                    std::string& sanitize_buffer) const override;
 
   static const absl::flat_hash_map<absl::string_view, TimePointGetter> KnownTimePointGetters;
 
@@ -211,6 +248,9 @@ public:
   // StreamInfoFormatterProvider
   absl::optional<std::string> format(const StreamInfo::StreamInfo&) const override;
   Protobuf::Value formatValue(const StreamInfo::StreamInfo&) const override;
+  bool formatTo(const StreamInfo::StreamInfo&, std::string& output) const override;
+  bool formatJsonTo(const StreamInfo::StreamInfo&, std::string& output,
+                    std::string& sanitize_buffer) const override;
 
 private:
   const Envoy::DateFormatter date_formatter_;
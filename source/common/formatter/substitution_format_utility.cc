@@ -5,6 +5,9 @@
 #include "source/common/api/os_sys_calls_impl.h"
 #include "source/common/http/header_utility.h"
 #include "source/common/http/utility.h"
+#include "source/common/json/constants.h"
+#include "source/common/json/json_sanitizer.h"
+#include "source/common/json/json_streamer.h"
 #include "source/common/protobuf/utility.h"
 #include "source/common/runtime/runtime_features.h"
 #include "source/common/stream_info/utility.h"
@@ -92,6 +95,30 @@ absl::string_view SubstitutionFormatUtils::truncateStringView(absl::string_view
   return str.substr(0, max_length.value());
 }
 
+void SubstitutionFormatUtils::sanitizeJsonSuffix(std::string& output, size_t offset,
+                                                 std::string& sanitize_buffer) {
+  const absl::string_view value = absl::string_view(output).substr(offset);
+  const absl::string_view sanitized = Json::sanitize(sanitize_buffer, value);
+  // The value is returned as is unless it has to be escaped, which is rare.
+  if (sanitized.data() != value.data()) {
+    output.resize(offset);
+    output.append(sanitized);
+  }
+}
+
+void SubstitutionFormatUtils::appendJsonNumber(double number, std::string& output) {
+  if (std::isnan(number)) {
+    appendJsonNull(output);
+    return;
+  }
+  Json::StringOutput string_output(output);
+  Buffer::Util::serializeDouble(number, string_output);
+}
+
+void SubstitutionFormatUtils::appendJsonNull(std::string& output) {
+  output.append(Json::Constants::Null);
+}
+
 absl::StatusOr<SubstitutionFormatUtils::HeaderPair>
 SubstitutionFormatUtils::parseSubcommandHeaders(absl::string_view subcommand) {
   absl::string_view main_header, alternative_header;
@@ -60,6 +60,46 @@ public:
   static absl::string_view truncateStringView(absl::string_view str,
                                               absl::optional<size_t> max_length);
 
+  /**
+   * JSON escape the part of the output that starts at the given offset, in place.
+   * @param output supplies the buffer to escape the end of.
+   * @param offset supplies the offset of the first character to escape.
+   * @param sanitize_buffer supplies a scratch buffer that is only used if escaping is needed.
+   */
+  static void sanitizeJsonSuffix(std::string& output, size_t offset, std::string& sanitize_buffer);
+
+  /**
+   * Append a number to the output in the JSON format of the number values of Protobuf::Value.
+   */
+  static void appendJsonNumber(double number, std::string& output);
+
+  /**
+   * Append a JSON null to the output.
+   */
+  static void appendJsonNull(std::string& output);
+
+  /**
+   * Append a JSON string with the value appended by format_to, or a JSON null if format_to
+   * returns false. This matches the serialization of the value of ValueUtil::optionalStringValue().
+   * @param output supplies the buffer the JSON value is appended to.
+   * @param sanitize_buffer supplies a scratch buffer for the escaping of the value.
+   * @param format_to supplies a callable of signature bool(std::string&) that appends the value
+   *        to its argument and returns whether there is a value.
+   */
+  template <class FormatTo>
+  static void appendJsonString(std::string& output, std::string& sanitize_buffer,
+                               const FormatTo& format_to) {
+    const size_t start = output.size();
+    output.push_back('"');
+    if (!format_to(output)) {
+      output.resize(start);
+      appendJsonNull(output);
+      return;
+    }
+    sanitizeJsonSuffix(output, start + 1, sanitize_buffer);
+    output.push_back('"');
+  }
+
   /**
    * Parse a header subcommand of the form: X?Y .
    * Will populate a main_header and an optional alternative header if specified.
@@ -1,5 +1,7 @@
 #include "source/common/formatter/substitution_formatter.h"
 
+#include "source/common/formatter/substitution_format_utility.h"
+
 namespace Envoy {
 namespace Formatter {
 
@@ -367,19 +369,19 @@ std::string FormatterImpl::format(const Context& context,
                                   const StreamInfo::StreamInfo& stream_info) const {
   std::string log_line;
   log_line.reserve(256);
+  formatTo(context, stream_info, log_line);
+  return log_line;
+}
 
+void FormatterImpl::formatTo(const Context& context, const StreamInfo::StreamInfo& stream_info,
+                             std::string& output) const {
   for (const auto& provider : providers_) {
-    const absl::optional<std::string> bit = provider->format(context, stream_info);
     // Add the formatted value if there is one. Otherwise add a default value
     // of "-" if omit_empty_values_ is not set.
-    if (bit.has_value()) {
-      log_line += bit.value();
-    } else if (!omit_empty_values_) {
-      log_line += DefaultUnspecifiedValueStringView;
+    if (!provider->formatTo(context, stream_info, output) && !omit_empty_values_) {
+      output.append(DefaultUnspecifiedValueStringView);
     }
   }
-
-  return log_line;
 }
 
 void stringValueToLogLine(const JsonFormatterImpl::Formatters& formatters, const Context& context,
@@ -387,15 +389,15 @@ void stringValueToLogLine(const JsonFormatterImpl::Formatters& formatters, const
                           std::string& sanitize, bool omit_empty_values) {
   log_line.push_back('"'); // Start the JSON string.
   for (const JsonFormatterImpl::Formatter& formatter : formatters) {
-    const absl::optional<std::string> value = formatter->format(context, info);
-    if (!value.has_value()) {
+    const size_t value_start = log_line.size();
+    if (!formatter->formatTo(context, info, log_line)) {
       // Add the empty value. This needn't be sanitized.
       log_line.append(omit_empty_values ? EMPTY_STRING : DefaultUnspecifiedValueStringView);
       continue;
     }
-    // Sanitize the string value and add it to the buffer. The string value will not be quoted
-    // since we handle the quoting by ourselves at the outer level.
-    log_line.append(Json::sanitize(sanitize, value.value()));
+    // Sanitize the string value in the buffer. The string value will not be quoted since we
+    // handle the quoting by ourselves at the outer level.
+    SubstitutionFormatUtils::sanitizeJsonSuffix(log_line, value_start, sanitize);
   }
   log_line.push_back('"'); // End the JSON string.
 }
@@ -418,6 +420,12 @@ std::string JsonFormatterImpl::format(const Context& context,
                                       const StreamInfo::StreamInfo& info) const {
   std::string log_line;
   log_line.reserve(2048);
+  formatTo(context, info, log_line);
+  return log_line;
+}
+
+void JsonFormatterImpl::formatTo(const Context& context, const StreamInfo::StreamInfo& info,
+                                 std::string& log_line) const {
   std::string sanitize; // Helper to serialize the value to log line.
 
   for (const ParsedFormatElement& element : parsed_elements_) {
@@ -438,14 +446,16 @@ std::string JsonFormatterImpl::format(const Context& context,
       stringValueToLogLine(formatters, context, info, log_line, sanitize, omit_empty_values_);
     } else {
       // 3. Handle the formatter element with a single provider and value
-      //    type needs to be kept.
-      const auto value = formatters[0]->formatValue(context, info);
-      Json::Utility::appendValueToString(value, log_line);
+      //    type needs to be kept. Providers of common values append them directly, the
+      //    others are serialized from their Protobuf::Value.
+      if (!formatters[0]->formatJsonTo(context, info, log_line, sanitize)) {
+        const auto value = formatters[0]->formatValue(context, info);
+        Json::Utility::appendValueToString(value, log_line);
+      }
     }
   }
 
   log_line.push_back('\n');
-  return log_line;
 }
 
 } // namespace Formatter
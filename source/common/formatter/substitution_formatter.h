@@ -39,6 +39,11 @@ public:
   Protobuf::Value formatValue(const Context&, const StreamInfo::StreamInfo&) const override {
     return str_;
   }
+  bool formatTo(const Context&, const StreamInfo::StreamInfo&,
+                std::string& output) const override {
+    output.append(str_.string_value());
+    return true;
+  }
 
 private:
   Protobuf::Value str_;
@@ -89,6 +94,8 @@ public:
   // Formatter
   std::string format(const Context& context,
                      const StreamInfo::StreamInfo& stream_info) const override;
+  void formatTo(const Context& context, const StreamInfo::StreamInfo& stream_info,
+                std::string& output) const override;
 
 protected:
   FormatterImpl(absl::Status& creation_status, absl::string_view format,
@@ -115,6 +122,8 @@ public:
 
   // Formatter
   std::string format(const Context& context, const StreamInfo::StreamInfo& info) const override;
+  void formatTo(const Context& context, const StreamInfo::StreamInfo& info,
+                std::string& output) const override;
 
 private:
   const bool omit_empty_values_;
@@ -910,6 +910,11 @@ ConnectionManagerImpl::ActiveStream::ActiveStream(ConnectionManagerImpl& connect
 
   connection_manager_.stats_.named_.downstream_rq_total_.inc();
   connection_manager_.stats_.named_.downstream_rq_active_.inc();
+  Event::DispatcherLoad& dispatcher_load = connection_manager_.dispatcher_->load();
+  if (dispatcher_load.streamTrackingEnabled()) {
+    dispatcher_load.incActiveStreams();
+    state_.counted_in_dispatcher_load_ = true;
+  }
   if (connection_manager_.codec_->protocol() == Protocol::Http2) {
     connection_manager_.stats_.named_.downstream_rq_http2_total_.inc();
   } else if (connection_manager_.codec_->protocol() == Protocol::Http3) {
@@ -988,6 +993,9 @@ void ConnectionManagerImpl::ActiveStream::completeRequest() {
   filter_manager_.streamInfo().onRequestComplete();
 
   connection_manager_.stats_.named_.downstream_rq_active_.dec();
+  if (state_.counted_in_dispatcher_load_) {
+    connection_manager_.dispatcher_->load().decActiveStreams();
+  }
   if (filter_manager_.streamInfo().healthCheck()) {
     connection_manager_.config_->tracingStats().health_check_.inc();
   }
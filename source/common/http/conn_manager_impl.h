@@ -383,6 +383,10 @@ private:
       // structure, so it can be atomically created and cleared.
       bool deferred_to_next_io_iteration_ : 1 = false;
       bool deferred_end_stream_ : 1 = false;
+
+      // True if the stream is counted in the active streams of the dispatcher load, which is only
+      // the case if a load aware connection balancer enabled stream tracking before it started.
+      bool counted_in_dispatcher_load_ : 1 = false;
     };
 
     bool canDestroyStream() const {
@@ -19,10 +19,14 @@ void FilterChainUtility::createFilterChainForFactories(
     Http::FilterChainManager& manager, const FilterChainOptions& options,
     const FilterFactoriesList& filter_factories) {
   bool added_missing_config_filter = false;
+  // Without overrides, e.g. for routes that configure no filter, the filter chain only depends on
+  // the filters that are disabled by default and no per filter lookup is needed.
+  const bool has_overrides = options.hasFilterDisabledOverrides();
   for (const auto& filter_config_provider : filter_factories) {
     // If this filter is disabled explicitly, skip trying to create it.
-    if (options.filterDisabled(filter_config_provider.provider->name())
-            .value_or(filter_config_provider.disabled)) {
+    if (has_overrides ? options.filterDisabled(filter_config_provider.provider->name())
+                            .value_or(filter_config_provider.disabled)
+                      : filter_config_provider.disabled) {
       continue;
     }
 
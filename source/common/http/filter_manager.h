@@ -1024,6 +1024,10 @@ private:
       return route_ != nullptr ? route_->filterDisabled(config_name) : absl::nullopt;
     }
 
+    bool hasFilterDisabledOverrides() const override {
+      return route_ != nullptr && route_->hasFilterDisabledOverrides();
+    }
+
   private:
     const Router::RouteConstSharedPtr route_;
   };
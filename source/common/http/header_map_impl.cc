@@ -1,5 +1,7 @@
 #include "source/common/http/header_map_impl.h"
 
+#include <algorithm>
+#include <cstddef>
 #include <cstdint>
 #include <list>
 #include <memory>
@@ -46,6 +48,56 @@ HeaderString::HeaderString(UnionString&& move_value) noexcept {
   ASSERT(valid());
 }
 
+HeaderNodeArena::~HeaderNodeArena() {
+  while (chunk_list_ != nullptr) {
+    Chunk* chunk = chunk_list_;
+    chunk_list_ = chunk->next_;
+    ::operator delete(chunk);
+  }
+}
+
+void* HeaderNodeArena::allocate(size_t size) {
+  if (slot_size_ == 0) {
+    // All nodes of a list have the same size, so the first allocation determines the slot size.
+    slot_size_ = (size + alignof(std::max_align_t) - 1) & ~(alignof(std::max_align_t) - 1);
+  }
+  if (size > slot_size_) {
+    return ::operator new(size);
+  }
+  if (free_slots_ != nullptr) {
+    FreeSlot* slot = free_slots_;
+    free_slots_ = slot->next_;
+    return slot;
+  }
+  if (next_slot_ == chunk_end_) {
+    newChunk();
+  }
+  void* slot = next_slot_;
+  next_slot_ += slot_size_;
+  return slot;
+}
+
+void HeaderNodeArena::deallocate(void* slot, size_t size) {
+  if (size > slot_size_) {
+    ::operator delete(slot);
+    return;
+  }
+  free_slots_ = new (slot) FreeSlot{free_slots_};
+}
+
+void HeaderNodeArena::newChunk() {
+  // Each chunk doubles the slots of the arena, up to MaxChunkSlots per chunk.
+  const uint32_t chunk_slots = std::clamp(slots_, FirstChunkSlots, MaxChunkSlots);
+  constexpr size_t header_size =
+      (sizeof(Chunk) + alignof(std::max_align_t) - 1) & ~(alignof(std::max_align_t) - 1);
+  char* memory = static_cast<char*>(::operator new(header_size + chunk_slots * slot_size_));
+  chunk_list_ = new (memory) Chunk{chunk_list_};
+  next_slot_ = memory + header_size;
+  chunk_end_ = next_slot_ + chunk_slots * slot_size_;
+  slots_ += chunk_slots;
+  chunks_++;
+}
+
 // Specialization needed for HeaderMapImpl::HeaderList::insert() when key is LowerCaseString.
 // A fully specialized template must be defined once in the program, hence this may not be in
 // a header file.
@@ -44,6 +44,83 @@ public:
   DEFINE_INLINE_HEADER_FUNCS(name)                                                                 \
   void set##name(uint64_t value) override { setInline(HeaderHandles::get().name, value); }
 
+/**
+ * Allocates the nodes of the header list of a single header map from chunks of contiguous,
+ * equally sized slots owned by the arena, so that the headers of a map sit next to each other in
+ * memory and adding a header rarely allocates. Slots freed by removed headers are reused by later
+ * insertions and chunks are only released with the arena, which lives as long as its header map.
+ */
+class HeaderNodeArena : NonCopyable {
+public:
+  HeaderNodeArena() = default;
+  ~HeaderNodeArena();
+
+  void* allocate(size_t size);
+  void deallocate(void* slot, size_t size);
+
+  // The number of chunks allocated by the arena.
+  uint32_t chunks() const { return chunks_; }
+
+private:
+  struct Chunk {
+    Chunk* next_;
+  };
+  struct FreeSlot {
+    FreeSlot* next_;
+  };
+
+  static constexpr uint32_t FirstChunkSlots = 4;
+  static constexpr uint32_t MaxChunkSlots = 32;
+
+  void newChunk();
+
+  Chunk* chunk_list_{};
+  FreeSlot* free_slots_{};
+  char* next_slot_{};
+  char* chunk_end_{};
+  size_t slot_size_{};
+  uint32_t slots_{};
+  uint32_t chunks_{};
+};
+
+/**
+ * Allocator of header list nodes which allocates from a HeaderNodeArena if it has one and from the
+ * heap otherwise.
+ */
+template <class T> class HeaderNodeAllocator {
+public:
+  using value_type = T;
+
+  explicit HeaderNodeAllocator(HeaderNodeArena* arena = nullptr) : arena_(arena) {}
+  template <class U>
+  HeaderNodeAllocator(const HeaderNodeAllocator<U>& other) : arena_(other.arena()) {}
+
+  T* allocate(size_t n) {
+    if (arena_ == nullptr) {
+      return std::allocator<T>().allocate(n);
+    }
+    return static_cast<T*>(arena_->allocate(n * sizeof(T)));
+  }
+  void deallocate(T* p, size_t n) {
+    if (arena_ == nullptr) {
+      std::allocator<T>().deallocate(p, n);
+    } else {
+      arena_->deallocate(p, n * sizeof(T));
+    }
+  }
+  HeaderNodeArena* arena() const { return arena_; }
+
+  template <class U> bool operator==(const HeaderNodeAllocator<U>& other) const {
+    return arena_ == other.arena();
+  }
+  template <class U> bool operator!=(const HeaderNodeAllocator<U>& other) const {
+    return arena_ != other.arena();
+  }
+
+private:
+  HeaderNodeArena* arena_;
+};
+
 /**
  * Implementation of Http::HeaderMap. This is heavily optimized for performance. Roughly, when
  * headers are added to the map by string, we do a trie lookup to see if it's one of the O(1)
@@ -53,9 +130,13 @@ public:
  */
 class HeaderMapImpl : NonCopyable {
 public:
+  // If use_node_arena is set, the nodes of the header list are allocated from a HeaderNodeArena
+  // owned by the map. The codecs latch envoy.reloadable_features.header_map_node_arena once per
+  // connection and pass it to the maps they create.
   HeaderMapImpl(const uint32_t max_headers_kb = UINT32_MAX,
-                const uint32_t max_headers_count = UINT32_MAX)
-      : max_headers_kb_(max_headers_kb), max_headers_count_(max_headers_count) {}
+                const uint32_t max_headers_count = UINT32_MAX, const bool use_node_arena = false)
+      : headers_(use_node_arena), max_headers_kb_(max_headers_kb),
+        max_headers_count_(max_headers_count) {}
   virtual ~HeaderMapImpl() = default;
 
   // The following "constructors" call virtual functions during construction and must use the
@@ -77,6 +158,9 @@ public:
 
   // Performs a manual byte size count for test verification.
   void verifyByteSizeInternalForTest() const;
+  // Returns the number of chunks allocated by the node arena, which is 0 if the map does not use
+  // one.
+  uint32_t nodeArenaChunksForTest() const { return headers_.arenaChunks(); }
 
   // Note: This class does not actually implement Http::HeaderMap to avoid virtual inheritance in
   // the derived classes. Instead, it is used as a mix-in class for TypedHeaderMapImpl below. This
@@ -113,6 +197,10 @@ public:
   StatefulHeaderKeyFormatterOptRef formatter() { return makeOptRefFromPtr(formatter_.get()); }
 
 protected:
+  struct HeaderEntryImpl;
+  using HeaderNodeList = std::list<HeaderEntryImpl, HeaderNodeAllocator<HeaderEntryImpl>>;
+  using HeaderNode = HeaderNodeList::iterator;
+
   struct HeaderEntryImpl : public HeaderEntry, NonCopyable {
     HeaderEntryImpl(const LowerCaseString& key);
     HeaderEntryImpl(const LowerCaseString& key, HeaderString&& value);
@@ -128,9 +216,8 @@ protected:
 
     HeaderString key_;
     HeaderString value_;
-    std::list<HeaderEntryImpl>::iterator entry_;
+    HeaderNode entry_;
   };
-  using HeaderNode = std::list<HeaderEntryImpl>::iterator;
 
   /**
    * This is the static lookup table that is used to determine whether a header is one of the O(1)
@@ -196,6 +283,8 @@ protected:
    * When the list size is greater or equal to 3, all headers are added to a map, to allow fast
    * access given a header key. Once the map is initialized, it will be used even
    * if the number of headers decreases below the threshold.
+   * If constructed with use_arena, the nodes of the list are allocated from a HeaderNodeArena
+   * owned by the list instead of one by one from the heap.
    *
    * Note: the internal iterators held in fields make this unsafe to copy and move, since the
    * reference to end() is not preserved across a move (see Notes in
@@ -209,7 +298,9 @@ protected:
     using HeaderNodeVector = absl::InlinedVector<HeaderNode, 1>;
     using HeaderLazyMap = absl::flat_hash_map<absl::string_view, HeaderNodeVector>;
 
-    HeaderList() : pseudo_headers_end_(headers_.end()) {}
+    explicit HeaderList(bool use_arena = false)
+        : headers_(HeaderNodeAllocator<HeaderEntryImpl>(use_arena ? &arena_ : nullptr)),
+          pseudo_headers_end_(headers_.end()) {}
 
     template <class Key> bool isPseudoHeader(const Key& key) {
       return !key.getStringView().empty() && key.getStringView()[0] == ':';
@@ -299,12 +390,12 @@ protected:
      */
     size_t remove(absl::string_view key);
 
-    std::list<HeaderEntryImpl>::iterator begin() { return headers_.begin(); }
-    std::list<HeaderEntryImpl>::iterator end() { return headers_.end(); }
-    std::list<HeaderEntryImpl>::const_iterator begin() const { return headers_.begin(); }
-    std::list<HeaderEntryImpl>::const_iterator end() const { return headers_.end(); }
-    std::list<HeaderEntryImpl>::const_reverse_iterator rbegin() const { return headers_.rbegin(); }
-    std::list<HeaderEntryImpl>::const_reverse_iterator rend() const { return headers_.rend(); }
+    HeaderNodeList::iterator begin() { return headers_.begin(); }
+    HeaderNodeList::iterator end() { return headers_.end(); }
+    HeaderNodeList::const_iterator begin() const { return headers_.begin(); }
+    HeaderNodeList::const_iterator end() const { return headers_.end(); }
+    HeaderNodeList::const_reverse_iterator rbegin() const { return headers_.rbegin(); }
+    HeaderNodeList::const_reverse_iterator rend() const { return headers_.rend(); }
     HeaderLazyMap::iterator mapFind(absl::string_view key) { return lazy_map_.find(key); }
     HeaderLazyMap::iterator mapEnd() { return lazy_map_.end(); }
     size_t size() const { return headers_.size(); }
@@ -314,9 +405,12 @@ protected:
       pseudo_headers_end_ = headers_.end();
       lazy_map_.clear();
     }
+    uint32_t arenaChunks() const { return arena_.chunks(); }
 
   private:
-    std::list<HeaderEntryImpl> headers_;
+    // The arena must outlive the nodes allocated from it.
+    HeaderNodeArena arena_;
+    HeaderNodeList headers_;
     HeaderNode pseudo_headers_end_;
     HeaderLazyMap lazy_map_;
   };
@@ -364,8 +458,9 @@ protected:
 template <class Interface> class TypedHeaderMapImpl : public HeaderMapImpl, public Interface {
 public:
   TypedHeaderMapImpl(const uint32_t max_headers_kb = UINT32_MAX,
-                     const uint32_t max_headers_count = UINT32_MAX)
-      : HeaderMapImpl(max_headers_kb, max_headers_count) {}
+                     const uint32_t max_headers_count = UINT32_MAX,
+                     const bool use_node_arena = false)
+      : HeaderMapImpl(max_headers_kb, max_headers_count, use_node_arena) {}
   void setFormatter(StatefulHeaderKeyFormatterPtr&& formatter) {
     formatter_ = std::move(formatter);
   }
@@ -491,9 +586,9 @@ class RequestHeaderMapImpl final : public TypedHeaderMapImpl<RequestHeaderMap>,
 public:
   static std::unique_ptr<RequestHeaderMapImpl>
   create(const uint32_t max_headers_kb = UINT32_MAX,
-         const uint32_t max_headers_count = UINT32_MAX) {
-    return std::unique_ptr<RequestHeaderMapImpl>(
-        new (inlineHeadersSize()) RequestHeaderMapImpl(max_headers_kb, max_headers_count));
+         const uint32_t max_headers_count = UINT32_MAX, const bool use_node_arena = false) {
+    return std::unique_ptr<RequestHeaderMapImpl>(new (inlineHeadersSize()) RequestHeaderMapImpl(
+        max_headers_kb, max_headers_count, use_node_arena));
   }
 
   INLINE_REQ_STRING_HEADERS(DEFINE_INLINE_HEADER_STRING_FUNCS)
@@ -520,9 +615,9 @@ private:
 
   using HeaderHandles = ConstSingleton<HeaderHandleValues>;
 
-  RequestHeaderMapImpl(const uint32_t max_headers_kb = UINT32_MAX,
-                       const uint32_t max_headers_count = UINT32_MAX)
-      : TypedHeaderMapImpl<RequestHeaderMap>(max_headers_kb, max_headers_count) {
+  RequestHeaderMapImpl(const uint32_t max_headers_kb, const uint32_t max_headers_count,
+                       const bool use_node_arena)
+      : TypedHeaderMapImpl<RequestHeaderMap>(max_headers_kb, max_headers_count, use_node_arena) {
     clearInline();
   }
 
@@ -538,9 +633,9 @@ class RequestTrailerMapImpl final : public TypedHeaderMapImpl<RequestTrailerMap>
 public:
   static std::unique_ptr<RequestTrailerMapImpl>
   create(const uint32_t max_headers_kb = UINT32_MAX,
-         const uint32_t max_headers_count = UINT32_MAX) {
-    return std::unique_ptr<RequestTrailerMapImpl>(
-        new (inlineHeadersSize()) RequestTrailerMapImpl(max_headers_kb, max_headers_count));
+         const uint32_t max_headers_count = UINT32_MAX, const bool use_node_arena = false) {
+    return std::unique_ptr<RequestTrailerMapImpl>(new (inlineHeadersSize()) RequestTrailerMapImpl(
+        max_headers_kb, max_headers_count, use_node_arena));
   }
 
 protected:
@@ -550,9 +645,9 @@ protected:
   HeaderEntryImpl** inlineHeaders() override { return inline_headers_; }
 
 private:
-  RequestTrailerMapImpl(const uint32_t max_headers_kb = UINT32_MAX,
-                        const uint32_t max_headers_count = UINT32_MAX)
-      : TypedHeaderMapImpl<RequestTrailerMap>(max_headers_kb, max_headers_count) {
+  RequestTrailerMapImpl(const uint32_t max_headers_kb, const uint32_t max_headers_count,
+                        const bool use_node_arena)
+      : TypedHeaderMapImpl<RequestTrailerMap>(max_headers_kb, max_headers_count, use_node_arena) {
     clearInline();
   }
 
@@ -568,9 +663,9 @@ class ResponseHeaderMapImpl final : public TypedHeaderMapImpl<ResponseHeaderMap>
 public:
   static std::unique_ptr<ResponseHeaderMapImpl>
   create(const uint32_t max_headers_kb = UINT32_MAX,
-         const uint32_t max_headers_count = UINT32_MAX) {
-    return std::unique_ptr<ResponseHeaderMapImpl>(
-        new (inlineHeadersSize()) ResponseHeaderMapImpl(max_headers_kb, max_headers_count));
+         const uint32_t max_headers_count = UINT32_MAX, const bool use_node_arena = false) {
+    return std::unique_ptr<ResponseHeaderMapImpl>(new (inlineHeadersSize()) ResponseHeaderMapImpl(
+        max_headers_kb, max_headers_count, use_node_arena));
   }
 
   INLINE_RESP_STRING_HEADERS(DEFINE_INLINE_HEADER_STRING_FUNCS)
@@ -598,9 +693,9 @@ private:
 
   using HeaderHandles = ConstSingleton<HeaderHandleValues>;
 
-  ResponseHeaderMapImpl(const uint32_t max_headers_kb = UINT32_MAX,
-                        const uint32_t max_headers_count = UINT32_MAX)
-      : TypedHeaderMapImpl<ResponseHeaderMap>(max_headers_kb, max_headers_count) {
+  ResponseHeaderMapImpl(const uint32_t max_headers_kb, const uint32_t max_headers_count,
+                        const bool use_node_arena)
+      : TypedHeaderMapImpl<ResponseHeaderMap>(max_headers_kb, max_headers_count, use_node_arena) {
     clearInline();
   }
   HeaderEntryImpl* inline_headers_[];
@@ -615,9 +710,9 @@ class ResponseTrailerMapImpl final : public TypedHeaderMapImpl<ResponseTrailerMa
 public:
   static std::unique_ptr<ResponseTrailerMapImpl>
   create(const uint32_t max_headers_kb = UINT32_MAX,
-         const uint32_t max_headers_count = UINT32_MAX) {
-    return std::unique_ptr<ResponseTrailerMapImpl>(
-        new (inlineHeadersSize()) ResponseTrailerMapImpl(max_headers_kb, max_headers_count));
+         const uint32_t max_headers_count = UINT32_MAX, const bool use_node_arena = false) {
+    return std::unique_ptr<ResponseTrailerMapImpl>(new (inlineHeadersSize()) ResponseTrailerMapImpl(
+        max_headers_kb, max_headers_count, use_node_arena));
   }
 
   INLINE_RESP_STRING_HEADERS_TRAILERS(DEFINE_INLINE_HEADER_STRING_FUNCS)
@@ -637,9 +732,9 @@ private:
 
   using HeaderHandles = ConstSingleton<HeaderHandleValues>;
 
-  ResponseTrailerMapImpl(const uint32_t max_headers_kb = UINT32_MAX,
-                         const uint32_t max_headers_count = UINT32_MAX)
-      : TypedHeaderMapImpl<ResponseTrailerMap>(max_headers_kb, max_headers_count) {
+  ResponseTrailerMapImpl(const uint32_t max_headers_kb, const uint32_t max_headers_count,
+                         const bool use_node_arena)
+      : TypedHeaderMapImpl<ResponseTrailerMap>(max_headers_kb, max_headers_count, use_node_arena) {
     clearInline();
   }
 
@@ -6,6 +6,7 @@
 
 #include "source/common/common/assert.h"
 #include "source/common/http/headers.h"
+#include "source/common/http/http1/header_scanner.h"
 #include "source/common/runtime/runtime_features.h"
 
 #include "absl/strings/ascii.h"
@@ -25,22 +26,12 @@ constexpr absl::string_view kColonSlashSlash = "://";
 constexpr char kResponseFirstByte = 'H';
 constexpr absl::string_view kHttpVersionPrefix = "HTTP/";
 
-// Allowed characters for field names according to Section 5.1
-// and for methods according to Section 9.1 of RFC 9110:
-// https://www.rfc-editor.org/rfc/rfc9110.html
-constexpr absl::string_view kValidCharacters =
-    "!#$%&'*+-.0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ^_`abcdefghijklmnopqrstuvwxyz|~";
-constexpr absl::string_view::iterator kValidCharactersBegin = kValidCharacters.begin();
-constexpr absl::string_view::iterator kValidCharactersEnd = kValidCharacters.end();
-
 // TODO(#21245): Skip method validation altogether when UHV method validation is
 // enabled.
 bool isMethodValid(absl::string_view method, bool allow_custom_methods) {
   if (allow_custom_methods) {
     return !method.empty() &&
-           std::all_of(method.begin(), method.end(), [](absl::string_view::value_type c) {
-             return std::binary_search(kValidCharactersBegin, kValidCharactersEnd, c);
-           });
+           HeaderScanner::findInvalidHeaderNameChar(method) == HeaderScanner::NotFound;
   }
 
   static constexpr absl::string_view kValidMethods[] = {
@@ -61,15 +52,9 @@ bool isUrlValid(absl::string_view url, bool is_connect) {
     return false;
   }
 
-  // Same set of characters are allowed for path and query.
-  const auto is_valid_path_query_char = [](char c) {
-    return c == 9 || c == 12 || ('!' <= c && c <= 126);
-  };
-
-  // The URL may start with a path.
-  if (auto it = url.begin(); *it == '/' || *it == '*') {
-    ++it;
-    return std::all_of(it, url.end(), is_valid_path_query_char);
+  // The URL may start with a path. Same set of characters are allowed for path and query.
+  if (url[0] == '/' || url[0] == '*') {
+    return HeaderScanner::findInvalidPathQueryChar(url.substr(1)) == HeaderScanner::NotFound;
   }
 
   // If method is not CONNECT, parse scheme.
@@ -110,7 +95,7 @@ bool isUrlValid(absl::string_view url, bool is_connect) {
   // Match http-parser's quirk of allowing any number of '@' characters in host
   // as long as they are not consecutive.
   return std::all_of(host.begin(), host.end(), valid_host_char) && !absl::StrContains(host, "@@") &&
-         std::all_of(path_query.begin(), path_query.end(), is_valid_path_query_char);
+         HeaderScanner::findInvalidPathQueryChar(path_query) == HeaderScanner::NotFound;
 }
 
 // Returns true if `version_input` is a valid HTTP version string as defined at
@@ -130,10 +115,10 @@ bool isVersionValid(absl::string_view version_input) {
          version_input[1] == '.' && absl::ascii_isdigit(version_input[2]);
 }
 
+// Field names according to Section 5.1 and methods according to Section 9.1 of RFC 9110 are both
+// tokens: https://www.rfc-editor.org/rfc/rfc9110.html
 bool isHeaderNameValid(absl::string_view name) {
-  return std::all_of(name.begin(), name.end(), [](absl::string_view::value_type c) {
-    return std::binary_search(kValidCharactersBegin, kValidCharactersEnd, c);
-  });
+  return HeaderScanner::findInvalidHeaderNameChar(name) == HeaderScanner::NotFound;
 }
 
 } // anonymous namespace
@@ -417,12 +402,13 @@ void BalsaParser::validateAndProcessHeadersOrTrailersImpl(const quiche::BalsaHea
     }
 
     // Remove CR and LF characters to match http-parser behavior.
-    auto is_cr_or_lf = [](char c) { return c == '\r' || c == '\n'; };
-    if (std::any_of(value.begin(), value.end(), is_cr_or_lf)) {
+    if (const size_t first_cr_or_lf = HeaderScanner::findCrOrLf(value);
+        first_cr_or_lf != HeaderScanner::NotFound) {
       std::string value_without_cr_or_lf;
       value_without_cr_or_lf.reserve(value.size());
-      for (char c : value) {
-        if (!is_cr_or_lf(c)) {
+      value_without_cr_or_lf.append(value.data(), first_cr_or_lf);
+      for (char c : value.substr(first_cr_or_lf)) {
+        if (c != '\r' && c != '\n') {
           value_without_cr_or_lf.push_back(c);
         }
       }
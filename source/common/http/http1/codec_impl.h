@@ -320,6 +320,7 @@ protected:
   StreamInfo::BytesMeterSharedPtr bytes_meter_before_stream_;
   const uint32_t max_headers_kb_;
   const uint32_t max_headers_count_;
+  const bool header_map_node_arena_;
 
 private:
   enum class HeaderParsingState { Field, Value, Done };
@@ -543,7 +544,8 @@ private:
   }
   void allocHeaders(StatefulHeaderKeyFormatterPtr&& formatter) override {
     ASSERT(!processing_trailers_);
-    auto headers = RequestHeaderMapImpl::create(max_headers_kb_, max_headers_count_);
+    auto headers =
+        RequestHeaderMapImpl::create(max_headers_kb_, max_headers_count_, header_map_node_arena_);
     headers->setFormatter(std::move(formatter));
     headers_or_trailers_.emplace<RequestHeaderMapPtr>(std::move(headers));
   }
@@ -551,7 +553,8 @@ private:
     ASSERT(processing_trailers_);
     if (!absl::holds_alternative<RequestTrailerMapPtr>(headers_or_trailers_)) {
       headers_or_trailers_.emplace<RequestTrailerMapPtr>(
-          RequestTrailerMapImpl::create(max_headers_kb_, max_headers_count_));
+          RequestTrailerMapImpl::create(max_headers_kb_, max_headers_count_,
+                                        header_map_node_arena_));
     }
   }
   void dumpAdditionalState(std::ostream& os, int indent_level) const override;
@@ -650,7 +653,8 @@ private:
   void allocHeaders(StatefulHeaderKeyFormatterPtr&& formatter) override {
     ASSERT(nullptr == absl::get<ResponseHeaderMapPtr>(headers_or_trailers_));
     ASSERT(!processing_trailers_);
-    auto headers = ResponseHeaderMapImpl::create(max_headers_kb_, max_headers_count_);
+    auto headers =
+        ResponseHeaderMapImpl::create(max_headers_kb_, max_headers_count_, header_map_node_arena_);
     headers->setFormatter(std::move(formatter));
     headers_or_trailers_.emplace<ResponseHeaderMapPtr>(std::move(headers));
   }
@@ -658,7 +662,8 @@ private:
     ASSERT(processing_trailers_);
     if (!absl::holds_alternative<ResponseTrailerMapPtr>(headers_or_trailers_)) {
       headers_or_trailers_.emplace<ResponseTrailerMapPtr>(
-          ResponseTrailerMapImpl::create(max_headers_kb_, max_headers_count_));
+          ResponseTrailerMapImpl::create(max_headers_kb_, max_headers_count_,
+                                         header_map_node_arena_));
     }
   }
   void dumpAdditionalState(std::ostream& os, int indent_level) const override;
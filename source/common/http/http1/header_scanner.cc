@@ -0,0 +1,239 @@
+#include "source/common/http/http1/header_scanner.h"
+
+#include <array>
+#include <cstdint>
+
+#include "source/common/buffer/search_kernels.h"
+#include "source/common/http/character_set_validation.h"
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define ENVOY_HTTP1_SCAN_X86 1
+#include <immintrin.h>
+#endif
+
+namespace Envoy {
+namespace Http {
+namespace Http1 {
+namespace {
+
+bool force_scalar = false;
+
+// Byte-wise implementations. These are also used for the tails of the vectorized scans that are
+// shorter than a vector.
+
+template <bool (*IsValid)(uint8_t)> size_t findInvalidScalar(const uint8_t* data, size_t size) {
+  for (size_t i = 0; i < size; i++) {
+    if (!IsValid(data[i])) {
+      return i;
+    }
+  }
+  return HeaderScanner::NotFound;
+}
+
+#ifdef ENVOY_HTTP1_SCAN_X86
+
+bool cpuSupportsAvx2() {
+  __builtin_cpu_init();
+  return __builtin_cpu_supports("avx2");
+}
+
+bool cpuSupportsSsse3() {
+  __builtin_cpu_init();
+  return __builtin_cpu_supports("ssse3");
+}
+
+bool useAvx2() {
+  static const bool has_avx2 = cpuSupportsAvx2();
+  return has_avx2;
+}
+
+bool useSsse3() {
+  static const bool has_ssse3 = cpuSupportsSsse3();
+  return has_ssse3;
+}
+
+// Adds `offset` to a result of a tail scan, preserving NotFound.
+size_t offsetResult(size_t offset, size_t result) {
+  return result == HeaderScanner::NotFound ? result : offset + result;
+}
+
+// Bit (c >> 4) of entry (c & 0xf) is set if the ASCII character c is in the table, so that a byte
+// is classified with two nibble lookups with a byte shuffle. The table must not contain bytes of
+// 0x80 and above.
+constexpr std::array<uint8_t, 16> nibbleTable(const std::array<uint32_t, 8>& table) {
+  std::array<uint8_t, 16> nibbles{};
+  for (uint32_t c = 0; c < 0x80; c++) {
+    if (testCharInTable(table, static_cast<char>(c))) {
+      nibbles[c & 0xf] |= 1 << (c >> 4);
+    }
+  }
+  return nibbles;
+}
+
+// Entry n is the bit of the high nibble n in the entries of a nibbleTable(), which is 0 for the
+// high nibbles of bytes of 0x80 and above.
+constexpr std::array<uint8_t, 16> HighNibbleBits = {1, 2, 4, 8, 16, 32, 64, 128,
+                                                    0, 0, 0, 0, 0, 0, 0, 0};
+
+constexpr std::array<uint8_t, 16> HeaderNameNibbles = nibbleTable(kGenericHeaderNameCharTable);
+
+#endif // ENVOY_HTTP1_SCAN_X86
+
+// Each character class provides the byte-wise check and the masks of the invalid bytes of 16 and
+// 32 byte vectors.
+
+struct HeaderNameClass {
+  static bool isValid(uint8_t c) { return testCharInTable(kGenericHeaderNameCharTable, c); }
+
+#ifdef ENVOY_HTTP1_SCAN_X86
+  __attribute__((target("ssse3"))) static uint32_t invalidMask(__m128i chunk) {
+    const __m128i low_nibble_mask = _mm_set1_epi8(0x0f);
+    const __m128i low = _mm_shuffle_epi8(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(HeaderNameNibbles.data())),
+        _mm_and_si128(chunk, low_nibble_mask));
+    const __m128i high = _mm_shuffle_epi8(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(HighNibbleBits.data())),
+        _mm_and_si128(_mm_srli_epi16(chunk, 4), low_nibble_mask));
+    const __m128i invalid = _mm_cmpeq_epi8(_mm_and_si128(low, high), _mm_setzero_si128());
+    return _mm_movemask_epi8(invalid);
+  }
+
+  __attribute__((target("avx2"))) static uint32_t invalidMask(__m256i chunk) {
+    const __m256i low_nibble_mask = _mm256_set1_epi8(0x0f);
+    const __m256i low = _mm256_shuffle_epi8(
+        _mm256_broadcastsi128_si256(
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(HeaderNameNibbles.data()))),
+        _mm256_and_si256(chunk, low_nibble_mask));
+    const __m256i high = _mm256_shuffle_epi8(
+        _mm256_broadcastsi128_si256(
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(HighNibbleBits.data()))),
+        _mm256_and_si256(_mm256_srli_epi16(chunk, 4), low_nibble_mask));
+    const __m256i invalid = _mm256_cmpeq_epi8(_mm256_and_si256(low, high), _mm256_setzero_si256());
+    return _mm256_movemask_epi8(invalid);
+  }
+#endif
+};
+
+// Control characters other than HTAB are invalid. Bytes of 0x80 and above are obs-text, which is
+// valid.
+struct HeaderValueClass {
+  static bool isValid(uint8_t c) { return c >= 0x20 ? c != 0x7f : c == '\t'; }
+
+#ifdef ENVOY_HTTP1_SCAN_X86
+  static uint32_t invalidMask(__m128i chunk) {
+    const __m128i control = _mm_cmpeq_epi8(_mm_max_epu8(chunk, _mm_set1_epi8(0x1f)),
+                                           _mm_set1_epi8(0x1f));
+    const __m128i invalid =
+        _mm_or_si128(_mm_andnot_si128(_mm_cmpeq_epi8(chunk, _mm_set1_epi8('\t')), control),
+                     _mm_cmpeq_epi8(chunk, _mm_set1_epi8(0x7f)));
+    return _mm_movemask_epi8(invalid);
+  }
+
+  __attribute__((target("avx2"))) static uint32_t invalidMask(__m256i chunk) {
+    const __m256i control = _mm256_cmpeq_epi8(_mm256_max_epu8(chunk, _mm256_set1_epi8(0x1f)),
+                                              _mm256_set1_epi8(0x1f));
+    const __m256i invalid = _mm256_or_si256(
+        _mm256_andnot_si256(_mm256_cmpeq_epi8(chunk, _mm256_set1_epi8('\t')), control),
+        _mm256_cmpeq_epi8(chunk, _mm256_set1_epi8(0x7f)));
+    return _mm256_movemask_epi8(invalid);
+  }
+#endif
+};
+
+// Visible ASCII characters, HTAB and form feed are valid. The signed comparisons exclude the
+// bytes of 0x80 and above, which are negative.
+struct PathQueryClass {
+  static bool isValid(uint8_t c) { return ('!' <= c && c <= '~') || c == '\t' || c == '\f'; }
+
+#ifdef ENVOY_HTTP1_SCAN_X86
+  static uint32_t invalidMask(__m128i chunk) {
+    const __m128i visible = _mm_and_si128(_mm_cmpgt_epi8(chunk, _mm_set1_epi8(' ')),
+                                          _mm_cmplt_epi8(chunk, _mm_set1_epi8(0x7f)));
+    const __m128i valid =
+        _mm_or_si128(visible, _mm_or_si128(_mm_cmpeq_epi8(chunk, _mm_set1_epi8('\t')),
+                                           _mm_cmpeq_epi8(chunk, _mm_set1_epi8('\f'))));
+    return ~_mm_movemask_epi8(valid) & 0xffff;
+  }
+
+  __attribute__((target("avx2"))) static uint32_t invalidMask(__m256i chunk) {
+    const __m256i visible = _mm256_and_si256(_mm256_cmpgt_epi8(chunk, _mm256_set1_epi8(' ')),
+                                             _mm256_cmpgt_epi8(_mm256_set1_epi8(0x7f), chunk));
+    const __m256i valid = _mm256_or_si256(
+        visible, _mm256_or_si256(_mm256_cmpeq_epi8(chunk, _mm256_set1_epi8('\t')),
+                                 _mm256_cmpeq_epi8(chunk, _mm256_set1_epi8('\f'))));
+    return ~static_cast<uint32_t>(_mm256_movemask_epi8(valid));
+  }
+#endif
+};
+
+#ifdef ENVOY_HTTP1_SCAN_X86
+
+template <class CharClass>
+__attribute__((target("ssse3"))) size_t findInvalidSsse3(const uint8_t* data, size_t size) {
+  size_t i = 0;
+  for (; i + sizeof(__m128i) <= size; i += sizeof(__m128i)) {
+    const uint32_t mask =
+        CharClass::invalidMask(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i)));
+    if (mask != 0) {
+      return i + __builtin_ctz(mask);
+    }
+  }
+  return offsetResult(i, findInvalidScalar<CharClass::isValid>(data + i, size - i));
+}
+
+template <class CharClass>
+__attribute__((target("avx2"))) size_t findInvalidAvx2(const uint8_t* data, size_t size) {
+  size_t i = 0;
+  for (; i + sizeof(__m256i) <= size; i += sizeof(__m256i)) {
+    const uint32_t mask =
+        CharClass::invalidMask(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i)));
+    if (mask != 0) {
+      return i + __builtin_ctz(mask);
+    }
+  }
+  // Most header names and values are shorter than 32 bytes, so their tails are worth a 16 byte
+  // vector too.
+  return offsetResult(i, findInvalidSsse3<CharClass>(data + i, size - i));
+}
+
+#endif // ENVOY_HTTP1_SCAN_X86
+
+template <class CharClass> size_t findInvalid(absl::string_view input) {
+  const uint8_t* data = reinterpret_cast<const uint8_t*>(input.data());
+#ifdef ENVOY_HTTP1_SCAN_X86
+  if (!force_scalar && useSsse3()) {
+    return useAvx2() ? findInvalidAvx2<CharClass>(data, input.size())
+                     : findInvalidSsse3<CharClass>(data, input.size());
+  }
+#endif
+  return findInvalidScalar<CharClass::isValid>(data, input.size());
+}
+
+} // namespace
+
+size_t HeaderScanner::findInvalidHeaderNameChar(absl::string_view name) {
+  return findInvalid<HeaderNameClass>(name);
+}
+
+size_t HeaderScanner::findInvalidHeaderValueChar(absl::string_view value) {
+  return findInvalid<HeaderValueClass>(value);
+}
+
+size_t HeaderScanner::findInvalidPathQueryChar(absl::string_view path_query) {
+  return findInvalid<PathQueryClass>(path_query);
+}
+
+size_t HeaderScanner::findCrOrLf(absl::string_view value) {
+  const size_t result = Buffer::SearchKernels::findAnyOf(
+      reinterpret_cast<const uint8_t*>(value.data()), value.size(), "\r\n");
+  return result == Buffer::SearchKernels::NotFound ? NotFound : result;
+}
+
+void HeaderScanner::forceScalarForTest(bool force) {
+  force_scalar = force;
+  Buffer::SearchKernels::forceScalarForTest(force);
+}
+
+} // namespace Http1
+} // namespace Http
+} // namespace Envoy
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstddef>
+
+#include "absl/strings/string_view.h"
+
+namespace Envoy {
+namespace Http {
+namespace Http1 {
+
+/**
+ * Character class scans of the request line and header block of HTTP/1 messages, used by the
+ * codec and the parsers to validate the tokens the parsers have delimited. On x86-64 the scans
+ * process 32 bytes at a time with AVX2 when the CPU supports it and 16 bytes at a time otherwise;
+ * other platforms and the tails of the scans shorter than a vector use the byte-wise checks of
+ * character_set_validation.h. All implementations accept exactly the same characters.
+ */
+class HeaderScanner {
+public:
+  // Returned by all scans when every character is valid.
+  static constexpr size_t NotFound = absl::string_view::npos;
+
+  /**
+   * @param name supplies a header field name.
+   * @return the index of the first character of the name that is not a token character as defined
+   *         by https://www.rfc-editor.org/rfc/rfc9110.html#section-5.1, or NotFound.
+   */
+  static size_t findInvalidHeaderNameChar(absl::string_view name);
+
+  /**
+   * @param value supplies a header field value.
+   * @return the index of the first character of the value that is a control character other than
+   *         HTAB, or NotFound. This accepts the same values as HeaderUtility::headerValueIsValid().
+   */
+  static size_t findInvalidHeaderValueChar(absl::string_view value);
+
+  /**
+   * @param path_query supplies the path and query of a request target.
+   * @return the index of the first character that is neither a visible ASCII character, HTAB nor
+   *         form feed, or NotFound. This matches the request targets accepted by http-parser.
+   */
+  static size_t findInvalidPathQueryChar(absl::string_view path_query);
+
+  /**
+   * @param value supplies a header field value.
+   * @return the index of the first CR or LF character of the value, or NotFound.
+   */
+  static size_t findCrOrLf(absl::string_view value);
+
+  /**
+   * Force the byte-wise implementations, regardless of the CPU features available. For use in
+   * tests and benchmarks comparing the implementations.
+   */
+  static void forceScalarForTest(bool force);
+};
+
+} // namespace Http1
+} // namespace Http
+} // namespace Envoy
@@ -942,6 +942,8 @@ ConnectionImpl::ConnectionImpl(Network::Connection& connection, CodecStats& stat
                                const uint32_t max_headers_kb, const uint32_t max_headers_count)
     : stats_(stats), connection_(connection), max_headers_kb_(max_headers_kb),
       max_headers_count_(max_headers_count),
+      header_map_node_arena_(
+          Runtime::runtimeFeatureEnabled("envoy.reloadable_features.header_map_node_arena")),
       per_stream_buffer_limit_(http2_options.initial_stream_window_size().value()),
       stream_error_on_invalid_http_messaging_(
           http2_options.override_stream_error_on_invalid_http_message().value()),
@@ -971,6 +973,12 @@ ConnectionImpl::ConnectionImpl(Network::Connection& connection, CodecStats& stat
     // This call schedules the initial interval, with jitter.
     onKeepaliveResponse();
   }
+  if (http2_options.has_outbound_frame_coalescing()) {
+    max_coalesced_bytes_ = PROTOBUF_GET_WRAPPED_OR_DEFAULT(
+        http2_options.outbound_frame_coalescing(), max_coalesced_bytes, 64 * 1024);
+    flush_coalesced_frames_callback_ =
+        connection.dispatcher().createSchedulableCallback([this]() { flushCoalescedFrames(); });
+  }
 }
 
 ConnectionImpl::~ConnectionImpl() {
@@ -1035,11 +1043,21 @@ bool ConnectionImpl::slowContainsStreamId(int32_t stream_id) const {
 }
 
 Http::Status ConnectionImpl::dispatch(Buffer::Instance& data) {
+  Http::Status status = dispatchImpl(data);
+  if (!status.ok()) {
+    // The connection is closed after a dispatch error, so write the GOAWAY queued by the adapter
+    // before the caller closes it.
+    flushCoalescedFrames();
+  }
+  return status;
+}
+
+Http::Status ConnectionImpl::dispatchImpl(Buffer::Instance& data) {
   ScopeTrackerScopeState scope(this, connection_.dispatcher());
   ENVOY_CONN_LOG(trace, "dispatching {} bytes", connection_, data.length());
   // Make sure that dispatching_ is set to false after dispatching, even when
-  // ConnectionImpl::dispatch returns early or throws an exception (consider removing if there is a
-  // single return after exception removal (#10878)).
+  // ConnectionImpl::dispatchImpl returns early or throws an exception (consider removing if there
+  // is a single return after exception removal (#10878)).
   Cleanup cleanup([this]() {
     dispatching_ = false;
     current_slice_ = nullptr;
@@ -1121,6 +1139,9 @@ void ConnectionImpl::goAway() {
   adapter_->SubmitGoAway(adapter_->GetHighestReceivedStreamId(),
                          http2::adapter::Http2ErrorCode::HTTP2_NO_ERROR, "");
   stats_.goaway_sent_.inc();
+  // The connection is typically closed after a GOAWAY, so from now on do not wait for the end of
+  // the event loop iteration to write frames.
+  sent_goaway_ = true;
   if (sendPendingFramesAndHandleError()) {
     // Intended to check through coverage that this error case is tested
     return;
@@ -1458,6 +1479,12 @@ Status ConnectionImpl::trackInboundFrames(int32_t stream_id, size_t length, uint
 
 ssize_t ConnectionImpl::onSend(const uint8_t* data, size_t length) {
   ENVOY_CONN_LOG(trace, "send data: bytes={}", connection_, length);
+  if (coalesceOutboundFrames()) {
+    // Adding the frame to the coalesced frames lets small frames share buffer slices.
+    addOutboundFrameFragment(coalesced_frames_, data, length);
+    coalesced_frame_count_++;
+    return length;
+  }
   Buffer::OwnedImpl buffer;
   addOutboundFrameFragment(buffer, data, length);
 
@@ -1636,6 +1663,9 @@ Status ConnectionImpl::sendPendingFrames() {
   const int rc = adapter_->Send();
   if (rc != 0) {
     ASSERT(rc == ERR_CALLBACK_FAILURE);
+    // The error GOAWAY that failed the send has already been serialized. Write it, as it would
+    // have been without coalescing, since the connection is torn down next.
+    flushCoalescedFrames();
     return codecProtocolError(codecStrError(rc));
   }
 
@@ -1664,6 +1694,10 @@ Status ConnectionImpl::sendPendingFrames() {
     RETURN_IF_ERROR(sendPendingFrames());
   }
 
+  if (coalesceOutboundFrames()) {
+    maybeFlushCoalescedFrames();
+  }
+
   // After all pending frames have been written into the outbound buffer check if any of
   // protocol constraints had been violated.
   Status status = protocol_constraints_.checkOutboundFrameLimits();
@@ -1682,6 +1716,32 @@ bool ConnectionImpl::sendPendingFramesAndHandleError() {
   return false;
 }
 
+void ConnectionImpl::maybeFlushCoalescedFrames() {
+  if (sent_goaway_ || coalesced_frames_.length() >= max_coalesced_bytes_) {
+    flushCoalescedFrames();
+  } else if (coalesced_frames_.length() > 0 && !flush_coalesced_frames_callback_->enabled()) {
+    flush_coalesced_frames_callback_->scheduleCallbackCurrentIteration();
+  }
+}
+
+void ConnectionImpl::flushCoalescedFrames() {
+  if (coalesced_frames_.length() == 0) {
+    return;
+  }
+  flush_coalesced_frames_callback_->cancel();
+  if (connection_.state() == Network::Connection::State::Closed) {
+    coalesced_frames_.drain(coalesced_frames_.length());
+    coalesced_frame_count_ = 0;
+    return;
+  }
+  ENVOY_CONN_LOG(trace, "writing {} coalesced frames: bytes={}", connection_,
+                 coalesced_frame_count_, coalesced_frames_.length());
+  stats_.outbound_coalesced_writes_.inc();
+  stats_.outbound_coalesced_frames_.add(coalesced_frame_count_);
+  coalesced_frame_count_ = 0;
+  connection_.write(coalesced_frames_, false);
+}
+
 void ConnectionImpl::sendSettingsHelper(
     const envoy::config::core::v3::Http2ProtocolOptions& http2_options, bool disable_push) {
   absl::InlinedVector<http2::adapter::Http2Setting, 10> settings;
@@ -1823,8 +1883,10 @@ bool ConnectionImpl::Http2Visitor::SendDataFrame(Http2StreamId stream_id,
     return false;
   }
   Buffer::OwnedImpl output;
+  const bool coalesce = connection_->coalesceOutboundFrames();
+  Buffer::OwnedImpl& frame = coalesce ? connection_->coalesced_frames_ : output;
   connection_->addOutboundFrameFragment(
-      output, reinterpret_cast<const uint8_t*>(frame_header.data()), frame_header.size());
+      frame, reinterpret_cast<const uint8_t*>(frame_header.data()), frame_header.size());
   if (!connection_->protocol_constraints_.checkOutboundFrameLimits().ok()) {
     ENVOY_CONN_LOG(debug, "error sending data frame: Too many frames in the outbound queue",
                    connection_->connection_);
@@ -1832,8 +1894,12 @@ bool ConnectionImpl::Http2Visitor::SendDataFrame(Http2StreamId stream_id,
   }
 
   connection_->stats_.pending_send_bytes_.sub(payload_length);
-  output.move(*stream->pending_send_data_, payload_length);
-  connection_->connection_.write(output, false);
+  frame.move(*stream->pending_send_data_, payload_length);
+  if (coalesce) {
+    connection_->coalesced_frame_count_++;
+  } else {
+    connection_->connection_.write(output, false);
+  }
   return true;
 }
 
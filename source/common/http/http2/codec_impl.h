@@ -162,7 +162,9 @@ public:
   Protocol protocol() override { return Protocol::Http2; }
   void shutdownNotice() override;
   Status protocolErrorForTest(); // Used in tests to simulate errors.
-  bool wantsToWrite() override { return adapter_->want_write(); }
+  bool wantsToWrite() override {
+    return adapter_->want_write() || coalesced_frames_.length() > 0;
+  }
   // Propagate network connection watermark events to each stream on the connection.
   void onUnderlyingConnectionAboveWriteBufferHighWatermark() override {
     for (auto& stream : active_streams_) {
@@ -503,7 +505,8 @@ protected:
                      ResponseDecoder& response_decoder)
         : StreamImpl(parent, buffer_limit), response_decoder_(response_decoder),
           headers_or_trailers_(
-              ResponseHeaderMapImpl::create(parent_.max_headers_kb_, parent_.max_headers_count_)) {}
+              ResponseHeaderMapImpl::create(parent_.max_headers_kb_, parent_.max_headers_count_,
+                                            parent_.header_map_node_arena_)) {}
 
     // Http::MultiplexedStreamImplBase
     // Client streams do not need a flush timer because we currently assume that any failure
@@ -535,10 +538,12 @@ protected:
       // we are about to receive trailers. The codec makes sure this is the only valid sequence.
       if (received_noninformational_headers_) {
         headers_or_trailers_.emplace<ResponseTrailerMapPtr>(
-            ResponseTrailerMapImpl::create(parent_.max_headers_kb_, parent_.max_headers_count_));
+            ResponseTrailerMapImpl::create(parent_.max_headers_kb_, parent_.max_headers_count_,
+                                           parent_.header_map_node_arena_));
       } else {
         headers_or_trailers_.emplace<ResponseHeaderMapPtr>(
-            ResponseHeaderMapImpl::create(parent_.max_headers_kb_, parent_.max_headers_count_));
+            ResponseHeaderMapImpl::create(parent_.max_headers_kb_, parent_.max_headers_count_,
+                                          parent_.header_map_node_arena_));
       }
     }
     HeaderMapPtr cloneTrailers(const HeaderMap& trailers) override {
@@ -570,7 +575,8 @@ protected:
     ServerStreamImpl(ConnectionImpl& parent, uint32_t buffer_limit)
         : StreamImpl(parent, buffer_limit),
           headers_or_trailers_(
-              RequestHeaderMapImpl::create(parent_.max_headers_kb_, parent_.max_headers_count_)) {}
+              RequestHeaderMapImpl::create(parent_.max_headers_kb_, parent_.max_headers_count_,
+                                           parent_.header_map_node_arena_)) {}
 
     // StreamImpl
     void destroy() override;
@@ -594,7 +600,8 @@ protected:
     }
     void allocTrailers() override {
       headers_or_trailers_.emplace<RequestTrailerMapPtr>(
-          RequestTrailerMapImpl::create(parent_.max_headers_kb_, parent_.max_headers_count_));
+          RequestTrailerMapImpl::create(parent_.max_headers_kb_, parent_.max_headers_count_,
+                                        parent_.header_map_node_arena_));
     }
     HeaderMapPtr cloneTrailers(const HeaderMap& trailers) override {
       return createHeaderMap<ResponseTrailerMapImpl>(trailers);
@@ -663,6 +670,26 @@ protected:
    * Return true if the disconnect callback has been scheduled.
    */
   bool sendPendingFramesAndHandleError();
+
+  // If outbound frame coalescing is enabled, frames are appended to coalesced_frames_ instead of
+  // being written to the connection one by one.
+  bool coalesceOutboundFrames() const { return flush_coalesced_frames_callback_ != nullptr; }
+
+  /**
+   * Writes the coalesced frames to the connection if the threshold of coalesced bytes has been
+   * reached or a GOAWAY has been sent, and otherwise schedules writing them at the end of the
+   * current event loop iteration.
+   */
+  void maybeFlushCoalescedFrames();
+
+  /**
+   * Writes the coalesced frames, if any, to the connection.
+   */
+  void flushCoalescedFrames();
+
+  // Dispatches data to the adapter. dispatch() wraps this to flush coalesced frames on error.
+  Http::Status dispatchImpl(Buffer::Instance& data);
+
   void sendSettings(const envoy::config::core::v3::Http2ProtocolOptions& http2_options,
                     bool disable_push);
   void sendSettingsHelper(const envoy::config::core::v3::Http2ProtocolOptions& http2_options,
@@ -717,6 +744,7 @@ protected:
   Network::Connection& connection_;
   const uint32_t max_headers_kb_;
   const uint32_t max_headers_count_;
+  const bool header_map_node_arena_;
   uint32_t per_stream_buffer_limit_;
   bool allow_metadata_;
   uint64_t max_metadata_size_;
@@ -806,6 +834,15 @@ private:
   std::chrono::milliseconds keepalive_interval_;
   std::chrono::milliseconds keepalive_timeout_;
   uint32_t keepalive_interval_jitter_percent_;
+  // Outbound frame coalescing, enabled if flush_coalesced_frames_callback_ is set. The coalesced
+  // frames hold drain trackers of protocol_constraints_, which must outlive them.
+  Event::SchedulableCallbackPtr flush_coalesced_frames_callback_;
+  Buffer::OwnedImpl coalesced_frames_;
+  uint32_t coalesced_frame_count_{};
+  uint32_t max_coalesced_bytes_{};
+  // Set once a GOAWAY has been sent. The connection is about to be closed, so frames are written
+  // as soon as they are serialized rather than at the end of the event loop iteration.
+  bool sent_goaway_{};
 };
 
 /**
@@ -23,6 +23,8 @@ namespace Http2 {
   COUNTER(inbound_window_update_frames_flood)                                                      \
   COUNTER(keepalive_timeout)                                                                       \
   COUNTER(metadata_empty_frames)                                                                   \
+  COUNTER(outbound_coalesced_frames)                                                               \
+  COUNTER(outbound_coalesced_writes)                                                               \
   COUNTER(outbound_control_flood)                                                                  \
   COUNTER(outbound_flood)                                                                          \
   COUNTER(requests_rejected_with_underscores_in_headers)                                           \
@@ -18,6 +18,7 @@ struct NullHedgePolicy : public Router::HedgePolicy {
     return additional_request_chance_;
   }
   bool hedgeOnPerTryTimeout() const override { return false; }
+  OptRef<Router::AdaptiveHedging> adaptiveHedging() const override { return {}; }
 
   const envoy::type::v3::FractionalPercent additional_request_chance_;
 };
@@ -268,6 +269,7 @@ struct NullRouteImpl : public Router::Route {
     return Router::DefaultRouteMetadataPack::get().typed_metadata_;
   }
   absl::optional<bool> filterDisabled(absl::string_view) const override { return {}; }
+  bool hasFilterDisabledOverrides() const override { return false; }
   const std::string& routeName() const override { return EMPTY_STRING; }
   const Router::VirtualHostConstSharedPtr& virtualHost() const override { return virtual_host_; }
 
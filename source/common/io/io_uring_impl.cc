@@ -17,6 +17,17 @@ bool isIoUringSupported() {
   return is_supported;
 }
 
+bool isIoUringSendZcSupported() {
+  struct io_uring_probe* probe = io_uring_get_probe();
+  if (probe == nullptr) {
+    return false;
+  }
+
+  const bool is_supported = io_uring_opcode_supported(probe, IORING_OP_SENDMSG_ZC);
+  io_uring_free_probe(probe);
+  return is_supported;
+}
+
 IoUringImpl::IoUringImpl(uint32_t io_uring_size, bool use_submission_queue_polling)
     : cqes_(io_uring_size, nullptr) {
   struct io_uring_params p {};
@@ -30,7 +41,12 @@ IoUringImpl::IoUringImpl(uint32_t io_uring_size, bool use_submission_queue_polli
   RELEASE_ASSERT(ret == 0, fmt::format("unable to initialize io_uring: {}", errorDetails(-ret)));
 }
 
-IoUringImpl::~IoUringImpl() { io_uring_queue_exit(&ring_); }
+IoUringImpl::~IoUringImpl() {
+  for (auto& [buffer_group, buffer_ring] : buffer_rings_) {
+    io_uring_free_buf_ring(&ring_, buffer_ring.ring_, buffer_ring.entries_, buffer_group);
+  }
+  io_uring_queue_exit(&ring_);
+}
 
 os_fd_t IoUringImpl::registerEventfd() {
   ASSERT(!isEventfdRegistered());
@@ -69,7 +85,11 @@ void IoUringImpl::forEveryCompletion(const CompletionCb& completion_cb) {
 
   for (unsigned i = 0; i < count; ++i) {
     struct io_uring_cqe* cqe = cqes_[i];
-    completion_cb(reinterpret_cast<Request*>(cqe->user_data), cqe->res, false);
+    Request* req = reinterpret_cast<Request*>(cqe->user_data);
+    if (req != nullptr) {
+      req->setCompletionFlags(cqe->flags);
+    }
+    completion_cb(req, cqe->res, false);
   }
 
   io_uring_cq_advance(&ring_, count);
@@ -136,6 +156,56 @@ IoUringResult IoUringImpl::prepareReadv(os_fd_t fd, const struct iovec* iovecs,
   return IoUringResult::Ok;
 }
 
+IoUringResult IoUringImpl::prepareRecvMultishot(os_fd_t fd, uint16_t buffer_group,
+                                                Request* user_data) {
+  ENVOY_LOG(trace, "prepare recv multishot for fd = {}, buffer group = {}", fd, buffer_group);
+  // TODO (soulxu): Handling the case of CQ ring is overflow.
+  ASSERT(!(*(ring_.sq.kflags) & IORING_SQ_CQ_OVERFLOW));
+  ASSERT(buffer_rings_.contains(buffer_group));
+  struct io_uring_sqe* sqe = io_uring_get_sqe(&ring_);
+  if (sqe == nullptr) {
+    return IoUringResult::Failed;
+  }
+
+  io_uring_prep_recv_multishot(sqe, fd, nullptr, 0, 0);
+  sqe->flags |= IOSQE_BUFFER_SELECT;
+  sqe->buf_group = buffer_group;
+  io_uring_sqe_set_data(sqe, user_data);
+  return IoUringResult::Ok;
+}
+
+IoUringResult IoUringImpl::prepareRecvmsg(os_fd_t fd, struct msghdr* msg, Request* user_data) {
+  ENVOY_LOG(trace, "prepare recvmsg for fd = {}", fd);
+  // TODO (soulxu): Handling the case of CQ ring is overflow.
+  ASSERT(!(*(ring_.sq.kflags) & IORING_SQ_CQ_OVERFLOW));
+  struct io_uring_sqe* sqe = io_uring_get_sqe(&ring_);
+  if (sqe == nullptr) {
+    return IoUringResult::Failed;
+  }
+
+  io_uring_prep_recvmsg(sqe, fd, msg, MSG_TRUNC);
+  io_uring_sqe_set_data(sqe, user_data);
+  return IoUringResult::Ok;
+}
+
+IoUringResult IoUringImpl::prepareRecvmsgMultishot(os_fd_t fd, struct msghdr* msg,
+                                                   uint16_t buffer_group, Request* user_data) {
+  ENVOY_LOG(trace, "prepare recvmsg multishot for fd = {}, buffer group = {}", fd, buffer_group);
+  // TODO (soulxu): Handling the case of CQ ring is overflow.
+  ASSERT(!(*(ring_.sq.kflags) & IORING_SQ_CQ_OVERFLOW));
+  ASSERT(buffer_rings_.contains(buffer_group));
+  struct io_uring_sqe* sqe = io_uring_get_sqe(&ring_);
+  if (sqe == nullptr) {
+    return IoUringResult::Failed;
+  }
+
+  io_uring_prep_recvmsg_multishot(sqe, fd, msg, MSG_TRUNC);
+  sqe->flags |= IOSQE_BUFFER_SELECT;
+  sqe->buf_group = buffer_group;
+  io_uring_sqe_set_data(sqe, user_data);
+  return IoUringResult::Ok;
+}
+
 IoUringResult IoUringImpl::prepareWritev(os_fd_t fd, const struct iovec* iovecs, unsigned nr_vecs,
                                          off_t offset, Request* user_data) {
   ENVOY_LOG(trace, "prepare writev for fd = {}", fd);
@@ -151,6 +221,36 @@ IoUringResult IoUringImpl::prepareWritev(os_fd_t fd, const struct iovec* iovecs,
   return IoUringResult::Ok;
 }
 
+IoUringResult IoUringImpl::prepareSendmsg(os_fd_t fd, const struct msghdr* msg,
+                                          Request* user_data) {
+  ENVOY_LOG(trace, "prepare sendmsg for fd = {}", fd);
+  // TODO (soulxu): Handling the case of CQ ring is overflow.
+  ASSERT(!(*(ring_.sq.kflags) & IORING_SQ_CQ_OVERFLOW));
+  struct io_uring_sqe* sqe = io_uring_get_sqe(&ring_);
+  if (sqe == nullptr) {
+    return IoUringResult::Failed;
+  }
+
+  io_uring_prep_sendmsg(sqe, fd, msg, 0);
+  io_uring_sqe_set_data(sqe, user_data);
+  return IoUringResult::Ok;
+}
+
+IoUringResult IoUringImpl::prepareSendmsgZc(os_fd_t fd, const struct msghdr* msg,
+                                            Request* user_data) {
+  ENVOY_LOG(trace, "prepare sendmsg zc for fd = {}", fd);
+  // TODO (soulxu): Handling the case of CQ ring is overflow.
+  ASSERT(!(*(ring_.sq.kflags) & IORING_SQ_CQ_OVERFLOW));
+  struct io_uring_sqe* sqe = io_uring_get_sqe(&ring_);
+  if (sqe == nullptr) {
+    return IoUringResult::Failed;
+  }
+
+  io_uring_prep_sendmsg_zc(sqe, fd, msg, 0);
+  io_uring_sqe_set_data(sqe, user_data);
+  return IoUringResult::Ok;
+}
+
 IoUringResult IoUringImpl::prepareClose(os_fd_t fd, Request* user_data) {
   ENVOY_LOG(trace, "prepare close for fd = {}", fd);
   // TODO (soulxu): Handling the case of CQ ring is overflow.
@@ -195,6 +295,29 @@ IoUringResult IoUringImpl::prepareShutdown(os_fd_t fd, int how, Request* user_da
   return IoUringResult::Ok;
 }
 
+IoUringResult IoUringImpl::registerBufferRing(uint16_t buffer_group, uint32_t entries) {
+  ASSERT(!buffer_rings_.contains(buffer_group));
+  ASSERT((entries & (entries - 1)) == 0);
+  int ret = 0;
+  struct io_uring_buf_ring* buffer_ring =
+      io_uring_setup_buf_ring(&ring_, entries, buffer_group, 0, &ret);
+  if (buffer_ring == nullptr) {
+    ENVOY_LOG(debug, "unable to register buffer ring: {}", errorDetails(-ret));
+    return IoUringResult::Failed;
+  }
+  buffer_rings_.emplace(buffer_group, BufferRing{buffer_ring, entries});
+  return IoUringResult::Ok;
+}
+
+void IoUringImpl::addBufferToRing(uint16_t buffer_group, uint8_t* buf, uint32_t len,
+                                  uint16_t buffer_id) {
+  auto it = buffer_rings_.find(buffer_group);
+  ASSERT(it != buffer_rings_.end());
+  io_uring_buf_ring_add(it->second.ring_, buf, len, buffer_id,
+                        io_uring_buf_ring_mask(it->second.entries_), 0);
+  io_uring_buf_ring_advance(it->second.ring_, 1);
+}
+
 IoUringResult IoUringImpl::submit() {
   int res = io_uring_submit(&ring_);
   RELEASE_ASSERT(res >= 0 || res == -EBUSY, "unable to submit io_uring queue entries");
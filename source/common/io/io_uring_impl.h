@@ -5,6 +5,7 @@
 
 #include "source/common/common/logger.h"
 
+#include "absl/container/flat_hash_map.h"
 #include "liburing.h"
 
 namespace Envoy {
@@ -12,6 +13,9 @@ namespace Io {
 
 bool isIoUringSupported();
 
+// Returns true if the kernel supports zero-copy sends with IORING_OP_SENDMSG_ZC.
+bool isIoUringSendZcSupported();
+
 struct InjectedCompletion {
   InjectedCompletion(os_fd_t fd, Request* user_data, int32_t result)
       : fd_(fd), user_data_(user_data), result_(result) {}
@@ -38,20 +42,37 @@ public:
                                Request* user_data) override;
   IoUringResult prepareReadv(os_fd_t fd, const struct iovec* iovecs, unsigned nr_vecs, off_t offset,
                              Request* user_data) override;
+  IoUringResult prepareRecvMultishot(os_fd_t fd, uint16_t buffer_group,
+                                     Request* user_data) override;
+  IoUringResult prepareRecvmsg(os_fd_t fd, struct msghdr* msg, Request* user_data) override;
+  IoUringResult prepareRecvmsgMultishot(os_fd_t fd, struct msghdr* msg, uint16_t buffer_group,
+                                        Request* user_data) override;
   IoUringResult prepareWritev(os_fd_t fd, const struct iovec* iovecs, unsigned nr_vecs,
                               off_t offset, Request* user_data) override;
+  IoUringResult prepareSendmsg(os_fd_t fd, const struct msghdr* msg, Request* user_data) override;
+  IoUringResult prepareSendmsgZc(os_fd_t fd, const struct msghdr* msg,
+                                 Request* user_data) override;
   IoUringResult prepareClose(os_fd_t fd, Request* user_data) override;
   IoUringResult prepareCancel(Request* cancelling_user_data, Request* user_data) override;
   IoUringResult prepareShutdown(os_fd_t fd, int how, Request* user_data) override;
+  IoUringResult registerBufferRing(uint16_t buffer_group, uint32_t entries) override;
+  void addBufferToRing(uint16_t buffer_group, uint8_t* buf, uint32_t len,
+                       uint16_t buffer_id) override;
   IoUringResult submit() override;
   void injectCompletion(os_fd_t fd, Request* user_data, int32_t result) override;
   void removeInjectedCompletion(os_fd_t fd) override;
 
 private:
+  struct BufferRing {
+    struct io_uring_buf_ring* ring_;
+    const uint32_t entries_;
+  };
+
   struct io_uring ring_ {};
   std::vector<struct io_uring_cqe*> cqes_;
   os_fd_t event_fd_{INVALID_SOCKET};
   std::list<InjectedCompletion> injected_completions_;
+  absl::flat_hash_map<uint16_t, BufferRing> buffer_rings_;
 };
 
 } // namespace Io
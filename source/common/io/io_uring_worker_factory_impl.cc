@@ -1,6 +1,6 @@
 #include "source/common/io/io_uring_worker_factory_impl.h"
 
-#include "source/common/io/io_uring_worker_impl.h"
+#include "absl/numeric/bits.h"
 
 namespace Envoy {
 namespace Io {
@@ -9,9 +9,16 @@ IoUringWorkerFactoryImpl::IoUringWorkerFactoryImpl(uint32_t io_uring_size,
                                                    bool use_submission_queue_polling,
                                                    uint32_t read_buffer_size,
                                                    uint32_t write_timeout_ms,
+                                                   uint32_t zero_copy_send_threshold,
+                                                   uint32_t buffer_ring_size, Stats::Scope& scope,
                                                    ThreadLocal::SlotAllocator& tls)
     : io_uring_size_(io_uring_size), use_submission_queue_polling_(use_submission_queue_polling),
-      read_buffer_size_(read_buffer_size), write_timeout_ms_(write_timeout_ms), tls_(tls) {}
+      read_buffer_size_(read_buffer_size), write_timeout_ms_(write_timeout_ms),
+      zero_copy_send_threshold_(zero_copy_send_threshold),
+      buffer_ring_size_(buffer_ring_size > 0 ? absl::bit_ceil(buffer_ring_size) : 0),
+      stats_(std::make_shared<IoUringWorkerStats>(IoUringWorkerStats{ALL_IO_URING_WORKER_STATS(
+          POOL_COUNTER_PREFIX(scope, "io_uring."), POOL_HISTOGRAM_PREFIX(scope, "io_uring."))})),
+      tls_(tls) {}
 
 OptRef<IoUringWorker> IoUringWorkerFactoryImpl::getIoUringWorker() {
   auto ret = tls_.get();
@@ -25,9 +32,12 @@ void IoUringWorkerFactoryImpl::onWorkerThreadInitialized() {
   tls_.set([io_uring_size = io_uring_size_,
             use_submission_queue_polling = use_submission_queue_polling_,
             read_buffer_size = read_buffer_size_,
-            write_timeout_ms = write_timeout_ms_](Event::Dispatcher& dispatcher) {
-    return std::make_shared<IoUringWorkerImpl>(io_uring_size, use_submission_queue_polling,
-                                               read_buffer_size, write_timeout_ms, dispatcher);
+            write_timeout_ms = write_timeout_ms_,
+            zero_copy_send_threshold = zero_copy_send_threshold_,
+            buffer_ring_size = buffer_ring_size_, stats = stats_](Event::Dispatcher& dispatcher) {
+    return std::make_shared<IoUringWorkerImpl>(
+        io_uring_size, use_submission_queue_polling, read_buffer_size, write_timeout_ms,
+        zero_copy_send_threshold, buffer_ring_size, stats, dispatcher);
   });
 }
 
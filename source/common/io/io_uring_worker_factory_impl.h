@@ -1,8 +1,11 @@
 #pragma once
 
 #include "envoy/common/io/io_uring.h"
+#include "envoy/stats/scope.h"
 #include "envoy/thread_local/thread_local.h"
 
+#include "source/common/io/io_uring_worker_impl.h"
+
 namespace Envoy {
 namespace Io {
 
@@ -10,7 +13,8 @@ class IoUringWorkerFactoryImpl : public IoUringWorkerFactory {
 public:
   IoUringWorkerFactoryImpl(uint32_t io_uring_size, bool use_submission_queue_polling,
                            uint32_t read_buffer_size, uint32_t write_timeout_ms,
-                           ThreadLocal::SlotAllocator& tls);
+                           uint32_t zero_copy_send_threshold, uint32_t buffer_ring_size,
+                           Stats::Scope& scope, ThreadLocal::SlotAllocator& tls);
 
   OptRef<IoUringWorker> getIoUringWorker() override;
 
@@ -22,6 +26,10 @@ private:
   const bool use_submission_queue_polling_;
   const uint32_t read_buffer_size_;
   const uint32_t write_timeout_ms_;
+  const uint32_t zero_copy_send_threshold_;
+  const uint32_t buffer_ring_size_;
+  // Shared by the workers of all threads.
+  IoUringWorkerStatsSharedPtr stats_;
   ThreadLocal::TypedSlot<IoUringWorker> tls_;
 };
 
@@ -4,12 +4,32 @@ namespace Envoy {
 namespace Io {
 
 ReadRequest::ReadRequest(IoUringSocket& socket, uint32_t size)
-    : Request(RequestType::Read, socket), buf_(std::make_unique<uint8_t[]>(size)),
-      iov_(std::make_unique<struct iovec>()) {
+    : Request(RequestType::Read, socket), buffer_select_(false),
+      buf_(std::make_unique<uint8_t[]>(size)), iov_(std::make_unique<struct iovec>()) {
   iov_->iov_base = buf_.get();
   iov_->iov_len = size;
 }
 
+ReadRequest::ReadRequest(IoUringSocket& socket)
+    : Request(RequestType::Read, socket), buffer_select_(true) {}
+
+RecvmsgRequest::RecvmsgRequest(IoUringSocket& socket, uint32_t size)
+    : ReadRequest(socket, size), control_(std::make_unique<uint8_t[]>(ControlSize)) {
+  msg_.msg_name = &peer_address_;
+  msg_.msg_namelen = sizeof(peer_address_);
+  msg_.msg_iov = iov_.get();
+  msg_.msg_iovlen = 1;
+  msg_.msg_control = control_.get();
+  msg_.msg_controllen = ControlSize;
+}
+
+RecvmsgRequest::RecvmsgRequest(IoUringSocket& socket) : ReadRequest(socket) {
+  // Only the sizes of the address and the control messages are used by a multishot recvmsg, they
+  // are written to the provided buffer.
+  msg_.msg_namelen = sizeof(peer_address_);
+  msg_.msg_controllen = ControlSize;
+}
+
 WriteRequest::WriteRequest(IoUringSocket& socket, const Buffer::RawSliceVector& slices)
     : Request(RequestType::Write, socket), iov_(std::make_unique<struct iovec[]>(slices.size())) {
   for (size_t i = 0; i < slices.size(); i++) {
@@ -18,6 +38,78 @@ WriteRequest::WriteRequest(IoUringSocket& socket, const Buffer::RawSliceVector&
   }
 }
 
+SendZcRequest::SendZcRequest(IoUringSocket& socket, Buffer::Instance& data)
+    : Request(RequestType::SendZc, socket) {
+  // Take no more slices than a single sendmsg can send.
+  uint64_t length = 0;
+  for (const Buffer::RawSlice& slice : data.getRawSlices(IOV_MAX)) {
+    length += slice.len_;
+  }
+  data_.move(data, length);
+
+  Buffer::RawSliceVector slices = data_.getRawSlices();
+  iov_ = std::make_unique<struct iovec[]>(slices.size());
+  for (size_t i = 0; i < slices.size(); i++) {
+    iov_[i].iov_base = slices[i].mem_;
+    iov_[i].iov_len = slices[i].len_;
+  }
+  msg_.msg_iov = iov_.get();
+  msg_.msg_iovlen = slices.size();
+}
+
+void SendZcRequest::returnUnsentData(uint64_t sent, Buffer::Instance& buffer) {
+  if (sent >= data_.length()) {
+    return;
+  }
+
+  // The data stays referenced by this request until the notification, so the unsent part is
+  // copied rather than moved.
+  Buffer::OwnedImpl unsent;
+  uint64_t skip = sent;
+  for (const Buffer::RawSlice& slice : data_.getRawSlices()) {
+    if (skip >= slice.len_) {
+      skip -= slice.len_;
+      continue;
+    }
+    unsent.add(static_cast<const uint8_t*>(slice.mem_) + skip, slice.len_ - skip);
+    skip = 0;
+  }
+  buffer.prepend(unsent);
+}
+
+SendmsgRequest::SendmsgRequest(IoUringSocket& socket, const Buffer::RawSlice* slices,
+                               uint64_t num_slice, const Network::Address::Instance& peer_address,
+                               absl::string_view control)
+    : Request(RequestType::Write, socket) {
+  uint64_t length = 0;
+  for (uint64_t i = 0; i < num_slice; i++) {
+    length += slices[i].len_;
+  }
+  buf_ = std::make_unique<uint8_t[]>(length);
+  uint64_t offset = 0;
+  for (uint64_t i = 0; i < num_slice; i++) {
+    if (slices[i].len_ > 0) {
+      memcpy(buf_.get() + offset, slices[i].mem_, slices[i].len_);
+      offset += slices[i].len_;
+    }
+  }
+  iov_.iov_base = buf_.get();
+  iov_.iov_len = length;
+
+  ASSERT(peer_address.sockAddrLen() <= sizeof(peer_address_));
+  memcpy(&peer_address_, peer_address.sockAddr(), peer_address.sockAddrLen());
+  msg_.msg_name = &peer_address_;
+  msg_.msg_namelen = peer_address.sockAddrLen();
+  msg_.msg_iov = &iov_;
+  msg_.msg_iovlen = 1;
+  if (!control.empty()) {
+    control_ = std::make_unique<uint8_t[]>(control.size());
+    memcpy(control_.get(), control.data(), control.size());
+    msg_.msg_control = control_.get();
+    msg_.msg_controllen = control.size();
+  }
+}
+
 IoUringSocketEntry::IoUringSocketEntry(os_fd_t fd, IoUringWorkerImpl& parent, Event::FileReadyCb cb,
                                        bool enable_close_event)
     : fd_(fd), parent_(parent), enable_close_event_(enable_close_event), cb_(std::move(cb)) {}
@@ -60,14 +152,36 @@ void IoUringSocketEntry::onRemoteClose() {
 
 IoUringWorkerImpl::IoUringWorkerImpl(uint32_t io_uring_size, bool use_submission_queue_polling,
                                      uint32_t read_buffer_size, uint32_t write_timeout_ms,
+                                     uint32_t zero_copy_send_threshold,
+                                     uint32_t buffer_ring_size, IoUringWorkerStatsSharedPtr stats,
                                      Event::Dispatcher& dispatcher)
     : IoUringWorkerImpl(std::make_unique<IoUringImpl>(io_uring_size, use_submission_queue_polling),
-                        read_buffer_size, write_timeout_ms, dispatcher) {}
+                        read_buffer_size, write_timeout_ms, zero_copy_send_threshold,
+                        buffer_ring_size, std::move(stats), dispatcher) {}
 
 IoUringWorkerImpl::IoUringWorkerImpl(IoUringPtr&& io_uring, uint32_t read_buffer_size,
-                                     uint32_t write_timeout_ms, Event::Dispatcher& dispatcher)
+                                     uint32_t write_timeout_ms, uint32_t zero_copy_send_threshold,
+                                     uint32_t buffer_ring_size, IoUringWorkerStatsSharedPtr stats,
+                                     Event::Dispatcher& dispatcher)
     : io_uring_(std::move(io_uring)), read_buffer_size_(read_buffer_size),
-      write_timeout_ms_(write_timeout_ms), dispatcher_(dispatcher) {
+      write_timeout_ms_(write_timeout_ms), zero_copy_send_threshold_(zero_copy_send_threshold),
+      stats_(std::move(stats)), dispatcher_(dispatcher) {
+  if (buffer_ring_size > 0) {
+    if (io_uring_->registerBufferRing(ProvidedBufferGroup, buffer_ring_size) ==
+        IoUringResult::Ok) {
+      provided_buffers_.resize(buffer_ring_size);
+      for (uint32_t i = 0; i < buffer_ring_size; i++) {
+        provided_buffers_[i] = std::make_unique<uint8_t[]>(read_buffer_size_);
+        io_uring_->addBufferToRing(ProvidedBufferGroup, provided_buffers_[i].get(),
+                                   read_buffer_size_, i);
+      }
+      multishot_recv_enabled_ = true;
+    } else {
+      ENVOY_LOG(warn, "io_uring provided buffer rings are not supported by the kernel, falling "
+                      "back to a read buffer per socket");
+    }
+  }
+
   const os_fd_t event_fd = io_uring_->registerEventfd();
   // We only care about the read event of Eventfd, since we only receive the
   // event here.
@@ -97,6 +211,15 @@ IoUringWorkerImpl::~IoUringWorkerImpl() {
     onFileEvent();
   }
 
+  // Exit the ring before releasing the zero-copy sends still waiting for their notifications, so
+  // that no completion can refer to them anymore. The provided buffers outlive the ring as well.
+  file_event_.reset();
+  io_uring_.reset();
+  for (Request* req : pending_send_zc_notifications_) {
+    delete req;
+  }
+  pending_send_zc_notifications_.clear();
+
   dispatcher_.clearDeferredDeleteList();
 }
 
@@ -127,6 +250,14 @@ IoUringSocket& IoUringWorkerImpl::addClientSocket(os_fd_t fd, Event::FileReadyCb
   return addSocket(std::move(socket));
 }
 
+IoUringSocket& IoUringWorkerImpl::addDatagramSocket(os_fd_t fd, Event::FileReadyCb cb) {
+  ENVOY_LOG(trace, "add datagram socket, fd = {}", fd);
+  std::unique_ptr<IoUringDatagramSocket> socket =
+      std::make_unique<IoUringDatagramSocket>(fd, *this, std::move(cb));
+  socket->enableRead();
+  return addSocket(std::move(socket));
+}
+
 Event::Dispatcher& IoUringWorkerImpl::dispatcher() { return dispatcher_; }
 
 IoUringSocketEntry& IoUringWorkerImpl::addSocket(IoUringSocketEntryPtr&& socket) {
@@ -134,6 +265,18 @@ IoUringSocketEntry& IoUringWorkerImpl::addSocket(IoUringSocketEntryPtr&& socket)
   return *sockets_.back();
 }
 
+template <typename PrepareFn>
+void IoUringWorkerImpl::prepareAndSubmit(absl::string_view name, PrepareFn prepare) {
+  IoUringResult res = prepare();
+  if (res == IoUringResult::Failed) {
+    // TODO(rojkov): handle `EBUSY` in case the completion queue is never reaped.
+    submit();
+    res = prepare();
+    RELEASE_ASSERT(res == IoUringResult::Ok, fmt::format("unable to prepare {}", name));
+  }
+  submit();
+}
+
 Request*
 IoUringWorkerImpl::submitConnectRequest(IoUringSocket& socket,
                                         const Network::Address::InstanceConstSharedPtr& address) {
@@ -141,30 +284,65 @@ IoUringWorkerImpl::submitConnectRequest(IoUringSocket& socket,
 
   ENVOY_LOG(trace, "submit connect request, fd = {}, req = {}", socket.fd(), fmt::ptr(req));
 
-  auto res = io_uring_->prepareConnect(socket.fd(), address, req);
-  if (res == IoUringResult::Failed) {
-    // TODO(rojkov): handle `EBUSY` in case the completion queue is never reaped.
-    submit();
-    res = io_uring_->prepareConnect(socket.fd(), address, req);
-    RELEASE_ASSERT(res == IoUringResult::Ok, "unable to prepare connect");
-  }
-  submit();
+  prepareAndSubmit("connect", [&]() {
+    return io_uring_->prepareConnect(socket.fd(), address, req);
+  });
   return req;
 }
 
 Request* IoUringWorkerImpl::submitReadRequest(IoUringSocket& socket) {
+  return submitReadRequest(socket, multishot_recv_enabled_);
+}
+
+Request* IoUringWorkerImpl::submitReadRequest(IoUringSocket& socket, bool multishot) {
+  if (multishot && multishot_recv_enabled_) {
+    ReadRequest* req = new ReadRequest(socket);
+
+    ENVOY_LOG(trace, "submit multishot recv request, fd = {}, read req = {}", socket.fd(),
+              fmt::ptr(req));
+
+    prepareAndSubmit("recv multishot", [&]() {
+      return io_uring_->prepareRecvMultishot(socket.fd(), ProvidedBufferGroup, req);
+    });
+    return req;
+  }
+
   ReadRequest* req = new ReadRequest(socket, read_buffer_size_);
 
   ENVOY_LOG(trace, "submit read request, fd = {}, read req = {}", socket.fd(), fmt::ptr(req));
 
-  auto res = io_uring_->prepareReadv(socket.fd(), req->iov_.get(), 1, 0, req);
-  if (res == IoUringResult::Failed) {
-    // TODO(rojkov): handle `EBUSY` in case the completion queue is never reaped.
-    submit();
-    res = io_uring_->prepareReadv(socket.fd(), req->iov_.get(), 1, 0, req);
-    RELEASE_ASSERT(res == IoUringResult::Ok, "unable to prepare readv");
+  prepareAndSubmit("readv", [&]() {
+    return io_uring_->prepareReadv(socket.fd(), req->iov_.get(), 1, 0, req);
+  });
+  return req;
+}
+
+Request* IoUringWorkerImpl::submitRecvmsgRequest(IoUringSocket& socket) {
+  return submitRecvmsgRequest(socket, multishot_recv_enabled_);
+}
+
+Request* IoUringWorkerImpl::submitRecvmsgRequest(IoUringSocket& socket, bool multishot) {
+  // A provided buffer has to fit a whole datagram, otherwise the datagram is truncated.
+  if (multishot && multishot_recv_enabled_ &&
+      read_buffer_size_ >= RecvmsgRequest::MinProvidedBufferSize) {
+    RecvmsgRequest* req = new RecvmsgRequest(socket);
+
+    ENVOY_LOG(trace, "submit multishot recvmsg request, fd = {}, read req = {}", socket.fd(),
+              fmt::ptr(req));
+
+    prepareAndSubmit("recvmsg multishot", [&]() {
+      return io_uring_->prepareRecvmsgMultishot(socket.fd(), &req->msg_, ProvidedBufferGroup, req);
+    });
+    return req;
   }
-  submit();
+
+  RecvmsgRequest* req = new RecvmsgRequest(socket, RecvmsgRequest::MaxDatagramSize);
+
+  ENVOY_LOG(trace, "submit recvmsg request, fd = {}, read req = {}", socket.fd(), fmt::ptr(req));
+
+  prepareAndSubmit("recvmsg", [&]() {
+    return io_uring_->prepareRecvmsg(socket.fd(), &req->msg_, req);
+  });
   return req;
 }
 
@@ -174,14 +352,36 @@ Request* IoUringWorkerImpl::submitWriteRequest(IoUringSocket& socket,
 
   ENVOY_LOG(trace, "submit write request, fd = {}, req = {}", socket.fd(), fmt::ptr(req));
 
-  auto res = io_uring_->prepareWritev(socket.fd(), req->iov_.get(), slices.size(), 0, req);
-  if (res == IoUringResult::Failed) {
-    // TODO(rojkov): handle `EBUSY` in case the completion queue is never reaped.
-    submit();
-    res = io_uring_->prepareWritev(socket.fd(), req->iov_.get(), slices.size(), 0, req);
-    RELEASE_ASSERT(res == IoUringResult::Ok, "unable to prepare writev");
-  }
-  submit();
+  prepareAndSubmit("writev", [&]() {
+    return io_uring_->prepareWritev(socket.fd(), req->iov_.get(), slices.size(), 0, req);
+  });
+  return req;
+}
+
+Request* IoUringWorkerImpl::submitSendZcRequest(IoUringSocket& socket, Buffer::Instance& data) {
+  SendZcRequest* req = new SendZcRequest(socket, data);
+
+  ENVOY_LOG(trace, "submit send zc request, fd = {}, size = {}, req = {}", socket.fd(),
+            req->data_.length(), fmt::ptr(req));
+
+  prepareAndSubmit("sendmsg zc", [&]() {
+    return io_uring_->prepareSendmsgZc(socket.fd(), &req->msg_, req);
+  });
+  return req;
+}
+
+Request* IoUringWorkerImpl::submitSendmsgRequest(IoUringSocket& socket,
+                                                 const Buffer::RawSlice* slices, uint64_t num_slice,
+                                                 const Network::Address::Instance& peer_address,
+                                                 absl::string_view control) {
+  SendmsgRequest* req = new SendmsgRequest(socket, slices, num_slice, peer_address, control);
+
+  ENVOY_LOG(trace, "submit sendmsg request, fd = {}, size = {}, req = {}", socket.fd(),
+            req->iov_.iov_len, fmt::ptr(req));
+
+  prepareAndSubmit("sendmsg", [&]() {
+    return io_uring_->prepareSendmsg(socket.fd(), &req->msg_, req);
+  });
   return req;
 }
 
@@ -190,14 +390,7 @@ Request* IoUringWorkerImpl::submitCloseRequest(IoUringSocket& socket) {
 
   ENVOY_LOG(trace, "submit close request, fd = {}, close req = {}", socket.fd(), fmt::ptr(req));
 
-  auto res = io_uring_->prepareClose(socket.fd(), req);
-  if (res == IoUringResult::Failed) {
-    // TODO(rojkov): handle `EBUSY` in case the completion queue is never reaped.
-    submit();
-    res = io_uring_->prepareClose(socket.fd(), req);
-    RELEASE_ASSERT(res == IoUringResult::Ok, "unable to prepare close");
-  }
-  submit();
+  prepareAndSubmit("close", [&]() { return io_uring_->prepareClose(socket.fd(), req); });
   return req;
 }
 
@@ -207,14 +400,7 @@ Request* IoUringWorkerImpl::submitCancelRequest(IoUringSocket& socket, Request*
   ENVOY_LOG(trace, "submit cancel request, fd = {}, cancel req = {}, req to cancel = {}",
             socket.fd(), fmt::ptr(req), fmt::ptr(request_to_cancel));
 
-  auto res = io_uring_->prepareCancel(request_to_cancel, req);
-  if (res == IoUringResult::Failed) {
-    // TODO(rojkov): handle `EBUSY` in case the completion queue is never reaped.
-    submit();
-    res = io_uring_->prepareCancel(request_to_cancel, req);
-    RELEASE_ASSERT(res == IoUringResult::Ok, "unable to prepare cancel");
-  }
-  submit();
+  prepareAndSubmit("cancel", [&]() { return io_uring_->prepareCancel(request_to_cancel, req); });
   return req;
 }
 
@@ -224,14 +410,7 @@ Request* IoUringWorkerImpl::submitShutdownRequest(IoUringSocket& socket, int how
   ENVOY_LOG(trace, "submit shutdown request, fd = {}, shutdown req = {}", socket.fd(),
             fmt::ptr(req));
 
-  auto res = io_uring_->prepareShutdown(socket.fd(), how, req);
-  if (res == IoUringResult::Failed) {
-    // TODO(rojkov): handle `EBUSY` in case the completion queue is never reaped.
-    submit();
-    res = io_uring_->prepareShutdown(socket.fd(), how, req);
-    RELEASE_ASSERT(res == IoUringResult::Ok, "unable to prepare cancel");
-  }
-  submit();
+  prepareAndSubmit("shutdown", [&]() { return io_uring_->prepareShutdown(socket.fd(), how, req); });
   return req;
 }
 
@@ -251,7 +430,7 @@ void IoUringWorkerImpl::injectCompletion(IoUringSocket& socket, Request::Request
 void IoUringWorkerImpl::onFileEvent() {
   ENVOY_LOG(trace, "io uring worker, on file event");
   delay_submit_ = true;
-  io_uring_->forEveryCompletion([](Request* req, int32_t result, bool injected) {
+  io_uring_->forEveryCompletion([this](Request* req, int32_t result, bool injected) {
     ENVOY_LOG(trace, "receive request completion, type = {}, req = {}",
               static_cast<uint8_t>(req->type()), fmt::ptr(req));
     ASSERT(req != nullptr);
@@ -270,13 +449,36 @@ void IoUringWorkerImpl::onFileEvent() {
     case Request::RequestType::Read:
       ENVOY_LOG(trace, "receive Read request completion, fd = {}, req = {}", req->socket().fd(),
                 fmt::ptr(req));
-      req->socket().onRead(req, result, injected);
+      if (req->completionFlags() & IORING_CQE_F_BUFFER) {
+        // The socket copies the received data out of the buffer the kernel has filled, then the
+        // buffer goes back to the ring.
+        const uint16_t buffer_id = req->completionFlags() >> IORING_CQE_BUFFER_SHIFT;
+        ReadRequest* read_req = static_cast<ReadRequest*>(req);
+        ASSERT(buffer_id < provided_buffers_.size());
+        read_req->selected_buf_ = provided_buffers_[buffer_id].get();
+        req->socket().onRead(req, result, injected);
+        read_req->selected_buf_ = nullptr;
+        recycleProvidedBuffer(buffer_id);
+      } else {
+        req->socket().onRead(req, result, injected);
+      }
+      if (req->completionFlags() & IORING_CQE_F_MORE) {
+        // The multishot recv stays armed, it is deleted with its last completion.
+        return;
+      }
       break;
     case Request::RequestType::Write:
       ENVOY_LOG(trace, "receive write request completion, fd = {}, req = {}", req->socket().fd(),
                 fmt::ptr(req));
       req->socket().onWrite(req, result, injected);
       break;
+    case Request::RequestType::SendZc:
+      ASSERT(!injected);
+      if (onSendZcCompletion(*static_cast<SendZcRequest*>(req), result)) {
+        // The request is deleted when its notification arrives.
+        return;
+      }
+      break;
     case Request::RequestType::Close:
       ENVOY_LOG(trace, "receive close request completion, fd = {}, req = {}", req->socket().fd(),
                 fmt::ptr(req));
@@ -300,6 +502,37 @@ void IoUringWorkerImpl::onFileEvent() {
   submit();
 }
 
+bool IoUringWorkerImpl::onSendZcCompletion(SendZcRequest& req, int32_t result) {
+  // The socket may be gone when the notification arrives, so it must not be accessed here.
+  if (req.completionFlags() & IORING_CQE_F_NOTIF) {
+    ENVOY_LOG(trace, "receive send zc notification, req = {}", fmt::ptr(&req));
+    pending_send_zc_notifications_.erase(&req);
+    if (stats_ != nullptr) {
+      stats_->write_zero_copy_notification_latency_.recordValue(
+          std::chrono::duration_cast<std::chrono::microseconds>(
+              dispatcher_.timeSource().monotonicTime() - req.send_completion_time_)
+              .count());
+    }
+    return false;
+  }
+
+  ENVOY_LOG(trace, "receive send zc request completion, fd = {}, req = {}", req.socket().fd(),
+            fmt::ptr(&req));
+  // A notification follows only if the kernel has set IORING_CQE_F_MORE.
+  const bool wait_notification = req.completionFlags() & IORING_CQE_F_MORE;
+  if (wait_notification) {
+    req.send_completion_time_ = dispatcher_.timeSource().monotonicTime();
+    pending_send_zc_notifications_.insert(&req);
+  }
+  req.socket().onWrite(&req, result, false);
+  return wait_notification;
+}
+
+void IoUringWorkerImpl::recycleProvidedBuffer(uint16_t buffer_id) {
+  io_uring_->addBufferToRing(ProvidedBufferGroup, provided_buffers_[buffer_id].get(),
+                             read_buffer_size_, buffer_id);
+}
+
 void IoUringWorkerImpl::submit() {
   if (!delay_submit_) {
     io_uring_->submit();
@@ -333,12 +566,13 @@ void IoUringServerSocket::close(bool keep_fd_open, IoUringSocketOnClosedCb cb) {
   keep_fd_open_ = keep_fd_open;
 
   // Delay close until read request and write (or shutdown) request are drained.
-  if (read_req_ == nullptr && write_or_shutdown_req_ == nullptr) {
+  if (read_req_ == nullptr && write_or_shutdown_req_ == nullptr && read_cancel_req_ == nullptr) {
     closeInternal();
     return;
   }
 
-  if (read_req_ != nullptr) {
+  // The read may be cancelled already by disableRead().
+  if (read_req_ != nullptr && read_cancel_req_ == nullptr) {
     ENVOY_LOG(trace, "cancel the read request, fd = {}", fd_);
     read_cancel_req_ = parent_.submitCancelRequest(*this, read_req_);
   }
@@ -372,7 +606,18 @@ void IoUringServerSocket::enableRead() {
   submitReadRequest();
 }
 
-void IoUringServerSocket::disableRead() { IoUringSocketEntry::disableRead(); }
+void IoUringServerSocket::disableRead() {
+  IoUringSocketEntry::disableRead();
+
+  // An armed multishot recv keeps appending to the read buffer, so it is cancelled. A single shot
+  // read takes its place to notice the remote close, see submitReadRequest().
+  if (read_req_ != nullptr && read_cancel_req_ == nullptr &&
+      read_req_->type() == Request::RequestType::Read &&
+      static_cast<ReadRequest*>(read_req_)->buffer_select_) {
+    ENVOY_LOG(trace, "cancel the multishot recv, fd = {}", fd_);
+    read_cancel_req_ = parent_.submitCancelRequest(*this, read_req_);
+  }
+}
 
 void IoUringServerSocket::write(Buffer::Instance& data) {
   ENVOY_LOG(trace, "write, buffer size = {}, fd = {}", data.length(), fd_);
@@ -418,6 +663,10 @@ void IoUringServerSocket::onCancel(Request* req, int32_t result, bool injected)
   ASSERT(!injected);
   if (read_cancel_req_ == req) {
     read_cancel_req_ = nullptr;
+    // Submit the read which was held back while the cancel was in flight.
+    if ((status_ == ReadEnabled || status_ == ReadDisabled) && !read_error_.has_value()) {
+      submitReadRequest();
+    }
   }
   if (write_or_shutdown_cancel_req_ == req) {
     write_or_shutdown_cancel_req_ = nullptr;
@@ -430,6 +679,12 @@ void IoUringServerSocket::onCancel(Request* req, int32_t result, bool injected)
 
 void IoUringServerSocket::moveReadDataToBuffer(Request* req, size_t data_length) {
   ReadRequest* read_req = static_cast<ReadRequest*>(req);
+  if (read_req->buffer_select_) {
+    // The provided buffer goes back to the ring after the completion, only the received bytes
+    // are copied out of it.
+    read_buf_.add(read_req->selected_buf_, data_length);
+    return;
+  }
   Buffer::BufferFragment* fragment = new Buffer::BufferFragmentImpl(
       read_req->buf_.release(), data_length,
       [](const void* data, size_t, const Buffer::BufferFragmentImpl* this_fragment) {
@@ -456,11 +711,26 @@ void IoUringServerSocket::onRead(Request* req, int32_t result, bool injected) {
   ENVOY_LOG(trace,
             "onRead with result {}, fd = {}, injected = {}, status_ = {}, enable_close_event = {}",
             result, fd_, injected, static_cast<int>(status_), enable_close_event_);
+  // A multishot recv ends when the provided buffer ring runs out of buffers, and fails if the
+  // kernel doesn't support it. Neither is an error of the socket, the read is submitted again.
+  bool resubmit_read = false;
   if (!injected) {
-    read_req_ = nullptr;
+    // A multishot recv stays armed as long as the kernel sets IORING_CQE_F_MORE.
+    if (!(req->completionFlags() & IORING_CQE_F_MORE)) {
+      read_req_ = nullptr;
+    }
+    if (static_cast<ReadRequest*>(req)->buffer_select_ &&
+        (result == -ENOBUFS || result == -EINVAL)) {
+      if (result == -EINVAL && !multishot_recv_unsupported_) {
+        ENVOY_LOG(debug, "multishot recv is not supported, falling back to a read buffer, fd = {}",
+                  fd_);
+        multishot_recv_unsupported_ = true;
+      }
+      resubmit_read = true;
+    }
     // If the socket is going to close, discard all results.
-    if (status_ == Closed && write_or_shutdown_req_ == nullptr && read_cancel_req_ == nullptr &&
-        write_or_shutdown_cancel_req_ == nullptr) {
+    if (status_ == Closed && read_req_ == nullptr && write_or_shutdown_req_ == nullptr &&
+        read_cancel_req_ == nullptr && write_or_shutdown_cancel_req_ == nullptr) {
       if (result > 0 && keep_fd_open_) {
         moveReadDataToBuffer(req, result);
       }
@@ -473,7 +743,7 @@ void IoUringServerSocket::onRead(Request* req, int32_t result, bool injected) {
   if (result > 0) {
     moveReadDataToBuffer(req, result);
   } else {
-    if (result != -ECANCELED) {
+    if (result != -ECANCELED && !resubmit_read) {
       read_error_ = result;
     }
   }
@@ -578,8 +848,23 @@ void IoUringServerSocket::onWrite(Request* req, int32_t result, bool injected) {
   }
 
   if (result > 0) {
-    write_buf_.drain(result);
-    ENVOY_LOG(trace, "drain write buf, drain size = {}, fd = {}", result, fd_);
+    IoUringWorkerStats* stats = parent_.stats();
+    if (req->type() == Request::RequestType::SendZc) {
+      // The sent data is kept by the request until the kernel releases it, only the data which
+      // was not sent has to be written again.
+      static_cast<SendZcRequest*>(req)->returnUnsentData(result, write_buf_);
+      if (stats != nullptr) {
+        stats->write_zero_copy_bytes_.add(result);
+        stats->write_zero_copy_requests_.inc();
+      }
+      ENVOY_LOG(trace, "zero-copy sent size = {}, fd = {}", result, fd_);
+    } else {
+      write_buf_.drain(result);
+      if (stats != nullptr) {
+        stats->write_copied_bytes_.add(result);
+      }
+      ENVOY_LOG(trace, "drain write buf, drain size = {}, fd = {}", result, fd_);
+    }
   } else {
     // Drain all write buf since the write failed.
     write_buf_.drain(write_buf_.length());
@@ -621,14 +906,23 @@ void IoUringServerSocket::closeInternal() {
 }
 
 void IoUringServerSocket::submitReadRequest() {
-  if (!read_req_) {
-    read_req_ = parent_.submitReadRequest(*this);
+  // Wait for a cancelled read to finish, so that a read cancel always targets read_req_.
+  if (!read_req_ && read_cancel_req_ == nullptr) {
+    // A multishot recv keeps receiving until it is cancelled, so it is only armed while the read
+    // is enabled.
+    read_req_ = parent_.submitReadRequest(
+        *this, status_ == ReadEnabled && !multishot_recv_unsupported_);
   }
 }
 
 void IoUringServerSocket::submitWriteOrShutdownRequest() {
   if (!write_or_shutdown_req_) {
-    if (write_buf_.length() > 0) {
+    if (write_buf_.length() > 0 && parent_.zeroCopySendThreshold() > 0 &&
+        write_buf_.length() >= parent_.zeroCopySendThreshold()) {
+      ENVOY_LOG(trace, "submit send zc request, write_buf size = {}, fd = {}", write_buf_.length(),
+                fd_);
+      write_or_shutdown_req_ = parent_.submitSendZcRequest(*this, write_buf_);
+    } else if (write_buf_.length() > 0) {
       Buffer::RawSliceVector slices = write_buf_.getRawSlices(IOV_MAX);
       ENVOY_LOG(trace, "submit write request, write_buf size = {}, num_iovecs = {}, fd = {}",
                 write_buf_.length(), slices.size(), fd_);
@@ -678,5 +972,257 @@ void IoUringClientSocket::onConnect(Request* req, int32_t result, bool injected)
   parent_.injectCompletion(*this, Request::RequestType::Write, result);
 }
 
+IoUringDatagramSocket::IoUringDatagramSocket(os_fd_t fd, IoUringWorkerImpl& parent,
+                                             Event::FileReadyCb cb)
+    : IoUringSocketEntry(fd, parent, std::move(cb), false) {}
+
+void IoUringDatagramSocket::close(bool keep_fd_open, IoUringSocketOnClosedCb cb) {
+  ENVOY_LOG(trace, "close the datagram socket, fd = {}, status = {}", fd_,
+            static_cast<int>(status_));
+
+  IoUringSocketEntry::close(keep_fd_open, cb);
+  keep_fd_open_ = keep_fd_open;
+
+  // Delay close until the read request is canceled and the sends are drained. Datagram sends
+  // don't block on the peer, so they are not canceled.
+  if (read_req_ == nullptr && read_cancel_req_ == nullptr && send_reqs_.empty()) {
+    closeInternal();
+    return;
+  }
+
+  // The read may be cancelled already by disableRead().
+  if (read_req_ != nullptr && read_cancel_req_ == nullptr) {
+    ENVOY_LOG(trace, "cancel the recvmsg request, fd = {}", fd_);
+    read_cancel_req_ = parent_.submitCancelRequest(*this, read_req_);
+  }
+}
+
+void IoUringDatagramSocket::enableRead() {
+  IoUringSocketEntry::enableRead();
+  ENVOY_LOG(trace, "enable read, fd = {}, queued datagrams = {}", fd_, datagrams_.size());
+
+  // Deliver the datagrams which were received while the read was disabled.
+  if (!datagrams_.empty()) {
+    injectCompletion(Request::RequestType::Read);
+  }
+  submitReadRequest();
+}
+
+void IoUringDatagramSocket::disableRead() {
+  IoUringSocketEntry::disableRead();
+
+  // An armed multishot recvmsg keeps receiving, so it is cancelled to leave the datagrams in the
+  // kernel's receive queue while the read is disabled.
+  if (read_req_ != nullptr && read_cancel_req_ == nullptr &&
+      static_cast<RecvmsgRequest*>(read_req_)->buffer_select_) {
+    ENVOY_LOG(trace, "cancel the multishot recvmsg, fd = {}", fd_);
+    read_cancel_req_ = parent_.submitCancelRequest(*this, read_req_);
+  }
+}
+
+int32_t IoUringDatagramSocket::sendmsg(const Buffer::RawSlice* slices, uint64_t num_slice,
+                                       const Network::Address::Instance& peer_address,
+                                       absl::string_view control) {
+  ASSERT(status_ != Closed);
+  if (send_reqs_.size() >= MaxSendsInFlight) {
+    ENVOY_LOG(trace, "too many sends in flight, fd = {}", fd_);
+    send_blocked_ = true;
+    return -EAGAIN;
+  }
+
+  uint64_t length = 0;
+  for (uint64_t i = 0; i < num_slice; i++) {
+    length += slices[i].len_;
+  }
+  send_reqs_.insert(parent_.submitSendmsgRequest(*this, slices, num_slice, peer_address, control));
+  return static_cast<int32_t>(length);
+}
+
+absl::optional<ReceivedDatagram> IoUringDatagramSocket::takeDatagram() {
+  if (datagrams_.empty()) {
+    return absl::nullopt;
+  }
+  ReceivedDatagram datagram = std::move(datagrams_.front());
+  datagrams_.pop_front();
+  return datagram;
+}
+
+void IoUringDatagramSocket::onClose(Request* req, int32_t result, bool injected) {
+  IoUringSocketEntry::onClose(req, result, injected);
+  ASSERT(!injected);
+  cleanup();
+}
+
+void IoUringDatagramSocket::onCancel(Request* req, int32_t result, bool injected) {
+  IoUringSocketEntry::onCancel(req, result, injected);
+  ASSERT(!injected);
+  if (read_cancel_req_ == req) {
+    read_cancel_req_ = nullptr;
+    // Submit the read which was held back while the cancel was in flight.
+    if (status_ == ReadEnabled) {
+      submitReadRequest();
+    }
+  }
+  if (status_ == Closed && read_req_ == nullptr && send_reqs_.empty()) {
+    closeInternal();
+  }
+}
+
+void IoUringDatagramSocket::queueDatagram(RecvmsgRequest& req, int32_t result) {
+  ReceivedDatagram datagram;
+  const uint8_t* payload;
+  uint64_t payload_length;
+  if (req.buffer_select_) {
+    // The provided buffer holds the address and the control messages ahead of the payload.
+    struct io_uring_recvmsg_out* out =
+        io_uring_recvmsg_validate(req.selected_buf_, result, &req.msg_);
+    if (out == nullptr) {
+      ENVOY_LOG(debug, "discard an invalid recvmsg result, fd = {}, result = {}", fd_, result);
+      return;
+    }
+    datagram.peer_address_len_ = std::min<socklen_t>(out->namelen, req.msg_.msg_namelen);
+    memcpy(&datagram.peer_address_, io_uring_recvmsg_name(out), datagram.peer_address_len_);
+    const uint8_t* control =
+        static_cast<const uint8_t*>(io_uring_recvmsg_name(out)) + req.msg_.msg_namelen;
+    datagram.control_.assign(control, control + out->controllen);
+    payload = static_cast<const uint8_t*>(io_uring_recvmsg_payload(out, &req.msg_));
+    payload_length = io_uring_recvmsg_payload_length(out, result, &req.msg_);
+    datagram.truncated_ = out->flags & MSG_TRUNC;
+  } else {
+    datagram.peer_address_len_ = req.msg_.msg_namelen;
+    memcpy(&datagram.peer_address_, &req.peer_address_, datagram.peer_address_len_);
+    datagram.control_.assign(req.control_.get(), req.control_.get() + req.msg_.msg_controllen);
+    payload = req.buf_.get();
+    payload_length = std::min<uint64_t>(result, RecvmsgRequest::MaxDatagramSize);
+    datagram.truncated_ = req.msg_.msg_flags & MSG_TRUNC;
+  }
+
+  if (datagrams_.size() >= MaxQueuedDatagrams) {
+    ENVOY_LOG(debug, "drop a datagram since the queue is full, fd = {}", fd_);
+    dropped_++;
+    return;
+  }
+  // The datagram is copied, so that a queued datagram only holds the memory of its payload.
+  datagram.buffer_ = std::make_unique<Buffer::OwnedImpl>(payload, payload_length);
+  datagram.dropped_ = dropped_;
+  dropped_ = 0;
+  datagrams_.push_back(std::move(datagram));
+}
+
+void IoUringDatagramSocket::onRead(Request* req, int32_t result, bool injected) {
+  IoUringSocketEntry::onRead(req, result, injected);
+
+  ENVOY_LOG(trace, "onRead with result {}, fd = {}, injected = {}, status_ = {}", result, fd_,
+            injected, static_cast<int>(status_));
+  if (!injected) {
+    // A multishot recvmsg stays armed as long as the kernel sets IORING_CQE_F_MORE.
+    if (!(req->completionFlags() & IORING_CQE_F_MORE)) {
+      read_req_ = nullptr;
+    }
+    // If the socket is going to close, discard all results.
+    if (status_ == Closed) {
+      if (read_req_ == nullptr && read_cancel_req_ == nullptr && send_reqs_.empty()) {
+        closeInternal();
+      }
+      return;
+    }
+
+    RecvmsgRequest* recvmsg_req = static_cast<RecvmsgRequest*>(req);
+    if (result >= 0) {
+      queueDatagram(*recvmsg_req, result);
+    } else if (result == -EINVAL && recvmsg_req->buffer_select_) {
+      if (!multishot_recv_unsupported_) {
+        ENVOY_LOG(debug, "multishot recvmsg is not supported, falling back to a buffer, fd = {}",
+                  fd_);
+        multishot_recv_unsupported_ = true;
+      }
+    } else if (result != -ENOBUFS && result != -ECANCELED) {
+      // A multishot recvmsg ends when the provided buffer ring runs out of buffers, it is
+      // submitted again. Other errors, e.g. ICMP errors of connected sockets, are not fatal for a
+      // datagram socket.
+      ENVOY_LOG(debug, "recvmsg failed, fd = {}, error = {}", fd_, errorDetails(-result));
+    }
+  }
+
+  // Discard calling back since the socket is not ready or closed.
+  if (status_ == Initialized || status_ == Closed) {
+    return;
+  }
+
+  if (status_ == ReadEnabled && (injected || !datagrams_.empty())) {
+    ENVOY_LOG(trace, "calling event callback since {} datagrams are queued, fd = {}",
+              datagrams_.size(), fd_);
+    THROW_IF_NOT_OK(cb_(Event::FileReadyType::Read));
+  }
+
+  // The socket may be not readable during handler onRead callback, check it again here. A
+  // disabled socket has no multishot recvmsg armed, see disableRead(), so the datagrams stay in the
+  // kernel's receive queue.
+  if (status_ == ReadEnabled) {
+    submitReadRequest();
+  }
+}
+
+void IoUringDatagramSocket::onWriteCompleted(int32_t result) {
+  WriteParam param{result};
+  write_param_ = param;
+  IoUringSocketEntry::onWriteCompleted();
+  write_param_ = absl::nullopt;
+}
+
+void IoUringDatagramSocket::onWrite(Request* req, int32_t result, bool injected) {
+  IoUringSocketEntry::onWrite(req, result, injected);
+
+  ENVOY_LOG(trace, "onWrite with result {}, fd = {}, injected = {}, status_ = {}", result, fd_,
+            injected, static_cast<int>(status_));
+  if (injected) {
+    if (status_ != Closed) {
+      onWriteCompleted(result);
+    }
+    return;
+  }
+
+  send_reqs_.erase(req);
+  if (result < 0) {
+    // The datagram is lost, like a datagram dropped on the way.
+    ENVOY_LOG(debug, "sendmsg failed, fd = {}, error = {}", fd_, errorDetails(-result));
+  }
+
+  if (status_ == Closed) {
+    if (read_req_ == nullptr && read_cancel_req_ == nullptr && send_reqs_.empty()) {
+      closeInternal();
+    }
+    return;
+  }
+
+  if (send_blocked_) {
+    send_blocked_ = false;
+    onWriteCompleted(result);
+  }
+}
+
+void IoUringDatagramSocket::closeInternal() {
+  if (keep_fd_open_) {
+    if (on_closed_cb_) {
+      // The queued datagrams are dropped, the kernel keeps receiving into the socket's receive
+      // queue until the socket is added to another worker.
+      Buffer::OwnedImpl read_buf;
+      on_closed_cb_(read_buf);
+    }
+    cleanup();
+    return;
+  }
+  if (close_req_ == nullptr) {
+    close_req_ = parent_.submitCloseRequest(*this);
+  }
+}
+
+void IoUringDatagramSocket::submitReadRequest() {
+  // Wait for a cancelled read to finish, so that a read cancel always targets read_req_.
+  if (!read_req_ && read_cancel_req_ == nullptr) {
+    read_req_ = parent_.submitRecvmsgRequest(*this, !multishot_recv_unsupported_);
+  }
+}
+
 } // namespace Io
 } // namespace Envoy
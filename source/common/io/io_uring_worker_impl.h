@@ -1,23 +1,62 @@
 #pragma once
 
+#include <deque>
+
 #include "envoy/common/io/io_uring.h"
+#include "envoy/common/time.h"
+#include "envoy/stats/stats_macros.h"
 
 #include "source/common/buffer/buffer_impl.h"
 #include "source/common/common/linked_object.h"
 #include "source/common/common/logger.h"
 #include "source/common/io/io_uring_impl.h"
 
+#include "absl/container/flat_hash_set.h"
+
 namespace Envoy {
 namespace Io {
 
 class ReadRequest : public Request {
 public:
   ReadRequest(IoUringSocket& socket, uint32_t size);
-
+  // A multishot read, which gets a buffer out of the worker's provided buffer ring for every
+  // completion.
+  explicit ReadRequest(IoUringSocket& socket);
+
+  // Whether the buffer is selected by the kernel out of the provided buffer ring.
+  const bool buffer_select_;
+  // The provided buffer the kernel has filled for the current completion. It goes back to the ring
+  // right after the completion is handled.
+  uint8_t* selected_buf_{nullptr};
   std::unique_ptr<uint8_t[]> buf_;
   std::unique_ptr<struct iovec> iov_;
 };
 
+/**
+ * A recvmsg request of a datagram socket. The multishot form picks a buffer out of the worker's
+ * provided buffer ring for every received datagram, which holds the address and the control
+ * messages ahead of the payload.
+ */
+class RecvmsgRequest : public ReadRequest {
+public:
+  RecvmsgRequest(IoUringSocket& socket, uint32_t size);
+  explicit RecvmsgRequest(IoUringSocket& socket);
+
+  // The space for the control messages received with a datagram.
+  static constexpr uint32_t ControlSize = 512;
+  // The largest datagram, including the ones coalesced by UDP GRO.
+  static constexpr uint32_t MaxDatagramSize = 65536;
+  // The smallest provided buffer which fits the largest datagram along with its address and
+  // control messages.
+  static constexpr uint32_t MinProvidedBufferSize =
+      sizeof(struct io_uring_recvmsg_out) + sizeof(sockaddr_storage) + ControlSize +
+      MaxDatagramSize;
+
+  struct msghdr msg_ {};
+  sockaddr_storage peer_address_;
+  std::unique_ptr<uint8_t[]> control_;
+};
+
 class WriteRequest : public Request {
 public:
   WriteRequest(IoUringSocket& socket, const Buffer::RawSliceVector& slices);
@@ -25,6 +64,64 @@ public:
   std::unique_ptr<struct iovec[]> iov_;
 };
 
+/**
+ * A zero-copy send request. The request takes the slices to send out of the socket's write buffer
+ * so that the memory stays valid until the kernel notifies that it no longer references it. The
+ * notification may arrive after the socket is closed, so the request is owned by the worker until
+ * then.
+ */
+class SendZcRequest : public Request {
+public:
+  SendZcRequest(IoUringSocket& socket, Buffer::Instance& data);
+
+  /**
+   * Copy the data which was not sent by a partial send back to the front of the given buffer.
+   * @param sent the number of bytes sent by the request.
+   * @param buffer the buffer to return the unsent data to.
+   */
+  void returnUnsentData(uint64_t sent, Buffer::Instance& buffer);
+
+  Buffer::OwnedImpl data_;
+  std::unique_ptr<struct iovec[]> iov_;
+  struct msghdr msg_ {};
+  // The time the send completed, used to measure how long the kernel keeps the data pinned.
+  MonotonicTime send_completion_time_;
+};
+
+/**
+ * A sendmsg request of a datagram socket. The request keeps a copy of the datagram, so that the
+ * caller's memory doesn't have to stay valid until the send completes.
+ */
+class SendmsgRequest : public Request {
+public:
+  SendmsgRequest(IoUringSocket& socket, const Buffer::RawSlice* slices, uint64_t num_slice,
+                 const Network::Address::Instance& peer_address, absl::string_view control);
+
+  std::unique_ptr<uint8_t[]> buf_;
+  struct iovec iov_ {};
+  sockaddr_storage peer_address_;
+  std::unique_ptr<uint8_t[]> control_;
+  struct msghdr msg_ {};
+};
+
+/**
+ * All io_uring worker stats. @see stats_macros.h
+ */
+#define ALL_IO_URING_WORKER_STATS(COUNTER, HISTOGRAM)                                              \
+  COUNTER(write_copied_bytes)                                                                      \
+  COUNTER(write_zero_copy_bytes)                                                                   \
+  COUNTER(write_zero_copy_requests)                                                                \
+  HISTOGRAM(write_zero_copy_notification_latency, Microseconds)
+
+/**
+ * Struct definition for all io_uring worker stats. @see stats_macros.h
+ */
+struct IoUringWorkerStats {
+  ALL_IO_URING_WORKER_STATS(GENERATE_COUNTER_STRUCT, GENERATE_HISTOGRAM_STRUCT)
+};
+
+using IoUringWorkerStatsSharedPtr = std::shared_ptr<IoUringWorkerStats>;
+
 class IoUringSocketEntry;
 using IoUringSocketEntryPtr = std::unique_ptr<IoUringSocketEntry>;
 
@@ -32,9 +129,11 @@ class IoUringWorkerImpl : public IoUringWorker, private Logger::Loggable<Logger:
 public:
   IoUringWorkerImpl(uint32_t io_uring_size, bool use_submission_queue_polling,
                     uint32_t read_buffer_size, uint32_t write_timeout_ms,
-                    Event::Dispatcher& dispatcher);
+                    uint32_t zero_copy_send_threshold, uint32_t buffer_ring_size,
+                    IoUringWorkerStatsSharedPtr stats, Event::Dispatcher& dispatcher);
   IoUringWorkerImpl(IoUringPtr&& io_uring, uint32_t read_buffer_size, uint32_t write_timeout_ms,
-                    Event::Dispatcher& dispatcher);
+                    uint32_t zero_copy_send_threshold, uint32_t buffer_ring_size,
+                    IoUringWorkerStatsSharedPtr stats, Event::Dispatcher& dispatcher);
   ~IoUringWorkerImpl() override;
 
   // IoUringWorker
@@ -44,11 +143,23 @@ public:
                                  bool enable_close_event) override;
   IoUringSocket& addClientSocket(os_fd_t fd, Event::FileReadyCb cb,
                                  bool enable_close_event) override;
+  IoUringSocket& addDatagramSocket(os_fd_t fd, Event::FileReadyCb cb) override;
 
   Request* submitConnectRequest(IoUringSocket& socket,
                                 const Network::Address::InstanceConstSharedPtr& address) override;
   Request* submitReadRequest(IoUringSocket& socket) override;
+  // Submit a read request, which is a multishot recv out of the provided buffer ring if
+  // `multishot` is true and the worker has a provided buffer ring.
+  Request* submitReadRequest(IoUringSocket& socket, bool multishot);
+  Request* submitRecvmsgRequest(IoUringSocket& socket) override;
+  // Submit a recvmsg request, which is a multishot recvmsg out of the provided buffer ring if
+  // `multishot` is true and the provided buffers fit the largest datagram.
+  Request* submitRecvmsgRequest(IoUringSocket& socket, bool multishot);
   Request* submitWriteRequest(IoUringSocket& socket, const Buffer::RawSliceVector& slices) override;
+  Request* submitSendZcRequest(IoUringSocket& socket, Buffer::Instance& data) override;
+  Request* submitSendmsgRequest(IoUringSocket& socket, const Buffer::RawSlice* slices,
+                                uint64_t num_slice, const Network::Address::Instance& peer_address,
+                                absl::string_view control) override;
   Request* submitCloseRequest(IoUringSocket& socket) override;
   Request* submitCancelRequest(IoUringSocket& socket, Request* request_to_cancel) override;
   Request* submitShutdownRequest(IoUringSocket& socket, int how) override;
@@ -64,22 +175,52 @@ public:
   // Return the number of sockets in this worker.
   uint32_t getNumOfSockets() const override { return sockets_.size(); }
 
+  // Return the minimum size of a write to be sent with zero-copy, or 0 if zero-copy sends are
+  // disabled.
+  uint32_t zeroCopySendThreshold() const { return zero_copy_send_threshold_; }
+
+  // Return the stats of this worker, which may be null.
+  IoUringWorkerStats* stats() const { return stats_.get(); }
+
+  // Return true if sockets read with multishot recvs out of the provided buffer ring.
+  bool multishotRecvEnabled() const { return multishot_recv_enabled_; }
+
+  // The buffer group id of the worker's provided buffer ring.
+  static constexpr uint16_t ProvidedBufferGroup = 0;
+
 protected:
   // Add a socket to the worker.
   IoUringSocketEntry& addSocket(IoUringSocketEntryPtr&& socket);
   void onFileEvent();
+  // Handle a completion of a zero-copy send request. Returns true if the request must be kept
+  // until its notification arrives.
+  bool onSendZcCompletion(SendZcRequest& req, int32_t result);
+  // Return a buffer consumed by a completion to the provided buffer ring.
+  void recycleProvidedBuffer(uint16_t buffer_id);
+  // Prepare a request with `prepare` and submit it. If the submission queue is full, the queued
+  // requests are submitted first to make room.
+  template <typename PrepareFn> void prepareAndSubmit(absl::string_view name, PrepareFn prepare);
   void submit();
 
   // The iouring instance.
   IoUringPtr io_uring_;
   const uint32_t read_buffer_size_;
   const uint32_t write_timeout_ms_;
+  const uint32_t zero_copy_send_threshold_;
+  IoUringWorkerStatsSharedPtr stats_;
+  // The buffers in the provided buffer ring shared by the multishot recvs of all sockets, indexed
+  // by buffer id. Idle sockets hold no read buffer at all.
+  std::vector<std::unique_ptr<uint8_t[]>> provided_buffers_;
+  bool multishot_recv_enabled_{false};
   // The dispatcher of this worker is running on.
   Event::Dispatcher& dispatcher_;
   // The file event of iouring's eventfd.
   Event::FileEventPtr file_event_{nullptr};
   // All the sockets in this worker.
   std::list<IoUringSocketEntryPtr> sockets_;
+  // The zero-copy send requests whose data is still referenced by the kernel. Their sockets may
+  // be closed already.
+  absl::flat_hash_set<Request*> pending_send_zc_notifications_;
   // This is used to mark whether delay submit is enabled.
   // The IoUringWorker will delay the submit the requests which are submitted in request completion
   // callback.
@@ -106,6 +247,11 @@ public:
   void disableRead() override { status_ = ReadDisabled; }
   void enableCloseEvent(bool enable) override { enable_close_event_ = enable; }
   void connect(const Network::Address::InstanceConstSharedPtr&) override { PANIC("not implement"); }
+  int32_t sendmsg(const Buffer::RawSlice*, uint64_t, const Network::Address::Instance&,
+                  absl::string_view) override {
+    PANIC("not implement");
+  }
+  absl::optional<ReceivedDatagram> takeDatagram() override { PANIC("not implement"); }
 
   void onAccept(Request*, int32_t, bool injected) override {
     if (injected && (injected_completions_ & static_cast<uint8_t>(Request::RequestType::Accept))) {
@@ -236,8 +382,12 @@ protected:
   Event::TimerPtr write_timeout_timer_{nullptr};
   // Whether keep the fd open when close the IoUringSocket.
   bool keep_fd_open_{false};
-  // This is used for tracking the read's cancel request.
+  // This is used for tracking the read's cancel request. No new read is submitted until the
+  // cancelled one is done.
   Request* read_cancel_req_{nullptr};
+  // Whether the kernel refused a multishot recv for this socket, which reads with a buffer of its
+  // own since then.
+  bool multishot_recv_unsupported_{false};
   // This is used for tracking the write or shutdown's cancel request.
   Request* write_or_shutdown_cancel_req_{nullptr};
   // This is used for tracking the close request.
@@ -260,5 +410,60 @@ public:
   void onConnect(Request* req, int32_t result, bool injected) override;
 };
 
+/**
+ * A datagram socket. Received datagrams are queued until the handler takes them, sends are
+ * submitted right away and complete in the background.
+ */
+class IoUringDatagramSocket : public IoUringSocketEntry {
+public:
+  IoUringDatagramSocket(os_fd_t fd, IoUringWorkerImpl& parent, Event::FileReadyCb cb);
+
+  // IoUringSocket
+  void close(bool keep_fd_open, IoUringSocketOnClosedCb cb = nullptr) override;
+  void enableRead() override;
+  void disableRead() override;
+  void write(Buffer::Instance&) override { PANIC("not implement"); }
+  uint64_t write(const Buffer::RawSlice*, uint64_t) override { PANIC("not implement"); }
+  int32_t sendmsg(const Buffer::RawSlice* slices, uint64_t num_slice,
+                  const Network::Address::Instance& peer_address,
+                  absl::string_view control) override;
+  absl::optional<ReceivedDatagram> takeDatagram() override;
+  void shutdown(int) override { PANIC("not implement"); }
+  void onClose(Request* req, int32_t result, bool injected) override;
+  void onRead(Request* req, int32_t result, bool injected) override;
+  void onWrite(Request* req, int32_t result, bool injected) override;
+  void onCancel(Request* req, int32_t result, bool injected) override;
+
+  // The number of received datagrams queued until the handler takes them. Further datagrams are
+  // dropped.
+  static constexpr uint32_t MaxQueuedDatagrams = 1024;
+  // The number of sends in flight, after which sendmsg() fails with -EAGAIN.
+  static constexpr uint32_t MaxSendsInFlight = 256;
+
+protected:
+  void queueDatagram(RecvmsgRequest& req, int32_t result);
+  void submitReadRequest();
+  void closeInternal();
+  void onWriteCompleted(int32_t result);
+
+  Request* read_req_{};
+  std::deque<ReceivedDatagram> datagrams_;
+  // The number of datagrams dropped since the last queued one.
+  uint32_t dropped_{0};
+  absl::flat_hash_set<Request*> send_reqs_;
+  // Whether a sendmsg() failed since too many sends were in flight. A write event is delivered
+  // once a send completes.
+  bool send_blocked_{false};
+  // Whether keep the fd open when close the IoUringSocket.
+  bool keep_fd_open_{false};
+  // This is used for tracking the read's cancel request. No new read is submitted until the
+  // cancelled one is done.
+  Request* read_cancel_req_{nullptr};
+  // Whether the kernel refused a multishot recvmsg for this socket.
+  bool multishot_recv_unsupported_{false};
+  // This is used for tracking the close request.
+  Request* close_req_{nullptr};
+};
+
 } // namespace Io
 } // namespace Envoy
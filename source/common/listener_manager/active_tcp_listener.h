@@ -72,6 +72,7 @@ public:
     ++num_listener_connections_;
     config_->openConnections().inc();
   }
+  Event::DispatcherLoad* dispatcherLoad() override { return &dispatcher().load(); }
   void post(Network::ConnectionSocketPtr&& socket) override;
   void onAcceptWorker(Network::ConnectionSocketPtr&& socket,
                       bool hand_off_restored_destination_connections, bool rebalanced) override;
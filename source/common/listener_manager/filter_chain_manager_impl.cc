@@ -537,6 +537,47 @@ makeCidrListEntry(const std::string& cidr, const T& data, absl::Status& creation
   return std::make_pair<T, std::vector<Network::Address::CidrRange>>(T(data), std::move(subnets));
 }
 
+// Builds the trie matching addresses against the CIDR ranges of an IP map. Returns nullptr if the
+// map is empty, or if it only has a catch-all entry and the catch-all ranges of both IP families
+// are supported, in which case the entry matches any address.
+template <class T>
+absl::StatusOr<std::unique_ptr<Network::LcTrie::LcTrie<T>>>
+buildIpsTrie(const absl::flat_hash_map<std::string, T>& ips_map, bool all_ip_families_supported) {
+  if (ips_map.empty() || (all_ip_families_supported && ips_map.size() == 1 &&
+                          ips_map.begin()->first == EMPTY_STRING)) {
+    return nullptr;
+  }
+
+  std::vector<std::pair<T, std::vector<Network::Address::CidrRange>>> ips_list;
+  ips_list.reserve(ips_map.size());
+  for (const auto& [ip, data] : ips_map) {
+    absl::Status creation_status = absl::OkStatus();
+    ips_list.push_back(makeCidrListEntry(ip, data, creation_status));
+    RETURN_IF_NOT_OK(creation_status);
+  }
+  return std::make_unique<Network::LcTrie::LcTrie<T>>(ips_list, true);
+}
+
+// Returns the data of the entry of an IP map matching the address, or nullptr if none matches.
+// Maps without a trie are matched without looking at the address, see buildIpsTrie().
+template <class T>
+T findIpsMatch(const absl::flat_hash_map<std::string, T>& ips_map,
+               const Network::LcTrie::LcTrie<T>* ips_trie,
+               const Network::Address::InstanceConstSharedPtr& address) {
+  if (ips_trie == nullptr) {
+    return ips_map.empty() ? nullptr : ips_map.begin()->second;
+  }
+
+  // Match on both: exact IP and wider CIDR ranges using LcTrie.
+  const auto& data = ips_trie->getData(
+      address->type() == Network::Address::Type::Ip ? address : FilterChain::fakeAddress());
+  if (data.empty()) {
+    return nullptr;
+  }
+  ASSERT(data.size() == 1);
+  return data.back();
+}
+
 }; // namespace
 
 const Network::FilterChain*
@@ -553,7 +594,7 @@ FilterChainManagerImpl::findFilterChain(const Network::ConnectionSocket& socket,
   if (address->type() == Network::Address::Type::Ip) {
     const auto port_match = destination_ports_map_.find(address->ip()->port());
     if (port_match != destination_ports_map_.end()) {
-      best_match_filter_chain = findFilterChainForDestinationIP(*port_match->second.second, socket);
+      best_match_filter_chain = findFilterChainForDestinationIP(port_match->second, socket);
       if (best_match_filter_chain != nullptr) {
         return best_match_filter_chain;
       } else {
@@ -566,7 +607,7 @@ FilterChainManagerImpl::findFilterChain(const Network::ConnectionSocket& socket,
   // Match on catch-all port 0 if there is no specific port sub tree.
   const auto port_match = destination_ports_map_.find(0);
   if (port_match != destination_ports_map_.end()) {
-    best_match_filter_chain = findFilterChainForDestinationIP(*port_match->second.second, socket);
+    best_match_filter_chain = findFilterChainForDestinationIP(port_match->second, socket);
   }
   return best_match_filter_chain != nullptr
              ? best_match_filter_chain
@@ -589,17 +630,12 @@ FilterChainManagerImpl::findFilterChainUsingMatcher(const Network::ConnectionSoc
 }
 
 const Network::FilterChain* FilterChainManagerImpl::findFilterChainForDestinationIP(
-    const DestinationIPsTrie& destination_ips_trie, const Network::ConnectionSocket& socket) const {
-  auto address = socket.connectionInfoProvider().localAddress();
-  if (address->type() != Network::Address::Type::Ip) {
-    address = FilterChain::fakeAddress();
-  }
-
-  // Match on both: exact IP and wider CIDR ranges using LcTrie.
-  const auto& data = destination_ips_trie.getData(address);
-  if (!data.empty()) {
-    ASSERT(data.size() == 1);
-    return findFilterChainForServerName(*data.back(), socket);
+    const DestinationIPsPair& destination_ips_pair, const Network::ConnectionSocket& socket) const {
+  const auto server_names_map = findIpsMatch(destination_ips_pair.first,
+                                             destination_ips_pair.second.get(),
+                                             socket.connectionInfoProvider().localAddress());
+  if (server_names_map != nullptr) {
+    return findFilterChainForServerName(*server_names_map, socket);
   }
 
   return nullptr;
@@ -608,7 +644,7 @@ const Network::FilterChain* FilterChainManagerImpl::findFilterChainForDestinatio
 const Network::FilterChain* FilterChainManagerImpl::findFilterChainForServerName(
     const ServerNamesMap& server_names_map, const Network::ConnectionSocket& socket) const {
   ASSERT(absl::AsciiStrToLower(socket.requestedServerName()) == socket.requestedServerName());
-  const std::string server_name(socket.requestedServerName());
+  const absl::string_view server_name = socket.requestedServerName();
 
   // Match on exact server name, i.e. "www.example.com" for "www.example.com".
   const auto server_name_exact_match = server_names_map.find(server_name);
@@ -618,8 +654,8 @@ const Network::FilterChain* FilterChainManagerImpl::findFilterChainForServerName
 
   // Match on all wildcard domains, i.e. ".example.com" and ".com" for "www.example.com".
   size_t pos = server_name.find('.', 1);
-  while (pos < server_name.size() - 1 && pos != std::string::npos) {
-    const std::string wildcard = server_name.substr(pos);
+  while (pos < server_name.size() - 1 && pos != absl::string_view::npos) {
+    const absl::string_view wildcard = server_name.substr(pos);
     const auto server_name_wildcard_match = server_names_map.find(wildcard);
     if (server_name_wildcard_match != server_names_map.end()) {
       return findFilterChainForTransportProtocol(server_name_wildcard_match->second, socket);
@@ -639,7 +675,7 @@ const Network::FilterChain* FilterChainManagerImpl::findFilterChainForServerName
 const Network::FilterChain* FilterChainManagerImpl::findFilterChainForTransportProtocol(
     const TransportProtocolsMap& transport_protocols_map,
     const Network::ConnectionSocket& socket) const {
-  const std::string transport_protocol(socket.detectedTransportProtocol());
+  const absl::string_view transport_protocol = socket.detectedTransportProtocol();
 
   // Match on exact transport protocol, e.g. "tls".
   const auto transport_protocol_match = transport_protocols_map.find(transport_protocol);
@@ -663,31 +699,27 @@ const Network::FilterChain* FilterChainManagerImpl::findFilterChainForApplicatio
   for (const auto& application_protocol : socket.requestedApplicationProtocols()) {
     const auto application_protocol_match = application_protocols_map.find(application_protocol);
     if (application_protocol_match != application_protocols_map.end()) {
-      return findFilterChainForDirectSourceIP(*application_protocol_match->second.second, socket);
+      return findFilterChainForDirectSourceIP(application_protocol_match->second, socket);
     }
   }
 
   // Match on a filter chain without application protocol requirements.
   const auto any_protocol_match = application_protocols_map.find(EMPTY_STRING);
   if (any_protocol_match != application_protocols_map.end()) {
-    return findFilterChainForDirectSourceIP(*any_protocol_match->second.second, socket);
+    return findFilterChainForDirectSourceIP(any_protocol_match->second, socket);
   }
 
   return nullptr;
 }
 
 const Network::FilterChain* FilterChainManagerImpl::findFilterChainForDirectSourceIP(
-    const DirectSourceIPsTrie& direct_source_ips_trie,
+    const DirectSourceIPsPair& direct_source_ips_pair,
     const Network::ConnectionSocket& socket) const {
-  auto address = socket.connectionInfoProvider().directRemoteAddress();
-  if (address->type() != Network::Address::Type::Ip) {
-    address = FilterChain::fakeAddress();
-  }
-
-  const auto& data = direct_source_ips_trie.getData(address);
-  if (!data.empty()) {
-    ASSERT(data.size() == 1);
-    return findFilterChainForSourceTypes(*data.back(), socket);
+  const auto source_types = findIpsMatch(direct_source_ips_pair.first,
+                                         direct_source_ips_pair.second.get(),
+                                         socket.connectionInfoProvider().directRemoteAddress());
+  if (source_types != nullptr) {
+    return findFilterChainForSourceTypes(*source_types, socket);
   }
 
   return nullptr;
@@ -710,39 +742,35 @@ const Network::FilterChain* FilterChainManagerImpl::findFilterChainForSourceType
 
   if (is_local_connection) {
     if (!filter_chain_local.first.empty()) {
-      return findFilterChainForSourceIpAndPort(*filter_chain_local.second, socket);
+      return findFilterChainForSourceIpAndPort(filter_chain_local, socket);
     }
   } else {
     if (!filter_chain_external.first.empty()) {
-      return findFilterChainForSourceIpAndPort(*filter_chain_external.second, socket);
+      return findFilterChainForSourceIpAndPort(filter_chain_external, socket);
     }
   }
 
   const auto& filter_chain_any = source_types[envoy::config::listener::v3::FilterChainMatch::ANY];
 
   if (!filter_chain_any.first.empty()) {
-    return findFilterChainForSourceIpAndPort(*filter_chain_any.second, socket);
+    return findFilterChainForSourceIpAndPort(filter_chain_any, socket);
   } else {
     return nullptr;
   }
 }
 
 const Network::FilterChain* FilterChainManagerImpl::findFilterChainForSourceIpAndPort(
-    const SourceIPsTrie& source_ips_trie, const Network::ConnectionSocket& socket) const {
-  auto address = socket.connectionInfoProvider().remoteAddress();
-  if (address->type() != Network::Address::Type::Ip) {
-    address = FilterChain::fakeAddress();
-  }
-
-  // Match on both: exact IP and wider CIDR ranges using LcTrie.
-  const auto& data = source_ips_trie.getData(address);
-  if (data.empty()) {
+    const SourceIPsPair& source_ips_pair, const Network::ConnectionSocket& socket) const {
+  const auto& address = socket.connectionInfoProvider().remoteAddress();
+  const auto source_ports_map_ptr =
+      findIpsMatch(source_ips_pair.first, source_ips_pair.second.get(), address);
+  if (source_ports_map_ptr == nullptr) {
     return nullptr;
   }
 
-  ASSERT(data.size() == 1);
-  const auto& source_ports_map = *data.back();
-  const uint32_t source_port = address->ip()->port();
+  const auto& source_ports_map = *source_ports_map_ptr;
+  const uint32_t source_port =
+      address->type() == Network::Address::Type::Ip ? address->ip()->port() : 0;
   const auto port_match = source_ports_map.find(source_port);
 
   // Did we get a direct hit on port.
@@ -762,23 +790,23 @@ const Network::FilterChain* FilterChainManagerImpl::findFilterChainForSourceIpAn
 }
 
 absl::Status FilterChainManagerImpl::convertIPsToTries() {
+  const bool all_ip_families_supported =
+      Network::SocketInterfaceSingleton::get().ipFamilySupported(AF_INET) &&
+      Network::SocketInterfaceSingleton::get().ipFamilySupported(AF_INET6);
+
   for (auto& [destination_port, destination_ips_pair] : destination_ports_map_) {
     UNREFERENCED_PARAMETER(destination_port);
-    // These variables are used as we build up the destination CIDRs used for the trie.
     auto& [destination_ips_map, destination_ips_trie] = destination_ips_pair;
-    std::vector<std::pair<ServerNamesMapSharedPtr, std::vector<Network::Address::CidrRange>>>
-        destination_ips_list;
-    destination_ips_list.reserve(destination_ips_map.size());
-
-    for (const auto& [destination_ip, server_names_map_ptr] : destination_ips_map) {
-      absl::Status creation_status = absl::OkStatus();
-      destination_ips_list.push_back(
-          makeCidrListEntry(destination_ip, server_names_map_ptr, creation_status));
-      RETURN_IF_NOT_OK(creation_status);
-
-      // This hugely nested for loop greatly pains me, but I'm not sure how to make it better.
-      // We need to get access to all of the source IP strings so that we can convert them into
-      // a trie like we did for the destination IPs above.
+    auto destination_ips_trie_or_error =
+        buildIpsTrie(destination_ips_map, all_ip_families_supported);
+    RETURN_IF_NOT_OK_REF(destination_ips_trie_or_error.status());
+    destination_ips_trie = std::move(*destination_ips_trie_or_error);
+
+    // This hugely nested for loop greatly pains me, but I'm not sure how to make it better.
+    // We need to get access to all of the source IP strings so that we can convert them into
+    // a trie like we did for the destination IPs above.
+    for (auto& [destination_ip, server_names_map_ptr] : destination_ips_map) {
+      UNREFERENCED_PARAMETER(destination_ip);
       for (auto& [server_name, transport_protocols_map] : *server_names_map_ptr) {
         UNREFERENCED_PARAMETER(server_name);
         for (auto& [transport_protocol, application_protocols_map] : transport_protocols_map) {
@@ -786,40 +814,24 @@ absl::Status FilterChainManagerImpl::convertIPsToTries() {
           for (auto& [application_protocol, direct_source_ips_pair] : application_protocols_map) {
             UNREFERENCED_PARAMETER(application_protocol);
             auto& [direct_source_ips_map, direct_source_ips_trie] = direct_source_ips_pair;
-
-            std::vector<
-                std::pair<SourceTypesArraySharedPtr, std::vector<Network::Address::CidrRange>>>
-                direct_source_ips_list;
-            direct_source_ips_list.reserve(direct_source_ips_map.size());
+            auto direct_source_ips_trie_or_error =
+                buildIpsTrie(direct_source_ips_map, all_ip_families_supported);
+            RETURN_IF_NOT_OK_REF(direct_source_ips_trie_or_error.status());
+            direct_source_ips_trie = std::move(*direct_source_ips_trie_or_error);
 
             for (auto& [direct_source_ip, source_arrays_ptr] : direct_source_ips_map) {
-              direct_source_ips_list.push_back(
-                  makeCidrListEntry(direct_source_ip, source_arrays_ptr, creation_status));
-              RETURN_IF_NOT_OK(creation_status);
-
+              UNREFERENCED_PARAMETER(direct_source_ip);
               for (auto& [source_ips_map, source_ips_trie] : *source_arrays_ptr) {
-                std::vector<
-                    std::pair<SourcePortsMapSharedPtr, std::vector<Network::Address::CidrRange>>>
-                    source_ips_list;
-                source_ips_list.reserve(source_ips_map.size());
-
-                for (auto& [source_ip, source_port_map_ptr] : source_ips_map) {
-                  source_ips_list.push_back(
-                      makeCidrListEntry(source_ip, source_port_map_ptr, creation_status));
-                  RETURN_IF_NOT_OK(creation_status);
-                }
-
-                source_ips_trie = std::make_unique<SourceIPsTrie>(source_ips_list, true);
+                auto source_ips_trie_or_error =
+                    buildIpsTrie(source_ips_map, all_ip_families_supported);
+                RETURN_IF_NOT_OK_REF(source_ips_trie_or_error.status());
+                source_ips_trie = std::move(*source_ips_trie_or_error);
               }
             }
-            direct_source_ips_trie =
-                std::make_unique<DirectSourceIPsTrie>(direct_source_ips_list, true);
           }
         }
       }
     }
-
-    destination_ips_trie = std::make_unique<DestinationIPsTrie>(destination_ips_list, true);
   }
   return absl::OkStatus();
 }
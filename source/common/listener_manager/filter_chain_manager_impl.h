@@ -237,7 +237,11 @@ private:
   using SourceIPsMap = absl::flat_hash_map<std::string, SourcePortsMapSharedPtr>;
   using SourceIPsTrie = Network::LcTrie::LcTrie<SourcePortsMapSharedPtr>;
   using SourceIPsTriePtr = std::unique_ptr<SourceIPsTrie>;
-  using SourceTypesArray = std::array<std::pair<SourceIPsMap, SourceIPsTriePtr>, 3>;
+  // The trie of an IP map is only built if the map has entries other than a catch-all entry, as
+  // a map with only a catch-all entry matches any address. This skips building the tries of all
+  // the filter chains without IP requirements, e.g. the ones matching on server names only.
+  using SourceIPsPair = std::pair<SourceIPsMap, SourceIPsTriePtr>;
+  using SourceTypesArray = std::array<SourceIPsPair, 3>;
   using SourceTypesArraySharedPtr = std::shared_ptr<SourceTypesArray>;
   using DirectSourceIPsMap = absl::flat_hash_map<std::string, SourceTypesArraySharedPtr>;
   using DirectSourceIPsTrie = Network::LcTrie::LcTrie<SourceTypesArraySharedPtr>;
@@ -261,8 +265,8 @@ private:
   using DestinationIPsMap = absl::flat_hash_map<std::string, ServerNamesMapSharedPtr>;
   using DestinationIPsTrie = Network::LcTrie::LcTrie<ServerNamesMapSharedPtr>;
   using DestinationIPsTriePtr = std::unique_ptr<DestinationIPsTrie>;
-  using DestinationPortsMap =
-      absl::flat_hash_map<uint16_t, std::pair<DestinationIPsMap, DestinationIPsTriePtr>>;
+  using DestinationIPsPair = std::pair<DestinationIPsMap, DestinationIPsTriePtr>;
+  using DestinationPortsMap = absl::flat_hash_map<uint16_t, DestinationIPsPair>;
 
   absl::Status
   verifyNoDuplicateMatchers(const xds::type::matcher::v3::Matcher* filter_chain_matcher,
@@ -334,7 +338,7 @@ private:
                                             const Network::FilterChainSharedPtr& filter_chain);
 
   const Network::FilterChain*
-  findFilterChainForDestinationIP(const DestinationIPsTrie& destination_ips_trie,
+  findFilterChainForDestinationIP(const DestinationIPsPair& destination_ips_pair,
                                   const Network::ConnectionSocket& socket) const;
   const Network::FilterChain*
   findFilterChainForServerName(const ServerNamesMap& server_names_map,
@@ -346,14 +350,14 @@ private:
   findFilterChainForApplicationProtocols(const ApplicationProtocolsMap& application_protocols_map,
                                          const Network::ConnectionSocket& socket) const;
   const Network::FilterChain*
-  findFilterChainForDirectSourceIP(const DirectSourceIPsTrie& direct_source_ips_trie,
+  findFilterChainForDirectSourceIP(const DirectSourceIPsPair& direct_source_ips_pair,
                                    const Network::ConnectionSocket& socket) const;
   const Network::FilterChain*
   findFilterChainForSourceTypes(const SourceTypesArray& source_types,
                                 const Network::ConnectionSocket& socket) const;
 
   const Network::FilterChain*
-  findFilterChainForSourceIpAndPort(const SourceIPsTrie& source_ips_trie,
+  findFilterChainForSourceIpAndPort(const SourceIPsPair& source_ips_pair,
                                     const Network::ConnectionSocket& socket) const;
 
   const FilterChainManagerImpl* getOriginFilterChainManager() { return origin_.value(); }
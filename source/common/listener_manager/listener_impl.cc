@@ -2,6 +2,7 @@
 
 #include <functional>
 
+#include "envoy/config/bootstrap/v3/bootstrap.pb.h"
 #include "envoy/config/core/v3/base.pb.h"
 #include "envoy/config/listener/v3/listener.pb.h"
 #include "envoy/config/listener/v3/listener_components.pb.h"
@@ -545,7 +546,7 @@ ListenerImpl::buildInternalListener(const envoy::config::listener::v3::Listener&
         config.enable_mptcp() ||
         config.has_enable_reuse_port() // internal listener doesn't use physical l4 port.
         || (config.has_freebind() && config.freebind().value()) || config.has_tcp_backlog_size() ||
-        config.has_tcp_fast_open_queue_length() ||
+        config.has_tcp_fast_open_queue_length() || config.reuse_port_cpu_steering() ||
         (config.has_transparent() && config.transparent().value())) {
       return absl::InvalidArgumentError(fmt::format(
           "error adding listener named '{}': has unsupported tcp listener feature", name_));
@@ -667,6 +668,9 @@ void ListenerImpl::buildListenSocketOptions(
         address_opts_list) {
   listen_socket_options_list_.insert(listen_socket_options_list_.begin(), addresses_.size(),
                                      nullptr);
+  const auto& bootstrap = listener_factory_context_->serverFactoryContext().bootstrap();
+  const bool has_hybrid_polling = bootstrap.dispatcher_options().has_worker_hybrid_polling();
+  const auto& hybrid_polling = bootstrap.dispatcher_options().worker_hybrid_polling();
   for (std::vector<std::reference_wrapper<
            const Protobuf::RepeatedPtrField<envoy::config::core::v3::SocketOption>&>>::size_type i =
            0;
@@ -688,6 +692,27 @@ void ListenerImpl::buildListenSocketOptions(
     if (reuse_port_) {
       addListenSocketOptions(listen_socket_options_list_[i],
                              Network::SocketOptionFactory::buildReusePortOptions());
+      // The sockets of the reuse port group are listened on in worker order, so the socket
+      // selected by the program belongs to the worker with the same index.
+      if (config.reuse_port_cpu_steering() && socket_type_ == Network::Socket::Type::Stream &&
+          parent_.server_.options().concurrency() > 1) {
+        addListenSocketOptions(listen_socket_options_list_[i],
+                               Network::SocketOptionFactory::buildReusePortCpuSteeringOptions(
+                                   parent_.server_.options().concurrency()));
+      }
+    }
+    if (has_hybrid_polling) {
+      // The sockets of accepted connections inherit the busy poll options of the listen socket.
+      addListenSocketOptions(
+          listen_socket_options_list_[i],
+          Network::SocketOptionFactory::buildBusyPollOptions(
+              hybrid_polling.has_socket_busy_poll_us()
+                  ? absl::make_optional(hybrid_polling.socket_busy_poll_us().value())
+                  : absl::nullopt,
+              hybrid_polling.socket_prefer_busy_poll(),
+              hybrid_polling.has_socket_busy_poll_budget()
+                  ? absl::make_optional(hybrid_polling.socket_busy_poll_budget().value())
+                  : absl::nullopt));
     }
     if (!address_opts_list[i].get().empty()) {
       addListenSocketOptions(
@@ -1201,7 +1226,8 @@ bool ListenerMessageUtil::socketOptionsEqual(const envoy::config::listener::v3::
       (PROTOBUF_GET_WRAPPED_OR_DEFAULT(lhs, freebind, false) !=
        PROTOBUF_GET_WRAPPED_OR_DEFAULT(rhs, freebind, false)) ||
       (PROTOBUF_GET_WRAPPED_OR_DEFAULT(lhs, tcp_fast_open_queue_length, 0) !=
-       PROTOBUF_GET_WRAPPED_OR_DEFAULT(rhs, tcp_fast_open_queue_length, 0))) {
+       PROTOBUF_GET_WRAPPED_OR_DEFAULT(rhs, tcp_fast_open_queue_length, 0)) ||
+      lhs.reuse_port_cpu_steering() != rhs.reuse_port_cpu_steering()) {
     return false;
   }
 
@@ -1,5 +1,7 @@
 #include "source/common/network/connection_balancer_impl.h"
 
+#include <thread>
+
 namespace Envoy {
 namespace Network {
 
@@ -34,5 +36,92 @@ ExactConnectionBalancerImpl::pickTargetHandler(BalancedConnectionHandler&) {
   return *min_connection_handler;
 }
 
+LoadAwareConnectionBalancerImpl::LoadAwareConnectionBalancerImpl(uint64_t connection_weight,
+                                                                 uint64_t stream_weight,
+                                                                 uint64_t busy_weight,
+                                                                 uint32_t busy_threshold_permille)
+    : connection_weight_(connection_weight), stream_weight_(stream_weight),
+      busy_weight_(busy_weight), busy_threshold_permille_(busy_threshold_permille),
+      handlers_owner_(std::make_unique<const HandlerList>()), handlers_(handlers_owner_.get()) {}
+
+void LoadAwareConnectionBalancerImpl::registerHandler(BalancedConnectionHandler& handler) {
+  Event::DispatcherLoad* dispatcher_load = handler.dispatcherLoad();
+  if (dispatcher_load != nullptr) {
+    if (busy_weight_ > 0 || busy_threshold_permille_ < 1000) {
+      dispatcher_load->enableBusyTracking();
+    }
+    if (stream_weight_ > 0) {
+      dispatcher_load->enableStreamTracking();
+    }
+  }
+  absl::MutexLock lock(lock_);
+  auto handlers = std::make_unique<HandlerList>(*handlers_owner_);
+  handlers->push_back(&handler);
+  publish(std::move(handlers));
+}
+
+void LoadAwareConnectionBalancerImpl::unregisterHandler(BalancedConnectionHandler& handler) {
+  absl::MutexLock lock(lock_);
+  auto handlers = std::make_unique<HandlerList>(*handlers_owner_);
+  handlers->erase(std::find(handlers->begin(), handlers->end(), &handler));
+  publish(std::move(handlers));
+}
+
+void LoadAwareConnectionBalancerImpl::publish(std::unique_ptr<const HandlerList>&& handlers) {
+  handlers_.store(handlers.get());
+  const uint32_t previous_epoch = epoch_.load();
+  epoch_.store(previous_epoch ^ 1);
+  // A picker that read the previous list registered in the previous epoch before reading it, so
+  // the list is no longer in use once the previous epoch has no pickers.
+  while (pickers_[previous_epoch].load() != 0) {
+    std::this_thread::yield();
+  }
+  handlers_owner_ = std::move(handlers);
+}
+
+LoadAwareConnectionBalancerImpl::Load
+LoadAwareConnectionBalancerImpl::load(BalancedConnectionHandler& handler) const {
+  uint64_t score = connection_weight_ * handler.numConnections();
+  bool hot = false;
+  const Event::DispatcherLoad* dispatcher_load = handler.dispatcherLoad();
+  if (dispatcher_load != nullptr) {
+    const uint32_t busy_permille = dispatcher_load->busyPermille();
+    score += stream_weight_ * dispatcher_load->activeStreams() + busy_weight_ * busy_permille;
+    hot = busy_permille >= busy_threshold_permille_;
+  }
+  return {hot, score};
+}
+
+BalancedConnectionHandler&
+LoadAwareConnectionBalancerImpl::pickTargetHandler(BalancedConnectionHandler& current_handler) {
+  // Register in the current epoch. If the epoch flipped in the meantime, a publish() may not have
+  // seen the registration, so register again in the new epoch.
+  uint32_t epoch = epoch_.load();
+  pickers_[epoch].fetch_add(1);
+  while (epoch_.load() != epoch) {
+    pickers_[epoch].fetch_sub(1);
+    epoch = epoch_.load();
+    pickers_[epoch].fetch_add(1);
+  }
+  const HandlerList& handlers = *handlers_.load();
+
+  BalancedConnectionHandler* target = &current_handler;
+  Load target_load = load(current_handler);
+  for (BalancedConnectionHandler* handler : handlers) {
+    if (handler == &current_handler) {
+      continue;
+    }
+    const Load handler_load = load(*handler);
+    if (handler_load < target_load) {
+      target = handler;
+      target_load = handler_load;
+    }
+  }
+  target->incNumConnections();
+
+  pickers_[epoch].fetch_sub(1);
+  return *target;
+}
+
 } // namespace Network
 } // namespace Envoy
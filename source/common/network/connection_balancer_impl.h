@@ -1,5 +1,10 @@
 #pragma once
 
+#include <array>
+#include <atomic>
+#include <memory>
+#include <vector>
+
 #include "envoy/config/listener/v3/listener.pb.h"
 #include "envoy/network/connection_balancer.h"
 #include "envoy/registry/registry.h"
@@ -44,6 +49,69 @@ private:
   std::vector<BalancedConnectionHandler*> handlers_ ABSL_GUARDED_BY(lock_);
 };
 
+/**
+ * Implementation of connection balancer that picks the least loaded handler without taking a lock
+ * on the accept path. The load of a handler combines the number of its connections with the number
+ * of active streams and the recent busy time of the event loop of the worker it runs on, so that
+ * workers busy with a few long lived, heavily multiplexed connections stop receiving new
+ * connections. Handlers on workers whose event loop is busier than a threshold are only picked if
+ * all workers are above the threshold. Ties are broken in favor of the current handler, to avoid
+ * needlessly handing the connection to another worker.
+ *
+ * The registered handlers are published as an immutable list which pickTargetHandler() reads
+ * without locking. Registering or unregistering a handler replaces the list and waits for the
+ * pickers still reading the previous list before freeing it, so it may block briefly; handlers are
+ * only registered and unregistered when listeners are added to or removed from workers.
+ */
+class LoadAwareConnectionBalancerImpl : public ConnectionBalancer {
+public:
+  /**
+   * @param connection_weight supplies the weight of each connection of a handler.
+   * @param stream_weight supplies the weight of each active stream of the worker of a handler.
+   * @param busy_weight supplies the weight of each thousandth of busy time of the event loop of the
+   *        worker of a handler.
+   * @param busy_threshold_permille supplies the busy time, in thousandths, from which a worker
+   *        only receives connections if all workers do.
+   */
+  LoadAwareConnectionBalancerImpl(uint64_t connection_weight, uint64_t stream_weight,
+                                  uint64_t busy_weight, uint32_t busy_threshold_permille);
+
+  // ConnectionBalancer
+  void registerHandler(BalancedConnectionHandler& handler) override;
+  void unregisterHandler(BalancedConnectionHandler& handler) override;
+  BalancedConnectionHandler& pickTargetHandler(BalancedConnectionHandler& current_handler) override;
+
+private:
+  using HandlerList = std::vector<BalancedConnectionHandler*>;
+
+  // The load of a handler, ordered so that a smaller value is less loaded.
+  struct Load {
+    bool operator<(const Load& other) const {
+      return hot_ != other.hot_ ? !hot_ : score_ < other.score_;
+    }
+
+    bool hot_;
+    uint64_t score_;
+  };
+
+  Load load(BalancedConnectionHandler& handler) const;
+  void publish(std::unique_ptr<const HandlerList>&& handlers) ABSL_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+
+  const uint64_t connection_weight_;
+  const uint64_t stream_weight_;
+  const uint64_t busy_weight_;
+  const uint32_t busy_threshold_permille_;
+
+  absl::Mutex lock_;
+  std::unique_ptr<const HandlerList> handlers_owner_ ABSL_GUARDED_BY(lock_);
+  std::atomic<const HandlerList*> handlers_;
+  // The number of pickers in each of the two epochs. A picker registers in the current epoch
+  // before reading handlers_; publish() flips the epoch after replacing the list, and frees the
+  // previous list once no picker is left in the previous epoch.
+  std::atomic<uint32_t> epoch_{};
+  std::array<std::atomic<uint64_t>, 2> pickers_{};
+};
+
 /**
  * A NOP connection balancer implementation that always continues execution after incrementing
  * the handler's connection count.
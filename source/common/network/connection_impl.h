@@ -157,6 +157,9 @@ public:
   void setTransportSocketIsReadable() override;
   void flushWriteBuffer() override;
   TransportSocketPtr& transportSocket() { return transport_socket_; }
+  // The number of bytes read from or written to the connection which are still buffered in it.
+  uint64_t bufferedReadBytes() const { return read_buffer_->length(); }
+  uint64_t bufferedWriteBytes() const { return write_buffer_->length(); }
 
   // Obtain global next connection ID. This should only be used in tests.
   static uint64_t nextGlobalIdForTest() { return next_global_id_; }
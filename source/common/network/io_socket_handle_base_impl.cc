@@ -6,6 +6,7 @@
 
 #include "source/common/api/os_sys_calls_impl.h"
 #include "source/common/common/assert.h"
+#include "source/common/common/safe_memcpy.h"
 #include "source/common/common/utility.h"
 #include "source/common/network/address_impl.h"
 #include "source/common/network/io_socket_error_impl.h"
@@ -14,6 +15,51 @@
 
 namespace Envoy {
 namespace Network {
+namespace {
+
+constexpr int messageTypeContainsIP() {
+#ifdef IP_RECVDSTADDR
+  return IP_RECVDSTADDR;
+#else
+  return IP_PKTINFO;
+#endif
+}
+
+in_addr addressFromMessage(const cmsghdr& cmsg) {
+#ifdef IP_RECVDSTADDR
+  return *reinterpret_cast<const in_addr*>(CMSG_DATA(&cmsg));
+#else
+  auto info = reinterpret_cast<const in_pktinfo*>(CMSG_DATA(&cmsg));
+  return info->ipi_addr;
+#endif
+}
+
+template <typename T> T getUnsignedIntFromHeader(const cmsghdr& cmsg) {
+  static_assert(std::is_unsigned_v<T>, "return type must be unsigned integral");
+  T value;
+  safeMemcpyUnsafeSrc(&value, CMSG_DATA(&cmsg));
+  return value;
+}
+
+template <typename T> absl::optional<T> maybeGetUnsignedIntFromHeader(const cmsghdr& cmsg) {
+  static_assert(std::is_unsigned_v<T>, "return type must be unsigned integral");
+  switch (cmsg.cmsg_len) {
+  case CMSG_LEN(sizeof(uint8_t)):
+    return static_cast<T>(getUnsignedIntFromHeader<uint8_t>(cmsg));
+  case CMSG_LEN(sizeof(uint16_t)):
+    return static_cast<T>(getUnsignedIntFromHeader<uint16_t>(cmsg));
+  case CMSG_LEN(sizeof(uint32_t)):
+    return static_cast<T>(getUnsignedIntFromHeader<uint32_t>(cmsg));
+  case CMSG_LEN(sizeof(uint64_t)):
+    return static_cast<T>(getUnsignedIntFromHeader<uint64_t>(cmsg));
+  default:;
+  }
+  IS_ENVOY_BUG(
+      fmt::format("unexpected cmsg_len value for unsigned integer payload: {}", cmsg.cmsg_len));
+  return absl::nullopt;
+}
+
+} // namespace
 
 IoSocketHandleBaseImpl::IoSocketHandleBaseImpl(os_fd_t fd, bool socket_v6only,
                                                absl::optional<int> domain)
@@ -180,5 +226,102 @@ absl::optional<std::string> IoSocketHandleBaseImpl::interfaceName() {
   return selected_interface_name;
 }
 
+bool IoSocketHandleBaseImpl::dstAddressFromHeader(const cmsghdr& cmsg, uint32_t self_port,
+                                                  sockaddr_storage& ss, socklen_t& ss_len) {
+  if (cmsg.cmsg_type == IPV6_PKTINFO) {
+    auto info = reinterpret_cast<const in6_pktinfo*>(CMSG_DATA(&cmsg));
+    auto ipv6_addr = reinterpret_cast<sockaddr_in6*>(&ss);
+    memset(ipv6_addr, 0, sizeof(sockaddr_in6));
+    ipv6_addr->sin6_family = AF_INET6;
+    ipv6_addr->sin6_addr = info->ipi6_addr;
+    ipv6_addr->sin6_port = htons(self_port);
+    ss_len = sizeof(sockaddr_in6);
+    return true;
+  }
+
+  if (cmsg.cmsg_type == messageTypeContainsIP()) {
+    auto ipv4_addr = reinterpret_cast<sockaddr_in*>(&ss);
+    memset(ipv4_addr, 0, sizeof(sockaddr_in));
+    ipv4_addr->sin_family = AF_INET;
+    ipv4_addr->sin_addr = addressFromMessage(cmsg);
+    ipv4_addr->sin_port = htons(self_port);
+    ss_len = sizeof(sockaddr_in);
+    return true;
+  }
+
+  return false;
+}
+
+absl::optional<uint32_t>
+IoSocketHandleBaseImpl::maybeGetPacketsDroppedFromHeader([[maybe_unused]] const cmsghdr& cmsg) {
+#ifdef SO_RXQ_OVFL
+  if (cmsg.cmsg_type == SO_RXQ_OVFL) {
+    return *reinterpret_cast<const uint32_t*>(CMSG_DATA(&cmsg));
+  }
+#endif
+  return absl::nullopt;
+}
+
+absl::optional<uint16_t>
+IoSocketHandleBaseImpl::maybeGetGsoSizeFromHeader([[maybe_unused]] const cmsghdr& cmsg) {
+#ifdef UDP_GRO
+  if (cmsg.cmsg_level == SOL_UDP && cmsg.cmsg_type == UDP_GRO) {
+    return maybeGetUnsignedIntFromHeader<uint16_t>(cmsg);
+  }
+#endif
+  return absl::nullopt;
+}
+
+absl::optional<uint8_t> IoSocketHandleBaseImpl::maybeGetTosFromHeader(const cmsghdr& cmsg) {
+  if (
+#ifdef __APPLE__
+      (cmsg.cmsg_level == IPPROTO_IP && cmsg.cmsg_type == IP_RECVTOS) ||
+#else
+      (cmsg.cmsg_level == IPPROTO_IP && cmsg.cmsg_type == IP_TOS) ||
+#endif // __APPLE__
+      (cmsg.cmsg_level == IPPROTO_IPV6 && cmsg.cmsg_type == IPV6_TCLASS)) {
+    return maybeGetUnsignedIntFromHeader<uint8_t>(cmsg);
+  }
+  return absl::nullopt;
+}
+
+size_t IoSocketHandleBaseImpl::sourceAddressControlMessageSpace(const Address::Ip& self_ip) {
+  // FreeBSD only needs in_addr size, but allocates more to unify code in two platforms.
+  return self_ip.version() == Address::IpVersion::v4 ? CMSG_SPACE(sizeof(in_pktinfo))
+                                                     : CMSG_SPACE(sizeof(in6_pktinfo));
+}
+
+void IoSocketHandleBaseImpl::setSourceAddressControlMessage(const Address::Ip& self_ip,
+                                                            msghdr& message) {
+  cmsghdr* const cmsg = CMSG_FIRSTHDR(&message);
+  RELEASE_ASSERT(cmsg != nullptr, fmt::format("cbuf with size {} is not enough, cmsghdr size {}",
+                                              message.msg_controllen, sizeof(cmsghdr)));
+  if (self_ip.version() == Address::IpVersion::v4) {
+    cmsg->cmsg_level = IPPROTO_IP;
+#ifndef IP_SENDSRCADDR
+    cmsg->cmsg_len = CMSG_LEN(sizeof(in_pktinfo));
+    cmsg->cmsg_type = IP_PKTINFO;
+    auto pktinfo = reinterpret_cast<in_pktinfo*>(CMSG_DATA(cmsg));
+    pktinfo->ipi_ifindex = 0;
+#ifdef WIN32
+    pktinfo->ipi_addr.s_addr = self_ip.ipv4()->address();
+#else
+    pktinfo->ipi_spec_dst.s_addr = self_ip.ipv4()->address();
+#endif
+#else
+    cmsg->cmsg_type = IP_SENDSRCADDR;
+    cmsg->cmsg_len = CMSG_LEN(sizeof(in_addr));
+    *(reinterpret_cast<struct in_addr*>(CMSG_DATA(cmsg))).s_addr = self_ip.ipv4()->address();
+#endif
+  } else if (self_ip.version() == Address::IpVersion::v6) {
+    cmsg->cmsg_len = CMSG_LEN(sizeof(in6_pktinfo));
+    cmsg->cmsg_level = IPPROTO_IPV6;
+    cmsg->cmsg_type = IPV6_PKTINFO;
+    auto pktinfo = reinterpret_cast<in6_pktinfo*>(CMSG_DATA(cmsg));
+    pktinfo->ipi6_ifindex = 0;
+    *(reinterpret_cast<absl::uint128*>(pktinfo->ipi6_addr.s6_addr)) = self_ip.ipv6()->address();
+  }
+}
+
 } // namespace Network
 } // namespace Envoy
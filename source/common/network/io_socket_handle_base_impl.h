@@ -36,6 +36,33 @@ public:
   absl::optional<std::string> interfaceName() override;
 
 protected:
+  /**
+   * Extracts the local address a datagram was received on from an IP_PKTINFO or IPV6_PKTINFO
+   * control message.
+   * @param cmsg supplies the control message.
+   * @param self_port supplies the port the socket is bound to.
+   * @param ss supplies the storage the address is written to.
+   * @param ss_len supplies the length of the written address.
+   * @return true if the control message contained the local address.
+   */
+  static bool dstAddressFromHeader(const cmsghdr& cmsg, uint32_t self_port, sockaddr_storage& ss,
+                                   socklen_t& ss_len);
+  static absl::optional<uint32_t> maybeGetPacketsDroppedFromHeader(const cmsghdr& cmsg);
+  static absl::optional<uint16_t> maybeGetGsoSizeFromHeader(const cmsghdr& cmsg);
+  static absl::optional<uint8_t> maybeGetTosFromHeader(const cmsghdr& cmsg);
+
+  /**
+   * @return the control message space needed to send a datagram from the given local address.
+   */
+  static size_t sourceAddressControlMessageSpace(const Address::Ip& self_ip);
+
+  /**
+   * Fills the first control message of the message with the local address to send from. The
+   * control buffer of the message must be zeroed and at least
+   * sourceAddressControlMessageSpace(self_ip) bytes long.
+   */
+  static void setSourceAddressControlMessage(const Address::Ip& self_ip, msghdr& message);
+
   os_fd_t fd_;
   int socket_v6only_;
   const absl::optional<int> domain_;
@@ -6,7 +6,6 @@
 
 #include "source/common/api/os_sys_calls_impl.h"
 #include "source/common/buffer/buffer_impl.h"
-#include "source/common/common/safe_memcpy.h"
 #include "source/common/common/utility.h"
 #include "source/common/event/file_event_impl.h"
 #include "source/common/network/address_impl.h"
@@ -22,23 +21,6 @@ namespace Envoy {
 
 namespace {
 
-constexpr int messageTypeContainsIP() {
-#ifdef IP_RECVDSTADDR
-  return IP_RECVDSTADDR;
-#else
-  return IP_PKTINFO;
-#endif
-}
-
-in_addr addressFromMessage(const cmsghdr& cmsg) {
-#ifdef IP_RECVDSTADDR
-  return *reinterpret_cast<const in_addr*>(CMSG_DATA(&cmsg));
-#else
-  auto info = reinterpret_cast<const in_pktinfo*>(CMSG_DATA(&cmsg));
-  return info->ipi_addr;
-#endif
-}
-
 constexpr int messageTruncatedOption() {
 #if defined(__APPLE__)
   // OSX does not support passing `MSG_TRUNC` to recvmsg and recvmmsg. This does not effect
@@ -182,45 +164,13 @@ Api::IoCallUint64Result IoSocketHandleImpl::sendmsg(const Buffer::RawSlice* slic
     const Api::SysCallSizeResult result = os_syscalls.sendmsg(fd_, &message, flags);
     return sysCallResultToIoCallResult(result);
   } else {
-    const size_t space_v6 = CMSG_SPACE(sizeof(in6_pktinfo));
-    const size_t space_v4 = CMSG_SPACE(sizeof(in_pktinfo));
-
-    // FreeBSD only needs in_addr size, but allocates more to unify code in two platforms.
-    const size_t cmsg_space = (self_ip->version() == Address::IpVersion::v4) ? space_v4 : space_v6;
-    // kSpaceForIp should be big enough to hold both IPv4 and IPv6 packet info.
+    const size_t cmsg_space = sourceAddressControlMessageSpace(*self_ip);
     absl::FixedArray<char> cbuf(cmsg_space);
     memset(cbuf.begin(), 0, cmsg_space);
 
     message.msg_control = cbuf.begin();
     message.msg_controllen = cmsg_space;
-    cmsghdr* const cmsg = CMSG_FIRSTHDR(&message);
-    RELEASE_ASSERT(cmsg != nullptr, fmt::format("cbuf with size {} is not enough, cmsghdr size {}",
-                                                sizeof(cbuf), sizeof(cmsghdr)));
-    if (self_ip->version() == Address::IpVersion::v4) {
-      cmsg->cmsg_level = IPPROTO_IP;
-#ifndef IP_SENDSRCADDR
-      cmsg->cmsg_len = CMSG_LEN(sizeof(in_pktinfo));
-      cmsg->cmsg_type = IP_PKTINFO;
-      auto pktinfo = reinterpret_cast<in_pktinfo*>(CMSG_DATA(cmsg));
-      pktinfo->ipi_ifindex = 0;
-#ifdef WIN32
-      pktinfo->ipi_addr.s_addr = self_ip->ipv4()->address();
-#else
-      pktinfo->ipi_spec_dst.s_addr = self_ip->ipv4()->address();
-#endif
-#else
-      cmsg->cmsg_type = IP_SENDSRCADDR;
-      cmsg->cmsg_len = CMSG_LEN(sizeof(in_addr));
-      *(reinterpret_cast<struct in_addr*>(CMSG_DATA(cmsg))).s_addr = self_ip->ipv4()->address();
-#endif
-    } else if (self_ip->version() == Address::IpVersion::v6) {
-      cmsg->cmsg_len = CMSG_LEN(sizeof(in6_pktinfo));
-      cmsg->cmsg_level = IPPROTO_IPV6;
-      cmsg->cmsg_type = IPV6_PKTINFO;
-      auto pktinfo = reinterpret_cast<in6_pktinfo*>(CMSG_DATA(cmsg));
-      pktinfo->ipi6_ifindex = 0;
-      *(reinterpret_cast<absl::uint128*>(pktinfo->ipi6_addr.s6_addr)) = self_ip->ipv6()->address();
-    }
+    setSourceAddressControlMessage(*self_ip, message);
     const Api::SysCallSizeResult result = os_syscalls.sendmsg(fd_, &message, flags);
     if (result.return_value_ < 0 && result.errno_ == SOCKET_ERROR_INVAL) {
       ENVOY_LOG(error, fmt::format("EINVAL error. Socket is open: {}, IPv{}.", isOpen(),
@@ -257,75 +207,12 @@ IoSocketHandleImpl::getOrCreateEnvoyAddressInstance(sockaddr_storage ss, socklen
 
 Address::InstanceConstSharedPtr
 IoSocketHandleImpl::maybeGetDstAddressFromHeader(const cmsghdr& cmsg, uint32_t self_port) {
-  if (cmsg.cmsg_type == IPV6_PKTINFO) {
-    auto info = reinterpret_cast<const in6_pktinfo*>(CMSG_DATA(&cmsg));
-    sockaddr_storage ss;
-    auto ipv6_addr = reinterpret_cast<sockaddr_in6*>(&ss);
-    memset(ipv6_addr, 0, sizeof(sockaddr_in6));
-    ipv6_addr->sin6_family = AF_INET6;
-    ipv6_addr->sin6_addr = info->ipi6_addr;
-    ipv6_addr->sin6_port = htons(self_port);
-    return getOrCreateEnvoyAddressInstance(ss, sizeof(sockaddr_in6));
-  }
-
-  if (cmsg.cmsg_type == messageTypeContainsIP()) {
-    sockaddr_storage ss;
-    auto ipv4_addr = reinterpret_cast<sockaddr_in*>(&ss);
-    memset(ipv4_addr, 0, sizeof(sockaddr_in));
-    ipv4_addr->sin_family = AF_INET;
-    ipv4_addr->sin_addr = addressFromMessage(cmsg);
-    ipv4_addr->sin_port = htons(self_port);
-    return getOrCreateEnvoyAddressInstance(ss, sizeof(sockaddr_in));
-  }
-
-  return nullptr;
-}
-
-absl::optional<uint32_t> maybeGetPacketsDroppedFromHeader([[maybe_unused]] const cmsghdr& cmsg) {
-#ifdef SO_RXQ_OVFL
-  if (cmsg.cmsg_type == SO_RXQ_OVFL) {
-    return *reinterpret_cast<const uint32_t*>(CMSG_DATA(&cmsg));
-  }
-#endif
-  return absl::nullopt;
-}
-
-template <typename T> T getUnsignedIntFromHeader(const cmsghdr& cmsg) {
-  static_assert(std::is_unsigned_v<T>, "return type must be unsigned integral");
-  T value;
-  safeMemcpyUnsafeSrc(&value, CMSG_DATA(&cmsg));
-  return value;
-}
-
-template <typename T> absl::optional<T> maybeGetUnsignedIntFromHeader(const cmsghdr& cmsg) {
-  static_assert(std::is_unsigned_v<T>, "return type must be unsigned integral");
-  switch (cmsg.cmsg_len) {
-  case CMSG_LEN(sizeof(uint8_t)):
-    return static_cast<T>(getUnsignedIntFromHeader<uint8_t>(cmsg));
-  case CMSG_LEN(sizeof(uint16_t)):
-    return static_cast<T>(getUnsignedIntFromHeader<uint16_t>(cmsg));
-  case CMSG_LEN(sizeof(uint32_t)):
-    return static_cast<T>(getUnsignedIntFromHeader<uint32_t>(cmsg));
-  case CMSG_LEN(sizeof(uint64_t)):
-    return static_cast<T>(getUnsignedIntFromHeader<uint64_t>(cmsg));
-  default:;
-  }
-  IS_ENVOY_BUG(
-      fmt::format("unexpected cmsg_len value for unsigned integer payload: {}", cmsg.cmsg_len));
-  return absl::nullopt;
-}
-
-absl::optional<uint8_t> maybeGetTosFromHeader(const cmsghdr& cmsg) {
-  if (
-#ifdef __APPLE__
-      (cmsg.cmsg_level == IPPROTO_IP && cmsg.cmsg_type == IP_RECVTOS) ||
-#else
-      (cmsg.cmsg_level == IPPROTO_IP && cmsg.cmsg_type == IP_TOS) ||
-#endif // __APPLE__
-      (cmsg.cmsg_level == IPPROTO_IPV6 && cmsg.cmsg_type == IPV6_TCLASS)) {
-    return maybeGetUnsignedIntFromHeader<uint8_t>(cmsg);
+  sockaddr_storage ss;
+  socklen_t ss_len;
+  if (!dstAddressFromHeader(cmsg, self_port, ss, ss_len)) {
+    return nullptr;
   }
-  return absl::nullopt;
+  return getOrCreateEnvoyAddressInstance(ss, ss_len);
 }
 
 Api::IoCallUint64Result IoSocketHandleImpl::recvmsg(Buffer::RawSlice* slices,
@@ -405,14 +292,10 @@ Api::IoCallUint64Result IoSocketHandleImpl::recvmsg(Buffer::RawSlice* slices,
           continue;
         }
       }
-#ifdef UDP_GRO
-      if (cmsg->cmsg_level == SOL_UDP && cmsg->cmsg_type == UDP_GRO) {
-        absl::optional<uint16_t> maybe_gso = maybeGetUnsignedIntFromHeader<uint16_t>(*cmsg);
-        if (maybe_gso) {
-          output.msg_[0].gso_size_ = *maybe_gso;
-        }
+      absl::optional<uint16_t> maybe_gso = maybeGetGsoSizeFromHeader(*cmsg);
+      if (maybe_gso) {
+        output.msg_[0].gso_size_ = *maybe_gso;
       }
-#endif
       absl::optional<uint8_t> maybe_tos = maybeGetTosFromHeader(*cmsg);
       if (maybe_tos) {
         output.msg_[0].tos_ = *maybe_tos;
@@ -13,16 +13,17 @@
 #include "source/common/network/io_socket_handle_impl.h"
 #include "source/common/network/socket_interface_impl.h"
 
+#include "absl/container/fixed_array.h"
+
 namespace Envoy {
 namespace Network {
 
 IoUringSocketHandleImpl::IoUringSocketHandleImpl(Io::IoUringWorkerFactory& io_uring_worker_factory,
                                                  os_fd_t fd, bool socket_v6only,
-                                                 absl::optional<int> domain, bool is_server_socket)
+                                                 absl::optional<int> domain,
+                                                 IoUringSocketType socket_type)
     : IoSocketHandleBaseImpl(fd, socket_v6only, domain),
-      io_uring_worker_factory_(io_uring_worker_factory),
-      io_uring_socket_type_(is_server_socket ? IoUringSocketType::Server
-                                             : IoUringSocketType::Unknown) {
+      io_uring_worker_factory_(io_uring_worker_factory), io_uring_socket_type_(socket_type) {
   ENVOY_LOG(trace, "construct io uring socket handle, fd = {}, type = {}", fd_,
             ioUringSocketTypeStr());
 }
@@ -127,26 +128,105 @@ Api::IoCallUint64Result IoUringSocketHandleImpl::write(Buffer::Instance& buffer)
   return {buffer_size, IoSocketError::none()};
 }
 
-Api::IoCallUint64Result IoUringSocketHandleImpl::sendmsg(const Buffer::RawSlice*, uint64_t, int,
-                                                         const Address::Ip*,
-                                                         const Address::Instance&) {
+Api::IoCallUint64Result IoUringSocketHandleImpl::sendmsg(const Buffer::RawSlice* slices,
+                                                         uint64_t num_slice, int flags,
+                                                         const Address::Ip* self_ip,
+                                                         const Address::Instance& peer_address) {
   ENVOY_LOG(trace, "sendmsg, fd = {}, type = {}", fd_, ioUringSocketTypeStr());
-  return Network::IoSocketError::ioResultSocketInvalidAddress();
+
+  if (io_uring_socket_type_ != IoUringSocketType::Datagram) {
+    return Network::IoSocketError::ioResultSocketInvalidAddress();
+  }
+
+  const size_t control_size = self_ip != nullptr ? sourceAddressControlMessageSpace(*self_ip) : 0;
+  absl::FixedArray<char> control(control_size);
+  memset(control.data(), 0, control_size);
+  msghdr message{};
+  if (self_ip != nullptr) {
+    message.msg_control = control.data();
+    message.msg_controllen = control_size;
+    setSourceAddressControlMessage(*self_ip, message);
+  }
+
+  if (!io_uring_socket_.has_value()) {
+    // The socket is added to the io_uring worker with its file event, send directly until then.
+    absl::FixedArray<iovec> iov(num_slice);
+    for (uint64_t i = 0; i < num_slice; i++) {
+      iov[i].iov_base = slices[i].mem_;
+      iov[i].iov_len = slices[i].len_;
+    }
+    message.msg_name = const_cast<sockaddr*>(peer_address.sockAddr());
+    message.msg_namelen = peer_address.sockAddrLen();
+    message.msg_iov = iov.data();
+    message.msg_iovlen = num_slice;
+    const Api::SysCallSizeResult result =
+        Api::OsSysCallsSingleton::get().sendmsg(fd_, &message, flags);
+    if (result.return_value_ < 0) {
+      return {0, result.errno_ == SOCKET_ERROR_AGAIN ? IoSocketError::getIoSocketEagainError()
+                                                     : IoSocketError::create(result.errno_)};
+    }
+    return {static_cast<uint64_t>(result.return_value_), IoSocketError::none()};
+  }
+
+  // The flags are not used by the datagram senders and are not supported by io_uring sends.
+  ASSERT(flags == 0);
+  const int32_t result = io_uring_socket_->sendmsg(
+      slices, num_slice, peer_address, absl::string_view(control.data(), control_size));
+  if (result < 0) {
+    return {0, result == -EAGAIN ? IoSocketError::getIoSocketEagainError()
+                                 : IoSocketError::create(-result)};
+  }
+  return {static_cast<uint64_t>(result), IoSocketError::none()};
 }
 
-Api::IoCallUint64Result IoUringSocketHandleImpl::recvmsg(Buffer::RawSlice*, const uint64_t,
-                                                         uint32_t,
-                                                         const IoHandle::UdpSaveCmsgConfig&,
-                                                         RecvMsgOutput&) {
+Api::IoCallUint64Result
+IoUringSocketHandleImpl::recvmsg(Buffer::RawSlice* slices, const uint64_t num_slice,
+                                 uint32_t self_port,
+                                 const IoHandle::UdpSaveCmsgConfig& udp_save_cmsg_config,
+                                 RecvMsgOutput& output) {
   ENVOY_LOG(trace, "recvmsg, fd = {}, type = {}", fd_, ioUringSocketTypeStr());
-  return Network::IoSocketError::ioResultSocketInvalidAddress();
+
+  if (io_uring_socket_type_ != IoUringSocketType::Datagram) {
+    return Network::IoSocketError::ioResultSocketInvalidAddress();
+  }
+  ASSERT(!output.msg_.empty());
+
+  absl::optional<Io::ReceivedDatagram> datagram =
+      io_uring_socket_.has_value() ? io_uring_socket_->takeDatagram() : absl::nullopt;
+  if (!datagram.has_value()) {
+    return Api::IoCallUint64Result{0, IoSocketError::getIoSocketEagainError()};
+  }
+  const uint64_t length = copyOutDatagram(*datagram, slices, num_slice, self_port,
+                                          udp_save_cmsg_config, output, 0);
+  return {length, IoSocketError::none()};
 }
 
-Api::IoCallUint64Result IoUringSocketHandleImpl::recvmmsg(RawSliceArrays&, uint32_t,
-                                                          const IoHandle::UdpSaveCmsgConfig&,
-                                                          RecvMsgOutput&) {
+Api::IoCallUint64Result
+IoUringSocketHandleImpl::recvmmsg(RawSliceArrays& slices, uint32_t self_port,
+                                  const IoHandle::UdpSaveCmsgConfig& udp_save_cmsg_config,
+                                  RecvMsgOutput& output) {
   ENVOY_LOG(trace, "recvmmsg, fd = {}, type = {}", fd_, ioUringSocketTypeStr());
-  return Network::IoSocketError::ioResultSocketInvalidAddress();
+
+  if (io_uring_socket_type_ != IoUringSocketType::Datagram) {
+    return Network::IoSocketError::ioResultSocketInvalidAddress();
+  }
+  ASSERT(output.msg_.size() == slices.size());
+
+  // The datagrams received by the io_uring socket are already batched, take as many as fit.
+  uint64_t num_packets_read = 0;
+  while (io_uring_socket_.has_value() && num_packets_read < slices.size()) {
+    absl::optional<Io::ReceivedDatagram> datagram = io_uring_socket_->takeDatagram();
+    if (!datagram.has_value()) {
+      break;
+    }
+    copyOutDatagram(*datagram, slices[num_packets_read].data(), slices[num_packets_read].size(),
+                    self_port, udp_save_cmsg_config, output, num_packets_read);
+    num_packets_read++;
+  }
+  if (num_packets_read == 0) {
+    return Api::IoCallUint64Result{0, IoSocketError::getIoSocketEagainError()};
+  }
+  return {num_packets_read, IoSocketError::none()};
 }
 
 Api::IoCallUint64Result IoUringSocketHandleImpl::recv(void* buffer, size_t length, int flags) {
@@ -192,12 +272,19 @@ IoHandlePtr IoUringSocketHandleImpl::accept(struct sockaddr* addr, socklen_t* ad
     return nullptr;
   }
   return std::make_unique<IoUringSocketHandleImpl>(io_uring_worker_factory_, result.return_value_,
-                                                   socket_v6only_, domain_, true);
+                                                   socket_v6only_, domain_,
+                                                   IoUringSocketType::Server);
 }
 
 Api::SysCallIntResult IoUringSocketHandleImpl::connect(Address::InstanceConstSharedPtr address) {
   ENVOY_LOG(trace, "connect, fd = {}, type = {}", fd_, ioUringSocketTypeStr());
 
+  // Connecting a datagram socket only sets its default peer, which completes right away.
+  if (io_uring_socket_type_ == IoUringSocketType::Datagram) {
+    return Api::OsSysCallsSingleton::get().connect(fd_, address->sockAddr(),
+                                                   address->sockAddrLen());
+  }
+
   ASSERT(io_uring_socket_type_ == IoUringSocketType::Client);
 
   io_uring_socket_->connect(address);
@@ -227,9 +314,11 @@ IoHandlePtr IoUringSocketHandleImpl::duplicate() {
   RELEASE_ASSERT(result.return_value_ != -1,
                  fmt::format("duplicate failed for '{}': ({}) {}", fd_, result.errno_,
                              errorDetails(result.errno_)));
-  return SocketInterfaceImpl::makePlatformSpecificSocket(result.return_value_, socket_v6only_,
-                                                         domain_, Network::SocketCreationOptions{},
-                                                         &io_uring_worker_factory_);
+  return SocketInterfaceImpl::makePlatformSpecificSocket(
+      result.return_value_, socket_v6only_, domain_, Network::SocketCreationOptions{},
+      &io_uring_worker_factory_,
+      io_uring_socket_type_ == IoUringSocketType::Datagram ? Socket::Type::Datagram
+                                                           : Socket::Type::Stream);
 }
 
 void IoUringSocketHandleImpl::initializeFileEvent(Event::Dispatcher& dispatcher,
@@ -268,6 +357,11 @@ void IoUringSocketHandleImpl::initializeFileEvent(Event::Dispatcher& dispatcher,
         wait_cv.wait(mutex);
       }
 
+      if (io_uring_socket_type_ == IoUringSocketType::Datagram) {
+        io_uring_socket_ =
+            io_uring_worker_factory_.getIoUringWorker()->addDatagramSocket(fd, std::move(cb));
+        return;
+      }
       // Move the temporary buf to the newly created one.
       io_uring_socket_ = io_uring_worker_factory_.getIoUringWorker()->addServerSocket(
           fd, buf, std::move(cb), events & Event::FileReadyType::Closed);
@@ -283,6 +377,10 @@ void IoUringSocketHandleImpl::initializeFileEvent(Event::Dispatcher& dispatcher,
     io_uring_socket_ = io_uring_worker_factory_.getIoUringWorker()->addServerSocket(
         fd_, std::move(cb), events & Event::FileReadyType::Closed);
     break;
+  case IoUringSocketType::Datagram:
+    io_uring_socket_ =
+        io_uring_worker_factory_.getIoUringWorker()->addDatagramSocket(fd_, std::move(cb));
+    break;
   case IoUringSocketType::Unknown:
   case IoUringSocketType::Client:
     io_uring_socket_type_ = IoUringSocketType::Client;
@@ -419,5 +517,80 @@ Api::IoCallUint64Result IoUringSocketHandleImpl::copyOut(uint64_t max_length,
   return {num_bytes_to_read, IoSocketError::none()};
 }
 
+uint64_t IoUringSocketHandleImpl::copyOutDatagram(
+    Io::ReceivedDatagram& datagram, Buffer::RawSlice* slices, uint64_t num_slice,
+    uint32_t self_port, const IoHandle::UdpSaveCmsgConfig& udp_save_cmsg_config,
+    RecvMsgOutput& output, size_t index) {
+  RecvMsgPerPacketInfo& info = output.msg_[index];
+  datagrams_dropped_ += datagram.dropped_;
+
+  uint64_t slices_length = 0;
+  for (uint64_t i = 0; i < num_slice; i++) {
+    slices_length += slices[i].len_;
+  }
+  const uint64_t length = datagram.buffer_->length();
+  if (datagram.truncated_ || length > slices_length) {
+    ENVOY_LOG_MISC(debug, "Dropping truncated UDP packet with size: {}.", length);
+    if (output.dropped_packets_ != nullptr) {
+      *output.dropped_packets_ += datagram.dropped_ + 1;
+    }
+    info.truncated_and_dropped_ = true;
+    return 0;
+  }
+
+  datagram.buffer_->copyOutToSlices(length, slices, num_slice);
+  info.msg_len_ = length;
+  RELEASE_ASSERT(datagram.peer_address_len_ > 0,
+                 fmt::format("Unable to get remote address from recvmsg() for fd: {}", fd_));
+  info.peer_address_ = Address::addressFromSockAddrOrDie(
+      datagram.peer_address_, datagram.peer_address_len_, fd_, socket_v6only_);
+  info.gso_size_ = 0;
+
+  // Get overflow, local address, gso_size and tos from the control messages, in the same way as
+  // IoSocketHandleImpl does.
+  bool overflow_reported = false;
+  msghdr hdr{};
+  hdr.msg_control = datagram.control_.data();
+  hdr.msg_controllen = datagram.control_.size();
+  for (struct cmsghdr* cmsg = CMSG_FIRSTHDR(&hdr); cmsg != nullptr;
+       cmsg = CMSG_NXTHDR(&hdr, cmsg)) {
+    if (udp_save_cmsg_config.hasConfig() &&
+        cmsg->cmsg_type == static_cast<int>(udp_save_cmsg_config.type.value()) &&
+        cmsg->cmsg_level == static_cast<int>(udp_save_cmsg_config.level.value())) {
+      Buffer::OwnedImpl cmsg_slice{CMSG_DATA(cmsg), cmsg->cmsg_len};
+      info.saved_cmsg_ = std::move(cmsg_slice);
+    }
+    if (info.local_address_ == nullptr) {
+      sockaddr_storage ss;
+      socklen_t ss_len;
+      if (dstAddressFromHeader(*cmsg, self_port, ss, ss_len)) {
+        // This is a IP packet info message.
+        info.local_address_ = Address::addressFromSockAddrOrDie(ss, ss_len, fd_, socket_v6only_);
+        continue;
+      }
+    }
+    if (output.dropped_packets_ != nullptr) {
+      absl::optional<uint32_t> maybe_dropped = maybeGetPacketsDroppedFromHeader(*cmsg);
+      if (maybe_dropped) {
+        *output.dropped_packets_ = *maybe_dropped + datagrams_dropped_;
+        overflow_reported = true;
+        continue;
+      }
+    }
+    absl::optional<uint16_t> maybe_gso = maybeGetGsoSizeFromHeader(*cmsg);
+    if (maybe_gso) {
+      info.gso_size_ = *maybe_gso;
+    }
+    absl::optional<uint8_t> maybe_tos = maybeGetTosFromHeader(*cmsg);
+    if (maybe_tos) {
+      info.tos_ = *maybe_tos;
+    }
+  }
+  if (output.dropped_packets_ != nullptr && !overflow_reported) {
+    *output.dropped_packets_ += datagram.dropped_;
+  }
+  return length;
+}
+
 } // namespace Network
 } // namespace Envoy
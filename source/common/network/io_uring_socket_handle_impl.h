@@ -22,6 +22,7 @@ enum class IoUringSocketType {
   Accept,
   Server,
   Client,
+  Datagram,
 };
 
 /**
@@ -32,7 +33,7 @@ public:
   IoUringSocketHandleImpl(Io::IoUringWorkerFactory& io_uring_worker_factory,
                           os_fd_t fd = INVALID_SOCKET, bool socket_v6only = false,
                           absl::optional<int> domain = absl::nullopt,
-                          bool is_server_socket = false);
+                          IoUringSocketType socket_type = IoUringSocketType::Unknown);
   ~IoUringSocketHandleImpl() override;
 
   Api::IoCallUint64Result close() override;
@@ -77,6 +78,8 @@ protected:
       return "client";
     case IoUringSocketType::Server:
       return "server";
+    case IoUringSocketType::Datagram:
+      return "datagram";
     }
     PANIC_DUE_TO_CORRUPT_ENUM;
   }
@@ -91,6 +94,17 @@ protected:
   absl::optional<Api::IoCallUint64Result> checkWriteResult() const;
   Api::IoCallUint64Result copyOut(uint64_t max_length, Buffer::RawSlice* slices,
                                   uint64_t num_slice);
+  // Copies a received datagram to the slices and fills the packet info at the given index of the
+  // output from the datagram's control messages. Returns the size of the datagram, or 0 if the
+  // datagram was truncated and dropped.
+  uint64_t copyOutDatagram(Io::ReceivedDatagram& datagram, Buffer::RawSlice* slices,
+                           uint64_t num_slice, uint32_t self_port,
+                           const IoHandle::UdpSaveCmsgConfig& udp_save_cmsg_config,
+                           RecvMsgOutput& output, size_t index);
+
+  // The number of datagrams dropped by the io_uring socket since its queue was full, which is
+  // reported on top of the kernel's SO_RXQ_OVFL count.
+  uint32_t datagrams_dropped_{0};
 };
 
 } // namespace Network
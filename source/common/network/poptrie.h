@@ -0,0 +1,396 @@
+#pragma once
+
+#include <climits>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "envoy/common/platform.h"
+#include "envoy/network/address.h"
+
+#include "source/common/common/assert.h"
+#include "source/common/network/address_impl.h"
+#include "source/common/network/cidr_range.h"
+#include "source/common/network/utility.h"
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/container/node_hash_set.h"
+#include "absl/numeric/bits.h"
+#include "absl/numeric/int128.h"
+
+namespace Envoy {
+namespace Network {
+namespace Poptrie {
+
+/**
+ * Default number of leading address bits resolved by the direct pointing table at the root of a
+ * Poptrie holding many prefixes of an IP version.
+ */
+constexpr uint32_t DefaultDirectPointingBits = 16;
+
+/**
+ * Minimum number of prefixes of an IP version for which the direct pointing table is used. Below
+ * this, the table would be much larger than the rest of the trie.
+ */
+constexpr size_t MinPrefixesForDirectPointing = 4096;
+
+/**
+ * Poptrie for associating data with CIDR ranges. It has the same interface and match semantics as
+ * Network::LcTrie::LcTrie, so either can be used by consumers, but it is built and looked up
+ * differently:
+ *  - it has no limit on the number of prefixes, and is built in a single pass over a binary trie
+ *    of the prefixes, without sorting them.
+ *  - a lookup resolves 6 bits of the address per node, with a 64 bit bitmap of the internal
+ *    children of the node and a 64 bit bitmap of the runs of identical leaves among its other
+ *    children. The index of the next node or of the leaf is the population count of the bitmap up
+ *    to the extracted bits, so the nodes hold no pointers and the lookup of an IPv4 address reads
+ *    at most 6 nodes of 24 bytes (3 with direct pointing). Matches are never verified against the
+ *    prefix, unlike with an LC trie which skips bits.
+ *  - for large tries, the leading bits of the address are resolved with a single read of a direct
+ *    pointing table.
+ *
+ * The algorithm is described in the paper 'Poptrie: A Compressed Trie with Population Count for
+ * Fast and Scalable Software IP Routing Table Lookup' by 'H. Asai' and 'Y. Ohara'.
+ */
+template <class T> class Poptrie {
+public:
+  /**
+   * @param data supplies a vector of data and CIDR ranges.
+   * @param exclusive if true then only data for the most specific subnet will be returned
+   *                  (i.e. data isn't inherited from wider ranges).
+   * @param direct_pointing_bits supplies the number of leading address bits resolved by the direct
+   *                             pointing table, for the IP versions with at least
+   *                             MinPrefixesForDirectPointing prefixes.
+   */
+  Poptrie(const std::vector<std::pair<T, std::vector<Address::CidrRange>>>& data,
+          bool exclusive = false, uint32_t direct_pointing_bits = DefaultDirectPointingBits) {
+    ASSERT(direct_pointing_bits <= 24);
+    BinaryTrie<Ipv4> ipv4_temp;
+    BinaryTrie<Ipv6> ipv6_temp;
+    for (const auto& pair_data : data) {
+      for (const auto& cidr_range : pair_data.second) {
+        if (cidr_range.ip()->version() == Address::IpVersion::v4) {
+          ipv4_temp.insert(ntohl(cidr_range.ip()->ipv4()->address()), cidr_range.length(),
+                           pair_data.first);
+        } else {
+          ipv6_temp.insert(Utility::Ip6ntohl(cidr_range.ip()->ipv6()->address()),
+                           cidr_range.length(), pair_data.first);
+        }
+      }
+    }
+
+    ipv4_trie_ = std::make_unique<PoptrieInternal<Ipv4>>(ipv4_temp, exclusive,
+                                                         direct_pointing_bits);
+    ipv6_trie_ = std::make_unique<PoptrieInternal<Ipv6>>(ipv6_temp, exclusive,
+                                                         direct_pointing_bits);
+  }
+
+  /**
+   * Retrieve data associated with the CIDR range that contains `ip_address`. Both IPv4 and IPv6
+   * addresses are supported.
+   * @param  ip_address supplies the IP address.
+   * @return a vector of data from the CIDR ranges and IP addresses that contains 'ip_address'. An
+   * empty vector is returned if no prefix contains 'ip_address' or there is no data for the IP
+   * version of the ip_address.
+   */
+  std::vector<T> getData(const Network::Address::InstanceConstSharedPtr& ip_address) const {
+    if (ip_address->ip()->version() == Address::IpVersion::v4) {
+      return ipv4_trie_->getData(ntohl(ip_address->ip()->ipv4()->address()));
+    } else {
+      return ipv6_trie_->getData(Utility::Ip6ntohl(ip_address->ip()->ipv6()->address()));
+    }
+  }
+
+private:
+  // IP addresses are stored in host byte order.
+  using Ipv4 = uint32_t;
+  using Ipv6 = absl::uint128;
+
+  using DataSet = absl::node_hash_set<T>;
+  using DataSetSharedPtr = std::shared_ptr<DataSet>;
+
+  // The number of address bits resolved by each node.
+  static constexpr uint32_t Stride = 6;
+
+  /**
+   * Extract n bits from input starting at position p. Bits past the end of the address are
+   * extracted as zeros.
+   */
+  template <class IpType, uint32_t address_size = CHAR_BIT * sizeof(IpType)>
+  static uint32_t extractBits(uint32_t p, uint32_t n, IpType input) {
+    if (n == 0) {
+      return 0;
+    }
+    return static_cast<uint32_t>(input << p >> (address_size - n));
+  }
+
+  /**
+   * Binary trie of the prefixes, used to build the Poptrie. Nodes are held in a vector and refer
+   * to their children by index, as a binary trie of a large table has several million nodes.
+   */
+  template <class IpType, uint32_t address_size = CHAR_BIT * sizeof(IpType)> class BinaryTrie {
+  public:
+    BinaryTrie() : nodes_(1) {}
+
+    /**
+     * Add a CIDR prefix and associated data to the binary trie.
+     */
+    void insert(IpType ip, uint32_t length, const T& data) {
+      uint32_t node = 0;
+      for (uint32_t i = 0; i < length; i++) {
+        const uint32_t bit = extractBits<IpType, address_size>(i, 1, ip);
+        if (nodes_[node].children_[bit] == 0) {
+          nodes_[node].children_[bit] = nodes_.size();
+          nodes_.emplace_back();
+        }
+        node = nodes_[node].children_[bit];
+      }
+      if (nodes_[node].data_ == nullptr) {
+        nodes_[node].data_ = std::make_shared<DataSet>();
+      }
+      nodes_[node].data_->insert(data);
+      ++num_prefixes_;
+    }
+
+    struct Node {
+      // Index of the children of the node, 0 if there is none as the root is no child.
+      uint32_t children_[2]{};
+      DataSetSharedPtr data_;
+    };
+
+    std::vector<Node> nodes_;
+    size_t num_prefixes_{};
+  };
+
+  template <class IpType, uint32_t address_size = CHAR_BIT * sizeof(IpType)>
+  class PoptrieInternal {
+  public:
+    PoptrieInternal(BinaryTrie<IpType, address_size>& binary_trie, bool exclusive,
+                    uint32_t direct_pointing_bits);
+
+    /**
+     * Retrieve the data associated with the CIDR range that contains `ip_address`.
+     * @param  ip_address supplies the IP address in host byte order.
+     * @return a vector of data from the CIDR ranges and IP addresses that encompasses the input.
+     */
+    std::vector<T> getData(const IpType& ip_address) const;
+
+  private:
+    using BinaryNode = typename BinaryTrie<IpType, address_size>::Node;
+
+    // An entry of the direct pointing table is the index of a node, or of a data set if
+    // LeafFlag is set.
+    static constexpr uint32_t LeafFlag = 1U << 31;
+
+    struct Node {
+      // Bit i is set if child i is an internal node.
+      uint64_t vector_;
+      // Bit i is set if child i is the first leaf of a run of leaves with the same data, ignoring
+      // the internal nodes in between.
+      uint64_t leafvec_;
+      // Index of the first leaf of the node in leaves_.
+      uint32_t base0_;
+      // Index of the first internal child of the node in nodes_.
+      uint32_t base1_;
+    };
+
+    /**
+     * Pushes the data of the binary trie to its leaves, so that each internal node has two
+     * children and the data of a leaf is the data of the most specific prefix containing it, or
+     * of all the prefixes containing it if not exclusive.
+     */
+    void pushLeaves(std::vector<BinaryNode>& binary_nodes, uint32_t node,
+                    const DataSetSharedPtr& data, bool exclusive);
+
+    /**
+     * @return the index of the data set of the leaf of the binary trie in data_.
+     */
+    uint32_t leafData(const BinaryNode& leaf);
+
+    /**
+     * @return the node of the binary trie reached by following the n first bits of bits from
+     *         node, stopping early at a leaf.
+     */
+    static uint32_t descend(const std::vector<BinaryNode>& binary_nodes, uint32_t node,
+                            uint32_t bits, uint32_t n) {
+      for (uint32_t i = 0; i < n; i++) {
+        const BinaryNode& current = binary_nodes[node];
+        if (current.children_[0] == 0) {
+          break;
+        }
+        node = current.children_[(bits >> (n - 1 - i)) & 1];
+      }
+      return node;
+    }
+
+    /**
+     * Builds nodes_[index] from the sub-trie of the binary trie rooted at node.
+     */
+    void buildNode(const std::vector<BinaryNode>& binary_nodes, uint32_t node, uint32_t index);
+
+    uint32_t direct_pointing_bits_{};
+    // Empty if there are no prefixes for the IP version.
+    std::vector<uint32_t> direct_;
+    std::vector<Node> nodes_;
+    // The index of the data set of each leaf in data_.
+    std::vector<uint32_t> leaves_;
+    // Data sets of the leaves. The first one is empty, for the addresses no prefix contains.
+    std::vector<std::vector<T>> data_;
+    // Index in data_ of the data sets shared by several leaves of the binary trie.
+    absl::flat_hash_map<const DataSet*, uint32_t> data_index_;
+    const DataSet* last_data_set_{};
+    uint32_t last_data_index_{};
+  };
+
+  std::unique_ptr<PoptrieInternal<Ipv4>> ipv4_trie_;
+  std::unique_ptr<PoptrieInternal<Ipv6>> ipv6_trie_;
+};
+
+template <class T>
+template <class IpType, uint32_t address_size>
+Poptrie<T>::PoptrieInternal<IpType, address_size>::PoptrieInternal(
+    BinaryTrie<IpType, address_size>& binary_trie, bool exclusive, uint32_t direct_pointing_bits)
+    : data_(1) {
+  if (binary_trie.num_prefixes_ == 0) {
+    return;
+  }
+  std::vector<BinaryNode>& binary_nodes = binary_trie.nodes_;
+  pushLeaves(binary_nodes, 0, nullptr, exclusive);
+
+  if (binary_trie.num_prefixes_ >= MinPrefixesForDirectPointing) {
+    direct_pointing_bits_ = direct_pointing_bits;
+  }
+  direct_.resize(1U << direct_pointing_bits_);
+  for (uint32_t bits = 0; bits < direct_.size(); bits++) {
+    const uint32_t node = descend(binary_nodes, 0, bits, direct_pointing_bits_);
+    if (binary_nodes[node].children_[0] == 0) {
+      direct_[bits] = LeafFlag | leafData(binary_nodes[node]);
+    } else {
+      direct_[bits] = nodes_.size();
+      nodes_.emplace_back();
+      buildNode(binary_nodes, node, direct_[bits]);
+    }
+  }
+  // The data sets of the binary trie are released once the Poptrie is built.
+  data_index_.clear();
+  last_data_set_ = nullptr;
+  nodes_.shrink_to_fit();
+  leaves_.shrink_to_fit();
+}
+
+template <class T>
+template <class IpType, uint32_t address_size>
+void Poptrie<T>::PoptrieInternal<IpType, address_size>::pushLeaves(
+    std::vector<BinaryNode>& binary_nodes, uint32_t node, const DataSetSharedPtr& data,
+    bool exclusive) {
+  // Inherit any data set by ancestor nodes.
+  if (data != nullptr) {
+    if (binary_nodes[node].data_ == nullptr) {
+      binary_nodes[node].data_ = data;
+    } else if (!exclusive) {
+      binary_nodes[node].data_->insert(data->begin(), data->end());
+    }
+  }
+  // Give a node with a single child a second one, which inherits the data of the node.
+  for (uint32_t bit : {0, 1}) {
+    if (binary_nodes[node].children_[bit] == 0 && binary_nodes[node].children_[bit ^ 1] != 0) {
+      binary_nodes[node].children_[bit] = binary_nodes.size();
+      binary_nodes.emplace_back();
+    }
+  }
+  if (binary_nodes[node].children_[0] != 0) {
+    // binary_nodes is not resized past this point of the recursion into a child, as the child
+    // has been created above if needed.
+    const DataSetSharedPtr node_data = binary_nodes[node].data_;
+    pushLeaves(binary_nodes, binary_nodes[node].children_[0], node_data, exclusive);
+    pushLeaves(binary_nodes, binary_nodes[node].children_[1], node_data, exclusive);
+  }
+}
+
+template <class T>
+template <class IpType, uint32_t address_size>
+uint32_t Poptrie<T>::PoptrieInternal<IpType, address_size>::leafData(const BinaryNode& leaf) {
+  if (leaf.data_ == nullptr || leaf.data_->empty()) {
+    return 0;
+  }
+  // Neighbouring leaves mostly inherit the same data set.
+  if (leaf.data_.get() == last_data_set_) {
+    return last_data_index_;
+  }
+  auto it = data_index_.find(leaf.data_.get());
+  if (it == data_index_.end()) {
+    data_.emplace_back(leaf.data_->begin(), leaf.data_->end());
+    it = data_index_.emplace(leaf.data_.get(), data_.size() - 1).first;
+  }
+  last_data_set_ = it->first;
+  last_data_index_ = it->second;
+  return last_data_index_;
+}
+
+template <class T>
+template <class IpType, uint32_t address_size>
+void Poptrie<T>::PoptrieInternal<IpType, address_size>::buildNode(
+    const std::vector<BinaryNode>& binary_nodes, uint32_t node, uint32_t index) {
+  constexpr uint32_t NumChildren = 1U << Stride;
+  uint32_t children[NumChildren];
+  uint64_t vector = 0;
+  uint64_t leafvec = 0;
+  uint32_t num_internal = 0;
+  const uint32_t base0 = leaves_.size();
+  for (uint32_t i = 0; i < NumChildren; i++) {
+    children[i] = descend(binary_nodes, node, i, Stride);
+    if (binary_nodes[children[i]].children_[0] != 0) {
+      vector |= uint64_t(1) << i;
+      ++num_internal;
+      continue;
+    }
+    // Consecutive leaves with the same data share a single entry of leaves_.
+    const uint32_t leaf_data = leafData(binary_nodes[children[i]]);
+    if (leaves_.size() == base0 || leaves_.back() != leaf_data) {
+      leafvec |= uint64_t(1) << i;
+      leaves_.push_back(leaf_data);
+    }
+  }
+
+  const uint32_t base1 = nodes_.size();
+  nodes_[index] = Node{vector, leafvec, base0, base1};
+  nodes_.resize(nodes_.size() + num_internal);
+  uint32_t child_index = base1;
+  for (uint32_t i = 0; i < NumChildren; i++) {
+    if (vector & (uint64_t(1) << i)) {
+      buildNode(binary_nodes, children[i], child_index++);
+    }
+  }
+}
+
+template <class T>
+template <class IpType, uint32_t address_size>
+std::vector<T>
+Poptrie<T>::PoptrieInternal<IpType, address_size>::getData(const IpType& ip_address) const {
+  if (direct_.empty()) {
+    return {};
+  }
+  uint32_t entry = direct_[extractBits<IpType, address_size>(0, direct_pointing_bits_, ip_address)];
+  if (entry & LeafFlag) {
+    return data_[entry & ~LeafFlag];
+  }
+
+  uint32_t position = direct_pointing_bits_;
+  const Node* node = &nodes_[entry];
+  while (true) {
+    const uint64_t bit = uint64_t(1) << extractBits<IpType, address_size>(position, Stride,
+                                                                            ip_address);
+    // The mask of the bits up to and including the extracted one. It is all ones for the last
+    // bit, as the shift then wraps to 0.
+    const uint64_t mask = (bit << 1) - 1;
+    if ((node->vector_ & bit) == 0) {
+      return data_[leaves_[node->base0_ + absl::popcount(node->leafvec_ & mask) - 1]];
+    }
+    node = &nodes_[node->base1_ + absl::popcount(node->vector_ & mask) - 1];
+    position += Stride;
+  }
+}
+
+} // namespace Poptrie
+} // namespace Network
+} // namespace Envoy
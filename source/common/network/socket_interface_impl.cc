@@ -36,7 +36,8 @@ void DefaultSocketInterfaceExtension::onWorkerThreadInitialized() {
 IoHandlePtr SocketInterfaceImpl::makePlatformSpecificSocket(
     int socket_fd, bool socket_v6only, absl::optional<int> domain,
     const SocketCreationOptions& options,
-    [[maybe_unused]] Io::IoUringWorkerFactory* io_uring_worker_factory) {
+    [[maybe_unused]] Io::IoUringWorkerFactory* io_uring_worker_factory,
+    [[maybe_unused]] Socket::Type socket_type) {
   if constexpr (Event::PlatformDefaultTriggerType == Event::FileTriggerType::EmulatedEdge) {
     return std::make_unique<Win32SocketHandleImpl>(socket_fd, socket_v6only, domain);
   }
@@ -45,8 +46,10 @@ IoHandlePtr SocketInterfaceImpl::makePlatformSpecificSocket(
   // been registered in the TLS, initialized. There are cases that test may create threads before
   // IoUringWorkerFactory has been added to the TLS and got initialized.
   if (hasIoUringWorkerFactory(io_uring_worker_factory)) {
-    return std::make_unique<IoUringSocketHandleImpl>(*io_uring_worker_factory, socket_fd,
-                                                     socket_v6only, domain);
+    return std::make_unique<IoUringSocketHandleImpl>(
+        *io_uring_worker_factory, socket_fd, socket_v6only, domain,
+        socket_type == Socket::Type::Datagram ? IoUringSocketType::Datagram
+                                              : IoUringSocketType::Unknown);
   }
 #endif
   return std::make_unique<IoSocketHandleImpl>(socket_fd, socket_v6only, domain,
@@ -56,11 +59,11 @@ IoHandlePtr SocketInterfaceImpl::makePlatformSpecificSocket(
 IoHandlePtr SocketInterfaceImpl::makeSocket(int socket_fd, bool socket_v6only,
                                             Socket::Type socket_type, absl::optional<int> domain,
                                             const SocketCreationOptions& options) const {
-  if (socket_type == Socket::Type::Datagram) {
+  if (socket_type == Socket::Type::Datagram && !io_uring_datagram_sockets_) {
     return makePlatformSpecificSocket(socket_fd, socket_v6only, domain, options, nullptr);
   }
   return makePlatformSpecificSocket(socket_fd, socket_v6only, domain, options,
-                                    io_uring_worker_factory_.lock().get());
+                                    io_uring_worker_factory_.lock().get(), socket_type);
 }
 
 IoHandlePtr SocketInterfaceImpl::socket(Socket::Type socket_type, Address::Type addr_type,
@@ -173,14 +176,23 @@ Server::BootstrapExtensionPtr SocketInterfaceImpl::createBootstrapExtension(
       config, context.messageValidationVisitor());
   if (message.has_io_uring_options() && Io::isIoUringSupported()) {
     const auto& options = message.io_uring_options();
+    uint32_t zero_copy_send_threshold =
+        PROTOBUF_GET_WRAPPED_OR_DEFAULT(options, zero_copy_send_threshold, 0);
+    if (zero_copy_send_threshold > 0 && !Io::isIoUringSendZcSupported()) {
+      ENVOY_LOG_MISC(warn, "io_uring zero-copy send is not supported by the kernel, falling back "
+                           "to copying sends");
+      zero_copy_send_threshold = 0;
+    }
     std::shared_ptr<Io::IoUringWorkerFactoryImpl> io_uring_worker_factory =
         std::make_shared<Io::IoUringWorkerFactoryImpl>(
             PROTOBUF_GET_WRAPPED_OR_DEFAULT(options, io_uring_size, 1000),
             options.enable_submission_queue_polling(),
             PROTOBUF_GET_WRAPPED_OR_DEFAULT(options, read_buffer_size, 8192),
             PROTOBUF_GET_WRAPPED_OR_DEFAULT(options, write_timeout_ms, 1000),
-            context.threadLocal());
+            zero_copy_send_threshold, PROTOBUF_GET_WRAPPED_OR_DEFAULT(options, buffer_ring_size, 0),
+            context.serverScope(), context.threadLocal());
     io_uring_worker_factory_ = io_uring_worker_factory;
+    io_uring_datagram_sockets_ = options.enable_datagram_sockets();
 
     return std::make_unique<DefaultSocketInterfaceExtension>(*this, io_uring_worker_factory);
   } else {
@@ -44,7 +44,8 @@ public:
   static IoHandlePtr
   makePlatformSpecificSocket(int socket_fd, bool socket_v6only, absl::optional<int> domain,
                              const SocketCreationOptions& options,
-                             Io::IoUringWorkerFactory* io_uring_worker_factory = nullptr);
+                             Io::IoUringWorkerFactory* io_uring_worker_factory = nullptr,
+                             Socket::Type socket_type = Socket::Type::Stream);
 
 protected:
   virtual IoHandlePtr makeSocket(int socket_fd, bool socket_v6only, Socket::Type socket_type,
@@ -53,6 +54,8 @@ protected:
 
 private:
   std::weak_ptr<Io::IoUringWorkerFactory> io_uring_worker_factory_;
+  // Whether datagram sockets are handled by io_uring as well.
+  bool io_uring_datagram_sockets_{false};
 };
 
 DECLARE_FACTORY(SocketInterfaceImpl);
@@ -7,6 +7,10 @@
 #include "source/common/network/socket_option_impl.h"
 #include "source/common/network/win32_redirect_records_option_impl.h"
 
+#if defined(__linux__)
+#include <linux/filter.h>
+#endif
+
 namespace Envoy {
 namespace Network {
 
@@ -154,6 +158,57 @@ std::unique_ptr<Socket::Options> SocketOptionFactory::buildReusePortOptions() {
   return options;
 }
 
+#if defined(SO_ATTACH_REUSEPORT_CBPF) && defined(__linux__)
+namespace {
+
+// Holds the BPF program referenced by the option value of a ReusePortCpuSteeringOptionImpl. It is
+// a base class so that the program is constructed before, and outlives, the option.
+class ReusePortCpuSteeringProgram {
+protected:
+  explicit ReusePortCpuSteeringProgram(uint32_t concurrency) {
+    // SPELLCHECKER(off)
+    filter_ = {
+        {0x20, 0, 0, static_cast<uint32_t>(SKF_AD_OFF + SKF_AD_CPU)}, // ld #cpu
+        {0x94, 0, 0, concurrency},                                    // mod #socket_count
+        {0x16, 0, 0, 0000000000},                                     // ret a
+    };
+    // SPELLCHECKER(on)
+    prog_.len = filter_.size();
+    prog_.filter = filter_.data();
+  }
+
+  std::vector<sock_filter> filter_;
+  sock_fprog prog_;
+};
+
+class ReusePortCpuSteeringOptionImpl : private ReusePortCpuSteeringProgram,
+                                       public SocketOptionImpl {
+public:
+  explicit ReusePortCpuSteeringOptionImpl(uint32_t concurrency)
+      : ReusePortCpuSteeringProgram(concurrency),
+        // The kernel only forms the reuse port group of TCP sockets on listen(), so the program
+        // is attached once the socket is listening.
+        SocketOptionImpl(envoy::config::core::v3::SocketOption::STATE_LISTENING,
+                         ENVOY_ATTACH_REUSEPORT_CBPF,
+                         absl::string_view(reinterpret_cast<char*>(&prog_), sizeof(prog_)),
+                         Socket::Type::Stream) {}
+};
+
+} // namespace
+#endif
+
+std::unique_ptr<Socket::Options>
+SocketOptionFactory::buildReusePortCpuSteeringOptions(uint32_t concurrency) {
+  std::unique_ptr<Socket::Options> options = std::make_unique<Socket::Options>();
+#if defined(SO_ATTACH_REUSEPORT_CBPF) && defined(__linux__)
+  ASSERT(concurrency > 0);
+  options->push_back(std::make_shared<ReusePortCpuSteeringOptionImpl>(concurrency));
+#else
+  UNREFERENCED_PARAMETER(concurrency);
+#endif
+  return options;
+}
+
 std::unique_ptr<Socket::Options> SocketOptionFactory::buildUdpGroOptions() {
   std::unique_ptr<Socket::Options> options = std::make_unique<Socket::Options>();
   options->push_back(std::make_shared<SocketOptionImpl>(
@@ -189,6 +244,28 @@ std::unique_ptr<Socket::Options> SocketOptionFactory::buildBindAddressNoPort() {
   return options;
 }
 
+std::unique_ptr<Socket::Options>
+SocketOptionFactory::buildBusyPollOptions(absl::optional<uint32_t> busy_poll_us,
+                                          bool prefer_busy_poll,
+                                          absl::optional<uint32_t> busy_poll_budget) {
+  std::unique_ptr<Socket::Options> options = std::make_unique<Socket::Options>();
+  if (busy_poll_us.has_value()) {
+    options->push_back(std::make_shared<SocketOptionImpl>(
+        envoy::config::core::v3::SocketOption::STATE_PREBIND, ENVOY_SOCKET_SO_BUSY_POLL,
+        static_cast<int>(busy_poll_us.value())));
+  }
+  if (prefer_busy_poll) {
+    options->push_back(std::make_shared<SocketOptionImpl>(
+        envoy::config::core::v3::SocketOption::STATE_PREBIND, ENVOY_SOCKET_SO_PREFER_BUSY_POLL, 1));
+  }
+  if (busy_poll_budget.has_value()) {
+    options->push_back(std::make_shared<SocketOptionImpl>(
+        envoy::config::core::v3::SocketOption::STATE_PREBIND, ENVOY_SOCKET_SO_BUSY_POLL_BUDGET,
+        static_cast<int>(busy_poll_budget.value())));
+  }
+  return options;
+}
+
 std::unique_ptr<Socket::Options>
 SocketOptionFactory::buildDoNotFragmentOptions(bool supports_v4_mapped_v6_addresses) {
   auto options = std::make_unique<Socket::Options>();
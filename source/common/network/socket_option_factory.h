@@ -35,10 +35,24 @@ public:
   static std::unique_ptr<Socket::Options> buildIpPacketInfoOptions();
   static std::unique_ptr<Socket::Options> buildRxQueueOverFlowOptions();
   static std::unique_ptr<Socket::Options> buildReusePortOptions();
+  /**
+   * @param concurrency supplies the number of sockets in the SO_REUSEPORT group.
+   * @return options which attach a reuse port BPF program that selects the socket with the index
+   * of the CPU that processed the incoming packet, modulo concurrency. Empty if not supported.
+   */
+  static std::unique_ptr<Socket::Options> buildReusePortCpuSteeringOptions(uint32_t concurrency);
   static std::unique_ptr<Socket::Options> buildUdpGroOptions();
   static std::unique_ptr<Socket::Options> buildZeroSoLingerOptions();
   static std::unique_ptr<Socket::Options> buildIpRecvTosOptions();
   static std::unique_ptr<Socket::Options> buildBindAddressNoPort();
+  /**
+   * @param busy_poll_us supplies the value of SO_BUSY_POLL, in microseconds.
+   * @param prefer_busy_poll supplies whether to set SO_PREFER_BUSY_POLL.
+   * @param busy_poll_budget supplies the value of SO_BUSY_POLL_BUDGET, if any.
+   */
+  static std::unique_ptr<Socket::Options>
+  buildBusyPollOptions(absl::optional<uint32_t> busy_poll_us, bool prefer_busy_poll,
+                       absl::optional<uint32_t> busy_poll_budget);
   /**
    * @param supports_v4_mapped_v6_addresses true if this option is to be applied to a v6 socket with
    * v4-mapped v6 address(i.e. ::ffff:172.21.0.6) support.
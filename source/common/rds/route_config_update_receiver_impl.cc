@@ -22,6 +22,12 @@ void RouteConfigUpdateReceiverImpl::updateConfig(
   route_config_proto_ = std::move(route_config_proto);
 }
 
+void RouteConfigUpdateReceiverImpl::updateConfig(
+    std::unique_ptr<Protobuf::Message>&& route_config_proto, ConfigConstSharedPtr config) {
+  config_ = std::move(config);
+  route_config_proto_ = std::move(route_config_proto);
+}
+
 void RouteConfigUpdateReceiverImpl::onUpdateCommon(const std::string& version_info) {
   last_updated_ = time_source_.systemTime();
   config_info_.emplace(RouteConfigProvider::ConfigInfo{*route_config_proto_, version_info});
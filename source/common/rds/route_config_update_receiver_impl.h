@@ -18,6 +18,9 @@ public:
   bool checkHash(uint64_t new_hash) const { return (new_hash != last_config_hash_); }
   void updateHash(uint64_t hash) { last_config_hash_ = hash; }
   void updateConfig(std::unique_ptr<Protobuf::Message>&& route_config_proto);
+  // Same as above, with a config that the caller created from route_config_proto.
+  void updateConfig(std::unique_ptr<Protobuf::Message>&& route_config_proto,
+                    ConfigConstSharedPtr config);
   void onUpdateCommon(const std::string& version_info);
 
   // RouteConfigUpdateReceiver
@@ -0,0 +1,120 @@
+#include "source/common/router/adaptive_hedging_impl.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "source/common/protobuf/utility.h"
+
+#include "absl/numeric/bits.h"
+
+namespace Envoy {
+namespace Router {
+
+size_t LatencyQuantileEstimator::bucketIndex(uint64_t latency_us) {
+  if (latency_us < SubBuckets) {
+    return latency_us;
+  }
+  // Octave n >= 3 of [2^n, 2^(n+1)) is split into SubBuckets buckets by the SubBuckets bits below
+  // the most significant bit.
+  const size_t msb = absl::bit_width(latency_us) - 1;
+  const size_t index = (msb - 2) * SubBuckets + ((latency_us >> (msb - 3)) - SubBuckets);
+  return std::min(index, Buckets - 1);
+}
+
+uint64_t LatencyQuantileEstimator::bucketLowerBound(size_t index) {
+  if (index < SubBuckets) {
+    return index;
+  }
+  return (SubBuckets + index % SubBuckets) << (index / SubBuckets - 1);
+}
+
+void LatencyQuantileEstimator::record(std::chrono::microseconds latency) {
+  const uint64_t latency_us = std::max<int64_t>(latency.count(), 0);
+  counts_[bucketIndex(latency_us)].fetch_add(1, std::memory_order_relaxed);
+
+  const uint64_t samples = samples_.fetch_add(1, std::memory_order_relaxed) + 1;
+  if (samples % DecayInterval == 0) {
+    for (std::atomic<uint64_t>& count : counts_) {
+      count.fetch_sub(count.load(std::memory_order_relaxed) / 2, std::memory_order_relaxed);
+    }
+  }
+  if (samples % UpdateInterval == 0) {
+    update();
+  }
+}
+
+void LatencyQuantileEstimator::update() {
+  std::array<uint64_t, Buckets> counts;
+  uint64_t total = 0;
+  for (size_t i = 0; i < Buckets; i++) {
+    counts[i] = counts_[i].load(std::memory_order_relaxed);
+    total += counts[i];
+  }
+  if (total == 0) {
+    return;
+  }
+
+  const uint64_t rank = std::max<uint64_t>(std::ceil(quantile_ * total), 1);
+  uint64_t cumulative = 0;
+  for (size_t i = 0; i < Buckets; i++) {
+    cumulative += counts[i];
+    if (cumulative >= rank) {
+      // The upper bound of the bucket, so that the estimate is not below the quantile.
+      estimate_us_.store(bucketLowerBound(i + 1), std::memory_order_relaxed);
+      return;
+    }
+  }
+}
+
+absl::optional<std::chrono::microseconds> LatencyQuantileEstimator::estimate() const {
+  const uint64_t estimate_us = estimate_us_.load(std::memory_order_relaxed);
+  if (estimate_us == 0) {
+    return absl::nullopt;
+  }
+  return std::chrono::microseconds(estimate_us);
+}
+
+AdaptiveHedgingImpl::AdaptiveHedgingImpl(
+    const envoy::config::route::v3::HedgePolicy::AdaptiveHedging& adaptive_hedging)
+    : latencies_((adaptive_hedging.has_latency_percentile()
+                      ? adaptive_hedging.latency_percentile().value()
+                      : 95.0) /
+                 100.0),
+      budget_ratio_(
+          (adaptive_hedging.has_budget_percent() ? adaptive_hedging.budget_percent().value()
+                                                 : 10.0) /
+          100.0),
+      min_samples_(PROTOBUF_GET_WRAPPED_OR_DEFAULT(adaptive_hedging, min_samples, 100)),
+      min_hedge_delay_(PROTOBUF_GET_MS_OR_DEFAULT(adaptive_hedging, min_hedge_delay, 1)) {}
+
+absl::optional<std::chrono::milliseconds> AdaptiveHedgingImpl::onRequest() {
+  uint64_t requests = requests_.fetch_add(1, std::memory_order_relaxed) + 1;
+  if (requests >= BudgetInterval &&
+      requests_.compare_exchange_strong(requests, requests / 2, std::memory_order_relaxed)) {
+    hedges_.store(hedges_.load(std::memory_order_relaxed) / 2, std::memory_order_relaxed);
+  }
+
+  if (latencies_.samples() < min_samples_) {
+    return absl::nullopt;
+  }
+  const absl::optional<std::chrono::microseconds> estimate = latencies_.estimate();
+  if (!estimate.has_value()) {
+    return absl::nullopt;
+  }
+  // Timers have a resolution of milliseconds.
+  return std::max(min_hedge_delay_, std::chrono::ceil<std::chrono::milliseconds>(*estimate));
+}
+
+void AdaptiveHedgingImpl::recordLatency(std::chrono::microseconds latency) {
+  latencies_.record(latency);
+}
+
+bool AdaptiveHedgingImpl::canHedge() const {
+  return hedges_.load(std::memory_order_relaxed) <
+         budget_ratio_ * requests_.load(std::memory_order_relaxed);
+}
+
+void AdaptiveHedgingImpl::onHedge() { hedges_.fetch_add(1, std::memory_order_relaxed); }
+
+} // namespace Router
+} // namespace Envoy
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+#include "envoy/config/route/v3/route_components.pb.h"
+#include "envoy/router/router.h"
+
+#include "absl/types/optional.h"
+
+namespace Envoy {
+namespace Router {
+
+/**
+ * Thread safe estimate of a quantile of recent latencies. Latencies are counted in log-linear
+ * buckets of an eighth of an octave, so that the estimate is at most 12.5% above the latency of
+ * the quantile. The counts are halved every DecayInterval latencies, which weighs recent
+ * latencies more and lets the estimate follow changes of the latency distribution. The estimate
+ * is updated every UpdateInterval latencies rather than computed by its readers.
+ */
+class LatencyQuantileEstimator {
+public:
+  static constexpr uint64_t DecayInterval = 4096;
+  static constexpr uint64_t UpdateInterval = 32;
+
+  /**
+   * @param quantile supplies the quantile to estimate, between 0 and 1.
+   */
+  explicit LatencyQuantileEstimator(double quantile) : quantile_(quantile) {}
+
+  void record(std::chrono::microseconds latency);
+
+  /**
+   * @return the estimate of the quantile, or absl::nullopt before the first update.
+   */
+  absl::optional<std::chrono::microseconds> estimate() const;
+
+  /**
+   * @return the number of latencies recorded.
+   */
+  uint64_t samples() const { return samples_.load(std::memory_order_relaxed); }
+
+  // Exposed for testing.
+  static size_t bucketIndex(uint64_t latency_us);
+  static uint64_t bucketLowerBound(size_t index);
+
+private:
+  static constexpr size_t SubBuckets = 8;
+  // Latencies of 2^36us (about 19 hours) and above share the last bucket.
+  static constexpr size_t Buckets = 34 * SubBuckets;
+
+  void update();
+
+  const double quantile_;
+  std::array<std::atomic<uint64_t>, Buckets> counts_{};
+  std::atomic<uint64_t> samples_{};
+  std::atomic<uint64_t> estimate_us_{};
+};
+
+/**
+ * Implementation of AdaptiveHedging that reads from the proto hedge policy. The hedging budget
+ * compares the hedged requests to the requests of the route, both halved every BudgetInterval
+ * requests. Concurrent requests may exceed the budget by the number of workers.
+ */
+class AdaptiveHedgingImpl : public AdaptiveHedging {
+public:
+  static constexpr uint64_t BudgetInterval = 1000;
+
+  explicit AdaptiveHedgingImpl(
+      const envoy::config::route::v3::HedgePolicy::AdaptiveHedging& adaptive_hedging);
+
+  // Router::AdaptiveHedging
+  absl::optional<std::chrono::milliseconds> onRequest() override;
+  void recordLatency(std::chrono::microseconds latency) override;
+  bool canHedge() const override;
+  void onHedge() override;
+
+private:
+  LatencyQuantileEstimator latencies_;
+  const double budget_ratio_;
+  const uint64_t min_samples_;
+  const std::chrono::milliseconds min_hedge_delay_;
+  std::atomic<uint64_t> requests_{};
+  std::atomic<uint64_t> hedges_{};
+};
+
+} // namespace Router
+} // namespace Envoy
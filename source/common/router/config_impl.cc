@@ -243,6 +243,9 @@ std::string SslRedirector::newUri(const Http::RequestHeaderMap& headers) const {
 
 HedgePolicyImpl::HedgePolicyImpl(const envoy::config::route::v3::HedgePolicy& hedge_policy)
     : additional_request_chance_(hedge_policy.additional_request_chance()),
+      adaptive_hedging_(hedge_policy.has_adaptive_hedging()
+                            ? std::make_unique<AdaptiveHedgingImpl>(hedge_policy.adaptive_hedging())
+                            : nullptr),
       initial_requests_(PROTOBUF_GET_WRAPPED_OR_DEFAULT(hedge_policy, initial_requests, 1)),
       hedge_on_per_try_timeout_(hedge_policy.hedge_on_per_try_timeout()) {}
 
@@ -509,6 +512,8 @@ RouteEntryImplBase::RouteEntryImplBase(const CommonVirtualHostSharedPtr& vhost,
       PerFilterConfigs::create(route.typed_per_filter_config(), factory_context, validator);
   SET_AND_RETURN_IF_NOT_OK(config_or_error.status(), creation_status);
   per_filter_configs_ = std::move(config_or_error.value());
+  has_filter_disabled_overrides_ =
+      !per_filter_configs_->empty() || vhost_->hasFilterDisabledOverrides();
 
   auto policy_or_error =
       buildRetryPolicy(vhost->retryPolicy(), route.route(), validator, factory_context);
@@ -537,6 +542,13 @@ RouteEntryImplBase::RouteEntryImplBase(const CommonVirtualHostSharedPtr& vhost,
     SET_AND_RETURN_IF_NOT_OK(parser_or_error.status(), creation_status);
     response_headers_parser_ = std::move(parser_or_error.value());
   }
+  // The header parsers of the virtual host and the route configuration are configured before
+  // the routes, so that the parsers of all levels can be merged into one here.
+  const bool specificity_ascend = vhost_->globalRouteConfig().mostSpecificHeaderMutationsWins();
+  merged_request_headers_parser_ = HeaderParser::merge(getRequestHeaderParsers(specificity_ascend));
+  merged_response_headers_parser_ =
+      HeaderParser::merge(getResponseHeaderParsers(specificity_ascend));
+
   if (route.has_metadata()) {
     metadata_ = std::make_unique<RouteMetadataPack>(route.metadata());
   }
@@ -908,10 +920,15 @@ void RouteEntryImplBase::finalizeRequestHeaders(Http::RequestHeaderMap& headers,
                                                 bool keep_original_host_or_path) const {
   // Apply header transformations configured via request_headers_to_add first.
   // This is important because host/path rewriting may depend on headers added here.
-  for (const HeaderParser* header_parser : getRequestHeaderParsers(
-           /*specificity_ascend=*/vhost_->globalRouteConfig().mostSpecificHeaderMutationsWins())) {
-    // Later evaluated header parser wins.
-    header_parser->evaluateHeaders(headers, context, stream_info);
+  if (merged_request_headers_parser_ != nullptr) {
+    merged_request_headers_parser_->evaluateHeaders(headers, context, stream_info);
+  } else {
+    for (const HeaderParser* header_parser :
+         getRequestHeaderParsers(/*specificity_ascend=*/vhost_->globalRouteConfig()
+                                     .mostSpecificHeaderMutationsWins())) {
+      // Later evaluated header parser wins.
+      header_parser->evaluateHeaders(headers, context, stream_info);
+    }
   }
 
   // Restore the port if this was a CONNECT request.
@@ -935,6 +952,10 @@ void RouteEntryImplBase::finalizeRequestHeaders(Http::RequestHeaderMap& headers,
 void RouteEntryImplBase::finalizeResponseHeaders(Http::ResponseHeaderMap& headers,
                                                  const Formatter::Context& context,
                                                  const StreamInfo::StreamInfo& stream_info) const {
+  if (merged_response_headers_parser_ != nullptr) {
+    merged_response_headers_parser_->evaluateHeaders(headers, context, stream_info);
+    return;
+  }
   for (const HeaderParser* header_parser : getResponseHeaderParsers(
            /*specificity_ascend=*/vhost_->globalRouteConfig().mostSpecificHeaderMutationsWins())) {
     // Later evaluated header parser wins.
@@ -1510,7 +1531,9 @@ CommonVirtualHostImpl::CommonVirtualHostImpl(
           virtual_host, request_body_buffer_limit, std::numeric_limits<uint64_t>::max())),
       include_attempt_count_in_request_(virtual_host.include_request_attempt_count()),
       include_attempt_count_in_response_(virtual_host.include_attempt_count_in_response()),
-      include_is_timeout_retry_header_(virtual_host.include_is_timeout_retry_header()) {
+      include_is_timeout_retry_header_(virtual_host.include_is_timeout_retry_header()),
+      has_filter_disabled_overrides_(!per_filter_configs_->empty() ||
+                                     global_route_config_->hasFilterDisabledOverrides()) {
 
   if (!virtual_host.request_headers_to_add().empty() ||
       !virtual_host.request_headers_to_remove().empty()) {
@@ -1700,39 +1723,56 @@ VirtualHostImpl::VirtualHostImpl(const envoy::config::route::v3::VirtualHost& vi
       SET_AND_RETURN_IF_NOT_OK(route_or_error.status(), creation_status);
       routes_.emplace_back(route_or_error.value());
     }
+    if (Runtime::runtimeFeatureEnabled("envoy.reloadable_features.router_path_prefilter")) {
+      path_prefilter_ = RoutePathPrefilter::create(
+          virtual_host.routes(),
+          shared_virtual_host_->globalRouteConfig().ignorePathParametersInPathMatching(),
+          factory_context.regexEngine());
+    }
+  }
+}
+
+bool VirtualHostImpl::evaluateRoute(const RouteCallback& cb, const Http::RequestHeaderMap& headers,
+                                    const StreamInfo::StreamInfo& stream_info,
+                                    uint64_t random_value,
+                                    absl::Span<const RouteEntryImplBaseConstSharedPtr> routes,
+                                    size_t index, RouteConstSharedPtr& result) const {
+  RouteConstSharedPtr route_entry = routes[index]->matches(headers, stream_info, random_value);
+  if (route_entry == nullptr) {
+    return false;
+  }
+
+  if (cb == nullptr) {
+    result = std::move(route_entry);
+    return true;
   }
+
+  RouteEvalStatus eval_status = (index + 1 == routes.size()) ? RouteEvalStatus::NoMoreRoutes
+                                                             : RouteEvalStatus::HasMoreRoutes;
+  RouteMatchStatus match_status = cb(route_entry, eval_status);
+  if (match_status == RouteMatchStatus::Accept) {
+    result = std::move(route_entry);
+    return true;
+  }
+  if (match_status == RouteMatchStatus::Continue && eval_status == RouteEvalStatus::NoMoreRoutes) {
+    ENVOY_LOG(debug, "return null when route match status is Continue but there is no more routes");
+    result = nullptr;
+    return true;
+  }
+  return false;
 }
 
 RouteConstSharedPtr VirtualHostImpl::getRouteFromRoutes(
     const RouteCallback& cb, const Http::RequestHeaderMap& headers,
     const StreamInfo::StreamInfo& stream_info, uint64_t random_value,
     absl::Span<const RouteEntryImplBaseConstSharedPtr> routes) const {
-  for (auto route = routes.begin(); route != routes.end(); ++route) {
-    if (!headers.Path() && !(*route)->supportsPathlessHeaders()) {
-      continue;
-    }
-
-    RouteConstSharedPtr route_entry = (*route)->matches(headers, stream_info, random_value);
-    if (route_entry == nullptr) {
+  RouteConstSharedPtr result;
+  for (size_t index = 0; index < routes.size(); index++) {
+    if (!headers.Path() && !routes[index]->supportsPathlessHeaders()) {
       continue;
     }
-
-    if (cb == nullptr) {
-      return route_entry;
-    }
-
-    RouteEvalStatus eval_status = (std::next(route) == routes.end())
-                                      ? RouteEvalStatus::NoMoreRoutes
-                                      : RouteEvalStatus::HasMoreRoutes;
-    RouteMatchStatus match_status = cb(route_entry, eval_status);
-    if (match_status == RouteMatchStatus::Accept) {
-      return route_entry;
-    }
-    if (match_status == RouteMatchStatus::Continue &&
-        eval_status == RouteEvalStatus::NoMoreRoutes) {
-      ENVOY_LOG(debug,
-                "return null when route match status is Continue but there is no more routes");
-      return nullptr;
+    if (evaluateRoute(cb, headers, stream_info, random_value, routes, index, result)) {
+      return result;
     }
   }
 
@@ -1789,6 +1829,20 @@ RouteConstSharedPtr VirtualHostImpl::getRouteFromEntries(const RouteCallback& cb
     return nullptr;
   }
 
+  // Only the candidates of the path prefilter can match. They are evaluated in the order of the
+  // routes, and as part of all routes, so that the same route is selected and route callbacks
+  // observe the same evaluation status as without the prefilter.
+  if (path_prefilter_ != nullptr && headers.Path() != nullptr) {
+    RouteConstSharedPtr result;
+    for (const uint32_t index : path_prefilter_->candidates(headers.getPathValue())) {
+      if (evaluateRoute(cb, headers, stream_info, random_value, routes_, index, result)) {
+        return result;
+      }
+    }
+    ENVOY_LOG(debug, "route was resolved but final route list did not match incoming request");
+    return nullptr;
+  }
+
   // Check for a route that matches the request.
   return getRouteFromRoutes(cb, headers, stream_info, random_value, routes_);
 }
@@ -1818,11 +1872,12 @@ absl::StatusOr<std::unique_ptr<RouteMatcher>>
 RouteMatcher::create(const envoy::config::route::v3::RouteConfiguration& route_config,
                      const CommonConfigSharedPtr& global_route_config,
                      Server::Configuration::ServerFactoryContext& factory_context,
-                     ProtobufMessage::ValidationVisitor& validator, bool validate_clusters) {
+                     ProtobufMessage::ValidationVisitor& validator, bool validate_clusters,
+                     bool reusable, const RouteMatcher* previous_matcher) {
   absl::Status creation_status = absl::OkStatus();
-  auto ret = std::unique_ptr<RouteMatcher>{new RouteMatcher(route_config, global_route_config,
-                                                            factory_context, validator,
-                                                            validate_clusters, creation_status)};
+  auto ret = std::unique_ptr<RouteMatcher>{
+      new RouteMatcher(route_config, global_route_config, factory_context, validator,
+                       validate_clusters, reusable, previous_matcher, creation_status)};
   RETURN_IF_NOT_OK(creation_status);
   return ret;
 }
@@ -1830,16 +1885,35 @@ RouteMatcher::RouteMatcher(const envoy::config::route::v3::RouteConfiguration& r
                            const CommonConfigSharedPtr& global_route_config,
                            Server::Configuration::ServerFactoryContext& factory_context,
                            ProtobufMessage::ValidationVisitor& validator, bool validate_clusters,
+                           bool reusable, const RouteMatcher* previous_matcher,
                            absl::Status& creation_status)
     : vhost_scope_(factory_context.scope().scopeFromStatName(
           factory_context.routerContext().virtualClusterStatNames().vhost_)),
       ignore_port_in_host_matching_(route_config.ignore_port_in_host_matching()),
       vhost_header_(route_config.vhost_header()) {
+  ASSERT(reusable || previous_matcher == nullptr);
+  if (reusable) {
+    virtual_hosts_by_hash_.reserve(route_config.virtual_hosts_size());
+  }
   for (const auto& virtual_host_config : route_config.virtual_hosts()) {
-    VirtualHostImplSharedPtr virtual_host = std::make_shared<VirtualHostImpl>(
-        virtual_host_config, global_route_config, factory_context, *vhost_scope_, validator,
-        validate_clusters, creation_status);
-    SET_AND_RETURN_IF_NOT_OK(creation_status, creation_status);
+    VirtualHostImplSharedPtr virtual_host;
+    const uint64_t virtual_host_hash = reusable ? MessageUtil::hash(virtual_host_config) : 0;
+    if (previous_matcher != nullptr) {
+      const auto previous = previous_matcher->virtual_hosts_by_hash_.find(virtual_host_hash);
+      if (previous != previous_matcher->virtual_hosts_by_hash_.end()) {
+        virtual_host = previous->second;
+        virtual_hosts_reused_++;
+      }
+    }
+    if (virtual_host == nullptr) {
+      virtual_host = std::make_shared<VirtualHostImpl>(virtual_host_config, global_route_config,
+                                                       factory_context, *vhost_scope_, validator,
+                                                       validate_clusters, creation_status);
+      SET_AND_RETURN_IF_NOT_OK(creation_status, creation_status);
+    }
+    if (reusable) {
+      virtual_hosts_by_hash_.emplace(virtual_host_hash, virtual_host);
+    }
     for (const std::string& domain_name : virtual_host_config.domains()) {
       const Http::LowerCaseString lower_case_domain_name(domain_name);
       absl::string_view domain = lower_case_domain_name;
@@ -2068,17 +2142,52 @@ ConfigImpl::create(const envoy::config::route::v3::RouteConfiguration& config,
   return ret;
 }
 
+absl::StatusOr<std::shared_ptr<ConfigImpl>>
+ConfigImpl::create(const envoy::config::route::v3::RouteConfiguration& config,
+                   uint64_t common_config_hash, const ConfigImpl* previous_config,
+                   Server::Configuration::ServerFactoryContext& factory_context,
+                   ProtobufMessage::ValidationVisitor& validator, bool validate_clusters_default) {
+  absl::Status creation_status = absl::OkStatus();
+  auto ret = std::shared_ptr<ConfigImpl>(
+      new ConfigImpl(config, common_config_hash, previous_config, factory_context, validator,
+                     validate_clusters_default, creation_status));
+  RETURN_IF_NOT_OK(creation_status);
+  return ret;
+}
+
+ConfigImpl::ConfigImpl(const envoy::config::route::v3::RouteConfiguration& config,
+                       Server::Configuration::ServerFactoryContext& factory_context,
+                       ProtobufMessage::ValidationVisitor& validator,
+                       bool validate_clusters_default, absl::Status& creation_status)
+    : ConfigImpl(config, absl::nullopt, nullptr, factory_context, validator,
+                 validate_clusters_default, creation_status) {}
+
 ConfigImpl::ConfigImpl(const envoy::config::route::v3::RouteConfiguration& config,
+                       absl::optional<uint64_t> common_config_hash,
+                       const ConfigImpl* previous_config,
                        Server::Configuration::ServerFactoryContext& factory_context,
                        ProtobufMessage::ValidationVisitor& validator,
                        bool validate_clusters_default, absl::Status& creation_status) {
-  auto config_or_error = CommonConfigImpl::create(config, factory_context, validator);
-  SET_AND_RETURN_IF_NOT_OK(config_or_error.status(), creation_status);
-  shared_config_ = std::move(config_or_error.value());
+  const bool validate_clusters =
+      PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, validate_clusters, validate_clusters_default);
+  if (!validate_clusters) {
+    common_config_hash_ = common_config_hash;
+  }
+  // The virtual hosts reference the global route config, so they can only be reused along with it.
+  if (previous_config != nullptr && common_config_hash_.has_value() &&
+      previous_config->common_config_hash_ == common_config_hash_) {
+    shared_config_ = previous_config->shared_config_;
+  } else {
+    previous_config = nullptr;
+    auto config_or_error = CommonConfigImpl::create(config, factory_context, validator);
+    SET_AND_RETURN_IF_NOT_OK(config_or_error.status(), creation_status);
+    shared_config_ = std::move(config_or_error.value());
+  }
 
   auto matcher_or_error = RouteMatcher::create(
-      config, shared_config_, factory_context, validator,
-      PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, validate_clusters, validate_clusters_default));
+      config, shared_config_, factory_context, validator, validate_clusters,
+      common_config_hash_.has_value(),
+      previous_config != nullptr ? previous_config->route_matcher_.get() : nullptr);
   SET_AND_RETURN_IF_NOT_OK(matcher_or_error.status(), creation_status);
   route_matcher_ = std::move(matcher_or_error.value());
 }
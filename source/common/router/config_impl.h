@@ -29,11 +29,13 @@
 #include "source/common/http/header_mutation.h"
 #include "source/common/http/header_utility.h"
 #include "source/common/matcher/matcher.h"
+#include "source/common/router/adaptive_hedging_impl.h"
 #include "source/common/router/config_utility.h"
 #include "source/common/router/header_parser.h"
 #include "source/common/router/metadatamatchcriteria_impl.h"
 #include "source/common/router/per_filter_config.h"
 #include "source/common/router/retry_policy_impl.h"
+#include "source/common/router/route_path_prefilter.h"
 #include "source/common/router/router_ratelimit.h"
 #include "source/common/router/tls_context_match_criteria_impl.h"
 #include "source/common/stats/symbol_table.h"
@@ -121,6 +123,7 @@ public:
     return nullptr;
   }
   absl::optional<bool> filterDisabled(absl::string_view) const override { return {}; }
+  bool hasFilterDisabledOverrides() const override { return false; }
   RouteSpecificFilterConfigs perFilterConfigs(absl::string_view) const override { return {}; }
   const envoy::config::core::v3::Metadata& metadata() const override { return metadata_; }
   const Envoy::Config::TypedMetadata& typedMetadata() const override { return typed_metadata_; }
@@ -248,6 +251,7 @@ public:
     return HeaderParser::defaultParser();
   }
   absl::optional<bool> filterDisabled(absl::string_view config_name) const;
+  bool hasFilterDisabledOverrides() const { return has_filter_disabled_overrides_; }
 
   // Router::VirtualHost
   const CorsPolicy* corsPolicy() const override { return cors_policy_.get(); }
@@ -359,6 +363,8 @@ private:
   const bool include_attempt_count_in_request_ : 1;
   const bool include_attempt_count_in_response_ : 1;
   const bool include_is_timeout_retry_header_ : 1;
+  // Whether the virtual host or the route configuration configure any filter.
+  const bool has_filter_disabled_overrides_ : 1;
 };
 
 /**
@@ -387,12 +393,22 @@ public:
 private:
   enum class SslRequirements : uint8_t { None, ExternalOnly, All };
 
+  // Evaluates routes[index] for a request. Returns true if the evaluation of the routes is
+  // complete, with the selected route or nullptr in result.
+  bool evaluateRoute(const RouteCallback& cb, const Http::RequestHeaderMap& headers,
+                     const StreamInfo::StreamInfo& stream_info, uint64_t random_value,
+                     absl::Span<const RouteEntryImplBaseConstSharedPtr> routes, size_t index,
+                     RouteConstSharedPtr& result) const;
+
   CommonVirtualHostSharedPtr shared_virtual_host_;
 
   std::shared_ptr<const SslRedirectRoute> ssl_redirect_route_;
   SslRequirements ssl_requirements_;
 
   std::vector<RouteEntryImplBaseConstSharedPtr> routes_;
+  // Candidate routes_ for request paths, if enabled by
+  // envoy.reloadable_features.router_path_prefilter.
+  RoutePathPrefilterPtr path_prefilter_;
   Matcher::MatchTreeSharedPtr<Http::HttpMatchingData> matcher_;
 };
 
@@ -451,9 +467,13 @@ public:
     return additional_request_chance_;
   }
   bool hedgeOnPerTryTimeout() const override { return hedge_on_per_try_timeout_; }
+  OptRef<AdaptiveHedging> adaptiveHedging() const override {
+    return makeOptRefFromPtr<AdaptiveHedging>(adaptive_hedging_.get());
+  }
 
 private:
   const envoy::type::v3::FractionalPercent additional_request_chance_;
+  const std::unique_ptr<AdaptiveHedgingImpl> adaptive_hedging_;
   // Keep small members (bools and enums) at the end of class, to reduce alignment overhead.
   const uint32_t initial_requests_;
   const bool hedge_on_per_try_timeout_;
@@ -751,6 +771,7 @@ public:
   const Decorator* decorator() const override { return decorator_.get(); }
   const RouteTracing* tracingConfig() const override { return route_tracing_.get(); }
   absl::optional<bool> filterDisabled(absl::string_view config_name) const override;
+  bool hasFilterDisabledOverrides() const override { return has_filter_disabled_overrides_; }
   const RouteSpecificFilterConfig*
   mostSpecificPerFilterConfig(absl::string_view name) const override {
     auto* config = per_filter_configs_->get(name);
@@ -906,6 +927,10 @@ private:
   TlsContextMatchCriteriaConstPtr tls_context_match_criteria_;
   HeaderParserPtr request_headers_parser_;
   HeaderParserPtr response_headers_parser_;
+  // The header parsers of the route, its virtual host and its route configuration merged into
+  // one, or nullptr if they are evaluated one after another.
+  HeaderParserPtr merged_request_headers_parser_;
+  HeaderParserPtr merged_response_headers_parser_;
   RouteMetadataPackPtr metadata_;
   const std::vector<Envoy::Matchers::MetadataMatcher> dynamic_metadata_;
   const std::vector<Envoy::Matchers::FilterStateMatcher> filter_state_;
@@ -933,6 +958,8 @@ private:
   const bool match_grpc_ : 1;
   const bool case_sensitive_ : 1;
   bool include_vh_rate_limits_ : 1;
+  // Whether the route, its virtual host or the route configuration configure any filter.
+  bool has_filter_disabled_overrides_ : 1;
 };
 
 /**
@@ -1200,22 +1227,32 @@ DECLARE_FACTORY(RouteListMatchActionFactory);
  */
 class RouteMatcher {
 public:
+  /**
+   * @param reusable whether the virtual hosts are indexed by the hash of their proto, so that a
+   *        later RouteMatcher may reuse them.
+   * @param previous_matcher if not nullptr, a reusable RouteMatcher of the same global route
+   *        config whose virtual hosts are reused for the unchanged virtual hosts of config.
+   */
   static absl::StatusOr<std::unique_ptr<RouteMatcher>>
   create(const envoy::config::route::v3::RouteConfiguration& config,
          const CommonConfigSharedPtr& global_route_config,
          Server::Configuration::ServerFactoryContext& factory_context,
-         ProtobufMessage::ValidationVisitor& validator, bool validate_clusters);
+         ProtobufMessage::ValidationVisitor& validator, bool validate_clusters,
+         bool reusable = false, const RouteMatcher* previous_matcher = nullptr);
 
   VirtualHostRoute route(const RouteCallback& cb, const Http::RequestHeaderMap& headers,
                          const StreamInfo::StreamInfo& stream_info, uint64_t random_value) const;
 
   const VirtualHostImpl* findVirtualHost(const Http::RequestHeaderMap& headers) const;
 
+  uint64_t virtualHostsReused() const { return virtual_hosts_reused_; }
+
 private:
   RouteMatcher(const envoy::config::route::v3::RouteConfiguration& config,
                const CommonConfigSharedPtr& global_route_config,
                Server::Configuration::ServerFactoryContext& factory_context,
                ProtobufMessage::ValidationVisitor& validator, bool validate_clusters,
+               bool reusable, const RouteMatcher* previous_matcher,
                absl::Status& creation_status);
 
   using WildcardVirtualHosts =
@@ -1241,6 +1278,9 @@ private:
   WildcardVirtualHosts wildcard_virtual_host_prefixes_;
 
   VirtualHostImplSharedPtr default_virtual_host_;
+  // The virtual hosts by the hash of their proto, if reusable.
+  absl::flat_hash_map<uint64_t, VirtualHostImplSharedPtr> virtual_hosts_by_hash_;
+  uint64_t virtual_hosts_reused_{0};
   const bool ignore_port_in_host_matching_{false};
   const Http::LowerCaseString vhost_header_;
 };
@@ -1274,6 +1314,7 @@ public:
   absl::optional<bool> filterDisabled(absl::string_view config_name) const {
     return per_filter_configs_->disabled(config_name);
   }
+  bool hasFilterDisabledOverrides() const { return !per_filter_configs_->empty(); }
 
   // Router::CommonConfig
   const std::vector<Http::LowerCaseString>& internalOnlyHeaders() const override {
@@ -1327,6 +1368,25 @@ public:
          Server::Configuration::ServerFactoryContext& factory_context,
          ProtobufMessage::ValidationVisitor& validator, bool validate_clusters_default);
 
+  /**
+   * Creates the config of an update of a route configuration, which reuses the compiled virtual
+   * hosts of previous_config whose proto did not change, if the remainder of the route
+   * configuration did not change either. Nothing is reused if the clusters are validated, as the
+   * clusters of reused virtual hosts would not be validated again.
+   * @param common_config_hash supplies the hash of config without its virtual hosts.
+   * @param previous_config supplies the config that config updates, or nullptr.
+   */
+  static absl::StatusOr<std::shared_ptr<ConfigImpl>>
+  create(const envoy::config::route::v3::RouteConfiguration& config, uint64_t common_config_hash,
+         const ConfigImpl* previous_config,
+         Server::Configuration::ServerFactoryContext& factory_context,
+         ProtobufMessage::ValidationVisitor& validator, bool validate_clusters_default);
+
+  /**
+   * @return the number of virtual hosts that were reused from the previous config.
+   */
+  uint64_t virtualHostsReused() const { return route_matcher_->virtualHostsReused(); }
+
   bool virtualHostExists(const Http::RequestHeaderMap& headers) const {
     return route_matcher_->findVirtualHost(headers) != nullptr;
   }
@@ -1371,8 +1431,17 @@ protected:
              absl::Status& creation_status);
 
 private:
+  ConfigImpl(const envoy::config::route::v3::RouteConfiguration& config,
+             absl::optional<uint64_t> common_config_hash, const ConfigImpl* previous_config,
+             Server::Configuration::ServerFactoryContext& factory_context,
+             ProtobufMessage::ValidationVisitor& validator, bool validate_clusters_default,
+             absl::Status& creation_status);
+
   CommonConfigSharedPtr shared_config_;
   std::unique_ptr<RouteMatcher> route_matcher_;
+  // The hash of the route configuration without its virtual hosts, if the virtual hosts of this
+  // config may be reused by a later config.
+  absl::optional<uint64_t> common_config_hash_;
 };
 
 /**
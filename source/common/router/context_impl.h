@@ -20,6 +20,7 @@ namespace Router {
   COUNTER(passthrough_internal_redirect_predicate)                                                 \
   COUNTER(passthrough_internal_redirect_too_many_redirects)                                        \
   COUNTER(passthrough_internal_redirect_unsafe_scheme)                                             \
+  COUNTER(rq_body_shared_bytes)                                                                    \
   COUNTER(rq_direct_response)                                                                      \
   COUNTER(rq_overload_local_reply)                                                                 \
   COUNTER(rq_redirect)                                                                             \
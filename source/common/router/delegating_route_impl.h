@@ -46,6 +46,9 @@ public:
   absl::optional<bool> filterDisabled(absl::string_view name) const override {
     return base_route_->filterDisabled(name);
   }
+  bool hasFilterDisabledOverrides() const override {
+    return base_route_->hasFilterDisabledOverrides();
+  }
   const std::string& routeName() const override { return base_route_->routeName(); }
   const VirtualHostConstSharedPtr& virtualHost() const override {
     return base_route_->virtualHost();
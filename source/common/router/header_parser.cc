@@ -15,6 +15,7 @@
 #include "source/common/protobuf/utility.h"
 #include "source/common/runtime/runtime_features.h"
 
+#include "absl/container/flat_hash_set.h"
 #include "absl/strings/str_cat.h"
 #include "absl/strings/str_replace.h"
 
@@ -23,6 +24,9 @@ namespace Router {
 
 namespace {
 
+// Values without command operators are formatted to themselves.
+bool isStaticValue(absl::string_view value) { return value.find('%') == absl::string_view::npos; }
+
 absl::StatusOr<Formatter::FormatterPtr>
 parseHttpHeaderFormatter(const envoy::config::core::v3::HeaderValue& header_value) {
   const std::string& key = header_value.key();
@@ -58,7 +62,8 @@ parseHttpHeaderFormatter(const envoy::config::core::v3::HeaderValue& header_valu
 HeadersToAddEntry::HeadersToAddEntry(const HeaderValueOption& header_value_option,
                                      absl::Status& creation_status)
     : original_value_(header_value_option.header().value()),
-      add_if_empty_(header_value_option.keep_empty_value()) {
+      add_if_empty_(header_value_option.keep_empty_value()),
+      static_value_(isStaticValue(original_value_)) {
 
   if (header_value_option.has_append()) {
     // 'append' is set and ensure the 'append_action' value is equal to the default value.
@@ -83,7 +88,8 @@ HeadersToAddEntry::HeadersToAddEntry(const HeaderValueOption& header_value_optio
 HeadersToAddEntry::HeadersToAddEntry(const HeaderValue& header_value,
                                      HeaderAppendAction append_action,
                                      absl::Status& creation_status)
-    : original_value_(header_value.value()), append_action_(append_action) {
+    : original_value_(header_value.value()), append_action_(append_action),
+      static_value_(isStaticValue(original_value_)) {
   auto formatter_or_error = parseHttpHeaderFormatter(header_value);
   SET_AND_RETURN_IF_NOT_OK(formatter_or_error.status(), creation_status);
   formatter_ = std::move(formatter_or_error.value());
@@ -96,6 +102,7 @@ HeaderParser::configure(const Protobuf::RepeatedPtrField<HeaderValueOption>& hea
   for (const auto& header_value_option : headers_to_add) {
     auto entry_or_error = HeadersToAddEntry::create(header_value_option);
     RETURN_IF_NOT_OK_REF(entry_or_error.status());
+    header_parser->formatted_headers_ += !entry_or_error.value()->static_value_;
     header_parser->headers_to_add_.emplace_back(
         Http::LowerCaseString(header_value_option.header().key()),
         std::move(entry_or_error.value()));
@@ -113,6 +120,7 @@ absl::StatusOr<HeaderParserPtr> HeaderParser::configure(
   for (const auto& header_value : headers_to_add) {
     auto entry_or_error = HeadersToAddEntry::create(header_value, append_action);
     RETURN_IF_NOT_OK_REF(entry_or_error.status());
+    header_parser->formatted_headers_ += !entry_or_error.value()->static_value_;
     header_parser->headers_to_add_.emplace_back(Http::LowerCaseString(header_value.key()),
                                                 std::move(entry_or_error.value()));
   }
@@ -141,6 +149,39 @@ HeaderParser::configure(const Protobuf::RepeatedPtrField<HeaderValueOption>& hea
   return header_parser;
 }
 
+HeaderParserPtr HeaderParser::merge(absl::Span<const HeaderParser* const> parsers) {
+  HeaderParserPtr merged(new HeaderParser());
+  uint32_t merged_parsers = 0;
+  absl::flat_hash_set<absl::string_view> keys;
+  for (const HeaderParser* parser : parsers) {
+    if (parser->headers_to_add_.empty() && parser->headers_to_remove_.empty()) {
+      continue;
+    }
+    merged_parsers++;
+    // A parser may modify the same header several times, but not one modified by another parser.
+    absl::flat_hash_set<absl::string_view> parser_keys;
+    for (const auto& [key, entry] : parser->headers_to_add_) {
+      if (!entry->static_value_ || keys.contains(key.get())) {
+        return nullptr;
+      }
+      parser_keys.insert(key.get());
+      merged->headers_to_add_.emplace_back(key, entry);
+    }
+    for (const auto& key : parser->headers_to_remove_) {
+      if (keys.contains(key.get())) {
+        return nullptr;
+      }
+      parser_keys.insert(key.get());
+      merged->headers_to_remove_.push_back(key);
+    }
+    keys.insert(parser_keys.begin(), parser_keys.end());
+  }
+  if (merged_parsers < 2) {
+    return nullptr;
+  }
+  return merged;
+}
+
 void HeaderParser::evaluateHeaders(Http::HeaderMap& headers, const Formatter::Context& context,
                                    const StreamInfo::StreamInfo& stream_info) const {
   evaluateHeaders(headers, context, &stream_info);
@@ -163,21 +204,21 @@ void HeaderParser::evaluateHeaders(Http::HeaderMap& headers, const Formatter::Co
   // header_formatter_speed_test.cc provides micro-benchmark for evaluating speed of adding and
   // replacing headers and should be used when modifying the code below to access the performance
   // impact of code changes.
-  absl::InlinedVector<std::pair<const Http::LowerCaseString&, const std::string>, 4> headers_to_add,
-      headers_to_overwrite;
-  // value_buffer is used only when stream_info is a valid pointer and stores header value
-  // created by a formatter. It is declared outside of 'for' loop for performance reason to avoid
-  // stack allocation and unnecessary std::string's memory adjustments for each iteration. The
-  // actual value of the header is accessed via 'value' variable which is initialized differently
-  // depending whether stream_info and valid or nullptr. Based on performance tests implemented in
-  // header_formatter_speed_test.cc this approach strikes the best balance between performance and
-  // readability.
-  std::string value_buffer;
+  absl::InlinedVector<std::pair<const Http::LowerCaseString&, absl::string_view>, 4>
+      headers_to_add, headers_to_overwrite;
+  // formatted_values holds the values created by formatters, which are only used when stream_info
+  // is a valid pointer. Static values are used as configured without formatting or copying them.
+  // The storage is reserved upfront so that the views of the values stay valid until they are
+  // set. Based on performance tests implemented in header_formatter_speed_test.cc this approach
+  // strikes the best balance between performance and readability.
+  absl::InlinedVector<std::string, 4> formatted_values;
+  if (stream_info != nullptr) {
+    formatted_values.reserve(formatted_headers_);
+  }
   for (const auto& [key, entry] : headers_to_add_) {
     absl::string_view value;
-    if (stream_info != nullptr) {
-      value_buffer = entry->formatter_->format(context, *stream_info);
-      value = value_buffer;
+    if (stream_info != nullptr && !entry->static_value_) {
+      value = formatted_values.emplace_back(entry->formatter_->format(context, *stream_info));
     } else {
       value = entry->original_value_;
     }
@@ -221,7 +262,9 @@ Http::HeaderTransforms HeaderParser::getHeaderTransforms(const StreamInfo::Strea
 
   for (const auto& [key, entry] : headers_to_add_) {
     if (do_formatting) {
-      const std::string value = entry->formatter_->format({}, stream_info);
+      const std::string value = entry->static_value_
+                                    ? entry->original_value_
+                                    : entry->formatter_->format({}, stream_info);
       if (!value.empty() || entry->add_if_empty_) {
         switch (entry->append_action_) {
         case HeaderValueOption::APPEND_IF_EXISTS_OR_ADD:
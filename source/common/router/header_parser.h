@@ -12,6 +12,8 @@
 #include "source/common/http/header_map_impl.h"
 #include "source/common/protobuf/protobuf.h"
 
+#include "absl/types/span.h"
+
 namespace Envoy {
 namespace Router {
 
@@ -45,6 +47,8 @@ struct HeadersToAddEntry {
   HeaderAppendAction append_action_;
   // Keep small members (bools and enums) at the end of class, to reduce alignment overhead.
   bool add_if_empty_ = false;
+  // True if the value has no command operators, so that original_value_ is the formatted value.
+  bool static_value_ = false;
 
 protected:
   HeadersToAddEntry(const HeaderValue& header_value, HeaderAppendAction append_action,
@@ -85,6 +89,17 @@ public:
   configure(const Protobuf::RepeatedPtrField<HeaderValueOption>& headers_to_add,
             const Protobuf::RepeatedPtrField<std::string>& headers_to_remove);
 
+  /**
+   * Merges header parsers that are evaluated one after another into a single parser with the same
+   * result. This is possible if all values to add are static and no header is added or removed by
+   * more than one of the parsers, because a parser evaluates its values against the headers set by
+   * the parsers evaluated before it.
+   * @param parsers supplies the parsers in evaluation order.
+   * @return HeaderParserPtr the merged parser, or nullptr if the parsers cannot be merged or fewer
+   *         than two of them modify headers.
+   */
+  static HeaderParserPtr merge(absl::Span<const HeaderParser* const> parsers);
+
   static const HeaderParser& defaultParser() {
     static HeaderParser* instance = new HeaderParser();
     return *instance;
@@ -128,8 +143,12 @@ protected:
   HeaderParser() = default;
 
 private:
-  std::vector<std::pair<Http::LowerCaseString, std::unique_ptr<HeadersToAddEntry>>> headers_to_add_;
+  // The entries are shared with the parsers merged from this one.
+  std::vector<std::pair<Http::LowerCaseString, std::shared_ptr<const HeadersToAddEntry>>>
+      headers_to_add_;
   std::vector<Http::LowerCaseString> headers_to_remove_;
+  // The number of headers_to_add_ entries whose values are not static.
+  uint32_t formatted_headers_{};
 };
 
 } // namespace Router
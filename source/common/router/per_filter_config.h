@@ -28,6 +28,11 @@ public:
    */
   absl::optional<bool> disabled(absl::string_view name) const;
 
+  /**
+   * @return true if no filter is configured, and so explicitly enabled or disabled.
+   */
+  bool empty() const { return configs_.empty(); }
+
 private:
   PerFilterConfigs(const Protobuf::Map<std::string, Protobuf::Any>& typed_configs,
                    Server::Configuration::ServerFactoryContext& factory_context,
@@ -198,8 +198,9 @@ RouteConfigProviderSharedPtr RdsFactoryImpl::createRdsRouteConfigProvider(
   auto provider = manager.addDynamicProvider(
       rds, rds.route_config_name(), init_manager,
       [&factory_context, &rds, &stat_prefix, &manager, &proto_traits](uint64_t manager_identifier) {
-        auto config_update =
-            std::make_unique<RouteConfigUpdateReceiverImpl>(proto_traits, factory_context);
+        auto config_update = std::make_unique<RouteConfigUpdateReceiverImpl>(
+            proto_traits, factory_context,
+            fmt::format("{}rds.{}.", stat_prefix, rds.route_config_name()));
         auto resource_decoder = std::make_shared<
             Envoy::Config::OpaqueResourceDecoderImpl<envoy::config::route::v3::RouteConfiguration>>(
             factory_context.messageValidationContext().dynamicValidationVisitor(), "name");
@@ -12,6 +12,7 @@
 #include "source/common/config/resource_name.h"
 #include "source/common/protobuf/utility.h"
 #include "source/common/router/config_impl.h"
+#include "source/common/runtime/runtime_features.h"
 
 namespace Envoy {
 namespace Router {
@@ -33,6 +34,15 @@ void rebuildRouteConfigVirtualHosts(
   }
 }
 
+// Hashes 'route_config' without its virtual hosts, which are swapped out rather than copied.
+uint64_t commonConfigHash(envoy::config::route::v3::RouteConfiguration& route_config) {
+  Protobuf::RepeatedPtrField<envoy::config::route::v3::VirtualHost> virtual_hosts;
+  virtual_hosts.Swap(route_config.mutable_virtual_hosts());
+  const uint64_t hash = MessageUtil::hash(route_config);
+  virtual_hosts.Swap(route_config.mutable_virtual_hosts());
+  return hash;
+}
+
 } // namespace
 
 Rds::ConfigConstSharedPtr ConfigTraitsImpl::createNullConfig() const {
@@ -76,7 +86,7 @@ bool RouteConfigUpdateReceiverImpl::onRdsUpdate(const Protobuf::Message& rc,
       rebuildRouteConfigVirtualHosts(*rds_virtual_hosts_, *vhds_virtual_hosts_, *new_route_config);
     }
   }
-  base_.updateConfig(std::move(new_route_config));
+  updateConfig(std::move(new_route_config));
   base_.updateHash(new_hash);
   vhds_configuration_changed_ = new_vhds_config_hash != last_vhds_config_hash_;
   last_vhds_config_hash_ = new_vhds_config_hash;
@@ -107,7 +117,7 @@ bool RouteConfigUpdateReceiverImpl::onVhdsUpdate(
   rebuildRouteConfigVirtualHosts(*rds_virtual_hosts_, *vhosts_after_this_update,
                                  *route_config_after_this_update);
 
-  base_.updateConfig(std::move(route_config_after_this_update));
+  updateConfig(std::move(route_config_after_this_update));
   // No exception, route_config_after_this_update is valid, can update the state.
   vhds_virtual_hosts_ = std::move(vhosts_after_this_update);
   resource_ids_in_last_update_ = std::move(added_resource_ids);
@@ -116,6 +126,35 @@ bool RouteConfigUpdateReceiverImpl::onVhdsUpdate(
   return removed || updated || !resource_ids_in_last_update_.empty();
 }
 
+void RouteConfigUpdateReceiverImpl::updateConfig(
+    std::unique_ptr<envoy::config::route::v3::RouteConfiguration>&& route_config) {
+  const MonotonicTime start_time = factory_context_.timeSource().monotonicTime();
+  const uint64_t virtual_hosts = route_config->virtual_hosts_size();
+  uint64_t virtual_hosts_reused = 0;
+  if (Runtime::runtimeFeatureEnabled(
+          "envoy.reloadable_features.rds_reuse_unchanged_virtual_hosts")) {
+    // The current config is a NullConfigImpl before the first update.
+    const auto* previous_config =
+        dynamic_cast<const ConfigImpl*>(base_.parsedConfiguration().get());
+    auto config = THROW_OR_RETURN_VALUE(
+        ConfigImpl::create(*route_config, commonConfigHash(*route_config), previous_config,
+                           factory_context_,
+                           factory_context_.messageValidationContext().dynamicValidationVisitor(),
+                           false /* not validate unknown cluster */),
+        std::shared_ptr<ConfigImpl>);
+    virtual_hosts_reused = config->virtualHostsReused();
+    base_.updateConfig(std::move(route_config), std::move(config));
+  } else {
+    base_.updateConfig(std::move(route_config));
+  }
+  stats_.virtual_hosts_reused_.add(virtual_hosts_reused);
+  stats_.virtual_hosts_rebuilt_.add(virtual_hosts - virtual_hosts_reused);
+  const std::chrono::milliseconds build_time =
+      std::chrono::duration_cast<std::chrono::milliseconds>(
+          factory_context_.timeSource().monotonicTime() - start_time);
+  stats_.config_build_time_.recordValue(build_time.count());
+}
+
 bool RouteConfigUpdateReceiverImpl::removeVhosts(
     VirtualHostMap& vhosts, const Protobuf::RepeatedPtrField<std::string>& removed_vhost_names) {
   bool vhosts_removed = false;
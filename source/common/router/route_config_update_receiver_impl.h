@@ -9,6 +9,8 @@
 #include "envoy/router/route_config_update_receiver.h"
 #include "envoy/server/factory_context.h"
 #include "envoy/service/discovery/v3/discovery.pb.h"
+#include "envoy/stats/scope.h"
+#include "envoy/stats/stats_macros.h"
 
 #include "source/common/common/logger.h"
 #include "source/common/protobuf/utility.h"
@@ -31,12 +33,30 @@ private:
   ProtobufMessage::ValidationVisitor& validator_;
 };
 
+/**
+ * All route config update stats. @see stats_macros.h
+ */
+#define ALL_ROUTE_CONFIG_UPDATE_STATS(COUNTER, HISTOGRAM)                                          \
+  COUNTER(virtual_hosts_rebuilt)                                                                   \
+  COUNTER(virtual_hosts_reused)                                                                    \
+  HISTOGRAM(config_build_time, Milliseconds)
+
+/**
+ * Struct definition for all route config update stats. @see stats_macros.h
+ */
+struct RouteConfigUpdateStats {
+  ALL_ROUTE_CONFIG_UPDATE_STATS(GENERATE_COUNTER_STRUCT, GENERATE_HISTOGRAM_STRUCT)
+};
+
 class RouteConfigUpdateReceiverImpl : public RouteConfigUpdateReceiver {
 public:
   RouteConfigUpdateReceiverImpl(Rds::ProtoTraits& proto_traits,
-                                Server::Configuration::ServerFactoryContext& factory_context)
+                                Server::Configuration::ServerFactoryContext& factory_context,
+                                const std::string& stat_prefix)
       : config_traits_(factory_context.messageValidationContext().dynamicValidationVisitor()),
-        base_(config_traits_, proto_traits, factory_context) {}
+        base_(config_traits_, proto_traits, factory_context), factory_context_(factory_context),
+        scope_(factory_context.scope().createScope(stat_prefix)),
+        stats_({ALL_ROUTE_CONFIG_UPDATE_STATS(POOL_COUNTER(*scope_), POOL_HISTOGRAM(*scope_))}) {}
 
   using VirtualHostMap = std::map<std::string, envoy::config::route::v3::VirtualHost>;
 
@@ -73,9 +93,16 @@ public:
   }
 
 private:
+  // Creates the config of route_config, reusing the unchanged virtual hosts of the current config
+  // if enabled by envoy.reloadable_features.rds_reuse_unchanged_virtual_hosts.
+  void updateConfig(std::unique_ptr<envoy::config::route::v3::RouteConfiguration>&& route_config);
+
   ConfigTraitsImpl config_traits_;
 
   Rds::RouteConfigUpdateReceiverImpl base_;
+  Server::Configuration::ServerFactoryContext& factory_context_;
+  Stats::ScopeSharedPtr scope_;
+  RouteConfigUpdateStats stats_;
 
   uint64_t last_vhds_config_hash_{0ul};
   // vhosts supplied by RDS, to be merged with VHDS vhosts in onVhdsUpdate.
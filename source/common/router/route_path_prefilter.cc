@@ -0,0 +1,141 @@
+#include "source/common/router/route_path_prefilter.h"
+
+#include <algorithm>
+
+#include "source/common/common/regex.h"
+#include "source/common/http/path_utility.h"
+#include "source/common/protobuf/utility.h"
+
+#include "absl/strings/ascii.h"
+
+namespace Envoy {
+namespace Router {
+
+void RoutePathPrefilter::PathIndex::addExact(absl::string_view path, uint32_t index) {
+  exact_[std::string(path)].push_back(index);
+}
+
+void RoutePathPrefilter::PathIndex::addPrefix(absl::string_view prefix, uint32_t index) {
+  RouteIndices* indices = prefixes_.find(prefix);
+  if (indices == nullptr) {
+    indices = prefix_indices_.emplace_back(std::make_unique<RouteIndices>()).get();
+    prefixes_.add(prefix, indices);
+  }
+  indices->push_back(index);
+}
+
+void RoutePathPrefilter::PathIndex::collect(absl::string_view path, Candidates& candidates) const {
+  if (auto it = exact_.find(path); it != exact_.end()) {
+    candidates.insert(candidates.end(), it->second.begin(), it->second.end());
+  }
+  if (!prefix_indices_.empty()) {
+    for (const RouteIndices* indices : prefixes_.findMatchingPrefixes(path)) {
+      candidates.insert(candidates.end(), indices->begin(), indices->end());
+    }
+  }
+}
+
+RoutePathPrefilter::RoutePathPrefilter(bool ignore_path_parameters)
+    : ignore_path_parameters_(ignore_path_parameters) {}
+
+RoutePathPrefilterPtr RoutePathPrefilter::create(
+    const Protobuf::RepeatedPtrField<envoy::config::route::v3::Route>& routes,
+    bool ignore_path_parameters, const Regex::Engine& regex_engine) {
+  // Regexes of other engines may not have the semantics of RE2, so they are not indexed.
+  const bool re2_engine = dynamic_cast<const Regex::GoogleReEngine*>(&regex_engine) != nullptr;
+
+  std::unique_ptr<RoutePathPrefilter> prefilter(new RoutePathPrefilter(ignore_path_parameters));
+  // The options of the regexes of CompiledGoogleReMatcher, anchored at both ends like
+  // RE2::FullMatch().
+  re2::RE2::Options options;
+  options.set_log_errors(false);
+  auto regexes = std::make_unique<re2::RE2::Set>(options, re2::RE2::ANCHOR_BOTH);
+  RouteIndices regex_routes;
+
+  for (int i = 0; i < routes.size(); i++) {
+    const uint32_t index = i;
+    const envoy::config::route::v3::RouteMatch& match = routes[i].match();
+    const bool case_sensitive = PROTOBUF_GET_WRAPPED_OR_DEFAULT(match, case_sensitive, true);
+    PathIndex& paths = case_sensitive ? prefilter->case_sensitive_ : prefilter->case_insensitive_;
+    const auto key = [case_sensitive](const std::string& path) {
+      return case_sensitive ? path : absl::AsciiStrToLower(path);
+    };
+
+    switch (match.path_specifier_case()) {
+    case envoy::config::route::v3::RouteMatch::PathSpecifierCase::kPrefix:
+      paths.addPrefix(key(match.prefix()), index);
+      break;
+    case envoy::config::route::v3::RouteMatch::PathSpecifierCase::kPathSeparatedPrefix:
+      // The path separated prefix matches a subset of the paths that the prefix matches.
+      paths.addPrefix(key(match.path_separated_prefix()), index);
+      break;
+    case envoy::config::route::v3::RouteMatch::PathSpecifierCase::kPath:
+      paths.addExact(key(match.path()), index);
+      break;
+    case envoy::config::route::v3::RouteMatch::PathSpecifierCase::kSafeRegex:
+      if ((re2_engine || match.safe_regex().has_google_re2()) &&
+          regexes->Add(match.safe_regex().regex(), nullptr) >= 0) {
+        regex_routes.push_back(index);
+      } else {
+        prefilter->unindexed_.push_back(index);
+      }
+      break;
+    default:
+      // Templates, path match policies and CONNECT routes.
+      prefilter->unindexed_.push_back(index);
+      break;
+    }
+  }
+
+  if (!regex_routes.empty()) {
+    if (regexes->Compile()) {
+      prefilter->regexes_ = std::move(regexes);
+      prefilter->regex_routes_ = std::move(regex_routes);
+    } else {
+      // The combined program exceeds the memory budget of RE2. The routes remain correct when
+      // evaluated one at a time.
+      prefilter->unindexed_.insert(prefilter->unindexed_.end(), regex_routes.begin(),
+                                   regex_routes.end());
+      std::sort(prefilter->unindexed_.begin(), prefilter->unindexed_.end());
+    }
+  }
+
+  if (prefilter->case_sensitive_.empty() && prefilter->case_insensitive_.empty() &&
+      prefilter->regexes_ == nullptr) {
+    return nullptr;
+  }
+  return prefilter;
+}
+
+RoutePathPrefilter::Candidates RoutePathPrefilter::candidates(absl::string_view path) const {
+  // Path matchers see the path like RouteEntryImplBase::sanitizePathBeforePathMatching() and
+  // Matchers::PathMatcher::match() prepare it.
+  if (ignore_path_parameters_) {
+    path = path.substr(0, path.find(';'));
+  }
+  path = Http::PathUtil::removeQueryAndFragment(path);
+
+  Candidates candidates(unindexed_.begin(), unindexed_.end());
+  case_sensitive_.collect(path, candidates);
+  if (!case_insensitive_.empty()) {
+    case_insensitive_.collect(absl::AsciiStrToLower(path), candidates);
+  }
+  if (regexes_ != nullptr) {
+    std::vector<int> matches;
+    re2::RE2::Set::ErrorInfo error_info;
+    if (regexes_->Match(path, &matches, &error_info)) {
+      for (const int match : matches) {
+        candidates.push_back(regex_routes_[match]);
+      }
+    } else if (error_info.kind != re2::RE2::Set::kNoError) {
+      // The DFA ran out of memory, in which case any of the regexes may match.
+      candidates.insert(candidates.end(), regex_routes_.begin(), regex_routes_.end());
+    }
+  }
+
+  std::sort(candidates.begin(), candidates.end());
+  return candidates;
+}
+
+} // namespace Router
+} // namespace Envoy
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "envoy/common/regex.h"
+#include "envoy/config/route/v3/route_components.pb.h"
+
+#include "source/common/common/radix_tree.h"
+#include "source/common/protobuf/protobuf.h"
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/container/inlined_vector.h"
+#include "absl/strings/string_view.h"
+#include "re2/set.h"
+
+namespace Envoy {
+namespace Router {
+
+class RoutePathPrefilter;
+using RoutePathPrefilterPtr = std::unique_ptr<const RoutePathPrefilter>;
+
+/**
+ * Narrows the routes of a virtual host down to those whose path matcher can match a request path,
+ * so that the routes of large route tables need not be evaluated one at a time. The exact paths of
+ * the routes are looked up in hash maps, their prefixes in radix trees and their RE2 regexes are
+ * combined into a single RE2::Set, all of which are evaluated once per request. Routes with other
+ * path matchers are always candidates.
+ *
+ * The candidates are a superset of the routes whose path matchers match. They are returned as
+ * indices into the routes of the virtual host in ascending order, so that evaluating them in turn
+ * yields the same route as evaluating all routes in order.
+ */
+class RoutePathPrefilter {
+public:
+  using Candidates = absl::InlinedVector<uint32_t, 8>;
+
+  /**
+   * @param routes supplies the routes of the virtual host, in order.
+   * @param ignore_path_parameters whether path parameters are ignored when matching paths, as
+   *        configured by RouteConfiguration.ignore_path_parameters_in_path_matching.
+   * @param regex_engine supplies the regex engine of the server. Regex paths are only indexed when
+   *        they are evaluated with RE2.
+   * @return the prefilter, or nullptr if no path matcher of the routes can be indexed.
+   */
+  static RoutePathPrefilterPtr
+  create(const Protobuf::RepeatedPtrField<envoy::config::route::v3::Route>& routes,
+         bool ignore_path_parameters, const Regex::Engine& regex_engine);
+
+  /**
+   * @param path supplies the :path header value of a request.
+   * @return the indices of the routes that may match the path, in ascending order.
+   */
+  Candidates candidates(absl::string_view path) const;
+
+  /**
+   * @return the number of routes that are candidates for every path.
+   */
+  size_t unindexedRoutes() const { return unindexed_.size(); }
+
+private:
+  using RouteIndices = std::vector<uint32_t>;
+
+  // Exact paths and prefixes of either case sensitive or case insensitive routes. The keys of
+  // case insensitive routes are lower case.
+  struct PathIndex {
+    void addExact(absl::string_view path, uint32_t index);
+    void addPrefix(absl::string_view prefix, uint32_t index);
+    void collect(absl::string_view path, Candidates& candidates) const;
+    bool empty() const { return exact_.empty() && prefix_indices_.empty(); }
+
+    absl::flat_hash_map<std::string, RouteIndices> exact_;
+    RadixTree<RouteIndices*> prefixes_;
+    // Owns the values of prefixes_.
+    std::vector<std::unique_ptr<RouteIndices>> prefix_indices_;
+  };
+
+  RoutePathPrefilter(bool ignore_path_parameters);
+
+  const bool ignore_path_parameters_;
+  PathIndex case_sensitive_;
+  PathIndex case_insensitive_;
+  std::unique_ptr<re2::RE2::Set> regexes_;
+  // The route index of each regex of regexes_.
+  RouteIndices regex_routes_;
+  // Routes that are candidates for every path.
+  RouteIndices unindexed_;
+};
+
+} // namespace Router
+} // namespace Envoy
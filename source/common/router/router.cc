@@ -327,7 +327,9 @@ FilterUtility::HedgingParams
 FilterUtility::finalHedgingParams(const RouteEntry& route,
                                   Http::RequestHeaderMap& request_headers) {
   HedgingParams hedging_params;
-  hedging_params.hedge_on_per_try_timeout_ = route.hedgePolicy().hedgeOnPerTryTimeout();
+  // Adaptive hedging hedges on the per try timeout that it derives from the route latencies.
+  hedging_params.hedge_on_per_try_timeout_ = route.hedgePolicy().hedgeOnPerTryTimeout() ||
+                                             route.hedgePolicy().adaptiveHedging().has_value();
 
   const Http::HeaderEntry* hedge_on_per_try_timeout_entry =
       request_headers.EnvoyHedgeOnPerTryTimeout();
@@ -609,6 +611,19 @@ Http::FilterHeadersStatus Filter::decodeHeaders(Http::RequestHeaderMap& headers,
                                          grpc_request_, hedging_params_.hedge_on_per_try_timeout_,
                                          config_->respect_expected_rq_timeout_);
 
+  adaptive_hedging_ = route_entry_->hedgePolicy().adaptiveHedging();
+  if (adaptive_hedging_.has_value()) {
+    // Every request of the route counts towards the hedging budget, but only requests that hedge
+    // shorten their per try timeout to the hedge delay.
+    const absl::optional<std::chrono::milliseconds> hedge_delay = adaptive_hedging_->onRequest();
+    if (hedge_delay.has_value() && hedging_params_.hedge_on_per_try_timeout_ &&
+        (timeout_.global_timeout_.count() == 0 || hedge_delay.value() < timeout_.global_timeout_) &&
+        (timeout_.per_try_timeout_.count() == 0 ||
+         hedge_delay.value() < timeout_.per_try_timeout_)) {
+      timeout_.per_try_timeout_ = hedge_delay.value();
+    }
+  }
+
   // Set x-envoy-attempt-count before finalizeRequestHeaders so it can be referenced.
   include_attempt_count_in_request_ = route_entry_->includeAttemptCountInRequest();
   if (include_attempt_count_in_request_) {
@@ -998,6 +1013,7 @@ Http::FilterDataStatus Filter::decodeData(Buffer::Instance& data, bool end_strea
     ENVOY_LOG(debug, "retry or shadow overflow: retry_state_ reset, buffering set to false");
     buffering = false;
     active_shadow_policies_.clear();
+    shared_request_body_.clear();
 
     // Only send local reply and cleanup if we're in a retry waiting state (no active upstream
     // requests). If there are active upstream requests, let the normal upstream failure handling
@@ -1035,20 +1051,42 @@ Http::FilterDataStatus Filter::decodeData(Buffer::Instance& data, bool end_strea
     request_buffer_overflowed_ = true;
   }
 
+  // The shadow streams, the upstream request and the buffer for retries reference the same
+  // slices of the data rather than copies of it.
+  Buffer::SharedBufferConstSharedPtr shared_data;
+  if (share_request_body_ && (buffering || !shadow_streams_.empty())) {
+    shared_data = Buffer::SharedBuffer::create(data);
+  }
   for (auto* shadow_stream : shadow_streams_) {
     if (end_stream) {
       shadow_stream->removeDestructorCallback();
       shadow_stream->removeWatermarkCallbacks();
     }
-    Buffer::OwnedImpl copy(data);
+    Buffer::OwnedImpl copy;
+    if (shared_data != nullptr) {
+      stats_.rq_body_shared_bytes_.add(shared_data->addTo(copy));
+    } else {
+      copy.add(data);
+    }
     shadow_stream->sendData(copy, end_stream);
   }
   if (end_stream) {
     shadow_streams_.clear();
   }
+  if (shared_data != nullptr) {
+    shared_data->addTo(data);
+    if (buffering) {
+      shared_request_body_.push_back(shared_data);
+    }
+  }
   if (buffering) {
     if (!upstream_requests_.empty()) {
-      Buffer::OwnedImpl copy(data);
+      Buffer::OwnedImpl copy;
+      if (shared_data != nullptr) {
+        stats_.rq_body_shared_bytes_.add(shared_data->addTo(copy));
+      } else {
+        copy.add(data);
+      }
       upstream_requests_.front()->acceptDataFromRouter(copy, end_stream);
     }
 
@@ -1289,7 +1327,9 @@ void Filter::onSoftPerTryTimeout(UpstreamRequest& upstream_request) {
                          absl::optional<uint64_t>(enumToInt(timeout_response_code_)));
   upstream_request.outlierDetectionTimeoutRecorded(true);
 
-  if (!downstream_response_started_ && retry_state_) {
+  // Adaptive hedging stops hedging once the hedges of the route exceed its budget.
+  if (!downstream_response_started_ && retry_state_ &&
+      (!adaptive_hedging_.has_value() || adaptive_hedging_->canHedge())) {
     RetryStatus retry_status = retry_state_->shouldHedgeRetryPerTryTimeout(
         [this, can_use_http3 = upstream_request.upstreamStreamOptions().can_use_http3_]() -> void {
           // Without any knowledge about what's going on in the connection pool, retry the request
@@ -1307,7 +1347,10 @@ void Filter::onSoftPerTryTimeout(UpstreamRequest& upstream_request) {
       // back.
       upstream_request.retried(true);
 
-      // TODO: cluster stat for hedge attempted.
+      cluster_->trafficStats()->upstream_rq_hedge_launched_.inc();
+      if (adaptive_hedging_.has_value()) {
+        adaptive_hedging_->onHedge();
+      }
     } else if (retry_status == RetryStatus::NoOverflow) {
       callbacks_->streamInfo().setResponseFlag(StreamInfo::CoreResponseFlag::UpstreamOverflow);
     } else if (retry_status == RetryStatus::NoRetryLimitExceeded) {
@@ -1659,6 +1702,22 @@ void Filter::onUpstream1xxHeaders(Http::ResponseHeaderMapPtr&& headers,
   callbacks_->encode1xxHeaders(std::move(headers));
 }
 
+void Filter::copyRequestBody(Buffer::Instance& copy) {
+  const Buffer::Instance& body = *callbacks_->decodingBuffer();
+  uint64_t shared_length = 0;
+  for (const Buffer::SharedBufferConstSharedPtr& shared_data : shared_request_body_) {
+    shared_length += shared_data->length();
+  }
+  // The body was buffered by a filter before the router, or not all of it was shared.
+  if (shared_length != body.length()) {
+    copy.add(body);
+    return;
+  }
+  for (const Buffer::SharedBufferConstSharedPtr& shared_data : shared_request_body_) {
+    stats_.rq_body_shared_bytes_.add(shared_data->addTo(copy));
+  }
+}
+
 void Filter::resetAll() {
   while (!upstream_requests_.empty()) {
     auto request_ptr = upstream_requests_.back()->removeFromList(upstream_requests_);
@@ -1671,19 +1730,26 @@ void Filter::resetOtherUpstreams(UpstreamRequest& upstream_request) {
   // Pop each upstream request on the list and reset it if it's not the one
   // provided. At the end we'll move it back into the list.
   UpstreamRequestPtr final_upstream_request;
+  bool reset_other_upstreams = false;
   while (!upstream_requests_.empty()) {
     UpstreamRequestPtr upstream_request_tmp =
         upstream_requests_.back()->removeFromList(upstream_requests_);
     if (upstream_request_tmp.get() != &upstream_request) {
       upstream_request_tmp->resetStream();
+      reset_other_upstreams = true;
       // TODO: per-host stat for hedge abandoned.
-      // TODO: cluster stat for hedge abandoned.
+      if (upstream_request_tmp->hedged()) {
+        cluster_->trafficStats()->upstream_rq_hedge_wasted_.inc();
+      }
     } else {
       final_upstream_request = std::move(upstream_request_tmp);
     }
   }
 
   ASSERT(final_upstream_request);
+  if (reset_other_upstreams && final_upstream_request->hedged()) {
+    cluster_->trafficStats()->upstream_rq_hedge_won_.inc();
+  }
   // Now put the final request back on this list.
   LinkedList::moveIntoList(std::move(final_upstream_request), upstream_requests_);
 }
@@ -1735,6 +1801,13 @@ void Filter::onUpstreamHeaders(uint64_t response_code, Http::ResponseHeaderMapPt
           : Upstream::Outlier::Result::ExtOriginRequestSuccess,
       response_code_for_outlier_detection);
 
+  // The hedge delay follows the latencies of the successful requests of the route. Failures may
+  // be fast or slow regardless of the latency of the upstream.
+  if (adaptive_hedging_.has_value() && response_code_for_outlier_detection < 500) {
+    adaptive_hedging_->recordLatency(std::chrono::duration_cast<std::chrono::microseconds>(
+        callbacks_->dispatcher().timeSource().monotonicTime() - upstream_request.startTime()));
+  }
+
   maybeProcessOrcaLoadReport(*headers, upstream_request);
 
   if (headers->EnvoyImmediateHealthCheckFail() != nullptr) {
@@ -2262,6 +2335,8 @@ void Filter::continueDoRetry(bool can_send_early_data, bool can_use_http3,
                                    grpc_request_, hedging_params_.hedge_on_per_try_timeout_);
 
   UpstreamRequest* upstream_request_tmp = upstream_request.get();
+  // The retry races the requests in flight if it was started on a per try timeout with hedging.
+  upstream_request->hedged(!upstream_requests_.empty());
   LinkedList::moveIntoList(std::move(upstream_request), upstream_requests_);
   upstream_requests_.front()->acceptHeadersFromRouter(
       !callbacks_->decodingBuffer() && !downstream_trailers_ && downstream_end_stream_);
@@ -2271,7 +2346,8 @@ void Filter::continueDoRetry(bool can_send_early_data, bool can_use_http3,
   if (!upstream_requests_.empty() && (upstream_requests_.front().get() == upstream_request_tmp)) {
     if (callbacks_->decodingBuffer()) {
       // If we are doing a retry we need to make a copy.
-      Buffer::OwnedImpl copy(*callbacks_->decodingBuffer());
+      Buffer::OwnedImpl copy;
+      copyRequestBody(copy);
       upstream_requests_.front()->acceptDataFromRouter(copy, !downstream_trailers_ &&
                                                                  downstream_end_stream_);
     }
@@ -22,6 +22,7 @@
 #include "envoy/stream_info/stream_info.h"
 #include "envoy/upstream/cluster_manager.h"
 
+#include "source/common/buffer/shared_buffer.h"
 #include "source/common/common/hash.h"
 #include "source/common/common/hex.h"
 #include "source/common/common/logger.h"
@@ -306,7 +307,9 @@ public:
         request_buffer_overflowed_(false),
         allow_multiplexed_upstream_half_close_(Runtime::runtimeFeatureEnabled(
             "envoy.reloadable_features.allow_multiplexed_upstream_half_close")),
-        upstream_request_started_(false), orca_load_report_received_(false) {}
+        upstream_request_started_(false), orca_load_report_received_(false),
+        share_request_body_(Runtime::runtimeFeatureEnabled(
+            "envoy.reloadable_features.router_shared_request_body")) {}
 
   ~Filter() override;
 
@@ -595,6 +598,8 @@ private:
   void onUpstreamAbort(Http::Code code, StreamInfo::CoreResponseFlag response_flag,
                        absl::string_view body, bool dropped, absl::string_view details);
   void onUpstreamComplete(UpstreamRequest& upstream_request);
+  // Add the buffered request body to the body of a retry.
+  void copyRequestBody(Buffer::Instance& copy);
   // Reset all in-flight upstream requests.
   void resetAll();
   // Reset all in-flight upstream requests that do NOT match the passed argument. This is used
@@ -635,6 +640,8 @@ private:
   std::unique_ptr<Stats::StatNameDynamicStorage> alt_stat_prefix_;
   const VirtualCluster* request_vcluster_{};
   RouteStatsContextOptRef route_stats_context_;
+  // The adaptive hedging of the route, if configured.
+  OptRef<AdaptiveHedging> adaptive_hedging_;
   std::function<void(Upstream::HostConstSharedPtr&& host, std::string details)> on_host_selected_;
   std::unique_ptr<Upstream::AsyncHostSelectionHandle> host_selection_cancelable_;
   Event::TimerPtr response_timeout_;
@@ -662,6 +669,8 @@ private:
   Network::Socket::OptionsSharedPtr upstream_options_;
   // Set of ongoing shadow streams which have not yet received end stream.
   absl::flat_hash_set<Http::AsyncClient::OngoingRequest*> shadow_streams_;
+  // The request body buffered for retries, whose slices the upstream requests share.
+  std::vector<Buffer::SharedBufferConstSharedPtr> shared_request_body_;
 
   // Keep small members (bools and enums) at the end of class, to reduce alignment overhead.
   uint64_t request_body_buffer_limit_{std::numeric_limits<uint64_t>::max()};
@@ -684,6 +693,7 @@ private:
   // Indicate that ORCA report is received to process it only once in either response headers or
   // trailers.
   bool orca_load_report_received_ : 1;
+  const bool share_request_body_ : 1;
 };
 
 class ProdFilter : public Filter {
@@ -155,6 +155,8 @@ public:
   bool outlierDetectionTimeoutRecorded() { return outlier_detection_timeout_recorded_; }
   void retried(bool value) { retried_ = value; }
   bool retried() { return retried_; }
+  void hedged(bool value) { hedged_ = value; }
+  bool hedged() { return hedged_; }
   bool grpcRqSuccessDeferred() { return grpc_rq_success_deferred_; }
   void grpcRqSuccessDeferred(bool deferred) { grpc_rq_success_deferred_ = deferred; }
   void upstreamCanary(bool value) { upstream_canary_ = value; }
@@ -168,6 +170,7 @@ public:
   // Exposes streamInfo for the upstream stream.
   StreamInfo::StreamInfo& streamInfo() { return stream_info_; }
   bool hadUpstream() const { return had_upstream_; }
+  MonotonicTime startTime() const { return start_time_; }
   // Disable per-try timeouts for websocket upgrades after successful handshake
   void disablePerTryTimeoutForWebsocketUpgrade();
 
@@ -242,6 +245,8 @@ private:
   bool router_sent_end_stream_ : 1;
   bool encode_trailers_ : 1;
   bool retried_ : 1;
+  // Whether the request was started while another request of the stream was in flight.
+  bool hedged_ : 1;
   bool awaiting_headers_ : 1;
   bool outlier_detection_timeout_recorded_ : 1;
   // Tracks whether we deferred a per try timeout because the downstream request
@@ -170,6 +170,10 @@ public:
     }
     return DynamicRouteEntry::filterDisabled(config_name);
   }
+  bool hasFilterDisabledOverrides() const override {
+    return !config_->per_filter_configs_->empty() ||
+           DynamicRouteEntry::hasFilterDisabledOverrides();
+  }
   const RouteSpecificFilterConfig*
   mostSpecificPerFilterConfig(absl::string_view name) const override {
     const auto* config = config_->per_filter_configs_->get(name);
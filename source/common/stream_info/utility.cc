@@ -31,22 +31,27 @@ const std::string ResponseFlagUtils::toShortString(const StreamInfo& stream_info
 }
 
 const std::string ResponseFlagUtils::toString(const StreamInfo& stream_info, bool use_long_name) {
-  // We don't expect more than 4 flags are set. Relax to 16 since the vector is allocated on stack
-  // anyway.
-  absl::InlinedVector<absl::string_view, 16> flag_strings_vec;
+  std::string result;
+  appendTo(stream_info, use_long_name, result);
+  return result;
+}
 
+void ResponseFlagUtils::appendTo(const StreamInfo& stream_info, bool use_long_name,
+                                 std::string& output) {
   const auto& all_flag_strings = responseFlagsVec();
+  const size_t start = output.size();
   for (const auto flag : stream_info.responseFlags()) {
     ASSERT(flag.value() < all_flag_strings.size(), "Flag value out of range");
 
     const auto flag_strings = all_flag_strings[flag.value()];
-    flag_strings_vec.push_back(use_long_name ? flag_strings.long_string_
-                                             : flag_strings.short_string_);
+    if (output.size() != start) {
+      output.push_back(',');
+    }
+    output.append(use_long_name ? flag_strings.long_string_ : flag_strings.short_string_);
   }
-  if (flag_strings_vec.empty()) {
-    return std::string(NONE);
+  if (output.size() == start) {
+    output.append(NONE);
   }
-  return absl::StrJoin(flag_strings_vec, ",");
 }
 
 ResponseFlagUtils::ResponseFlagsMapType& ResponseFlagUtils::mutableResponseFlagsMap() {
@@ -51,6 +51,8 @@ class ResponseFlagUtils {
 public:
   static const std::string toString(const StreamInfo& stream_info);
   static const std::string toShortString(const StreamInfo& stream_info);
+  // Appends what toString() or toShortString() return to the output.
+  static void appendTo(const StreamInfo& stream_info, bool use_long_name, std::string& output);
   static absl::optional<ResponseFlag> toResponseFlag(absl::string_view response_flag);
 
   struct FlagStrings {
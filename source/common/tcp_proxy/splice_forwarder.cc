@@ -0,0 +1,203 @@
+#include "source/common/tcp_proxy/splice_forwarder.h"
+
+#include "envoy/api/os_sys_calls.h"
+#include "envoy/event/dispatcher.h"
+
+#include "source/common/api/os_sys_calls_impl.h"
+#include "source/common/common/assert.h"
+#include "source/common/common/utility.h"
+#include "source/common/network/connection_impl.h"
+#include "source/common/network/io_socket_handle_impl.h"
+#include "source/common/network/raw_buffer_socket.h"
+
+#if defined(__linux__)
+#include <fcntl.h>
+
+#include "source/common/api/os_sys_calls_impl_linux.h"
+#endif
+
+namespace Envoy {
+namespace TcpProxy {
+
+namespace {
+
+// The default capacity of a pipe on Linux, which is the most a pipe holds without raising the
+// pipe size.
+constexpr size_t PipeCapacity = 64 * 1024;
+
+// The number of times a pipe is filled from the source of a direction in a single event, to
+// yield to other connections when both sockets keep up.
+constexpr uint32_t MaxPipeFillsPerEvent = 16;
+
+Api::SysCallSizeResult spliceFd(os_fd_t fd_in, os_fd_t fd_out, size_t length) {
+#if defined(__linux__)
+  return Api::LinuxOsSysCallsSingleton::get().splice(fd_in, fd_out, length,
+                                                     SPLICE_F_MOVE | SPLICE_F_NONBLOCK);
+#else
+  UNREFERENCED_PARAMETER(fd_in);
+  UNREFERENCED_PARAMETER(fd_out);
+  UNREFERENCED_PARAMETER(length);
+  return {-1, SOCKET_ERROR_NOT_SUP};
+#endif
+}
+
+Api::SysCallIntResult createPipe(int fds[2]) {
+#if defined(__linux__)
+  return Api::LinuxOsSysCallsSingleton::get().pipe2(fds, O_NONBLOCK | O_CLOEXEC);
+#else
+  UNREFERENCED_PARAMETER(fds);
+  return {-1, SOCKET_ERROR_NOT_SUP};
+#endif
+}
+
+} // namespace
+
+SpliceForwarder::Direction::Direction(Network::Connection& source, Network::Connection& sink,
+                                      bool upstream)
+    : source_(source), source_fd_(source.getSocket()->ioHandle().fdDoNotUse()),
+      sink_fd_(sink.getSocket()->ioHandle().fdDoNotUse()), upstream_(upstream) {}
+
+std::unique_ptr<SpliceForwarder> SpliceForwarder::create(Network::Connection& downstream,
+                                                         Network::Connection& upstream,
+                                                         Callbacks& callbacks) {
+  if (!canSplice(downstream) || !canSplice(upstream)) {
+    return nullptr;
+  }
+  std::unique_ptr<SpliceForwarder> forwarder(new SpliceForwarder(downstream, upstream, callbacks));
+  if (!forwarder->initialize()) {
+    return nullptr;
+  }
+  return forwarder;
+}
+
+bool SpliceForwarder::canSplice(Network::Connection& connection) {
+#if defined(__linux__)
+  auto* connection_impl = dynamic_cast<Network::ConnectionImpl*>(&connection);
+  if (connection_impl == nullptr || connection.state() != Network::Connection::State::Open ||
+      connection.connecting() || !connection.readEnabled() || !connection.isHalfCloseEnabled() ||
+      connection_impl->bufferedReadBytes() > 0 || connection_impl->bufferedWriteBytes() > 0) {
+    return false;
+  }
+  // Only a raw buffer transport socket writes the payload to the socket as is, and only the
+  // default IO handle reads from and writes to the socket directly.
+  return dynamic_cast<Network::RawBufferSocket*>(connection_impl->transportSocket().get()) !=
+             nullptr &&
+         dynamic_cast<Network::IoSocketHandleImpl*>(&connection_impl->ioHandle()) != nullptr;
+#else
+  UNREFERENCED_PARAMETER(connection);
+  return false;
+#endif
+}
+
+SpliceForwarder::SpliceForwarder(Network::Connection& downstream, Network::Connection& upstream,
+                                 Callbacks& callbacks)
+    : callbacks_(callbacks), to_upstream_(downstream, upstream, true),
+      to_downstream_(upstream, downstream, false) {}
+
+SpliceForwarder::~SpliceForwarder() {
+  downstream_event_.reset();
+  upstream_event_.reset();
+  for (Direction* direction : {&to_upstream_, &to_downstream_}) {
+    if (direction->active_ && direction->source_.state() == Network::Connection::State::Open) {
+      direction->source_.readDisable(false);
+    }
+    for (os_fd_t fd : {direction->pipe_read_fd_, direction->pipe_write_fd_}) {
+      if (fd != INVALID_SOCKET) {
+        Api::OsSysCallsSingleton::get().close(fd);
+      }
+    }
+  }
+}
+
+bool SpliceForwarder::initialize() {
+  for (Direction* direction : {&to_upstream_, &to_downstream_}) {
+    int fds[2];
+    const Api::SysCallIntResult result = createPipe(fds);
+    if (result.return_value_ != 0) {
+      ENVOY_LOG(debug, "unable to create splice pipe: {}", errorDetails(result.errno_));
+      return false;
+    }
+    direction->pipe_read_fd_ = fds[0];
+    direction->pipe_write_fd_ = fds[1];
+  }
+
+  for (Direction* direction : {&to_upstream_, &to_downstream_}) {
+    direction->source_.readDisable(true);
+    direction->active_ = true;
+  }
+
+  // The connections keep their own events on the sockets, which only wait for writes while they
+  // are read disabled.
+  Event::Dispatcher& dispatcher = to_upstream_.source_.dispatcher();
+  const uint32_t events = Event::FileReadyType::Read | Event::FileReadyType::Write;
+  downstream_event_ = dispatcher.createFileEvent(
+      to_upstream_.source_fd_,
+      [this](uint32_t) {
+        onFileEvent();
+        return absl::OkStatus();
+      },
+      Event::PlatformDefaultTriggerType, events);
+  upstream_event_ = dispatcher.createFileEvent(
+      to_downstream_.source_fd_,
+      [this](uint32_t) {
+        onFileEvent();
+        return absl::OkStatus();
+      },
+      Event::PlatformDefaultTriggerType, events);
+  return true;
+}
+
+void SpliceForwarder::onFileEvent() {
+  // Either socket becoming readable or writable may unblock either direction.
+  pump(to_upstream_, *downstream_event_);
+  pump(to_downstream_, *upstream_event_);
+}
+
+void SpliceForwarder::pump(Direction& direction, Event::FileEvent& source_event) {
+  uint32_t pipe_fills = 0;
+  while (direction.active_) {
+    while (direction.pipe_bytes_ > 0) {
+      const Api::SysCallSizeResult result =
+          spliceFd(direction.pipe_read_fd_, direction.sink_fd_, direction.pipe_bytes_);
+      if (result.return_value_ < 0) {
+        if (result.errno_ == SOCKET_ERROR_AGAIN) {
+          // Resumed once the sink is writable.
+          return;
+        }
+        ENVOY_LOG(debug, "splice to {} failed: {}", direction.upstream_ ? "upstream" : "downstream",
+                  errorDetails(result.errno_));
+        stop(direction);
+        return;
+      }
+      direction.pipe_bytes_ -= result.return_value_;
+      callbacks_.onSplicedBytes(direction.upstream_, result.return_value_);
+    }
+
+    if (++pipe_fills > MaxPipeFillsPerEvent) {
+      source_event.activate(Event::FileReadyType::Read);
+      return;
+    }
+
+    const Api::SysCallSizeResult result =
+        spliceFd(direction.source_fd_, direction.pipe_write_fd_, PipeCapacity);
+    if (result.return_value_ > 0) {
+      direction.pipe_bytes_ = result.return_value_;
+    } else if (result.return_value_ < 0 && result.errno_ == SOCKET_ERROR_AGAIN) {
+      // Resumed once the source is readable.
+      return;
+    } else {
+      // The end of stream or the error is raised by the source connection once it reads again.
+      stop(direction);
+    }
+  }
+}
+
+void SpliceForwarder::stop(Direction& direction) {
+  ASSERT(direction.active_);
+  direction.active_ = false;
+  direction.pipe_bytes_ = 0;
+  direction.source_.readDisable(false);
+}
+
+} // namespace TcpProxy
+} // namespace Envoy
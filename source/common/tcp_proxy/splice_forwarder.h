@@ -0,0 +1,92 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+
+#include "envoy/common/platform.h"
+#include "envoy/common/pure.h"
+#include "envoy/event/file_event.h"
+#include "envoy/network/connection.h"
+
+#include "source/common/common/logger.h"
+
+namespace Envoy {
+namespace TcpProxy {
+
+/**
+ * Moves the payload of a TCP proxy session between the downstream and upstream sockets with
+ * splice(2), through a pipe per direction, so that it is never copied to user space.
+ *
+ * While a direction is spliced its source connection is read disabled, so the payload bypasses the
+ * connection and its filter chain. Once the source socket of a direction reaches end of stream or
+ * fails, the direction stops being spliced and its source connection is read enabled again, so
+ * that the end of stream or error is raised through the connection as usual.
+ */
+class SpliceForwarder : protected Logger::Loggable<Logger::Id::filter> {
+public:
+  class Callbacks {
+  public:
+    virtual ~Callbacks() = default;
+
+    /**
+     * Called when bytes have been moved from one socket to the other.
+     * @param upstream true if the bytes were sent upstream, false if they were sent downstream.
+     * @param bytes supplies the number of bytes moved.
+     */
+    virtual void onSplicedBytes(bool upstream, uint64_t bytes) PURE;
+  };
+
+  /**
+   * @return a forwarder which splices the payload between the connections, or nullptr if splicing
+   *         is not supported for either connection or the pipes could not be created.
+   */
+  static std::unique_ptr<SpliceForwarder>
+  create(Network::Connection& downstream, Network::Connection& upstream, Callbacks& callbacks);
+
+  /**
+   * @return true if the payload of the connection can be spliced: it is an open and read enabled
+   *         plaintext connection of a kernel socket, with half close enabled and no buffered data.
+   */
+  static bool canSplice(Network::Connection& connection);
+
+  /**
+   * Stops splicing and read enables the source connections which are still open. Data moved into
+   * a pipe but not yet to its destination socket is dropped, so this is meant to be destroyed when
+   * the session is being closed.
+   */
+  ~SpliceForwarder();
+
+private:
+  struct Direction {
+    Direction(Network::Connection& source, Network::Connection& sink, bool upstream);
+
+    Network::Connection& source_;
+    const os_fd_t source_fd_;
+    const os_fd_t sink_fd_;
+    const bool upstream_;
+    os_fd_t pipe_read_fd_{INVALID_SOCKET};
+    os_fd_t pipe_write_fd_{INVALID_SOCKET};
+    // The number of bytes in the pipe which are not yet written to the sink.
+    uint64_t pipe_bytes_{};
+    bool active_{};
+  };
+
+  SpliceForwarder(Network::Connection& downstream, Network::Connection& upstream,
+                  Callbacks& callbacks);
+
+  bool initialize();
+  void onFileEvent();
+  void pump(Direction& direction, Event::FileEvent& source_event);
+  void stop(Direction& direction);
+
+  Callbacks& callbacks_;
+  Direction to_upstream_;
+  Direction to_downstream_;
+  Event::FileEventPtr downstream_event_;
+  Event::FileEventPtr upstream_event_;
+};
+
+using SpliceForwarderPtr = std::unique_ptr<SpliceForwarder>;
+
+} // namespace TcpProxy
+} // namespace Envoy
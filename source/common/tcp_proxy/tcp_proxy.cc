@@ -196,6 +196,7 @@ Config::SharedConfig::SharedConfig(
 Config::Config(const envoy::extensions::filters::network::tcp_proxy::v3::TcpProxy& config,
                Server::Configuration::FactoryContext& context)
     : max_connect_attempts_(PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, max_connect_attempts, 1)),
+      splice_data_(config.splice_data()),
       upstream_drain_manager_slot_(context.serverFactoryContext().threadLocal().allocateSlot()),
       shared_config_(std::make_shared<SharedConfig>(config, context)),
       random_generator_(context.serverFactoryContext().api().randomGenerator()),
@@ -420,6 +421,7 @@ void Filter::initialize(Network::ReadFilterCallbacks& callbacks, bool set_connec
 
   config_->stats().downstream_cx_total_.inc();
   if (set_connection_stats) {
+    downstream_connection_stats_ = true;
     read_callbacks_->connection().setConnectionStats(
         {config_->stats().downstream_cx_rx_bytes_total_,
          config_->stats().downstream_cx_rx_bytes_buffered_,
@@ -1009,6 +1011,8 @@ bool Filter::startUpstreamSecureTransport() {
 void Filter::onDownstreamEvent(Network::ConnectionEvent event) {
   if (event == Network::ConnectionEvent::LocalClose ||
       event == Network::ConnectionEvent::RemoteClose) {
+    // Stop splicing before the upstream connection is closed or handed to the drain manager.
+    splice_forwarder_.reset();
     downstream_closed_ = true;
     // Cancel the potential odcds callback.
     cluster_discovery_handle_ = nullptr;
@@ -1062,6 +1066,7 @@ void Filter::onUpstreamEvent(Network::ConnectionEvent event) {
 
   if (event == Network::ConnectionEvent::RemoteClose ||
       event == Network::ConnectionEvent::LocalClose) {
+    splice_forwarder_.reset();
     if (Runtime::runtimeFeatureEnabled(
             "envoy.restart_features.upstream_http_filters_with_tcp_proxy")) {
       read_callbacks_->connection().dispatcher().deferredDelete(std::move(upstream_));
@@ -1153,11 +1158,44 @@ void Filter::onUpstreamConnection() {
     }
   }
 
+  if (config_->spliceData() && upstream_ && upstream_->rawConnection() != nullptr) {
+    splice_forwarder_ =
+        SpliceForwarder::create(read_callbacks_->connection(), *upstream_->rawConnection(), *this);
+    if (splice_forwarder_ != nullptr) {
+      config_->stats().downstream_cx_spliced_total_.inc();
+      ENVOY_CONN_LOG(debug, "splicing payload to and from upstream", read_callbacks_->connection());
+    }
+  }
+
   if (config_->flushAccessLogOnConnected()) {
     flushAccessLog(AccessLog::AccessLogType::TcpUpstreamConnected);
   }
 }
 
+void Filter::onSplicedBytes(bool upstream, uint64_t bytes) {
+  // The payload bypasses both connections, so account for it as they would have.
+  if (upstream) {
+    getStreamInfo().getDownstreamBytesMeter()->addWireBytesReceived(bytes);
+    getStreamInfo().getUpstreamBytesMeter()->addWireBytesSent(bytes);
+    getStreamInfo().addBytesReceived(bytes);
+    if (downstream_connection_stats_) {
+      config_->stats().downstream_cx_rx_bytes_total_.add(bytes);
+    }
+    read_callbacks_->upstreamHost()->cluster().trafficStats()->upstream_cx_tx_bytes_total_.add(
+        bytes);
+  } else {
+    getStreamInfo().getUpstreamBytesMeter()->addWireBytesReceived(bytes);
+    getStreamInfo().getDownstreamBytesMeter()->addWireBytesSent(bytes);
+    getStreamInfo().addBytesSent(bytes);
+    if (downstream_connection_stats_) {
+      config_->stats().downstream_cx_tx_bytes_total_.add(bytes);
+    }
+    read_callbacks_->upstreamHost()->cluster().trafficStats()->upstream_cx_rx_bytes_total_.add(
+        bytes);
+  }
+  resetIdleTimer();
+}
+
 void Filter::onIdleTimeout() {
   ENVOY_CONN_LOG(debug, "Session timed out", read_callbacks_->connection());
   config_->stats().idle_timeout_.inc();
@@ -106,6 +106,13 @@ Ssl::ConnectionInfoConstSharedPtr TcpUpstream::getUpstreamConnectionSslInfo() {
   return nullptr;
 }
 
+Network::Connection* TcpUpstream::rawConnection() {
+  if (upstream_conn_data_ != nullptr) {
+    return &upstream_conn_data_->connection();
+  }
+  return nullptr;
+}
+
 Tcp::ConnectionPool::ConnectionData*
 TcpUpstream::onDownstreamEvent(Network::ConnectionEvent event) {
   // TODO(botengyao): propagate RST back to upstream connection if RST is received from downstream.
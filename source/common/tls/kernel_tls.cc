@@ -0,0 +1,403 @@
+#include "source/common/tls/kernel_tls.h"
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "envoy/api/os_sys_calls.h"
+
+#include "source/common/api/os_sys_calls_impl.h"
+#include "source/common/common/assert.h"
+#include "source/common/common/utility.h"
+#include "source/common/network/io_socket_handle_impl.h"
+
+#include "absl/strings/str_cat.h"
+#include "openssl/hkdf.h"
+#include "openssl/mem.h"
+
+#if defined(__linux__)
+#include <linux/tls.h>
+#include <netinet/tcp.h>
+
+#ifndef SOL_TLS
+#define SOL_TLS 282
+#endif
+#ifndef TCP_ULP
+#define TCP_ULP 31
+#endif
+#endif
+
+namespace Envoy {
+namespace Extensions {
+namespace TransportSockets {
+namespace Tls {
+namespace KernelTls {
+
+Session::~Session() {
+  OPENSSL_cleanse(read_secret_.data(), read_secret_.size());
+  OPENSSL_cleanse(write_secret_.data(), write_secret_.size());
+}
+
+#if defined(__linux__)
+namespace {
+
+// The keys of one direction of a session.
+struct TrafficKeys {
+  std::vector<uint8_t> key_;
+  // The fixed part of the nonce of TLS 1.2 AES-GCM sessions, or the whole IV otherwise.
+  std::vector<uint8_t> iv_;
+  uint64_t sequence_{};
+};
+
+union CryptoInfo {
+  tls_crypto_info info_;
+  tls12_crypto_info_aes_gcm_128 aes_gcm_128_;
+  tls12_crypto_info_aes_gcm_256 aes_gcm_256_;
+  tls12_crypto_info_chacha20_poly1305 chacha20_poly1305_;
+};
+
+void putSequence(uint64_t sequence, unsigned char out[8]) {
+  for (int i = 7; i >= 0; i--) {
+    out[i] = sequence & 0xff;
+    sequence >>= 8;
+  }
+}
+
+template <class T> size_t fillCryptoInfo(T& info, const TrafficKeys& keys) {
+  ASSERT(keys.key_.size() == sizeof(info.key));
+  memcpy(info.key, keys.key_.data(), sizeof(info.key));
+  putSequence(keys.sequence_, info.rec_seq);
+  if (keys.iv_.size() == sizeof(info.salt) + sizeof(info.iv)) {
+    memcpy(info.salt, keys.iv_.data(), sizeof(info.salt));
+    memcpy(info.iv, keys.iv_.data() + sizeof(info.salt), sizeof(info.iv));
+  } else {
+    // The explicit part of the nonce of TLS 1.2 AES-GCM records, which the kernel increments for
+    // every record, starts from the sequence number as it does with SSL.
+    ASSERT(keys.iv_.size() == sizeof(info.salt) && sizeof(info.iv) == sizeof(info.rec_seq));
+    memcpy(info.salt, keys.iv_.data(), sizeof(info.salt));
+    putSequence(keys.sequence_, info.iv);
+  }
+  return sizeof(info);
+}
+
+// HKDF-Expand-Label with an empty context, see https://www.rfc-editor.org/rfc/rfc8446#section-7.1.
+bool expandLabel(const EVP_MD* digest, const uint8_t* secret, size_t secret_length,
+                 absl::string_view label, std::vector<uint8_t>& out) {
+  const std::string full_label = absl::StrCat("tls13 ", label);
+  std::vector<uint8_t> info;
+  info.push_back(out.size() >> 8);
+  info.push_back(out.size() & 0xff);
+  info.push_back(full_label.size());
+  info.insert(info.end(), full_label.begin(), full_label.end());
+  info.push_back(0);
+  return HKDF_expand(out.data(), out.size(), digest, secret, secret_length, info.data(),
+                     info.size()) == 1;
+}
+
+absl::Status tls12Keys(SSL* ssl, size_t key_length, size_t iv_length, TrafficKeys& read_keys,
+                       TrafficKeys& write_keys) {
+  // The key block of AEAD ciphers has no MAC keys, see
+  // https://www.rfc-editor.org/rfc/rfc5246#section-6.3.
+  const size_t key_block_length = 2 * (key_length + iv_length);
+  if (SSL_get_key_block_len(ssl) != key_block_length) {
+    return absl::FailedPreconditionError("unexpected key block length");
+  }
+  std::vector<uint8_t> key_block(key_block_length);
+  if (SSL_generate_key_block(ssl, key_block.data(), key_block.size()) != 1) {
+    return absl::FailedPreconditionError("unable to generate the key block");
+  }
+  const uint8_t* client_key = key_block.data();
+  const uint8_t* server_key = client_key + key_length;
+  const uint8_t* client_iv = server_key + key_length;
+  const uint8_t* server_iv = client_iv + iv_length;
+  const bool is_server = SSL_is_server(ssl);
+  const uint8_t* read_key = is_server ? client_key : server_key;
+  const uint8_t* read_iv = is_server ? client_iv : server_iv;
+  const uint8_t* write_key = is_server ? server_key : client_key;
+  const uint8_t* write_iv = is_server ? server_iv : client_iv;
+  read_keys.key_.assign(read_key, read_key + key_length);
+  read_keys.iv_.assign(read_iv, read_iv + iv_length);
+  write_keys.key_.assign(write_key, write_key + key_length);
+  write_keys.iv_.assign(write_iv, write_iv + iv_length);
+  return absl::OkStatus();
+}
+
+// The traffic keys of a TLS 1.3 traffic secret, see
+// https://www.rfc-editor.org/rfc/rfc8446#section-7.3.
+bool tls13TrafficKeys(const Session& session, const std::vector<uint8_t>& secret,
+                      TrafficKeys& keys) {
+  keys.key_.resize(session.key_length_);
+  // All the supported ciphers have 96 bit nonces.
+  keys.iv_.resize(12);
+  return expandLabel(session.digest_, secret.data(), secret.size(), "key", keys.key_) &&
+         expandLabel(session.digest_, secret.data(), secret.size(), "iv", keys.iv_);
+}
+
+absl::Status tls13Keys(SSL* ssl, Session& session, TrafficKeys& read_keys,
+                       TrafficKeys& write_keys) {
+  bssl::Span<const uint8_t> read_secret;
+  bssl::Span<const uint8_t> write_secret;
+  if (!bssl::SSL_get_traffic_secrets(ssl, &read_secret, &write_secret)) {
+    return absl::FailedPreconditionError("unable to get the traffic secrets");
+  }
+  session.digest_ = SSL_CIPHER_get_handshake_digest(SSL_get_current_cipher(ssl));
+  session.read_secret_.assign(read_secret.begin(), read_secret.end());
+  session.write_secret_.assign(write_secret.begin(), write_secret.end());
+  if (!tls13TrafficKeys(session, session.read_secret_, read_keys) ||
+      !tls13TrafficKeys(session, session.write_secret_, write_keys)) {
+    return absl::FailedPreconditionError("unable to derive the traffic keys");
+  }
+  return absl::OkStatus();
+}
+
+size_t cryptoInfo(uint16_t version, int cipher_nid, const TrafficKeys& keys, CryptoInfo& info) {
+  memset(&info, 0, sizeof(info));
+  info.info_.version = version;
+  switch (cipher_nid) {
+  case NID_aes_128_gcm:
+    info.info_.cipher_type = TLS_CIPHER_AES_GCM_128;
+    return fillCryptoInfo(info.aes_gcm_128_, keys);
+  case NID_aes_256_gcm:
+    info.info_.cipher_type = TLS_CIPHER_AES_GCM_256;
+    return fillCryptoInfo(info.aes_gcm_256_, keys);
+  default:
+    ASSERT(cipher_nid == NID_chacha20_poly1305);
+    info.info_.cipher_type = TLS_CIPHER_CHACHA20_POLY1305;
+    return fillCryptoInfo(info.chacha20_poly1305_, keys);
+  }
+}
+
+Api::SysCallSizeResult sendRecord(os_fd_t fd, uint8_t record_type, uint8_t* data, size_t length) {
+  iovec iov{data, length};
+  alignas(cmsghdr) char control[CMSG_SPACE(sizeof(uint8_t))] = {};
+  msghdr message{};
+  message.msg_iov = &iov;
+  message.msg_iovlen = 1;
+  message.msg_control = control;
+  message.msg_controllen = sizeof(control);
+  cmsghdr* cmsg = CMSG_FIRSTHDR(&message);
+  cmsg->cmsg_level = SOL_TLS;
+  cmsg->cmsg_type = TLS_SET_RECORD_TYPE;
+  cmsg->cmsg_len = CMSG_LEN(sizeof(uint8_t));
+  *CMSG_DATA(cmsg) = record_type;
+  return Api::OsSysCallsSingleton::get().sendmsg(fd, &message, 0);
+}
+
+// Moves one direction of a TLS 1.3 session to its next traffic secret, see
+// https://www.rfc-editor.org/rfc/rfc8446#section-7.2.
+absl::Status updateKeys(os_fd_t fd, Session& session, bool read) {
+  std::vector<uint8_t>& secret = read ? session.read_secret_ : session.write_secret_;
+  std::vector<uint8_t> next_secret(secret.size());
+  TrafficKeys keys;
+  if (!expandLabel(session.digest_, secret.data(), secret.size(), "traffic upd", next_secret) ||
+      !tls13TrafficKeys(session, next_secret, keys)) {
+    return absl::InternalError("unable to derive the next traffic keys");
+  }
+  OPENSSL_cleanse(secret.data(), secret.size());
+  secret.swap(next_secret);
+
+  CryptoInfo info;
+  const size_t info_length = cryptoInfo(TLS_1_3_VERSION, session.cipher_nid_, keys, info);
+  const Api::SysCallIntResult result = Api::OsSysCallsSingleton::get().setsockopt(
+      fd, SOL_TLS, read ? TLS_RX : TLS_TX, &info, info_length);
+  OPENSSL_cleanse(&info, sizeof(info));
+  OPENSSL_cleanse(keys.key_.data(), keys.key_.size());
+  if (result.return_value_ != 0) {
+    // Kernels without support for key updates refuse to replace the keys.
+    const std::string details =
+        absl::StrCat("unable to update the keys: ", errorDetails(result.errno_));
+    return result.errno_ == EBUSY ? absl::FailedPreconditionError(details)
+                                  : absl::InternalError(details);
+  }
+  return absl::OkStatus();
+}
+
+} // namespace
+
+absl::Status enable(SSL* ssl, Network::IoHandle& io_handle, Session& session) {
+  // Other IO handles either do not own a kernel socket or do not read from it directly.
+  if (dynamic_cast<Network::IoSocketHandleImpl*>(&io_handle) == nullptr || !io_handle.isOpen()) {
+    return absl::FailedPreconditionError("not a kernel socket");
+  }
+  if (SSL_has_pending(ssl)) {
+    return absl::FailedPreconditionError("data is buffered by SSL");
+  }
+
+  uint16_t version;
+  switch (SSL_version(ssl)) {
+  case TLS1_2_VERSION:
+    version = TLS_1_2_VERSION;
+    break;
+  case TLS1_3_VERSION:
+    version = TLS_1_3_VERSION;
+    break;
+  default:
+    return absl::FailedPreconditionError("unsupported TLS version");
+  }
+
+  const SSL_CIPHER* cipher = SSL_get_current_cipher(ssl);
+  const int cipher_nid = cipher != nullptr ? SSL_CIPHER_get_cipher_nid(cipher) : NID_undef;
+  size_t key_length;
+  // The length of the part of the nonce derived from the key block in TLS 1.2.
+  size_t tls12_iv_length;
+  switch (cipher_nid) {
+  case NID_aes_128_gcm:
+    key_length = TLS_CIPHER_AES_GCM_128_KEY_SIZE;
+    tls12_iv_length = TLS_CIPHER_AES_GCM_128_SALT_SIZE;
+    break;
+  case NID_aes_256_gcm:
+    key_length = TLS_CIPHER_AES_GCM_256_KEY_SIZE;
+    tls12_iv_length = TLS_CIPHER_AES_GCM_256_SALT_SIZE;
+    break;
+  case NID_chacha20_poly1305:
+    key_length = TLS_CIPHER_CHACHA20_POLY1305_KEY_SIZE;
+    tls12_iv_length = TLS_CIPHER_CHACHA20_POLY1305_IV_SIZE;
+    break;
+  default:
+    return absl::FailedPreconditionError("unsupported cipher");
+  }
+
+  session.version_ = version;
+  session.cipher_nid_ = cipher_nid;
+  session.key_length_ = key_length;
+  TrafficKeys read_keys;
+  TrafficKeys write_keys;
+  absl::Status status = version == TLS_1_2_VERSION
+                            ? tls12Keys(ssl, key_length, tls12_iv_length, read_keys, write_keys)
+                            : tls13Keys(ssl, session, read_keys, write_keys);
+  if (!status.ok()) {
+    return status;
+  }
+  read_keys.sequence_ = SSL_get_read_sequence(ssl);
+  write_keys.sequence_ = SSL_get_write_sequence(ssl);
+
+  auto& os_sys_calls = Api::OsSysCallsSingleton::get();
+  const os_fd_t fd = io_handle.fdDoNotUse();
+  // Until keys are installed, the TLS upper layer protocol passes data through as is.
+  constexpr char ulp[] = "tls";
+  Api::SysCallIntResult result = os_sys_calls.setsockopt(fd, SOL_TCP, TCP_ULP, ulp, sizeof(ulp));
+  if (result.return_value_ != 0) {
+    return absl::FailedPreconditionError(absl::StrCat(
+        "unable to attach the TLS upper layer protocol: ", errorDetails(result.errno_)));
+  }
+
+  CryptoInfo info;
+  size_t info_length = cryptoInfo(version, cipher_nid, write_keys, info);
+  result = os_sys_calls.setsockopt(fd, SOL_TLS, TLS_TX, &info, info_length);
+  OPENSSL_cleanse(&info, sizeof(info));
+  if (result.return_value_ != 0) {
+    return absl::FailedPreconditionError(
+        absl::StrCat("unable to install the transmit keys: ", errorDetails(result.errno_)));
+  }
+  info_length = cryptoInfo(version, cipher_nid, read_keys, info);
+  result = os_sys_calls.setsockopt(fd, SOL_TLS, TLS_RX, &info, info_length);
+  OPENSSL_cleanse(&info, sizeof(info));
+  if (result.return_value_ != 0) {
+    // The transmit keys can not be removed once installed.
+    return absl::InternalError(
+        absl::StrCat("unable to install the receive keys: ", errorDetails(result.errno_)));
+  }
+  return absl::OkStatus();
+}
+
+Api::SysCallSizeResult read(os_fd_t fd, void* buffer, size_t length, uint8_t& record_type) {
+  iovec iov{buffer, length};
+  alignas(cmsghdr) char control[CMSG_SPACE(sizeof(uint8_t))];
+  msghdr message{};
+  message.msg_iov = &iov;
+  message.msg_iovlen = 1;
+  message.msg_control = control;
+  message.msg_controllen = sizeof(control);
+  const Api::SysCallSizeResult result = Api::OsSysCallsSingleton::get().recvmsg(fd, &message, 0);
+  record_type = RecordTypeApplicationData;
+  if (result.return_value_ > 0) {
+    const cmsghdr* cmsg = CMSG_FIRSTHDR(&message);
+    if (cmsg != nullptr && cmsg->cmsg_level == SOL_TLS && cmsg->cmsg_type == TLS_GET_RECORD_TYPE) {
+      record_type = *CMSG_DATA(cmsg);
+    }
+  }
+  return result;
+}
+
+Api::SysCallSizeResult sendCloseNotify(os_fd_t fd) {
+  // A warning level close_notify alert.
+  uint8_t alert[] = {1, AlertCloseNotify};
+  return sendRecord(fd, RecordTypeAlert, alert, sizeof(alert));
+}
+
+absl::Status onHandshakeMessages(os_fd_t fd, Session& session,
+                                 absl::Span<const uint8_t> messages) {
+  if (session.version_ != TLS_1_3_VERSION) {
+    // Renegotiation is not supported.
+    return absl::InvalidArgumentError("handshake message after the handshake");
+  }
+  while (!messages.empty()) {
+    // A message starts with its type and the 24 bit length of its body.
+    if (messages.size() < 4) {
+      return absl::InvalidArgumentError("truncated handshake message");
+    }
+    const uint8_t type = messages[0];
+    const size_t length = (messages[1] << 16) | (messages[2] << 8) | messages[3];
+    if (messages.size() - 4 < length) {
+      return absl::InvalidArgumentError("truncated handshake message");
+    }
+    const absl::Span<const uint8_t> body = messages.subspan(4, length);
+    messages.remove_prefix(4 + length);
+
+    switch (type) {
+    case HandshakeNewSessionTicket:
+      break;
+    case HandshakeKeyUpdate: {
+      // The body tells whether the peer requests a key update in return.
+      if (body.size() != 1 || body[0] > 1) {
+        return absl::InvalidArgumentError("invalid key update");
+      }
+      absl::Status status = updateKeys(fd, session, true);
+      if (!status.ok() || body[0] == 0) {
+        return status;
+      }
+      // The KeyUpdate is sent with the current keys, it does not request a key update in return.
+      uint8_t key_update[] = {HandshakeKeyUpdate, 0, 0, 1, 0};
+      const Api::SysCallSizeResult result =
+          sendRecord(fd, RecordTypeHandshake, key_update, sizeof(key_update));
+      if (result.return_value_ != sizeof(key_update)) {
+        return absl::InternalError(
+            absl::StrCat("unable to send a key update: ", errorDetails(result.errno_)));
+      }
+      status = updateKeys(fd, session, false);
+      if (!status.ok()) {
+        return status;
+      }
+      break;
+    }
+    default:
+      return absl::InvalidArgumentError(
+          absl::StrCat("unexpected handshake message: ", static_cast<int>(type)));
+    }
+  }
+  return absl::OkStatus();
+}
+
+#else
+
+absl::Status enable(SSL*, Network::IoHandle&, Session&) {
+  return absl::FailedPreconditionError("kernel TLS is only supported on Linux");
+}
+
+Api::SysCallSizeResult read(os_fd_t, void*, size_t, uint8_t&) {
+  return {-1, SOCKET_ERROR_NOT_SUP};
+}
+
+Api::SysCallSizeResult sendCloseNotify(os_fd_t) { return {-1, SOCKET_ERROR_NOT_SUP}; }
+
+absl::Status onHandshakeMessages(os_fd_t, Session&, absl::Span<const uint8_t>) {
+  return absl::UnimplementedError("kernel TLS is only supported on Linux");
+}
+
+#endif
+
+} // namespace KernelTls
+} // namespace Tls
+} // namespace TransportSockets
+} // namespace Extensions
+} // namespace Envoy
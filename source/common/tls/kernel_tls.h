@@ -0,0 +1,103 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "envoy/api/os_sys_calls_common.h"
+#include "envoy/common/platform.h"
+#include "envoy/network/io_handle.h"
+
+#include "absl/status/status.h"
+#include "absl/types/span.h"
+#include "openssl/ssl.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace TransportSockets {
+namespace Tls {
+namespace KernelTls {
+
+// TLS record content types, see https://www.rfc-editor.org/rfc/rfc8446#section-5.1.
+constexpr uint8_t RecordTypeAlert = 21;
+constexpr uint8_t RecordTypeHandshake = 22;
+constexpr uint8_t RecordTypeApplicationData = 23;
+
+// The description of the close_notify alert.
+constexpr uint8_t AlertCloseNotify = 0;
+
+// The types of the TLS 1.3 post-handshake messages, see
+// https://www.rfc-editor.org/rfc/rfc8446#section-4.6.
+constexpr uint8_t HandshakeNewSessionTicket = 4;
+constexpr uint8_t HandshakeKeyUpdate = 24;
+
+/**
+ * What is kept of a session whose record layer is offloaded to follow the key updates of TLS 1.3.
+ * The traffic secrets are cleansed on destruction.
+ */
+struct Session {
+  ~Session();
+
+  uint16_t version_{};
+  int cipher_nid_{NID_undef};
+  size_t key_length_{};
+  const EVP_MD* digest_{};
+  std::vector<uint8_t> read_secret_;
+  std::vector<uint8_t> write_secret_;
+};
+
+/**
+ * Offloads the record layer of an established TLS 1.2 or TLS 1.3 session to the kernel (kTLS) by
+ * installing the transmit and receive keys of the session on its socket. From then on, plaintext
+ * written to the socket is sent as application data records and the payload of the received
+ * records is read from it, so the session must no longer be read from or written to with SSL.
+ *
+ * Only AES-128-GCM, AES-256-GCM and ChaCha20-Poly1305 sessions on a plain TCP socket without any
+ * data buffered by SSL can be offloaded.
+ *
+ * @param ssl supplies the session, which must have completed its handshake.
+ * @param io_handle supplies the handle of the socket of the session.
+ * @param session is set to what onHandshakeMessages() needs of the session.
+ * @return absl::OkStatus() if the record layer has been offloaded. A FailedPrecondition status if
+ *         it can not be offloaded, in which case the session is left as is and keeps being read
+ *         from and written to with SSL. Any other error leaves the session unusable.
+ */
+absl::Status enable(SSL* ssl, Network::IoHandle& io_handle, Session& session);
+
+/**
+ * Handles the payload of a handshake record received on a socket with an offloaded record layer.
+ * NewSessionTicket messages are ignored, since the offloaded session is never resumed. A KeyUpdate
+ * installs the next receive keys, and if the peer requests it, sends a KeyUpdate and installs the
+ * next transmit keys.
+ * @param fd supplies the socket.
+ * @param session supplies the session, whose secrets are updated.
+ * @param messages supplies the payload of the record, which must hold whole messages.
+ * @return absl::OkStatus() if the messages have been handled, otherwise the session is unusable.
+ *         A FailedPrecondition status if the kernel can not update the keys.
+ */
+absl::Status onHandshakeMessages(os_fd_t fd, Session& session,
+                                 absl::Span<const uint8_t> messages);
+
+/**
+ * Reads the payload of the next received records from a socket with an offloaded record layer.
+ * The payload of records of different content types is never returned by the same read.
+ * @param fd supplies the socket.
+ * @param buffer supplies the buffer to read into.
+ * @param length supplies the length of the buffer.
+ * @param record_type is set to the content type of the records read.
+ * @return the number of bytes read, 0 at the end of stream, or -1 and the error.
+ */
+Api::SysCallSizeResult read(os_fd_t fd, void* buffer, size_t length, uint8_t& record_type);
+
+/**
+ * Sends a close_notify alert on a socket with an offloaded record layer.
+ * @param fd supplies the socket.
+ * @return the number of bytes written, or -1 and the error.
+ */
+Api::SysCallSizeResult sendCloseNotify(os_fd_t fd);
+
+} // namespace KernelTls
+} // namespace Tls
+} // namespace TransportSockets
+} // namespace Extensions
+} // namespace Envoy
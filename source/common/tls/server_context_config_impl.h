@@ -42,6 +42,7 @@ public:
 
   bool fullScanCertsOnSNIMismatch() const override { return full_scan_certs_on_sni_mismatch_; }
   bool preferClientCiphers() const override { return prefer_client_ciphers_; }
+  bool kernelTlsOffload() const override { return kernel_tls_offload_; }
 
   Ssl::TlsCertificateSelectorFactory tlsCertificateSelectorFactory() const override;
 
@@ -79,6 +80,7 @@ private:
   const bool disable_stateful_session_resumption_;
   bool full_scan_certs_on_sni_mismatch_;
   const bool prefer_client_ciphers_;
+  const bool kernel_tls_offload_;
 };
 
 } // namespace Tls
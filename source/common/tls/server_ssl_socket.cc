@@ -64,8 +64,9 @@ Network::TransportSocketPtr ServerSslSocketFactory::createDownstreamTransportSoc
     ssl_ctx = ssl_ctx_;
   }
   if (ssl_ctx) {
-    auto status_or_socket = SslSocket::create(std::move(ssl_ctx), InitialState::Server, nullptr,
-                                              config_->createHandshaker());
+    auto status_or_socket =
+        SslSocket::create(std::move(ssl_ctx), InitialState::Server, nullptr,
+                          config_->createHandshaker(), nullptr, config_->kernelTlsOffload());
     if (status_or_socket.ok()) {
       return std::move(*status_or_socket);
     }
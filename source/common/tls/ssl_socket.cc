@@ -10,6 +10,7 @@
 #include "source/common/tls/ssl_handshaker.h"
 #include "source/common/tls/utility.h"
 
+#include "absl/strings/str_cat.h"
 #include "absl/strings/str_replace.h"
 #include "openssl/err.h"
 #include "openssl/x509v3.h"
@@ -33,8 +34,9 @@ absl::StatusOr<std::unique_ptr<SslSocket>>
 SslSocket::create(Envoy::Ssl::ContextSharedPtr ctx, InitialState state,
                   const Network::TransportSocketOptionsConstSharedPtr& transport_socket_options,
                   Ssl::HandshakerFactoryCb handshaker_factory_cb,
-                  Upstream::HostDescriptionConstSharedPtr host) {
-  std::unique_ptr<SslSocket> socket(new SslSocket(ctx, transport_socket_options));
+                  Upstream::HostDescriptionConstSharedPtr host, bool kernel_tls_offload) {
+  std::unique_ptr<SslSocket> socket(
+      new SslSocket(ctx, transport_socket_options, kernel_tls_offload));
   auto status = socket->initialize(state, handshaker_factory_cb, host);
   if (status.ok()) {
     return socket;
@@ -44,9 +46,12 @@ SslSocket::create(Envoy::Ssl::ContextSharedPtr ctx, InitialState state,
 }
 
 SslSocket::SslSocket(Envoy::Ssl::ContextSharedPtr ctx,
-                     const Network::TransportSocketOptionsConstSharedPtr& transport_socket_options)
+                     const Network::TransportSocketOptionsConstSharedPtr& transport_socket_options,
+                     bool kernel_tls_offload)
     : transport_socket_options_(transport_socket_options),
-      ctx_(std::dynamic_pointer_cast<ContextImpl>(ctx)) {}
+      ctx_(std::dynamic_pointer_cast<ContextImpl>(ctx)),
+      kernel_tls_state_(kernel_tls_offload ? KernelTlsState::Requested
+                                           : KernelTlsState::Disabled) {}
 
 absl::Status SslSocket::initialize(InitialState state,
                                    Ssl::HandshakerFactoryCb handshaker_factory_cb,
@@ -116,6 +121,12 @@ Network::IoResult SslSocket::doRead(Buffer::Instance& read_buffer) {
       return {action, 0, false};
     }
   }
+  if (kernel_tls_state_ == KernelTlsState::Enabled) {
+    return kernelTlsRead(read_buffer);
+  }
+  if (kernel_tls_state_ == KernelTlsState::Failed) {
+    return {PostIoAction::Close, 0, false};
+  }
 
   bool keep_reading = true;
   bool end_stream = false;
@@ -172,6 +183,86 @@ Network::IoResult SslSocket::doRead(Buffer::Instance& read_buffer) {
   return {action, bytes_read, end_stream};
 }
 
+Network::IoResult SslSocket::kernelTlsRead(Buffer::Instance& read_buffer) {
+  const os_fd_t fd = callbacks_->ioHandle().fdDoNotUse();
+  bool keep_reading = true;
+  bool end_stream = false;
+  PostIoAction action = PostIoAction::KeepOpen;
+  uint64_t bytes_read = 0;
+  while (keep_reading) {
+    uint64_t bytes_read_this_iteration = 0;
+    Buffer::Reservation reservation = read_buffer.reserveForRead();
+    for (uint64_t i = 0; i < reservation.numSlices() && keep_reading; i++) {
+      uint8_t* mem = static_cast<uint8_t*>(reservation.slices()[i].mem_);
+      size_t remaining = reservation.slices()[i].len_;
+      while (remaining > 0) {
+        uint8_t record_type;
+        const Api::SysCallSizeResult result = KernelTls::read(fd, mem, remaining, record_type);
+        ENVOY_CONN_LOG(trace, "kernel tls read returns: {}", callbacks_->connection(),
+                       result.return_value_);
+        if (result.return_value_ > 0 && record_type == KernelTls::RecordTypeApplicationData) {
+          mem += result.return_value_;
+          remaining -= result.return_value_;
+          bytes_read_this_iteration += result.return_value_;
+          continue;
+        }
+
+        keep_reading = false;
+        if (result.return_value_ < 0) {
+          if (result.errno_ != SOCKET_ERROR_AGAIN) {
+            failure_reason_ =
+                absl::StrCat("TLS_error:kernel_tls_read:", errorDetails(result.errno_));
+            action = PostIoAction::Close;
+          }
+        } else if (result.return_value_ == 0) {
+          // Non-graceful shutdown by closing the underlying socket.
+          end_stream = true;
+        } else if (record_type == KernelTls::RecordTypeAlert && result.return_value_ == 2 &&
+                   mem[1] == KernelTls::AlertCloseNotify) {
+          // Graceful shutdown using close_notify TLS alert. The alert is not part of the payload,
+          // so it is not committed to the read buffer.
+          end_stream = true;
+        } else if (record_type == KernelTls::RecordTypeHandshake) {
+          // Post-handshake messages, such as session tickets and key updates, are not part of the
+          // payload either.
+          const absl::Status status = KernelTls::onHandshakeMessages(
+              fd, kernel_tls_session_, absl::MakeConstSpan(mem, result.return_value_));
+          if (status.ok()) {
+            keep_reading = true;
+            continue;
+          }
+          failure_reason_ =
+              absl::StrCat("TLS_error:kernel_tls_handshake_message:", status.message());
+          ctx_->stats().connection_error_.inc();
+          action = PostIoAction::Close;
+        } else {
+          // Other alerts need the TLS state which has been handed to the kernel.
+          failure_reason_ = absl::StrCat("TLS_error:kernel_tls_unexpected_record_type:",
+                                         static_cast<int>(record_type));
+          ctx_->stats().connection_error_.inc();
+          action = PostIoAction::Close;
+        }
+        break;
+      }
+    }
+
+    reservation.commit(bytes_read_this_iteration);
+    if (bytes_read_this_iteration > 0 && callbacks_->shouldDrainReadBuffer()) {
+      callbacks_->setTransportSocketIsReadable();
+      keep_reading = false;
+    }
+
+    bytes_read += bytes_read_this_iteration;
+  }
+
+  if (!failure_reason_.empty() && action == PostIoAction::Close) {
+    ENVOY_CONN_LOG(debug, "{}", callbacks_->connection(), failure_reason_);
+  }
+  ENVOY_CONN_LOG(trace, "kernel tls read {} bytes", callbacks_->connection(), bytes_read);
+
+  return {action, bytes_read, end_stream};
+}
+
 void SslSocket::onPrivateKeyMethodComplete() { resumeHandshake(); }
 
 void SslSocket::resumeHandshake() {
@@ -191,6 +282,9 @@ Network::Connection& SslSocket::connection() const { return callbacks_->connecti
 
 void SslSocket::onSuccess(SSL* ssl) {
   ctx_->logHandshake(ssl);
+  if (kernel_tls_state_ == KernelTlsState::Requested) {
+    enableKernelTls(ssl);
+  }
   if (callbacks_->connection().streamInfo().upstreamInfo()) {
     callbacks_->connection()
         .streamInfo()
@@ -206,6 +300,27 @@ void SslSocket::onSuccess(SSL* ssl) {
 
 void SslSocket::onFailure() { drainErrorQueue(); }
 
+void SslSocket::enableKernelTls(SSL* ssl) {
+  const absl::Status status = KernelTls::enable(ssl, callbacks_->ioHandle(), kernel_tls_session_);
+  if (status.ok()) {
+    ENVOY_CONN_LOG(debug, "TLS record layer offloaded to the kernel", callbacks_->connection());
+    ctx_->stats().kernel_tls_offload_.inc();
+    kernel_tls_state_ = KernelTlsState::Enabled;
+    return;
+  }
+
+  ENVOY_CONN_LOG(debug, "unable to offload the TLS record layer to the kernel: {}",
+                 callbacks_->connection(), status.message());
+  ctx_->stats().kernel_tls_offload_failed_.inc();
+  if (absl::IsFailedPrecondition(status)) {
+    // The session is left as is, so it keeps going through SSL.
+    kernel_tls_state_ = KernelTlsState::Disabled;
+  } else {
+    failure_reason_ = absl::StrCat("TLS_error:kernel_tls_offload:", status.message());
+    kernel_tls_state_ = KernelTlsState::Failed;
+  }
+}
+
 PostIoAction SslSocket::doHandshake() { return info_->doHandshake(); }
 
 void SslSocket::drainErrorQueue() {
@@ -262,6 +377,12 @@ Network::IoResult SslSocket::doWrite(Buffer::Instance& write_buffer, bool end_st
       return {action, 0, false};
     }
   }
+  if (kernel_tls_state_ == KernelTlsState::Enabled) {
+    return kernelTlsWrite(write_buffer, end_stream);
+  }
+  if (kernel_tls_state_ == KernelTlsState::Failed) {
+    return {PostIoAction::Close, 0, false};
+  }
 
   uint64_t bytes_to_write;
   if (bytes_to_retry_) {
@@ -313,14 +434,61 @@ Network::IoResult SslSocket::doWrite(Buffer::Instance& write_buffer, bool end_st
   return {PostIoAction::KeepOpen, total_bytes_written, false};
 }
 
+Network::IoResult SslSocket::kernelTlsWrite(Buffer::Instance& write_buffer, bool end_stream) {
+  // The kernel splits the plaintext into records as it is written.
+  uint64_t total_bytes_written = 0;
+  while (write_buffer.length() > 0) {
+    Api::IoCallUint64Result result = callbacks_->ioHandle().write(write_buffer);
+    ENVOY_CONN_LOG(trace, "kernel tls write returns: {}", callbacks_->connection(),
+                   result.return_value_);
+    if (!result.ok()) {
+      if (result.err_->getErrorCode() == Api::IoError::IoErrorCode::Again) {
+        break;
+      }
+      failure_reason_ = absl::StrCat("TLS_error:kernel_tls_write:", result.err_->getErrorDetails());
+      ENVOY_CONN_LOG(debug, "{}", callbacks_->connection(), failure_reason_);
+      return {PostIoAction::Close, total_bytes_written, false};
+    }
+    total_bytes_written += result.return_value_;
+  }
+
+  if (write_buffer.length() == 0 && end_stream) {
+    shutdownSsl();
+  }
+
+  return {PostIoAction::KeepOpen, total_bytes_written, false};
+}
+
 void SslSocket::onConnected() { ASSERT(info_->state() == Ssl::SocketState::PreHandshake); }
 
 Ssl::ConnectionInfoConstSharedPtr SslSocket::ssl() const { return info_; }
 
 void SslSocket::shutdownSsl() {
   ASSERT(info_->state() != Ssl::SocketState::PreHandshake);
+  if (kernel_tls_state_ == KernelTlsState::Failed) {
+    shutdownBasic();
+    return;
+  }
   if (info_->state() != Ssl::SocketState::ShutdownSent &&
       callbacks_->connection().state() != Network::Connection::State::Closed) {
+    if (kernel_tls_state_ == KernelTlsState::Enabled) {
+      // SSL no longer has the keys of the session, so the close_notify alert is sent by the
+      // kernel.
+      const Api::SysCallSizeResult result =
+          KernelTls::sendCloseNotify(callbacks_->ioHandle().fdDoNotUse());
+      ENVOY_CONN_LOG(debug, "kernel TLS shutdown: rc={}", callbacks_->connection(),
+                     result.return_value_);
+      if (result.return_value_ < 0) {
+        if (result.errno_ == SOCKET_ERROR_AGAIN) {
+          // Retried by the next write or close of the socket.
+          return;
+        }
+        failure_reason_ =
+            absl::StrCat("TLS_error:kernel_tls_close_notify:", errorDetails(result.errno_));
+      }
+      info_->setState(Ssl::SocketState::ShutdownSent);
+      return;
+    }
     int rc = SSL_shutdown(rawSsl());
     if constexpr (Event::PlatformDefaultTriggerType == Event::FileTriggerType::EmulatedEdge) {
       // Windows operate under `EmulatedEdge`. These are level events that are artificially
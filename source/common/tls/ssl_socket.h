@@ -16,6 +16,7 @@
 #include "source/common/common/logger.h"
 #include "source/common/network/transport_socket_options_impl.h"
 #include "source/common/tls/context_impl.h"
+#include "source/common/tls/kernel_tls.h"
 #include "source/common/tls/ssl_handshaker.h"
 #include "source/common/tls/utility.h"
 
@@ -52,7 +53,7 @@ public:
   create(Envoy::Ssl::ContextSharedPtr ctx, InitialState state,
          const Network::TransportSocketOptionsConstSharedPtr& transport_socket_options,
          Ssl::HandshakerFactoryCb handshaker_factory_cb,
-         Upstream::HostDescriptionConstSharedPtr host = {});
+         Upstream::HostDescriptionConstSharedPtr host = {}, bool kernel_tls_offload = false);
 
   // Network::TransportSocket
   void setTransportSocketCallbacks(Network::TransportSocketCallbacks& callbacks) override;
@@ -82,8 +83,20 @@ protected:
   SSL* rawSsl() const { return info_->ssl(); }
 
 private:
+  // The state of the offload of the record layer to the kernel.
+  enum class KernelTlsState {
+    // Not requested, or not possible for the session.
+    Disabled,
+    // Requested once the handshake is complete.
+    Requested,
+    Enabled,
+    // Partially enabled, which leaves the session unusable.
+    Failed
+  };
+
   SslSocket(Envoy::Ssl::ContextSharedPtr ctx,
-            const Network::TransportSocketOptionsConstSharedPtr& transport_socket_options);
+            const Network::TransportSocketOptionsConstSharedPtr& transport_socket_options,
+            bool kernel_tls_offload);
   absl::Status initialize(InitialState state, Ssl::HandshakerFactoryCb handshaker_factory_cb,
                           Upstream::HostDescriptionConstSharedPtr host);
 
@@ -93,6 +106,10 @@ private:
   };
   ReadResult sslReadIntoSlice(Buffer::RawSlice& slice);
 
+  void enableKernelTls(SSL* ssl);
+  Network::IoResult kernelTlsRead(Buffer::Instance& read_buffer);
+  Network::IoResult kernelTlsWrite(Buffer::Instance& write_buffer, bool end_stream);
+
   Network::PostIoAction doHandshake();
   void drainErrorQueue();
   void shutdownSsl();
@@ -104,6 +121,8 @@ private:
   ContextImplSharedPtr ctx_;
   uint64_t bytes_to_retry_{};
   std::string failure_reason_;
+  KernelTlsState kernel_tls_state_;
+  KernelTls::Session kernel_tls_session_;
 
   SslHandshakerImplSharedPtr info_;
 };
@@ -1110,6 +1110,11 @@ ClusterInfoImpl::ClusterInfoImpl(
           config.preconnect_policy(), per_upstream_preconnect_ratio, 1.0)),
       peekahead_ratio_(PROTOBUF_GET_WRAPPED_OR_DEFAULT(config.preconnect_policy(),
                                                        predictive_preconnect_ratio, 0)),
+      adaptive_preconnect_max_streams_(
+          config.preconnect_policy().has_adaptive_preconnect()
+              ? absl::make_optional<uint32_t>(PROTOBUF_GET_WRAPPED_OR_DEFAULT(
+                    config.preconnect_policy().adaptive_preconnect(), max_anticipated_streams, 10))
+              : absl::nullopt),
       socket_matcher_(std::move(socket_matcher)), stats_scope_(std::move(stats_scope)),
       traffic_stats_(generateStats(
           stats_scope_, factory_context.serverFactoryContext().clusterManager().clusterStatNames(),
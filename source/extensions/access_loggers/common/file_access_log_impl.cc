@@ -14,9 +14,22 @@ FileAccessLog::FileAccessLog(const Filesystem::FilePathAndType& access_log_file_
   log_file_ = file_or_error.value();
 }
 
+namespace {
+// Lines longer than this don't keep their buffer allocated after they are written.
+constexpr size_t MaxRetainedLogLineSize = 64 * 1024;
+} // namespace
+
 void FileAccessLog::emitLog(const Formatter::Context& context,
                             const StreamInfo::StreamInfo& stream_info) {
-  log_file_->write(formatter_->format(context, stream_info));
+  // The file copies the line into its own buffer, so the line buffer of each thread is reused
+  // across logs instead of allocating a string per log.
+  static thread_local std::string log_line;
+  log_line.clear();
+  formatter_->formatTo(context, stream_info, log_line);
+  log_file_->write(log_line);
+  if (log_line.capacity() > MaxRetainedLogLineSize) {
+    std::string().swap(log_line);
+  }
 }
 
 } // namespace File
@@ -493,6 +493,12 @@ EXTENSIONS = {
 
     "envoy.rbac.principals.mtls_authenticated":        "//source/extensions/filters/common/rbac/principals/mtls_authenticated:config",
 
+    #
+    # Connection balancers
+    #
+
+    "envoy.network.connection_balance.load_aware":     "//source/extensions/network/connection_balance/load_aware:config",
+
     #
     # DNS Resolver
     #
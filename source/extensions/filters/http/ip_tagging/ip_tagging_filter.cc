@@ -70,7 +70,12 @@ IpTaggingFilterConfig::IpTaggingFilterConfig(
     tag_data.emplace_back(ip_tag.ip_tag_name(), cidr_set);
     stat_name_set_->rememberBuiltin(absl::StrCat(ip_tag.ip_tag_name(), ".hit"));
   }
-  trie_ = std::make_unique<Network::LcTrie::LcTrie<std::string>>(tag_data);
+  if (config.ip_lookup_algorithm() ==
+      envoy::extensions::filters::http::ip_tagging::v3::IPTagging::POPTRIE) {
+    poptrie_ = std::make_unique<Network::Poptrie::Poptrie<std::string>>(tag_data);
+  } else {
+    trie_ = std::make_unique<Network::LcTrie::LcTrie<std::string>>(tag_data);
+  }
 }
 
 void IpTaggingFilterConfig::incCounter(Stats::StatName name) {
@@ -96,7 +101,7 @@ Http::FilterHeadersStatus IpTaggingFilter::decodeHeaders(Http::RequestHeaderMap&
   }
 
   std::vector<std::string> tags =
-      config_->trie().getData(callbacks_->streamInfo().downstreamAddressProvider().remoteAddress());
+      config_->getTags(callbacks_->streamInfo().downstreamAddressProvider().remoteAddress());
 
   applyTags(headers, tags);
   if (!tags.empty()) {
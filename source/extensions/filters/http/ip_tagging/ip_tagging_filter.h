@@ -15,6 +15,7 @@
 
 #include "source/common/network/cidr_range.h"
 #include "source/common/network/lc_trie.h"
+#include "source/common/network/poptrie.h"
 #include "source/common/stats/symbol_table.h"
 
 namespace Envoy {
@@ -40,7 +41,9 @@ public:
 
   Runtime::Loader& runtime() { return runtime_; }
   FilterRequestType requestType() const { return request_type_; }
-  const Network::LcTrie::LcTrie<std::string>& trie() const { return *trie_; }
+  std::vector<std::string> getTags(const Network::Address::InstanceConstSharedPtr& address) const {
+    return poptrie_ != nullptr ? poptrie_->getData(address) : trie_->getData(address);
+  }
 
   OptRef<const Http::LowerCaseString> ipTagHeader() const {
     if (ip_tag_header_.get().empty()) {
@@ -85,7 +88,9 @@ private:
   const Stats::StatName no_hit_;
   const Stats::StatName total_;
   const Stats::StatName unknown_tag_;
+  // Only one of the tries is built, depending on the configured IP lookup algorithm.
   std::unique_ptr<Network::LcTrie::LcTrie<std::string>> trie_;
+  std::unique_ptr<Network::Poptrie::Poptrie<std::string>> poptrie_;
   const Http::LowerCaseString
       ip_tag_header_; // An empty string indicates that no ip_tag_header is set.
   const HeaderAction ip_tag_header_action_;
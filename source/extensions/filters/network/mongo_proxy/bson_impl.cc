@@ -52,8 +52,8 @@ void BufferHelper::removeBytes(Buffer::Instance& data, uint8_t* out, size_t out_
 }
 
 std::string BufferHelper::removeCString(Buffer::Instance& data) {
-  char end = '\0';
-  ssize_t index = data.search(&end, sizeof(end), 0);
+  // The terminator is searched for with the vectorized byte set scan of the buffer.
+  ssize_t index = data.searchAnyOf(absl::string_view("\0", 1), 0, 0);
   if (index == -1) {
     throw EnvoyException("invalid CString");
   }
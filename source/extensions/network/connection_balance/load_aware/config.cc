@@ -0,0 +1,36 @@
+#include "source/extensions/network/connection_balance/load_aware/config.h"
+
+#include "envoy/config/core/v3/extension.pb.h"
+
+#include "source/common/protobuf/utility.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace Network {
+namespace ConnectionBalance {
+namespace LoadAware {
+
+Envoy::Network::ConnectionBalancerSharedPtr
+LoadAwareConnectionBalanceFactory::createConnectionBalancerFromProto(
+    const Protobuf::Message& config, Server::Configuration::FactoryContext& context) {
+  const auto& typed_config =
+      dynamic_cast<const envoy::config::core::v3::TypedExtensionConfig&>(config);
+  envoy::extensions::network::connection_balance::load_aware::v3::LoadAwareConnectionBalance
+      proto_config;
+  MessageUtil::anyConvertAndValidate(typed_config.typed_config(), proto_config,
+                                     context.messageValidationVisitor());
+
+  return std::make_shared<Envoy::Network::LoadAwareConnectionBalancerImpl>(
+      PROTOBUF_GET_WRAPPED_OR_DEFAULT(proto_config, connection_weight, 1),
+      PROTOBUF_GET_WRAPPED_OR_DEFAULT(proto_config, stream_weight, 1),
+      PROTOBUF_GET_WRAPPED_OR_DEFAULT(proto_config, busy_weight, 1),
+      PROTOBUF_PERCENT_TO_ROUNDED_INTEGER_OR_DEFAULT(proto_config, busy_threshold, 1000, 900));
+}
+
+REGISTER_FACTORY(LoadAwareConnectionBalanceFactory, Envoy::Network::ConnectionBalanceFactory);
+
+} // namespace LoadAware
+} // namespace ConnectionBalance
+} // namespace Network
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,37 @@
+#pragma once
+
+#include "envoy/extensions/network/connection_balance/load_aware/v3/load_aware.pb.h"
+#include "envoy/registry/registry.h"
+
+#include "source/common/network/connection_balancer_impl.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace Network {
+namespace ConnectionBalance {
+namespace LoadAware {
+
+/**
+ * Config registration for the load aware connection balancer.
+ */
+class LoadAwareConnectionBalanceFactory : public Envoy::Network::ConnectionBalanceFactory {
+public:
+  Envoy::Network::ConnectionBalancerSharedPtr
+  createConnectionBalancerFromProto(const Protobuf::Message& config,
+                                    Server::Configuration::FactoryContext& context) override;
+
+  ProtobufTypes::MessagePtr createEmptyConfigProto() override {
+    return std::make_unique<envoy::extensions::network::connection_balance::load_aware::v3::
+                                LoadAwareConnectionBalance>();
+  }
+
+  std::string name() const override { return "envoy.network.connection_balance.load_aware"; }
+};
+
+DECLARE_FACTORY(LoadAwareConnectionBalanceFactory);
+
+} // namespace LoadAware
+} // namespace ConnectionBalance
+} // namespace Network
+} // namespace Extensions
+} // namespace Envoy
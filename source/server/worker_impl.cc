@@ -3,6 +3,7 @@
 #include <functional>
 #include <memory>
 
+#include "envoy/config/bootstrap/v3/bootstrap.pb.h"
 #include "envoy/event/dispatcher.h"
 #include "envoy/event/timer.h"
 #include "envoy/network/exception.h"
@@ -12,6 +13,12 @@
 #include "source/common/config/utility.h"
 #include "source/server/listener_manager_factory.h"
 
+#if defined(__linux__)
+#include <sched.h>
+
+#include "source/common/api/os_sys_calls_impl_linux.h"
+#endif
+
 namespace Envoy {
 namespace Server {
 namespace {
@@ -30,6 +37,33 @@ std::unique_ptr<ConnectionHandler> getHandler(Event::Dispatcher& dispatcher, uin
   return nullptr;
 }
 
+// Returns the CPUs of the process affinity mask that worker `index` is pinned to, which are the
+// CPUs with `cpu % concurrency == index`. This matches the worker selected by the reuse port CPU
+// steering program of the listeners.
+std::vector<uint32_t> workerCpuAffinity(uint32_t index, uint32_t concurrency) {
+  std::vector<uint32_t> cpus;
+#if defined(__linux__)
+  cpu_set_t mask;
+  CPU_ZERO(&mask);
+  const Api::SysCallIntResult result =
+      Api::LinuxOsSysCallsSingleton::get().sched_getaffinity(0, sizeof(cpu_set_t), &mask);
+  if (result.return_value_ == -1) {
+    ENVOY_LOG_MISC(warn, "unable to get the CPU affinity of the process, not pinning worker {}",
+                   index);
+    return cpus;
+  }
+  for (uint32_t cpu = index; cpu < CPU_SETSIZE; cpu += concurrency) {
+    if (CPU_ISSET(cpu, &mask)) {
+      cpus.push_back(cpu);
+    }
+  }
+#else
+  UNREFERENCED_PARAMETER(index);
+  UNREFERENCED_PARAMETER(concurrency);
+#endif
+  return cpus;
+}
+
 } // namespace
 
 WorkerPtr ProdWorkerFactory::createWorker(uint32_t index, OverloadManager& overload_manager,
@@ -37,18 +71,28 @@ WorkerPtr ProdWorkerFactory::createWorker(uint32_t index, OverloadManager& overl
                                           const std::string& worker_name) {
   Event::DispatcherPtr dispatcher(
       api_.allocateDispatcher(worker_name, overload_manager.scaledTimerFactory()));
+  const auto& dispatcher_options = api_.bootstrap().dispatcher_options();
+  if (dispatcher_options.has_worker_hybrid_polling()) {
+    dispatcher->enableHybridPolling(
+        std::chrono::microseconds(Protobuf::util::TimeUtil::DurationToMicroseconds(
+            dispatcher_options.worker_hybrid_polling().spin_duration())));
+  }
   auto conn_handler = getHandler(*dispatcher, index, overload_manager, null_overload_manager);
-  return std::make_unique<WorkerImpl>(tls_, hooks_, std::move(dispatcher), std::move(conn_handler),
-                                      overload_manager, api_, stat_names_);
+  return std::make_unique<WorkerImpl>(
+      tls_, hooks_, std::move(dispatcher), std::move(conn_handler), overload_manager, api_,
+      stat_names_,
+      dispatcher_options.pin_workers_to_cpus() ? workerCpuAffinity(index, concurrency_)
+                                               : std::vector<uint32_t>{});
 }
 
 WorkerImpl::WorkerImpl(ThreadLocal::Instance& tls, ListenerHooks& hooks,
                        Event::DispatcherPtr&& dispatcher, Network::ConnectionHandlerPtr handler,
                        OverloadManager& overload_manager, Api::Api& api,
-                       WorkerStatNames& stat_names)
+                       WorkerStatNames& stat_names, std::vector<uint32_t> cpu_affinity)
     : tls_(tls), hooks_(hooks), dispatcher_(std::move(dispatcher)), handler_(std::move(handler)),
       api_(api), reset_streams_counter_(
-                     api_.rootScope().counterFromStatName(stat_names.reset_high_memory_stream_)) {
+                     api_.rootScope().counterFromStatName(stat_names.reset_high_memory_stream_)),
+      cpu_affinity_(std::move(cpu_affinity)) {
   tls_.registerThread(*dispatcher_, false);
   overload_manager.registerForAction(
       OverloadActionNames::get().StopAcceptingConnections, *dispatcher_,
@@ -115,6 +159,7 @@ void WorkerImpl::start(OptRef<GuardDog> guard_dog, const std::function<void()>&
   // TODO(jmarantz): consider refactoring how this naming works so this naming
   // architecture is centralized, resulting in clearer names.
   Thread::Options options{absl::StrCat("wrk:", dispatcher_->name())};
+  options.cpu_affinity_ = cpu_affinity_;
   thread_ = api_.threadFactory().createThread(
       [this, guard_dog, cb]() -> void { threadRoutine(guard_dog, cb); }, options);
 }
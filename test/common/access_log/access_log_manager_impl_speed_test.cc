@@ -0,0 +1,56 @@
+// Note: this should be run with --compilation_mode=opt, and would benefit from a
+// quiescent system with disabled cstate power management.
+
+#include "source/common/access_log/access_log_manager_impl.h"
+#include "source/common/stats/isolated_store_impl.h"
+
+#include "test/test_common/utility.h"
+
+#include "benchmark/benchmark.h"
+
+namespace Envoy {
+namespace AccessLog {
+namespace {
+
+constexpr uint32_t MaxThreads = 16;
+
+// A line of the default access log format.
+constexpr absl::string_view LogLine =
+    "[2024-05-14T09:21:36.412Z] \"GET /api/v2/accounts/8f14e45f/orders?status=open HTTP/1.1\" 200 "
+    "- 0 1843 12 11 \"10.0.3.17\" \"example-client/3.4.1\" "
+    "\"3b241101-e2bb-4255-8caf-4136c566a962\" \"api.example.com\" \"10.0.7.42:8080\"\n";
+
+// A log file written to /dev/null, so that the flush thread keeps up with the writers.
+struct AccessLogFixture {
+  AccessLogFixture()
+      : api_(Api::createApiForTest(store_)), dispatcher_(api_->allocateDispatcher("test_thread")),
+        access_log_manager_(std::chrono::milliseconds(1000), *api_, *dispatcher_, lock_, store_),
+        file_(access_log_manager_
+                  .createAccessLog(
+                      Filesystem::FilePathAndType{Filesystem::DestinationType::File, "/dev/null"})
+                  .value()) {}
+
+  Stats::IsolatedStoreImpl store_;
+  Api::ApiPtr api_;
+  Event::DispatcherPtr dispatcher_;
+  Thread::MutexBasicLockable lock_;
+  AccessLogManagerImpl access_log_manager_;
+  AccessLogFileSharedPtr file_;
+};
+
+// Writes log lines to the same file from the benchmark threads. The time per iteration is the time
+// a write takes on the writing thread, and the items per second are the log lines written per
+// second by all threads.
+static void bmAccessLogFileWrite(benchmark::State& state) {
+  static AccessLogFixture fixture;
+  for (auto _ : state) { // NOLINT
+    fixture.file_->write(LogLine);
+  }
+  state.SetItemsProcessed(state.iterations());
+  state.SetBytesProcessed(state.iterations() * LogLine.size());
+}
+BENCHMARK(bmAccessLogFileWrite)->ThreadRange(1, MaxThreads)->UseRealTime();
+
+} // namespace
+} // namespace AccessLog
+} // namespace Envoy
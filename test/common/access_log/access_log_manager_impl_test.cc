@@ -1,6 +1,8 @@
 #include <memory>
+#include <vector>
 
 #include "source/common/access_log/access_log_manager_impl.h"
+#include "source/common/common/fmt.h"
 #include "source/common/filesystem/file_shared_impl.h"
 
 #include "test/common/stats/stat_test_utility.h"
@@ -11,11 +13,14 @@
 #include "test/test_common/test_time.h"
 #include "test/test_common/utility.h"
 
+#include "absl/strings/numbers.h"
+#include "absl/strings/str_split.h"
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 
 using testing::_;
 using testing::ByMove;
+using testing::ElementsAre;
 using testing::Invoke;
 using testing::NiceMock;
 using testing::Return;
@@ -27,6 +32,34 @@ namespace Envoy {
 namespace AccessLog {
 namespace {
 
+TEST(WriteRingTest, WrapsAround) {
+  WriteRing ring(8);
+  EXPECT_EQ(8, ring.capacity());
+  EXPECT_TRUE(ring.write("abcdef"));
+  EXPECT_FALSE(ring.write("ghi"));
+  EXPECT_EQ(6, ring.size());
+
+  std::vector<absl::string_view> slices;
+  uint64_t end = ring.peek(slices);
+  EXPECT_THAT(slices, ElementsAre("abcdef"));
+  ring.consume(end);
+  EXPECT_EQ(0, ring.size());
+
+  EXPECT_TRUE(ring.write("ghijk"));
+  EXPECT_TRUE(ring.write("lmn"));
+  EXPECT_FALSE(ring.write("o"));
+  slices.clear();
+  end = ring.peek(slices);
+  EXPECT_THAT(slices, ElementsAre("gh", "ijklmn"));
+  ring.consume(end);
+
+  EXPECT_TRUE(ring.write(""));
+  EXPECT_TRUE(ring.write("o"));
+  slices.clear();
+  ring.peek(slices);
+  EXPECT_THAT(slices, ElementsAre("o"));
+}
+
 class AccessLogManagerImplTest : public testing::Test {
 protected:
   AccessLogManagerImplTest()
@@ -443,6 +476,88 @@ TEST_F(AccessLogManagerImplTest, BigDataChunkShouldBeFlushedWithoutTimer) {
   EXPECT_CALL(*file_, close_()).WillOnce(Return(ByMove(Filesystem::resultSuccess<bool>(true))));
 }
 
+// The lines of each thread are written in order and none is lost, even when the threads fill their
+// rings and write to the shared buffer.
+TEST_F(AccessLogManagerImplTest, ConcurrentWritesKeepTheOrderOfEachThread) {
+  EXPECT_CALL(*file_, open_(_)).WillOnce(Return(ByMove(Filesystem::resultSuccess<bool>(true))));
+  AccessLogFileSharedPtr log_file =
+      access_log_manager_
+          .createAccessLog(Filesystem::FilePathAndType{Filesystem::DestinationType::File, "foo"})
+          .value();
+
+  // MockFile calls write_() with its mutex held.
+  std::string written;
+  EXPECT_CALL(*file_, write_(_))
+      .WillRepeatedly(Invoke([&written](absl::string_view data) -> Api::IoCallSizeResult {
+        written.append(data);
+        return Filesystem::resultSuccess<ssize_t>(static_cast<ssize_t>(data.length()));
+      }));
+
+  constexpr uint32_t num_threads = 4;
+  constexpr uint32_t num_lines = 5000;
+  const std::string padding(64, 'x');
+  std::vector<Thread::ThreadPtr> threads;
+  for (uint32_t i = 0; i < num_threads; i++) {
+    threads.push_back(thread_factory_.createThread([&log_file, &padding, i]() {
+      for (uint32_t line = 0; line < num_lines; line++) {
+        log_file->write(fmt::format("{} {} {}\n", i, line, padding));
+      }
+    }));
+  }
+  for (Thread::ThreadPtr& thread : threads) {
+    thread->join();
+  }
+  log_file->flush();
+
+  std::vector<uint32_t> next_lines(num_threads);
+  {
+    absl::MutexLock lock(&file_->mutex_);
+    for (absl::string_view line : absl::StrSplit(written, '\n', absl::SkipEmpty())) {
+      const std::vector<absl::string_view> fields = absl::StrSplit(line, ' ');
+      ASSERT_EQ(3, fields.size());
+      uint32_t thread;
+      uint32_t number;
+      ASSERT_TRUE(absl::SimpleAtoi(fields[0], &thread));
+      ASSERT_TRUE(absl::SimpleAtoi(fields[1], &number));
+      ASSERT_LT(thread, num_threads);
+      ASSERT_EQ(next_lines[thread]++, number);
+    }
+  }
+  EXPECT_THAT(next_lines, testing::Each(num_lines));
+  EXPECT_EQ(0UL, store_.counter("filesystem.write_dropped").value());
+  EXPECT_EQ(num_threads * num_lines, store_.counter("filesystem.write_buffered").value());
+  EXPECT_TRUE(waitForGaugeEq("filesystem.write_total_buffered", 0));
+
+  EXPECT_CALL(*file_, close_()).WillOnce(Return(ByMove(Filesystem::resultSuccess<bool>(true))));
+}
+
+TEST_F(AccessLogManagerImplTest, DropWritesBeyondMaxBufferedBytes) {
+  AccessLogManagerImpl access_log_manager(timeout_40ms_, api_, dispatcher_, lock_, store_, 1024);
+  EXPECT_CALL(*file_, open_(_)).WillOnce(Return(ByMove(Filesystem::resultSuccess<bool>(true))));
+  AccessLogFileSharedPtr log_file =
+      access_log_manager
+          .createAccessLog(Filesystem::FilePathAndType{Filesystem::DestinationType::File, "foo"})
+          .value();
+
+  EXPECT_CALL(*file_, write_(_))
+      .WillOnce(Invoke([](absl::string_view data) -> Api::IoCallSizeResult {
+        EXPECT_EQ(data, "a");
+        return Filesystem::resultSuccess<ssize_t>(static_cast<ssize_t>(data.length()));
+      }));
+
+  log_file->write("a");
+  // This does not fit the ring of the thread, and exceeds the limit of the shared buffer.
+  log_file->write(std::string(1024 * 64 + 1, 'b'));
+  EXPECT_EQ(1UL, store_.counter("filesystem.write_dropped").value());
+  EXPECT_EQ(1UL, store_.counter("filesystem.write_buffered").value());
+
+  log_file->flush();
+  EXPECT_TRUE(file_->waitForEventCount(file_->num_writes_, 1));
+  EXPECT_TRUE(waitForGaugeEq("filesystem.write_total_buffered", 0));
+
+  EXPECT_CALL(*file_, close_()).WillOnce(Return(ByMove(Filesystem::resultSuccess<bool>(true))));
+}
+
 TEST_F(AccessLogManagerImplTest, ReopenAllFiles) {
   EXPECT_CALL(dispatcher_, createTimer_(_)).WillRepeatedly(ReturnNew<NiceMock<Event::MockTimer>>());
 
@@ -200,6 +200,14 @@ public:
     return asStringView().find({static_cast<const char*>(data), size}, start);
   }
 
+  ssize_t searchAnyOf(absl::string_view bytes, size_t start, size_t length) const override {
+    absl::string_view data = asStringView();
+    if (length != 0 && start < data.size()) {
+      data = data.substr(0, std::min<size_t>(data.size(), start + length));
+    }
+    return data.find_first_of(bytes, start);
+  }
+
   bool startsWith(absl::string_view data) const override {
     return absl::StartsWith(asStringView(), data);
   }
@@ -462,6 +470,18 @@ uint32_t bufferAction(Context& ctxt, char insert_value, uint32_t max_alloc, Buff
                 static_cast<ssize_t>(target_buffer.toString().find(content, offset)));
     break;
   }
+  case test::common::buffer::Action::kSearchAnyOf: {
+    const std::string& bytes = action.search_any_of().bytes();
+    const uint32_t offset = action.search_any_of().offset();
+    const uint32_t length = action.search_any_of().length();
+    std::string data = target_buffer.toString();
+    if (length != 0 && offset < data.size()) {
+      data.resize(std::min<size_t>(data.size(), static_cast<size_t>(offset) + length));
+    }
+    FUZZ_ASSERT(target_buffer.searchAnyOf(bytes, offset, length) ==
+                static_cast<ssize_t>(data.find_first_of(bytes, offset)));
+    break;
+  }
   case test::common::buffer::Action::kStartsWith: {
     const std::string data = target_buffer.toString();
     FUZZ_ASSERT(target_buffer.startsWith(action.starts_with()) ==
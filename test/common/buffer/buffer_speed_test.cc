@@ -2,8 +2,12 @@
 #include "envoy/http/stream_reset_handler.h"
 
 #include "source/common/buffer/buffer_impl.h"
+#include "source/common/buffer/search_kernels.h"
 #include "source/common/buffer/watermark_buffer.h"
 #include "source/common/common/assert.h"
+#include "source/common/stats/isolated_store_impl.h"
+
+#include "test/test_common/utility.h"
 
 #include "absl/strings/string_view.h"
 #include "benchmark/benchmark.h"
@@ -320,6 +324,60 @@ BENCHMARK(bufferReserveCommit)
     ->Arg(64 * 1024)
     ->Arg(128 * 1024);
 
+// Simulate proxying data between two connections: read into the downstream read buffer, move the
+// data to the upstream write buffer and drain it as if it had been written. Arg 0 is the size of
+// each read. Arg 1 selects the slice storage allocator: 0 for the global allocator, 1 for a
+// SliceStoragePool that retains nothing (so every slice allocation reaches the global allocator)
+// and 2 for a SliceStoragePool with its default retention limit. Reports the number of slice
+// storage allocations that reach the global allocator per MB proxied when a pool is installed.
+static void bufferProxyReadMoveDrain(benchmark::State& state) {
+  const uint64_t read_size = state.range(0);
+  const int64_t mode = state.range(1);
+  Stats::IsolatedStoreImpl store;
+  Buffer::SliceStoragePoolPtr pool;
+  if (mode != 0) {
+    pool = Buffer::SliceStoragePool::create(mode == 1 ? 0 : 4 * 1024 * 1024);
+    Buffer::SliceStoragePool::setCurrent(pool.get());
+    pool->initializeStats(*store.rootScope(), "pool.");
+  }
+
+  Buffer::OwnedImpl read_buffer;
+  Buffer::OwnedImpl write_buffer;
+  uint64_t bytes_proxied = 0;
+  for (auto _ : state) {
+    UNREFERENCED_PARAMETER(_);
+    Buffer::Reservation reservation = read_buffer.reserveForRead();
+    reservation.commit(std::min<uint64_t>(read_size, reservation.length()));
+    bytes_proxied += read_buffer.length();
+    write_buffer.move(read_buffer);
+    if (write_buffer.length() >= MaxBufferLength) {
+      write_buffer.drain(write_buffer.length());
+    }
+  }
+  write_buffer.drain(write_buffer.length());
+
+  if (pool != nullptr) {
+    const double megabytes = static_cast<double>(bytes_proxied) / (1024 * 1024);
+    state.counters["allocs_per_mb"] =
+        TestUtility::findCounter(store, "pool.misses")->value() / megabytes;
+    state.counters["hit_rate"] = benchmark::Counter(
+        TestUtility::findCounter(store, "pool.hits")->value() /
+        static_cast<double>(TestUtility::findCounter(store, "pool.hits")->value() +
+                            TestUtility::findCounter(store, "pool.misses")->value()));
+    Buffer::SliceStoragePool::setCurrent(nullptr);
+  }
+}
+BENCHMARK(bufferProxyReadMoveDrain)
+    ->Args({1024, 0})
+    ->Args({1024, 1})
+    ->Args({1024, 2})
+    ->Args({16 * 1024, 0})
+    ->Args({16 * 1024, 1})
+    ->Args({16 * 1024, 2})
+    ->Args({64 * 1024, 0})
+    ->Args({64 * 1024, 1})
+    ->Args({64 * 1024, 2});
+
 // Test the reserve+commit cycle, for the common case where the reserved space is
 // only partially used (and therefore the commit size is smaller than the reservation size).
 static void bufferReserveCommitPartial(benchmark::State& state) {
@@ -423,6 +481,72 @@ static void bufferSearchPartialMatch(benchmark::State& state) {
 }
 BENCHMARK(bufferSearchPartialMatch)->Arg(1)->Arg(4096)->Arg(16384)->Arg(65536);
 
+// Fill a buffer with roughly 64KiB of header-like text split into slices of `slice_size` bytes,
+// terminated by an empty line. The slice boundaries are not aligned with the lines, so the
+// terminating CRLFCRLF straddles slices for some slice sizes.
+static void fillFragmentedHeaderBuffer(Buffer::OwnedImpl& buffer, uint64_t slice_size) {
+  std::string data;
+  while (data.size() < 64 * 1024) {
+    data += "x-some-header-name: some-header-value\r\n";
+  }
+  data += "\r\n";
+  for (uint64_t offset = 0; offset < data.size(); offset += slice_size) {
+    buffer.appendSliceForTest(absl::string_view(data).substr(offset, slice_size));
+  }
+}
+
+// Test buffer search for the end of a header block in a fragmented buffer. Arg 0 is the slice
+// size. Arg 1 selects the scalar (1) or the vectorized (0) search kernels.
+static void bufferSearchFragmented(benchmark::State& state) {
+  Buffer::OwnedImpl buffer;
+  fillFragmentedHeaderBuffer(buffer, state.range(0));
+  Buffer::SearchKernels::forceScalarForTest(state.range(1) != 0);
+  const absl::string_view pattern = "\r\n\r\n";
+  ssize_t result = 0;
+  for (auto _ : state) {
+    UNREFERENCED_PARAMETER(_);
+    result += buffer.search(pattern.data(), pattern.size(), 0, 0);
+  }
+  Buffer::SearchKernels::forceScalarForTest(false);
+  benchmark::DoNotOptimize(result);
+  state.SetBytesProcessed(state.iterations() * buffer.length());
+}
+BENCHMARK(bufferSearchFragmented)
+    ->Args({61, 0})
+    ->Args({61, 1})
+    ->Args({1500, 0})
+    ->Args({1500, 1})
+    ->Args({16384, 0})
+    ->Args({16384, 1});
+
+// Test scanning a fragmented buffer for the next byte out of a set, e.g. the line scanning done
+// by text protocol codecs. Arg 0 is the slice size. Arg 1 selects the scalar (1) or the vectorized
+// (0) search kernels.
+static void bufferSearchAnyOfFragmented(benchmark::State& state) {
+  Buffer::OwnedImpl buffer;
+  fillFragmentedHeaderBuffer(buffer, state.range(0));
+  Buffer::SearchKernels::forceScalarForTest(state.range(1) != 0);
+  uint64_t lines = 0;
+  for (auto _ : state) {
+    UNREFERENCED_PARAMETER(_);
+    ssize_t position = 0;
+    while ((position = buffer.searchAnyOf("\r\n:", position, 0)) != -1) {
+      position++;
+      lines++;
+    }
+  }
+  Buffer::SearchKernels::forceScalarForTest(false);
+  benchmark::DoNotOptimize(lines);
+  state.SetBytesProcessed(state.iterations() * buffer.length());
+}
+BENCHMARK(bufferSearchAnyOfFragmented)
+    ->Args({61, 0})
+    ->Args({61, 1})
+    ->Args({1500, 0})
+    ->Args({1500, 1})
+    ->Args({16384, 0})
+    ->Args({16384, 1});
+
 // Test buffer startsWith, for the simple case where there is no match for the pattern at the start
 // of the buffer.
 static void bufferStartsWith(benchmark::State& state) {
@@ -1,9 +1,11 @@
 #include <cstddef>
 #include <limits>
+#include <thread>
 
 #include "envoy/common/exception.h"
 
 #include "source/common/buffer/buffer_impl.h"
+#include "source/common/stats/isolated_store_impl.h"
 
 #include "test/common/buffer/utility.h"
 #include "test/test_common/printers.h"
@@ -1103,6 +1105,120 @@ TEST(BufferHelperTest, AddFragments) {
     }
   }
 }
+
+class SliceStoragePoolTest : public testing::Test {
+public:
+  SliceStoragePoolTest() : pool_(SliceStoragePool::create(MaxRetainedBytes)) {
+    SliceStoragePool::setCurrent(pool_.get());
+    pool_->initializeStats(*store_.rootScope(), "pool.");
+  }
+  ~SliceStoragePoolTest() override { SliceStoragePool::setCurrent(nullptr); }
+
+  static constexpr uint64_t MaxRetainedBytes = 1024 * 1024;
+
+  uint64_t counter(const std::string& name) {
+    return TestUtility::findCounter(store_, "pool." + name)->value();
+  }
+  uint64_t retainedBytesGauge() {
+    return TestUtility::findGauge(store_, "pool.retained_bytes")->value();
+  }
+
+  Stats::IsolatedStoreImpl store_;
+  SliceStoragePoolPtr pool_;
+};
+
+TEST_F(SliceStoragePoolTest, ReusesFreedStorage) {
+  uint8_t* first;
+  {
+    Slice slice(16384, nullptr);
+    first = slice.data();
+    EXPECT_EQ(pool_.get(), Slice::newStorage(1).mem_.get_deleter().pool());
+  }
+  EXPECT_EQ(16384 + 4096, pool_->retainedBytes());
+  EXPECT_EQ(16384 + 4096, retainedBytesGauge());
+
+  Slice slice(16384, nullptr);
+  EXPECT_EQ(first, slice.data());
+  EXPECT_EQ(4096, pool_->retainedBytes());
+  EXPECT_EQ(1, counter("hits"));
+  EXPECT_EQ(2, counter("misses"));
+}
+
+TEST_F(SliceStoragePoolTest, SizeClassesAreSeparate) {
+  { Slice slice(4096, nullptr); }
+  { Slice slice(8192, nullptr); }
+  EXPECT_EQ(0, counter("hits"));
+  EXPECT_EQ(2, counter("misses"));
+  { Slice slice(4000, nullptr); }
+  EXPECT_EQ(1, counter("hits"));
+}
+
+TEST_F(SliceStoragePoolTest, LargeStorageBypassesPool) {
+  Slice::SizedStorage storage = Slice::newStorage(SliceStoragePool::MaxPooledSize + 1);
+  EXPECT_EQ(nullptr, storage.mem_.get_deleter().pool());
+  EXPECT_EQ(0, counter("misses"));
+}
+
+TEST_F(SliceStoragePoolTest, RetentionLimit) {
+  const uint64_t num_slices = MaxRetainedBytes / SliceStoragePool::MaxPooledSize + 1;
+  {
+    std::vector<Slice> slices;
+    for (uint64_t i = 0; i < num_slices; i++) {
+      slices.emplace_back(SliceStoragePool::MaxPooledSize, nullptr);
+    }
+  }
+  EXPECT_EQ(MaxRetainedBytes, pool_->retainedBytes());
+  EXPECT_EQ(num_slices, counter("misses"));
+  EXPECT_EQ(1, counter("overflow_frees"));
+}
+
+TEST_F(SliceStoragePoolTest, ReadReservationUsesPool) {
+  OwnedImpl buffer;
+  {
+    Reservation reservation = buffer.reserveForRead();
+    reservation.commit(1);
+  }
+  // The reservation is made of default sized slices; all but the committed one go back to the pool.
+  EXPECT_EQ((Reservation::MAX_SLICES_ - 1) * Slice::default_slice_size_, pool_->retainedBytes());
+  buffer.drain(buffer.length());
+  EXPECT_EQ(Reservation::MAX_SLICES_ * Slice::default_slice_size_, pool_->retainedBytes());
+}
+
+TEST_F(SliceStoragePoolTest, CrossThreadFree) {
+  auto buffer = std::make_unique<OwnedImpl>();
+  buffer->add(std::string(8192, 'a'));
+
+  // Move the data into a buffer owned by another thread and free it there.
+  std::thread thread([&buffer]() {
+    EXPECT_EQ(nullptr, SliceStoragePool::current());
+    OwnedImpl other;
+    other.move(*buffer);
+    EXPECT_EQ(8192, other.length());
+  });
+  thread.join();
+  EXPECT_EQ(0, pool_->retainedBytes());
+
+  // The block is reclaimed on the next allocation that finds its free list empty.
+  Slice slice(8192, nullptr);
+  EXPECT_EQ(1, counter("remote_frees"));
+  EXPECT_EQ(1, counter("hits"));
+}
+
+TEST_F(SliceStoragePoolTest, OutstandingStorageOutlivesPool) {
+  Slice::SizedStorage storage = Slice::newStorage(4096);
+  SliceStoragePool::setCurrent(nullptr);
+  pool_.reset();
+  // The pool stays alive until the last outstanding block has been freed.
+  storage.mem_.reset();
+}
+
+TEST_F(SliceStoragePoolTest, NoPoolInstalled) {
+  SliceStoragePool::setCurrent(nullptr);
+  Slice::SizedStorage storage = Slice::newStorage(4096);
+  EXPECT_EQ(nullptr, storage.mem_.get_deleter().pool());
+  EXPECT_EQ(0, counter("misses"));
+}
+
 } // namespace
 } // namespace Buffer
 } // namespace Envoy
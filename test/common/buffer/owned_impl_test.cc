@@ -1000,6 +1000,51 @@ TEST_F(OwnedImplTest, SearchWithLengthLimit) {
   EXPECT_EQ(12, buffer.search("ba", 2, 11, 10e6));
 }
 
+TEST_F(OwnedImplTest, SearchStraddlingManySlices) {
+  // Long enough slices for the vectorized kernels to kick in, with the needle spread over
+  // several slices including empty and single byte ones.
+  const std::string padding(100, 'x');
+  Buffer::OwnedImpl buffer;
+  buffer.appendSliceForTest(padding + "\r");
+  buffer.appendSliceForTest("");
+  buffer.appendSliceForTest("\n");
+  buffer.appendSliceForTest("\r");
+  buffer.appendSliceForTest("\n" + padding + "\r\n\r\n");
+
+  EXPECT_EQ(100, buffer.search("\r\n", 2, 0, 0));
+  EXPECT_EQ(100, buffer.search("\r\n\r\n", 4, 0, 0));
+  EXPECT_EQ(102, buffer.search("\r\n", 2, 101, 0));
+  EXPECT_EQ(204, buffer.search("\r\n\r\n", 4, 101, 0));
+  EXPECT_EQ(-1, buffer.search("\r\n\r\n", 4, 101, 106));
+  EXPECT_EQ(204, buffer.search("\r\n\r\n", 4, 101, 107));
+  EXPECT_EQ(-1, buffer.search("\r\n\r\n\r", 5, 0, 0));
+  EXPECT_EQ(97, buffer.search("xxx\r\n\r\n", 7, 0, 0));
+  EXPECT_EQ(201, buffer.search("xxx\r\n\r\n", 7, 98, 0));
+}
+
+TEST_F(OwnedImplTest, SearchAnyOf) {
+  static const char* Inputs[] = {"ab", "a", "", "aaa", "b", "a", "aaa", "ab", "a"};
+  Buffer::OwnedImpl buffer;
+  for (const auto& input : Inputs) {
+    buffer.appendSliceForTest(input);
+  }
+  buffer.appendSliceForTest(std::string(64, 'a') + "c");
+  EXPECT_STREQ(("abaaaabaaaaaba" + std::string(64, 'a') + "c").c_str(), buffer.toString().c_str());
+
+  EXPECT_EQ(-1, buffer.searchAnyOf("", 0, 0));
+  EXPECT_EQ(-1, buffer.searchAnyOf("xyz", 0, 0));
+  EXPECT_EQ(1, buffer.searchAnyOf("b", 0, 0));
+  EXPECT_EQ(0, buffer.searchAnyOf("ab", 0, 0));
+  EXPECT_EQ(6, buffer.searchAnyOf("bc", 2, 0));
+  EXPECT_EQ(-1, buffer.searchAnyOf("bc", 2, 4));
+  EXPECT_EQ(6, buffer.searchAnyOf("bc", 2, 5));
+  EXPECT_EQ(78, buffer.searchAnyOf("cd", 0, 0));
+  EXPECT_EQ(78, buffer.searchAnyOf("0123456789cd", 0, 0));
+  EXPECT_EQ(-1, buffer.searchAnyOf("cd", 0, 78));
+  EXPECT_EQ(-1, buffer.searchAnyOf("a", buffer.length(), 0));
+  EXPECT_EQ(-1, buffer.searchAnyOf("a", buffer.length() + 1, 0));
+}
+
 TEST_F(OwnedImplTest, StartsWith) {
   // Populate a buffer with a string split across many small slices, to
   // exercise edge cases in the startsWith implementation.
@@ -0,0 +1,87 @@
+#include <string>
+
+#include "source/common/buffer/search_kernels.h"
+
+#include "test/test_common/test_random_generator.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Buffer {
+namespace {
+
+class SearchKernelsTest : public testing::TestWithParam<bool> {
+public:
+  SearchKernelsTest() { SearchKernels::forceScalarForTest(GetParam()); }
+  ~SearchKernelsTest() override { SearchKernels::forceScalarForTest(false); }
+
+  static const uint8_t* bytes(absl::string_view data) {
+    return reinterpret_cast<const uint8_t*>(data.data());
+  }
+
+  static size_t expected(size_t pos) {
+    return pos == std::string::npos ? SearchKernels::NotFound : pos;
+  }
+};
+
+INSTANTIATE_TEST_SUITE_P(Implementation, SearchKernelsTest, testing::Bool(),
+                         [](const testing::TestParamInfo<bool>& param) {
+                           return param.param ? "Scalar" : "Vector";
+                         });
+
+TEST_P(SearchKernelsTest, FindByte) {
+  const std::string data = std::string(100, 'a') + "b";
+  EXPECT_EQ(100, SearchKernels::findByte(bytes(data), data.size(), 'b'));
+  EXPECT_EQ(SearchKernels::NotFound, SearchKernels::findByte(bytes(data), 100, 'b'));
+  EXPECT_EQ(SearchKernels::NotFound, SearchKernels::findByte(bytes(data), 0, 'a'));
+}
+
+TEST_P(SearchKernelsTest, FindAnyOf) {
+  // Place the match at every position relative to the vector width, with and without a tail.
+  for (size_t size = 1; size < 80; size++) {
+    for (size_t pos = 0; pos < size; pos++) {
+      std::string data(size, 'a');
+      data[pos] = '\n';
+      EXPECT_EQ(pos, SearchKernels::findAnyOf(bytes(data), size, "\r\n")) << size << " " << pos;
+      EXPECT_EQ(pos, SearchKernels::findAnyOf(bytes(data), size, "0123456789\n"))
+          << size << " " << pos;
+    }
+    const std::string data(size, 'a');
+    EXPECT_EQ(SearchKernels::NotFound, SearchKernels::findAnyOf(bytes(data), size, "\r\n"));
+  }
+  const std::string data = "abc";
+  EXPECT_EQ(SearchKernels::NotFound, SearchKernels::findAnyOf(bytes(data), data.size(), ""));
+  EXPECT_EQ(1, SearchKernels::findAnyOf(bytes(data), data.size(), "b"));
+  EXPECT_EQ(1, SearchKernels::findAnyOf(bytes(data), data.size(), "cb"));
+  // Bytes with the high bit set.
+  const std::string binary = "ab\xff";
+  EXPECT_EQ(2, SearchKernels::findAnyOf(bytes(binary), binary.size(), "\xfe\xff"));
+}
+
+TEST_P(SearchKernelsTest, FindNeedle) {
+  TestRandomGenerator rand;
+  for (size_t i = 0; i < 10000; i++) {
+    // A small alphabet produces many partial matches.
+    std::string data(rand.random() % 200, 'a');
+    for (char& c : data) {
+      c = "ab\r\n"[rand.random() % 4];
+    }
+    std::string needle(1 + rand.random() % 6, 'a');
+    for (char& c : needle) {
+      c = "ab\r\n"[rand.random() % 4];
+    }
+    EXPECT_EQ(expected(data.find(needle)),
+              SearchKernels::findNeedle(bytes(data), data.size(), bytes(needle), needle.size()))
+        << data << " " << needle;
+  }
+}
+
+TEST_P(SearchKernelsTest, FindNeedleLongerThanData) {
+  const std::string data = "abc";
+  EXPECT_EQ(SearchKernels::NotFound, SearchKernels::findNeedle(bytes(data), 2, bytes(data), 3));
+  EXPECT_EQ(0, SearchKernels::findNeedle(bytes(data), 3, bytes(data), 3));
+}
+
+} // namespace
+} // namespace Buffer
+} // namespace Envoy
@@ -0,0 +1,79 @@
+#include <string>
+
+#include "source/common/buffer/buffer_impl.h"
+#include "source/common/buffer/shared_buffer.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Buffer {
+namespace {
+
+TEST(SharedBufferTest, AddToBuffers) {
+  const std::string large(OwnedImpl::CopyThreshold, 'a');
+  const std::string small(OwnedImpl::CopyThreshold - 1, 'b');
+  OwnedImpl data;
+  data.addBufferFragment(*new BufferFragmentImpl(
+      large.data(), large.size(),
+      [](const void*, size_t, const BufferFragmentImpl* fragment) { delete fragment; }));
+  data.addBufferFragment(*new BufferFragmentImpl(
+      small.data(), small.size(),
+      [](const void*, size_t, const BufferFragmentImpl* fragment) { delete fragment; }));
+
+  SharedBufferConstSharedPtr shared = SharedBuffer::create(data);
+  EXPECT_EQ(0, data.length());
+  EXPECT_EQ(large.size() + small.size(), shared->length());
+
+  OwnedImpl first("first:");
+  OwnedImpl second;
+  EXPECT_EQ(large.size(), shared->addTo(first));
+  EXPECT_EQ(large.size(), shared->addTo(second));
+  EXPECT_EQ("first:" + large + small, first.toString());
+  EXPECT_EQ(large + small, second.toString());
+
+  // The large slice is referenced by both buffers, and the small slice is copied.
+  const RawSlice first_slice = first.frontSlice();
+  first.drain(first_slice.len_);
+  EXPECT_EQ(second.frontSlice().mem_, first.frontSlice().mem_);
+  EXPECT_EQ(large.data(), second.frontSlice().mem_);
+  second.drain(large.size());
+  EXPECT_NE(small.data(), second.frontSlice().mem_);
+}
+
+// The data outlives the shared buffer for as long as a buffer references it.
+TEST(SharedBufferTest, BuffersKeepDataAlive) {
+  bool released = false;
+  const std::string large(2 * OwnedImpl::CopyThreshold, 'a');
+  OwnedImpl data;
+  data.addBufferFragment(*new BufferFragmentImpl(
+      large.data(), large.size(),
+      [&released](const void*, size_t, const BufferFragmentImpl* fragment) {
+        released = true;
+        delete fragment;
+      }));
+
+  OwnedImpl first;
+  OwnedImpl second;
+  {
+    SharedBufferConstSharedPtr shared = SharedBuffer::create(data);
+    shared->addTo(first);
+    shared->addTo(second);
+  }
+  EXPECT_FALSE(released);
+
+  first.drain(first.length());
+  EXPECT_FALSE(released);
+  EXPECT_EQ(large, second.toString());
+
+  OwnedImpl moved;
+  moved.move(second);
+  EXPECT_FALSE(released);
+  moved.drain(large.size() / 2);
+  EXPECT_FALSE(released);
+  moved.drain(moved.length());
+  EXPECT_TRUE(released);
+}
+
+} // namespace
+} // namespace Buffer
+} // namespace Envoy
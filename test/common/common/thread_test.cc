@@ -1,5 +1,9 @@
 #include <functional>
 
+#if defined(__linux__)
+#include <sched.h>
+#endif
+
 #if defined(__linux__) || defined(__APPLE__)
 #include "source/common/common/posix/thread_impl.h"
 #endif
@@ -301,6 +305,31 @@ TEST(PosixThreadTest, InvalidThreadPriority) {
   EXPECT_NE(thread_priority, options.priority_);
 }
 
+#if defined(__linux__)
+TEST(PosixThreadTest, ThreadCpuAffinity) {
+  cpu_set_t process_cpus;
+  CPU_ZERO(&process_cpus);
+  ASSERT_EQ(0, sched_getaffinity(0, sizeof(process_cpus), &process_cpus));
+  uint32_t cpu = 0;
+  while (!CPU_ISSET(cpu, &process_cpus)) {
+    ++cpu;
+  }
+
+  auto thread_factory = PosixThreadFactory::create();
+  Options options;
+  options.cpu_affinity_ = {cpu};
+  cpu_set_t thread_cpus;
+  CPU_ZERO(&thread_cpus);
+  auto thread = thread_factory->createThread(
+      [&]() { pthread_getaffinity_np(pthread_self(), sizeof(thread_cpus), &thread_cpus); },
+      options, /* crash_on_failure= */ false);
+  thread->join();
+
+  EXPECT_EQ(1, CPU_COUNT(&thread_cpus));
+  EXPECT_TRUE(CPU_ISSET(cpu, &thread_cpus));
+}
+#endif
+
 class PosixThreadFactoryFailCreate : public PosixThreadFactory {
 protected:
   int createPthread(ThreadHandle*) override { return 1; }
@@ -296,6 +296,47 @@ TEST_F(ConnPoolImplBaseTest, PreconnectOnDisconnect) {
   pool_.destructAllConnections();
 }
 
+TEST(AdaptivePreconnectEstimatorTest, AnticipatedStreams) {
+  AdaptivePreconnectEstimator estimator;
+  MonotonicTime now;
+  EXPECT_EQ(0, estimator.anticipatedStreams(now));
+
+  // A stream every millisecond and connections established in 5 milliseconds.
+  for (int i = 0; i < 100; ++i) {
+    estimator.onStream(now);
+    now += std::chrono::milliseconds(1);
+  }
+  EXPECT_EQ(0, estimator.anticipatedStreams(now));
+  estimator.onConnected(std::chrono::milliseconds(5));
+  EXPECT_DOUBLE_EQ(5, estimator.anticipatedStreams(now));
+
+  // Slower connections move the estimate gradually.
+  estimator.onConnected(std::chrono::milliseconds(13));
+  EXPECT_DOUBLE_EQ(6, estimator.anticipatedStreams(now));
+
+  // Streams sent at the same time count as a microsecond apart.
+  estimator.onStream(now);
+  estimator.onStream(now);
+  EXPECT_GT(estimator.anticipatedStreams(now), 6);
+}
+
+TEST(AdaptivePreconnectEstimatorTest, DecaysWhileIdle) {
+  AdaptivePreconnectEstimator estimator;
+  MonotonicTime now;
+
+  // A stream every millisecond and connections established in 5 milliseconds.
+  for (int i = 0; i < 100; ++i) {
+    estimator.onStream(now);
+    now += std::chrono::milliseconds(1);
+  }
+  estimator.onConnected(std::chrono::milliseconds(5));
+  EXPECT_DOUBLE_EQ(5, estimator.anticipatedStreams(now));
+
+  // Without streams for a second, at most one stream per second is expected.
+  now += std::chrono::milliseconds(999);
+  EXPECT_DOUBLE_EQ(0.005, estimator.anticipatedStreams(now));
+}
+
 TEST_F(ConnPoolImplBaseTest, NoPreconnectIfUnhealthy) {
   // Create more than one connection per new stream.
   ON_CALL(*cluster_, perUpstreamPreconnectRatio).WillByDefault(Return(1.5));
@@ -688,5 +729,76 @@ TEST_F(ConnPoolImplDispatcherBaseTest, PoolDrainsWithEarlyDataStreams) {
   closeStream();
 }
 
+TEST_F(ConnPoolImplDispatcherBaseTest, AdaptivePreconnect) {
+  ON_CALL(*cluster_, adaptivePreconnectMaxStreams).WillByDefault(Return(10));
+  Upstream::ClusterTrafficStats& traffic_stats = *cluster_->trafficStats();
+
+  // Without estimates, only the connection for the first stream is created. It connects in 10ms.
+  EXPECT_CALL(pool_, instantiateActiveClient);
+  pool_.newStreamImpl(context_, /*can_send_early_data=*/false);
+  time_system_.advanceTimeWait(std::chrono::milliseconds(10));
+  EXPECT_CALL(pool_, onPoolReady);
+  clients_[0]->onEvent(Network::ConnectionEvent::Connected);
+  --clients_[0]->active_streams_;
+  pool_.onStreamClosed(*clients_[0], false);
+
+  // A stream 15ms later anticipates another stream within the 10ms it takes to connect, so a
+  // connection is preconnected.
+  time_system_.advanceTimeWait(std::chrono::milliseconds(5));
+  EXPECT_CALL(pool_, onPoolReady);
+  EXPECT_CALL(pool_, instantiateActiveClient);
+  pool_.newStreamImpl(context_, /*can_send_early_data=*/false);
+  EXPECT_EQ(2u, clients_.size());
+  time_system_.advanceTimeWait(std::chrono::milliseconds(10));
+  clients_[1]->onEvent(Network::ConnectionEvent::Connected);
+  EXPECT_EQ(ActiveClient::State::Ready, clients_[1]->state());
+
+  // The next stream uses the preconnected connection, and another one is preconnected.
+  EXPECT_CALL(pool_, onPoolReady);
+  EXPECT_CALL(pool_, instantiateActiveClient);
+  pool_.newStreamImpl(context_, /*can_send_early_data=*/false);
+  EXPECT_EQ(1, clients_[1]->active_streams_);
+  EXPECT_EQ(1, traffic_stats.upstream_cx_preconnect_used_.value());
+  EXPECT_EQ(0, traffic_stats.upstream_cx_preconnect_unused_.value());
+
+  // Clean up. The last preconnected connection is closed without having served a stream.
+  for (int i = 0; i < 2; ++i) {
+    --clients_[i]->active_streams_;
+    pool_.onStreamClosed(*clients_[i], false);
+  }
+  pool_.drainConnectionsImpl(Envoy::ConnectionPool::DrainBehavior::DrainAndDelete);
+  EXPECT_EQ(1, traffic_stats.upstream_cx_preconnect_used_.value());
+  EXPECT_EQ(1, traffic_stats.upstream_cx_preconnect_unused_.value());
+}
+
+// Upstreams that receive less than a stream per two connection establishment times do not get a
+// spare connection.
+TEST_F(ConnPoolImplDispatcherBaseTest, AdaptivePreconnectLowRate) {
+  ON_CALL(*cluster_, adaptivePreconnectMaxStreams).WillByDefault(Return(10));
+
+  // The first stream creates a connection, which connects in 10ms.
+  EXPECT_CALL(pool_, instantiateActiveClient);
+  pool_.newStreamImpl(context_, /*can_send_early_data=*/false);
+  time_system_.advanceTimeWait(std::chrono::milliseconds(10));
+  EXPECT_CALL(pool_, onPoolReady);
+  clients_[0]->onEvent(Network::ConnectionEvent::Connected);
+  --clients_[0]->active_streams_;
+  pool_.onStreamClosed(*clients_[0], false);
+
+  // A stream every second reuses the connection without preconnecting another one.
+  EXPECT_CALL(pool_, instantiateActiveClient).Times(0);
+  for (int i = 0; i < 5; ++i) {
+    time_system_.advanceTimeWait(std::chrono::seconds(1));
+    EXPECT_CALL(pool_, onPoolReady);
+    pool_.newStreamImpl(context_, /*can_send_early_data=*/false);
+    --clients_[0]->active_streams_;
+    pool_.onStreamClosed(*clients_[0], false);
+  }
+  EXPECT_EQ(1u, clients_.size());
+  EXPECT_EQ(0, cluster_->trafficStats()->upstream_cx_preconnect_unused_.value());
+
+  pool_.drainConnectionsImpl(Envoy::ConnectionPool::DrainBehavior::DrainAndDelete);
+}
+
 } // namespace ConnectionPool
 } // namespace Envoy
@@ -369,6 +369,8 @@ TEST_F(DispatcherImplTest, InitializeStats) {
               histogram("test.dispatcher.loop_duration_us", Stats::Histogram::Unit::Microseconds));
   EXPECT_CALL(store_,
               histogram("test.dispatcher.poll_delay_us", Stats::Histogram::Unit::Microseconds));
+  EXPECT_CALL(store_,
+              histogram("test.dispatcher.spin_duration_us", Stats::Histogram::Unit::Microseconds));
   dispatcher_->initializeStats(scope_, "test.");
 }
 
@@ -772,6 +774,116 @@ TEST_F(NotStartedDispatcherImplTest, IsThreadSafe) {
   EXPECT_TRUE(dispatcher_->isThreadSafe());
 }
 
+class DispatcherHybridPollingTest : public testing::Test {
+protected:
+  DispatcherHybridPollingTest()
+      : api_(Api::createApiForTest()), dispatcher_(api_->allocateDispatcher("test_thread")) {
+    dispatcher_->initializeStats(scope_);
+    dispatcher_->enableHybridPolling(std::chrono::milliseconds(1));
+  }
+
+  NiceMock<Stats::MockStore> store_;
+  Stats::Scope& scope_{*store_.rootScope()};
+  Api::ApiPtr api_;
+  DispatcherPtr dispatcher_;
+};
+
+// Events that arrive both while the loop spins and after it blocked are handled.
+TEST_F(DispatcherHybridPollingTest, RunsEventsUntilExit) {
+  uint32_t fired = 0;
+  TimerPtr timer;
+  timer = dispatcher_->createTimer([&]() {
+    // Alternate between waking up within and after the spin duration.
+    if (++fired < 4) {
+      timer->enableHRTimer(fired % 2 == 0 ? std::chrono::microseconds(100)
+                                          : std::chrono::microseconds(5000));
+      return;
+    }
+    dispatcher_->exit();
+  });
+  timer->enableTimer(std::chrono::milliseconds(0));
+
+  Thread::ThreadPtr thread = api_->threadFactory().createThread([this]() {
+    dispatcher_->post([]() {});
+  });
+
+  dispatcher_->run(Dispatcher::RunType::Block);
+  thread->join();
+  EXPECT_EQ(4, fired);
+}
+
+// Like the Block mode without hybrid polling, run() returns once no events are registered.
+TEST_F(DispatcherHybridPollingTest, ReturnsWithoutEvents) {
+  bool posted = false;
+  dispatcher_->post([&posted]() { posted = true; });
+  dispatcher_->run(Dispatcher::RunType::Block);
+  EXPECT_TRUE(posted);
+}
+
+// The busy time excludes the time the loop spins without events, even if it never blocks.
+TEST_F(DispatcherHybridPollingTest, BusyTracking) {
+  dispatcher_->load().enableBusyTracking();
+
+  // Keep the loop busy for 10ms out of every 10.1ms, then idle for 300ms with events arriving
+  // within the spin duration of each other.
+  uint32_t iterations = 0;
+  uint64_t busy_permille = 0;
+  MonotonicTime idle_start;
+  TimerPtr timer;
+  timer = dispatcher_->createTimer([&]() {
+    const MonotonicTime now = api_->timeSource().monotonicTime();
+    if (++iterations <= 30) {
+      while (api_->timeSource().monotonicTime() - now < std::chrono::milliseconds(10)) {
+      }
+      busy_permille = dispatcher_->load().busyPermille();
+      idle_start = api_->timeSource().monotonicTime();
+    } else if (now - idle_start > std::chrono::milliseconds(300)) {
+      dispatcher_->exit();
+      return;
+    }
+    timer->enableHRTimer(std::chrono::microseconds(100));
+  });
+  timer->enableTimer(std::chrono::milliseconds(0));
+
+  dispatcher_->run(Dispatcher::RunType::Block);
+  EXPECT_GT(busy_permille, 300);
+  EXPECT_LT(dispatcher_->load().busyPermille(), 500);
+}
+
+// Hybrid polling only applies to the Block mode.
+TEST_F(DispatcherHybridPollingTest, NonBlock) {
+  TimerPtr timer = dispatcher_->createTimer([]() {});
+  timer->enableTimer(std::chrono::seconds(10));
+  dispatcher_->run(Dispatcher::RunType::NonBlock);
+  EXPECT_TRUE(timer->enabled());
+}
+
+// Once busy tracking is enabled, the fraction of time the event loop spends handling events is
+// published periodically.
+TEST(DispatcherLoadTest, BusyTracking) {
+  Api::ApiPtr api = Api::createApiForTest();
+  DispatcherPtr dispatcher = api->allocateDispatcher("test_thread");
+  EXPECT_EQ(0, dispatcher->load().busyPermille());
+  dispatcher->load().enableBusyTracking();
+
+  // Keep the loop busy for about 10ms out of every 11ms for a few tracking periods.
+  uint32_t iterations = 0;
+  TimerPtr timer;
+  timer = dispatcher->createTimer([&]() {
+    const MonotonicTime start = api->timeSource().monotonicTime();
+    while (api->timeSource().monotonicTime() - start < std::chrono::milliseconds(10)) {
+    }
+    if (++iterations < 30) {
+      timer->enableTimer(std::chrono::milliseconds(1));
+    }
+  });
+  timer->enableTimer(std::chrono::milliseconds(0));
+  while (iterations < 30) {
+    dispatcher->run(Dispatcher::RunType::NonBlock);
+  }
+  EXPECT_GT(dispatcher->load().busyPermille(), 300);
+}
+
 class DispatcherMonotonicTimeTest : public testing::Test {
 protected:
   DispatcherMonotonicTimeTest() : api_(Api::createApiForTest()) {
@@ -0,0 +1,99 @@
+// Compares the libevent timer heap with the timing wheel on a workload where timers are re-armed
+// much more often than they fire, as done by stream and connection idle timeouts.
+
+#include <chrono>
+#include <vector>
+
+#include "envoy/config/bootstrap/v3/bootstrap.pb.h"
+
+#include "source/common/api/api_impl.h"
+#include "source/common/common/random_generator.h"
+#include "source/common/event/real_time_system.h"
+#include "source/common/stats/isolated_store_impl.h"
+
+#include "test/test_common/file_system_for_test.h"
+#include "test/test_common/thread_factory_for_test.h"
+
+#include "benchmark/benchmark.h"
+
+namespace Envoy {
+namespace Event {
+namespace {
+
+// NOLINTNEXTLINE(readability-identifier-naming)
+static void BM_TimerReArm(benchmark::State& state) {
+  const bool use_timer_wheel = state.range(0) != 0;
+  const uint64_t num_timers = state.range(1);
+
+  envoy::config::bootstrap::v3::Bootstrap bootstrap;
+  if (use_timer_wheel) {
+    bootstrap.mutable_dispatcher_options()->mutable_timer_wheel();
+  }
+  Stats::IsolatedStoreImpl store;
+  RealTimeSystem time_system;
+  Random::RandomGeneratorImpl random;
+  Api::Impl api(Thread::threadFactoryForTest(), store, time_system, Filesystem::fileSystemForTest(),
+                random, bootstrap);
+  DispatcherPtr dispatcher = api.allocateDispatcher("bench_thread");
+
+  std::vector<TimerPtr> timers;
+  timers.reserve(num_timers);
+  for (uint64_t i = 0; i < num_timers; ++i) {
+    timers.push_back(dispatcher->createTimer([]() {}));
+    timers.back()->enableTimer(std::chrono::milliseconds(10000 + i % 10000));
+  }
+
+  uint64_t i = 0;
+  for (auto _ : state) { // NOLINT
+    // Push the timeout out again, spreading the new deadlines over a few seconds.
+    timers[i % num_timers]->enableTimer(std::chrono::milliseconds(15000 + (i * 7919) % 5000));
+    // Include the cost of the event loop iterations that happen between the re-arms.
+    if (++i % 1024 == 0) {
+      dispatcher->run(Dispatcher::RunType::NonBlock);
+    }
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_TimerReArm)
+    ->ArgsProduct({{0, 1}, {1000, 100000, 1000000}})
+    ->Unit(benchmark::kNanosecond);
+
+// NOLINTNEXTLINE(readability-identifier-naming)
+static void BM_TimerEnableDisable(benchmark::State& state) {
+  const bool use_timer_wheel = state.range(0) != 0;
+  const uint64_t num_timers = state.range(1);
+
+  envoy::config::bootstrap::v3::Bootstrap bootstrap;
+  if (use_timer_wheel) {
+    bootstrap.mutable_dispatcher_options()->mutable_timer_wheel();
+  }
+  Stats::IsolatedStoreImpl store;
+  RealTimeSystem time_system;
+  Random::RandomGeneratorImpl random;
+  Api::Impl api(Thread::threadFactoryForTest(), store, time_system, Filesystem::fileSystemForTest(),
+                random, bootstrap);
+  DispatcherPtr dispatcher = api.allocateDispatcher("bench_thread");
+
+  std::vector<TimerPtr> timers;
+  timers.reserve(num_timers);
+  for (uint64_t i = 0; i < num_timers; ++i) {
+    timers.push_back(dispatcher->createTimer([]() {}));
+    timers.back()->enableTimer(std::chrono::milliseconds(10000 + i % 10000));
+  }
+
+  uint64_t i = 0;
+  for (auto _ : state) { // NOLINT
+    // A request timeout that is armed and then disabled when the response completes.
+    Timer& timer = *timers[i++ % num_timers];
+    timer.disableTimer();
+    timer.enableTimer(std::chrono::milliseconds(15000 + (i * 7919) % 5000));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_TimerEnableDisable)
+    ->ArgsProduct({{0, 1}, {1000, 100000, 1000000}})
+    ->Unit(benchmark::kNanosecond);
+
+} // namespace
+} // namespace Event
+} // namespace Envoy
@@ -0,0 +1,318 @@
+#include <chrono>
+#include <memory>
+#include <vector>
+
+#include "envoy/config/bootstrap/v3/bootstrap.pb.h"
+#include "envoy/event/timer.h"
+
+#include "source/common/api/api_impl.h"
+#include "source/common/common/random_generator.h"
+#include "source/common/event/dispatcher_impl.h"
+#include "source/common/event/scaled_range_timer_manager_impl.h"
+#include "source/common/event/timer_wheel_impl.h"
+#include "source/common/stats/isolated_store_impl.h"
+
+#include "test/mocks/common.h"
+#include "test/mocks/event/wrapped_dispatcher.h"
+#include "test/test_common/file_system_for_test.h"
+#include "test/test_common/simulated_time_system.h"
+#include "test/test_common/thread_factory_for_test.h"
+#include "test/test_common/utility.h"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Event {
+namespace {
+
+using testing::InSequence;
+using testing::MockFunction;
+
+// Creates the timers driving the wheel on the underlying dispatcher.
+class DispatcherScheduler : public Scheduler {
+public:
+  explicit DispatcherScheduler(Dispatcher& dispatcher) : dispatcher_(dispatcher) {}
+
+  TimerPtr createTimer(const TimerCb& cb, Dispatcher&) override {
+    return dispatcher_.createTimer(cb);
+  }
+
+private:
+  Dispatcher& dispatcher_;
+};
+
+// Dispatcher whose timers are served by a timing wheel.
+class WheelDispatcher : public WrappedDispatcher {
+public:
+  WheelDispatcher(Dispatcher& impl, TimeSource& time_source, std::chrono::microseconds tick)
+      : WrappedDispatcher(impl), scheduler_(impl),
+        wheel_(std::make_unique<TimerWheel>(scheduler_, *this, time_source, tick)) {}
+
+  TimerPtr createTimer(TimerCb cb) override { return wheel_->createTimer(cb, *this); }
+
+  DispatcherScheduler scheduler_;
+  TimerWheelPtr wheel_;
+};
+
+class TimerWheelTest : public testing::Test, public TestUsingSimulatedTime {
+public:
+  TimerWheelTest()
+      : api_(Api::createApiForTest()), dispatcher_(api_->allocateDispatcher("test_thread")) {}
+
+  void setTick(std::chrono::microseconds tick) {
+    wheel_dispatcher_ = std::make_unique<WheelDispatcher>(*dispatcher_, simTime(), tick);
+  }
+
+  void advance(std::chrono::microseconds duration) {
+    simTime().advanceTimeAndRun(duration, *dispatcher_, Dispatcher::RunType::NonBlock);
+  }
+
+  TimerWheel& wheel() { return *wheel_dispatcher_->wheel_; }
+
+  Api::ApiPtr api_;
+  DispatcherPtr dispatcher_;
+  std::unique_ptr<WheelDispatcher> wheel_dispatcher_;
+};
+
+TEST_F(TimerWheelTest, EnableAndFire) {
+  setTick(std::chrono::milliseconds(1));
+  MockFunction<TimerCb> callback;
+  TimerPtr timer = wheel_dispatcher_->createTimer(callback.AsStdFunction());
+  EXPECT_FALSE(timer->enabled());
+
+  timer->enableTimer(std::chrono::milliseconds(10));
+  EXPECT_TRUE(timer->enabled());
+  EXPECT_EQ(1, wheel().size());
+
+  advance(std::chrono::milliseconds(9));
+  EXPECT_TRUE(timer->enabled());
+
+  EXPECT_CALL(callback, Call());
+  advance(std::chrono::milliseconds(1));
+  EXPECT_FALSE(timer->enabled());
+  EXPECT_EQ(0, wheel().size());
+}
+
+TEST_F(TimerWheelTest, RoundsUpToTick) {
+  setTick(std::chrono::milliseconds(10));
+  MockFunction<TimerCb> callback;
+  TimerPtr timer = wheel_dispatcher_->createTimer(callback.AsStdFunction());
+
+  // Half way into the first tick, a timer of one tick must not fire at the end of that tick.
+  advance(std::chrono::milliseconds(5));
+  timer->enableTimer(std::chrono::milliseconds(10));
+  advance(std::chrono::milliseconds(5));
+  EXPECT_TRUE(timer->enabled());
+  advance(std::chrono::milliseconds(9));
+  EXPECT_TRUE(timer->enabled());
+
+  EXPECT_CALL(callback, Call());
+  advance(std::chrono::milliseconds(1));
+  EXPECT_FALSE(timer->enabled());
+
+  // The same holds for high resolution timers shorter than a tick.
+  timer->enableHRTimer(std::chrono::microseconds(1));
+  advance(std::chrono::milliseconds(9));
+  EXPECT_TRUE(timer->enabled());
+  EXPECT_CALL(callback, Call());
+  advance(std::chrono::milliseconds(1));
+  EXPECT_FALSE(timer->enabled());
+}
+
+TEST_F(TimerWheelTest, ReEnableAndDisable) {
+  setTick(std::chrono::milliseconds(1));
+  MockFunction<TimerCb> callback;
+  TimerPtr timer = wheel_dispatcher_->createTimer(callback.AsStdFunction());
+
+  timer->enableTimer(std::chrono::milliseconds(10));
+  advance(std::chrono::milliseconds(5));
+  timer->enableTimer(std::chrono::milliseconds(10));
+  advance(std::chrono::milliseconds(9));
+  EXPECT_TRUE(timer->enabled());
+  timer->disableTimer();
+  EXPECT_FALSE(timer->enabled());
+  EXPECT_EQ(0, wheel().size());
+  advance(std::chrono::milliseconds(10));
+
+  // Disabling a disabled timer is a no-op.
+  timer->disableTimer();
+
+  EXPECT_CALL(callback, Call());
+  timer->enableTimer(std::chrono::milliseconds(3));
+  advance(std::chrono::milliseconds(3));
+}
+
+TEST_F(TimerWheelTest, ZeroDuration) {
+  setTick(std::chrono::milliseconds(10));
+  MockFunction<TimerCb> callback;
+  TimerPtr timer = wheel_dispatcher_->createTimer(callback.AsStdFunction());
+
+  // Zero duration timers are not rounded up to a tick.
+  EXPECT_CALL(callback, Call());
+  timer->enableTimer(std::chrono::milliseconds(0));
+  EXPECT_TRUE(timer->enabled());
+  dispatcher_->run(Dispatcher::RunType::NonBlock);
+  EXPECT_FALSE(timer->enabled());
+
+  // A timer re-enabled from its callback runs in the next event loop iteration.
+  TimerPtr rearming_timer;
+  int runs = 0;
+  rearming_timer = wheel_dispatcher_->createTimer([&]() {
+    ++runs;
+    rearming_timer->enableTimer(std::chrono::milliseconds(0));
+  });
+  rearming_timer->enableTimer(std::chrono::milliseconds(0));
+  dispatcher_->run(Dispatcher::RunType::NonBlock);
+  EXPECT_EQ(1, runs);
+  dispatcher_->run(Dispatcher::RunType::NonBlock);
+  EXPECT_EQ(2, runs);
+  rearming_timer->disableTimer();
+  dispatcher_->run(Dispatcher::RunType::NonBlock);
+  EXPECT_EQ(2, runs);
+}
+
+TEST_F(TimerWheelTest, CascadesFromHigherLevels) {
+  setTick(std::chrono::milliseconds(1));
+  // Durations in milliseconds covering every level of the wheel.
+  const std::vector<int64_t> durations = {50, 3000, 200000, 10000000, 600000000, 30000000000};
+  std::vector<MockFunction<TimerCb>> callbacks(durations.size());
+  std::vector<TimerPtr> timers;
+  for (size_t i = 0; i < durations.size(); ++i) {
+    timers.push_back(wheel_dispatcher_->createTimer(callbacks[i].AsStdFunction()));
+    timers.back()->enableTimer(std::chrono::milliseconds(durations[i]));
+  }
+
+  int64_t elapsed = 0;
+  for (size_t i = 0; i < durations.size(); ++i) {
+    advance(std::chrono::milliseconds(durations[i] - elapsed - 1));
+    EXPECT_TRUE(timers[i]->enabled()) << i;
+    EXPECT_CALL(callbacks[i], Call());
+    advance(std::chrono::milliseconds(1));
+    EXPECT_FALSE(timers[i]->enabled()) << i;
+    elapsed = durations[i];
+  }
+}
+
+TEST_F(TimerWheelTest, TimersOfSameTickRunInOrder) {
+  setTick(std::chrono::milliseconds(1));
+  InSequence s;
+  MockFunction<TimerCb> callback1;
+  MockFunction<TimerCb> callback2;
+  MockFunction<TimerCb> callback3;
+  TimerPtr timer1 = wheel_dispatcher_->createTimer(callback1.AsStdFunction());
+  TimerPtr timer2 = wheel_dispatcher_->createTimer(callback2.AsStdFunction());
+  TimerPtr timer3 = wheel_dispatcher_->createTimer(callback3.AsStdFunction());
+
+  timer1->enableTimer(std::chrono::milliseconds(100));
+  timer2->enableTimer(std::chrono::milliseconds(100));
+  timer3->enableTimer(std::chrono::milliseconds(100));
+
+  EXPECT_CALL(callback1, Call()).WillOnce([&]() {
+    // Timers of the slot being run can be disabled and deleted from a callback.
+    timer2.reset();
+  });
+  EXPECT_CALL(callback3, Call()).WillOnce([&]() { timer3.reset(); });
+  advance(std::chrono::milliseconds(100));
+  EXPECT_EQ(0, wheel().size());
+}
+
+TEST_F(TimerWheelTest, EnableFromCallback) {
+  setTick(std::chrono::milliseconds(1));
+  MockFunction<TimerCb> callback;
+  TimerPtr other = wheel_dispatcher_->createTimer(callback.AsStdFunction());
+  TimerPtr timer = wheel_dispatcher_->createTimer(
+      [&]() { other->enableTimer(std::chrono::milliseconds(5000)); });
+  timer->enableTimer(std::chrono::milliseconds(10));
+
+  advance(std::chrono::milliseconds(10));
+  EXPECT_TRUE(other->enabled());
+  advance(std::chrono::milliseconds(4999));
+  EXPECT_TRUE(other->enabled());
+  EXPECT_CALL(callback, Call());
+  advance(std::chrono::milliseconds(1));
+}
+
+TEST_F(TimerWheelTest, LateProcessingRunsAllExpiredTimers) {
+  setTick(std::chrono::milliseconds(1));
+  MockFunction<TimerCb> callback;
+  std::vector<TimerPtr> timers;
+  for (int i = 1; i <= 100; ++i) {
+    timers.push_back(wheel_dispatcher_->createTimer(callback.AsStdFunction()));
+    timers.back()->enableTimer(std::chrono::milliseconds(i * 97));
+  }
+
+  EXPECT_CALL(callback, Call()).Times(100);
+  advance(std::chrono::seconds(10));
+  EXPECT_EQ(0, wheel().size());
+}
+
+TEST_F(TimerWheelTest, ClipsLongDurations) {
+  setTick(std::chrono::milliseconds(1));
+  MockFunction<TimerCb> callback;
+  TimerPtr timer = wheel_dispatcher_->createTimer(callback.AsStdFunction());
+  timer->enableTimer(std::chrono::milliseconds::max());
+  EXPECT_TRUE(timer->enabled());
+  advance(std::chrono::hours(24 * 365));
+  EXPECT_TRUE(timer->enabled());
+}
+
+TEST_F(TimerWheelTest, ScopeTracking) {
+  setTick(std::chrono::milliseconds(1));
+  MockScopeTrackedObject scope;
+  MockFunction<TimerCb> callback;
+  TimerPtr timer = wheel_dispatcher_->createTimer(callback.AsStdFunction());
+
+  timer->enableTimer(std::chrono::milliseconds(5), &scope);
+  EXPECT_CALL(callback, Call()).WillOnce([&]() {
+    EXPECT_FALSE(dispatcher_->trackedObjectStackIsEmpty());
+  });
+  advance(std::chrono::milliseconds(5));
+  EXPECT_TRUE(dispatcher_->trackedObjectStackIsEmpty());
+}
+
+TEST_F(TimerWheelTest, ScaledRangeTimers) {
+  setTick(std::chrono::milliseconds(1));
+  ScaledRangeTimerManagerImpl manager(*wheel_dispatcher_);
+  MockFunction<TimerCb> callback;
+  TimerPtr timer = manager.createTimer(ScaledMinimum(UnitFloat(0.5)), callback.AsStdFunction());
+
+  timer->enableTimer(std::chrono::seconds(10));
+  advance(std::chrono::seconds(5));
+  EXPECT_TRUE(timer->enabled());
+
+  // Scaling down the remaining 5s expires the timer 2.5s after its minimum.
+  manager.setScaleFactor(UnitFloat(0.5));
+  advance(std::chrono::milliseconds(2499));
+  EXPECT_TRUE(timer->enabled());
+  EXPECT_CALL(callback, Call());
+  advance(std::chrono::milliseconds(1));
+  EXPECT_FALSE(timer->enabled());
+}
+
+TEST_F(TimerWheelTest, DispatcherOption) {
+  envoy::config::bootstrap::v3::Bootstrap bootstrap;
+  bootstrap.mutable_dispatcher_options()->mutable_timer_wheel()->mutable_tick()->set_nanos(
+      10000000);
+  Stats::IsolatedStoreImpl store;
+  Random::RandomGeneratorImpl random;
+  Api::Impl api(Thread::threadFactoryForTest(), store, simTime(), Filesystem::fileSystemForTest(),
+                random, bootstrap);
+  DispatcherPtr dispatcher = api.allocateDispatcher("wheel_thread");
+
+  MockFunction<TimerCb> callback;
+  TimerPtr timer = dispatcher->createTimer(callback.AsStdFunction());
+  // Rounded up to the 10ms tick of the wheel.
+  timer->enableTimer(std::chrono::milliseconds(15));
+  simTime().advanceTimeAndRun(std::chrono::milliseconds(15), *dispatcher,
+                              Dispatcher::RunType::NonBlock);
+  EXPECT_TRUE(timer->enabled());
+  EXPECT_CALL(callback, Call());
+  simTime().advanceTimeAndRun(std::chrono::milliseconds(5), *dispatcher,
+                              Dispatcher::RunType::NonBlock);
+  EXPECT_FALSE(timer->enabled());
+}
+
+} // namespace
+} // namespace Event
+} // namespace Envoy
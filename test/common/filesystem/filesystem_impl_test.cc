@@ -2,6 +2,7 @@
 #include <filesystem>
 #include <stdexcept>
 #include <string>
+#include <vector>
 
 #include "source/common/common/assert.h"
 #include "source/common/common/cleanup.h"
@@ -805,6 +806,39 @@ TEST_F(FileSystemImplTest, WriteAfterClose) {
   EXPECT_EQ(IoFileError::IoErrorCode::BadFd, size_result.err_->getErrorCode());
 }
 
+TEST_F(FileSystemImplTest, WritevWritesSlicesInOrder) {
+  const std::string new_file_path = TestEnvironment::temporaryPath("envoy_this_not_exist");
+  ::unlink(new_file_path.c_str());
+
+  FilePathAndType new_file_info{Filesystem::DestinationType::File, new_file_path};
+  {
+    FilePtr file = file_system_.createFile(new_file_info);
+    const Api::IoCallBoolResult open_result = file->open(DefaultFlags);
+    EXPECT_TRUE(open_result.return_value_);
+    const std::vector<absl::string_view> slices{"first ", "", "second ", "third"};
+    const Api::IoCallSizeResult size_result = file->writev(slices);
+    EXPECT_TRUE(size_result.ok());
+    EXPECT_EQ(18, size_result.return_value_);
+  }
+  EXPECT_EQ("first second third", TestEnvironment::readFileToStringForTest(new_file_path));
+}
+
+TEST_F(FileSystemImplTest, WritevAfterClose) {
+  const std::string new_file_path = TestEnvironment::temporaryPath("envoy_this_not_exist");
+  ::unlink(new_file_path.c_str());
+
+  FilePathAndType new_file_info{Filesystem::DestinationType::File, new_file_path};
+  FilePtr file = file_system_.createFile(new_file_info);
+  const Api::IoCallBoolResult bool_result1 = file->open(DefaultFlags);
+  EXPECT_TRUE(bool_result1.return_value_);
+  const Api::IoCallBoolResult bool_result2 = file->close();
+  EXPECT_TRUE(bool_result2.return_value_);
+  const std::vector<absl::string_view> slices{" new", " data"};
+  const Api::IoCallSizeResult size_result = file->writev(slices);
+  EXPECT_EQ(-1, size_result.return_value_);
+  EXPECT_EQ(IoFileError::IoErrorCode::BadFd, size_result.err_->getErrorCode());
+}
+
 TEST_F(FileSystemImplTest, NonExistingFileAndReadOnly) {
   const std::string new_file_path = TestEnvironment::temporaryPath("envoy_this_not_exist");
   ::unlink(new_file_path.c_str());
@@ -36,6 +36,95 @@ std::unique_ptr<Envoy::TestStreamInfo> makeStreamInfo(TimeSource& time_source) {
   return stream_info;
 }
 
+// The fields of a typical request log, which are mostly common StreamInfo fields and headers.
+constexpr std::pair<absl::string_view, absl::string_view> RequestLogFields[] = {
+    {"start_time", "%START_TIME%"},
+    {"method", "%REQ(:METHOD)%"},
+    {"path", "%REQ(X-ENVOY-ORIGINAL-PATH?:PATH)%"},
+    {"authority", "%REQ(:AUTHORITY)%"},
+    {"protocol", "%PROTOCOL%"},
+    {"response_code", "%RESPONSE_CODE%"},
+    {"response_flags", "%RESPONSE_FLAGS%"},
+    {"response_code_details", "%RESPONSE_CODE_DETAILS%"},
+    {"bytes_received", "%BYTES_RECEIVED%"},
+    {"bytes_sent", "%BYTES_SENT%"},
+    {"duration", "%DURATION%"},
+    {"request_duration", "%REQUEST_DURATION%"},
+    {"response_duration", "%RESPONSE_DURATION%"},
+    {"upstream_service_time", "%RESP(X-ENVOY-UPSTREAM-SERVICE-TIME)%"},
+    {"content_type", "%RESP(CONTENT-TYPE)%"},
+    {"x_forwarded_for", "%REQ(X-FORWARDED-FOR)%"},
+    {"user_agent", "%REQ(USER-AGENT)%"},
+    {"referer", "%REQ(REFERER)%"},
+    {"request_id", "%REQ(X-REQUEST-ID)%"},
+    {"upstream_host", "%UPSTREAM_HOST%"},
+    {"upstream_cluster", "%UPSTREAM_CLUSTER%"},
+    {"downstream_remote_address", "%DOWNSTREAM_REMOTE_ADDRESS%"},
+    {"downstream_remote_port", "%DOWNSTREAM_REMOTE_PORT%"},
+    {"route_name", "%ROUTE_NAME%"},
+    {"connection_id", "%CONNECTION_ID%"},
+    {"stream_id", "%STREAM_ID%"},
+    {"attempt_count", "%UPSTREAM_REQUEST_ATTEMPT_COUNT%"},
+    {"url", "%REQ(X-FORWARDED-PROTO)%://%REQ(:AUTHORITY)%%REQ(:PATH)%"},
+};
+
+std::unique_ptr<Envoy::Formatter::FormatterImpl> makeRequestLogFormatter() {
+  std::string format;
+  for (const auto& field : RequestLogFields) {
+    absl::StrAppend(&format, field.second, " ");
+  }
+  format.back() = '\n';
+  return *Envoy::Formatter::FormatterImpl::create(format, false);
+}
+
+std::unique_ptr<Envoy::Formatter::JsonFormatterImpl> makeRequestLogJsonFormatter() {
+  Protobuf::Struct struct_format;
+  for (const auto& field : RequestLogFields) {
+    (*struct_format.mutable_fields())[field.first].set_string_value(field.second);
+  }
+  return std::make_unique<Envoy::Formatter::JsonFormatterImpl>(struct_format, false);
+}
+
+// Formats request logs with the given formatter. The argument selects formatting into a reused
+// buffer instead of returning a string per log.
+void formatRequestLogs(benchmark::State& state, const Envoy::Formatter::Formatter& formatter) {
+  testing::NiceMock<MockTimeSystem> time_system;
+  std::unique_ptr<Envoy::TestStreamInfo> stream_info = makeStreamInfo(time_system);
+  stream_info->setResponseCode(200);
+  stream_info->setResponseCodeDetails("via_upstream");
+  stream_info->protocol(Http::Protocol::Http11);
+  stream_info->addBytesReceived(1024);
+  stream_info->addBytesSent(16384);
+  stream_info->downstream_connection_info_provider_->setConnectionID(42);
+  const Http::TestRequestHeaderMapImpl request_headers{
+      {":method", "GET"},
+      {":path", "/api/v2/accounts/8f14e45f/orders?status=open&limit=50"},
+      {":authority", "api.example.com"},
+      {"x-forwarded-proto", "https"},
+      {"x-forwarded-for", "203.0.113.1"},
+      {"user-agent", "example-client/3.4.1"},
+      {"x-request-id", "3b241101-e2bb-4255-8caf-4136c566a962"}};
+  const Http::TestResponseHeaderMapImpl response_headers{
+      {":status", "200"},
+      {"content-type", "application/json"},
+      {"x-envoy-upstream-service-time", "12"}};
+  const Envoy::Formatter::Context context(&request_headers, &response_headers);
+
+  const bool reuse_buffer = state.range(0) != 0;
+  std::string log_line;
+  size_t output_bytes = 0;
+  for (auto _ : state) { // NOLINT: Silences warning about dead store
+    if (reuse_buffer) {
+      log_line.clear();
+      formatter.formatTo(context, *stream_info, log_line);
+      output_bytes += log_line.size();
+    } else {
+      output_bytes += formatter.format(context, *stream_info).size();
+    }
+  }
+  benchmark::DoNotOptimize(output_bytes);
+}
+
 } // namespace
 
 // Test measures how fast Formatters are constructed from
@@ -125,6 +214,18 @@ static void BM_JsonAccessLogFormatter(benchmark::State& state) {
 }
 BENCHMARK(BM_JsonAccessLogFormatter);
 
+// NOLINTNEXTLINE(readability-identifier-naming)
+static void BM_AccessLogFormatterRequestLog(benchmark::State& state) {
+  formatRequestLogs(state, *makeRequestLogFormatter());
+}
+BENCHMARK(BM_AccessLogFormatterRequestLog)->Arg(0)->Arg(1);
+
+// NOLINTNEXTLINE(readability-identifier-naming)
+static void BM_JsonAccessLogFormatterRequestLog(benchmark::State& state) {
+  formatRequestLogs(state, *makeRequestLogJsonFormatter());
+}
+BENCHMARK(BM_JsonAccessLogFormatterRequestLog)->Arg(0)->Arg(1);
+
 // NOLINTNEXTLINE(readability-identifier-naming)
 static void BM_FormatterCommandParsing(benchmark::State& state) {
   const std::string token = "Listener:namespace:key";
@@ -15,6 +15,7 @@
 #include "source/common/formatter/substitution_formatter.h"
 #include "source/common/http/header_map_impl.h"
 #include "source/common/json/json_loader.h"
+#include "source/common/json/json_utility.h"
 #include "source/common/network/address_impl.h"
 #include "source/common/protobuf/utility.h"
 #include "source/common/router/string_accessor_impl.h"
@@ -4236,6 +4237,124 @@ TEST(SubstitutionFormatterTest, JsonFormatterWithOrderedPropertiesTest) {
   EXPECT_EQ(out_json, expected);
 }
 
+// The values providers append to buffers are the same as the values they return.
+TEST(SubstitutionFormatterTest, FormatToMatchesFormat) {
+  Http::TestRequestHeaderMapImpl request_headers{
+      {":method", "GET"},
+      {":path", "/path"},
+      {"user-agent", "agent \"quoted\" \\ \xc3\xa9"},
+      {"x-request-id", "3b241101-e2bb-4255-8caf-4136c566a962"}};
+  Http::TestResponseHeaderMapImpl response_headers{{"content-type", "text/plain"}};
+  const Context context(&request_headers, &response_headers);
+
+  const std::vector<std::string> commands = {
+      "plain \"string\"",
+      "%PROTOCOL%",
+      "%UPSTREAM_PROTOCOL%",
+      "%RESPONSE_CODE%",
+      "%RESPONSE_CODE_DETAILS%",
+      "%RESPONSE_CODE_DETAILS(ALLOW_WHITESPACES)%",
+      "%RESPONSE_FLAGS%",
+      "%RESPONSE_FLAGS_LONG%",
+      "%BYTES_RECEIVED%",
+      "%BYTES_SENT%",
+      "%DURATION%",
+      "%REQUEST_DURATION%",
+      "%COMMON_DURATION(DS_RX_BEG:DS_TX_END:us)%",
+      "%CUSTOM_FLAGS%",
+      "%UPSTREAM_HOST%",
+      "%UPSTREAM_CLUSTER%",
+      "%UPSTREAM_CLUSTER_RAW%",
+      "%DOWNSTREAM_REMOTE_ADDRESS%",
+      "%DOWNSTREAM_REMOTE_ADDRESS_WITHOUT_PORT%",
+      "%DOWNSTREAM_REMOTE_PORT%",
+      "%DOWNSTREAM_LOCAL_ADDRESS%",
+      "%ROUTE_NAME%",
+      "%VIRTUAL_CLUSTER_NAME%",
+      "%STREAM_ID%",
+      "%CONNECTION_ID%",
+      "%REQ(:METHOD)%",
+      "%REQ(USER-AGENT)%",
+      "%REQ(USER-AGENT):5%",
+      "%REQ(X-MISSING?:PATH)%",
+      "%REQ(X-MISSING)%",
+      "%RESP(CONTENT-TYPE)%",
+      "%TRAILER(GRPC-STATUS)%",
+      "%START_TIME%",
+      "%START_TIME(%Y/%m/%d)%",
+  };
+
+  auto expect_same_values = [&](const StreamInfo::StreamInfo& stream_info) {
+    for (const std::string& command : commands) {
+      SCOPED_TRACE(command);
+      auto providers = *SubstitutionFormatParser::parse(command);
+      ASSERT_EQ(1, providers.size());
+      const FormatterProvider& provider = *providers[0];
+
+      const absl::optional<std::string> value = provider.format(context, stream_info);
+      std::string output = "prefix";
+      EXPECT_EQ(value.has_value(), provider.formatTo(context, stream_info, output));
+      EXPECT_EQ(absl::StrCat("prefix", value.value_or("")), output);
+
+      std::string expected_json = "prefix";
+      Json::Utility::appendValueToString(provider.formatValue(context, stream_info),
+                                         expected_json);
+      std::string json = "prefix";
+      std::string sanitize_buffer;
+      if (provider.formatJsonTo(context, stream_info, json, sanitize_buffer)) {
+        EXPECT_EQ(expected_json, json);
+      } else {
+        EXPECT_EQ("prefix", json);
+      }
+    }
+  };
+
+  NiceMock<StreamInfo::MockStreamInfo> stream_info;
+  stream_info.protocol_ = Http::Protocol::Http2;
+  stream_info.setResponseCodeDetails("via upstream\tdetails");
+  stream_info.setResponseFlag(StreamInfo::CoreResponseFlag::LocalReset);
+  stream_info.setResponseFlag(StreamInfo::CoreResponseFlag::UpstreamRequestTimeout);
+  stream_info.route_name_ = "route \"name\"";
+  stream_info.virtual_cluster_name_ = "virtual_cluster";
+  stream_info.addCustomFlag("CF");
+  expect_same_values(stream_info);
+
+  NiceMock<StreamInfo::MockStreamInfo> empty_stream_info;
+  empty_stream_info.protocol_ = absl::nullopt;
+  empty_stream_info.response_code_ = absl::nullopt;
+  empty_stream_info.upstream_info_ = nullptr;
+  empty_stream_info.upstream_cluster_info_ = absl::nullopt;
+  empty_stream_info.downstream_connection_info_provider_->setRemoteAddress(nullptr);
+  expect_same_values(empty_stream_info);
+}
+
+// Formatting into a buffer appends the line that format() returns.
+TEST(SubstitutionFormatterTest, FormatterFormatToAppends) {
+  NiceMock<StreamInfo::MockStreamInfo> stream_info;
+  stream_info.protocol_ = Http::Protocol::Http11;
+  Http::TestRequestHeaderMapImpl request_headers{{":method", "GET"}, {":path", "/path"}};
+  const Context context(&request_headers);
+
+  auto formatter =
+      *FormatterImpl::create("%REQ(:METHOD)% %REQ(:PATH)% %PROTOCOL% %REQ(X-MISSING)%");
+  std::string output = "prefix ";
+  formatter->formatTo(context, stream_info, output);
+  EXPECT_EQ("prefix GET /path HTTP/1.1 -", output);
+  EXPECT_EQ(output, absl::StrCat("prefix ", formatter->format(context, stream_info)));
+
+  Protobuf::Struct key_mapping;
+  TestUtility::loadFromYaml(R"EOF(
+    method: '%REQ(:METHOD)%'
+    path: '%REQ(:PATH)% %REQ(X-MISSING)%'
+    code: '%RESPONSE_CODE%'
+  )EOF",
+                            key_mapping);
+  JsonFormatterImpl json_formatter(key_mapping, false);
+  std::string json_output = "prefix ";
+  json_formatter.formatTo(context, stream_info, json_output);
+  EXPECT_EQ(json_output, absl::StrCat("prefix ", json_formatter.format(context, stream_info)));
+}
+
 TEST(SubstitutionFormatterTest, CompositeFormatterSuccess) {
   Http::TestRequestHeaderMapImpl request_header{{"first", "GET"}, {":path", "/"}};
   Http::TestResponseHeaderMapImpl response_header{{"second", "PUT"}, {"test", "test"}};
@@ -139,6 +139,47 @@ TEST_F(HttpConnectionManagerImplTest, ResponseBeforeRequestComplete10NoOptimize)
   decoder_filters_[0]->callbacks_->encodeHeaders(std::move(response_headers), true, "details");
 }
 
+// Streams are counted in the dispatcher load while a load aware connection balancer has enabled
+// stream tracking.
+TEST_F(HttpConnectionManagerImplTest, DispatcherLoadActiveStreams) {
+  setup();
+  setupFilterChain(1, 0);
+  Event::DispatcherLoad& load = filter_callbacks_.connection_.dispatcher_.load_;
+  load.enableStreamTracking();
+
+  EXPECT_CALL(*decoder_filters_[0], decodeHeaders(_, true))
+      .WillOnce(Return(FilterHeadersStatus::StopIteration));
+  startRequest(true);
+  EXPECT_EQ(1, load.activeStreams());
+
+  EXPECT_CALL(response_encoder_, encodeHeaders(_, true));
+  decoder_filters_[0]->callbacks_->streamInfo().setResponseCodeDetails("");
+  decoder_filters_[0]->callbacks_->encodeHeaders(
+      ResponseHeaderMapPtr{new TestResponseHeaderMapImpl{{":status", "200"}}}, true, "details");
+  response_encoder_.stream_.codec_callbacks_->onCodecEncodeComplete();
+  EXPECT_EQ(0, load.activeStreams());
+}
+
+// A stream that started before stream tracking was enabled is not counted when it completes.
+TEST_F(HttpConnectionManagerImplTest, DispatcherLoadStreamTrackingEnabledDuringStream) {
+  setup();
+  setupFilterChain(1, 0);
+  Event::DispatcherLoad& load = filter_callbacks_.connection_.dispatcher_.load_;
+
+  EXPECT_CALL(*decoder_filters_[0], decodeHeaders(_, true))
+      .WillOnce(Return(FilterHeadersStatus::StopIteration));
+  startRequest(true);
+  EXPECT_EQ(0, load.activeStreams());
+  load.enableStreamTracking();
+
+  EXPECT_CALL(response_encoder_, encodeHeaders(_, true));
+  decoder_filters_[0]->callbacks_->streamInfo().setResponseCodeDetails("");
+  decoder_filters_[0]->callbacks_->encodeHeaders(
+      ResponseHeaderMapPtr{new TestResponseHeaderMapImpl{{":status", "200"}}}, true, "details");
+  response_encoder_.stream_.codec_callbacks_->onCodecEncodeComplete();
+  EXPECT_EQ(0, load.activeStreams());
+}
+
 TEST_F(HttpConnectionManagerImplTest, DisconnectOnProxyConnectionDisconnect) {
   TestScopedRuntime scoped_runtime;
   scoped_runtime.mergeValues(
@@ -0,0 +1,103 @@
+// Note: this should be run with --compilation_mode=opt, and would benefit from a
+// quiescent system with disabled cstate power management.
+
+#include "envoy/config/route/v3/route.pb.h"
+
+#include "source/common/http/filter_chain_helper.h"
+#include "source/common/router/config_impl.h"
+
+#include "test/mocks/server/instance.h"
+#include "test/mocks/stream_info/mocks.h"
+#include "test/test_common/utility.h"
+
+#include "benchmark/benchmark.h"
+
+using testing::NiceMock;
+using testing::ReturnRef;
+
+namespace Envoy {
+namespace Http {
+
+// The number of filters of the benchmarked filter chains that are enabled by default.
+constexpr uint32_t EnabledFilters = 4;
+
+// Resolves the filters of a route like the filter manager does.
+class RouteFilterChainOptions : public FilterChainOptions {
+public:
+  RouteFilterChainOptions(Router::RouteConstSharedPtr route) : route_(std::move(route)) {}
+
+  absl::optional<bool> filterDisabled(absl::string_view config_name) const override {
+    return route_->filterDisabled(config_name);
+  }
+  bool hasFilterDisabledOverrides() const override { return route_->hasFilterDisabledOverrides(); }
+
+private:
+  const Router::RouteConstSharedPtr route_;
+};
+
+class CountingFilterChainManager : public FilterChainManager {
+public:
+  void applyFilterFactoryCb(FilterContext, FilterFactoryCb&) override { filters_++; }
+
+  uint64_t filters_{};
+};
+
+// Route /simple configures no filter. Route /override enables the first filter that is disabled
+// by default and disables the first filter that is enabled by default.
+static envoy::config::route::v3::RouteConfiguration genRouteConfig() {
+  return TestUtility::parseYaml<envoy::config::route::v3::RouteConfiguration>(R"EOF(
+virtual_hosts:
+  - name: default
+    domains: ["*"]
+    routes:
+      - match: { prefix: "/simple" }
+        direct_response: { status: 200 }
+      - match: { prefix: "/override" }
+        direct_response: { status: 200 }
+        typed_per_filter_config:
+          disabled_0:
+            "@type": type.googleapis.com/envoy.config.route.v3.FilterConfig
+            config: {}
+          enabled_0:
+            "@type": type.googleapis.com/envoy.config.route.v3.FilterConfig
+            disabled: true
+)EOF");
+}
+
+// Creates the filter chains of requests to a route, with range(0) filters that are disabled by
+// default in addition to the filters that are enabled by default. range(1) selects the route
+// that overrides filters.
+static void bmCreateFilterChain(benchmark::State& state) {
+  Api::ApiPtr api = Api::createApiForTest();
+  NiceMock<Server::Configuration::MockServerFactoryContext> factory_context;
+  ON_CALL(factory_context, api()).WillByDefault(ReturnRef(*api));
+  std::shared_ptr<Router::ConfigImpl> config = *Router::ConfigImpl::create(
+      genRouteConfig(), factory_context, ProtobufMessage::getNullValidationVisitor(), false);
+  NiceMock<StreamInfo::MockStreamInfo> stream_info;
+  const TestRequestHeaderMapImpl headers{{":authority", "www.example.com"},
+                                         {":method", "GET"},
+                                         {":path", state.range(1) != 0 ? "/override" : "/simple"},
+                                         {"x-forwarded-proto", "http"}};
+  const RouteFilterChainOptions options(config->route(headers, stream_info, 0));
+
+  FilterChainUtility::FilterFactoriesList filter_factories;
+  for (uint32_t i = 0; i < EnabledFilters + state.range(0); i++) {
+    const bool disabled = i >= EnabledFilters;
+    filter_factories.push_back(
+        {std::make_unique<Filter::StaticFilterConfigProviderImpl<Filter::HttpFilterFactoryCb>>(
+             [](FilterChainFactoryCallbacks&) {},
+             absl::StrCat(disabled ? "disabled_" : "enabled_",
+                          disabled ? i - EnabledFilters : i)),
+         disabled});
+  }
+
+  CountingFilterChainManager manager;
+  for (auto _ : state) { // NOLINT
+    FilterChainUtility::createFilterChainForFactories(manager, options, filter_factories);
+  }
+  benchmark::DoNotOptimize(manager.filters_);
+}
+BENCHMARK(bmCreateFilterChain)->ArgsProduct({{0, 4, 16, 64}, {0, 1}});
+
+} // namespace Http
+} // namespace Envoy
@@ -16,9 +16,12 @@ namespace {
 
 class MockFilterChainOptions : public FilterChainOptions {
 public:
-  MockFilterChainOptions() = default;
+  MockFilterChainOptions() {
+    ON_CALL(*this, hasFilterDisabledOverrides()).WillByDefault(Return(true));
+  }
 
   MOCK_METHOD(absl::optional<bool>, filterDisabled, (absl::string_view), (const));
+  MOCK_METHOD(bool, hasFilterDisabledOverrides, (), (const));
 };
 
 TEST(FilterChainUtilityTest, CreateFilterChainForFactoriesWithRouteDisabled) {
@@ -84,6 +87,25 @@ TEST(FilterChainUtilityTest, CreateFilterChainForFactoriesWithRouteDisabledAndDe
   }
 }
 
+TEST(FilterChainUtilityTest, CreateFilterChainForFactoriesWithoutOverrides) {
+  NiceMock<MockFilterChainManager> manager;
+  NiceMock<MockFilterChainOptions> options;
+  FilterChainUtility::FilterFactoriesList filter_factories;
+
+  for (const auto& name : {"filter_0", "filter_1", "filter_2"}) {
+    auto provider =
+        std::make_unique<Filter::StaticFilterConfigProviderImpl<Filter::HttpFilterFactoryCb>>(
+            [](FilterChainFactoryCallbacks&) {}, name);
+    filter_factories.push_back({std::move(provider), name == std::string("filter_1")});
+  }
+
+  // Only the filters that are enabled by default are added, without looking up the route.
+  EXPECT_CALL(options, hasFilterDisabledOverrides()).WillOnce(Return(false));
+  EXPECT_CALL(options, filterDisabled(_)).Times(0);
+  EXPECT_CALL(manager, applyFilterFactoryCb(_, _)).Times(2);
+  FilterChainUtility::createFilterChainForFactories(manager, options, filter_factories);
+}
+
 } // namespace
 } // namespace Http
 } // namespace Envoy
@@ -297,6 +297,64 @@ static void headerMapImplRemovePrefix(benchmark::State& state) {
 }
 BENCHMARK(headerMapImplRemovePrefix)->Arg(0)->Arg(1)->Arg(5)->Arg(10)->Arg(50);
 
+/**
+ * Measure the lifecycle of the request headers of a stream: creating the map and adding realistic
+ * browser request headers by copy as a codec does, getting and iterating them, and removing some of
+ * them as the router does. The numeric Arg selects whether the header list nodes are allocated from
+ * a per map arena (1) or one by one from the heap (0). The node_allocs counter reports the heap
+ * allocations of header list nodes per map.
+ */
+static void headerMapImplRequestLifecycle(benchmark::State& state) {
+  const std::pair<LowerCaseString, std::string> headers_to_add[] = {
+      {LowerCaseString(":method"), "GET"},
+      {LowerCaseString(":path"), "/products/category/shoes?sort=price&order=asc&page=2"},
+      {LowerCaseString(":scheme"), "https"},
+      {LowerCaseString(":authority"), "www.example.com"},
+      {LowerCaseString("sec-ch-ua"), "\"Chromium\";v=\"124\", \"Not-A.Brand\";v=\"99\""},
+      {LowerCaseString("sec-ch-ua-mobile"), "?0"},
+      {LowerCaseString("sec-ch-ua-platform"), "\"Windows\""},
+      {LowerCaseString("upgrade-insecure-requests"), "1"},
+      {LowerCaseString("user-agent"),
+       "Mozilla/5.0 (Windows NT 10.0; Win64; x64) AppleWebKit/537.36 (KHTML, like Gecko)"},
+      {LowerCaseString("accept"), "text/html,application/xhtml+xml,application/xml;q=0.9"},
+      {LowerCaseString("sec-fetch-site"), "same-origin"},
+      {LowerCaseString("sec-fetch-mode"), "navigate"},
+      {LowerCaseString("sec-fetch-user"), "?1"},
+      {LowerCaseString("sec-fetch-dest"), "document"},
+      {LowerCaseString("referer"), "https://www.example.com/products/category/shoes"},
+      {LowerCaseString("accept-encoding"), "gzip, deflate, br, zstd"},
+      {LowerCaseString("accept-language"), "en-US,en;q=0.9"},
+      {LowerCaseString("cookie"), "session_id=5f2b8c1e9a7d4e3f8b6a0c2d1e4f7a9b"},
+      {LowerCaseString("x-forwarded-for"), "192.0.2.1"},
+      {LowerCaseString("x-request-id"), "3b241101-e2bb-4255-8caf-4136c566a962"},
+  };
+  const LowerCaseString removed_key("sec-fetch-user");
+  const bool use_node_arena = state.range(0) != 0;
+  uint64_t node_allocs = 0;
+  for (auto _ : state) { // NOLINT
+    auto headers = Http::RequestHeaderMapImpl::create(UINT32_MAX, UINT32_MAX, use_node_arena);
+    for (const auto& key_value : headers_to_add) {
+      headers->addCopy(key_value.first, key_value.second);
+    }
+    benchmark::DoNotOptimize(headers->getPathValue());
+    benchmark::DoNotOptimize(headers->get(removed_key));
+    size_t size = 0;
+    headers->iterate([&size](const HeaderEntry& header) -> HeaderMap::Iterate {
+      size += header.value().size();
+      return HeaderMap::Iterate::Continue;
+    });
+    benchmark::DoNotOptimize(size);
+    headers->remove(removed_key);
+    headers->removeForwardedFor();
+    headers->setCopy(LowerCaseString("x-envoy-expected-rq-timeout-ms"), "15000");
+    node_allocs +=
+        use_node_arena ? headers->nodeArenaChunksForTest() : std::size(headers_to_add) + 1;
+  }
+  state.counters["node_allocs"] =
+      benchmark::Counter(node_allocs, benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(headerMapImplRequestLifecycle)->Arg(0)->Arg(1);
+
 class StaticLookupBenchmarker {
 public:
   explicit StaticLookupBenchmarker(std::unique_ptr<HeaderMapImpl> impl)
@@ -1087,5 +1087,76 @@ TEST(HeaderMapImplTest, HeaderMapMaxLimits) {
   EXPECT_EQ(response_trailer->maxHeadersCount(), 3);
 }
 
+// Applies the same operations to header maps with and without a node arena and expects the same
+// headers in the same order.
+TEST(HeaderMapImplTest, NodeArena) {
+  auto heap_headers = RequestHeaderMapImpl::create();
+  auto arena_headers = RequestHeaderMapImpl::create(UINT32_MAX, UINT32_MAX, true);
+  EXPECT_EQ(0, heap_headers->nodeArenaChunksForTest());
+  EXPECT_EQ(0, arena_headers->nodeArenaChunksForTest());
+
+  for (RequestHeaderMapImpl* headers : {heap_headers.get(), arena_headers.get()}) {
+    for (uint32_t i = 0; i < 100; i++) {
+      headers->addCopy(LowerCaseString(absl::StrCat("x-header-", i % 40)), absl::StrCat(i));
+      if (i % 10 == 0) {
+        headers->setPath(absl::StrCat("/", i));
+        headers->setMethod("GET");
+      }
+      if (i % 7 == 0) {
+        headers->remove(LowerCaseString(absl::StrCat("x-header-", i % 20)));
+      }
+      if (i % 30 == 0) {
+        headers->removeMethod();
+      }
+    }
+    headers->removeIf([](const HeaderEntry& entry) {
+      return absl::EndsWith(entry.key().getStringView(), "3");
+    });
+    headers->verifyByteSizeInternalForTest();
+  }
+  EXPECT_EQ(*heap_headers, *arena_headers);
+  std::vector<std::string> keys;
+  arena_headers->iterate([&keys](const HeaderEntry& header) -> HeaderMap::Iterate {
+    keys.emplace_back(header.key().getStringView());
+    return HeaderMap::Iterate::Continue;
+  });
+  EXPECT_EQ(":path", keys.front());
+  EXPECT_EQ(0, heap_headers->nodeArenaChunksForTest());
+  EXPECT_LT(0, arena_headers->nodeArenaChunksForTest());
+
+  // Slots are reused after clearing the map.
+  const uint32_t chunks = arena_headers->nodeArenaChunksForTest();
+  const size_t size = arena_headers->size();
+  arena_headers->clear();
+  for (size_t i = 0; i < size; i++) {
+    arena_headers->addCopy(LowerCaseString(absl::StrCat("x-other-", i)), "value");
+  }
+  EXPECT_EQ(chunks, arena_headers->nodeArenaChunksForTest());
+  arena_headers->verifyByteSizeInternalForTest();
+}
+
+TEST(HeaderNodeArenaTest, Chunks) {
+  HeaderNodeArena arena;
+  std::vector<void*> slots;
+  // Chunks of 4, 4, 8, 16 and 32 slots.
+  for (uint32_t i = 0; i < 64; i++) {
+    slots.push_back(arena.allocate(24));
+    EXPECT_EQ(0, reinterpret_cast<uintptr_t>(slots.back()) % alignof(std::max_align_t));
+  }
+  EXPECT_EQ(5, arena.chunks());
+  for (void* slot : slots) {
+    arena.deallocate(slot, 24);
+  }
+  for (uint32_t i = 0; i < 64; i++) {
+    arena.allocate(24);
+  }
+  EXPECT_EQ(5, arena.chunks());
+
+  // Larger allocations are not served from the slots.
+  void* large = arena.allocate(1024);
+  arena.deallocate(large, 1024);
+  EXPECT_EQ(5, arena.chunks());
+}
+
 } // namespace Http
 } // namespace Envoy
@@ -905,6 +905,26 @@ TEST_F(Http1ServerConnectionImplTest, CodecHasDefaultStreamErrorIfNotSet) {
   EXPECT_FALSE(response_encoder->streamErrorOnInvalidHttpMessage());
 }
 
+// The codec latches the header_map_node_arena guard when it is created and passes it to the header
+// maps it creates.
+TEST_F(Http1ServerConnectionImplTest, HeaderMapNodeArena) {
+  TestScopedRuntime scoped_runtime;
+  scoped_runtime.mergeValues({{"envoy.reloadable_features.header_map_node_arena", "true"}});
+  initialize();
+  scoped_runtime.mergeValues({{"envoy.reloadable_features.header_map_node_arena", "false"}});
+
+  MockRequestDecoder decoder;
+  EXPECT_CALL(callbacks_, newStream(_, _)).WillOnce(ReturnRef(decoder));
+  EXPECT_CALL(decoder, decodeHeaders_(_, true))
+      .WillOnce(Invoke([](Http::RequestHeaderMapSharedPtr& headers, bool) -> void {
+        EXPECT_LT(0, dynamic_cast<RequestHeaderMapImpl&>(*headers).nodeArenaChunksForTest());
+      }));
+
+  Buffer::OwnedImpl buffer("GET / HTTP/1.1\r\nhost: example.com\r\n\r\n");
+  auto status = codec_->dispatch(buffer);
+  EXPECT_TRUE(status.ok());
+}
+
 TEST_F(Http1ServerConnectionImplTest, Http10) {
   codec_settings_.accept_http_10_ = true;
   initialize();
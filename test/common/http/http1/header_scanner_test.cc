@@ -0,0 +1,92 @@
+#include <string>
+
+#include "source/common/http/header_utility.h"
+#include "source/common/http/http1/header_scanner.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Http {
+namespace Http1 {
+namespace {
+
+constexpr absl::string_view TokenChars =
+    "!#$%&'*+-.0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ^_`abcdefghijklmnopqrstuvwxyz|~";
+
+bool isValidHeaderValueChar(uint8_t c) {
+  return HeaderUtility::headerValueIsValid(absl::string_view(reinterpret_cast<char*>(&c), 1));
+}
+
+bool isValidPathQueryChar(uint8_t c) { return c == 9 || c == 12 || ('!' <= c && c <= 126); }
+
+// Runs every test with both the vectorized and the byte-wise scans.
+class HeaderScannerTest : public testing::TestWithParam<bool> {
+public:
+  HeaderScannerTest() { HeaderScanner::forceScalarForTest(GetParam()); }
+  ~HeaderScannerTest() override { HeaderScanner::forceScalarForTest(false); }
+
+  // Places `c` at every position of valid strings of every length up to a few vectors, to cover
+  // the vector loops and their tails.
+  void expectPositions(size_t (*scan)(absl::string_view), char filler, uint8_t c, bool valid) {
+    for (size_t size = 1; size <= 100; size++) {
+      std::string input(size, filler);
+      ASSERT_EQ(HeaderScanner::NotFound, scan(input));
+      for (size_t position = 0; position < size; position++) {
+        input[position] = c;
+        ASSERT_EQ(valid ? HeaderScanner::NotFound : position, scan(input))
+            << "byte " << static_cast<int>(c) << " at " << position << " of " << size;
+        input[position] = filler;
+      }
+    }
+  }
+};
+
+INSTANTIATE_TEST_SUITE_P(ForceScalar, HeaderScannerTest, testing::Bool());
+
+TEST_P(HeaderScannerTest, Empty) {
+  EXPECT_EQ(HeaderScanner::NotFound, HeaderScanner::findInvalidHeaderNameChar(""));
+  EXPECT_EQ(HeaderScanner::NotFound, HeaderScanner::findInvalidHeaderValueChar(""));
+  EXPECT_EQ(HeaderScanner::NotFound, HeaderScanner::findInvalidPathQueryChar(""));
+  EXPECT_EQ(HeaderScanner::NotFound, HeaderScanner::findCrOrLf(""));
+}
+
+TEST_P(HeaderScannerTest, HeaderName) {
+  for (uint32_t c = 0; c < 256; c++) {
+    expectPositions(HeaderScanner::findInvalidHeaderNameChar, 'a', c,
+                    c != 0 && TokenChars.find(static_cast<char>(c)) != absl::string_view::npos);
+  }
+}
+
+TEST_P(HeaderScannerTest, HeaderValue) {
+  for (uint32_t c = 0; c < 256; c++) {
+    expectPositions(HeaderScanner::findInvalidHeaderValueChar, ' ', c, isValidHeaderValueChar(c));
+  }
+}
+
+TEST_P(HeaderScannerTest, PathQuery) {
+  for (uint32_t c = 0; c < 256; c++) {
+    expectPositions(HeaderScanner::findInvalidPathQueryChar, '/', c, isValidPathQueryChar(c));
+  }
+}
+
+TEST_P(HeaderScannerTest, CrOrLf) {
+  for (uint32_t c = 0; c < 256; c++) {
+    expectPositions(HeaderScanner::findCrOrLf, 'x', c, c != '\r' && c != '\n');
+  }
+}
+
+// The first of several invalid characters is found.
+TEST_P(HeaderScannerTest, FirstInvalid) {
+  std::string value(64, 'v');
+  value[40] = '\x7f';
+  value[20] = '\x01';
+  value[50] = '\n';
+  EXPECT_EQ(20, HeaderScanner::findInvalidHeaderValueChar(value));
+  EXPECT_EQ(50, HeaderScanner::findCrOrLf(value));
+  EXPECT_EQ(20, HeaderScanner::findInvalidHeaderNameChar(value));
+}
+
+} // namespace
+} // namespace Http1
+} // namespace Http
+} // namespace Envoy
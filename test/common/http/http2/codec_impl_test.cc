@@ -3254,6 +3254,195 @@ TEST_P(Http2CodecImplTest, PingFloodMitigationDisabled) {
   EXPECT_NO_THROW(driveToCompletion());
 }
 
+// Verify that frames are written to the connection once per event loop iteration when outbound
+// frame coalescing is enabled.
+TEST_P(Http2CodecImplTest, OutboundFrameCoalescing) {
+  server_http2_options_.mutable_outbound_frame_coalescing();
+  auto* flush_callback =
+      new NiceMock<Event::MockSchedulableCallback>(&server_connection_.dispatcher_);
+  initialize();
+  auto drive = [&]() {
+    driveToCompletion();
+    while (flush_callback->enabled_) {
+      flush_callback->invokeCallback();
+      driveToCompletion();
+    }
+  };
+
+  TestRequestHeaderMapImpl request_headers;
+  HttpTestUtility::addDefaultHeaders(request_headers);
+  EXPECT_CALL(request_decoder_, decodeHeaders_(_, false));
+  EXPECT_TRUE(request_encoder_->encodeHeaders(request_headers, false).ok());
+  drive();
+
+  uint32_t writes = 0;
+  ON_CALL(server_connection_, write(_, _))
+      .WillByDefault(Invoke([&](Buffer::Instance& data, bool) -> void {
+        writes++;
+        client_wrapper_->buffer_.add(data);
+      }));
+  const uint64_t coalesced_writes =
+      server_stats_store_.counter("http2.outbound_coalesced_writes").value();
+  const uint64_t coalesced_frames =
+      server_stats_store_.counter("http2.outbound_coalesced_frames").value();
+
+  TestResponseHeaderMapImpl response_headers{{":status", "200"}};
+  response_encoder_->encodeHeaders(response_headers, false);
+  Buffer::OwnedImpl first("first");
+  response_encoder_->encodeData(first, false);
+  Buffer::OwnedImpl second("second");
+  response_encoder_->encodeData(second, false);
+  Buffer::OwnedImpl third("third");
+  response_encoder_->encodeData(third, true);
+  EXPECT_EQ(0, writes);
+  EXPECT_TRUE(flush_callback->enabled_);
+
+  // The HEADERS frame and three DATA frames are written at once.
+  EXPECT_CALL(response_decoder_, decodeHeaders_(_, false));
+  EXPECT_CALL(response_decoder_, decodeData(_, false)).Times(AnyNumber());
+  EXPECT_CALL(response_decoder_, decodeData(_, true));
+  flush_callback->invokeCallback();
+  EXPECT_EQ(1, writes);
+  EXPECT_EQ(coalesced_writes + 1,
+            server_stats_store_.counter("http2.outbound_coalesced_writes").value());
+  EXPECT_EQ(coalesced_frames + 4,
+            server_stats_store_.counter("http2.outbound_coalesced_frames").value());
+  drive();
+}
+
+// Verify that coalesced frames are written as soon as the threshold of coalesced bytes is
+// reached, and that a GOAWAY frame is written immediately.
+TEST_P(Http2CodecImplTest, OutboundFrameCoalescingThresholdAndGoAway) {
+  auto* coalescing = server_http2_options_.mutable_outbound_frame_coalescing();
+  coalescing->mutable_max_coalesced_bytes()->set_value(100);
+  auto* flush_callback =
+      new NiceMock<Event::MockSchedulableCallback>(&server_connection_.dispatcher_);
+  initialize();
+  auto drive = [&]() {
+    driveToCompletion();
+    while (flush_callback->enabled_) {
+      flush_callback->invokeCallback();
+      driveToCompletion();
+    }
+  };
+
+  TestRequestHeaderMapImpl request_headers;
+  HttpTestUtility::addDefaultHeaders(request_headers);
+  EXPECT_CALL(request_decoder_, decodeHeaders_(_, false));
+  EXPECT_TRUE(request_encoder_->encodeHeaders(request_headers, false).ok());
+  drive();
+
+  uint32_t writes = 0;
+  ON_CALL(server_connection_, write(_, _))
+      .WillByDefault(Invoke([&](Buffer::Instance& data, bool) -> void {
+        writes++;
+        client_wrapper_->buffer_.add(data);
+      }));
+
+  TestResponseHeaderMapImpl response_headers{{":status", "200"}};
+  response_encoder_->encodeHeaders(response_headers, false);
+  EXPECT_EQ(0, writes);
+  EXPECT_TRUE(flush_callback->enabled_);
+  Buffer::OwnedImpl body(std::string(1024, 'a'));
+  response_encoder_->encodeData(body, false);
+  EXPECT_EQ(1, writes);
+  EXPECT_FALSE(flush_callback->enabled_);
+  EXPECT_CALL(response_decoder_, decodeHeaders_(_, false));
+  EXPECT_CALL(response_decoder_, decodeData(_, false)).Times(AnyNumber());
+  drive();
+
+  writes = 0;
+  EXPECT_CALL(client_callbacks_, onGoAway(_));
+  server_->goAway();
+  EXPECT_EQ(1, writes);
+  EXPECT_FALSE(flush_callback->enabled_);
+  drive();
+}
+
+// Verify that the last frames of a draining connection and its GOAWAY reach the peer before the
+// connection is closed when outbound frame coalescing is enabled.
+TEST_P(Http2CodecImplTest, OutboundFrameCoalescingDrainAndClose) {
+  server_http2_options_.mutable_outbound_frame_coalescing();
+  auto* flush_callback =
+      new NiceMock<Event::MockSchedulableCallback>(&server_connection_.dispatcher_);
+  initialize();
+  auto drive = [&]() {
+    driveToCompletion();
+    while (flush_callback->enabled_) {
+      flush_callback->invokeCallback();
+      driveToCompletion();
+    }
+  };
+
+  TestRequestHeaderMapImpl request_headers;
+  HttpTestUtility::addDefaultHeaders(request_headers);
+  EXPECT_CALL(request_decoder_, decodeHeaders_(_, true));
+  EXPECT_TRUE(request_encoder_->encodeHeaders(request_headers, true).ok());
+  drive();
+
+  // Coalesced frames that have not been written yet are reported as pending writes.
+  TestResponseHeaderMapImpl continue_headers{{":status", "100"}};
+  response_encoder_->encode1xxHeaders(continue_headers);
+  EXPECT_TRUE(flush_callback->enabled_);
+  EXPECT_TRUE(server_->wantsToWrite());
+  EXPECT_CALL(response_decoder_, decode1xxHeaders_(_));
+  flush_callback->invokeCallback();
+  EXPECT_FALSE(server_->wantsToWrite());
+  driveToCompletion();
+
+  // The connection drains: the GOAWAY and every frame sent after it are written right away.
+  EXPECT_CALL(client_callbacks_, onGoAway(_));
+  server_->shutdownNotice();
+  server_->goAway();
+  EXPECT_FALSE(flush_callback->enabled_);
+  EXPECT_FALSE(server_->wantsToWrite());
+
+  TestResponseHeaderMapImpl response_headers{{":status", "200"}};
+  response_encoder_->encodeHeaders(response_headers, false);
+  Buffer::OwnedImpl body("body");
+  response_encoder_->encodeData(body, true);
+  EXPECT_FALSE(flush_callback->enabled_);
+  EXPECT_FALSE(server_->wantsToWrite());
+
+  // The connection manager closes the connection as nothing is left to write. The peer still
+  // receives the final HEADERS and DATA frames.
+  server_connection_.state_ = Network::Connection::State::Closed;
+  EXPECT_CALL(response_decoder_, decodeHeaders_(_, false));
+  EXPECT_CALL(response_decoder_, decodeData(_, true));
+  driveClient();
+}
+
+// Verify that the GOAWAY sent on a codec error is written to the connection, which is closed
+// right after the error, when outbound frame coalescing is enabled.
+TEST_P(Http2CodecImplTest, OutboundFrameCoalescingProtocolError) {
+  server_http2_options_.mutable_outbound_frame_coalescing();
+  auto* flush_callback =
+      new NiceMock<Event::MockSchedulableCallback>(&server_connection_.dispatcher_);
+  initialize();
+  auto drive = [&]() {
+    driveToCompletion();
+    while (flush_callback->enabled_) {
+      flush_callback->invokeCallback();
+      driveToCompletion();
+    }
+  };
+
+  TestRequestHeaderMapImpl request_headers;
+  HttpTestUtility::addDefaultHeaders(request_headers);
+  EXPECT_CALL(request_decoder_, decodeHeaders_(_, true));
+  EXPECT_TRUE(request_encoder_->encodeHeaders(request_headers, true).ok());
+  drive();
+
+  EXPECT_CALL(client_callbacks_, onGoAway(Http::GoAwayErrorCode::Other));
+  ServerConnectionImpl* raw_server = dynamic_cast<ServerConnectionImpl*>(server_.get());
+  ASSERT(raw_server != nullptr);
+  EXPECT_EQ(StatusCode::CodecProtocolError, getStatusCode(raw_server->protocolErrorForTest()));
+  EXPECT_FALSE(flush_callback->enabled_);
+  EXPECT_FALSE(server_->wantsToWrite());
+  server_connection_.state_ = Network::Connection::State::Closed;
+  driveClient();
+}
+
 // Verify that outbound control frame counter decreases when send buffer is drained
 TEST_P(Http2CodecImplTest, PingFloodCounterReset) {
   // Ping frames are 17 bytes each so 240 full frames and a partial frame fit in the current min
@@ -0,0 +1,81 @@
+#include <sys/socket.h>
+
+#include "source/common/api/os_sys_calls_impl.h"
+#include "source/common/io/io_uring_impl.h"
+#include "source/common/io/io_uring_worker_impl.h"
+#include "source/common/memory/stats.h"
+
+#include "test/benchmark/main.h"
+#include "test/test_common/utility.h"
+
+#include "benchmark/benchmark.h"
+
+namespace Envoy {
+namespace Io {
+namespace {
+
+constexpr uint32_t ReadBufferSize = 8192;
+
+// Measures the memory held by idle server sockets, i.e. sockets with a read in flight and no data
+// to read. Without a buffer ring every socket holds a read buffer, with a buffer ring the buffers
+// are shared by all the sockets of the worker and only taken when data arrives.
+void benchmarkIdleServerSocketMemory(::benchmark::State& state) {
+  const uint32_t buffer_ring_size = state.range(0);
+  const uint32_t num_sockets = state.range(1);
+
+  if (!isIoUringSupported()) {
+    state.SkipWithError("io_uring is not supported");
+    return;
+  }
+  if (benchmark::skipExpensiveBenchmarks() && num_sockets > 100) {
+    state.SkipWithError("Skipping expensive benchmark");
+    return;
+  }
+
+  Api::ApiPtr api = Api::createApiForTest();
+  Event::DispatcherPtr dispatcher = api->allocateDispatcher("test_thread");
+
+  for (auto _ : state) { // NOLINT: Silences warning about dead store
+    state.PauseTiming();
+    const size_t start_worker_mem = Memory::Stats::totalCurrentlyAllocated();
+    IoUringWorkerImpl worker(std::make_unique<IoUringImpl>(num_sockets + 16, false),
+                             ReadBufferSize, 1000, 0, buffer_ring_size, nullptr, *dispatcher);
+    const size_t end_worker_mem = Memory::Stats::totalCurrentlyAllocated();
+    if (buffer_ring_size > 0 && !worker.multishotRecvEnabled()) {
+      state.SkipWithError("io_uring provided buffer rings are not supported");
+      break;
+    }
+
+    std::vector<os_fd_t> client_fds;
+    client_fds.reserve(num_sockets);
+    const size_t start_mem = Memory::Stats::totalCurrentlyAllocated();
+    state.ResumeTiming();
+    for (uint32_t i = 0; i < num_sockets; i++) {
+      os_fd_t fds[2];
+      const Api::SysCallIntResult result =
+          Api::OsSysCallsSingleton::get().socketpair(AF_UNIX, SOCK_STREAM, 0, fds);
+      RELEASE_ASSERT(result.return_value_ == 0, "unable to create a socket pair");
+      worker.addServerSocket(fds[0], [](uint32_t) { return absl::OkStatus(); }, false);
+      client_fds.push_back(fds[1]);
+    }
+    state.PauseTiming();
+    const size_t end_mem = Memory::Stats::totalCurrentlyAllocated();
+    state.counters["worker_memory"] = end_worker_mem - start_worker_mem;
+    state.counters["memory_per_idle_connection"] = (end_mem - start_mem) / num_sockets;
+
+    for (os_fd_t fd : client_fds) {
+      Api::OsSysCallsSingleton::get().close(fd);
+    }
+    state.ResumeTiming();
+  }
+}
+BENCHMARK(benchmarkIdleServerSocketMemory)
+    ->Args({0, 100})
+    ->Args({256, 100})
+    ->Args({0, 400})
+    ->Args({256, 400})
+    ->Unit(::benchmark::kMillisecond);
+
+} // namespace
+} // namespace Io
+} // namespace Envoy
@@ -2,6 +2,7 @@
 
 #include "source/common/io/io_uring_worker_impl.h"
 #include "source/common/network/address_impl.h"
+#include "source/common/stats/isolated_store_impl.h"
 
 #include "test/mocks/event/mocks.h"
 #include "test/mocks/io/mocks.h"
@@ -33,8 +34,13 @@ public:
 
 class IoUringWorkerTestImpl : public IoUringWorkerImpl {
 public:
-  IoUringWorkerTestImpl(IoUringPtr io_uring_instance, Event::Dispatcher& dispatcher)
-      : IoUringWorkerImpl(std::move(io_uring_instance), 8192, 1000, dispatcher) {}
+  IoUringWorkerTestImpl(IoUringPtr io_uring_instance, Event::Dispatcher& dispatcher,
+                        uint32_t zero_copy_send_threshold = 0,
+                        IoUringWorkerStatsSharedPtr stats = nullptr, uint32_t buffer_ring_size = 0,
+                        uint32_t read_buffer_size = 8192)
+      : IoUringWorkerImpl(std::move(io_uring_instance), read_buffer_size, 1000,
+                          zero_copy_send_threshold, buffer_ring_size, std::move(stats),
+                          dispatcher) {}
 
   IoUringSocket& addTestSocket(os_fd_t fd) {
     return addSocket(std::make_unique<IoUringSocketTestImpl>(fd, *this));
@@ -464,6 +470,676 @@ TEST(IoUringWorkerImplTest, ServerCloseWithWriteRequestOnly) {
   EXPECT_EQ(0, worker.getSockets().size());
 }
 
+TEST(IoUringWorkerImplTest, ServerSocketZeroCopySend) {
+  Event::MockDispatcher dispatcher;
+  IoUringPtr io_uring_instance = std::make_unique<MockIoUring>();
+  MockIoUring& mock_io_uring = *dynamic_cast<MockIoUring*>(io_uring_instance.get());
+  Event::FileReadyCb file_event_callback;
+  Stats::IsolatedStoreImpl stats_store;
+  Stats::Scope& scope = *stats_store.rootScope();
+  auto stats = std::make_shared<IoUringWorkerStats>(IoUringWorkerStats{ALL_IO_URING_WORKER_STATS(
+      POOL_COUNTER_PREFIX(scope, "io_uring."), POOL_HISTOGRAM_PREFIX(scope, "io_uring."))});
+
+  EXPECT_CALL(mock_io_uring, registerEventfd());
+  EXPECT_CALL(dispatcher,
+              createFileEvent_(_, _, Event::PlatformDefaultTriggerType, Event::FileReadyType::Read))
+      .WillOnce(
+          DoAll(SaveArg<1>(&file_event_callback), ReturnNew<NiceMock<Event::MockFileEvent>>()));
+  std::unique_ptr<IoUringWorkerTestImpl> worker =
+      std::make_unique<IoUringWorkerTestImpl>(std::move(io_uring_instance), dispatcher, 16, stats);
+
+  os_fd_t fd = 11;
+  SET_SOCKET_INVALID(fd);
+
+  // The read request added by server socket constructor.
+  Request* read_req = nullptr;
+  EXPECT_CALL(mock_io_uring, prepareReadv(fd, _, _, _, _))
+      .WillOnce(DoAll(SaveArg<4>(&read_req), Return<IoUringResult>(IoUringResult::Ok)));
+  EXPECT_CALL(mock_io_uring, submit()).Times(1).RetiresOnSaturation();
+  auto& io_uring_socket =
+      worker->addServerSocket(fd, [](uint32_t) { return absl::OkStatus(); }, false);
+
+  // Disable the socket and finish the read request, then there will be no new read request.
+  io_uring_socket.disableRead();
+  EXPECT_CALL(mock_io_uring, forEveryCompletion(_))
+      .WillOnce(Invoke([&read_req](const CompletionCb& cb) { cb(read_req, -EAGAIN, false); }));
+  EXPECT_CALL(mock_io_uring, submit()).Times(1).RetiresOnSaturation();
+  ASSERT_TRUE(file_event_callback(Event::FileReadyType::Read).ok());
+
+  // A write below the threshold is copied.
+  Request* write_req = nullptr;
+  EXPECT_CALL(mock_io_uring, prepareWritev(fd, _, _, _, _))
+      .WillOnce(DoAll(SaveArg<4>(&write_req), Return<IoUringResult>(IoUringResult::Ok)));
+  EXPECT_CALL(mock_io_uring, submit()).Times(1).RetiresOnSaturation();
+  Buffer::OwnedImpl small_buf("Hello");
+  io_uring_socket.write(small_buf);
+
+  EXPECT_CALL(mock_io_uring, forEveryCompletion(_))
+      .WillOnce(Invoke([&write_req](const CompletionCb& cb) { cb(write_req, 5, false); }));
+  EXPECT_CALL(mock_io_uring, submit()).Times(1).RetiresOnSaturation();
+  ASSERT_TRUE(file_event_callback(Event::FileReadyType::Read).ok());
+  EXPECT_EQ(5, stats->write_copied_bytes_.value());
+
+  // A write above the threshold is sent with zero-copy, and the sent data is kept by the request.
+  Request* send_req = nullptr;
+  const struct msghdr* msg = nullptr;
+  EXPECT_CALL(mock_io_uring, prepareSendmsgZc(fd, _, _))
+      .WillOnce(DoAll(SaveArg<1>(&msg), SaveArg<2>(&send_req),
+                      Return<IoUringResult>(IoUringResult::Ok)))
+      .RetiresOnSaturation();
+  EXPECT_CALL(mock_io_uring, submit()).Times(1).RetiresOnSaturation();
+  const std::string data(64, 'a');
+  Buffer::OwnedImpl large_buf(data);
+  io_uring_socket.write(large_buf);
+  ASSERT_NE(nullptr, msg);
+  EXPECT_EQ(1, msg->msg_iovlen);
+  EXPECT_EQ(64, msg->msg_iov[0].iov_len);
+  const void* sent_data = msg->msg_iov[0].iov_base;
+
+  // A partial send, the unsent data is submitted again while the sent data stays pinned until the
+  // notification arrives.
+  Request* second_send_req = nullptr;
+  EXPECT_CALL(mock_io_uring, forEveryCompletion(_))
+      .WillOnce(Invoke([&mock_io_uring, fd, &send_req, &second_send_req](const CompletionCb& cb) {
+        EXPECT_CALL(mock_io_uring, prepareSendmsgZc(fd, _, _))
+            .WillOnce(
+                DoAll(SaveArg<2>(&second_send_req), Return<IoUringResult>(IoUringResult::Ok)))
+            .RetiresOnSaturation();
+        send_req->setCompletionFlags(IORING_CQE_F_MORE);
+        cb(send_req, 32, false);
+      }));
+  EXPECT_CALL(mock_io_uring, submit()).Times(1).RetiresOnSaturation();
+  ASSERT_TRUE(file_event_callback(Event::FileReadyType::Read).ok());
+  EXPECT_EQ(32, stats->write_zero_copy_bytes_.value());
+  EXPECT_EQ(1, stats->write_zero_copy_requests_.value());
+  EXPECT_EQ(data, static_cast<SendZcRequest*>(send_req)->data_.toString());
+  EXPECT_EQ(sent_data, static_cast<SendZcRequest*>(send_req)->data_.frontSlice().mem_);
+  EXPECT_EQ(std::string(32, 'a'), static_cast<SendZcRequest*>(second_send_req)->data_.toString());
+
+  // The notification releases the first request.
+  EXPECT_CALL(mock_io_uring, forEveryCompletion(_))
+      .WillOnce(Invoke([&send_req](const CompletionCb& cb) {
+        send_req->setCompletionFlags(IORING_CQE_F_NOTIF);
+        cb(send_req, 0, false);
+      }));
+  EXPECT_CALL(mock_io_uring, submit()).Times(1).RetiresOnSaturation();
+  ASSERT_TRUE(file_event_callback(Event::FileReadyType::Read).ok());
+
+  // Complete the second request, its notification is still pending when the socket is closed.
+  EXPECT_CALL(mock_io_uring, forEveryCompletion(_))
+      .WillOnce(Invoke([&second_send_req](const CompletionCb& cb) {
+        second_send_req->setCompletionFlags(IORING_CQE_F_MORE);
+        cb(second_send_req, 32, false);
+      }));
+  EXPECT_CALL(mock_io_uring, submit()).Times(1).RetiresOnSaturation();
+  ASSERT_TRUE(file_event_callback(Event::FileReadyType::Read).ok());
+  EXPECT_EQ(64, stats->write_zero_copy_bytes_.value());
+  EXPECT_EQ(2, stats->write_zero_copy_requests_.value());
+
+  // There are no requests in flight, so the socket is closed directly.
+  Request* close_req = nullptr;
+  EXPECT_CALL(mock_io_uring, prepareClose(fd, _))
+      .WillOnce(DoAll(SaveArg<1>(&close_req), Return<IoUringResult>(IoUringResult::Ok)));
+  EXPECT_CALL(mock_io_uring, submit()).Times(1).RetiresOnSaturation();
+  io_uring_socket.close(false);
+
+  EXPECT_CALL(mock_io_uring, forEveryCompletion(_))
+      .WillOnce(Invoke([&close_req](const CompletionCb& cb) { cb(close_req, 0, false); }));
+  EXPECT_CALL(mock_io_uring, removeInjectedCompletion(fd));
+  EXPECT_CALL(dispatcher, deferredDelete_);
+  EXPECT_CALL(mock_io_uring, submit()).Times(1).RetiresOnSaturation();
+  ASSERT_TRUE(file_event_callback(Event::FileReadyType::Read).ok());
+  EXPECT_EQ(0, worker->getSockets().size());
+
+  // The worker releases the request still waiting for its notification on destruction.
+  EXPECT_CALL(dispatcher, clearDeferredDeleteList());
+  worker.reset();
+}
+
+TEST(IoUringWorkerImplTest, ServerSocketMultishotRecv) {
+  Event::MockDispatcher dispatcher;
+  IoUringPtr io_uring_instance = std::make_unique<MockIoUring>();
+  MockIoUring& mock_io_uring = *dynamic_cast<MockIoUring*>(io_uring_instance.get());
+  Event::FileReadyCb file_event_callback;
+
+  // The worker fills the buffer ring on construction.
+  std::vector<uint8_t*> provided_buffers(4);
+  EXPECT_CALL(mock_io_uring, registerBufferRing(IoUringWorkerImpl::ProvidedBufferGroup, 4))
+      .WillOnce(Return<IoUringResult>(IoUringResult::Ok));
+  EXPECT_CALL(mock_io_uring, addBufferToRing(IoUringWorkerImpl::ProvidedBufferGroup, _, 8192, _))
+      .Times(4)
+      .WillRepeatedly(Invoke([&provided_buffers](uint16_t, uint8_t* buf, uint32_t,
+                                                 uint16_t buffer_id) {
+        provided_buffers[buffer_id] = buf;
+        return IoUringResult::Ok;
+      }))
+      .RetiresOnSaturation();
+  EXPECT_CALL(mock_io_uring, registerEventfd());
+  EXPECT_CALL(dispatcher,
+              createFileEvent_(_, _, Event::PlatformDefaultTriggerType, Event::FileReadyType::Read))
+      .WillOnce(
+          DoAll(SaveArg<1>(&file_event_callback), ReturnNew<NiceMock<Event::MockFileEvent>>()));
+  IoUringWorkerTestImpl worker(std::move(io_uring_instance), dispatcher, 0, nullptr, 4);
+  EXPECT_TRUE(worker.multishotRecvEnabled());
+
+  os_fd_t fd = 11;
+  SET_SOCKET_INVALID(fd);
+
+  // The server socket arms a multishot recv instead of submitting a read with its own buffer.
+  Request* read_req = nullptr;
+  EXPECT_CALL(mock_io_uring, prepareReadv(_, _, _, _, _)).Times(0);
+  EXPECT_CALL(mock_io_uring, prepareRecvMultishot(fd, IoUringWorkerImpl::ProvidedBufferGroup, _))
+      .WillOnce(DoAll(SaveArg<2>(&read_req), Return<IoUringResult>(IoUringResult::Ok)))
+      .RetiresOnSaturation();
+  EXPECT_CALL(mock_io_uring, submit()).Times(1).RetiresOnSaturation();
+  std::string received;
+  OptRef<IoUringSocket> socket;
+  socket = worker.addServerSocket(
+      fd,
+      [&socket, &received](uint32_t) {
+        received.append(socket->getReadParam()->buf_.toString());
+        socket->getReadParam()->buf_.drain(socket->getReadParam()->buf_.length());
+        return absl::OkStatus();
+      },
+      false);
+
+  // The kernel fills the buffer 2, the received bytes are copied to the socket and the same
+  // buffer goes back to the ring. The recv stays armed.
+  uint8_t* filled_buffer = provided_buffers[2];
+  memcpy(filled_buffer, "hello", 5);
+  EXPECT_CALL(mock_io_uring, forEveryCompletion(_))
+      .WillOnce(Invoke([&read_req](const CompletionCb& cb) {
+        read_req->setCompletionFlags(IORING_CQE_F_BUFFER | IORING_CQE_F_MORE |
+                                     (2 << IORING_CQE_BUFFER_SHIFT));
+        cb(read_req, 5, false);
+      }));
+  EXPECT_CALL(mock_io_uring,
+              addBufferToRing(IoUringWorkerImpl::ProvidedBufferGroup, filled_buffer, 8192, 2))
+      .WillOnce(Return<IoUringResult>(IoUringResult::Ok))
+      .RetiresOnSaturation();
+  EXPECT_CALL(mock_io_uring, submit()).Times(1).RetiresOnSaturation();
+  ASSERT_TRUE(file_event_callback(Event::FileReadyType::Read).ok());
+  EXPECT_EQ("hello", received);
+
+  // The ring ran out of buffers, which ends the multishot recv. It is armed again.
+  Request* second_read_req = nullptr;
+  EXPECT_CALL(mock_io_uring, forEveryCompletion(_))
+      .WillOnce(Invoke([&read_req](const CompletionCb& cb) {
+        read_req->setCompletionFlags(0);
+        cb(read_req, -ENOBUFS, false);
+      }));
+  EXPECT_CALL(mock_io_uring, prepareRecvMultishot(fd, IoUringWorkerImpl::ProvidedBufferGroup, _))
+      .WillOnce(DoAll(SaveArg<2>(&second_read_req), Return<IoUringResult>(IoUringResult::Ok)))
+      .RetiresOnSaturation();
+  EXPECT_CALL(mock_io_uring, submit()).Times(1).RetiresOnSaturation();
+  ASSERT_TRUE(file_event_callback(Event::FileReadyType::Read).ok());
+  EXPECT_EQ("hello", received);
+
+  // Close the socket, the armed recv is cancelled first.
+  Request* cancel_req = nullptr;
+  EXPECT_CALL(mock_io_uring, prepareCancel(second_read_req, _))
+      .WillOnce(DoAll(SaveArg<1>(&cancel_req), Return<IoUringResult>(IoUringResult::Ok)))
+      .RetiresOnSaturation();
+  EXPECT_CALL(mock_io_uring, submit()).Times(1).RetiresOnSaturation();
+  socket->close(false);
+
+  Request* close_req = nullptr;
+  EXPECT_CALL(mock_io_uring, forEveryCompletion(_))
+      .WillOnce(Invoke([&second_read_req, &cancel_req](const CompletionCb& cb) {
+        cb(second_read_req, -ECANCELED, false);
+        cb(cancel_req, 0, false);
+      }));
+  EXPECT_CALL(mock_io_uring, prepareClose(fd, _))
+      .WillOnce(DoAll(SaveArg<1>(&close_req), Return<IoUringResult>(IoUringResult::Ok)))
+      .RetiresOnSaturation();
+  EXPECT_CALL(mock_io_uring, submit()).Times(1).RetiresOnSaturation();
+  ASSERT_TRUE(file_event_callback(Event::FileReadyType::Read).ok());
+
+  EXPECT_CALL(mock_io_uring, forEveryCompletion(_))
+      .WillOnce(Invoke([&close_req](const CompletionCb& cb) { cb(close_req, 0, false); }));
+  EXPECT_CALL(mock_io_uring, removeInjectedCompletion(fd));
+  EXPECT_CALL(dispatcher, deferredDelete_);
+  EXPECT_CALL(dispatcher, clearDeferredDeleteList());
+  EXPECT_CALL(mock_io_uring, submit()).Times(1).RetiresOnSaturation();
+  ASSERT_TRUE(file_event_callback(Event::FileReadyType::Read).ok());
+  EXPECT_EQ(0, worker.getSockets().size());
+}
+
+TEST(IoUringWorkerImplTest, ServerSocketMultishotRecvDisableRead) {
+  Event::MockDispatcher dispatcher;
+  IoUringPtr io_uring_instance = std::make_unique<MockIoUring>();
+  MockIoUring& mock_io_uring = *dynamic_cast<MockIoUring*>(io_uring_instance.get());
+  Event::FileReadyCb file_event_callback;
+
+  std::vector<uint8_t*> provided_buffers(4);
+  EXPECT_CALL(mock_io_uring, registerBufferRing(IoUringWorkerImpl::ProvidedBufferGroup, 4))
+      .WillOnce(Return<IoUringResult>(IoUringResult::Ok));
+  EXPECT_CALL(mock_io_uring, addBufferToRing(IoUringWorkerImpl::ProvidedBufferGroup, _, 8192, _))
+      .Times(4)
+      .WillRepeatedly(Invoke([&provided_buffers](uint16_t, uint8_t* buf, uint32_t,
+                                                 uint16_t buffer_id) {
+        provided_buffers[buffer_id] = buf;
+        return IoUringResult::Ok;
+      }))
+      .RetiresOnSaturation();
+  EXPECT_CALL(mock_io_uring, registerEventfd());
+  EXPECT_CALL(dispatcher,
+              createFileEvent_(_, _, Event::PlatformDefaultTriggerType, Event::FileReadyType::Read))
+      .WillOnce(
+          DoAll(SaveArg<1>(&file_event_callback), ReturnNew<NiceMock<Event::MockFileEvent>>()));
+  IoUringWorkerTestImpl worker(std::move(io_uring_instance), dispatcher, 0, nullptr, 4);
+
+  os_fd_t fd = 11;
+  SET_SOCKET_INVALID(fd);
+
+  Request* read_req = nullptr;
+  EXPECT_CALL(mock_io_uring, prepareRecvMultishot(fd, IoUringWorkerImpl::ProvidedBufferGroup, _))
+      .WillOnce(DoAll(SaveArg<2>(&read_req), Return<IoUringResult>(IoUringResult::Ok)))
+      .RetiresOnSaturation();
+  EXPECT_CALL(mock_io_uring, submit()).Times(1).RetiresOnSaturation();
+  std::string received;
+  OptRef<IoUringSocket> socket;
+  socket = worker.addServerSocket(
+      fd,
+      [&socket, &received](uint32_t) {
+        received.append(socket->getReadParam()->buf_.toString());
+        socket->getReadParam()->buf_.drain(socket->getReadParam()->buf_.length());
+        return absl::OkStatus();
+      },
+      false);
+
+  // Disabling the read cancels the multishot recv.
+  Request* cancel_req = nullptr;
+  EXPECT_CALL(mock_io_uring, prepareCancel(read_req, _))
+      .WillOnce(DoAll(SaveArg<1>(&cancel_req), Return<IoUringResult>(IoUringResult::Ok)))
+      .RetiresOnSaturation();
+  EXPECT_CALL(mock_io_uring, submit()).Times(1).RetiresOnSaturation();
+  socket->disableRead();
+
+  // Disabling the read again doesn't cancel the recv twice.
+  socket->disableRead();
+
+  // The data received before the cancel is kept for the handler. Once the recv is done, a single
+  // shot read is submitted to notice the remote close.
+  memcpy(provided_buffers[1], "hello", 5);
+  Request* single_read_req = nullptr;
+  EXPECT_CALL(mock_io_uring, forEveryCompletion(_))
+      .WillOnce(Invoke([&read_req, &cancel_req](const CompletionCb& cb) {
+        read_req->setCompletionFlags(IORING_CQE_F_BUFFER | IORING_CQE_F_MORE |
+                                     (1 << IORING_CQE_BUFFER_SHIFT));
+        cb(read_req, 5, false);
+        read_req->setCompletionFlags(0);
+        cb(read_req, -ECANCELED, false);
+        cb(cancel_req, 0, false);
+      }));
+  EXPECT_CALL(mock_io_uring,
+              addBufferToRing(IoUringWorkerImpl::ProvidedBufferGroup, provided_buffers[1], 8192, 1))
+      .WillOnce(Return<IoUringResult>(IoUringResult::Ok))
+      .RetiresOnSaturation();
+  EXPECT_CALL(mock_io_uring, prepareRecvMultishot(_, _, _)).Times(0);
+  EXPECT_CALL(mock_io_uring, prepareReadv(fd, _, _, _, _))
+      .WillOnce(DoAll(SaveArg<4>(&single_read_req), Return<IoUringResult>(IoUringResult::Ok)))
+      .RetiresOnSaturation();
+  EXPECT_CALL(mock_io_uring, submit()).Times(1).RetiresOnSaturation();
+  ASSERT_TRUE(file_event_callback(Event::FileReadyType::Read).ok());
+  EXPECT_EQ("", received);
+
+  // Enabling the read delivers the kept data.
+  Request* inject_req = nullptr;
+  EXPECT_CALL(mock_io_uring, injectCompletion(fd, _, -EAGAIN)).WillOnce(SaveArg<1>(&inject_req));
+  socket->enableRead();
+  EXPECT_CALL(mock_io_uring, forEveryCompletion(_))
+      .WillOnce(Invoke([&inject_req](const CompletionCb& cb) { cb(inject_req, -EAGAIN, true); }));
+  EXPECT_CALL(mock_io_uring, submit()).Times(1).RetiresOnSaturation();
+  ASSERT_TRUE(file_event_callback(Event::FileReadyType::Read).ok());
+  EXPECT_EQ("hello", received);
+
+  // The multishot recv is armed again once the single shot read is done.
+  Request* second_read_req = nullptr;
+  EXPECT_CALL(mock_io_uring, forEveryCompletion(_))
+      .WillOnce(Invoke([&single_read_req](const CompletionCb& cb) {
+        memcpy(static_cast<ReadRequest*>(single_read_req)->buf_.get(), "world", 5);
+        cb(single_read_req, 5, false);
+      }));
+  EXPECT_CALL(mock_io_uring, prepareRecvMultishot(fd, IoUringWorkerImpl::ProvidedBufferGroup, _))
+      .WillOnce(DoAll(SaveArg<2>(&second_read_req), Return<IoUringResult>(IoUringResult::Ok)))
+      .RetiresOnSaturation();
+  EXPECT_CALL(mock_io_uring, submit()).Times(1).RetiresOnSaturation();
+  ASSERT_TRUE(file_event_callback(Event::FileReadyType::Read).ok());
+  EXPECT_EQ("helloworld", received);
+
+  EXPECT_CALL(mock_io_uring, prepareCancel(second_read_req, _))
+      .WillOnce(DoAll(SaveArg<1>(&cancel_req), Return<IoUringResult>(IoUringResult::Ok)))
+      .RetiresOnSaturation();
+  EXPECT_CALL(mock_io_uring, submit()).Times(1).RetiresOnSaturation();
+  socket->close(false);
+
+  Request* close_req = nullptr;
+  EXPECT_CALL(mock_io_uring, forEveryCompletion(_))
+      .WillOnce(Invoke([&second_read_req, &cancel_req](const CompletionCb& cb) {
+        cb(second_read_req, -ECANCELED, false);
+        cb(cancel_req, 0, false);
+      }));
+  EXPECT_CALL(mock_io_uring, prepareClose(fd, _))
+      .WillOnce(DoAll(SaveArg<1>(&close_req), Return<IoUringResult>(IoUringResult::Ok)))
+      .RetiresOnSaturation();
+  EXPECT_CALL(mock_io_uring, submit()).Times(1).RetiresOnSaturation();
+  ASSERT_TRUE(file_event_callback(Event::FileReadyType::Read).ok());
+
+  EXPECT_CALL(mock_io_uring, forEveryCompletion(_))
+      .WillOnce(Invoke([&close_req](const CompletionCb& cb) { cb(close_req, 0, false); }));
+  EXPECT_CALL(mock_io_uring, removeInjectedCompletion(fd));
+  EXPECT_CALL(dispatcher, deferredDelete_);
+  EXPECT_CALL(dispatcher, clearDeferredDeleteList());
+  EXPECT_CALL(mock_io_uring, submit()).Times(1).RetiresOnSaturation();
+  ASSERT_TRUE(file_event_callback(Event::FileReadyType::Read).ok());
+  EXPECT_EQ(0, worker.getSockets().size());
+}
+
+TEST(IoUringWorkerImplTest, ServerSocketMultishotRecvNotSupported) {
+  Event::MockDispatcher dispatcher;
+  IoUringPtr io_uring_instance = std::make_unique<MockIoUring>();
+  MockIoUring& mock_io_uring = *dynamic_cast<MockIoUring*>(io_uring_instance.get());
+  Event::FileReadyCb file_event_callback;
+
+  EXPECT_CALL(mock_io_uring, registerBufferRing(IoUringWorkerImpl::ProvidedBufferGroup, 4))
+      .WillOnce(Return<IoUringResult>(IoUringResult::Ok));
+  EXPECT_CALL(mock_io_uring, addBufferToRing(IoUringWorkerImpl::ProvidedBufferGroup, _, 8192, _))
+      .Times(4)
+      .WillRepeatedly(Return<IoUringResult>(IoUringResult::Ok))
+      .RetiresOnSaturation();
+  EXPECT_CALL(mock_io_uring, registerEventfd());
+  EXPECT_CALL(dispatcher,
+              createFileEvent_(_, _, Event::PlatformDefaultTriggerType, Event::FileReadyType::Read))
+      .WillOnce(
+          DoAll(SaveArg<1>(&file_event_callback), ReturnNew<NiceMock<Event::MockFileEvent>>()));
+  IoUringWorkerTestImpl worker(std::move(io_uring_instance), dispatcher, 0, nullptr, 4);
+
+  os_fd_t fd = 11;
+  SET_SOCKET_INVALID(fd);
+
+  Request* read_req = nullptr;
+  EXPECT_CALL(mock_io_uring, prepareRecvMultishot(fd, IoUringWorkerImpl::ProvidedBufferGroup, _))
+      .WillOnce(DoAll(SaveArg<2>(&read_req), Return<IoUringResult>(IoUringResult::Ok)))
+      .RetiresOnSaturation();
+  EXPECT_CALL(mock_io_uring, submit()).Times(1).RetiresOnSaturation();
+  auto& io_uring_socket =
+      worker.addServerSocket(fd, [](uint32_t) { return absl::OkStatus(); }, false);
+
+  // The kernel refuses the multishot recv for the socket, which falls back to a read buffer of its
+  // own. The other sockets of the worker keep using multishot recvs.
+  Request* single_read_req = nullptr;
+  EXPECT_CALL(mock_io_uring, forEveryCompletion(_))
+      .WillOnce(Invoke([&read_req](const CompletionCb& cb) { cb(read_req, -EINVAL, false); }));
+  EXPECT_CALL(mock_io_uring, prepareReadv(fd, _, _, _, _))
+      .WillOnce(DoAll(SaveArg<4>(&single_read_req), Return<IoUringResult>(IoUringResult::Ok)))
+      .RetiresOnSaturation();
+  EXPECT_CALL(mock_io_uring, submit()).Times(1).RetiresOnSaturation();
+  ASSERT_TRUE(file_event_callback(Event::FileReadyType::Read).ok());
+  EXPECT_TRUE(worker.multishotRecvEnabled());
+
+  os_fd_t other_fd = 12;
+  SET_SOCKET_INVALID(other_fd);
+  Request* other_read_req = nullptr;
+  EXPECT_CALL(mock_io_uring,
+              prepareRecvMultishot(other_fd, IoUringWorkerImpl::ProvidedBufferGroup, _))
+      .WillOnce(DoAll(SaveArg<2>(&other_read_req), Return<IoUringResult>(IoUringResult::Ok)))
+      .RetiresOnSaturation();
+  EXPECT_CALL(mock_io_uring, submit()).Times(1).RetiresOnSaturation();
+  auto& other_io_uring_socket =
+      worker.addServerSocket(other_fd, [](uint32_t) { return absl::OkStatus(); }, false);
+
+  // Both sockets cancel their reads on close.
+  Request* cancel_req = nullptr;
+  Request* other_cancel_req = nullptr;
+  EXPECT_CALL(mock_io_uring, prepareCancel(single_read_req, _))
+      .WillOnce(DoAll(SaveArg<1>(&cancel_req), Return<IoUringResult>(IoUringResult::Ok)))
+      .RetiresOnSaturation();
+  EXPECT_CALL(mock_io_uring, submit()).Times(1).RetiresOnSaturation();
+  io_uring_socket.close(false);
+  EXPECT_CALL(mock_io_uring, prepareCancel(other_read_req, _))
+      .WillOnce(DoAll(SaveArg<1>(&other_cancel_req), Return<IoUringResult>(IoUringResult::Ok)))
+      .RetiresOnSaturation();
+  EXPECT_CALL(mock_io_uring, submit()).Times(1).RetiresOnSaturation();
+  other_io_uring_socket.close(false);
+
+  Request* close_req = nullptr;
+  Request* other_close_req = nullptr;
+  EXPECT_CALL(mock_io_uring, forEveryCompletion(_))
+      .WillOnce(Invoke([&](const CompletionCb& cb) {
+        cb(single_read_req, -ECANCELED, false);
+        cb(cancel_req, 0, false);
+        cb(other_read_req, -ECANCELED, false);
+        cb(other_cancel_req, 0, false);
+      }));
+  EXPECT_CALL(mock_io_uring, prepareClose(fd, _))
+      .WillOnce(DoAll(SaveArg<1>(&close_req), Return<IoUringResult>(IoUringResult::Ok)))
+      .RetiresOnSaturation();
+  EXPECT_CALL(mock_io_uring, prepareClose(other_fd, _))
+      .WillOnce(DoAll(SaveArg<1>(&other_close_req), Return<IoUringResult>(IoUringResult::Ok)))
+      .RetiresOnSaturation();
+  EXPECT_CALL(mock_io_uring, submit()).Times(1).RetiresOnSaturation();
+  ASSERT_TRUE(file_event_callback(Event::FileReadyType::Read).ok());
+
+  EXPECT_CALL(mock_io_uring, forEveryCompletion(_))
+      .WillOnce(Invoke([&close_req, &other_close_req](const CompletionCb& cb) {
+        cb(close_req, 0, false);
+        cb(other_close_req, 0, false);
+      }));
+  EXPECT_CALL(mock_io_uring, removeInjectedCompletion(fd));
+  EXPECT_CALL(mock_io_uring, removeInjectedCompletion(other_fd));
+  EXPECT_CALL(dispatcher, deferredDelete_).Times(2);
+  EXPECT_CALL(dispatcher, clearDeferredDeleteList());
+  EXPECT_CALL(mock_io_uring, submit()).Times(1).RetiresOnSaturation();
+  ASSERT_TRUE(file_event_callback(Event::FileReadyType::Read).ok());
+  EXPECT_EQ(0, worker.getSockets().size());
+}
+
+TEST(IoUringWorkerImplTest, DatagramSocket) {
+  Event::MockDispatcher dispatcher;
+  IoUringPtr io_uring_instance = std::make_unique<MockIoUring>();
+  MockIoUring& mock_io_uring = *dynamic_cast<MockIoUring*>(io_uring_instance.get());
+  Event::FileReadyCb file_event_callback;
+
+  EXPECT_CALL(mock_io_uring, registerEventfd());
+  EXPECT_CALL(dispatcher,
+              createFileEvent_(_, _, Event::PlatformDefaultTriggerType, Event::FileReadyType::Read))
+      .WillOnce(
+          DoAll(SaveArg<1>(&file_event_callback), ReturnNew<NiceMock<Event::MockFileEvent>>()));
+  IoUringWorkerTestImpl worker(std::move(io_uring_instance), dispatcher);
+
+  os_fd_t fd = 11;
+  SET_SOCKET_INVALID(fd);
+
+  // The datagram socket receives right away.
+  Request* read_req = nullptr;
+  struct msghdr* msg = nullptr;
+  EXPECT_CALL(mock_io_uring, prepareRecvmsg(fd, _, _))
+      .WillOnce(DoAll(SaveArg<1>(&msg), SaveArg<2>(&read_req),
+                      Return<IoUringResult>(IoUringResult::Ok)))
+      .RetiresOnSaturation();
+  EXPECT_CALL(mock_io_uring, submit()).Times(1).RetiresOnSaturation();
+  std::vector<std::string> received;
+  OptRef<IoUringSocket> socket;
+  socket = worker.addDatagramSocket(fd, [&socket, &received](uint32_t events) {
+    EXPECT_EQ(Event::FileReadyType::Read, events);
+    for (auto datagram = socket->takeDatagram(); datagram.has_value();
+         datagram = socket->takeDatagram()) {
+      received.push_back(datagram->buffer_->toString());
+    }
+    return absl::OkStatus();
+  });
+
+  // The kernel receives a datagram, it is queued and the next recvmsg is submitted.
+  auto peer_address = std::make_shared<Network::Address::Ipv4Instance>("127.0.0.1", 1234);
+  memcpy(msg->msg_name, peer_address->sockAddr(), peer_address->sockAddrLen());
+  msg->msg_namelen = peer_address->sockAddrLen();
+  msg->msg_controllen = 0;
+  memcpy(msg->msg_iov[0].iov_base, "hello", 5);
+  Request* second_read_req = nullptr;
+  EXPECT_CALL(mock_io_uring, forEveryCompletion(_))
+      .WillOnce(Invoke([&read_req](const CompletionCb& cb) { cb(read_req, 5, false); }));
+  EXPECT_CALL(mock_io_uring, prepareRecvmsg(fd, _, _))
+      .WillOnce(DoAll(SaveArg<2>(&second_read_req), Return<IoUringResult>(IoUringResult::Ok)))
+      .RetiresOnSaturation();
+  EXPECT_CALL(mock_io_uring, submit()).Times(1).RetiresOnSaturation();
+  ASSERT_TRUE(file_event_callback(Event::FileReadyType::Read).ok());
+  EXPECT_EQ(std::vector<std::string>{"hello"}, received);
+
+  // The datagram is copied by the send request.
+  Request* send_req = nullptr;
+  EXPECT_CALL(mock_io_uring, prepareSendmsg(fd, _, _))
+      .WillOnce(DoAll(Invoke([](os_fd_t, const struct msghdr* msg, Request*) {
+                        EXPECT_EQ(1, msg->msg_iovlen);
+                        EXPECT_EQ("world", std::string(static_cast<char*>(msg->msg_iov[0].iov_base),
+                                                       msg->msg_iov[0].iov_len));
+                        EXPECT_EQ(nullptr, msg->msg_control);
+                      }),
+                      SaveArg<2>(&send_req), Return<IoUringResult>(IoUringResult::Ok)))
+      .RetiresOnSaturation();
+  EXPECT_CALL(mock_io_uring, submit()).Times(1).RetiresOnSaturation();
+  std::string data = "world";
+  Buffer::RawSlice slice{data.data(), data.size()};
+  EXPECT_EQ(5, socket->sendmsg(&slice, 1, *peer_address, ""));
+
+  // The send completes in the background.
+  EXPECT_CALL(mock_io_uring, forEveryCompletion(_))
+      .WillOnce(Invoke([&send_req](const CompletionCb& cb) { cb(send_req, 5, false); }));
+  EXPECT_CALL(mock_io_uring, submit()).Times(1).RetiresOnSaturation();
+  ASSERT_TRUE(file_event_callback(Event::FileReadyType::Read).ok());
+
+  // Close the socket, the recvmsg is cancelled first.
+  Request* cancel_req = nullptr;
+  EXPECT_CALL(mock_io_uring, prepareCancel(second_read_req, _))
+      .WillOnce(DoAll(SaveArg<1>(&cancel_req), Return<IoUringResult>(IoUringResult::Ok)))
+      .RetiresOnSaturation();
+  EXPECT_CALL(mock_io_uring, submit()).Times(1).RetiresOnSaturation();
+  socket->close(false);
+
+  Request* close_req = nullptr;
+  EXPECT_CALL(mock_io_uring, forEveryCompletion(_))
+      .WillOnce(Invoke([&second_read_req, &cancel_req](const CompletionCb& cb) {
+        cb(second_read_req, -ECANCELED, false);
+        cb(cancel_req, 0, false);
+      }));
+  EXPECT_CALL(mock_io_uring, prepareClose(fd, _))
+      .WillOnce(DoAll(SaveArg<1>(&close_req), Return<IoUringResult>(IoUringResult::Ok)))
+      .RetiresOnSaturation();
+  EXPECT_CALL(mock_io_uring, submit()).Times(1).RetiresOnSaturation();
+  ASSERT_TRUE(file_event_callback(Event::FileReadyType::Read).ok());
+
+  EXPECT_CALL(mock_io_uring, forEveryCompletion(_))
+      .WillOnce(Invoke([&close_req](const CompletionCb& cb) { cb(close_req, 0, false); }));
+  EXPECT_CALL(mock_io_uring, removeInjectedCompletion(fd));
+  EXPECT_CALL(dispatcher, deferredDelete_);
+  EXPECT_CALL(dispatcher, clearDeferredDeleteList());
+  EXPECT_CALL(mock_io_uring, submit()).Times(1).RetiresOnSaturation();
+  ASSERT_TRUE(file_event_callback(Event::FileReadyType::Read).ok());
+  EXPECT_EQ(0, worker.getSockets().size());
+}
+
+TEST(IoUringWorkerImplTest, DatagramSocketMultishotRecvmsg) {
+  Event::MockDispatcher dispatcher;
+  IoUringPtr io_uring_instance = std::make_unique<MockIoUring>();
+  MockIoUring& mock_io_uring = *dynamic_cast<MockIoUring*>(io_uring_instance.get());
+  Event::FileReadyCb file_event_callback;
+
+  const uint32_t read_buffer_size = RecvmsgRequest::MinProvidedBufferSize;
+  EXPECT_CALL(mock_io_uring, registerBufferRing(IoUringWorkerImpl::ProvidedBufferGroup, 2))
+      .WillOnce(Return<IoUringResult>(IoUringResult::Ok));
+  EXPECT_CALL(mock_io_uring,
+              addBufferToRing(IoUringWorkerImpl::ProvidedBufferGroup, _, read_buffer_size, _))
+      .Times(2)
+      .WillRepeatedly(Return<IoUringResult>(IoUringResult::Ok));
+  EXPECT_CALL(mock_io_uring, registerEventfd());
+  EXPECT_CALL(dispatcher,
+              createFileEvent_(_, _, Event::PlatformDefaultTriggerType, Event::FileReadyType::Read))
+      .WillOnce(
+          DoAll(SaveArg<1>(&file_event_callback), ReturnNew<NiceMock<Event::MockFileEvent>>()));
+  IoUringWorkerTestImpl worker(std::move(io_uring_instance), dispatcher, 0, nullptr, 2,
+                               read_buffer_size);
+
+  os_fd_t fd = 11;
+  SET_SOCKET_INVALID(fd);
+
+  Request* read_req = nullptr;
+  EXPECT_CALL(mock_io_uring,
+              prepareRecvmsgMultishot(fd, _, IoUringWorkerImpl::ProvidedBufferGroup, _))
+      .WillOnce(DoAll(SaveArg<3>(&read_req), Return<IoUringResult>(IoUringResult::Ok)))
+      .RetiresOnSaturation();
+  EXPECT_CALL(mock_io_uring, submit()).Times(1).RetiresOnSaturation();
+  OptRef<IoUringSocket> socket;
+  socket = worker.addDatagramSocket(fd, [](uint32_t) { return absl::OkStatus(); });
+
+  // Disabling the read cancels the multishot recvmsg, so the datagrams stay in the kernel's
+  // receive queue until the read is enabled again.
+  Request* cancel_req = nullptr;
+  EXPECT_CALL(mock_io_uring, prepareCancel(read_req, _))
+      .WillOnce(DoAll(SaveArg<1>(&cancel_req), Return<IoUringResult>(IoUringResult::Ok)))
+      .RetiresOnSaturation();
+  EXPECT_CALL(mock_io_uring, submit()).Times(1).RetiresOnSaturation();
+  socket->disableRead();
+
+  EXPECT_CALL(mock_io_uring, forEveryCompletion(_))
+      .WillOnce(Invoke([&read_req, &cancel_req](const CompletionCb& cb) {
+        cb(read_req, -ECANCELED, false);
+        cb(cancel_req, 0, false);
+      }));
+  EXPECT_CALL(mock_io_uring, prepareRecvmsgMultishot(_, _, _, _)).Times(0);
+  EXPECT_CALL(mock_io_uring, prepareRecvmsg(_, _, _)).Times(0);
+  EXPECT_CALL(mock_io_uring, submit()).Times(1).RetiresOnSaturation();
+  ASSERT_TRUE(file_event_callback(Event::FileReadyType::Read).ok());
+
+  Request* second_read_req = nullptr;
+  EXPECT_CALL(mock_io_uring,
+              prepareRecvmsgMultishot(fd, _, IoUringWorkerImpl::ProvidedBufferGroup, _))
+      .WillOnce(DoAll(SaveArg<3>(&second_read_req), Return<IoUringResult>(IoUringResult::Ok)))
+      .RetiresOnSaturation();
+  EXPECT_CALL(mock_io_uring, submit()).Times(1).RetiresOnSaturation();
+  socket->enableRead();
+
+  // The kernel refuses the multishot recvmsg for the socket, which falls back to a buffer of its
+  // own.
+  Request* single_read_req = nullptr;
+  EXPECT_CALL(mock_io_uring, forEveryCompletion(_))
+      .WillOnce(Invoke([&second_read_req](const CompletionCb& cb) {
+        cb(second_read_req, -EINVAL, false);
+      }));
+  EXPECT_CALL(mock_io_uring, prepareRecvmsg(fd, _, _))
+      .WillOnce(DoAll(SaveArg<2>(&single_read_req), Return<IoUringResult>(IoUringResult::Ok)))
+      .RetiresOnSaturation();
+  EXPECT_CALL(mock_io_uring, submit()).Times(1).RetiresOnSaturation();
+  ASSERT_TRUE(file_event_callback(Event::FileReadyType::Read).ok());
+  EXPECT_TRUE(worker.multishotRecvEnabled());
+
+  EXPECT_CALL(mock_io_uring, prepareCancel(single_read_req, _))
+      .WillOnce(DoAll(SaveArg<1>(&cancel_req), Return<IoUringResult>(IoUringResult::Ok)))
+      .RetiresOnSaturation();
+  EXPECT_CALL(mock_io_uring, submit()).Times(1).RetiresOnSaturation();
+  socket->close(false);
+
+  Request* close_req = nullptr;
+  EXPECT_CALL(mock_io_uring, forEveryCompletion(_))
+      .WillOnce(Invoke([&single_read_req, &cancel_req](const CompletionCb& cb) {
+        cb(single_read_req, -ECANCELED, false);
+        cb(cancel_req, 0, false);
+      }));
+  EXPECT_CALL(mock_io_uring, prepareClose(fd, _))
+      .WillOnce(DoAll(SaveArg<1>(&close_req), Return<IoUringResult>(IoUringResult::Ok)))
+      .RetiresOnSaturation();
+  EXPECT_CALL(mock_io_uring, submit()).Times(1).RetiresOnSaturation();
+  ASSERT_TRUE(file_event_callback(Event::FileReadyType::Read).ok());
+
+  EXPECT_CALL(mock_io_uring, forEveryCompletion(_))
+      .WillOnce(Invoke([&close_req](const CompletionCb& cb) { cb(close_req, 0, false); }));
+  EXPECT_CALL(mock_io_uring, removeInjectedCompletion(fd));
+  EXPECT_CALL(dispatcher, deferredDelete_);
+  EXPECT_CALL(dispatcher, clearDeferredDeleteList());
+  EXPECT_CALL(mock_io_uring, submit()).Times(1).RetiresOnSaturation();
+  ASSERT_TRUE(file_event_callback(Event::FileReadyType::Read).ok());
+  EXPECT_EQ(0, worker.getSockets().size());
+}
+
 // Make sure that even the socket is disabled, that remote close can be handled.
 TEST(IoUringWorkerImplTest, CloseDetected) {
   Event::MockDispatcher dispatcher;
@@ -193,6 +193,18 @@ const char YamlSingleDstPortBottom[] = R"EOF(
           session_ticket_keys:
             keys:
             - filename: "{{ test_rundir }}/test/common/tls/test_data/ticket_key_a")EOF";
+const char YamlSingleServerNameTop[] = R"EOF(
+    - filter_chain_match:
+        server_names: ")EOF";
+const char YamlSingleServerNameBottom[] = R"EOF("
+        transport_protocol: "tls")EOF";
+
+std::string serverName(int64_t index) { return absl::StrCat("server", index, ".example.com"); }
+
+// The first address of a distinct /24 prefix per index.
+std::string prefixAddress(int64_t index, int last_octet) {
+  return absl::StrCat("10.", index / 256 % 256, ".", index % 256, ".", last_octet);
+}
 } // namespace
 
 class FilterChainBenchmarkFixture : public ::benchmark::Fixture {
@@ -211,6 +223,46 @@ public:
     filter_chains_ = listener_config_.filter_chains();
   }
 
+  // Builds a listener with a filter chain per server name, as listeners terminating TLS for many
+  // domains have.
+  void initializeServerNames(::benchmark::State& state) {
+    int64_t input_size = state.range(0);
+    std::vector<std::string> server_name_chains;
+    server_name_chains.reserve(input_size);
+    for (int64_t i = 0; i < input_size; i++) {
+      server_name_chains.push_back(
+          absl::StrCat(YamlSingleServerNameTop, serverName(i), YamlSingleServerNameBottom));
+    }
+    listener_yaml_config_ = absl::StrCat(R"EOF(
+    address:
+      socket_address: { address: 127.0.0.1, port_value: 1234 }
+    filter_chains:)EOF",
+                                         absl::StrJoin(server_name_chains, ""));
+    TestUtility::loadFromYaml(listener_yaml_config_, listener_config_);
+    filter_chains_ = listener_config_.filter_chains();
+  }
+
+  // Builds a listener with a filter chain per destination prefix, which puts all the prefixes in
+  // the destination IP trie of the listener port.
+  void initializeDestinationPrefixes(::benchmark::State& state) {
+    int64_t input_size = state.range(0);
+    std::vector<std::string> prefix_chains;
+    prefix_chains.reserve(input_size);
+    for (int64_t i = 0; i < input_size; i++) {
+      prefix_chains.push_back(absl::StrCat(R"EOF(
+    - filter_chain_match:
+        prefix_ranges: { address_prefix: ")EOF",
+                                           prefixAddress(i, 0), R"EOF(", prefix_len: 24 })EOF"));
+    }
+    listener_yaml_config_ = absl::StrCat(R"EOF(
+    address:
+      socket_address: { address: 0.0.0.0, port_value: 1234 }
+    filter_chains:)EOF",
+                                         absl::StrJoin(prefix_chains, ""));
+    TestUtility::loadFromYaml(listener_yaml_config_, listener_config_);
+    filter_chains_ = listener_config_.filter_chains();
+  }
+
   Envoy::Thread::MutexBasicLockable lock_;
   Logger::Context logging_state_{spdlog::level::warn, Logger::Logger::DEFAULT_LOG_FORMAT, lock_,
                                  false};
@@ -270,6 +322,137 @@ BENCHMARK_DEFINE_F(FilterChainBenchmarkFixture, FilterChainFindTest)
     }
   }
 }
+// NOLINTNEXTLINE(readability-redundant-member-init)
+BENCHMARK_DEFINE_F(FilterChainBenchmarkFixture, FilterChainManagerServerNamesBuildTest)
+(::benchmark::State& state) {
+  if (benchmark::skipExpensiveBenchmarks() && state.range(0) > 64) {
+    state.SkipWithError("Skipping expensive benchmark");
+    return;
+  }
+
+  initializeServerNames(state);
+  NiceMock<Server::Configuration::MockFactoryContext> factory_context;
+  std::vector<Network::Address::InstanceConstSharedPtr> addresses;
+  addresses.emplace_back(std::make_shared<Network::Address::Ipv4Instance>("127.0.0.1", 1234));
+  for (auto _ : state) {
+    UNREFERENCED_PARAMETER(_);
+    FilterChainManagerImpl filter_chain_manager{addresses, factory_context, init_manager_};
+    THROW_IF_NOT_OK(filter_chain_manager.addFilterChains(nullptr, filter_chains_, nullptr,
+                                                         dummy_builder_, filter_chain_manager));
+  }
+}
+
+// Measures a listener update changing a single filter chain, in which all the other filter chains
+// are taken over from the previous generation of the filter chain manager.
+// NOLINTNEXTLINE(readability-redundant-member-init)
+BENCHMARK_DEFINE_F(FilterChainBenchmarkFixture, FilterChainManagerServerNamesUpdateTest)
+(::benchmark::State& state) {
+  if (benchmark::skipExpensiveBenchmarks() && state.range(0) > 64) {
+    state.SkipWithError("Skipping expensive benchmark");
+    return;
+  }
+
+  initializeServerNames(state);
+  NiceMock<Server::Configuration::MockFactoryContext> factory_context;
+  std::vector<Network::Address::InstanceConstSharedPtr> addresses;
+  addresses.emplace_back(std::make_shared<Network::Address::Ipv4Instance>("127.0.0.1", 1234));
+  FilterChainManagerImpl parent_manager{addresses, factory_context, init_manager_};
+  THROW_IF_NOT_OK(parent_manager.addFilterChains(nullptr, filter_chains_, nullptr, dummy_builder_,
+                                                 parent_manager));
+
+  envoy::config::listener::v3::Listener updated_config = listener_config_;
+  *updated_config.mutable_filter_chains(0)->mutable_filter_chain_match()->mutable_server_names(0) =
+      "updated.example.com";
+  const auto& updated_filter_chains = updated_config.filter_chains();
+  for (auto _ : state) {
+    UNREFERENCED_PARAMETER(_);
+    FilterChainManagerImpl filter_chain_manager{addresses, factory_context, init_manager_,
+                                                parent_manager};
+    THROW_IF_NOT_OK(filter_chain_manager.addFilterChains(
+        nullptr, updated_filter_chains, nullptr, dummy_builder_, filter_chain_manager));
+  }
+}
+
+BENCHMARK_DEFINE_F(FilterChainBenchmarkFixture, FilterChainServerNamesFindTest)
+(::benchmark::State& state) {
+  if (benchmark::skipExpensiveBenchmarks() && state.range(0) > 64) {
+    state.SkipWithError("Skipping expensive benchmark");
+    return;
+  }
+
+  initializeServerNames(state);
+  std::vector<MockConnectionSocket> sockets;
+  sockets.reserve(state.range(0));
+  for (int64_t i = 0; i < state.range(0); i++) {
+    sockets.push_back(std::move(*MockConnectionSocket::createMockConnectionSocket(
+        1234, "127.0.0.1", serverName(i), "", "tls", {}, "8.8.8.8", 111)));
+  }
+  NiceMock<Server::Configuration::MockFactoryContext> factory_context;
+  std::vector<Network::Address::InstanceConstSharedPtr> addresses;
+  addresses.emplace_back(std::make_shared<Network::Address::Ipv4Instance>("127.0.0.1", 1234));
+  FilterChainManagerImpl filter_chain_manager{addresses, factory_context, init_manager_};
+
+  THROW_IF_NOT_OK(filter_chain_manager.addFilterChains(nullptr, filter_chains_, nullptr,
+                                                       dummy_builder_, filter_chain_manager));
+  NiceMock<StreamInfo::MockStreamInfo> stream_info;
+  for (auto _ : state) {
+    UNREFERENCED_PARAMETER(_);
+    for (int64_t i = 0; i < state.range(0); i++) {
+      filter_chain_manager.findFilterChain(sockets[i], stream_info);
+    }
+  }
+}
+
+// NOLINTNEXTLINE(readability-redundant-member-init)
+BENCHMARK_DEFINE_F(FilterChainBenchmarkFixture, FilterChainManagerDestinationPrefixesBuildTest)
+(::benchmark::State& state) {
+  if (benchmark::skipExpensiveBenchmarks() && state.range(0) > 64) {
+    state.SkipWithError("Skipping expensive benchmark");
+    return;
+  }
+
+  initializeDestinationPrefixes(state);
+  NiceMock<Server::Configuration::MockFactoryContext> factory_context;
+  std::vector<Network::Address::InstanceConstSharedPtr> addresses;
+  addresses.emplace_back(std::make_shared<Network::Address::Ipv4Instance>("0.0.0.0", 1234));
+  for (auto _ : state) {
+    UNREFERENCED_PARAMETER(_);
+    FilterChainManagerImpl filter_chain_manager{addresses, factory_context, init_manager_};
+    THROW_IF_NOT_OK(filter_chain_manager.addFilterChains(nullptr, filter_chains_, nullptr,
+                                                         dummy_builder_, filter_chain_manager));
+  }
+}
+
+BENCHMARK_DEFINE_F(FilterChainBenchmarkFixture, FilterChainDestinationPrefixesFindTest)
+(::benchmark::State& state) {
+  if (benchmark::skipExpensiveBenchmarks() && state.range(0) > 64) {
+    state.SkipWithError("Skipping expensive benchmark");
+    return;
+  }
+
+  initializeDestinationPrefixes(state);
+  std::vector<MockConnectionSocket> sockets;
+  sockets.reserve(state.range(0));
+  for (int64_t i = 0; i < state.range(0); i++) {
+    sockets.push_back(std::move(*MockConnectionSocket::createMockConnectionSocket(
+        1234, prefixAddress(i, 1), "", "", "raw_buffer", {}, "8.8.8.8", 111)));
+  }
+  NiceMock<Server::Configuration::MockFactoryContext> factory_context;
+  std::vector<Network::Address::InstanceConstSharedPtr> addresses;
+  addresses.emplace_back(std::make_shared<Network::Address::Ipv4Instance>("0.0.0.0", 1234));
+  FilterChainManagerImpl filter_chain_manager{addresses, factory_context, init_manager_};
+
+  THROW_IF_NOT_OK(filter_chain_manager.addFilterChains(nullptr, filter_chains_, nullptr,
+                                                       dummy_builder_, filter_chain_manager));
+  NiceMock<StreamInfo::MockStreamInfo> stream_info;
+  for (auto _ : state) {
+    UNREFERENCED_PARAMETER(_);
+    for (int64_t i = 0; i < state.range(0); i++) {
+      filter_chain_manager.findFilterChain(sockets[i], stream_info);
+    }
+  }
+}
+
 BENCHMARK_REGISTER_F(FilterChainBenchmarkFixture, FilterChainManagerBuildTest)
     ->Ranges({
         // scale of the chains
@@ -282,6 +465,36 @@ BENCHMARK_REGISTER_F(FilterChainBenchmarkFixture, FilterChainFindTest)
         {1, 4096},
     })
     ->Unit(::benchmark::kMillisecond);
+BENCHMARK_REGISTER_F(FilterChainBenchmarkFixture, FilterChainManagerServerNamesBuildTest)
+    ->Ranges({
+        // scale of the chains
+        {1, 16384},
+    })
+    ->Unit(::benchmark::kMillisecond);
+BENCHMARK_REGISTER_F(FilterChainBenchmarkFixture, FilterChainManagerServerNamesUpdateTest)
+    ->Ranges({
+        // scale of the chains
+        {1, 16384},
+    })
+    ->Unit(::benchmark::kMillisecond);
+BENCHMARK_REGISTER_F(FilterChainBenchmarkFixture, FilterChainServerNamesFindTest)
+    ->Ranges({
+        // scale of the chains
+        {1, 16384},
+    })
+    ->Unit(::benchmark::kMillisecond);
+BENCHMARK_REGISTER_F(FilterChainBenchmarkFixture, FilterChainManagerDestinationPrefixesBuildTest)
+    ->Ranges({
+        // scale of the chains
+        {1, 16384},
+    })
+    ->Unit(::benchmark::kMillisecond);
+BENCHMARK_REGISTER_F(FilterChainBenchmarkFixture, FilterChainDestinationPrefixesFindTest)
+    ->Ranges({
+        // scale of the chains
+        {1, 16384},
+    })
+    ->Unit(::benchmark::kMillisecond);
 
 /*
 clang-format off
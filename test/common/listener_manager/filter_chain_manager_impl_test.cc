@@ -16,6 +16,7 @@
 #include "source/common/network/address_impl.h"
 #include "source/common/network/io_socket_handle_impl.h"
 #include "source/common/network/listen_socket_impl.h"
+#include "source/common/network/socket_interface.h"
 #include "source/common/network/socket_option_impl.h"
 #include "source/common/network/utility.h"
 #include "source/common/protobuf/protobuf.h"
@@ -197,6 +198,29 @@ TEST_P(FilterChainManagerImplTest, AddSingleFilterChain) {
   }
 }
 
+// The filter chain has no IP requirements, so its catch-all IP entries match any address without
+// a trie.
+TEST_P(FilterChainManagerImplTest, FilterChainWithoutIpsMatchesAnyAddress) {
+  envoy::config::listener::v3::FilterChain new_filter_chain = filter_chain_template_;
+  new_filter_chain.mutable_filter_chain_match()->add_server_names("*.example.com");
+  addSingleFilterChainHelper(new_filter_chain);
+
+  EXPECT_NE(findFilterChainHelper(10000, "127.0.0.1", "foo.example.com", "tls", {}, "8.8.8.8", 111),
+            nullptr);
+  EXPECT_NE(findFilterChainHelper(10000, "127.0.0.1", "foo.example.com", "tls", {},
+                                  "/tmp/test.sock", 0),
+            nullptr);
+  if (Network::SocketInterfaceSingleton::get().ipFamilySupported(AF_INET6)) {
+    EXPECT_NE(findFilterChainHelper(10000, "::1", "foo.example.com", "tls", {}, "2001:db8::1", 111),
+              nullptr);
+  }
+  if (!GetParam()) {
+    EXPECT_EQ(
+        findFilterChainHelper(10000, "127.0.0.1", "foo.example.org", "tls", {}, "8.8.8.8", 111),
+        nullptr);
+  }
+}
+
 TEST_P(FilterChainManagerImplTest, FilterChainUseFallbackIfNoFilterChainMatches) {
   // The build helper will build matchable filter chain and then build the default filter chain.
   EXPECT_CALL(filter_chain_factory_builder_, buildFilterChain(_, _, _))
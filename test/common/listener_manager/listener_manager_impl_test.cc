@@ -1162,6 +1162,7 @@ TEST_P(ListenerManagerImplTest, RejectTcpOptionsWithInternalListenerConfig) {
       [](envoy::config::listener::v3::Listener& l) { l.mutable_tcp_backlog_size(); },
       [](envoy::config::listener::v3::Listener& l) { l.mutable_tcp_fast_open_queue_length(); },
       [](envoy::config::listener::v3::Listener& l) { l.mutable_transparent()->set_value(true); },
+      [](envoy::config::listener::v3::Listener& l) { l.set_reuse_port_cpu_steering(true); },
 
   };
   for (const auto& f : listener_mutators) {
@@ -6318,6 +6319,59 @@ TEST_P(ListenerManagerImplWithRealFiltersTest, FreebindListenerEnabled) {
                    ENVOY_SOCKET_IP_FREEBIND, /* expected_value */ 1);
 }
 
+// Validate that when hybrid polling configures socket busy polling in the bootstrap, we see the
+// socket option propagated to setsockopt() on the listen sockets.
+TEST_P(ListenerManagerImplWithRealFiltersTest, BusyPollListenerEnabled) {
+  auto listener = createIPv4Listener("BusyPollListener");
+  listener.mutable_enable_reuse_port()->set_value(false);
+  server_.server_factory_context_->bootstrap_.mutable_dispatcher_options()
+      ->mutable_worker_hybrid_polling()
+      ->mutable_socket_busy_poll_us()
+      ->set_value(50);
+
+  testSocketOption(listener, envoy::config::core::v3::SocketOption::STATE_PREBIND,
+                   ENVOY_SOCKET_SO_BUSY_POLL, /* expected_value */ 50);
+}
+
+// Validate that reuse_port_cpu_steering attaches the reuse port BPF program once the sockets are
+// listening, but only when there is more than one worker to steer to.
+TEST_P(ListenerManagerImplWithRealFiltersTest, ReusePortCpuSteeringListenerEnabled) {
+  auto listener = createIPv4Listener("CpuSteeringListener");
+  listener.mutable_enable_reuse_port()->set_value(true);
+  listener.set_reuse_port_cpu_steering(true);
+
+  const auto count_steering_options = [&listener](ListenerManagerImpl& manager) {
+    auto listener_impl = *ListenerImpl::create(listener, "version", manager, "foo", true, false,
+                                               /*hash=*/static_cast<uint64_t>(0));
+    const Network::Socket::OptionsSharedPtr& options = listener_impl->listenSocketOptions(0);
+    if (options == nullptr) {
+      return 0;
+    }
+    NiceMock<Network::MockListenSocket> socket;
+    int count = 0;
+    for (const auto& option : *options) {
+      auto details =
+          option->getOptionDetails(socket, envoy::config::core::v3::SocketOption::STATE_LISTENING);
+      if (details.has_value() &&
+          details->name_.level() == ENVOY_ATTACH_REUSEPORT_CBPF.level() &&
+          details->name_.option() == ENVOY_ATTACH_REUSEPORT_CBPF.option()) {
+        ++count;
+      }
+    }
+    return count;
+  };
+
+  server_.options_.concurrency_ = 1;
+  EXPECT_EQ(0, count_steering_options(*manager_));
+
+  server_.options_.concurrency_ = 2;
+#if defined(__linux__)
+  EXPECT_EQ(ENVOY_ATTACH_REUSEPORT_CBPF.hasValue() ? 1 : 0, count_steering_options(*manager_));
+#else
+  EXPECT_EQ(0, count_steering_options(*manager_));
+#endif
+}
+
 // Validate that when tcp_fast_open_queue_length is set in the Listener, we see the socket option
 // propagated to setsockopt(). This is as close to an end-to-end test as we have
 // for this feature, due to the complexity of creating an integration test
@@ -0,0 +1,140 @@
+#include <array>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "source/common/network/connection_balancer_impl.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Network {
+namespace {
+
+class TestBalancedConnectionHandler : public BalancedConnectionHandler {
+public:
+  // BalancedConnectionHandler
+  uint64_t numConnections() const override { return num_connections_; }
+  void incNumConnections() override { ++num_connections_; }
+  Event::DispatcherLoad* dispatcherLoad() override { return &load_; }
+  void post(ConnectionSocketPtr&&) override {}
+  void onAcceptWorker(ConnectionSocketPtr&&, bool, bool) override {}
+
+  std::atomic<uint64_t> num_connections_{};
+  Event::DispatcherLoad load_;
+};
+
+class LoadAwareConnectionBalancerImplTest : public testing::Test {
+protected:
+  void initialize(uint64_t connection_weight, uint64_t stream_weight, uint64_t busy_weight,
+                  uint32_t busy_threshold_permille) {
+    balancer_ = std::make_unique<LoadAwareConnectionBalancerImpl>(
+        connection_weight, stream_weight, busy_weight, busy_threshold_permille);
+    for (auto& handler : handlers_) {
+      balancer_->registerHandler(handler);
+    }
+  }
+
+  std::unique_ptr<LoadAwareConnectionBalancerImpl> balancer_;
+  std::array<TestBalancedConnectionHandler, 3> handlers_;
+};
+
+TEST_F(LoadAwareConnectionBalancerImplTest, BalancesConnections) {
+  initialize(1, 0, 0, 1000);
+  for (uint32_t i = 0; i < 6; ++i) {
+    balancer_->pickTargetHandler(handlers_[0]);
+  }
+  for (auto& handler : handlers_) {
+    EXPECT_EQ(2, handler.numConnections());
+  }
+}
+
+TEST_F(LoadAwareConnectionBalancerImplTest, PrefersCurrentHandlerOnTie) {
+  initialize(1, 1, 1, 900);
+  EXPECT_EQ(&handlers_[1], &balancer_->pickTargetHandler(handlers_[1]));
+  EXPECT_EQ(1, handlers_[1].numConnections());
+}
+
+TEST_F(LoadAwareConnectionBalancerImplTest, AccountsForStreamsAndBusyTime) {
+  initialize(1, 1, 1, 1000);
+  handlers_[0].load_.incActiveStreams();
+  handlers_[0].load_.incActiveStreams();
+  handlers_[1].load_.setBusyPermille(1);
+  // Scores: 2 streams, 1 permille busy, and 0.
+  EXPECT_EQ(&handlers_[2], &balancer_->pickTargetHandler(handlers_[0]));
+  // Scores: 2, 1, and 1 connection. The tie is broken in favor of the current handler.
+  EXPECT_EQ(&handlers_[2], &balancer_->pickTargetHandler(handlers_[2]));
+  EXPECT_EQ(&handlers_[1], &balancer_->pickTargetHandler(handlers_[0]));
+}
+
+TEST_F(LoadAwareConnectionBalancerImplTest, AvoidsHotWorkers) {
+  initialize(1, 0, 0, 900);
+  handlers_[1].num_connections_ = 10;
+  handlers_[2].num_connections_ = 20;
+  handlers_[0].load_.setBusyPermille(950);
+  // The hot worker has the fewest connections but is skipped.
+  EXPECT_EQ(&handlers_[1], &balancer_->pickTargetHandler(handlers_[0]));
+
+  // If all workers are hot, the least loaded one is picked.
+  handlers_[1].load_.setBusyPermille(900);
+  handlers_[2].load_.setBusyPermille(1000);
+  EXPECT_EQ(&handlers_[0], &balancer_->pickTargetHandler(handlers_[2]));
+}
+
+TEST_F(LoadAwareConnectionBalancerImplTest, EnablesBusyTracking) {
+  initialize(1, 1, 0, 1000);
+  EXPECT_FALSE(handlers_[0].load_.busyTrackingEnabled());
+
+  TestBalancedConnectionHandler handler;
+  LoadAwareConnectionBalancerImpl balancer(1, 1, 1, 1000);
+  balancer.registerHandler(handler);
+  EXPECT_TRUE(handler.load_.busyTrackingEnabled());
+  balancer.unregisterHandler(handler);
+}
+
+TEST_F(LoadAwareConnectionBalancerImplTest, EnablesStreamTracking) {
+  initialize(1, 0, 1, 1000);
+  EXPECT_FALSE(handlers_[0].load_.streamTrackingEnabled());
+
+  TestBalancedConnectionHandler handler;
+  LoadAwareConnectionBalancerImpl balancer(1, 1, 0, 1000);
+  balancer.registerHandler(handler);
+  EXPECT_TRUE(handler.load_.streamTrackingEnabled());
+  balancer.unregisterHandler(handler);
+}
+
+TEST_F(LoadAwareConnectionBalancerImplTest, UnregisteredHandlerIsNotPicked) {
+  initialize(1, 0, 0, 1000);
+  handlers_[0].num_connections_ = 10;
+  handlers_[2].num_connections_ = 10;
+  balancer_->unregisterHandler(handlers_[1]);
+  EXPECT_EQ(&handlers_[0], &balancer_->pickTargetHandler(handlers_[0]));
+}
+
+// Handlers can be registered and unregistered while connections are balanced on other threads.
+TEST_F(LoadAwareConnectionBalancerImplTest, ConcurrentRegistration) {
+  initialize(1, 1, 1, 900);
+  std::atomic<bool> done{};
+  std::vector<std::thread> pickers;
+  for (auto& handler : handlers_) {
+    pickers.emplace_back([this, &handler, &done]() {
+      while (!done) {
+        balancer_->pickTargetHandler(handler);
+      }
+    });
+  }
+  for (uint32_t i = 0; i < 100; ++i) {
+    auto handler = std::make_unique<TestBalancedConnectionHandler>();
+    balancer_->registerHandler(*handler);
+    balancer_->unregisterHandler(*handler);
+  }
+  done = true;
+  for (auto& picker : pickers) {
+    picker.join();
+  }
+}
+
+} // namespace
+} // namespace Network
+} // namespace Envoy
@@ -0,0 +1,70 @@
+// Note: this should be run with --compilation_mode=opt, and would benefit from a
+// quiescent system with disabled cstate power management.
+
+#include <array>
+#include <atomic>
+
+#include "source/common/network/connection_balancer_impl.h"
+
+#include "benchmark/benchmark.h"
+
+namespace Envoy {
+namespace Network {
+namespace {
+
+constexpr uint32_t MaxThreads = 16;
+
+// Stands in for the listener of a worker. Connections are closed as soon as they are accepted, so
+// that the counts stay bounded.
+class BenchmarkConnectionHandler : public BalancedConnectionHandler {
+public:
+  // BalancedConnectionHandler
+  uint64_t numConnections() const override { return num_connections_; }
+  void incNumConnections() override { ++num_connections_; }
+  Event::DispatcherLoad* dispatcherLoad() override { return &load_; }
+  void post(ConnectionSocketPtr&&) override {}
+  void onAcceptWorker(ConnectionSocketPtr&&, bool, bool) override {}
+
+  void closeConnection() { --num_connections_; }
+
+  std::atomic<uint64_t> num_connections_{};
+  Event::DispatcherLoad load_;
+};
+
+template <class Balancer> struct BalancerFixture {
+  template <class... Args> BalancerFixture(Args&&... args) : balancer_(args...) {
+    for (auto& handler : handlers_) {
+      balancer_.registerHandler(handler);
+    }
+  }
+
+  Balancer balancer_;
+  std::array<BenchmarkConnectionHandler, MaxThreads> handlers_;
+};
+
+template <class Fixture> void pickTargetHandler(benchmark::State& state, Fixture& fixture) {
+  BenchmarkConnectionHandler& current = fixture.handlers_[state.thread_index()];
+  for (auto _ : state) { // NOLINT
+    auto& target = static_cast<BenchmarkConnectionHandler&>(
+        fixture.balancer_.pickTargetHandler(current));
+    target.closeConnection();
+  }
+}
+
+// Accept throughput of the exact balancer, which takes a global lock per accepted connection.
+static void bmExactBalancer(benchmark::State& state) {
+  static BalancerFixture<ExactConnectionBalancerImpl> fixture;
+  pickTargetHandler(state, fixture);
+}
+BENCHMARK(bmExactBalancer)->ThreadRange(1, MaxThreads)->UseRealTime();
+
+// Accept throughput of the load aware balancer, which does not take a lock.
+static void bmLoadAwareBalancer(benchmark::State& state) {
+  static BalancerFixture<LoadAwareConnectionBalancerImpl> fixture(1, 1, 1, 900);
+  pickTargetHandler(state, fixture);
+}
+BENCHMARK(bmLoadAwareBalancer)->ThreadRange(1, MaxThreads)->UseRealTime();
+
+} // namespace
+} // namespace Network
+} // namespace Envoy
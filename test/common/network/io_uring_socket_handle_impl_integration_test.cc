@@ -45,7 +45,8 @@ public:
     }
 
     io_uring_worker_factory_ =
-        std::make_unique<Io::IoUringWorkerFactoryImpl>(10, false, 8192, 1000, instance_);
+        std::make_unique<Io::IoUringWorkerFactoryImpl>(10, false, 8192, 1000, 0, 0,
+                                                       api_->rootScope(), instance_);
     io_uring_worker_factory_->onWorkerThreadInitialized();
 
     // Create the thread after the io_uring worker has been initialized, otherwise the dispatcher
@@ -61,7 +62,7 @@ public:
     fd_ = Api::OsSysCallsSingleton::get().socket(AF_INET, SOCK_STREAM, IPPROTO_TCP).return_value_;
     EXPECT_GE(fd_, 0);
     io_uring_socket_handle_ = std::make_unique<IoUringSocketHandleImpl>(
-        *io_uring_worker_factory_, fd_, false, absl::nullopt, false);
+        *io_uring_worker_factory_, fd_, false, absl::nullopt, IoUringSocketType::Unknown);
 
     // Listen within the io_uring handle.
     auto local_addr = std::make_shared<Network::Address::Ipv4Instance>("127.0.0.1", 0);
@@ -81,7 +82,7 @@ public:
     fd_ = Api::OsSysCallsSingleton::get().socket(AF_INET, SOCK_STREAM, IPPROTO_TCP).return_value_;
     EXPECT_GE(fd_, 0);
     io_uring_socket_handle_ = std::make_unique<IoUringSocketHandleImpl>(
-        *io_uring_worker_factory_, fd_, false, absl::nullopt, true);
+        *io_uring_worker_factory_, fd_, false, absl::nullopt, IoUringSocketType::Server);
   }
 
   void createClientConnection() {
@@ -110,7 +111,7 @@ public:
     fd_ = Api::OsSysCallsSingleton::get().socket(AF_INET, SOCK_STREAM, IPPROTO_TCP).return_value_;
     EXPECT_GE(fd_, 0);
     io_uring_socket_handle_ = std::make_unique<IoUringSocketHandleImpl>(
-        *io_uring_worker_factory_, fd_, false, absl::nullopt, false);
+        *io_uring_worker_factory_, fd_, false, absl::nullopt, IoUringSocketType::Unknown);
 
     int error = -1;
     socklen_t error_size = sizeof(error);
@@ -260,7 +261,7 @@ TEST_F(IoUringSocketHandleImplIntegrationTest, ConnectError) {
   fd_ = Api::OsSysCallsSingleton::get().socket(AF_INET, SOCK_STREAM, IPPROTO_TCP).return_value_;
   EXPECT_GE(fd_, 0);
   io_uring_socket_handle_ = std::make_unique<IoUringSocketHandleImpl>(
-      *io_uring_worker_factory_, fd_, false, absl::nullopt, false);
+      *io_uring_worker_factory_, fd_, false, absl::nullopt, IoUringSocketType::Unknown);
 
   int original_error = -1;
   socklen_t original_error_size = sizeof(original_error);
@@ -636,7 +637,7 @@ TEST_F(IoUringSocketHandleImplIntegrationTest, Bind) {
   fd_ = Api::OsSysCallsSingleton::get().socket(AF_INET, SOCK_STREAM, IPPROTO_TCP).return_value_;
   EXPECT_GE(fd_, 0);
   io_uring_socket_handle_ = std::make_unique<IoUringSocketHandleImpl>(
-      *io_uring_worker_factory_, fd_, false, absl::nullopt, false);
+      *io_uring_worker_factory_, fd_, false, absl::nullopt, IoUringSocketType::Unknown);
   auto local_addr = std::make_shared<Network::Address::Ipv4Instance>("127.0.0.1", 0);
   io_uring_socket_handle_->bind(local_addr);
 
@@ -990,6 +991,77 @@ TEST_F(IoUringSocketHandleImplIntegrationTest, MigrateServerSocketBetweenThreads
   second_thread_->join();
 }
 
+TEST_F(IoUringSocketHandleImplIntegrationTest, Datagram) {
+  initialize();
+
+  // Create an io_uring handle with datagram socket.
+  fd_ = Api::OsSysCallsSingleton::get().socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP).return_value_;
+  EXPECT_GE(fd_, 0);
+  io_uring_socket_handle_ = std::make_unique<IoUringSocketHandleImpl>(
+      *io_uring_worker_factory_, fd_, false, absl::nullopt, IoUringSocketType::Datagram);
+  auto local_addr = std::make_shared<Network::Address::Ipv4Instance>("127.0.0.1", 0);
+  io_uring_socket_handle_->bind(local_addr);
+  Address::InstanceConstSharedPtr io_uring_addr = *io_uring_socket_handle_->localAddress();
+
+  // Create the peer socket handle.
+  os_fd_t fd = Api::OsSysCallsSingleton::get()
+                   .socket(AF_INET, SOCK_DGRAM | SOCK_NONBLOCK, IPPROTO_UDP)
+                   .return_value_;
+  EXPECT_GE(fd, 0);
+  io_socket_handle_ = std::make_unique<IoSocketHandleImpl>(fd);
+  io_socket_handle_->bind(local_addr);
+  Address::InstanceConstSharedPtr peer_addr = *io_socket_handle_->localAddress();
+
+  std::string received;
+  Address::InstanceConstSharedPtr received_from;
+  io_uring_socket_handle_->initializeFileEvent(
+      *dispatcher_,
+      [this, &received, &received_from](uint32_t events) {
+        if (!(events & Event::FileReadyType::Read)) {
+          return absl::OkStatus();
+        }
+        char buf[64];
+        Buffer::RawSlice slice{buf, sizeof(buf)};
+        IoHandle::RecvMsgOutput output(1, nullptr);
+        auto ret = io_uring_socket_handle_->recvmsg(&slice, 1, 0, {}, output);
+        EXPECT_TRUE(ret.ok());
+        received.assign(buf, ret.return_value_);
+        received_from = output.msg_[0].peer_address_;
+        return absl::OkStatus();
+      },
+      Event::PlatformDefaultTriggerType, Event::FileReadyType::Read | Event::FileReadyType::Write);
+
+  // Send from the peer handle.
+  std::string data = "Hello world";
+  Buffer::RawSlice slice{data.data(), data.size()};
+  auto ret = io_socket_handle_->sendmsg(&slice, 1, 0, nullptr, *io_uring_addr);
+  EXPECT_EQ(ret.return_value_, data.size());
+  while (received.empty()) {
+    dispatcher_->run(Event::Dispatcher::RunType::NonBlock);
+  }
+  EXPECT_EQ(received, data);
+  EXPECT_EQ(received_from->asString(), peer_addr->asString());
+
+  // Send back from the io_uring handle.
+  ret = io_uring_socket_handle_->sendmsg(&slice, 1, 0, nullptr, *peer_addr);
+  EXPECT_EQ(ret.return_value_, data.size());
+  char buf[64];
+  Buffer::RawSlice read_slice{buf, sizeof(buf)};
+  IoHandle::RecvMsgOutput output(1, nullptr);
+  do {
+    dispatcher_->run(Event::Dispatcher::RunType::NonBlock);
+    ret = io_socket_handle_->recvmsg(&read_slice, 1, 0, {}, output);
+  } while (ret.wouldBlock());
+  EXPECT_EQ(std::string(buf, ret.return_value_), data);
+
+  // Close safely.
+  io_socket_handle_->close();
+  io_uring_socket_handle_->close();
+  while (fcntl(fd_, F_GETFD, 0) >= 0) {
+    dispatcher_->run(Event::Dispatcher::RunType::NonBlock);
+  }
+}
+
 } // namespace
 } // namespace Network
 } // namespace Envoy
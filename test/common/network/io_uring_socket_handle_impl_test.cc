@@ -13,7 +13,11 @@ namespace {
 class IoUringSocketHandleTestImpl : public IoUringSocketHandleImpl {
 public:
   IoUringSocketHandleTestImpl(Io::IoUringWorkerFactory& factory, bool is_server_socket)
-      : IoUringSocketHandleImpl(factory, INVALID_SOCKET, false, absl::nullopt, is_server_socket) {}
+      : IoUringSocketHandleImpl(factory, INVALID_SOCKET, false, absl::nullopt,
+                                is_server_socket ? IoUringSocketType::Server
+                                                 : IoUringSocketType::Unknown) {}
+  IoUringSocketHandleTestImpl(Io::IoUringWorkerFactory& factory, IoUringSocketType type)
+      : IoUringSocketHandleImpl(factory, INVALID_SOCKET, false, absl::nullopt, type) {}
   IoUringSocketType ioUringSocketType() const { return io_uring_socket_type_; }
 };
 
@@ -132,6 +136,105 @@ TEST_F(IoUringSocketHandleTest, RecvmmsgNotSupported) {
               Api::IoError::IoErrorCode::NoSupport);
 }
 
+TEST_F(IoUringSocketHandleTest, DatagramRecvmsg) {
+  IoUringSocketHandleTestImpl impl(factory_, IoUringSocketType::Datagram);
+  EXPECT_CALL(worker_, addDatagramSocket(_, _)).WillOnce(testing::ReturnRef(socket_));
+  EXPECT_CALL(factory_, getIoUringWorker())
+      .WillOnce(testing::Return(OptRef<Io::IoUringWorker>(worker_)));
+  impl.initializeFileEvent(
+      dispatcher_, [](uint32_t) { return absl::OkStatus(); }, Event::PlatformDefaultTriggerType,
+      Event::FileReadyType::Read);
+
+  // A datagram from 127.0.0.1:1234 with the local address, a GRO segment size and 2 datagrams
+  // dropped by the queue of the io_uring socket.
+  Io::ReceivedDatagram datagram;
+  datagram.buffer_ = std::make_unique<Buffer::OwnedImpl>("hello");
+  auto peer_addr = std::make_shared<Address::Ipv4Instance>("127.0.0.1", 1234);
+  memcpy(&datagram.peer_address_, peer_addr->sockAddr(), peer_addr->sockAddrLen());
+  datagram.peer_address_len_ = peer_addr->sockAddrLen();
+  datagram.control_.resize(CMSG_SPACE(sizeof(in_pktinfo)) + CMSG_SPACE(sizeof(uint16_t)));
+  msghdr hdr{};
+  hdr.msg_control = datagram.control_.data();
+  hdr.msg_controllen = datagram.control_.size();
+  cmsghdr* cmsg = CMSG_FIRSTHDR(&hdr);
+  cmsg->cmsg_level = IPPROTO_IP;
+  cmsg->cmsg_type = IP_PKTINFO;
+  cmsg->cmsg_len = CMSG_LEN(sizeof(in_pktinfo));
+  reinterpret_cast<in_pktinfo*>(CMSG_DATA(cmsg))->ipi_addr.s_addr = htonl(INADDR_LOOPBACK);
+  cmsg = CMSG_NXTHDR(&hdr, cmsg);
+  cmsg->cmsg_level = SOL_UDP;
+  cmsg->cmsg_type = UDP_GRO;
+  cmsg->cmsg_len = CMSG_LEN(sizeof(uint16_t));
+  *reinterpret_cast<uint16_t*>(CMSG_DATA(cmsg)) = 1200;
+  datagram.dropped_ = 2;
+  EXPECT_CALL(socket_, takeDatagram())
+      .WillOnce(testing::Return(testing::ByMove(std::move(datagram))));
+
+  char buf[16];
+  Buffer::RawSlice slice{buf, sizeof(buf)};
+  uint32_t dropped = 0;
+  IoHandle::RecvMsgOutput output(1, &dropped);
+  auto ret = impl.recvmsg(&slice, 1, 5678, {}, output);
+  EXPECT_TRUE(ret.ok());
+  EXPECT_EQ(std::string(buf, ret.return_value_), "hello");
+  EXPECT_EQ(output.msg_[0].peer_address_->asString(), "127.0.0.1:1234");
+  EXPECT_EQ(output.msg_[0].local_address_->asString(), "127.0.0.1:5678");
+  EXPECT_EQ(output.msg_[0].gso_size_, 1200);
+  EXPECT_EQ(dropped, 2);
+
+  // No more datagrams.
+  EXPECT_CALL(socket_, takeDatagram()).WillOnce(testing::Return(absl::nullopt));
+  ret = impl.recvmsg(&slice, 1, 5678, {}, output);
+  EXPECT_TRUE(ret.wouldBlock());
+
+  // A datagram larger than the slices is dropped.
+  Io::ReceivedDatagram large_datagram;
+  large_datagram.buffer_ = std::make_unique<Buffer::OwnedImpl>(std::string(32, 'a'));
+  large_datagram.peer_address_len_ = 0;
+  EXPECT_CALL(socket_, takeDatagram())
+      .WillOnce(testing::Return(testing::ByMove(std::move(large_datagram))));
+  IoHandle::RecvMsgOutput large_output(1, &dropped);
+  ret = impl.recvmsg(&slice, 1, 5678, {}, large_output);
+  EXPECT_TRUE(ret.ok());
+  EXPECT_EQ(ret.return_value_, 0);
+  EXPECT_TRUE(large_output.msg_[0].truncated_and_dropped_);
+  EXPECT_EQ(dropped, 3);
+}
+
+TEST_F(IoUringSocketHandleTest, DatagramSendmsg) {
+  IoUringSocketHandleTestImpl impl(factory_, IoUringSocketType::Datagram);
+  EXPECT_CALL(worker_, addDatagramSocket(_, _)).WillOnce(testing::ReturnRef(socket_));
+  EXPECT_CALL(factory_, getIoUringWorker())
+      .WillOnce(testing::Return(OptRef<Io::IoUringWorker>(worker_)));
+  impl.initializeFileEvent(
+      dispatcher_, [](uint32_t) { return absl::OkStatus(); }, Event::PlatformDefaultTriggerType,
+      Event::FileReadyType::Read);
+
+  std::string data = "hello";
+  Buffer::RawSlice slice{data.data(), data.size()};
+  auto peer_addr = std::make_shared<Address::Ipv4Instance>("127.0.0.1", 1234);
+  auto self_addr = std::make_shared<Address::Ipv4Instance>("127.0.0.2", 0);
+  // The source address is passed as a control message.
+  EXPECT_CALL(socket_, sendmsg(_, 1, _, _))
+      .WillOnce(testing::Invoke([](const Buffer::RawSlice*, uint64_t,
+                                   const Address::Instance& peer_address,
+                                   absl::string_view control) {
+        EXPECT_EQ(peer_address.asString(), "127.0.0.1:1234");
+        EXPECT_EQ(control.size(), CMSG_SPACE(sizeof(in_pktinfo)));
+        const cmsghdr* cmsg = reinterpret_cast<const cmsghdr*>(control.data());
+        EXPECT_EQ(cmsg->cmsg_type, IP_PKTINFO);
+        return 5;
+      }));
+  auto ret = impl.sendmsg(&slice, 1, 0, self_addr->ip(), *peer_addr);
+  EXPECT_TRUE(ret.ok());
+  EXPECT_EQ(ret.return_value_, 5);
+
+  // Too many sends in flight.
+  EXPECT_CALL(socket_, sendmsg(_, 1, _, _)).WillOnce(testing::Return(-EAGAIN));
+  ret = impl.sendmsg(&slice, 1, 0, nullptr, *peer_addr);
+  EXPECT_TRUE(ret.wouldBlock());
+}
+
 } // namespace
 } // namespace Network
 } // namespace Envoy
@@ -1,11 +1,13 @@
-// Performance benchmark comparing LcTrie vs Linear Search for IP range matching
+// Performance benchmark comparing LcTrie vs Poptrie vs Linear Search for IP range matching
 // in RBAC and access control scenarios.
 
 #include <random>
 #include <vector>
 
+#include "source/common/memory/stats.h"
 #include "source/common/network/cidr_range.h"
 #include "source/common/network/lc_trie.h"
+#include "source/common/network/poptrie.h"
 #include "source/common/network/utility.h"
 #include "source/common/protobuf/protobuf.h"
 
@@ -190,6 +192,65 @@ static void BM_LcTrieIpListMatching(benchmark::State& state) {
   state.SetLabel(fmt::format("LcTrie_{}ranges", num_ranges));
 }
 
+// Benchmark Poptrie IP list implementation, selectable in place of the LcTrie.
+static void BM_PoptrieIpListMatching(benchmark::State& state) {
+  const size_t num_ranges = state.range(0);
+  const size_t num_queries = 1000;
+
+  IpRangeGenerator generator;
+  auto ranges = generator.generateIpv4Ranges(num_ranges);
+  auto test_ips = generator.generateTestIps(num_queries);
+
+  auto cidr_ranges = protobufToCidrRanges(ranges);
+  if (cidr_ranges.empty()) {
+    state.SkipWithError("Failed to convert ranges to CidrRange");
+    return;
+  }
+
+  Network::Poptrie::Poptrie<bool> trie(
+      std::vector<std::pair<bool, std::vector<CidrRange>>>{{true, cidr_ranges}});
+
+  // Pre-generate random queries for consistent benchmark.
+  std::mt19937 rng(12345);
+  std::uniform_int_distribution<size_t> dist(0, test_ips.size() - 1);
+  std::vector<size_t> query_indices;
+  for (size_t i = 0; i < 1024; ++i) {
+    query_indices.push_back(dist(rng));
+  }
+
+  size_t query_idx = 0;
+  for (auto _ : state) {
+    const auto& query_ip = test_ips[query_indices[query_idx % 1024]];
+    bool result = !trie.getData(query_ip).empty();
+    benchmark::DoNotOptimize(result);
+    query_idx++;
+  }
+
+  state.SetItemsProcessed(state.iterations());
+  state.SetLabel(fmt::format("Poptrie_{}ranges", num_ranges));
+}
+
+// Benchmark building the IP list with either trie, and the memory it uses if the allocator
+// supports it.
+template <class Trie> static void BM_TrieIpListBuild(benchmark::State& state) {
+  const size_t num_ranges = state.range(0);
+
+  IpRangeGenerator generator;
+  auto cidr_ranges = protobufToCidrRanges(generator.generateIpv4Ranges(num_ranges));
+  const std::vector<std::pair<bool, std::vector<CidrRange>>> data{{true, cidr_ranges}};
+
+  for (auto _ : state) {
+    const size_t start_mem = Memory::Stats::totalCurrentlyAllocated();
+    auto trie = std::make_unique<Trie>(data);
+    state.PauseTiming();
+    state.counters["memory"] = Memory::Stats::totalCurrentlyAllocated() - start_mem;
+    trie.reset();
+    state.ResumeTiming();
+  }
+
+  state.SetLabel(fmt::format("{}ranges", num_ranges));
+}
+
 // IPv6 benchmarks
 static void BM_LinearIpListMatchingIPv6(benchmark::State& state) {
   const size_t num_ranges = state.range(0);
@@ -269,17 +330,61 @@ static void BM_LcTrieIpListMatchingIPv6(benchmark::State& state) {
   state.SetLabel(fmt::format("LcTrie_IPv6_{}ranges", num_ranges));
 }
 
+static void BM_PoptrieIpListMatchingIPv6(benchmark::State& state) {
+  const size_t num_ranges = state.range(0);
+  const size_t num_queries = 1000;
+
+  IpRangeGenerator generator;
+  auto ranges = generator.generateIpv6Ranges(num_ranges);
+  auto test_ips = generator.generateTestIps(num_queries, true);
+
+  auto cidr_ranges = protobufToCidrRanges(ranges);
+  if (cidr_ranges.empty()) {
+    state.SkipWithError("Failed to convert ranges to CidrRange");
+    return;
+  }
+
+  Network::Poptrie::Poptrie<bool> trie(
+      std::vector<std::pair<bool, std::vector<CidrRange>>>{{true, cidr_ranges}});
+
+  // Pre-generate random queries for consistent benchmark.
+  std::mt19937 rng(12345);
+  std::uniform_int_distribution<size_t> dist(0, test_ips.size() - 1);
+  std::vector<size_t> query_indices;
+  for (size_t i = 0; i < 512; ++i) {
+    query_indices.push_back(dist(rng));
+  }
+
+  size_t query_idx = 0;
+  for (auto _ : state) {
+    const auto& query_ip = test_ips[query_indices[query_idx % 512]];
+    bool result = !trie.getData(query_ip).empty();
+    benchmark::DoNotOptimize(result);
+    query_idx++;
+  }
+
+  state.SetItemsProcessed(state.iterations());
+  state.SetLabel(fmt::format("Poptrie_IPv6_{}ranges", num_ranges));
+}
+
 // Comprehensive benchmarks for RBAC scenarios
 BENCHMARK(BM_LinearIpListMatching)->Range(10, 5000)->Unit(benchmark::kNanosecond);
 BENCHMARK(BM_LcTrieIpListMatching)->Range(10, 5000)->Unit(benchmark::kNanosecond);
+BENCHMARK(BM_PoptrieIpListMatching)->Range(10, 5000)->Unit(benchmark::kNanosecond);
 
 // Focused benchmarks for common RBAC policy sizes
 BENCHMARK(BM_LinearIpListMatching)->Arg(25)->Arg(50)->Arg(100)->Arg(250)->Arg(500)->Arg(1000);
 BENCHMARK(BM_LcTrieIpListMatching)->Arg(25)->Arg(50)->Arg(100)->Arg(250)->Arg(500)->Arg(1000);
+BENCHMARK(BM_PoptrieIpListMatching)->Arg(25)->Arg(50)->Arg(100)->Arg(250)->Arg(500)->Arg(1000);
 
 // IPv6 benchmarks for realistic dual-stack scenarios
 BENCHMARK(BM_LinearIpListMatchingIPv6)->Arg(50)->Arg(200)->Arg(500);
 BENCHMARK(BM_LcTrieIpListMatchingIPv6)->Arg(50)->Arg(200)->Arg(500);
+BENCHMARK(BM_PoptrieIpListMatchingIPv6)->Arg(50)->Arg(200)->Arg(500);
+
+// Build time and memory of both tries
+BENCHMARK_TEMPLATE(BM_TrieIpListBuild, Network::LcTrie::LcTrie<bool>)->Range(10, 5000);
+BENCHMARK_TEMPLATE(BM_TrieIpListBuild, Network::Poptrie::Poptrie<bool>)->Range(10, 5000);
 
 } // namespace Address
 } // namespace Network
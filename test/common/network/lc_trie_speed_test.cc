@@ -1,4 +1,8 @@
+#include <random>
+
+#include "source/common/memory/stats.h"
 #include "source/common/network/lc_trie.h"
+#include "source/common/network/poptrie.h"
 #include "source/common/network/utility.h"
 
 #include "benchmark/benchmark.h"
@@ -50,6 +54,33 @@ struct CidrInputs {
       tag_data_minimal_;
 };
 
+// Random IPv4 prefixes of lengths 8 to 32 spread over 64 tags, in the order of magnitude of large
+// ip_tagging tables.
+struct LargeCidrInputs {
+  explicit LargeCidrInputs(size_t num_prefixes) {
+    std::mt19937 generator(42);
+    tag_data_.resize(64);
+    for (size_t i = 0; i < tag_data_.size(); i++) {
+      tag_data_[i].first = fmt::format("tag_{}", i);
+    }
+    for (size_t i = 0; i < num_prefixes; i++) {
+      const uint32_t ip = generator();
+      tag_data_[i % tag_data_.size()].second.push_back(
+          *Envoy::Network::Address::CidrRange::create(
+              fmt::format("{}.{}.{}.{}", ip >> 24, (ip >> 16) & 0xff, (ip >> 8) & 0xff, ip & 0xff),
+              8 + generator() % 25));
+    }
+    for (size_t i = 0; i < 1024; i++) {
+      const uint32_t ip = generator();
+      addresses_.push_back(Envoy::Network::Utility::parseInternetAddressNoThrow(
+          fmt::format("{}.{}.{}.{}", ip >> 24, (ip >> 16) & 0xff, (ip >> 8) & 0xff, ip & 0xff)));
+    }
+  }
+
+  std::vector<std::pair<std::string, std::vector<Envoy::Network::Address::CidrRange>>> tag_data_;
+  std::vector<Envoy::Network::Address::InstanceConstSharedPtr> addresses_;
+};
+
 } // namespace
 
 namespace Envoy {
@@ -153,4 +184,123 @@ static void lcTrieLookupMinimal(benchmark::State& state) {
 
 BENCHMARK(lcTrieLookupMinimal);
 
+static void poptrieConstruct(benchmark::State& state) {
+  CidrInputs inputs;
+
+  std::unique_ptr<Envoy::Network::Poptrie::Poptrie<std::string>> trie;
+  for (auto _ : state) {
+    UNREFERENCED_PARAMETER(_);
+    trie = std::make_unique<Envoy::Network::Poptrie::Poptrie<std::string>>(inputs.tag_data_);
+  }
+  benchmark::DoNotOptimize(trie);
+}
+
+BENCHMARK(poptrieConstruct);
+
+static void poptrieConstructNested(benchmark::State& state) {
+  CidrInputs inputs;
+
+  std::unique_ptr<Envoy::Network::Poptrie::Poptrie<std::string>> trie;
+  for (auto _ : state) {
+    UNREFERENCED_PARAMETER(_);
+    trie = std::make_unique<Envoy::Network::Poptrie::Poptrie<std::string>>(
+        inputs.tag_data_nested_prefixes_);
+  }
+  benchmark::DoNotOptimize(trie);
+}
+
+BENCHMARK(poptrieConstructNested);
+
+static void poptrieLookup(benchmark::State& state) {
+  CidrInputs cidr_inputs;
+  AddressInputs address_inputs;
+  std::unique_ptr<Envoy::Network::Poptrie::Poptrie<std::string>> poptrie =
+      std::make_unique<Envoy::Network::Poptrie::Poptrie<std::string>>(cidr_inputs.tag_data_);
+
+  static size_t i = 0;
+  size_t output_tags = 0;
+  for (auto _ : state) {
+    UNREFERENCED_PARAMETER(_);
+    i++;
+    i %= address_inputs.addresses_.size();
+    output_tags += poptrie->getData(address_inputs.addresses_[i]).size();
+  }
+  benchmark::DoNotOptimize(output_tags);
+}
+
+BENCHMARK(poptrieLookup);
+
+static void poptrieLookupWithNestedPrefixes(benchmark::State& state) {
+  CidrInputs cidr_inputs;
+  AddressInputs address_inputs;
+  std::unique_ptr<Envoy::Network::Poptrie::Poptrie<std::string>> poptrie_nested_prefixes =
+      std::make_unique<Envoy::Network::Poptrie::Poptrie<std::string>>(
+          cidr_inputs.tag_data_nested_prefixes_);
+
+  static size_t i = 0;
+  size_t output_tags = 0;
+  for (auto _ : state) {
+    UNREFERENCED_PARAMETER(_);
+    i++;
+    i %= address_inputs.addresses_.size();
+    output_tags += poptrie_nested_prefixes->getData(address_inputs.addresses_[i]).size();
+  }
+  benchmark::DoNotOptimize(output_tags);
+}
+
+BENCHMARK(poptrieLookupWithNestedPrefixes);
+
+// Builds a trie of state.range(0) prefixes, and reports the memory it uses if the allocator
+// supports it.
+template <class Trie> static void constructLarge(benchmark::State& state) {
+  LargeCidrInputs inputs(state.range(0));
+
+  for (auto _ : state) {
+    UNREFERENCED_PARAMETER(_);
+    const size_t start_mem = Envoy::Memory::Stats::totalCurrentlyAllocated();
+    auto trie = std::make_unique<Trie>(inputs.tag_data_, true);
+    state.PauseTiming();
+    state.counters["memory"] = Envoy::Memory::Stats::totalCurrentlyAllocated() - start_mem;
+    trie.reset();
+    state.ResumeTiming();
+  }
+}
+
+template <class Trie> static void lookupLarge(benchmark::State& state) {
+  LargeCidrInputs inputs(state.range(0));
+  Trie trie(inputs.tag_data_, true);
+
+  size_t i = 0;
+  size_t output_tags = 0;
+  for (auto _ : state) {
+    UNREFERENCED_PARAMETER(_);
+    i++;
+    i %= inputs.addresses_.size();
+    output_tags += trie.getData(inputs.addresses_[i]).size();
+  }
+  benchmark::DoNotOptimize(output_tags);
+}
+
+// The LC trie supports at most 262144 prefixes with the default fill factor.
+BENCHMARK_TEMPLATE(constructLarge, Envoy::Network::LcTrie::LcTrie<std::string>)
+    ->Arg(1024)
+    ->Arg(65536)
+    ->Arg(262144)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(constructLarge, Envoy::Network::Poptrie::Poptrie<std::string>)
+    ->Arg(1024)
+    ->Arg(65536)
+    ->Arg(262144)
+    ->Arg(524288)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(lookupLarge, Envoy::Network::LcTrie::LcTrie<std::string>)
+    ->Arg(1024)
+    ->Arg(65536)
+    ->Arg(262144);
+BENCHMARK_TEMPLATE(lookupLarge, Envoy::Network::Poptrie::Poptrie<std::string>)
+    ->Arg(1024)
+    ->Arg(65536)
+    ->Arg(262144)
+    ->Arg(524288);
+
 } // namespace Envoy
@@ -0,0 +1,169 @@
+#include <memory>
+#include <random>
+
+#include "source/common/common/utility.h"
+#include "source/common/network/address_impl.h"
+#include "source/common/network/cidr_range.h"
+#include "source/common/network/lc_trie.h"
+#include "source/common/network/poptrie.h"
+
+#include "test/test_common/utility.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Network {
+namespace Poptrie {
+
+class PoptrieTest : public testing::Test {
+public:
+  void setup(const std::vector<std::vector<std::string>>& cidr_range_strings,
+             bool exclusive = false) {
+    std::vector<std::pair<std::string, std::vector<Address::CidrRange>>> output;
+    for (size_t i = 0; i < cidr_range_strings.size(); i++) {
+      std::pair<std::string, std::vector<Address::CidrRange>> ip_tags;
+      ip_tags.first = fmt::format("tag_{0}", i);
+      for (const auto& j : cidr_range_strings[i]) {
+        ip_tags.second.push_back(*Address::CidrRange::create(j));
+      }
+      output.push_back(ip_tags);
+    }
+    trie_ = std::make_unique<Poptrie<std::string>>(output, exclusive);
+  }
+
+  void expectIPAndTags(
+      const std::vector<std::pair<std::string, std::vector<std::string>>>& test_output) {
+    for (const auto& kv : test_output) {
+      std::vector<std::string> expected(kv.second);
+      std::sort(expected.begin(), expected.end());
+      std::vector<std::string> actual(
+          trie_->getData(Utility::parseInternetAddressNoThrow(kv.first)));
+      std::sort(actual.begin(), actual.end());
+      EXPECT_EQ(expected, actual) << kv.first;
+    }
+  }
+
+  std::unique_ptr<Poptrie<std::string>> trie_;
+};
+
+TEST_F(PoptrieTest, IPv4) {
+  std::vector<std::vector<std::string>> cidr_range_strings = {
+      {"0.0.0.0/4"},      // tag_0
+      {"16.0.0.0/4"},     // tag_1
+      {"40.0.0.0/5"},     // tag_2
+      {"128.0.0.0/3"},    // tag_3
+      {"232.0.0.0/8"},    // tag_4
+      {"233.0.0.0/8"},    // tag_5
+      {"10.1.2.3/32"},    // tag_6
+      {"10.1.2.128/25"},  // tag_7
+      {"10.1.2.252/30"},  // tag_8
+  };
+  setup(cidr_range_strings);
+
+  std::vector<std::pair<std::string, std::vector<std::string>>> test_case = {
+      {"0.0.0.0", {"tag_0"}},
+      {"16.0.0.1", {"tag_1"}},
+      {"40.0.0.255", {"tag_2"}},
+      {"48.0.0.0", {}},
+      {"159.255.255.255", {"tag_3"}},
+      {"232.1.2.3", {"tag_4"}},
+      {"233.255.0.0", {"tag_5"}},
+      {"234.0.0.0", {}},
+      {"10.1.2.3", {"tag_0", "tag_6"}},
+      {"10.1.2.2", {"tag_0"}},
+      {"10.1.2.200", {"tag_0", "tag_7"}},
+      {"10.1.2.254", {"tag_0", "tag_7", "tag_8"}},
+      {"::1", {}},
+  };
+  expectIPAndTags(test_case);
+}
+
+TEST_F(PoptrieTest, IPv6) {
+  std::vector<std::vector<std::string>> cidr_range_strings = {
+      {"2406:da00:2000::/40", "::1/128"}, // tag_0
+      {"2001:abcd:ef01:2345::1/128"},     // tag_1
+      {"2001:abcd:ef01:2345::/64"},       // tag_2
+      {"::/0"},                           // tag_3
+  };
+  setup(cidr_range_strings);
+
+  std::vector<std::pair<std::string, std::vector<std::string>>> test_case = {
+      {"2406:da00:2000::1", {"tag_0", "tag_3"}},
+      {"::1", {"tag_0", "tag_3"}},
+      {"::2", {"tag_3"}},
+      {"2001:abcd:ef01:2345::1", {"tag_1", "tag_2", "tag_3"}},
+      {"2001:abcd:ef01:2345::2", {"tag_2", "tag_3"}},
+      {"2001:abcd:ef01:2346::1", {"tag_3"}},
+      {"1.2.3.4", {}},
+  };
+  expectIPAndTags(test_case);
+}
+
+TEST_F(PoptrieTest, Exclusive) {
+  std::vector<std::vector<std::string>> cidr_range_strings = {
+      {"0.0.0.0/0"},      // tag_0
+      {"10.0.0.0/8"},     // tag_1
+      {"10.1.0.0/16"},    // tag_2
+      {"10.1.2.128/32"},  // tag_3
+      {"2001:db8::/32"},  // tag_4
+  };
+  setup(cidr_range_strings, true);
+
+  std::vector<std::pair<std::string, std::vector<std::string>>> test_case = {
+      {"1.2.3.4", {"tag_0"}},
+      {"10.2.3.4", {"tag_1"}},
+      {"10.1.3.4", {"tag_2"}},
+      {"10.1.2.128", {"tag_3"}},
+      {"2001:db8::1", {"tag_4"}},
+      {"2001:db9::1", {}},
+  };
+  expectIPAndTags(test_case);
+}
+
+TEST_F(PoptrieTest, Empty) {
+  setup({});
+  expectIPAndTags({{"1.2.3.4", {}}, {"::1", {}}});
+}
+
+// Compares lookups with an LC trie of the same random prefixes, with enough prefixes to use the
+// direct pointing table.
+TEST(PoptrieLcTrieTest, MatchesLcTrie) {
+  std::mt19937 generator(42);
+  std::vector<std::pair<std::string, std::vector<Address::CidrRange>>> data;
+  for (uint32_t i = 0; i < 16; i++) {
+    std::vector<Address::CidrRange> ranges;
+    for (uint32_t j = 0; j < 512; j++) {
+      const uint32_t ip = generator();
+      ranges.push_back(*Address::CidrRange::create(
+          fmt::format("{}.{}.{}.{}", ip >> 24, (ip >> 16) & 0xff, (ip >> 8) & 0xff, ip & 0xff),
+          8 + generator() % 25));
+      ranges.push_back(*Address::CidrRange::create(
+          fmt::format("2001:db8:{:x}:{:x}::", generator() & 0xffff, generator() & 0xffff),
+          32 + generator() % 65));
+    }
+    data.emplace_back(fmt::format("tag_{}", i), std::move(ranges));
+  }
+
+  for (const bool exclusive : {false, true}) {
+    Poptrie<std::string> poptrie(data, exclusive);
+    LcTrie::LcTrie<std::string> lc_trie(data, exclusive);
+    for (uint32_t i = 0; i < 10000; i++) {
+      const uint32_t ip = generator();
+      const std::string address =
+          i % 2 == 0 ? fmt::format("{}.{}.{}.{}", ip >> 24, (ip >> 16) & 0xff, (ip >> 8) & 0xff,
+                                   ip & 0xff)
+                     : fmt::format("2001:db8:{:x}:{:x}::{:x}", generator() & 0xffff,
+                                   generator() & 0xffff, ip & 0xffff);
+      const auto instance = Utility::parseInternetAddressNoThrow(address);
+      std::vector<std::string> expected = lc_trie.getData(instance);
+      std::vector<std::string> actual = poptrie.getData(instance);
+      std::sort(expected.begin(), expected.end());
+      std::sort(actual.begin(), actual.end());
+      ASSERT_EQ(expected, actual) << address;
+    }
+  }
+}
+
+} // namespace Poptrie
+} // namespace Network
+} // namespace Envoy
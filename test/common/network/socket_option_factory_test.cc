@@ -1,3 +1,7 @@
+#if defined(__linux__)
+#include <linux/filter.h>
+#endif
+
 #include "envoy/config/core/v3/base.pb.h"
 
 #include "source/common/network/address_impl.h"
@@ -298,6 +302,55 @@ TEST_F(SocketOptionFactoryTest, TestBuildBindAddressNoPortOptions) {
   EXPECT_EQ(expected_value, option_details->value_);
 }
 
+TEST_F(SocketOptionFactoryTest, TestBuildBusyPollOptions) {
+  const auto expected_option = ENVOY_SOCKET_SO_BUSY_POLL;
+  CHECK_OPTION_SUPPORTED(expected_option);
+
+  int value = 50;
+  absl::string_view expected_value{reinterpret_cast<char*>(&value), sizeof(value)};
+  auto socket_options = SocketOptionFactory::buildBusyPollOptions(50, false, absl::nullopt);
+  ASSERT_EQ(1, socket_options->size());
+  auto option_details = socket_options->at(0)->getOptionDetails(
+      socket_mock_, envoy::config::core::v3::SocketOption::STATE_PREBIND);
+  EXPECT_TRUE(option_details.has_value());
+  EXPECT_EQ(expected_option.level(), option_details->name_.level());
+  EXPECT_EQ(expected_option.option(), option_details->name_.option());
+  EXPECT_EQ(expected_value, option_details->value_);
+
+  EXPECT_EQ(3, SocketOptionFactory::buildBusyPollOptions(50, true, 16)->size());
+  EXPECT_TRUE(
+      SocketOptionFactory::buildBusyPollOptions(absl::nullopt, false, absl::nullopt)->empty());
+}
+
+TEST_F(SocketOptionFactoryTest, TestBuildReusePortCpuSteeringOptions) {
+  const auto expected_option = ENVOY_ATTACH_REUSEPORT_CBPF;
+  CHECK_OPTION_SUPPORTED(expected_option);
+
+  auto socket_options = SocketOptionFactory::buildReusePortCpuSteeringOptions(4);
+#if defined(__linux__)
+  ASSERT_EQ(1, socket_options->size());
+  EXPECT_FALSE(socket_options->at(0)
+                   ->getOptionDetails(socket_mock_,
+                                      envoy::config::core::v3::SocketOption::STATE_BOUND)
+                   .has_value());
+  auto option_details = socket_options->at(0)->getOptionDetails(
+      socket_mock_, envoy::config::core::v3::SocketOption::STATE_LISTENING);
+  ASSERT_TRUE(option_details.has_value());
+  EXPECT_EQ(expected_option.level(), option_details->name_.level());
+  EXPECT_EQ(expected_option.option(), option_details->name_.option());
+  EXPECT_EQ(Socket::Type::Stream, socket_options->at(0)->socketType());
+
+  ASSERT_EQ(sizeof(sock_fprog), option_details->value_.size());
+  sock_fprog prog;
+  memcpy(&prog, option_details->value_.data(), sizeof(prog));
+  ASSERT_EQ(3, prog.len);
+  EXPECT_EQ(static_cast<uint32_t>(SKF_AD_OFF + SKF_AD_CPU), prog.filter[0].k);
+  EXPECT_EQ(4, prog.filter[1].k);
+#else
+  EXPECT_TRUE(socket_options->empty());
+#endif
+}
+
 } // namespace
 } // namespace Network
 } // namespace Envoy
@@ -0,0 +1,158 @@
+#include <limits>
+
+#include "envoy/config/route/v3/route_components.pb.h"
+
+#include "source/common/router/adaptive_hedging_impl.h"
+
+#include "test/test_common/utility.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Router {
+namespace {
+
+using std::chrono::microseconds;
+using std::chrono::milliseconds;
+
+TEST(LatencyQuantileEstimatorTest, BucketBounds) {
+  for (uint64_t latency_us = 0; latency_us < uint64_t(1) << 20; latency_us++) {
+    const size_t index = LatencyQuantileEstimator::bucketIndex(latency_us);
+    ASSERT_LE(LatencyQuantileEstimator::bucketLowerBound(index), latency_us);
+    ASSERT_GT(LatencyQuantileEstimator::bucketLowerBound(index + 1), latency_us);
+  }
+  // Bucket widths are at most an eighth of their lower bound.
+  EXPECT_EQ(1024U, LatencyQuantileEstimator::bucketLowerBound(
+                      LatencyQuantileEstimator::bucketIndex(1024 + 127)));
+  EXPECT_EQ(1152U, LatencyQuantileEstimator::bucketLowerBound(
+                      LatencyQuantileEstimator::bucketIndex(1024 + 128)));
+  EXPECT_EQ(LatencyQuantileEstimator::bucketIndex(uint64_t(1) << 40),
+            LatencyQuantileEstimator::bucketIndex(std::numeric_limits<uint64_t>::max()));
+}
+
+TEST(LatencyQuantileEstimatorTest, EstimateAfterUpdateInterval) {
+  LatencyQuantileEstimator estimator(0.5);
+  for (uint64_t i = 1; i < LatencyQuantileEstimator::UpdateInterval; i++) {
+    estimator.record(microseconds(1000));
+  }
+  EXPECT_FALSE(estimator.estimate().has_value());
+
+  estimator.record(microseconds(1000));
+  EXPECT_EQ(microseconds(1024), estimator.estimate());
+  EXPECT_EQ(LatencyQuantileEstimator::UpdateInterval, estimator.samples());
+}
+
+TEST(LatencyQuantileEstimatorTest, Quantiles) {
+  LatencyQuantileEstimator p50(0.5);
+  LatencyQuantileEstimator p95(0.95);
+  for (int64_t i = 1; i <= 1024; i++) {
+    p50.record(milliseconds(i));
+    p95.record(milliseconds(i));
+  }
+  EXPECT_GE(p50.estimate().value(), milliseconds(512));
+  EXPECT_LE(p50.estimate().value(), milliseconds(576));
+  EXPECT_GE(p95.estimate().value(), milliseconds(973));
+  EXPECT_LE(p95.estimate().value(), milliseconds(1095));
+}
+
+// The estimate follows a shift of the latencies once the older latencies have decayed.
+TEST(LatencyQuantileEstimatorTest, Decay) {
+  LatencyQuantileEstimator estimator(0.5);
+  for (uint64_t i = 0; i < LatencyQuantileEstimator::DecayInterval; i++) {
+    estimator.record(milliseconds(1));
+  }
+  EXPECT_LT(estimator.estimate().value(), milliseconds(2));
+
+  for (uint64_t i = 0; i < LatencyQuantileEstimator::DecayInterval; i++) {
+    estimator.record(milliseconds(100));
+  }
+  EXPECT_GE(estimator.estimate().value(), milliseconds(100));
+}
+
+class AdaptiveHedgingImplTest : public testing::Test {
+public:
+  void create(const std::string& yaml) {
+    adaptive_hedging_ = std::make_unique<AdaptiveHedgingImpl>(
+        TestUtility::parseYaml<envoy::config::route::v3::HedgePolicy::AdaptiveHedging>(yaml));
+  }
+
+  void recordLatencies(uint64_t count, microseconds latency) {
+    for (uint64_t i = 0; i < count; i++) {
+      adaptive_hedging_->recordLatency(latency);
+    }
+  }
+
+  std::unique_ptr<AdaptiveHedgingImpl> adaptive_hedging_;
+};
+
+TEST_F(AdaptiveHedgingImplTest, MinSamples) {
+  create("{}");
+  recordLatencies(99, milliseconds(10));
+  EXPECT_EQ(absl::nullopt, adaptive_hedging_->onRequest());
+
+  recordLatencies(1, milliseconds(10));
+  const absl::optional<milliseconds> hedge_delay = adaptive_hedging_->onRequest();
+  ASSERT_TRUE(hedge_delay.has_value());
+  EXPECT_GE(hedge_delay.value(), milliseconds(10));
+  EXPECT_LE(hedge_delay.value(), milliseconds(12));
+}
+
+TEST_F(AdaptiveHedgingImplTest, MinHedgeDelay) {
+  create(R"EOF(
+min_samples: 32
+min_hedge_delay: 0.050s
+)EOF");
+  recordLatencies(32, milliseconds(10));
+  EXPECT_EQ(milliseconds(50), adaptive_hedging_->onRequest());
+
+  // Latencies below a millisecond are rounded up.
+  create("{ min_samples: 32 }");
+  recordLatencies(32, microseconds(100));
+  EXPECT_EQ(milliseconds(1), adaptive_hedging_->onRequest());
+}
+
+TEST_F(AdaptiveHedgingImplTest, Budget) {
+  create("{ budget_percent: { value: 10 } }");
+  for (int i = 0; i < 10; i++) {
+    adaptive_hedging_->onRequest();
+  }
+  EXPECT_TRUE(adaptive_hedging_->canHedge());
+  adaptive_hedging_->onHedge();
+  EXPECT_FALSE(adaptive_hedging_->canHedge());
+
+  for (int i = 0; i < 10; i++) {
+    adaptive_hedging_->onRequest();
+  }
+  EXPECT_TRUE(adaptive_hedging_->canHedge());
+}
+
+// The budget follows the recent hedges of the route, as the requests and hedges are halved every
+// BudgetInterval requests.
+TEST_F(AdaptiveHedgingImplTest, BudgetInterval) {
+  create("{ budget_percent: { value: 10 } }");
+  for (uint64_t i = 1; i < AdaptiveHedgingImpl::BudgetInterval; i++) {
+    adaptive_hedging_->onRequest();
+    adaptive_hedging_->onHedge();
+  }
+  EXPECT_FALSE(adaptive_hedging_->canHedge());
+
+  for (uint64_t i = 0; i < AdaptiveHedgingImpl::BudgetInterval; i++) {
+    adaptive_hedging_->onRequest();
+  }
+  EXPECT_FALSE(adaptive_hedging_->canHedge());
+
+  for (uint64_t i = 0; i < 3 * AdaptiveHedgingImpl::BudgetInterval; i++) {
+    adaptive_hedging_->onRequest();
+  }
+  EXPECT_TRUE(adaptive_hedging_->canHedge());
+}
+
+TEST_F(AdaptiveHedgingImplTest, ZeroBudget) {
+  create("{ budget_percent: { value: 0 } }");
+  adaptive_hedging_->onRequest();
+  EXPECT_FALSE(adaptive_hedging_->canHedge());
+}
+
+} // namespace
+} // namespace Router
+} // namespace Envoy
@@ -6,6 +6,7 @@
 
 #include "test/mocks/server/instance.h"
 #include "test/mocks/stream_info/mocks.h"
+#include "test/test_common/test_runtime.h"
 #include "test/test_common/utility.h"
 
 #include "benchmark/benchmark.h"
@@ -202,9 +203,14 @@ static RouteConfiguration genPrefixMatcherTreeRouteConfig(benchmark::State& stat
  * We construct the first `n - 1` items in the route table so they are not
  * matched by the incoming request. Only the last route will be matched.
  * We then time how long it takes for the request to be matched against the
- * last route.
+ * last route. A non-zero second argument enables the path prefilter, which only evaluates the
+ * routes whose path matchers can match the request.
  */
 static void bmRouteTableSize(benchmark::State& state, RouteMatch::PathSpecifierCase match_type) {
+  TestScopedRuntime scoped_runtime;
+  scoped_runtime.mergeValues({{"envoy.reloadable_features.router_path_prefilter",
+                               state.range(1) != 0 ? "true" : "false"}});
+
   // Setup router for benchmarking.
   Api::ApiPtr api = Api::createApiForTest();
   NiceMock<Server::Configuration::MockServerFactoryContext> factory_context;
@@ -256,6 +262,93 @@ static void bmRouteTableSizeWithRegexMatch(benchmark::State& state) {
   bmRouteTableSize(state, RouteMatch::PathSpecifierCase::kSafeRegex);
 }
 
+/**
+ * Generates a virtual host of `n` routes of an API gateway, mostly regexes of path templates:
+ * - /api/v{i % 3}/service_{i}/items/[^/]+
+ * - /api/v{i % 3}/service_{i}/items/[0-9]+/versions/[0-9a-f]{8}
+ * - /api/v{i % 3}/service_{i}/ (prefix, every 4th route)
+ * - /static/ (prefix, last)
+ */
+static RouteConfiguration genRegexHeavyRouteConfig(int routes) {
+  RouteConfiguration route_config;
+  VirtualHost* v_host = route_config.add_virtual_hosts();
+  v_host->set_name("default");
+  v_host->add_domains("*");
+
+  for (int i = 0; i < routes - 1; ++i) {
+    Route* route = v_host->add_routes();
+    route->mutable_direct_response()->set_status(200);
+    RouteMatch* match = route->mutable_match();
+    const std::string service = absl::StrCat("/api/v", i % 3, "/service_", i);
+    switch (i % 4) {
+    case 0:
+      match->mutable_safe_regex()->set_regex(absl::StrCat(service, "/items/[^/]+"));
+      break;
+    case 1:
+      match->mutable_safe_regex()->set_regex(
+          absl::StrCat(service, "/items/[0-9]+/versions/[0-9a-f]{8}"));
+      break;
+    case 2:
+      match->mutable_safe_regex()->set_regex(absl::StrCat(service, "/(search|export)\\.json"));
+      break;
+    default:
+      match->set_prefix(absl::StrCat(service, "/"));
+      break;
+    }
+  }
+  Route* route = v_host->add_routes();
+  route->mutable_direct_response()->set_status(404);
+  route->mutable_match()->set_prefix("/static/");
+
+  return route_config;
+}
+
+/**
+ * Benchmark route matching against genRegexHeavyRouteConfig() with range(0) routes, with requests
+ * that match routes spread over the route table and a request that matches the last route.
+ * A non-zero range(1) enables the path prefilter.
+ */
+static void bmRegexHeavyRouteTable(benchmark::State& state) {
+  TestScopedRuntime scoped_runtime;
+  scoped_runtime.mergeValues({{"envoy.reloadable_features.router_path_prefilter",
+                               state.range(1) != 0 ? "true" : "false"}});
+
+  Api::ApiPtr api = Api::createApiForTest();
+  NiceMock<Server::Configuration::MockServerFactoryContext> factory_context;
+  NiceMock<Envoy::StreamInfo::MockStreamInfo> stream_info;
+  ON_CALL(factory_context, api()).WillByDefault(ReturnRef(*api));
+
+  const int routes = state.range(0);
+  std::shared_ptr<ConfigImpl> config =
+      *ConfigImpl::create(genRegexHeavyRouteConfig(routes), factory_context,
+                          ProtobufMessage::getNullValidationVisitor(), true);
+
+  const auto service = [](int i) { return absl::StrCat("/api/v", i % 3, "/service_", i); };
+  std::vector<std::string> paths{"/static/app.js"};
+  for (const int i : {routes / 8, routes / 2, routes - 8}) {
+    paths.push_back(absl::StrCat(service(i), "/items/8f14e45f?fields=name"));
+    paths.push_back(absl::StrCat(service(i + 1), "/items/42/versions/c0ffee42"));
+    paths.push_back(absl::StrCat(service(i + 2), "/search.json"));
+    paths.push_back(absl::StrCat(service(i + 3), "/health"));
+  }
+  std::vector<Http::TestRequestHeaderMapImpl> requests;
+  for (const std::string& path : paths) {
+    requests.push_back({{":authority", "www.example.com"},
+                        {":method", "GET"},
+                        {":path", path},
+                        {"x-forwarded-proto", "http"}});
+  }
+
+  size_t matched = 0;
+  for (auto _ : state) { // NOLINT
+    for (const Http::TestRequestHeaderMapImpl& request : requests) {
+      matched += config->route(request, stream_info, 0) != nullptr;
+    }
+  }
+  RELEASE_ASSERT(matched == state.iterations() * requests.size(), "");
+  state.SetItemsProcessed(state.iterations() * requests.size());
+}
+
 /**
  * Benchmark matcher tree route matching performance with exact path matchers in the form of:
  * - /shelves/shelf_1/route_1
@@ -311,9 +404,13 @@ static void bmRouteTableSizeWithPrefixMatcherTree(benchmark::State& state) {
   }
 }
 
-BENCHMARK(bmRouteTableSizeWithPathPrefixMatch)->RangeMultiplier(2)->Ranges({{1, 2 << 13}});
-BENCHMARK(bmRouteTableSizeWithExactPathMatch)->RangeMultiplier(2)->Ranges({{1, 2 << 13}});
-BENCHMARK(bmRouteTableSizeWithRegexMatch)->RangeMultiplier(2)->Ranges({{1, 2 << 13}});
+BENCHMARK(bmRouteTableSizeWithPathPrefixMatch)
+    ->ArgsProduct({benchmark::CreateRange(1, 2 << 13, 2), {0, 1}});
+BENCHMARK(bmRouteTableSizeWithExactPathMatch)
+    ->ArgsProduct({benchmark::CreateRange(1, 2 << 13, 2), {0, 1}});
+BENCHMARK(bmRouteTableSizeWithRegexMatch)
+    ->ArgsProduct({benchmark::CreateRange(1, 2 << 13, 2), {0, 1}});
+BENCHMARK(bmRegexHeavyRouteTable)->ArgsProduct({{64, 256, 1024}, {0, 1}});
 
 BENCHMARK(bmRouteTableSizeWithExactMatcherTree)->RangeMultiplier(2)->Ranges({{1, 2 << 13}});
 BENCHMARK(bmRouteTableSizeWithPrefixMatcherTree)->RangeMultiplier(2)->Ranges({{1, 2 << 13}});
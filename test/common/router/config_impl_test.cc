@@ -1330,6 +1330,54 @@ virtual_hosts:
             config.route(genHeaders("example.com", "/", "GET"), 0)->routeEntry()->clusterName());
 }
 
+TEST_F(RouteMatcherTest, ReuseUnchangedVirtualHosts) {
+  const std::string yaml = R"EOF(
+virtual_hosts:
+  - name: www
+    domains: ["www.lyft.com"]
+    routes:
+      - match: { prefix: "/" }
+        route: { cluster: "www" }
+  - name: api
+    domains: ["api.lyft.com"]
+    routes:
+      - match: { prefix: "/" }
+        route: { cluster: "api" }
+  )EOF";
+
+  factory_context_.cluster_manager_.initializeClusters({"www", "api", "api2"}, {});
+  auto proto_config = parseRouteConfigurationFromYaml(yaml);
+  const auto config = *ConfigImpl::create(proto_config, 1, nullptr, factory_context_,
+                                          ProtobufMessage::getNullValidationVisitor(), false);
+  EXPECT_EQ(0U, config->virtualHostsReused());
+  const auto www_route = config->route(genHeaders("www.lyft.com", "/", "GET"), 0).route;
+
+  proto_config.mutable_virtual_hosts(1)->mutable_routes(0)->mutable_route()->set_cluster("api2");
+  const auto updated_config = *ConfigImpl::create(
+      proto_config, 1, config.get(), factory_context_, ProtobufMessage::getNullValidationVisitor(),
+      false);
+  EXPECT_EQ(1U, updated_config->virtualHostsReused());
+  EXPECT_EQ(www_route, updated_config->route(genHeaders("www.lyft.com", "/", "GET"), 0).route);
+  EXPECT_EQ("api2", updated_config->route(genHeaders("api.lyft.com", "/", "GET"), 0)
+                        ->routeEntry()
+                        ->clusterName());
+
+  // Nothing is reused if the remainder of the route configuration changed.
+  const auto config_with_changed_common_config = *ConfigImpl::create(
+      proto_config, 2, updated_config.get(), factory_context_,
+      ProtobufMessage::getNullValidationVisitor(), false);
+  EXPECT_EQ(0U, config_with_changed_common_config->virtualHostsReused());
+  EXPECT_NE(www_route,
+            config_with_changed_common_config->route(genHeaders("www.lyft.com", "/", "GET"), 0)
+                .route);
+
+  // Nor if the clusters are validated.
+  const auto config_validating_clusters = *ConfigImpl::create(
+      proto_config, 2, config_with_changed_common_config.get(), factory_context_,
+      ProtobufMessage::getNullValidationVisitor(), true);
+  EXPECT_EQ(0U, config_validating_clusters->virtualHostsReused());
+}
+
 TEST_F(RouteMatcherTest, TestRoutesWithInvalidRegex) {
   std::string invalid_route = R"EOF(
 virtual_hosts:
@@ -5503,6 +5551,42 @@ virtual_hosts:
   EXPECT_EQ(100, ProtobufPercentHelper::fractionalPercentDenominatorToInt(percent.denominator()));
 }
 
+// Each route of a virtual host hedge policy with adaptive hedging tracks its own latencies.
+TEST_F(RouteMatcherTest, HedgeAdaptiveHedging) {
+  const std::string yaml = R"EOF(
+virtual_hosts:
+- domains: [www.lyft.com]
+  name: www
+  hedge_policy: {adaptive_hedging: {}}
+  routes:
+  - match: {prefix: /foo}
+    route: {cluster: www}
+  - match: {prefix: /bar}
+    route:
+      cluster: www
+      hedge_policy: {hedge_on_per_try_timeout: true}
+  - match: {prefix: /}
+    route: {cluster: www}
+  )EOF";
+
+  factory_context_.cluster_manager_.initializeClusters({"www"}, {});
+  TestConfigImpl config(parseRouteConfigurationFromYaml(yaml), factory_context_, true,
+                        creation_status_);
+
+  const auto adaptive_hedging = [&config](const std::string& path) {
+    return config.route(genHeaders("www.lyft.com", path, "GET"), 0)
+        ->routeEntry()
+        ->hedgePolicy()
+        .adaptiveHedging();
+  };
+  ASSERT_TRUE(adaptive_hedging("/foo").has_value());
+  ASSERT_TRUE(adaptive_hedging("/").has_value());
+  EXPECT_NE(adaptive_hedging("/foo").ptr(), adaptive_hedging("/").ptr());
+  EXPECT_EQ(adaptive_hedging("/foo").ptr(), adaptive_hedging("/foo/1").ptr());
+  // Route level hedge policy takes precedence.
+  EXPECT_FALSE(adaptive_hedging("/bar").has_value());
+}
+
 TEST_F(RouteMatcherTest, HedgeVirtualHostLevel) {
   const std::string yaml = R"EOF(
 virtual_hosts:
@@ -11560,6 +11644,136 @@ virtual_hosts:
   EXPECT_TRUE(route5->filterDisabled("test.filter").value());
 }
 
+TEST_F(PerFilterConfigsTest, RouteHasFilterDisabledOverrides) {
+  const std::string yaml = R"EOF(
+virtual_hosts:
+  - name: bar
+    domains: ["host1"]
+    routes:
+      - match: { prefix: "/route1" }
+        route: { cluster: baz }
+      - match: { prefix: "/route2" }
+        route: { cluster: baz }
+        typed_per_filter_config:
+          test.filter:
+            "@type": type.googleapis.com/envoy.config.route.v3.FilterConfig
+            disabled: true
+  - name: bar
+    domains: ["host2"]
+    routes:
+      - match: { prefix: "/route3" }
+        route: { cluster: baz }
+    typed_per_filter_config:
+      test.filter:
+        "@type": type.googleapis.com/envoy.config.route.v3.FilterConfig
+        config: {}
+)EOF";
+
+  factory_context_.cluster_manager_.initializeClusters({"baz"}, {});
+
+  {
+    const TestConfigImpl config(parseRouteConfigurationFromYaml(yaml), factory_context_, true,
+                                creation_status_);
+
+    // Neither the route, its virtual host nor the route configuration configure a filter.
+    const auto route1 = config.route(genHeaders("host1", "/route1", "GET"), 0);
+    EXPECT_FALSE(route1->hasFilterDisabledOverrides());
+
+    const auto route2 = config.route(genHeaders("host1", "/route2", "GET"), 0);
+    EXPECT_TRUE(route2->hasFilterDisabledOverrides());
+
+    const auto route3 = config.route(genHeaders("host2", "/route3", "GET"), 0);
+    EXPECT_TRUE(route3->hasFilterDisabledOverrides());
+  }
+
+  {
+    envoy::config::route::v3::RouteConfiguration route_config =
+        parseRouteConfigurationFromYaml(yaml);
+    envoy::config::route::v3::FilterConfig filter_config;
+    filter_config.set_disabled(true);
+    (*route_config.mutable_typed_per_filter_config())["test.filter"].PackFrom(filter_config);
+    const TestConfigImpl config(route_config, factory_context_, true, creation_status_);
+
+    const auto route1 = config.route(genHeaders("host1", "/route1", "GET"), 0);
+    EXPECT_TRUE(route1->hasFilterDisabledOverrides());
+  }
+}
+
+// The path prefilter selects the same routes as evaluating every route in order, and route
+// callbacks observe the same evaluation status.
+TEST_F(RouteMatcherTest, PathPrefilter) {
+  mergeValues({{"envoy.reloadable_features.router_path_prefilter", "true"}});
+  const std::string yaml = R"EOF(
+virtual_hosts:
+  - name: default
+    domains: ["*"]
+    routes:
+      - match:
+          safe_regex: { regex: "/users/[0-9]+" }
+          headers:
+            - name: x-version
+              string_match: { exact: "2" }
+        route: { cluster: users_v2 }
+      - match: { safe_regex: { regex: "/users/[0-9]+" } }
+        route: { cluster: users }
+      - match: { path: "/users/Me", case_sensitive: false }
+        route: { cluster: me }
+      - match: { prefix: "/users/" }
+        route: { cluster: users_prefix }
+      - match: { safe_regex: { regex: "/orders/.*" } }
+        route: { cluster: orders }
+      - match: { prefix: "/static/" }
+        route: { cluster: static }
+)EOF";
+
+  factory_context_.cluster_manager_.initializeClusters(
+      {"users_v2", "users", "me", "users_prefix", "orders", "static"}, {});
+  TestConfigImpl config(parseRouteConfigurationFromYaml(yaml), factory_context_, true,
+                        creation_status_);
+
+  EXPECT_EQ("users", config.route(genHeaders("www.lyft.com", "/users/42", "GET"), 0)
+                         ->routeEntry()
+                         ->clusterName());
+  {
+    Http::TestRequestHeaderMapImpl headers = genHeaders("www.lyft.com", "/users/42?a=b", "GET");
+    headers.addCopy("x-version", "2");
+    EXPECT_EQ("users_v2", config.route(headers, 0)->routeEntry()->clusterName());
+  }
+  EXPECT_EQ("me", config.route(genHeaders("www.lyft.com", "/USERS/me", "GET"), 0)
+                      ->routeEntry()
+                      ->clusterName());
+  EXPECT_EQ("users_prefix", config.route(genHeaders("www.lyft.com", "/users/alice", "GET"), 0)
+                                ->routeEntry()
+                                ->clusterName());
+  EXPECT_EQ("orders", config.route(genHeaders("www.lyft.com", "/orders/1#items", "GET"), 0)
+                          ->routeEntry()
+                          ->clusterName());
+  EXPECT_EQ(nullptr, config.route(genHeaders("www.lyft.com", "/carts/1", "GET"), 0).route);
+
+  // Routes that do not match the path are not evaluated, but are still counted as remaining
+  // routes.
+  std::vector<std::string> clusters{"users_prefix", "users"};
+  RouteConstSharedPtr accepted_route = config.route(
+      [&clusters](RouteConstSharedPtr route,
+                  RouteEvalStatus route_eval_status) -> RouteMatchStatus {
+        EXPECT_EQ(clusters.back(), route->routeEntry()->clusterName());
+        clusters.pop_back();
+        EXPECT_EQ(route_eval_status, RouteEvalStatus::HasMoreRoutes);
+        return RouteMatchStatus::Continue;
+      },
+      genHeaders("www.lyft.com", "/users/42", "GET"));
+  EXPECT_EQ(accepted_route, nullptr);
+  EXPECT_TRUE(clusters.empty());
+
+  accepted_route = config.route(
+      [](RouteConstSharedPtr, RouteEvalStatus route_eval_status) -> RouteMatchStatus {
+        EXPECT_EQ(route_eval_status, RouteEvalStatus::NoMoreRoutes);
+        return RouteMatchStatus::Accept;
+      },
+      genHeaders("www.lyft.com", "/static/app.js", "GET"));
+  EXPECT_EQ(accepted_route->routeEntry()->clusterName(), "static");
+}
+
 class RouteMatchOverrideTest : public testing::Test, public ConfigImplTestBase {};
 
 TEST_F(RouteMatchOverrideTest, VerifyAllMatchableRoutes) {
@@ -46,5 +46,68 @@ static void bmEvaluateHeaders(benchmark::State& state) {
 
 BENCHMARK(bmEvaluateHeaders)->DenseRange(2, 20, 2);
 
+static Protobuf::RepeatedPtrField<envoy::config::core::v3::HeaderValueOption>
+headersToOverwrite(absl::string_view prefix, int64_t count, absl::string_view value) {
+  Protobuf::RepeatedPtrField<envoy::config::core::v3::HeaderValueOption> headers_to_add;
+  for (int64_t i = 0; i < count; i++) {
+    envoy::config::core::v3::HeaderValueOption* header_value_option = headers_to_add.Add();
+    header_value_option->set_append_action(HeaderValueOption::OVERWRITE_IF_EXISTS_OR_ADD);
+    header_value_option->mutable_header()->set_key(absl::StrCat(prefix, i));
+    header_value_option->mutable_header()->set_value(value);
+  }
+  return headers_to_add;
+}
+
+// Overwrites range(0) headers with static values, or with values of a command operator if
+// range(1) is set. Static values are used without running their formatters.
+static void bmEvaluateStaticOrFormattedHeaders(benchmark::State& state) {
+  auto request_header = Http::RequestHeaderMapImpl::create();
+  Event::SimulatedTimeSystem time_system;
+  const auto stream_info = std::make_unique<Envoy::TestStreamInfo>(time_system);
+
+  HeaderParserPtr header_parser =
+      HeaderParser::configure(headersToOverwrite("x-header-", state.range(0),
+                                                 state.range(1) != 0 ? "%PROTOCOL%"
+                                                                     : "static-header-value"))
+          .value();
+
+  for (auto _ : state) { // NOLINT: Silences warning about dead store
+    header_parser->evaluateHeaders(*request_header, {request_header.get()}, *stream_info);
+  }
+}
+
+BENCHMARK(bmEvaluateStaticOrFormattedHeaders)->ArgsProduct({{2, 8, 16}, {0, 1}});
+
+// Overwrites range(0) static headers at each of the route configuration, virtual host and route
+// levels, by evaluating the parsers of the levels one after another or, if range(1) is set, the
+// parser merged from them as routes do.
+static void bmEvaluateRouteLevelHeaders(benchmark::State& state) {
+  auto request_header = Http::RequestHeaderMapImpl::create();
+  Event::SimulatedTimeSystem time_system;
+  const auto stream_info = std::make_unique<Envoy::TestStreamInfo>(time_system);
+
+  std::vector<HeaderParserPtr> level_parsers;
+  std::array<const HeaderParser*, 3> parsers;
+  for (absl::string_view level : {"x-route-config-", "x-vhost-", "x-route-"}) {
+    level_parsers.push_back(
+        HeaderParser::configure(headersToOverwrite(level, state.range(0), "value")).value());
+    parsers[level_parsers.size() - 1] = level_parsers.back().get();
+  }
+  HeaderParserPtr merged = HeaderParser::merge(parsers);
+  RELEASE_ASSERT(merged != nullptr, "");
+
+  for (auto _ : state) { // NOLINT: Silences warning about dead store
+    if (state.range(1) != 0) {
+      merged->evaluateHeaders(*request_header, {request_header.get()}, *stream_info);
+    } else {
+      for (const HeaderParser* parser : parsers) {
+        parser->evaluateHeaders(*request_header, {request_header.get()}, *stream_info);
+      }
+    }
+  }
+}
+
+BENCHMARK(bmEvaluateRouteLevelHeaders)->ArgsProduct({{1, 2, 4}, {0, 1}});
+
 } // namespace Router
 } // namespace Envoy
@@ -1,3 +1,4 @@
+#include <array>
 #include <string>
 
 #include "envoy/config/core/v3/base.pb.h"
@@ -1166,6 +1167,107 @@ response_headers_to_remove: ["x-baz-header"]
   }
 }
 
+TEST(HeaderParserTest, MergeStaticHeaders) {
+  const std::string vhost_yaml = R"EOF(
+match: { prefix: "/" }
+route:
+  cluster: www2
+request_headers_to_add:
+  - header:
+      key: "x-vhost-header"
+      value: "vhost"
+    append_action: OVERWRITE_IF_EXISTS_OR_ADD
+request_headers_to_remove: ["x-vhost-remove"]
+)EOF";
+  const std::string route_yaml = R"EOF(
+match: { prefix: "/" }
+route:
+  cluster: www2
+request_headers_to_add:
+  - header:
+      key: "x-route-header"
+      value: "route"
+  - header:
+      key: "x-route-header"
+      value: "route2"
+  - header:
+      key: "x-absent-header"
+      value: "absent"
+    append_action: ADD_IF_ABSENT
+)EOF";
+
+  const auto vhost = parseRouteFromV3Yaml(vhost_yaml);
+  const auto route = parseRouteFromV3Yaml(route_yaml);
+  HeaderParserPtr vhost_parser =
+      HeaderParser::configure(vhost.request_headers_to_add(), vhost.request_headers_to_remove())
+          .value();
+  HeaderParserPtr route_parser = HeaderParser::configure(route.request_headers_to_add()).value();
+  const std::array<const HeaderParser*, 3> parsers{
+      &HeaderParser::defaultParser(), vhost_parser.get(), route_parser.get()};
+  HeaderParserPtr merged = HeaderParser::merge(parsers);
+  ASSERT_NE(nullptr, merged);
+
+  NiceMock<Envoy::StreamInfo::MockStreamInfo> stream_info;
+  Http::TestRequestHeaderMapImpl expected{{"x-vhost-header", "old"},
+                                          {"x-vhost-remove", "remove"},
+                                          {"x-absent-header", "present"}};
+  Http::TestRequestHeaderMapImpl header_map = expected;
+  for (const HeaderParser* parser : parsers) {
+    parser->evaluateHeaders(expected, stream_info);
+  }
+  merged->evaluateHeaders(header_map, stream_info);
+  EXPECT_EQ(expected, header_map);
+  EXPECT_EQ("vhost", header_map.get_("x-vhost-header"));
+  EXPECT_FALSE(header_map.has("x-vhost-remove"));
+  EXPECT_EQ(2, header_map.get(Http::LowerCaseString("x-route-header")).size());
+  EXPECT_EQ("present", header_map.get_("x-absent-header"));
+
+  // A single parser that modifies headers is not merged.
+  EXPECT_EQ(nullptr, HeaderParser::merge({&HeaderParser::defaultParser(), route_parser.get()}));
+}
+
+TEST(HeaderParserTest, MergeRejectsDependentParsers) {
+  const std::string yaml = R"EOF(
+match: { prefix: "/" }
+route:
+  cluster: www2
+request_headers_to_add:
+  - header:
+      key: "x-static-header"
+      value: "static"
+  - header:
+      key: "x-dynamic-header"
+      value: "%PROTOCOL%"
+request_headers_to_remove: ["x-removed-header"]
+)EOF";
+
+  const auto route = parseRouteFromV3Yaml(yaml);
+  HeaderParserPtr parser =
+      HeaderParser::configure(route.request_headers_to_add(), route.request_headers_to_remove())
+          .value();
+
+  Protobuf::RepeatedPtrField<HeaderValueOption> headers_to_add;
+  auto* header = headers_to_add.Add()->mutable_header();
+  header->set_key("x-other-header");
+  header->set_value("other");
+  HeaderParserPtr static_parser = HeaderParser::configure(headers_to_add).value();
+
+  // The value of a header depends on the stream.
+  EXPECT_EQ(nullptr, HeaderParser::merge({static_parser.get(), parser.get()}));
+
+  Protobuf::RepeatedPtrField<std::string> headers_to_remove;
+  headers_to_remove.Add("x-other-header");
+  HeaderParserPtr remove_parser =
+      HeaderParser::configure(Protobuf::RepeatedPtrField<HeaderValueOption>{}, headers_to_remove)
+          .value();
+  // A header added by one parser is removed by another.
+  EXPECT_EQ(nullptr, HeaderParser::merge({static_parser.get(), remove_parser.get()}));
+
+  header->set_key("x-remaining-header");
+  HeaderParserPtr other_static_parser = HeaderParser::configure(headers_to_add).value();
+  EXPECT_NE(nullptr, HeaderParser::merge({remove_parser.get(), other_static_parser.get()}));
+}
+
 } // namespace
 } // namespace Router
 } // namespace Envoy
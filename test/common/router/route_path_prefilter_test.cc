@@ -0,0 +1,137 @@
+#include "envoy/config/route/v3/route.pb.h"
+
+#include "source/common/common/regex.h"
+#include "source/common/router/route_path_prefilter.h"
+
+#include "test/test_common/utility.h"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Router {
+namespace {
+
+using testing::ElementsAre;
+using testing::IsEmpty;
+
+// A regex engine that is not RE2.
+class TestRegexEngine : public Regex::Engine {
+public:
+  absl::StatusOr<Regex::CompiledMatcherPtr> matcher(const std::string& regex) const override {
+    return Regex::GoogleReEngine().matcher(regex);
+  }
+};
+
+class RoutePathPrefilterTest : public testing::Test {
+public:
+  RoutePathPrefilterPtr create(const std::string& yaml, bool ignore_path_parameters = false) {
+    virtual_host_ = TestUtility::parseYaml<envoy::config::route::v3::VirtualHost>(yaml);
+    return RoutePathPrefilter::create(virtual_host_.routes(), ignore_path_parameters,
+                                      regex_engine_);
+  }
+
+  envoy::config::route::v3::VirtualHost virtual_host_;
+  Regex::GoogleReEngine regex_engine_;
+};
+
+TEST_F(RoutePathPrefilterTest, NothingToIndex) {
+  EXPECT_EQ(nullptr, create(R"EOF(
+name: default
+domains: ["*"]
+routes:
+  - match: { connect_matcher: {} }
+    route: { cluster: connect }
+)EOF"));
+}
+
+TEST_F(RoutePathPrefilterTest, CandidatesInRouteOrder) {
+  const RoutePathPrefilterPtr prefilter = create(R"EOF(
+name: default
+domains: ["*"]
+routes:
+  - match: { safe_regex: { regex: "/users/[0-9]+" } }
+    route: { cluster: users }
+  - match: { path: "/users/42" }
+    route: { cluster: user_42 }
+  - match: { prefix: "/users/" }
+    route: { cluster: users_prefix }
+  - match: { safe_regex: { regex: "/users/[a-z]+" } }
+    route: { cluster: user_names }
+  - match: { path_separated_prefix: "/users" }
+    route: { cluster: users_separated }
+  - match: { prefix: "/" }
+    route: { cluster: default }
+)EOF");
+  ASSERT_NE(nullptr, prefilter);
+  EXPECT_EQ(0, prefilter->unindexedRoutes());
+
+  EXPECT_THAT(prefilter->candidates("/users/42"), ElementsAre(0, 1, 2, 4, 5));
+  EXPECT_THAT(prefilter->candidates("/users/43?verbose=true"), ElementsAre(0, 2, 4, 5));
+  EXPECT_THAT(prefilter->candidates("/users/alice#top"), ElementsAre(2, 3, 4, 5));
+  EXPECT_THAT(prefilter->candidates("/users"), ElementsAre(4, 5));
+  EXPECT_THAT(prefilter->candidates("/orders"), ElementsAre(5));
+  // Regexes match the whole path.
+  EXPECT_THAT(prefilter->candidates("/users/42/orders"), ElementsAre(2, 4, 5));
+}
+
+TEST_F(RoutePathPrefilterTest, CaseInsensitivePaths) {
+  const RoutePathPrefilterPtr prefilter = create(R"EOF(
+name: default
+domains: ["*"]
+routes:
+  - match: { path: "/Users", case_sensitive: false }
+    route: { cluster: users }
+  - match: { prefix: "/Orders/", case_sensitive: false }
+    route: { cluster: orders }
+  - match: { path: "/Users" }
+    route: { cluster: users_exact_case }
+)EOF");
+  ASSERT_NE(nullptr, prefilter);
+
+  EXPECT_THAT(prefilter->candidates("/Users"), ElementsAre(0, 2));
+  EXPECT_THAT(prefilter->candidates("/USERS"), ElementsAre(0));
+  EXPECT_THAT(prefilter->candidates("/orders/1"), ElementsAre(1));
+  EXPECT_THAT(prefilter->candidates("/users/1"), IsEmpty());
+}
+
+TEST_F(RoutePathPrefilterTest, IgnorePathParameters) {
+  const std::string yaml = R"EOF(
+name: default
+domains: ["*"]
+routes:
+  - match: { path: "/users" }
+    route: { cluster: users }
+)EOF";
+  EXPECT_THAT(create(yaml, true)->candidates("/users;session=1?q=2"), ElementsAre(0));
+  EXPECT_THAT(create(yaml, false)->candidates("/users;session=1?q=2"), IsEmpty());
+}
+
+// Routes of other path matchers and regexes of other engines are candidates for every path.
+TEST_F(RoutePathPrefilterTest, UnindexedRoutes) {
+  virtual_host_ = TestUtility::parseYaml<envoy::config::route::v3::VirtualHost>(R"EOF(
+name: default
+domains: ["*"]
+routes:
+  - match: { safe_regex: { regex: "/users/[0-9]+" } }
+    route: { cluster: users }
+  - match: { path: "/orders" }
+    route: { cluster: orders }
+  - match: { safe_regex: { google_re2: {}, regex: "/items/[0-9]+" } }
+    route: { cluster: items }
+  - match: { connect_matcher: {} }
+    route: { cluster: connect }
+)EOF");
+  TestRegexEngine engine;
+  const RoutePathPrefilterPtr prefilter =
+      RoutePathPrefilter::create(virtual_host_.routes(), false, engine);
+  ASSERT_NE(nullptr, prefilter);
+  EXPECT_EQ(2, prefilter->unindexedRoutes());
+
+  EXPECT_THAT(prefilter->candidates("/orders"), ElementsAre(0, 1, 3));
+  EXPECT_THAT(prefilter->candidates("/items/1"), ElementsAre(0, 2, 3));
+}
+
+} // namespace
+} // namespace Router
+} // namespace Envoy
@@ -13,6 +13,7 @@
 #include "envoy/type/v3/percent.pb.h"
 
 #include "source/common/buffer/buffer_impl.h"
+#include "source/common/buffer/shared_buffer.h"
 #include "source/common/common/base64.h"
 #include "source/common/common/empty_string.h"
 #include "source/common/config/metadata.h"
@@ -2528,7 +2529,7 @@ TEST_F(RouterTest, HedgedPerTryTimeoutFirstRequestSucceeds) {
   EXPECT_TRUE(verifyHostUpstreamStats(1, 0));
   EXPECT_EQ(0U, router_->upstreamRequests().size());
 
-  // TODO: Verify hedge stats here once they are implemented.
+  EXPECT_TRUE(verifyHedgeStats(1, 1, 0));
 }
 
 // Tests that an upstream request is reset even if it can't be retried as long as there is
@@ -2626,7 +2627,7 @@ TEST_F(RouterTest, HedgedPerTryTimeoutResetsOnBadHeaders) {
   response_decoder1->decodeHeaders(std::move(response_headers), true);
   EXPECT_TRUE(verifyHostUpstreamStats(1, 1));
 
-  // TODO: Verify hedge stats here once they are implemented.
+  EXPECT_TRUE(verifyHedgeStats(1, 0, 0));
 }
 
 // Three requests sent: 1) 5xx error, 2) per try timeout, 3) gets good response
@@ -2772,7 +2773,7 @@ TEST_F(RouterTest, HedgedPerTryTimeoutThirdRequestSucceeds) {
 
   EXPECT_EQ(333U, callbacks_.stream_info_.upstreamInfo()->upstreamConnectionId());
 
-  // TODO: Verify hedge stats here once they are implemented.
+  EXPECT_TRUE(verifyHedgeStats(1, 0, 1));
 }
 
 // First request times out and is retried, and then a response is received.
@@ -3032,6 +3033,65 @@ TEST_F(RouterTest, RetryRequestDuringBody) {
   EXPECT_TRUE(verifyHostUpstreamStats(1, 1));
 }
 
+// Test retrying a request during the body with the request body shared, in which case the
+// upstream requests reference the slices of the body rather than copies of it.
+TEST_F(RouterTest, RetryRequestDuringBodySharedBody) {
+  TestScopedRuntime scoped_runtime;
+  scoped_runtime.mergeValues({{"envoy.reloadable_features.router_shared_request_body", "true"}});
+  recreateFilter();
+
+  Buffer::OwnedImpl decoding_buffer;
+  EXPECT_CALL(callbacks_, decodingBuffer()).WillRepeatedly(Return(&decoding_buffer));
+  EXPECT_CALL(callbacks_, addDecodedData(_, true))
+      .WillRepeatedly(Invoke([&](Buffer::Instance& data, bool) { decoding_buffer.move(data); }));
+
+  NiceMock<Http::MockRequestEncoder> encoder1;
+  Http::ResponseDecoder* response_decoder = nullptr;
+  expectNewStreamWithImmediateEncoder(encoder1, &response_decoder, Http::Protocol::Http10);
+
+  expectResponseTimerCreate();
+
+  Http::TestRequestHeaderMapImpl headers{{"x-envoy-retry-on", "5xx"}, {"x-envoy-internal", "true"}};
+  HttpTestUtility::addDefaultHeaders(headers);
+  router_->decodeHeaders(headers, false);
+  const std::string body1(Buffer::OwnedImpl::CopyThreshold, 'a');
+  Buffer::OwnedImpl buf1(body1);
+  const void* body1_data = buf1.frontSlice().mem_;
+  EXPECT_CALL(encoder1, encodeData(BufferStringEqual(body1), false))
+      .WillOnce(Invoke([&](Buffer::Instance& data, bool) {
+        EXPECT_EQ(body1_data, data.frontSlice().mem_);
+      }));
+  EXPECT_CALL(*router_->retry_state_, enabled()).WillOnce(Return(true));
+  router_->decodeData(buf1, false);
+  EXPECT_EQ(body1_data, decoding_buffer.frontSlice().mem_);
+
+  router_->retry_state_->expectResetRetry();
+  encoder1.stream_.resetStream(Http::StreamResetReason::RemoteReset);
+
+  NiceMock<Http::MockRequestEncoder> encoder2;
+  expectNewStreamWithImmediateEncoder(encoder2, &response_decoder, Http::Protocol::Http10);
+  EXPECT_CALL(encoder2, encodeData(BufferStringEqual(body1), false))
+      .WillOnce(Invoke([&](Buffer::Instance& data, bool) {
+        EXPECT_EQ(body1_data, data.frontSlice().mem_);
+      }));
+  router_->retry_state_->callback_();
+  EXPECT_EQ(2 * body1.size(), stats_store_.counter("test.rq_body_shared_bytes").value());
+
+  // Small slices are copied.
+  const std::string body2("body2");
+  EXPECT_CALL(encoder2, encodeData(BufferStringEqual(body2), true));
+  Buffer::OwnedImpl buf2(body2);
+  EXPECT_CALL(*router_->retry_state_, enabled()).WillOnce(Return(true));
+  router_->decodeData(buf2, true);
+  EXPECT_EQ(2 * body1.size(), stats_store_.counter("test.rq_body_shared_bytes").value());
+
+  Http::ResponseHeaderMapPtr response_headers(
+      new Http::TestResponseHeaderMapImpl({{":status", "200"}}));
+  EXPECT_CALL(callbacks_, encodeHeaders_(_, _));
+  response_decoder->decodeHeaders(std::move(response_headers), true);
+  EXPECT_TRUE(verifyHostUpstreamStats(1, 1));
+}
+
 // Test retrying a request, when the first attempt fails while the client
 // is sending the body, with more data arriving in between upstream attempts
 // (which would normally happen during the backoff timer interval), but not end_stream.
@@ -3666,7 +3726,94 @@ TEST_F(RouterTest, HedgedPerTryTimeoutGlobalTimeout) {
   response_timeout_->invokeCallback();
   EXPECT_TRUE(verifyHostUpstreamStats(0, 2));
   EXPECT_EQ(2, cm_.thread_local_cluster_.conn_pool_.host_->stats_.rq_timeout_.value());
-  // TODO: Verify hedge stats here once they are implemented.
+  EXPECT_TRUE(verifyHedgeStats(1, 0, 0));
+}
+
+// Adaptive hedging shortens the per try timeout to the hedge delay of the route and records the
+// latency of the response.
+TEST_F(RouterTest, AdaptiveHedgingPerTryTimeout) {
+  NiceMock<MockAdaptiveHedging> adaptive_hedging;
+  callbacks_.route_->route_entry_.hedge_policy_.adaptive_hedging_ = &adaptive_hedging;
+  callbacks_.route_->route_entry_.retry_policy_->per_try_timeout_ = std::chrono::milliseconds(8);
+  EXPECT_CALL(adaptive_hedging, onRequest()).WillOnce(Return(std::chrono::milliseconds(7)));
+
+  NiceMock<Http::MockRequestEncoder> encoder;
+  Http::ResponseDecoder* response_decoder = nullptr;
+  expectNewStreamWithImmediateEncoder(encoder, &response_decoder, Http::Protocol::Http10);
+  expectResponseTimerCreate();
+  per_try_timeout_ = new Event::MockTimer(&callbacks_.dispatcher_);
+  EXPECT_CALL(*per_try_timeout_, enableTimer(std::chrono::milliseconds(7), _));
+  EXPECT_CALL(*per_try_timeout_, disableTimer());
+
+  Http::TestRequestHeaderMapImpl headers;
+  HttpTestUtility::addDefaultHeaders(headers);
+  router_->decodeHeaders(headers, true);
+  // Hedged requests expect the global timeout.
+  EXPECT_EQ("10", headers.get_("x-envoy-expected-rq-timeout-ms"));
+
+  EXPECT_CALL(adaptive_hedging, recordLatency(_));
+  EXPECT_CALL(callbacks_, encodeHeaders_(_, true));
+  Http::ResponseHeaderMapPtr response_headers(
+      new Http::TestResponseHeaderMapImpl{{":status", "200"}});
+  response_decoder->decodeHeaders(std::move(response_headers), true);
+  EXPECT_TRUE(verifyHedgeStats(0, 0, 0));
+}
+
+// The hedge delay is not used before the route has enough latencies and responses that fail do
+// not count towards its latencies.
+TEST_F(RouterTest, AdaptiveHedgingWithoutHedgeDelay) {
+  NiceMock<MockAdaptiveHedging> adaptive_hedging;
+  callbacks_.route_->route_entry_.hedge_policy_.adaptive_hedging_ = &adaptive_hedging;
+  EXPECT_CALL(adaptive_hedging, onRequest()).WillOnce(Return(absl::nullopt));
+
+  NiceMock<Http::MockRequestEncoder> encoder;
+  Http::ResponseDecoder* response_decoder = nullptr;
+  expectNewStreamWithImmediateEncoder(encoder, &response_decoder, Http::Protocol::Http10);
+  expectResponseTimerCreate();
+
+  Http::TestRequestHeaderMapImpl headers;
+  HttpTestUtility::addDefaultHeaders(headers);
+  router_->decodeHeaders(headers, true);
+  EXPECT_EQ(nullptr, per_try_timeout_);
+
+  EXPECT_CALL(adaptive_hedging, recordLatency(_)).Times(0);
+  EXPECT_CALL(callbacks_, encodeHeaders_(_, true));
+  Http::ResponseHeaderMapPtr response_headers(
+      new Http::TestResponseHeaderMapImpl{{":status", "503"}});
+  response_decoder->decodeHeaders(std::move(response_headers), true);
+}
+
+// A per try timeout does not hedge once the hedges of the route exceed its budget.
+TEST_F(RouterTest, AdaptiveHedgingBudgetExhausted) {
+  NiceMock<MockAdaptiveHedging> adaptive_hedging;
+  callbacks_.route_->route_entry_.hedge_policy_.adaptive_hedging_ = &adaptive_hedging;
+  EXPECT_CALL(adaptive_hedging, onRequest()).WillOnce(Return(std::chrono::milliseconds(5)));
+
+  NiceMock<Http::MockRequestEncoder> encoder;
+  Http::ResponseDecoder* response_decoder = nullptr;
+  expectNewStreamWithImmediateEncoder(encoder, &response_decoder, Http::Protocol::Http10);
+  expectResponseTimerCreate();
+  expectPerTryTimerCreate();
+
+  Http::TestRequestHeaderMapImpl headers;
+  HttpTestUtility::addDefaultHeaders(headers);
+  router_->decodeHeaders(headers, true);
+
+  EXPECT_CALL(adaptive_hedging, canHedge()).WillOnce(Return(false));
+  EXPECT_CALL(adaptive_hedging, onHedge()).Times(0);
+  EXPECT_CALL(*router_->retry_state_, shouldHedgeRetryPerTryTimeout(_)).Times(0);
+  EXPECT_CALL(encoder.stream_, resetStream(_)).Times(0);
+  EXPECT_CALL(
+      cm_.thread_local_cluster_.conn_pool_.host_->outlier_detector_,
+      putResult(Upstream::Outlier::Result::LocalOriginTimeout, absl::optional<uint64_t>(504)));
+  per_try_timeout_->invokeCallback();
+
+  EXPECT_CALL(adaptive_hedging, recordLatency(_));
+  EXPECT_CALL(callbacks_, encodeHeaders_(_, true));
+  Http::ResponseHeaderMapPtr response_headers(
+      new Http::TestResponseHeaderMapImpl{{":status", "200"}});
+  response_decoder->decodeHeaders(std::move(response_headers), true);
+  EXPECT_TRUE(verifyHedgeStats(0, 0, 0));
 }
 
 // Sequence: 1) per try timeout w/ hedge retry, 2) second request gets a 5xx
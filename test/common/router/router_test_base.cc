@@ -91,6 +91,21 @@ AssertionResult RouterTestBase::verifyHostUpstreamStats(uint64_t success, uint64
   return AssertionSuccess();
 }
 
+AssertionResult RouterTestBase::verifyHedgeStats(uint64_t launched, uint64_t wasted,
+                                                 uint64_t won) {
+  for (const auto& [name, expected] : {std::make_pair("upstream_rq_hedge_launched", launched),
+                                       std::make_pair("upstream_rq_hedge_wasted", wasted),
+                                       std::make_pair("upstream_rq_hedge_won", won)}) {
+    const uint64_t value =
+        cm_.thread_local_cluster_.cluster_.info_->stats_store_.counter(name).value();
+    if (expected != value) {
+      return AssertionFailure() << fmt::format("{} {} does not match expected {}", name, value,
+                                               expected);
+    }
+  }
+  return AssertionSuccess();
+}
+
 void RouterTestBase::verifyAttemptCountInRequestBasic(bool set_include_attempt_count_in_request,
                                                       absl::optional<int> preset_count,
                                                       int expected_count) {
@@ -74,6 +74,7 @@ public:
   void expectPerTryIdleTimerCreate(std::chrono::milliseconds timeout);
   void expectMaxStreamDurationTimerCreate(std::chrono::milliseconds duration_msec);
   AssertionResult verifyHostUpstreamStats(uint64_t success, uint64_t error);
+  AssertionResult verifyHedgeStats(uint64_t launched, uint64_t wasted, uint64_t won);
   void verifyAttemptCountInRequestBasic(bool set_include_attempt_count_in_request,
                                         absl::optional<int> preset_count, int expected_count);
   void verifyAttemptCountInResponseBasic(bool set_include_attempt_count_in_response,
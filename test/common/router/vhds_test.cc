@@ -22,6 +22,7 @@
 #include "test/mocks/thread_local/mocks.h"
 #include "test/test_common/printers.h"
 #include "test/test_common/simulated_time_system.h"
+#include "test/test_common/test_runtime.h"
 #include "test/test_common/utility.h"
 
 #include "gmock/gmock.h"
@@ -79,7 +80,8 @@ vhds:
   RouteConfigUpdatePtr
   makeRouteConfigUpdate(const envoy::config::route::v3::RouteConfiguration& rc) {
     RouteConfigUpdatePtr config_update_info =
-        std::make_unique<RouteConfigUpdateReceiverImpl>(proto_traits_, factory_context_);
+        std::make_unique<RouteConfigUpdateReceiverImpl>(proto_traits_, factory_context_,
+                                                        "test.");
     config_update_info->onRdsUpdate(rc, "1");
     return config_update_info;
   }
@@ -153,6 +155,40 @@ TEST_F(VhdsTest, VhdsAddsVirtualHosts) {
       vhost, config_update_info->protobufConfigurationCast().virtual_hosts(0)));
 }
 
+// verify that VHDS updates reuse the virtual hosts that did not change
+TEST_F(VhdsTest, VhdsUpdatesReuseUnchangedVirtualHosts) {
+  TestScopedRuntime scoped_runtime;
+  scoped_runtime.mergeValues(
+      {{"envoy.reloadable_features.rds_reuse_unchanged_virtual_hosts", "true"}});
+  const auto route_config =
+      TestUtility::parseYaml<envoy::config::route::v3::RouteConfiguration>(default_vhds_config_);
+  RouteConfigUpdatePtr config_update_info = makeRouteConfigUpdate(route_config);
+
+  VhdsSubscriptionPtr subscription = VhdsSubscription::createVhdsSubscription(
+                                         config_update_info, factory_context_, context_, provider_)
+                                         .value();
+  const Protobuf::RepeatedPtrField<std::string> removed_resources;
+  const auto added_resources = buildAddedResources({buildVirtualHost("vhost1", "vhost.first")});
+  const auto decoded_resources =
+      TestUtility::decodeResources<envoy::config::route::v3::VirtualHost>(added_resources);
+  EXPECT_TRUE(factory_context_.cluster_manager_.subscription_factory_.callbacks_
+                  ->onConfigUpdate(decoded_resources.refvec_, removed_resources, "1")
+                  .ok());
+  EXPECT_EQ(0UL, factory_context_.store_.counter("test.virtual_hosts_reused").value());
+  EXPECT_EQ(1UL, factory_context_.store_.counter("test.virtual_hosts_rebuilt").value());
+
+  const auto more_added_resources =
+      buildAddedResources({buildVirtualHost("vhost2", "vhost.second")});
+  const auto more_decoded_resources =
+      TestUtility::decodeResources<envoy::config::route::v3::VirtualHost>(more_added_resources);
+  EXPECT_TRUE(factory_context_.cluster_manager_.subscription_factory_.callbacks_
+                  ->onConfigUpdate(more_decoded_resources.refvec_, removed_resources, "2")
+                  .ok());
+  EXPECT_EQ(2UL, config_update_info->protobufConfigurationCast().virtual_hosts_size());
+  EXPECT_EQ(1UL, factory_context_.store_.counter("test.virtual_hosts_reused").value());
+  EXPECT_EQ(2UL, factory_context_.store_.counter("test.virtual_hosts_rebuilt").value());
+}
+
 // verify that an RDS update of virtual hosts leaves VHDS virtual hosts intact
 TEST_F(VhdsTest, RdsUpdatesVirtualHosts) {
   const auto route_config =
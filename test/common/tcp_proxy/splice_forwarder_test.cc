@@ -0,0 +1,205 @@
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "source/common/buffer/buffer_impl.h"
+#include "source/common/network/connection_impl.h"
+#include "source/common/network/io_socket_handle_impl.h"
+#include "source/common/network/utility.h"
+#include "source/common/stream_info/stream_info_impl.h"
+#include "source/common/tcp_proxy/splice_forwarder.h"
+
+#include "test/mocks/network/mocks.h"
+#include "test/test_common/network_utility.h"
+#include "test/test_common/utility.h"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace TcpProxy {
+namespace {
+
+class SpliceForwarderTest : public testing::Test, public SpliceForwarder::Callbacks {
+protected:
+  SpliceForwarderTest()
+      : api_(Api::createApiForTest()), dispatcher_(api_->allocateDispatcher("test_thread")),
+        stream_info_(dispatcher_->timeSource(), nullptr,
+                     StreamInfo::FilterState::LifeSpan::Connection) {}
+
+  ~SpliceForwarderTest() override {
+    forwarder_.reset();
+    for (auto& connection : connections_) {
+      connection->close(Network::ConnectionCloseType::NoFlush);
+    }
+    for (os_fd_t fd : peers_) {
+      ::close(fd);
+    }
+  }
+
+  // Returns a connection for one end of a socket pair, and sets the other end as its peer.
+  Network::Connection& createConnection(os_fd_t& peer) {
+    int fds[2];
+    RELEASE_ASSERT(::socketpair(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0, fds) == 0, "");
+    peer = fds[0];
+    peers_.push_back(peer);
+    const auto address = Network::Utility::getCanonicalIpv4LoopbackAddress();
+    connections_.push_back(dispatcher_->createServerConnection(
+        std::make_unique<Network::ConnectionSocketImpl>(
+            std::make_unique<Network::IoSocketHandleImpl>(fds[1]), address, address),
+        Network::Test::createRawBufferSocket(), stream_info_));
+    connections_.back()->enableHalfClose(true);
+    return *connections_.back();
+  }
+
+  // Runs the dispatcher until the condition holds, or fails the test after a timeout.
+  bool runUntil(const std::function<bool()>& condition) {
+    const MonotonicTime deadline =
+        api_->timeSource().monotonicTime() + TestUtility::DefaultTimeout;
+    while (!condition()) {
+      if (api_->timeSource().monotonicTime() >= deadline) {
+        ADD_FAILURE() << "timed out";
+        return false;
+      }
+      dispatcher_->run(Event::Dispatcher::RunType::NonBlock);
+    }
+    return true;
+  }
+
+  // Runs the dispatcher until the peer has received the given number of bytes, or what it has
+  // received when timing out.
+  std::string receive(os_fd_t peer, size_t length) {
+    std::string received;
+    char buffer[1024];
+    runUntil([&]() {
+      const ssize_t rc = ::read(peer, buffer, sizeof(buffer));
+      if (rc > 0) {
+        received.append(buffer, rc);
+      }
+      return received.size() >= length;
+    });
+    return received;
+  }
+
+  // SpliceForwarder::Callbacks
+  void onSplicedBytes(bool upstream, uint64_t bytes) override {
+    (upstream ? upstream_bytes_ : downstream_bytes_) += bytes;
+  }
+
+  Api::ApiPtr api_;
+  Event::DispatcherPtr dispatcher_;
+  StreamInfo::StreamInfoImpl stream_info_;
+  std::vector<Network::ServerConnectionPtr> connections_;
+  std::vector<os_fd_t> peers_;
+  SpliceForwarderPtr forwarder_;
+  uint64_t upstream_bytes_{};
+  uint64_t downstream_bytes_{};
+};
+
+TEST_F(SpliceForwarderTest, MockConnectionNotSpliced) {
+  testing::NiceMock<Network::MockConnection> downstream;
+  testing::NiceMock<Network::MockConnection> upstream;
+  EXPECT_FALSE(SpliceForwarder::canSplice(downstream));
+  EXPECT_EQ(nullptr, SpliceForwarder::create(downstream, upstream, *this));
+}
+
+#if defined(__linux__)
+TEST_F(SpliceForwarderTest, ForwardsBothDirections) {
+  os_fd_t downstream_peer;
+  os_fd_t upstream_peer;
+  Network::Connection& downstream = createConnection(downstream_peer);
+  Network::Connection& upstream = createConnection(upstream_peer);
+
+  forwarder_ = SpliceForwarder::create(downstream, upstream, *this);
+  ASSERT_NE(nullptr, forwarder_);
+  EXPECT_FALSE(downstream.readEnabled());
+  EXPECT_FALSE(upstream.readEnabled());
+
+  ASSERT_EQ(5, ::write(downstream_peer, "hello", 5));
+  EXPECT_EQ("hello", receive(upstream_peer, 5));
+  EXPECT_EQ(5U, upstream_bytes_);
+
+  ASSERT_EQ(6, ::write(upstream_peer, "world!", 6));
+  EXPECT_EQ("world!", receive(downstream_peer, 6));
+  EXPECT_EQ(6U, downstream_bytes_);
+
+  forwarder_.reset();
+  EXPECT_TRUE(downstream.readEnabled());
+  EXPECT_TRUE(upstream.readEnabled());
+}
+
+// The end of stream of one direction is raised through its source connection, while the other
+// direction keeps being spliced.
+TEST_F(SpliceForwarderTest, HalfClose) {
+  os_fd_t downstream_peer;
+  os_fd_t upstream_peer;
+  Network::Connection& downstream = createConnection(downstream_peer);
+  Network::Connection& upstream = createConnection(upstream_peer);
+
+  forwarder_ = SpliceForwarder::create(downstream, upstream, *this);
+  ASSERT_NE(nullptr, forwarder_);
+
+  ASSERT_EQ(5, ::write(downstream_peer, "hello", 5));
+  ASSERT_EQ(0, ::shutdown(downstream_peer, SHUT_WR));
+  EXPECT_EQ("hello", receive(upstream_peer, 5));
+  EXPECT_TRUE(runUntil([&]() { return downstream.readEnabled(); }));
+  EXPECT_EQ(Network::Connection::State::Open, downstream.state());
+  EXPECT_FALSE(upstream.readEnabled());
+
+  ASSERT_EQ(6, ::write(upstream_peer, "world!", 6));
+  EXPECT_EQ("world!", receive(downstream_peer, 6));
+  EXPECT_EQ(6U, downstream_bytes_);
+}
+
+// Both directions stop once their sources reach the end of stream.
+TEST_F(SpliceForwarderTest, EndOfStream) {
+  os_fd_t downstream_peer;
+  os_fd_t upstream_peer;
+  Network::Connection& downstream = createConnection(downstream_peer);
+  Network::Connection& upstream = createConnection(upstream_peer);
+
+  forwarder_ = SpliceForwarder::create(downstream, upstream, *this);
+  ASSERT_NE(nullptr, forwarder_);
+
+  ASSERT_EQ(0, ::shutdown(downstream_peer, SHUT_WR));
+  ASSERT_EQ(0, ::shutdown(upstream_peer, SHUT_WR));
+  EXPECT_TRUE(runUntil([&]() { return downstream.readEnabled() && upstream.readEnabled(); }));
+  EXPECT_EQ(0U, upstream_bytes_);
+  EXPECT_EQ(0U, downstream_bytes_);
+}
+
+// A direction which fails to write to its sink stops, and read enables its source connection.
+TEST_F(SpliceForwarderTest, SpliceError) {
+  os_fd_t downstream_peer;
+  os_fd_t upstream_peer;
+  Network::Connection& downstream = createConnection(downstream_peer);
+  Network::Connection& upstream = createConnection(upstream_peer);
+
+  forwarder_ = SpliceForwarder::create(downstream, upstream, *this);
+  ASSERT_NE(nullptr, forwarder_);
+
+  // Writing to the downstream socket fails once its peer is closed.
+  ASSERT_EQ(0, ::shutdown(downstream_peer, SHUT_RD));
+  ASSERT_EQ(6, ::write(upstream_peer, "world!", 6));
+  EXPECT_TRUE(runUntil([&]() { return upstream.readEnabled(); }));
+  EXPECT_EQ(0U, downstream_bytes_);
+  EXPECT_FALSE(downstream.readEnabled());
+}
+
+TEST_F(SpliceForwarderTest, BufferedWriteNotSpliced) {
+  os_fd_t peer;
+  Network::Connection& connection = createConnection(peer);
+  EXPECT_TRUE(SpliceForwarder::canSplice(connection));
+
+  Buffer::OwnedImpl data("hello");
+  connection.write(data, false);
+  EXPECT_FALSE(SpliceForwarder::canSplice(connection));
+}
+#endif
+
+} // namespace
+} // namespace TcpProxy
+} // namespace Envoy
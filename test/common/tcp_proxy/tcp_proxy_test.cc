@@ -225,6 +225,26 @@ TEST_P(TcpProxyTest, HalfCloseProxy) {
   upstream_callbacks_->onEvent(Network::ConnectionEvent::RemoteClose);
 }
 
+// Tests that the payload is proxied through the connections when splicing is enabled but the
+// connections are not plaintext kernel socket connections.
+TEST_P(TcpProxyTest, SpliceDataFallsBackToProxying) {
+  auto config = defaultConfig();
+  config.set_splice_data(true);
+  setup(1, config);
+  EXPECT_TRUE(config_->spliceData());
+
+  raiseEventUpstreamConnected(0);
+  EXPECT_EQ(0U, config_->stats().downstream_cx_spliced_total_.value());
+
+  Buffer::OwnedImpl buffer("hello");
+  EXPECT_CALL(*upstream_connections_.at(0), write(BufferEqual(&buffer), false));
+  filter_->onData(buffer, false);
+
+  Buffer::OwnedImpl response("world");
+  EXPECT_CALL(filter_callbacks_.connection_, write(BufferEqual(&response), false));
+  upstream_callbacks_->onUpstreamData(response, false);
+}
+
 // Test with an explicitly configured upstream.
 TEST_P(TcpProxyTest, ExplicitFactory) {
   // Explicitly configure an HTTP upstream, to test factory creation.
@@ -130,6 +130,12 @@ TEST_P(HttpUpstreamTest, AddBytesSentCallbackForCoverage) {
   this->upstream_->addBytesSentCallback([&](uint64_t) { return true; });
 }
 
+// A tunneled payload can not be spliced to the upstream connection.
+TEST_P(HttpUpstreamTest, NoRawConnection) {
+  this->setupUpstream();
+  EXPECT_EQ(nullptr, this->upstream_->rawConnection());
+}
+
 TEST_P(HttpUpstreamTest, DownstreamDisconnect) {
   this->setupUpstream();
   EXPECT_CALL(this->encoder_.stream_, resetStream(Http::StreamResetReason::LocalReset));
@@ -195,6 +195,26 @@ TEST_F(SslContextImplTest, TestPreferClientCiphers) {
   EXPECT_FALSE(SSL_CTX_get_options(ssl_ctx) & SSL_OP_CIPHER_SERVER_PREFERENCE);
 }
 
+TEST_F(SslContextImplTest, TestKernelTlsOffload) {
+  const std::string yaml = R"EOF(
+  common_tls_context:
+    tls_certificates:
+      certificate_chain:
+        filename: "{{ test_rundir }}/test/common/tls/test_data/unittest_cert.pem"
+      private_key:
+        filename: "{{ test_rundir }}/test/common/tls/test_data/unittest_key.pem"
+  )EOF";
+
+  envoy::extensions::transport_sockets::tls::v3::DownstreamTlsContext tls_context;
+  TestUtility::loadFromYaml(TestEnvironment::substitute(yaml), tls_context);
+  auto cfg = ServerContextConfigImpl::create(tls_context, factory_context_, false).value();
+  EXPECT_FALSE(cfg->kernelTlsOffload());
+
+  tls_context.set_kernel_tls_offload(true);
+  cfg = ServerContextConfigImpl::create(tls_context, factory_context_, false).value();
+  EXPECT_TRUE(cfg->kernelTlsOffload());
+}
+
 TEST_F(SslContextImplTest, TestExpiringCert) {
   const std::string yaml = R"EOF(
   common_tls_context:
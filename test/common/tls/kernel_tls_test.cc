@@ -0,0 +1,286 @@
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "source/common/common/assert.h"
+#include "source/common/network/io_socket_handle_impl.h"
+#include "source/common/tls/kernel_tls.h"
+
+#include "test/mocks/network/io_handle.h"
+#include "test/test_common/environment.h"
+
+#include "absl/strings/str_cat.h"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "openssl/ssl.h"
+
+using testing::NiceMock;
+
+namespace Envoy {
+namespace Extensions {
+namespace TransportSockets {
+namespace Tls {
+namespace {
+
+TEST(KernelTlsTest, NotKernelSocket) {
+  NiceMock<Network::MockIoHandle> io_handle;
+  KernelTls::Session session;
+  EXPECT_TRUE(absl::IsFailedPrecondition(KernelTls::enable(nullptr, io_handle, session)));
+}
+
+#if defined(__linux__)
+class KernelTlsSocketTest : public testing::Test {
+protected:
+  KernelTlsSocketTest() {
+    RELEASE_ASSERT(::socketpair(AF_UNIX, SOCK_STREAM, 0, fds_) == 0, "");
+  }
+  ~KernelTlsSocketTest() override {
+    ::close(fds_[0]);
+    ::close(fds_[1]);
+  }
+
+  int fds_[2];
+};
+
+// Without any record layer offloaded, the payload is read as application data.
+TEST_F(KernelTlsSocketTest, ReadApplicationData) {
+  ASSERT_EQ(5, ::write(fds_[0], "hello", 5));
+  char buffer[16];
+  uint8_t record_type = 0;
+  EXPECT_EQ(5, KernelTls::read(fds_[1], buffer, sizeof(buffer), record_type).return_value_);
+  EXPECT_EQ(KernelTls::RecordTypeApplicationData, record_type);
+  EXPECT_EQ("hello", absl::string_view(buffer, 5));
+}
+
+// The alert is sent as the payload of the record.
+TEST_F(KernelTlsSocketTest, SendCloseNotify) {
+  EXPECT_EQ(2, KernelTls::sendCloseNotify(fds_[0]).return_value_);
+  uint8_t alert[2];
+  ASSERT_EQ(2, ::read(fds_[1], alert, sizeof(alert)));
+  EXPECT_EQ(1, alert[0]);
+  EXPECT_EQ(KernelTls::AlertCloseNotify, alert[1]);
+}
+
+// Handshake messages of a TLS 1.2 session are renegotiation requests.
+TEST_F(KernelTlsSocketTest, HandshakeMessageWithTls12) {
+  KernelTls::Session session;
+  session.version_ = TLS1_2_VERSION;
+  const uint8_t hello_request[] = {0, 0, 0, 0};
+  EXPECT_TRUE(absl::IsInvalidArgument(
+      KernelTls::onHandshakeMessages(fds_[0], session, absl::MakeConstSpan(hello_request))));
+}
+
+TEST_F(KernelTlsSocketTest, TruncatedHandshakeMessage) {
+  KernelTls::Session session;
+  session.version_ = TLS1_3_VERSION;
+  const uint8_t key_update[] = {KernelTls::HandshakeKeyUpdate, 0, 0, 1};
+  EXPECT_TRUE(absl::IsInvalidArgument(
+      KernelTls::onHandshakeMessages(fds_[0], session, absl::MakeConstSpan(key_update))));
+}
+
+// Session tickets are ignored, since the offloaded session is never resumed.
+TEST_F(KernelTlsSocketTest, IgnoreNewSessionTicket) {
+  KernelTls::Session session;
+  session.version_ = TLS1_3_VERSION;
+  const uint8_t ticket[] = {KernelTls::HandshakeNewSessionTicket, 0, 0, 2, 0, 0};
+  EXPECT_TRUE(
+      KernelTls::onHandshakeMessages(fds_[0], session, absl::MakeConstSpan(ticket)).ok());
+}
+
+struct KernelTlsLoopbackParam {
+  uint16_t version_;
+  // The TLS 1.2 cipher suite, TLS 1.3 ones can not be configured.
+  const char* cipher_list_;
+};
+
+// Offloads the record layer of the server side of a session established over loopback, and checks
+// that the client, which keeps using SSL, reads what the kernel encrypts and the other way around.
+class KernelTlsLoopbackTest : public testing::TestWithParam<KernelTlsLoopbackParam> {
+protected:
+  KernelTlsLoopbackTest()
+      : client_ctx_(SSL_CTX_new(TLS_method())), server_ctx_(SSL_CTX_new(TLS_method())) {
+    for (SSL_CTX* ctx : {client_ctx_.get(), server_ctx_.get()}) {
+      RELEASE_ASSERT(SSL_CTX_set_min_proto_version(ctx, GetParam().version_), "");
+      RELEASE_ASSERT(SSL_CTX_set_max_proto_version(ctx, GetParam().version_), "");
+    }
+    if (GetParam().cipher_list_ != nullptr) {
+      RELEASE_ASSERT(SSL_CTX_set_strict_cipher_list(client_ctx_.get(), GetParam().cipher_list_),
+                     "");
+    }
+    RELEASE_ASSERT(SSL_CTX_use_certificate_chain_file(
+                       server_ctx_.get(), TestEnvironment::runfilesPath(
+                                              "test/common/tls/test_data/unittest_cert.pem")
+                                              .c_str()),
+                   "");
+    RELEASE_ASSERT(SSL_CTX_use_PrivateKey_file(
+                       server_ctx_.get(),
+                       TestEnvironment::runfilesPath("test/common/tls/test_data/unittest_key.pem")
+                           .c_str(),
+                       SSL_FILETYPE_PEM),
+                   "");
+  }
+
+  ~KernelTlsLoopbackTest() override {
+    if (client_fd_ >= 0) {
+      ::close(client_fd_);
+    }
+  }
+
+  // Connects a client and a server over loopback and completes the handshake.
+  void connect() {
+    const int listen_fd = ::socket(AF_INET, SOCK_STREAM, 0);
+    ASSERT_GE(listen_fd, 0);
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    socklen_t address_length = sizeof(address);
+    ASSERT_EQ(0, ::bind(listen_fd, reinterpret_cast<sockaddr*>(&address), address_length));
+    ASSERT_EQ(0, ::listen(listen_fd, 1));
+    ASSERT_EQ(0, ::getsockname(listen_fd, reinterpret_cast<sockaddr*>(&address), &address_length));
+    client_fd_ = ::socket(AF_INET, SOCK_STREAM, 0);
+    ASSERT_GE(client_fd_, 0);
+    ASSERT_EQ(0, ::connect(client_fd_, reinterpret_cast<sockaddr*>(&address), address_length));
+    const int server_fd = ::accept(listen_fd, nullptr, nullptr);
+    ::close(listen_fd);
+    ASSERT_GE(server_fd, 0);
+    server_io_handle_ = std::make_unique<Network::IoSocketHandleImpl>(server_fd);
+
+    client_.reset(SSL_new(client_ctx_.get()));
+    server_.reset(SSL_new(server_ctx_.get()));
+    SSL_set_fd(client_.get(), client_fd_);
+    SSL_set_fd(server_.get(), server_fd);
+    SSL_set_connect_state(client_.get());
+    SSL_set_accept_state(server_.get());
+    // Both sides are driven from this thread, so neither may block on the other.
+    ASSERT_NE(-1, ::fcntl(client_fd_, F_SETFL, O_NONBLOCK));
+    ASSERT_NE(-1, ::fcntl(server_fd, F_SETFL, O_NONBLOCK));
+    bool client_done = false;
+    bool server_done = false;
+    while (!client_done || !server_done) {
+      client_done = client_done || handshakeStep(client_.get());
+      server_done = server_done || handshakeStep(server_.get());
+    }
+    ASSERT_NE(-1, ::fcntl(client_fd_, F_SETFL, 0));
+    ASSERT_NE(-1, ::fcntl(server_fd, F_SETFL, 0));
+  }
+
+  static bool handshakeStep(SSL* ssl) {
+    const int rc = SSL_do_handshake(ssl);
+    if (rc == 1) {
+      return true;
+    }
+    const int error = SSL_get_error(ssl, rc);
+    RELEASE_ASSERT(error == SSL_ERROR_WANT_READ || error == SSL_ERROR_WANT_WRITE,
+                   absl::StrCat("handshake failed: ", error));
+    return false;
+  }
+
+  // Reads the next application data record of the server, handling the handshake records before
+  // it.
+  std::string serverRead() {
+    const os_fd_t fd = server_io_handle_->fdDoNotUse();
+    char buffer[256];
+    uint8_t record_type;
+    while (true) {
+      const Api::SysCallSizeResult result =
+          KernelTls::read(fd, buffer, sizeof(buffer), record_type);
+      RELEASE_ASSERT(result.return_value_ > 0, absl::StrCat("read failed: ", result.errno_));
+      if (record_type == KernelTls::RecordTypeApplicationData) {
+        return {buffer, static_cast<size_t>(result.return_value_)};
+      }
+      RELEASE_ASSERT(record_type == KernelTls::RecordTypeHandshake, "");
+      handshake_status_ = KernelTls::onHandshakeMessages(
+          fd, session_,
+          absl::MakeConstSpan(reinterpret_cast<uint8_t*>(buffer), result.return_value_));
+      if (!handshake_status_.ok()) {
+        return "";
+      }
+    }
+  }
+
+  std::string clientRead() {
+    char buffer[256];
+    const int rc = SSL_read(client_.get(), buffer, sizeof(buffer));
+    return rc > 0 ? std::string(buffer, rc) : "";
+  }
+
+  // Round trips a message through the offloaded server.
+  void echo(absl::string_view message) {
+    ASSERT_EQ(static_cast<int>(message.size()),
+              SSL_write(client_.get(), message.data(), message.size()));
+    const std::string received = serverRead();
+    if (absl::IsFailedPrecondition(handshake_status_)) {
+      return;
+    }
+    ASSERT_TRUE(handshake_status_.ok()) << handshake_status_;
+    EXPECT_EQ(message, received);
+    ASSERT_EQ(static_cast<ssize_t>(message.size()),
+              ::send(server_io_handle_->fdDoNotUse(), received.data(), received.size(), 0));
+    EXPECT_EQ(message, clientRead());
+  }
+
+  bssl::UniquePtr<SSL_CTX> client_ctx_;
+  bssl::UniquePtr<SSL_CTX> server_ctx_;
+  bssl::UniquePtr<SSL> client_;
+  bssl::UniquePtr<SSL> server_;
+  int client_fd_{-1};
+  std::unique_ptr<Network::IoSocketHandleImpl> server_io_handle_;
+  KernelTls::Session session_;
+  absl::Status handshake_status_;
+};
+
+INSTANTIATE_TEST_SUITE_P(
+    Ciphers, KernelTlsLoopbackTest,
+    testing::Values(KernelTlsLoopbackParam{TLS1_2_VERSION, "ECDHE-RSA-AES128-GCM-SHA256"},
+                    KernelTlsLoopbackParam{TLS1_2_VERSION, "ECDHE-RSA-AES256-GCM-SHA384"},
+                    KernelTlsLoopbackParam{TLS1_2_VERSION, "ECDHE-RSA-CHACHA20-POLY1305"},
+                    KernelTlsLoopbackParam{TLS1_3_VERSION, nullptr}));
+
+TEST_P(KernelTlsLoopbackTest, Echo) {
+  connect();
+  const absl::Status status = KernelTls::enable(server_.get(), *server_io_handle_, session_);
+  if (absl::IsFailedPrecondition(status)) {
+    GTEST_SKIP() << "kernel TLS is not available: " << status;
+  }
+  ASSERT_TRUE(status.ok()) << status;
+
+  echo("hello");
+  echo("world");
+
+  // The alert is read by the client as the end of the session.
+  ASSERT_EQ(2, KernelTls::sendCloseNotify(server_io_handle_->fdDoNotUse()).return_value_);
+  char buffer[16];
+  const int rc = SSL_read(client_.get(), buffer, sizeof(buffer));
+  EXPECT_EQ(SSL_ERROR_ZERO_RETURN, SSL_get_error(client_.get(), rc));
+}
+
+TEST_P(KernelTlsLoopbackTest, KeyUpdate) {
+  if (GetParam().version_ != TLS1_3_VERSION) {
+    GTEST_SKIP() << "key updates are specific to TLS 1.3";
+  }
+  connect();
+  const absl::Status status = KernelTls::enable(server_.get(), *server_io_handle_, session_);
+  if (absl::IsFailedPrecondition(status)) {
+    GTEST_SKIP() << "kernel TLS is not available: " << status;
+  }
+  ASSERT_TRUE(status.ok()) << status;
+
+  // The session tickets sent at the end of the handshake are read by the client before the echo.
+  echo("hello");
+  // The update of the client keys is sent along with the next write, and requests the server to
+  // update its keys in return.
+  ASSERT_EQ(1, SSL_key_update(client_.get(), SSL_KEY_UPDATE_REQUESTED));
+  echo("world");
+  if (absl::IsFailedPrecondition(handshake_status_)) {
+    GTEST_SKIP() << "key updates are not supported by the kernel: " << handshake_status_;
+  }
+  echo("again");
+}
+#endif
+
+} // namespace
+} // namespace Tls
+} // namespace TransportSockets
+} // namespace Extensions
+} // namespace Envoy
@@ -12,6 +12,8 @@
 #include "test/mocks/stats/mocks.h"
 #include "test/test_common/utility.h"
 
+#include "absl/strings/str_join.h"
+#include "absl/strings/str_split.h"
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 
@@ -416,6 +418,38 @@ ip_tags:
   EXPECT_EQ(Http::FilterTrailersStatus::Continue, filter_->decodeTrailers(request_trailers));
 }
 
+TEST_F(IpTaggingFilterTest, PoptrieLookup) {
+  const std::string poptrie_yaml = R"EOF(
+ip_lookup_algorithm: POPTRIE
+ip_tags:
+  - ip_tag_name: wide_request
+    ip_list:
+      - {address_prefix: 1.2.0.0, prefix_len: 16}
+  - ip_tag_name: narrow_request
+    ip_list:
+      - {address_prefix: 1.2.3.4, prefix_len: 32}
+      - {address_prefix: 2001:abcd:ef01:2345::, prefix_len: 64}
+)EOF";
+  initializeFilter(poptrie_yaml);
+
+  for (const auto& [address, tags] : std::vector<std::pair<std::string, std::string>>{
+           {"1.2.3.4", "narrow_request,wide_request"},
+           {"1.2.5.6", "wide_request"},
+           {"2001:abcd:ef01:2345::1", "narrow_request"}}) {
+    Http::TestRequestHeaderMapImpl request_headers;
+    filter_callbacks_.stream_info_.downstream_connection_info_provider_->setRemoteAddress(
+        Network::Utility::parseInternetAddressNoThrow(address));
+    EXPECT_EQ(Http::FilterHeadersStatus::Continue,
+              filter_->decodeHeaders(request_headers, false));
+
+    // There is no guarantee for the order tags are returned by the Poptrie.
+    std::vector<std::string> header_tags = absl::StrSplit(
+        request_headers.get_(Http::Headers::get().EnvoyIpTags.get()), ',', absl::SkipEmpty());
+    std::sort(header_tags.begin(), header_tags.end());
+    EXPECT_EQ(tags, absl::StrJoin(header_tags, ","));
+  }
+}
+
 TEST_F(IpTaggingFilterTest, RuntimeDisabled) {
   initializeFilter(internal_request_yaml);
   Http::TestRequestHeaderMapImpl request_headers{{"x-envoy-internal", "true"}};
@@ -0,0 +1,63 @@
+#include "envoy/config/core/v3/extension.pb.h"
+#include "envoy/extensions/network/connection_balance/load_aware/v3/load_aware.pb.h"
+
+#include "source/extensions/network/connection_balance/load_aware/config.h"
+
+#include "test/mocks/server/factory_context.h"
+#include "test/test_common/utility.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace Network {
+namespace ConnectionBalance {
+namespace LoadAware {
+namespace {
+
+Envoy::Network::ConnectionBalancerSharedPtr createBalancer(const std::string& yaml) {
+  envoy::extensions::network::connection_balance::load_aware::v3::LoadAwareConnectionBalance
+      config;
+  TestUtility::loadFromYaml(yaml, config);
+  envoy::config::core::v3::TypedExtensionConfig typed_config;
+  typed_config.set_name("envoy.network.connection_balance.load_aware");
+  typed_config.mutable_typed_config()->PackFrom(config);
+
+  auto* factory = Registry::FactoryRegistry<Envoy::Network::ConnectionBalanceFactory>::getFactory(
+      "envoy.network.connection_balance.load_aware");
+  EXPECT_NE(nullptr, factory);
+  testing::NiceMock<Server::Configuration::MockFactoryContext> context;
+  return factory->createConnectionBalancerFromProto(typed_config, context);
+}
+
+TEST(LoadAwareConnectionBalanceFactoryTest, CreatesBalancer) {
+  const auto balancer = createBalancer(R"EOF(
+connection_weight: 2
+stream_weight: 1
+busy_weight: 0
+busy_threshold:
+  value: 80
+)EOF");
+  EXPECT_NE(nullptr,
+            dynamic_cast<Envoy::Network::LoadAwareConnectionBalancerImpl*>(balancer.get()));
+}
+
+TEST(LoadAwareConnectionBalanceFactoryTest, Defaults) {
+  EXPECT_NE(nullptr, dynamic_cast<Envoy::Network::LoadAwareConnectionBalancerImpl*>(
+                         createBalancer("{}").get()));
+}
+
+TEST(LoadAwareConnectionBalanceFactoryTest, InvalidBusyThreshold) {
+  EXPECT_THROW(createBalancer(R"EOF(
+busy_threshold:
+  value: 120
+)EOF"),
+               ProtoValidationException);
+}
+
+} // namespace
+} // namespace LoadAware
+} // namespace ConnectionBalance
+} // namespace Network
+} // namespace Extensions
+} // namespace Envoy
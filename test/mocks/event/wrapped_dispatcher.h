@@ -91,6 +91,10 @@ public:
 
   void run(RunType type) override { impl_.run(type); }
 
+  void enableHybridPolling(std::chrono::microseconds spin_duration) override {
+    impl_.enableHybridPolling(spin_duration);
+  }
+
   Buffer::WatermarkFactory& getWatermarkFactory() override { return impl_.getWatermarkFactory(); }
   void pushTrackedObject(const ScopeTrackedObject* object) override {
     return impl_.pushTrackedObject(object);
@@ -106,6 +110,8 @@ public:
     return impl_.approximateMonotonicTime();
   }
 
+  DispatcherLoad& load() override { return impl_.load(); }
+
   void updateApproximateMonotonicTime() override { impl_.updateApproximateMonotonicTime(); }
 
   bool isThreadSafe() const override { return impl_.isThreadSafe(); }
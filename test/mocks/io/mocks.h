@@ -22,12 +22,25 @@ public:
   MOCK_METHOD(IoUringResult, prepareReadv,
               (os_fd_t fd, const struct iovec* iovecs, unsigned nr_vecs, off_t offset,
                Request* user_data));
+  MOCK_METHOD(IoUringResult, prepareRecvMultishot,
+              (os_fd_t fd, uint16_t buffer_group, Request* user_data));
+  MOCK_METHOD(IoUringResult, prepareRecvmsg,
+              (os_fd_t fd, struct msghdr* msg, Request* user_data));
+  MOCK_METHOD(IoUringResult, prepareRecvmsgMultishot,
+              (os_fd_t fd, struct msghdr* msg, uint16_t buffer_group, Request* user_data));
   MOCK_METHOD(IoUringResult, prepareWritev,
               (os_fd_t fd, const struct iovec* iovecs, unsigned nr_vecs, off_t offset,
                Request* user_data));
+  MOCK_METHOD(IoUringResult, prepareSendmsg,
+              (os_fd_t fd, const struct msghdr* msg, Request* user_data));
+  MOCK_METHOD(IoUringResult, prepareSendmsgZc,
+              (os_fd_t fd, const struct msghdr* msg, Request* user_data));
   MOCK_METHOD(IoUringResult, prepareClose, (os_fd_t fd, Request* user_data));
   MOCK_METHOD(IoUringResult, prepareCancel, (Request * cancelling_user_data, Request* user_data));
   MOCK_METHOD(IoUringResult, prepareShutdown, (os_fd_t fd, int how, Request* user_data));
+  MOCK_METHOD(IoUringResult, registerBufferRing, (uint16_t buffer_group, uint32_t entries));
+  MOCK_METHOD(void, addBufferToRing,
+              (uint16_t buffer_group, uint8_t* buf, uint32_t len, uint16_t buffer_id));
   MOCK_METHOD(IoUringResult, submit, ());
   MOCK_METHOD(void, injectCompletion, (os_fd_t fd, Request* user_data, int32_t result));
   MOCK_METHOD(void, removeInjectedCompletion, (os_fd_t fd));
@@ -44,6 +57,10 @@ public:
   MOCK_METHOD(void, connect, (const Network::Address::InstanceConstSharedPtr& address));
   MOCK_METHOD(void, write, (Buffer::Instance & data));
   MOCK_METHOD(uint64_t, write, (const Buffer::RawSlice* slices, uint64_t num_slice));
+  MOCK_METHOD(int32_t, sendmsg,
+              (const Buffer::RawSlice* slices, uint64_t num_slice,
+               const Network::Address::Instance& peer_address, absl::string_view control));
+  MOCK_METHOD(absl::optional<ReceivedDatagram>, takeDatagram, ());
   MOCK_METHOD(void, onAccept, (Request * req, int32_t result, bool injected));
   MOCK_METHOD(void, onConnect, (Request * req, int32_t result, bool injected));
   MOCK_METHOD(void, onRead, (Request * req, int32_t result, bool injected));
@@ -68,12 +85,18 @@ public:
                bool enable_close_event));
   MOCK_METHOD(IoUringSocket&, addClientSocket,
               (os_fd_t fd, Event::FileReadyCb cb, bool enable_close_event));
+  MOCK_METHOD(IoUringSocket&, addDatagramSocket, (os_fd_t fd, Event::FileReadyCb cb));
   MOCK_METHOD(Event::Dispatcher&, dispatcher, ());
   MOCK_METHOD(Request*, submitConnectRequest,
               (IoUringSocket & socket, const Network::Address::InstanceConstSharedPtr& address));
   MOCK_METHOD(Request*, submitReadRequest, (IoUringSocket & socket));
+  MOCK_METHOD(Request*, submitRecvmsgRequest, (IoUringSocket & socket));
   MOCK_METHOD(Request*, submitWriteRequest,
               (IoUringSocket & socket, const Buffer::RawSliceVector& slices));
+  MOCK_METHOD(Request*, submitSendZcRequest, (IoUringSocket & socket, Buffer::Instance& data));
+  MOCK_METHOD(Request*, submitSendmsgRequest,
+              (IoUringSocket & socket, const Buffer::RawSlice* slices, uint64_t num_slice,
+               const Network::Address::Instance& peer_address, absl::string_view control));
   MOCK_METHOD(Request*, submitCloseRequest, (IoUringSocket & socket));
   MOCK_METHOD(Request*, submitCancelRequest, (IoUringSocket & socket, Request* request_to_cancel));
   MOCK_METHOD(Request*, submitShutdownRequest, (IoUringSocket & socket, int how));
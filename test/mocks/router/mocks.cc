@@ -68,6 +68,12 @@ MockRateLimitPolicy::MockRateLimitPolicy() {
 
 MockRateLimitPolicy::~MockRateLimitPolicy() = default;
 
+MockAdaptiveHedging::MockAdaptiveHedging() {
+  ON_CALL(*this, canHedge()).WillByDefault(Return(true));
+}
+
+MockAdaptiveHedging::~MockAdaptiveHedging() = default;
+
 MockShadowWriter::MockShadowWriter() = default;
 MockShadowWriter::~MockShadowWriter() = default;
 
@@ -160,6 +166,7 @@ MockRoute::MockRoute() {
   ON_CALL(*this, typedMetadata()).WillByDefault(ReturnRef(typed_metadata_));
   ON_CALL(*this, routeName()).WillByDefault(ReturnRef(route_name_));
   ON_CALL(*this, virtualHost()).WillByDefault(ReturnRef(virtual_host_copy_));
+  ON_CALL(*this, hasFilterDisabledOverrides()).WillByDefault(Return(true));
 
   // Route entry methods.
   ON_CALL(*this, clusterName()).WillByDefault(ReturnRef(route_entry_.cluster_name_));
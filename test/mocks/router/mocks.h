@@ -105,6 +105,18 @@ public:
   absl::optional<bool> forward_not_matching_preflights_;
 };
 
+class MockAdaptiveHedging : public AdaptiveHedging {
+public:
+  MockAdaptiveHedging();
+  ~MockAdaptiveHedging() override;
+
+  // Router::AdaptiveHedging
+  MOCK_METHOD(absl::optional<std::chrono::milliseconds>, onRequest, ());
+  MOCK_METHOD(void, recordLatency, (std::chrono::microseconds latency));
+  MOCK_METHOD(bool, canHedge, (), (const));
+  MOCK_METHOD(void, onHedge, ());
+};
+
 class TestHedgePolicy : public HedgePolicy {
 public:
   // Router::HedgePolicy
@@ -113,9 +125,13 @@ public:
     return additional_request_chance_;
   }
   bool hedgeOnPerTryTimeout() const override { return hedge_on_per_try_timeout_; }
+  OptRef<AdaptiveHedging> adaptiveHedging() const override {
+    return makeOptRefFromPtr(adaptive_hedging_);
+  }
 
   uint32_t initial_requests_{};
   envoy::type::v3::FractionalPercent additional_request_chance_;
+  AdaptiveHedging* adaptive_hedging_{};
   bool hedge_on_per_try_timeout_{};
 };
 
@@ -530,6 +546,7 @@ public:
   MOCK_METHOD(const Decorator*, decorator, (), (const));
   MOCK_METHOD(const RouteTracing*, tracingConfig, (), (const));
   MOCK_METHOD(absl::optional<bool>, filterDisabled, (absl::string_view), (const));
+  MOCK_METHOD(bool, hasFilterDisabledOverrides, (), (const));
   MOCK_METHOD(const RouteSpecificFilterConfig*, perFilterConfig, (absl::string_view), (const));
   MOCK_METHOD(const RouteSpecificFilterConfig*, mostSpecificPerFilterConfig, (absl::string_view),
               (const));